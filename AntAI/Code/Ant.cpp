@@ -338,8 +338,8 @@ eOrderCode Ant::GetOrderAttackSoldier()
 	}
 
 	if (!m_isChasingEnemy) {
-		TileHeatMap const& heatmap = m_colony->GetHeatmap(AGENT_TYPE_SOLDIER, true);
-		nextTile = heatmap.GetCoordsForNextLowestValue(currentPos);
+		HeatmapSnapshot heatmap = m_colony->GetHeatmap(AGENT_TYPE_SOLDIER, true);
+		nextTile = heatmap->GetCoordsForNextLowestValue(currentPos);
 	}
 
 	if (m_colony->IsTileSolid(nextTile, AGENT_TYPE_SOLDIER)) {
@@ -368,8 +368,7 @@ eOrderCode Ant::GetOrderAttackSoldier()
 	int maxSoldiers = (guardsPerQueen * numQueens) + numWorkers;
 
 	if (numSoldiers > maxSoldiers + 2) {
-		if (!m_colony->IsScheduledForDeath(AGENT_TYPE_SOLDIER)) {
-			m_colony->ScheduleForDeath(AGENT_TYPE_SOLDIER);
+		if (m_colony->TryScheduleForDeath(AGENT_TYPE_SOLDIER)) {
 			return eOrderCode::ORDER_SUICIDE;
 		}
 	}
@@ -461,8 +460,8 @@ eOrderCode Ant::GetOrderWorker()
 
 	// Must take food to queen!
 	if (m_state == STATE_HOLDING_FOOD) {
-		TileHeatMap const& heatmap = m_colony->GetHeatmap(AGENT_TYPE_WORKER, true);
-		float currentValue = heatmap.GetValue(currentPos);
+		HeatmapSnapshot heatmap = m_colony->GetHeatmap(AGENT_TYPE_WORKER, true);
+		float currentValue = heatmap->GetValue(currentPos);
 
 		if (currentValue == 0.0f) {
 			g_debug->QueueDrawWorldText((float)currentPos.x, (float)currentPos.y, 0.0f, 0.0f, 1.0f, Color8(255, 255, 0, 255), "Feed your highness");
@@ -470,7 +469,7 @@ eOrderCode Ant::GetOrderWorker()
 			return ORDER_DROP_CARRIED_OBJECT;
 		}
 
-		nextLowest = heatmap.GetCoordsForNextLowestValue(currentPos);
+		nextLowest = heatmap->GetCoordsForNextLowestValue(currentPos);
 	}
 	else {
 		if (m_canDig) {
@@ -494,8 +493,7 @@ eOrderCode Ant::GetOrderWorker()
 
 		if (distToGoal > 18) {
 			if (((m_colony->m_foodCount * 3) / 2) < m_colony->m_liveWorkers) {
-				if (!m_colony->IsScheduledForDeath(AGENT_TYPE_WORKER)) {
-					m_colony->ScheduleForDeath(AGENT_TYPE_WORKER);
+				if (m_colony->TryScheduleForDeath(AGENT_TYPE_WORKER)) {
 					return ORDER_SUICIDE;
 				}
 			}
@@ -35,6 +35,7 @@ const char* GiveAuthorName() // DLL should return the actual human author's name
 //------------------------------------------------------------------------------------------------
 void PreGameStartup(const StartupInfo& info) // Server provides player/match info
 {
+	g_threadSafe_turnInfo.SetMapWidth(info.matchInfo.mapWidth);
 	g_colony = new Colony(info);
 	g_threadSafe_turnStatus = TURN_STATUS_WAITING_FOR_NEXT_UPDATE;
 	g_debug = info.debugInterface;
@@ -71,7 +72,7 @@ void PlayerThreadEntry(int yourThreadIndex) // Called from its own private threa
 //------------------------------------------------------------------------------------------------
 void ReceiveTurnState(const ArenaTurnStateForPlayer& turnInfo) // Server tells us what happened, and what we see
 {
-	g_threadSafe_turnInfo.CopyFrom(turnInfo); // Copy off the turn state info we've just been given
+	g_threadSafe_turnInfo.CopyFrom(turnInfo); // Copy into the back buffer and publish it; no lock, the colony reads it in place
 	g_threadSafe_turnStatus = TURN_STATUS_PROCESSING_UPDATE;
 }
 
@@ -2,29 +2,68 @@
 #include "ColonyJob.hpp"
 #include "ArenaPlayerInterface.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
+#include <algorithm>
+#include <queue>
+#include <emmintrin.h>
+
+constexpr int MIN_ANTS_PER_ORDER_BATCH = 32;
+constexpr int MIN_SECTOR_PATH_DISTANCE = 2 * SECTOR_WIDTH; // Shorter paths are searched tile by tile
 
 Colony::Colony(StartupInfo const& startupInfo) :
 	m_startupInfo(startupInfo),
-	m_queenFoodMap(IntVec2(startupInfo.matchInfo.mapWidth, startupInfo.matchInfo.mapWidth)),
-	m_heatmapToQueens(IntVec2(startupInfo.matchInfo.mapWidth, startupInfo.matchInfo.mapWidth)),
+	m_currentTurnInfo(&g_threadSafe_turnInfo.GetFront()),
 	m_solidMap(IntVec2(startupInfo.matchInfo.mapWidth, startupInfo.matchInfo.mapWidth)),
 	m_foodDensityMap(IntVec2(startupInfo.matchInfo.mapWidth, startupInfo.matchInfo.mapWidth)),
-	m_enemyHistoryMap(IntVec2(startupInfo.matchInfo.mapWidth, startupInfo.matchInfo.mapWidth)),
-	m_soldierAttackMap(IntVec2(startupInfo.matchInfo.mapWidth, startupInfo.matchInfo.mapWidth))
+	m_enemyHistoryMap(IntVec2(startupInfo.matchInfo.mapWidth, startupInfo.matchInfo.mapWidth))
 {
-	m_queenFoodMap.SetAllValues(FLT_MAX);
+	IntVec2 mapDimensions = IntVec2(startupInfo.matchInfo.mapWidth, startupInfo.matchInfo.mapWidth);
+	std::shared_ptr<TileHeatMap> queenFoodMap = std::make_shared<TileHeatMap>(mapDimensions);
+	queenFoodMap->SetAllValues(FLT_MAX);
+	m_queenFoodMap = queenFoodMap;
+	m_heatmapToQueens = std::make_shared<TileHeatMap>(mapDimensions);
+	m_soldierAttackMap = std::make_shared<TileHeatMap>(mapDimensions);
+
 	m_solidMap.SetAllValues(1.0f);
-	m_tiles.resize(startupInfo.matchInfo.mapWidth * startupInfo.matchInfo.mapWidth);
+	int numTiles = startupInfo.matchInfo.mapWidth * startupInfo.matchInfo.mapWidth;
+	m_tiles.resize(numTiles);
+	m_previousObservedTiles.resize(numTiles, TILE_TYPE_UNSEEN);
+	m_previousTilesWithFood.resize(numTiles, 0);
+	m_foodTileSlots.resize(numTiles, -1);
+	m_isDensityTile.resize(numTiles, 0);
+
+	m_unexploredTiles.reserve(numTiles);
+	for (int tileIndex = 0; tileIndex < numTiles; tileIndex++) {
+		m_unexploredTiles.push_back(GetTileCoords(tileIndex));
+	}
+	m_numUnexploredTiles = numTiles;
 	m_foodDensityMap.SetAllValues(0.0f);
+
+	// Sector graphs are built by the first rebuild job; until then paths are searched tile by tile
+	for (int agentType = 0; agentType < NUM_AGENT_TYPES; agentType++) {
+		m_sectorGraphs[agentType] = std::make_shared<SectorGraph>((eAgentType)agentType, startupInfo.matchInfo.mapWidth);
+	}
+	int numSectors = m_sectorGraphs[0]->GetNumSectors();
+	m_isSectorDirty.resize(numSectors, 1);
+	for (int sectorIndex = 0; sectorIndex < numSectors; sectorIndex++) {
+		m_dirtySectors.push_back(sectorIndex);
+	}
 }
 
 void Colony::Update()
 {
-	m_aStarsRequested = 0;
-	m_aStarsRequestedSoldiers = 0;
 	eTurnStatus turnStatus = g_threadSafe_turnStatus;
 	if (turnStatus == TURN_STATUS_PROCESSING_UPDATE) {
-		g_threadSafe_turnInfo.CopyTo(m_currentTurnInfo);
+		// A late turn can still have order batches in flight when the next state arrives. They read the ants, the batch
+		// state and the turn info this is about to overwrite, so help them finish first. AcquireLatest gives the front
+		// buffer back to the writer, so it must not be called before this
+		while (!m_areCalculationsDone) {
+			AsyncUpdate();
+		}
+
+		// A* budgets are per turn. Update runs once per job, so resetting them every call left batches on other threads unbounded
+		m_aStarsRequested = 0;
+		m_aStarsRequestedSoldiers = 0;
+		m_currentTurnInfo = &g_threadSafe_turnInfo.AcquireLatest();
 		g_threadSafe_turnStatus = TURN_STATUS_WORKING_ON_ORDERS;
 
 		//ProcessTurnInfoJob* processTurnInfoJob = new ProcessTurnInfoJob(this);
@@ -84,56 +123,41 @@ void Colony::AsyncUpdate()
 		jobToExecute->Execute();
 		delete jobToExecute;
 	}
+	else {
+		std::this_thread::yield();
+	}
 }
 
-TileHeatMap Colony::GetHeatmap(eAgentType agentType, bool lookingForQueen)
+HeatmapSnapshot Colony::GetHeatmap(eAgentType agentType, bool lookingForQueen) const
 {
+	return std::atomic_load(GetPublishedHeatmapSlot(agentType, lookingForQueen));
+}
 
-	TileHeatMap heatmapToReturn = TileHeatMap(IntVec2(1, 1));
-	m_heatmapsMutex.lock();
-
+void Colony::PublishHeatmap(std::shared_ptr<TileHeatMap> const& updatedHeatmap, eAgentType agentType, bool lookingForQueen)
+{
+	std::atomic_store(GetPublishedHeatmapSlot(agentType, lookingForQueen), HeatmapSnapshot(updatedHeatmap));
 	if (lookingForQueen) {
-		heatmapToReturn = m_heatmapToQueens;
+		m_isHeatmapToQueensBeingBuilt = false;
 	}
-	else {
-		switch (agentType)
-		{
-		case AGENT_TYPE_QUEEN:
-			heatmapToReturn = m_queenFoodMap;
-			break;
-		case AGENT_TYPE_SOLDIER:
-			heatmapToReturn = m_soldierAttackMap;
-		default:
-			m_queenFoodMap = m_queenFoodMap;
-			break;
-		}
-	}
-	m_heatmapsMutex.unlock();
-	return heatmapToReturn;
-
 }
-void Colony::UpdateHeatmap(TileHeatMap const& updatedHeatmap, eAgentType agentType, bool lookingForQueen)
+
+HeatmapSnapshot* Colony::GetPublishedHeatmapSlot(eAgentType agentType, bool lookingForQueen)
 {
-	m_heatmapsMutex.lock();
-	if (lookingForQueen) {
-		m_heatmapToQueens = updatedHeatmap;
-	}
-	else {
-		switch (agentType)
-		{
-		case AGENT_TYPE_QUEEN:
-			m_queenFoodMap = updatedHeatmap;
-			break;
-		case AGENT_TYPE_SOLDIER:
-			m_soldierAttackMap = updatedHeatmap;
-			break;
-		default:
-			m_queenFoodMap = updatedHeatmap;
-			break;
-		}
+	if (lookingForQueen) return &m_heatmapToQueens;
+
+	switch (agentType)
+	{
+	case AGENT_TYPE_SOLDIER:
+		return &m_soldierAttackMap;
+	case AGENT_TYPE_QUEEN:
+	default:
+		return &m_queenFoodMap;
 	}
+}
 
-	m_heatmapsMutex.unlock();
+HeatmapSnapshot const* Colony::GetPublishedHeatmapSlot(eAgentType agentType, bool lookingForQueen) const
+{
+	return const_cast<Colony*>(this)->GetPublishedHeatmapSlot(agentType, lookingForQueen);
 }
 
 void Colony::UpdateOrders(PlayerTurnOrders const& newOrders)
@@ -147,7 +171,7 @@ void Colony::UpdateOrders(PlayerTurnOrders const& newOrders)
 
 int Colony::GetNutrients() const
 {
-	return m_currentTurnInfo.currentNutrients;
+	return m_currentTurnInfo->currentNutrients;
 }
 
 void Colony::GetAStarPath(std::vector<IntVec2>& resultPath, IntVec2 const& start, std::vector<IntVec2> const& goals, eAgentType agentType, int maxLoops, float heuristicWeight, bool seekingFood)
@@ -155,6 +179,22 @@ void Colony::GetAStarPath(std::vector<IntVec2>& resultPath, IntVec2 const& start
 	m_aStarsRequested++;
 	IntVec2 mapDimensions = IntVec2(m_startupInfo.matchInfo.mapWidth, m_startupInfo.matchInfo.mapWidth);
 
+	IntVec2 closestGoal;
+	if (seekingFood) {
+		closestGoal = GetClosestFoodGoal(start, goals);
+	}
+	else {
+		closestGoal = GetClosestGoal(start, goals);
+	}
+
+	// Long paths go over the sector graph. maxLoops only bounds the tile search below: the sector search is bounded by
+	// the graph instead, and either finds the whole path or none. Falls through to the tile search if the graph can't
+	// find one yet
+	if ((GetTileIndex(closestGoal.x, closestGoal.y) != -1) && (GetTaxicabDistance2D(start, closestGoal) >= MIN_SECTOR_PATH_DISTANCE)) {
+		SectorGraphSnapshot sectorGraph = std::atomic_load(&m_sectorGraphs[agentType]);
+		if (sectorGraph->FindPath(resultPath, start, closestGoal, *m_tileTypes, heuristicWeight)) return;
+	}
+
 	TileHeatMap tileScores(mapDimensions);
 	tileScores.SetAllValues(FLT_MAX); // All tiles unexplored
 	TileHeatMap tileFScores(mapDimensions);
@@ -165,14 +205,6 @@ void Colony::GetAStarPath(std::vector<IntVec2>& resultPath, IntVec2 const& start
 	openTiles.push_back(start);
 	tileScores.SetValue(start, 0.0f);
 
-	IntVec2 closestGoal;
-	if (seekingFood) {
-		closestGoal = GetClosestFoodGoal(start, goals);
-	}
-	else {
-		closestGoal = GetClosestGoal(start, goals);
-	}
-
 	float currentHeuristic = GetAStarHeuristic(start, closestGoal, seekingFood);
 	tileFScores.SetValue(start, currentHeuristic);
 
@@ -231,7 +263,7 @@ void Colony::GetAStarPath(std::vector<IntVec2>& resultPath, IntVec2 const& start
 			float const& neighborFScore = tileFScores.GetValue(neighborTile);
 
 			float tentativeScore = currentScore + GetTileCost(neighborTile, agentType);
-			float tentativeFScore = tentativeScore + (GetAStarHeuristic(neighborTile, closestGoal) * heuristicWeight, seekingFood);
+			float tentativeFScore = tentativeScore + (GetAStarHeuristic(neighborTile, closestGoal, seekingFood) * heuristicWeight);
 
 			if (tentativeScore < neighborScore) {
 				bool isOpenNode = (neighborFScore == FLT_MAX);
@@ -324,8 +356,8 @@ ObservedAgent const* Colony::GetClosestEnemy(IntVec2 const& coords) const
 	int bestDistance = INT_MAX;
 	ObservedAgent const* closestEnemy = nullptr;
 
-	for (int observedAgentCount = 0; observedAgentCount < m_currentTurnInfo.numObservedAgents; observedAgentCount++) {
-		ObservedAgent const& enemyAgent = m_currentTurnInfo.observedAgents[observedAgentCount];
+	for (int observedAgentCount = 0; observedAgentCount < m_currentTurnInfo->numObservedAgents; observedAgentCount++) {
+		ObservedAgent const& enemyAgent = m_currentTurnInfo->observedAgents[observedAgentCount];
 		IntVec2 enemyCoords = IntVec2(enemyAgent.tileX, enemyAgent.tileY);
 		if (IsTileSolid(enemyCoords, AGENT_TYPE_SOLDIER)) continue;
 
@@ -360,8 +392,8 @@ ObservedAgent const* Colony::GetClosestEnemyQueen(IntVec2 const& coords) const
 	int bestDistance = INT_MAX;
 	ObservedAgent const* closestEnemy = nullptr;
 
-	for (int observedAgentCount = 0; observedAgentCount < m_currentTurnInfo.numObservedAgents; observedAgentCount++) {
-		ObservedAgent const& enemyAgent = m_currentTurnInfo.observedAgents[observedAgentCount];
+	for (int observedAgentCount = 0; observedAgentCount < m_currentTurnInfo->numObservedAgents; observedAgentCount++) {
+		ObservedAgent const& enemyAgent = m_currentTurnInfo->observedAgents[observedAgentCount];
 
 		if (enemyAgent.type != AGENT_TYPE_QUEEN) continue;
 
@@ -382,8 +414,8 @@ ObservedAgent const* Colony::GetClosestEnemyQueen(IntVec2 const& coords) const
 
 ObservedAgent const* Colony::GetEnemyIfVisible(AgentID enemyId) const
 {
-	for (int observedAgentCount = 0; observedAgentCount < m_currentTurnInfo.numObservedAgents; observedAgentCount++) {
-		ObservedAgent const& enemyAgent = m_currentTurnInfo.observedAgents[observedAgentCount];
+	for (int observedAgentCount = 0; observedAgentCount < m_currentTurnInfo->numObservedAgents; observedAgentCount++) {
+		ObservedAgent const& enemyAgent = m_currentTurnInfo->observedAgents[observedAgentCount];
 		if (enemyAgent.agentID == enemyId) return &enemyAgent;
 	}
 
@@ -393,7 +425,7 @@ ObservedAgent const* Colony::GetEnemyIfVisible(AgentID enemyId) const
 
 bool Colony::IsAnyQueenBeingAttacked() const
 {
-	return (m_currentTurnInfo.nutrientsLostDueToQueenDamage > 0) || (m_currentTurnInfo.nutrientsLostDueToQueenSuffocation > 0);
+	return (m_currentTurnInfo->nutrientsLostDueToQueenDamage > 0) || (m_currentTurnInfo->nutrientsLostDueToQueenSuffocation > 0);
 }
 
 bool Colony::IsEnemyAtPos(IntVec2 const& coords) const
@@ -405,7 +437,9 @@ bool Colony::IsEnemyAtPos(IntVec2 const& coords) const
 
 bool Colony::IsFoodAtPos(IntVec2 const& coords) const
 {
+	m_foodDensityMutex.lock();
 	float heatmapVal = m_foodDensityMap.GetValue(coords);
+	m_foodDensityMutex.unlock();
 	return heatmapVal > 3.0f;
 }
 
@@ -440,8 +474,8 @@ void Colony::ProcessEnemyInfo()
 		}
 	}
 
-	for (int enemyIndex = 0; enemyIndex < m_currentTurnInfo.numObservedAgents; enemyIndex++) {
-		ObservedAgent const& enemy = m_currentTurnInfo.observedAgents[enemyIndex];
+	for (int enemyIndex = 0; enemyIndex < m_currentTurnInfo->numObservedAgents; enemyIndex++) {
+		ObservedAgent const& enemy = m_currentTurnInfo->observedAgents[enemyIndex];
 		IntVec2 enemyPos = IntVec2(enemy.tileX, enemy.tileY);
 
 		float currentValue = m_enemyHistoryMap.GetValue(enemyPos);
@@ -465,22 +499,34 @@ void Colony::ProcessTurnInfo()
 	m_foundQueen = false;
 
 	ProcessEnemyInfo();
-	ProcessTilesInfo(m_currentTurnInfo.observedTiles, m_currentTurnInfo.tilesThatHaveFood);
+	ProcessTilesInfo(m_currentTurnInfo->observedTiles, m_currentTurnInfo->tilesThatHaveFood);
 
-	for (int observedAgentCount = 0; (observedAgentCount < m_currentTurnInfo.numObservedAgents) && !m_foundQueen; observedAgentCount++) {
-		ObservedAgent const& enemyAgent = m_currentTurnInfo.observedAgents[observedAgentCount];
+	for (int observedAgentCount = 0; (observedAgentCount < m_currentTurnInfo->numObservedAgents) && !m_foundQueen; observedAgentCount++) {
+		ObservedAgent const& enemyAgent = m_currentTurnInfo->observedAgents[observedAgentCount];
 		if (enemyAgent.type == AGENT_TYPE_QUEEN) m_foundQueen = true;
 	}
 
-	for (int reportIndex = 0; reportIndex < m_currentTurnInfo.numReports; reportIndex++) {
-		AgentReport const& currentReport = m_currentTurnInfo.agentReports[reportIndex];
+	for (int reportIndex = 0; reportIndex < m_currentTurnInfo->numReports; reportIndex++) {
+		AgentReport const& currentReport = m_currentTurnInfo->agentReports[reportIndex];
 		ProcessReport(currentReport);
 	}
 
+	UpdateTileTypes();
+
 
 
-	if (!m_heatmapScheduled && m_heatmapToQueensDirty) {
-		RecalculateHeatmapToQueens();
+	// One build of the queen heatmap at a time; whatever changes in the meantime is picked up once it is published
+	if (!m_isHeatmapToQueensBeingBuilt) {
+		if (!m_heatmapScheduled && m_heatmapToQueensDirty) {
+			RecalculateHeatmapToQueens();
+		}
+		else if (!m_heatmapToQueensRepairTiles.empty()) {
+			RepairHeatmapToQueens();
+		}
+	}
+
+	if (!m_isSectorGraphBeingBuilt && !m_dirtySectors.empty()) {
+		QueueSectorGraphRebuild();
 	}
 
 	if (!m_heatmapScheduled /*&& (m_lastSoldierUpdate > 3)*/) {
@@ -497,8 +543,7 @@ void Colony::ProcessTurnInfo()
 		m_lastQueenFoodUpdate++;
 	}*/
 
-	OrderProcessingJob* orderProcessJob = new OrderProcessingJob(this);
-	QueueJobForExecution(orderProcessJob);
+	QueueOrderBatches();
 }
 
 void Colony::GetUnexploredTiles(std::vector<IntVec2>& tileCoordsContainer) const
@@ -518,71 +563,153 @@ void Colony::GetUnexploredTiles(std::vector<IntVec2>& tileCoordsContainer) const
 
 }
 
+// Appends every tile whose observed type or food flag differs from last turn's, comparing 16 tiles at a time
+static void FindChangedTiles(std::vector<int>& out_changedTiles, eTileType const* observedTiles, eTileType const* previousObservedTiles,
+	unsigned char const* tilesWithFood, unsigned char const* previousTilesWithFood, int numTiles)
+{
+	int tileIndex = 0;
+	for (; (tileIndex + 16) <= numTiles; tileIndex += 16) {
+		__m128i tileTypes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(observedTiles + tileIndex));
+		__m128i previousTileTypes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(previousObservedTiles + tileIndex));
+		__m128i foodFlags = _mm_loadu_si128(reinterpret_cast<__m128i const*>(tilesWithFood + tileIndex));
+		__m128i previousFoodFlags = _mm_loadu_si128(reinterpret_cast<__m128i const*>(previousTilesWithFood + tileIndex));
+
+		__m128i isUnchanged = _mm_and_si128(_mm_cmpeq_epi8(tileTypes, previousTileTypes), _mm_cmpeq_epi8(foodFlags, previousFoodFlags));
+		int changedMask = ~_mm_movemask_epi8(isUnchanged) & 0xffff;
+		if (changedMask == 0) continue;
+
+		for (int lane = 0; lane < 16; lane++) {
+			if (changedMask & (1 << lane)) {
+				out_changedTiles.push_back(tileIndex + lane);
+			}
+		}
+	}
+
+	for (; tileIndex < numTiles; tileIndex++) {
+		if ((observedTiles[tileIndex] != previousObservedTiles[tileIndex]) || (tilesWithFood[tileIndex] != previousTilesWithFood[tileIndex])) {
+			out_changedTiles.push_back(tileIndex);
+		}
+	}
+}
+
 void Colony::ProcessTilesInfo(eTileType const* observedTiles, bool const* tilesWithFood)
 {
-	m_foodCount = 0;
-	m_tilesWithFood.clear();
-	m_tilesWithFood.reserve(m_solidMap.GetDimensions().x * 4);
-	m_unexploredTiles.clear();
-	m_foodDensityMipMap.clear();
-	m_foodDensityMipMap.resize(16);
+	int numTiles = (int)m_tiles.size();
+	unsigned char const* foodFlags = reinterpret_cast<unsigned char const*>(tilesWithFood);
 
+	m_changedTiles.clear();
+	FindChangedTiles(m_changedTiles, observedTiles, m_previousObservedTiles.data(), foodFlags, m_previousTilesWithFood.data(), numTiles);
 
-	int foodMipMapWidth = m_startupInfo.matchInfo.mapWidth / 4;
+	// Scout goals only last a turn
+	m_unexploredTiles.resize(m_numUnexploredTiles);
+	bool discoveredAnyTile = false;
 
-	for (int tileIndex = 0; tileIndex < m_tiles.size(); tileIndex++) {
+	for (int tileIndex : m_changedTiles) {
 		eTileType const& observedType = observedTiles[tileIndex];
 		Tile& tile = m_tiles[tileIndex];
+		m_previousObservedTiles[tileIndex] = observedType;
+		m_previousTilesWithFood[tileIndex] = foodFlags[tileIndex];
+
+		if (observedType == TILE_TYPE_UNSEEN) continue;
 
-		if (observedType != eTileType::TILE_TYPE_UNSEEN) {
+		if (tile.m_hasFood != tilesWithFood[tileIndex]) {
 			tile.m_hasFood = tilesWithFood[tileIndex];
+			if (tile.m_hasFood) {
+				m_foodTileSlots[tileIndex] = (int)m_foodTiles.size();
+				m_foodTiles.push_back(tileIndex);
+			}
+			else {
+				int foodSlot = m_foodTileSlots[tileIndex];
+				int lastFoodTile = m_foodTiles.back();
+				m_foodTiles[foodSlot] = lastFoodTile;
+				m_foodTileSlots[lastFoodTile] = foodSlot;
+				m_foodTiles.pop_back();
+				m_foodTileSlots[tileIndex] = -1;
+			}
 		}
-		IntVec2 tileCoords = GetTileCoords(tileIndex);
 
-		float currentDensityValue = m_foodDensityMap.GetValue(tileCoords);
-		if (tile.m_hasFood) {
-			//if (m_solidMap.GetValue(tileCoords) == 0.0f) {
-				m_foodCount++;
-				m_tilesWithFood.push_back(tileCoords);
-
-				if (currentDensityValue < 0.0f) currentDensityValue = 0.0f;
-				currentDensityValue++;
-				m_foodDensityMap.SetValue(tileCoords, currentDensityValue);
+		if (tile.m_type != TILE_TYPE_UNSEEN) continue;
+		tile.m_type = observedType;
+		m_numKnownTiles++;
+		discoveredAnyTile = true;
+		m_areTileTypesDirty = true;
 
-			//}
+		// Unseen tiles cost the same as air for every agent type
+		if ((observedType != TILE_TYPE_AIR) && (observedType != TILE_TYPE_CORPSE_BRIDGE)) {
+			MarkSectorsDirty(tileIndex);
 		}
 
-		if (currentDensityValue > 0.0f) {
-			int mipMapX = tileCoords.x / foodMipMapWidth;
-			int mipMapY = tileCoords.y / foodMipMapWidth;
-
-			int mipMapIndex = (mipMapY * 4) + mipMapX;
-			m_foodDensityMipMap[mipMapIndex] += 1;
-			m_foodCount++;
-			m_tilesWithFood.push_back(tileCoords);
+		if (tile.m_type != TILE_TYPE_STONE) {
+			m_solidMap.SetValue(tileIndex, 0.0f);
 		}
 
+		// Unseen tiles are pathed through like air, so only tiles that turn out costlier change the distances to queens
+		if (GetTileCost(tileIndex, AGENT_TYPE_WORKER) != 1.0f) {
+			m_heatmapToQueensRepairTiles.push_back(tileIndex);
+		}
+	}
 
+	if (discoveredAnyTile) {
+		int numUnexploredTiles = 0;
+		for (int unexploredIndex = 0; unexploredIndex < m_numUnexploredTiles; unexploredIndex++) {
+			IntVec2 const& tileCoords = m_unexploredTiles[unexploredIndex];
+			if (m_tiles[GetTileIndex(tileCoords.x, tileCoords.y)].m_type != TILE_TYPE_UNSEEN) continue;
 
-		if (observedType == TILE_TYPE_UNSEEN) {
-			if (tile.m_type == TILE_TYPE_UNSEEN) {
-				m_unexploredTiles.emplace_back(tileCoords);
-			}
-			continue;
+			m_unexploredTiles[numUnexploredTiles] = tileCoords;
+			numUnexploredTiles++;
 		}
+		m_unexploredTiles.resize(numUnexploredTiles);
+		m_numUnexploredTiles = numUnexploredTiles;
+	}
 
+	// Food density keeps growing while food is there; workers reset it when they find a tile emptied or claim it
+	m_foodDensityMutex.lock();
+	int numSortedDensityTiles = (int)m_densityTiles.size();
+	for (int tileIndex : m_foodTiles) {
+		float currentDensityValue = m_foodDensityMap.GetValue(tileIndex);
+		if (currentDensityValue < 0.0f) currentDensityValue = 0.0f;
+		currentDensityValue++;
+		m_foodDensityMap.SetValue(tileIndex, currentDensityValue);
+
+		if (!m_isDensityTile[tileIndex]) {
+			m_isDensityTile[tileIndex] = 1;
+			m_densityTiles.push_back(tileIndex);
+		}
+	}
 
-		if (tile.m_type != TILE_TYPE_UNSEEN) continue;
-		tile.m_type = observedTiles[tileIndex];
-		m_heatmapToQueensDirty = true;
-		m_numKnownTiles++;
+	// Only the tiles added this turn are out of order
+	std::sort(m_densityTiles.begin() + numSortedDensityTiles, m_densityTiles.end());
+	std::inplace_merge(m_densityTiles.begin(), m_densityTiles.begin() + numSortedDensityTiles, m_densityTiles.end());
 
-		if (tile.m_type != TILE_TYPE_STONE) {
-			m_solidMap.SetValue(tileCoords, 0.0f);
+	int numDensityTiles = 0;
+	for (int tileIndex : m_densityTiles) {
+		if (m_foodDensityMap.GetValue(tileIndex) > 0.0f) {
+			m_densityTiles[numDensityTiles] = tileIndex;
+			numDensityTiles++;
+		}
+		else {
+			m_isDensityTile[tileIndex] = 0;
 		}
-
 	}
+	m_foodDensityMutex.unlock();
+	m_densityTiles.resize(numDensityTiles);
+
+	// Food tiles always have a positive density, so they are counted twice like before
+	m_foodCount = (unsigned int)(m_foodTiles.size() + m_densityTiles.size());
+	m_tilesWithFood.clear();
+	m_foodDensityMipMap.clear();
+	m_foodDensityMipMap.resize(16);
+
+	int foodMipMapWidth = m_startupInfo.matchInfo.mapWidth / 4;
+	for (int tileIndex : m_densityTiles) {
+		IntVec2 tileCoords = GetTileCoords(tileIndex);
+		int mipMapX = tileCoords.x / foodMipMapWidth;
+		int mipMapY = tileCoords.y / foodMipMapWidth;
 
+		int mipMapIndex = (mipMapY * 4) + mipMapX;
+		m_foodDensityMipMap[mipMapIndex] += 1;
+		m_tilesWithFood.push_back(tileCoords);
+	}
 }
 
 void Colony::ProcessReport(AgentReport const& newReport)
@@ -685,13 +812,23 @@ void Colony::ProcessAgentDeath(AgentReport const& newReport)
 
 	Ant& ant = GetAnt(newReport.agentID, retrievedCorrectAnt);
 	if (retrievedCorrectAnt) {
-		for (Ant* guard : ant.m_guards) {
+		// RemoveGuard erases from the list of the ant guarded, which is usually this one
+		std::vector<Ant*> guards;
+		guards.swap(ant.m_guards);
+		for (Ant* guard : guards) {
 			if (guard->m_guardedAnt) {
 				guard->m_guardedAnt->RemoveGuard(guard);
 			}
 			guard->RelieveFromGuardDuty();
 		}
 
+		// The slot goes to the next ant born. One that inherited guard duty would copy the guarded ant's move from a
+		// batch that runs alongside the guarded ant's own
+		if (ant.m_guardedAnt) {
+			ant.m_guardedAnt->RemoveGuard(&ant);
+		}
+		ant.RelieveFromGuardDuty();
+
 		ant.m_state = STATE_DEAD;
 		m_liveAnts--;
 
@@ -705,7 +842,9 @@ void Colony::ProcessAgentDeath(AgentReport const& newReport)
 		case AGENT_TYPE_WORKER:
 			m_liveWorkers--;
 			if (ant.m_currentPath.size() > 0) {
+				m_foodDensityMutex.lock();
 				m_foodDensityMap.SetValue(ant.m_currentPath[0], 1.0f);
+				m_foodDensityMutex.unlock();
 			}
 			break;
 		case AGENT_TYPE_SOLDIER:
@@ -746,7 +885,11 @@ void Colony::ProcessAgentDug(AgentReport const& newReport)
 		CopyReportInfo(ant, newReport);
 		int tileindex = GetTileIndex(newReport.tileX, newReport.tileY);
 		Tile& tileDug = m_tiles[tileindex];
-		tileDug.m_type = TILE_TYPE_AIR;
+		if (tileDug.m_type != TILE_TYPE_AIR) {
+			tileDug.m_type = TILE_TYPE_AIR;
+			m_areTileTypesDirty = true;
+			MarkSectorsDirty(tileindex);
+		}
 	}
 	m_workerFoodmapDirty = true;
 
@@ -793,7 +936,6 @@ void Colony::AddDebugVisibilityVerts(std::vector<VertexPC>& verts)
 
 void Colony::AddHeatmapDebugVerts(std::vector<VertexPC>& verts, TileHeatMap const& heatMap, float maxVisibleValue)
 {
-	m_heatmapsMutex.lock();
 	float quadSize = 1.0f;
 	for (int tileX = 0; tileX < m_startupInfo.matchInfo.mapWidth; tileX++) {
 		for (int tileY = 0; tileY < m_startupInfo.matchInfo.mapWidth; tileY++) {
@@ -815,7 +957,6 @@ void Colony::AddHeatmapDebugVerts(std::vector<VertexPC>& verts, TileHeatMap cons
 
 		}
 	}
-	m_heatmapsMutex.unlock();
 }
 
 
@@ -861,13 +1002,23 @@ void Colony::RecalculateHeatmapToQueens()
 		}
 	}
 
-	HeatmapUpdateJob* heatmapUpdateJob = new HeatmapUpdateJob(this, m_heatmapToQueens.GetDimensions(), goals, AGENT_TYPE_WORKER, true);
+	m_isHeatmapToQueensBeingBuilt = true;
+	HeatmapUpdateJob* heatmapUpdateJob = new HeatmapUpdateJob(this, m_solidMap.GetDimensions(), goals, AGENT_TYPE_WORKER, true, m_tileTypes);
 	QueueJobForExecution(heatmapUpdateJob);
 	//RecalculateHeatMap(m_heatmapToQueens, AGENT_TYPE_WORKER);
 	m_heatmapToQueensDirty = false;
+	m_heatmapToQueensRepairTiles.clear();
 	m_heatmapScheduled = true;
 }
 
+void Colony::RepairHeatmapToQueens()
+{
+	m_isHeatmapToQueensBeingBuilt = true;
+	HeatmapRepairJob* heatmapRepairJob = new HeatmapRepairJob(this, GetHeatmap(AGENT_TYPE_WORKER, true), m_heatmapToQueensRepairTiles, AGENT_TYPE_WORKER, true, m_tileTypes);
+	QueueJobForExecution(heatmapRepairJob);
+	m_heatmapToQueensRepairTiles.clear();
+}
+
 //void Colony::RecalculateWorkerFoodmap()
 //{
 //	int mapWidth = m_startupInfo.matchInfo.mapWidth;
@@ -919,7 +1070,7 @@ void Colony::RecalculateQueenFoodmap()
 		}
 	}
 
-	HeatmapUpdateJob* queenFoodmapUpdate = new HeatmapUpdateJob(this, m_queenFoodMap.GetDimensions(), queenGoals, eAgentType::AGENT_TYPE_QUEEN, false);
+	HeatmapUpdateJob* queenFoodmapUpdate = new HeatmapUpdateJob(this, m_solidMap.GetDimensions(), queenGoals, eAgentType::AGENT_TYPE_QUEEN, false, m_tileTypes);
 	QueueJobForExecution(queenFoodmapUpdate);
 	m_queenFoodMapDirty = false;
 	m_lastQueenFoodUpdate = 0;
@@ -928,14 +1079,14 @@ void Colony::RecalculateQueenFoodmap()
 
 void Colony::RecalculateSoldierAttackmap()
 {
-	HeatmapUpdateJob* soldierUpdate = new HeatmapUpdateJob(this, m_soldierAttackMap.GetDimensions(), m_enemyPositions, eAgentType::AGENT_TYPE_SOLDIER, false);
+	HeatmapUpdateJob* soldierUpdate = new HeatmapUpdateJob(this, m_solidMap.GetDimensions(), m_enemyPositions, eAgentType::AGENT_TYPE_SOLDIER, false, m_tileTypes);
 	QueueJobForExecution(soldierUpdate);
 
 	m_heatmapScheduled = true;
 	m_lastSoldierUpdate = 0;
 }
 
-void Colony::RecalculateHeatMap(TileHeatMap& heatmap, eAgentType agentType)
+void Colony::RecalculateHeatMap(TileHeatMap& heatmap, eAgentType agentType, std::vector<eTileType> const& tileTypes)
 {
 	int mapWidth = (int)m_startupInfo.matchInfo.mapWidth;
 
@@ -949,17 +1100,17 @@ void Colony::RecalculateHeatMap(TileHeatMap& heatmap, eAgentType agentType)
 
 				float const& tileValue = heatmap.GetValue(tileIndex);
 				if (tileValue != currentValue) continue;
-				if (IsTileSolid(tileIndex, agentType)) continue;
+				if (IsTileTypeSolid(tileTypes[tileIndex], agentType)) continue;
 
 				int northTileIndex = GetTileIndex(tileX, tileY + 1);
 				int southTileIndex = GetTileIndex(tileX, tileY - 1);
 				int eastTileIndex = GetTileIndex(tileX + 1, tileY);
 				int westTileIndex = GetTileIndex(tileX - 1, tileY);
 
-				bool modifiedNorth = (northTileIndex > -1) && (SetTileHeatmapValue(heatmap, agentType, northTileIndex, currentValue));
-				bool modifiedSouth = (southTileIndex > -1) && (SetTileHeatmapValue(heatmap, agentType, southTileIndex, currentValue));
-				bool modifiedEast = (eastTileIndex > -1) && (SetTileHeatmapValue(heatmap, agentType, eastTileIndex, currentValue));
-				bool modifiedWest = (westTileIndex > -1) && (SetTileHeatmapValue(heatmap, agentType, westTileIndex, currentValue));
+				bool modifiedNorth = (northTileIndex > -1) && (SetTileHeatmapValue(heatmap, agentType, northTileIndex, currentValue, tileTypes));
+				bool modifiedSouth = (southTileIndex > -1) && (SetTileHeatmapValue(heatmap, agentType, southTileIndex, currentValue, tileTypes));
+				bool modifiedEast = (eastTileIndex > -1) && (SetTileHeatmapValue(heatmap, agentType, eastTileIndex, currentValue, tileTypes));
+				bool modifiedWest = (westTileIndex > -1) && (SetTileHeatmapValue(heatmap, agentType, westTileIndex, currentValue, tileTypes));
 
 				modifiedAnyTile = modifiedAnyTile || modifiedNorth || modifiedSouth || modifiedEast || modifiedWest;
 
@@ -972,50 +1123,335 @@ void Colony::RecalculateHeatMap(TileHeatMap& heatmap, eAgentType agentType)
 
 
 
+void Colony::RebuildSectorGraphs(std::vector<int> const& dirtySectors, std::vector<eTileType> const& tileTypes)
+{
+	for (int agentType = 0; agentType < NUM_AGENT_TYPES; agentType++) {
+		std::shared_ptr<SectorGraph> sectorGraph = std::make_shared<SectorGraph>(*std::atomic_load(&m_sectorGraphs[agentType]));
+		for (int sectorIndex : dirtySectors) {
+			sectorGraph->RebuildSector(sectorIndex, tileTypes);
+		}
+		std::atomic_store(&m_sectorGraphs[agentType], SectorGraphSnapshot(sectorGraph));
+	}
+	m_isSectorGraphBeingBuilt = false;
+}
+
+void Colony::MarkSectorsDirty(int tileIndex)
+{
+	// A tile on the edge of a sector also changes the crossings of the sector across that edge
+	int mapWidth = m_startupInfo.matchInfo.mapWidth;
+	IntVec2 tileCoords = GetTileCoords(tileIndex);
+	IntVec2 sectorCoords = IntVec2(tileCoords.x / SECTOR_WIDTH, tileCoords.y / SECTOR_WIDTH);
+	IntVec2 sectorsToMark[] = {
+		sectorCoords,
+		((tileCoords.x % SECTOR_WIDTH) == 0) ? sectorCoords + IntVec2(-1, 0) : sectorCoords,
+		((tileCoords.x % SECTOR_WIDTH) == SECTOR_WIDTH - 1) ? sectorCoords + IntVec2(1, 0) : sectorCoords,
+		((tileCoords.y % SECTOR_WIDTH) == 0) ? sectorCoords + IntVec2(0, -1) : sectorCoords,
+		((tileCoords.y % SECTOR_WIDTH) == SECTOR_WIDTH - 1) ? sectorCoords + IntVec2(0, 1) : sectorCoords
+	};
+
+	int sectorsPerRow = (mapWidth + SECTOR_WIDTH - 1) / SECTOR_WIDTH;
+	for (IntVec2 const& sectorToMark : sectorsToMark) {
+		if ((sectorToMark.x < 0) || (sectorToMark.y < 0) || (sectorToMark.x >= sectorsPerRow) || (sectorToMark.y >= sectorsPerRow)) continue;
+
+		int sectorIndex = (sectorToMark.y * sectorsPerRow) + sectorToMark.x;
+		if (m_isSectorDirty[sectorIndex]) continue;
+		m_isSectorDirty[sectorIndex] = 1;
+		m_dirtySectors.push_back(sectorIndex);
+	}
+}
+
+void Colony::QueueSectorGraphRebuild()
+{
+	m_isSectorGraphBeingBuilt = true;
+	SectorGraphUpdateJob* sectorGraphUpdateJob = new SectorGraphUpdateJob(this, m_dirtySectors, m_tileTypes);
+	QueueJobForExecution(sectorGraphUpdateJob);
+
+	for (int sectorIndex : m_dirtySectors) {
+		m_isSectorDirty[sectorIndex] = 0;
+	}
+	m_dirtySectors.clear();
+}
+
 void Colony::QueueJobForExecution(ColonyJob* newJob)
 {
 	m_queuedJobsMutex.lock();
 	m_queuedJobs.push_back(newJob);
-	m_queuedJobsMutex.unlock();
 	m_queuedJobsAmount++;
+	m_queuedJobsMutex.unlock();
 }
 
 ColonyJob* Colony::ClaimJobForExecution()
 {
+	// Every thread polls for jobs in a tight loop, so only take the lock when there is something to claim
+	if (m_queuedJobsAmount == 0) return nullptr;
+
 	ColonyJob* jobToExecute = nullptr;
 
 	m_queuedJobsMutex.lock();
 	if (!m_queuedJobs.empty()) {
-		bool foundJob = false;
-		std::deque<ColonyJob*>::iterator foundJobIt;
-		for (std::deque<ColonyJob*>::iterator dequeIt = m_queuedJobs.begin(); dequeIt != m_queuedJobs.end() && !foundJob; dequeIt++) {
-			if (*dequeIt) {
-				jobToExecute = *dequeIt;
-				foundJob = true;
-				foundJobIt = dequeIt;
-			}
-		}
-		if (foundJob) {
-			m_queuedJobs.erase(foundJobIt);
-		}
+		jobToExecute = m_queuedJobs.front();
+		m_queuedJobs.pop_front();
+		m_queuedJobsAmount--;
 	}
 	m_queuedJobsMutex.unlock();
 
-	if (jobToExecute) {
-		m_queuedJobsAmount--;
+	return jobToExecute;
+}
+
+void Colony::ComputeAntOrder(int antIndex)
+{
+	Ant& ant = m_colony[antIndex];
+	if (ant.m_isGuardian && (ant.GetPosition() == ant.m_guardedAnt->GetPosition())) {
+		m_antOrders[antIndex] = ant.m_guardedAnt->m_nextMove;
+		return;
 	}
 
-	return jobToExecute;
+	m_antOrders[antIndex] = ant.GetOrder();
+}
+
+void Colony::FinishOrderBatch()
+{
+	if (--m_orderBatchesLeft == 0) {
+		FinishOrderPhase();
+	}
+}
+
+void Colony::QueueOrderBatches()
+{
+	int numThreads = g_threadSafe_threadCount;
+	if (numThreads < 1) numThreads = 1;
+
+	std::vector<int> antIndexesByType[NUM_AGENT_TYPES];
+	for (int antIndex = 0, liveAntIndex = 0; liveAntIndex < (int)m_liveAnts; antIndex++) {
+		Ant const& ant = m_colony[antIndex];
+		if (ant.m_state == STATE_DEAD) continue;
+		liveAntIndex++;
+		if (ant.m_type == AGENT_TYPE_SOLDIER) continue;
+
+		antIndexesByType[ant.m_type].push_back(antIndex);
+	}
+
+	for (Ant* soldier : m_soldierAnts) {
+		if (!soldier) continue;
+		antIndexesByType[AGENT_TYPE_SOLDIER].push_back((int)(soldier - m_colony));
+	}
+
+	// Queens share the birth schedule and scouts the unexplored tiles list, so each of those stays in a single batch
+	std::vector<ColonyJob*> batches;
+	AddOrderBatches(batches, antIndexesByType[AGENT_TYPE_QUEEN], 1);
+	AddOrderBatches(batches, antIndexesByType[AGENT_TYPE_SCOUT], 1);
+	AddOrderBatches(batches, antIndexesByType[AGENT_TYPE_WORKER], numThreads);
+	AddOrderBatches(m_soldierOrderBatches, antIndexesByType[AGENT_TYPE_SOLDIER], numThreads);
+
+	QueueOrderBatchJobs(batches);
+}
+
+void Colony::AddOrderBatches(std::vector<ColonyJob*>& batches, std::vector<int> const& antIndexes, int maxBatches)
+{
+	if (antIndexes.empty()) return;
+
+	// Region, ant slot
+	std::vector<std::pair<int, int>> antsByRegion;
+	antsByRegion.reserve(antIndexes.size());
+	for (int antIndex : antIndexes) {
+		antsByRegion.emplace_back(GetRegionIndex(m_colony[antIndex].GetPosition()), antIndex);
+	}
+	std::sort(antsByRegion.begin(), antsByRegion.end());
+
+	int numAnts = (int)antsByRegion.size();
+	int numBatches = numAnts / MIN_ANTS_PER_ORDER_BATCH;
+	if (numBatches > maxBatches) numBatches = maxBatches;
+	if (numBatches < 1) numBatches = 1;
+
+	for (int batchIndex = 0; batchIndex < numBatches; batchIndex++) {
+		int firstAnt = (numAnts * batchIndex) / numBatches;
+		int endAnt = (numAnts * (batchIndex + 1)) / numBatches;
+
+		std::vector<int> batchAntIndexes;
+		batchAntIndexes.reserve(endAnt - firstAnt);
+		for (int sortedIndex = firstAnt; sortedIndex < endAnt; sortedIndex++) {
+			batchAntIndexes.push_back(antsByRegion[sortedIndex].second);
+		}
+		batches.push_back(new AntOrdersJob(this, batchAntIndexes));
+	}
+}
+
+void Colony::QueueOrderBatchJobs(std::vector<ColonyJob*> const& batches)
+{
+	if (batches.empty()) {
+		FinishOrderPhase();
+		return;
+	}
+
+	m_orderBatchesLeft = (int)batches.size();
+	for (ColonyJob* batch : batches) {
+		QueueJobForExecution(batch);
+	}
+}
+
+void Colony::FinishOrderPhase()
+{
+	if (!m_soldierOrderBatches.empty()) {
+		std::vector<ColonyJob*> soldierBatches;
+		soldierBatches.swap(m_soldierOrderBatches);
+		QueueOrderBatchJobs(soldierBatches);
+		return;
+	}
+
+	MergeOrders();
+}
+
+void Colony::MergeOrders()
+{
+	PlayerTurnOrders newOrders = {};
+	newOrders.numberOfOrders = (int)m_liveAnts;
+
+	int orderIndex = 0;
+	for (int antIndex = 0, liveAntIndex = 0; liveAntIndex < (int)m_liveAnts; antIndex++) {
+		Ant const& ant = m_colony[antIndex];
+		if (ant.m_state == STATE_DEAD) continue;
+		liveAntIndex++;
+		if (ant.m_type == AGENT_TYPE_SOLDIER) continue;
+
+		AgentOrder& currentOrder = newOrders.orders[orderIndex];
+		currentOrder.agentID = ant.m_agentID;
+		currentOrder.order = m_antOrders[antIndex];
+		orderIndex++;
+	}
+
+	for (Ant* soldier : m_soldierAnts) {
+		if (!soldier) continue;
+		AgentOrder& currentOrder = newOrders.orders[orderIndex];
+		currentOrder.agentID = soldier->m_agentID;
+		currentOrder.order = m_antOrders[soldier - m_colony];
+		orderIndex++;
+	}
+
+	AppointAllPendingGuards();
+	ReleaseAllPendingGuards();
+	UpdateOrders(newOrders);
+}
+
+int Colony::GetRegionIndex(IntVec2 const& tileCoords) const
+{
+	// Same 4x4 regions as the food density mip map
+	int regionWidth = m_startupInfo.matchInfo.mapWidth / 4;
+	if (regionWidth < 1) return 0;
+
+	return ((tileCoords.y / regionWidth) * 4) + (tileCoords.x / regionWidth);
 }
 
 
 
-bool Colony::SetTileHeatmapValue(TileHeatMap& heatmap, eAgentType agentType, int tileIndex, float currentValue)
+void Colony::RepairHeatMap(TileHeatMap& heatmap, eAgentType agentType, std::vector<int> const& costlierTiles, std::vector<eTileType> const& tileTypes)
 {
-	if (IsTileSolid(tileIndex, agentType)) return false;
+	// Tile costs only go up, so a value can only be wrong if it was reached through one of the costlier tiles. Those
+	// values are cleared and filled back in from the still valid tiles around them
+	int numTiles = (int)tileTypes.size();
+	std::vector<unsigned char> isInvalid(numTiles, 0);
+	std::vector<int> invalidTiles;
+	for (int tileIndex : costlierTiles) {
+		if (isInvalid[tileIndex]) continue;
+		// Goals keep their value, but nothing can be reached through one that turned solid
+		if ((heatmap.GetValue(tileIndex) == 0.0f) && !IsTileTypeSolid(tileTypes[tileIndex], agentType)) continue;
+
+		isInvalid[tileIndex] = 1;
+		invalidTiles.push_back(tileIndex);
+	}
+
+	// Values are still the old ones here: a neighbor exactly one step costlier may have been reached through this tile
+	for (int invalidIndex = 0; invalidIndex < (int)invalidTiles.size(); invalidIndex++) {
+		int tileIndex = invalidTiles[invalidIndex];
+		float tileValue = heatmap.GetValue(tileIndex);
+		if (tileValue == FLT_MAX) continue;
+
+		IntVec2 tileCoords = GetTileCoords(tileIndex);
+		int neighborIndexes[] = {
+			GetTileIndex(tileCoords.x, tileCoords.y + 1),
+			GetTileIndex(tileCoords.x, tileCoords.y - 1),
+			GetTileIndex(tileCoords.x + 1, tileCoords.y),
+			GetTileIndex(tileCoords.x - 1, tileCoords.y)
+		};
+
+		for (int neighborIndex : neighborIndexes) {
+			if ((neighborIndex == -1) || isInvalid[neighborIndex]) continue;
+
+			float neighborValue = heatmap.GetValue(neighborIndex);
+			if ((neighborValue == 0.0f) || (neighborValue == FLT_MAX)) continue;
+			if (neighborValue != tileValue + GetTileTypeCost(tileTypes[neighborIndex], agentType)) continue;
+
+			isInvalid[neighborIndex] = 1;
+			invalidTiles.push_back(neighborIndex);
+		}
+	}
+
+	for (int tileIndex : invalidTiles) {
+		if (heatmap.GetValue(tileIndex) == 0.0f) continue;
+		heatmap.SetValue(tileIndex, FLT_MAX);
+	}
+
+	// Value, tile
+	typedef std::pair<float, int> OpenTile;
+	std::priority_queue<OpenTile, std::vector<OpenTile>, std::greater<OpenTile>> openTiles;
+
+	for (int tileIndex : invalidTiles) {
+		if (IsTileTypeSolid(tileTypes[tileIndex], agentType)) continue;
+
+		IntVec2 tileCoords = GetTileCoords(tileIndex);
+		int neighborIndexes[] = {
+			GetTileIndex(tileCoords.x, tileCoords.y + 1),
+			GetTileIndex(tileCoords.x, tileCoords.y - 1),
+			GetTileIndex(tileCoords.x + 1, tileCoords.y),
+			GetTileIndex(tileCoords.x - 1, tileCoords.y)
+		};
+
+		float tileCost = GetTileTypeCost(tileTypes[tileIndex], agentType);
+		float bestValue = FLT_MAX;
+		for (int neighborIndex : neighborIndexes) {
+			if ((neighborIndex == -1) || isInvalid[neighborIndex]) continue;
+			if (IsTileTypeSolid(tileTypes[neighborIndex], agentType)) continue;
+
+			float neighborValue = heatmap.GetValue(neighborIndex);
+			if ((neighborValue != FLT_MAX) && ((neighborValue + tileCost) < bestValue)) {
+				bestValue = neighborValue + tileCost;
+			}
+		}
+
+		if (bestValue != FLT_MAX) {
+			heatmap.SetValue(tileIndex, bestValue);
+			openTiles.emplace(bestValue, tileIndex);
+		}
+	}
+
+	while (!openTiles.empty()) {
+		OpenTile currentTile = openTiles.top();
+		openTiles.pop();
+		if (currentTile.first > heatmap.GetValue(currentTile.second)) continue;
+
+		IntVec2 tileCoords = GetTileCoords(currentTile.second);
+		int neighborIndexes[] = {
+			GetTileIndex(tileCoords.x, tileCoords.y + 1),
+			GetTileIndex(tileCoords.x, tileCoords.y - 1),
+			GetTileIndex(tileCoords.x + 1, tileCoords.y),
+			GetTileIndex(tileCoords.x - 1, tileCoords.y)
+		};
+
+		for (int neighborIndex : neighborIndexes) {
+			if (neighborIndex == -1) continue;
+			if (SetTileHeatmapValue(heatmap, agentType, neighborIndex, currentTile.first, tileTypes)) {
+				openTiles.emplace(heatmap.GetValue(neighborIndex), neighborIndex);
+			}
+		}
+	}
+}
+
+bool Colony::SetTileHeatmapValue(TileHeatMap& heatmap, eAgentType agentType, int tileIndex, float currentValue, std::vector<eTileType> const& tileTypes)
+{
+	eTileType tileType = tileTypes[tileIndex];
+	if (IsTileTypeSolid(tileType, agentType)) return false;
 
 	float const& tileValue = heatmap.GetValue(tileIndex);
-	float tileCost = GetTileCost(tileIndex, agentType);
+	float tileCost = GetTileTypeCost(tileType, agentType);
 	float possibleValue = currentValue + tileCost;
 	if (possibleValue < tileValue) {
 		heatmap.SetValue(tileIndex, possibleValue);
@@ -1025,12 +1461,27 @@ bool Colony::SetTileHeatmapValue(TileHeatMap& heatmap, eAgentType agentType, int
 	return false;
 }
 
+void Colony::UpdateTileTypes()
+{
+	if (!m_areTileTypesDirty) return;
+
+	std::shared_ptr<std::vector<eTileType>> tileTypes = std::make_shared<std::vector<eTileType>>(m_tiles.size());
+	for (int tileIndex = 0; tileIndex < (int)m_tiles.size(); tileIndex++) {
+		(*tileTypes)[tileIndex] = m_tiles[tileIndex].m_type;
+	}
+	m_tileTypes = tileTypes;
+	m_areTileTypesDirty = false;
+}
+
 bool Colony::IsTileSolid(int tileIndex, eAgentType agentType) const
 {
-	Tile const& tile = m_tiles[tileIndex];
+	return IsTileTypeSolid(m_tiles[tileIndex].m_type, agentType);
+}
 
-	unsigned char tileTypeMask = (1 << tile.m_type);
-	if (tile.m_type == TILE_TYPE_UNSEEN) return false;
+bool Colony::IsTileTypeSolid(eTileType tileType, eAgentType agentType)
+{
+	unsigned char tileTypeMask = (1 << tileType);
+	if (tileType == TILE_TYPE_UNSEEN) return false;
 
 	unsigned char comparisonResult = 0;
 
@@ -1127,9 +1578,11 @@ void Colony::ScheduleForBirth(eAgentType agentType)
 	}
 }
 
-void Colony::ScheduleForDeath(eAgentType agentType)
+bool Colony::TryScheduleForDeath(eAgentType agentType)
 {
-	m_scheduledForDeath |= (1 << agentType);
+	unsigned char typeFlag = (unsigned char)(1 << agentType);
+	unsigned char previousFlags = m_scheduledForDeath.fetch_or(typeFlag);
+	return (previousFlags & typeFlag) == 0;
 }
 
 int Colony::HowManyWillBeBorn(eAgentType agentType) const
@@ -1173,7 +1626,9 @@ void Colony::FlagFoodAsTaken(IntVec2 const& coords)
 	if (tileIndex == -1) return;
 	//m_tiles[tileIndex].m_hasFood = false;
 
+	m_foodDensityMutex.lock();
 	m_foodDensityMap.SetValue(tileIndex, -1.0f);
+	m_foodDensityMutex.unlock();
 	/*for (IntVec2& tileCoords : m_tilesWithFood) {
 		if (tileCoords == coords) {
 			tileCoords = IntVec2(-1, -1);
@@ -1185,7 +1640,9 @@ void Colony::ResetFoodDensity(IntVec2 const& coords)
 {
 	int tileIndex = GetTileIndex(coords.x, coords.y);
 	if (tileIndex == -1) return;
+	m_foodDensityMutex.lock();
 	m_foodDensityMap.SetValue(tileIndex, 0.0f);
+	m_foodDensityMutex.unlock();
 }
 
 void Colony::RegisterSoldierAStartRequest()
@@ -1195,12 +1652,15 @@ void Colony::RegisterSoldierAStartRequest()
 
 float Colony::GetTileCost(int tileIndex, eAgentType agentType) const
 {
-	if (IsTileSolid(tileIndex, agentType)) return FLT_MAX;
+	return GetTileTypeCost(m_tiles[tileIndex].m_type, agentType);
+}
 
-	Tile const& tile = m_tiles[tileIndex];
+float Colony::GetTileTypeCost(eTileType tileType, eAgentType agentType)
+{
+	if (IsTileTypeSolid(tileType, agentType)) return FLT_MAX;
 
-	if (tile.m_type == TILE_TYPE_WATER) return 6.0f;
-	if (tile.m_type == TILE_TYPE_DIRT) {
+	if (tileType == TILE_TYPE_WATER) return 6.0f;
+	if (tileType == TILE_TYPE_DIRT) {
 		if (agentType == AGENT_TYPE_SCOUT) {
 			return 1.0f;
 		}
@@ -1277,6 +1737,7 @@ IntVec2 Colony::GetClosestFoodGoal(IntVec2 const& tilecoords, std::vector<IntVec
 {
 	int bestDistance = INT_MAX;
 	IntVec2 closestGoal = IntVec2(-1, -1);
+	m_foodDensityMutex.lock();
 	for (IntVec2 const& goalCoords : goals) {
 		if (m_foodDensityMap.GetValue(goalCoords) < 0.0f) continue;
 		int distToGoal = (int)GetAStarHeuristic(tilecoords, goalCoords);
@@ -1285,6 +1746,7 @@ IntVec2 Colony::GetClosestFoodGoal(IntVec2 const& tilecoords, std::vector<IntVec
 			closestGoal = goalCoords;
 		}
 	}
+	m_foodDensityMutex.unlock();
 
 	return closestGoal;
 }
@@ -2,23 +2,33 @@
 #include "Engine/Core/HeatMaps.hpp"
 #include "Tile.hpp"
 #include "Ant.hpp"
+#include "SectorGraph.hpp"
+#include <memory>
 struct StartupInfo;
 
 class ColonyJob;
 
+// Published heatmaps are never written to again. Holding one keeps it alive, so readers need no lock and never copy it,
+// while a rebuilt heatmap is swapped in behind them; the old one is freed when its last reader lets go of it
+typedef std::shared_ptr<TileHeatMap const> HeatmapSnapshot;
+
 class Colony {
 public:
 	Colony(StartupInfo const& startupInfo);
 	void Update();
 	void AsyncUpdate();
-	TileHeatMap GetHeatmap(eAgentType agentType, bool lookingForQueen = false);
-	int GetTurnNumber() const { return m_currentTurnInfo.turnNumber; }
+	HeatmapSnapshot GetHeatmap(eAgentType agentType, bool lookingForQueen = false) const;
+	int GetTurnNumber() const { return m_currentTurnInfo->turnNumber; }
 	int GetNutrients() const;
-	void RecalculateHeatMap(TileHeatMap& heatmap, eAgentType agentType);
+	void RecalculateHeatMap(TileHeatMap& heatmap, eAgentType agentType, std::vector<eTileType> const& tileTypes);
+	void RepairHeatMap(TileHeatMap& heatmap, eAgentType agentType, std::vector<int> const& costlierTiles, std::vector<eTileType> const& tileTypes);
+	void RebuildSectorGraphs(std::vector<int> const& dirtySectors, std::vector<eTileType> const& tileTypes);
 	void QueueJobForExecution(ColonyJob* newJob);
 	ColonyJob* ClaimJobForExecution();
-	void UpdateHeatmap(TileHeatMap const& updatedHeatmap, eAgentType agentType, bool lookingForQueen = false);
+	void PublishHeatmap(std::shared_ptr<TileHeatMap> const& updatedHeatmap, eAgentType agentType, bool lookingForQueen = false);
 	void UpdateOrders(PlayerTurnOrders const& newOrders);
+	void ComputeAntOrder(int antIndex);
+	void FinishOrderBatch();
 	void ProcessTurnInfo();
 	void GetUnexploredTiles(std::vector<IntVec2>& tileCoordsContainer) const;
 	
@@ -26,6 +36,10 @@ public:
 	bool IsTileSolid(IntVec2 const& tileCoords, eAgentType agentType) const;
 	bool IsTileDirt(int tileIndex) const;
 	bool IsTileDirt(IntVec2 const& tileCoords) const;
+	float GetTileCost(int tileIndex, eAgentType agentType) const;
+	float GetTileCost(IntVec2 const& tileCoords, eAgentType agentType) const;
+	static bool IsTileTypeSolid(eTileType tileType, eAgentType agentType);
+	static float GetTileTypeCost(eTileType tileType, eAgentType agentType);
 
 	int GetCostToBirth(eAgentType agentType) const;
 	int GetSightRadius(eAgentType agentType) const;
@@ -34,7 +48,8 @@ public:
 	void ScheduleForBirth(eAgentType agentType);
 	int HowManyWillBeBorn(eAgentType agentType) const;
 
-	void ScheduleForDeath(eAgentType agentType);
+	// Only one ant of each type gets to suicide per turn: true for the ant that claimed it
+	bool TryScheduleForDeath(eAgentType agentType);
 	bool IsScheduledForDeath(eAgentType agentType) const;
 	IntVec2 GetRandNonSolidCoords() const;
 
@@ -73,8 +88,8 @@ public:
 	unsigned int m_queensToBirth = 0;
 	unsigned int m_scoutsToBirth = 0;
 	unsigned int m_soldiersToBirth = 0;
-	int m_aStarsRequested = 0;
-	int m_aStarsRequestedSoldiers = 0;
+	std::atomic<int> m_aStarsRequested = 0;
+	std::atomic<int> m_aStarsRequestedSoldiers = 0;
 
 	std::atomic<unsigned char> m_scheduledForDeath = 0;
 	std::atomic<unsigned int> m_foodCount = 0;
@@ -106,13 +121,21 @@ private:
 	void AddVertsForSquare(std::vector<VertexPC>& verts, float size, int x, int y, Color8 color);
 
 	void RecalculateHeatmapToQueens();
+	void RepairHeatmapToQueens();
 	void RecalculateQueenFoodmap();
 	void RecalculateSoldierAttackmap();
 
-	bool SetTileHeatmapValue(TileHeatMap& heatmap, eAgentType agentType, int tileIndex, float currentValue);
+	void QueueOrderBatches();
+	void AddOrderBatches(std::vector<ColonyJob*>& batches, std::vector<int> const& antIndexes, int maxBatches);
+	void QueueOrderBatchJobs(std::vector<ColonyJob*> const& batches);
+	void FinishOrderPhase();
+	void MergeOrders();
+	int GetRegionIndex(IntVec2 const& tileCoords) const;
 
-	float GetTileCost(int tileIndex, eAgentType agentType) const;
-	float GetTileCost(IntVec2 const& tileCoords, eAgentType agentType) const;
+	bool SetTileHeatmapValue(TileHeatMap& heatmap, eAgentType agentType, int tileIndex, float currentValue, std::vector<eTileType> const& tileTypes);
+	void UpdateTileTypes();
+	void MarkSectorsDirty(int tileIndex);
+	void QueueSectorGraphRebuild();
 
 	void ConstructPathForAStar(std::vector<IntVec2>& pathContainer, std::map<IntVec2, IntVec2> const& cameFromMap, IntVec2 const& goalCoords) const;
 	float GetAStarHeuristic(IntVec2 const& tileCoords, std::vector<IntVec2> const& goals, bool avoidEnemies = false);
@@ -125,30 +148,61 @@ private:
 	Ant& GetFreeAntSlot();
 	Ant& GetAnt(AgentID agentId, bool& out_wasSuccessful);
 	StartupInfo m_startupInfo = {};
-	ArenaTurnStateForPlayer m_currentTurnInfo = {};
+	ArenaTurnStateForPlayer const* m_currentTurnInfo = nullptr; // Front buffer of g_threadSafe_turnInfo; order batches read it in place until the turn's orders are merged
 	Ant m_colony[MAX_AGENTS_PER_PLAYER] = {};
 
-	std::mutex m_heatmapsMutex;
+	HeatmapSnapshot* GetPublishedHeatmapSlot(eAgentType agentType, bool lookingForQueen);
+	HeatmapSnapshot const* GetPublishedHeatmapSlot(eAgentType agentType, bool lookingForQueen) const;
+
+	// Only accessed through std::atomic_load/atomic_store
+	HeatmapSnapshot m_heatmapToQueens;
+	HeatmapSnapshot m_queenFoodMap;
+	HeatmapSnapshot m_soldierAttackMap;
 
-	TileHeatMap m_heatmapToQueens;
-	TileHeatMap m_queenFoodMap;
 	TileHeatMap m_solidMap;
 	TileHeatMap m_foodDensityMap;
 	TileHeatMap m_enemyHistoryMap;
-	TileHeatMap m_soldierAttackMap;
 	std::vector<int> m_foodDensityMipMap;
-	bool m_heatmapToQueensDirty = true;
+	bool m_heatmapToQueensDirty = true; // Queens moved, needs a full rebuild
+	std::vector<int> m_heatmapToQueensRepairTiles; // Tiles seen for the first time that cost workers more than unseen ones
+	std::atomic<bool> m_isHeatmapToQueensBeingBuilt = false;
+	TileTypesSnapshot m_tileTypes;				// Refreshed once a turn, before any job is queued, and only if a tile changed type
+	bool m_areTileTypesDirty = true;
+	// One graph per agent type, since they differ in which tiles are solid and what dirt costs. Only accessed through
+	// std::atomic_load/atomic_store
+	SectorGraphSnapshot m_sectorGraphs[NUM_AGENT_TYPES];
+	std::vector<int> m_dirtySectors;			// Sectors with a tile that changed cost since the last rebuild was queued
+	std::vector<unsigned char> m_isSectorDirty;
+	std::atomic<bool> m_isSectorGraphBeingBuilt = false;
 	bool m_workerFoodmapDirty = true;
 	bool m_queenFoodMapDirty = true;
 	int m_lastQueenFoodUpdate = 0;
 	int m_lastSoldierUpdate = 0;
 
 	std::vector<Tile> m_tiles;
-	std::atomic<bool> m_areCalculationsDone = false;
+
+	// Last turn's observation. Only the tiles that differ from it are processed
+	std::vector<eTileType> m_previousObservedTiles;
+	std::vector<unsigned char> m_previousTilesWithFood;
+	std::vector<int> m_changedTiles;
+	std::vector<int> m_foodTiles;				// Tiles believed to hold food
+	std::vector<int> m_foodTileSlots;			// Per tile, position in m_foodTiles or -1
+	std::vector<int> m_densityTiles;			// Tiles with a positive food density, ascending
+	std::vector<unsigned char> m_isDensityTile;
+	int m_numUnexploredTiles = 0;				// Anything past this in m_unexploredTiles was added by scouts as a goal
+	std::atomic<bool> m_areCalculationsDone = true;		// False while a turn's order batches are in flight
 
 	mutable std::mutex m_queuedJobsMutex;
 	std::deque<ColonyJob*> m_queuedJobs;
-	std::atomic<int> m_queuedJobsAmount;
+	std::atomic<int> m_queuedJobsAmount = 0;
+
+	// Ant orders are computed in batches by whichever threads are free. Each ant writes to its own slot and the slots are
+	// merged in a fixed order once every batch is done. Soldier batches wait for the others: guards copy the move of the
+	// ant they guard
+	eOrderCode m_antOrders[MAX_AGENTS_PER_PLAYER] = {};
+	std::vector<ColonyJob*> m_soldierOrderBatches;
+	std::atomic<int> m_orderBatchesLeft = 0;
+	mutable std::mutex m_foodDensityMutex; // Workers of different batches claim food concurrently
 
 	std::mutex m_ordersMutex;
 	PlayerTurnOrders m_turnOrders = {};
@@ -1,108 +1,60 @@
 #include "ColonyJob.hpp"
 #include "Colony.hpp"
 
-HeatmapUpdateJob::HeatmapUpdateJob(Colony* colony, IntVec2 const& heatmapDims, std::vector<IntVec2> const& goals, eAgentType agentType, bool lookingForQueen) :
-	m_heatmapCopy(heatmapDims),
+HeatmapUpdateJob::HeatmapUpdateJob(Colony* colony, IntVec2 const& heatmapDims, std::vector<IntVec2> const& goals, eAgentType agentType, bool lookingForQueen, TileTypesSnapshot const& tileTypes) :
+	ColonyJob(colony),
+	m_heatmap(std::make_shared<TileHeatMap>(heatmapDims)),
 	m_agentType(agentType),
-	m_lookingForQueen(lookingForQueen),
 	m_goals(goals),
-	ColonyJob(colony)
+	m_lookingForQueen(lookingForQueen),
+	m_tileTypes(tileTypes)
 {
 
 }
 
 void HeatmapUpdateJob::Execute()
 {
-	m_heatmapCopy.SetAllValues(FLT_MAX);
+	m_heatmap->SetAllValues(FLT_MAX);
 	for (IntVec2 const& goal : m_goals) {
-		m_heatmapCopy.SetValue(goal, 0.0f);
+		m_heatmap->SetValue(goal, 0.0f);
 	}
-	m_colony->RecalculateHeatMap(m_heatmapCopy, m_agentType);
-	m_colony->UpdateHeatmap(m_heatmapCopy, m_agentType, m_lookingForQueen);
+	m_colony->RecalculateHeatMap(*m_heatmap, m_agentType, *m_tileTypes);
+	m_colony->PublishHeatmap(m_heatmap, m_agentType, m_lookingForQueen);
 	m_isFinished = true;
 }
 
-void OrderProcessingJob::Execute()
+HeatmapRepairJob::HeatmapRepairJob(Colony* colony, std::shared_ptr<TileHeatMap const> const& baseHeatmap, std::vector<int> const& costlierTiles, eAgentType agentType, bool lookingForQueen, TileTypesSnapshot const& tileTypes) :
+	ColonyJob(colony),
+	m_baseHeatmap(baseHeatmap),
+	m_costlierTiles(costlierTiles),
+	m_agentType(agentType),
+	m_lookingForQueen(lookingForQueen),
+	m_tileTypes(tileTypes)
 {
-	Ant* colony = m_colony->GetColony();
-
-	PlayerTurnOrders newOrders = {};
-	newOrders.numberOfOrders = (int)m_colony->m_liveAnts;
-
-	int orderIndex = 0;
-	int liveAnts = (int)m_colony->m_liveAnts;
-
-	for (int antIndex = 0, liveAntIndex = 0; liveAntIndex < liveAnts; antIndex++) {
-		Ant& ant = colony[antIndex];
-		if (ant.m_state == STATE_DEAD) continue;
-		liveAntIndex++;
-		if (ant.m_type == AGENT_TYPE_SOLDIER) continue;
-
-		AgentOrder& currentOrder = newOrders.orders[orderIndex];
-		currentOrder.agentID = ant.m_agentID;
-		currentOrder.order = ant.GetOrder();
-		orderIndex++;
 
-	}
-
-
-	for (Ant* guard : m_colony->m_soldierAnts) {
-		if (!guard) continue;
-		AgentOrder& currentOrder = newOrders.orders[orderIndex];
-		currentOrder.agentID = guard->m_agentID;
-		orderIndex++;
-		if (guard->m_isGuardian) {
-			IntVec2 guardPos = guard->GetPosition();
-			IntVec2 guardedAntPos = guard->m_guardedAnt->GetPosition();
-			if (guardPos == guardedAntPos) {
-				currentOrder.order = guard->m_guardedAnt->m_nextMove;
-				continue;
-			}
+}
 
-		}
+void HeatmapRepairJob::Execute()
+{
+	std::shared_ptr<TileHeatMap> heatmap = std::make_shared<TileHeatMap>(*m_baseHeatmap);
+	m_colony->RepairHeatMap(*heatmap, m_agentType, m_costlierTiles, *m_tileTypes);
+	m_colony->PublishHeatmap(heatmap, m_agentType, m_lookingForQueen);
+	m_isFinished = true;
+}
 
-		currentOrder.order = guard->GetOrder();
+void SectorGraphUpdateJob::Execute()
+{
+	m_colony->RebuildSectorGraphs(m_dirtySectors, *m_tileTypes);
+	m_isFinished = true;
+}
 
+void AntOrdersJob::Execute()
+{
+	for (int antIndex : m_antIndexes) {
+		m_colony->ComputeAntOrder(antIndex);
 	}
-
-	//for (int antIndex = 0, liveAntIndex = 0; liveAntIndex < liveAnts; antIndex++) {
-	//	Ant& ant = colony[antIndex];
-
-	//	if ((ant.m_state != STATE_DEAD)) {
-	//		liveAntIndex++;
-	//		if (ant.m_isGuardian) continue;
-
-	//		AgentOrder& currentOrder = newOrders.orders[orderIndex];
-	//		currentOrder.agentID = ant.m_agentID;
-	//		currentOrder.order = ant.GetOrder();
-	//		orderIndex++;
-
-	//	}
-	//}
-
-	/*for (Ant* guard : m_colony->m_soldierAnts) {
-		if (!guard) continue;
-		if (!guard->m_isGuardian) continue;
-
-		AgentOrder& currentOrder = newOrders.orders[orderIndex];
-		currentOrder.agentID = guard->m_agentID;
-		orderIndex++;
-
-		IntVec2 guardPos = guard->GetPosition();
-		IntVec2 guardedAntPos = guard->m_guardedAnt->GetPosition();
-		if (guardPos == guardedAntPos) {
-			currentOrder.order = guard->m_guardedAnt->m_nextMove;
-		}
-		else {
-			currentOrder.order = guard->GetOrder();
-		}
-
-	}*/
-
-	m_colony->AppointAllPendingGuards();
-	m_colony->ReleaseAllPendingGuards();
-	m_colony->UpdateOrders(newOrders);
-
+	m_isFinished = true;
+	m_colony->FinishOrderBatch();
 }
 
 void ProcessTurnInfoJob::Execute()
@@ -1,6 +1,8 @@
 #pragma once
 #include "Common.hpp"
+#include "Tile.hpp"
 #include "Engine/Core/HeatMaps.hpp"
+#include <memory>
 
 class ColonyJob {
 public:
@@ -16,22 +18,54 @@ public:
 
 class HeatmapUpdateJob : public ColonyJob {
 public:
-	HeatmapUpdateJob(Colony* colony, IntVec2 const& heatmapDims, std::vector<IntVec2> const& goals, eAgentType agentType, bool lookingForQueen);
+	HeatmapUpdateJob(Colony* colony, IntVec2 const& heatmapDims, std::vector<IntVec2> const& goals, eAgentType agentType, bool lookingForQueen, TileTypesSnapshot const& tileTypes);
 
 	void Execute() override;
 public:
-	TileHeatMap m_heatmapCopy;
+	std::shared_ptr<TileHeatMap> m_heatmap; // Built here, then published as is
 	eAgentType m_agentType;
 	std::vector<IntVec2> m_goals;
 	bool m_lookingForQueen = false;
+	TileTypesSnapshot m_tileTypes;
 };
 
 
-class OrderProcessingJob : public ColonyJob {
+// Patches a published heatmap around tiles that got costlier, instead of rebuilding all of it
+class HeatmapRepairJob : public ColonyJob {
 public:
-	OrderProcessingJob(Colony* colony): ColonyJob(colony){}
+	HeatmapRepairJob(Colony* colony, std::shared_ptr<TileHeatMap const> const& baseHeatmap, std::vector<int> const& costlierTiles, eAgentType agentType, bool lookingForQueen, TileTypesSnapshot const& tileTypes);
 
 	void Execute() override;
+public:
+	std::shared_ptr<TileHeatMap const> m_baseHeatmap;
+	std::vector<int> m_costlierTiles;
+	eAgentType m_agentType;
+	bool m_lookingForQueen = false;
+	TileTypesSnapshot m_tileTypes;
+};
+
+
+// Rebuilds the sectors of every agent type's sector graph whose tiles changed, then publishes the new graphs
+class SectorGraphUpdateJob : public ColonyJob {
+public:
+	SectorGraphUpdateJob(Colony* colony, std::vector<int> const& dirtySectors, TileTypesSnapshot const& tileTypes) : ColonyJob(colony), m_dirtySectors(dirtySectors), m_tileTypes(tileTypes) {}
+
+	void Execute() override;
+public:
+	std::vector<int> m_dirtySectors;
+	TileTypesSnapshot m_tileTypes;
+};
+
+
+// Computes the orders of a fixed set of ants, all of the same type. Ants are sorted by region, so ants competing for the
+// same food are handled in sequence by one thread, in the same order every turn
+class AntOrdersJob : public ColonyJob {
+public:
+	AntOrdersJob(Colony* colony, std::vector<int> const& antIndexes) : ColonyJob(colony), m_antIndexes(antIndexes) {}
+
+	void Execute() override;
+public:
+	std::vector<int> m_antIndexes;
 };
 
 
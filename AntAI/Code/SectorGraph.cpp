@@ -0,0 +1,378 @@
+#include "SectorGraph.hpp"
+#include "Colony.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <queue>
+#include <unordered_map>
+
+// Costs and the path back to the tile a search started from, for the tiles of one sector. Tiles are indexed locally,
+// SECTOR_WIDTH per row, so a search never touches more than a sector's worth of memory
+struct SectorGraph::SectorSearch {
+	IntVec2 m_mins;
+	IntVec2 m_maxs;
+	int m_sourceIndex = -1;
+	int m_targetIndex = -1;							// Search stops once this is reached, -1 to search the whole sector
+	float m_tileCosts[SECTOR_WIDTH * SECTOR_WIDTH];	// Of stepping onto each tile, FLT_MAX if solid
+	float m_costs[SECTOR_WIDTH * SECTOR_WIDTH];
+	int m_cameFrom[SECTOR_WIDTH * SECTOR_WIDTH];
+	std::vector<std::pair<float, int>> m_openTiles;	// Heap of cost, local index
+
+	bool IsInSector(IntVec2 const& tileCoords) const;
+	float GetHeuristic(int localIndex) const;
+	int GetLocalIndex(IntVec2 const& tileCoords) const { return ((tileCoords.y - m_mins.y) * SECTOR_WIDTH) + (tileCoords.x - m_mins.x); }
+};
+
+bool SectorGraph::SectorSearch::IsInSector(IntVec2 const& tileCoords) const
+{
+	return (tileCoords.x >= m_mins.x) && (tileCoords.x <= m_maxs.x) && (tileCoords.y >= m_mins.y) && (tileCoords.y <= m_maxs.y);
+}
+
+float SectorGraph::SectorSearch::GetHeuristic(int localIndex) const
+{
+	if (m_targetIndex == -1) return 0.0f;
+	IntVec2 localCoords = IntVec2(localIndex % SECTOR_WIDTH, localIndex / SECTOR_WIDTH);
+	IntVec2 targetCoords = IntVec2(m_targetIndex % SECTOR_WIDTH, m_targetIndex / SECTOR_WIDTH);
+	return (float)GetTaxicabDistance2D(localCoords, targetCoords);
+}
+
+SectorNode const* Sector::FindNode(int tileIndex) const
+{
+	for (SectorNode const& node : m_nodes) {
+		if (node.m_tileIndex == tileIndex) return &node;
+	}
+	return nullptr;
+}
+
+SectorGraph::SectorGraph(eAgentType agentType, int mapWidth) :
+	m_agentType(agentType),
+	m_mapWidth(mapWidth),
+	m_sectorsPerRow((mapWidth + SECTOR_WIDTH - 1) / SECTOR_WIDTH)
+{
+	m_sectors.resize(m_sectorsPerRow * m_sectorsPerRow);
+}
+
+int SectorGraph::GetSectorIndex(int tileIndex) const
+{
+	return GetSectorIndex(IntVec2(tileIndex % m_mapWidth, tileIndex / m_mapWidth));
+}
+
+int SectorGraph::GetSectorIndex(IntVec2 const& tileCoords) const
+{
+	return ((tileCoords.y / SECTOR_WIDTH) * m_sectorsPerRow) + (tileCoords.x / SECTOR_WIDTH);
+}
+
+void SectorGraph::GetSectorBounds(int sectorIndex, IntVec2& out_mins, IntVec2& out_maxs) const
+{
+	out_mins = IntVec2((sectorIndex % m_sectorsPerRow) * SECTOR_WIDTH, (sectorIndex / m_sectorsPerRow) * SECTOR_WIDTH);
+	out_maxs = IntVec2(out_mins.x + SECTOR_WIDTH - 1, out_mins.y + SECTOR_WIDTH - 1);
+	if (out_maxs.x >= m_mapWidth) out_maxs.x = m_mapWidth - 1;
+	if (out_maxs.y >= m_mapWidth) out_maxs.y = m_mapWidth - 1;
+}
+
+float SectorGraph::GetTileCost(int tileIndex, std::vector<eTileType> const& tileTypes) const
+{
+	return Colony::GetTileTypeCost(tileTypes[tileIndex], m_agentType);
+}
+
+void SectorGraph::RebuildSector(int sectorIndex, std::vector<eTileType> const& tileTypes)
+{
+	IntVec2 mins;
+	IntVec2 maxs;
+	GetSectorBounds(sectorIndex, mins, maxs);
+	int sectorWidth = maxs.x - mins.x + 1;
+	int sectorHeight = maxs.y - mins.y + 1;
+
+	// Both sectors of a border scan it in the same order, so they agree on where the crossings are
+	std::vector<SectorCrossing> crossings;
+	if (maxs.x < m_mapWidth - 1) AddBorderCrossings(crossings, IntVec2(maxs.x, mins.y), IntVec2(0, 1), IntVec2(1, 0), sectorHeight, tileTypes);
+	if (mins.x > 0) AddBorderCrossings(crossings, mins, IntVec2(0, 1), IntVec2(-1, 0), sectorHeight, tileTypes);
+	if (maxs.y < m_mapWidth - 1) AddBorderCrossings(crossings, IntVec2(mins.x, maxs.y), IntVec2(1, 0), IntVec2(0, 1), sectorWidth, tileTypes);
+	if (mins.y > 0) AddBorderCrossings(crossings, mins, IntVec2(1, 0), IntVec2(0, -1), sectorWidth, tileTypes);
+
+	std::shared_ptr<Sector> sector = std::make_shared<Sector>();
+	for (SectorCrossing const& crossing : crossings) {
+		if (sector->FindNode(crossing.m_tileIndex)) continue;
+		SectorNode newNode;
+		newNode.m_tileIndex = crossing.m_tileIndex;
+		sector->m_nodes.push_back(newNode);
+	}
+
+	SectorSearch search;
+	PrepareSectorSearch(search, sectorIndex, tileTypes);
+	for (SectorNode& node : sector->m_nodes) {
+		SearchSector(search, node.m_tileIndex, false);
+		for (SectorNode const& otherNode : sector->m_nodes) {
+			if (otherNode.m_tileIndex == node.m_tileIndex) continue;
+
+			IntVec2 otherCoords = IntVec2(otherNode.m_tileIndex % m_mapWidth, otherNode.m_tileIndex / m_mapWidth);
+			float costToOther = search.m_costs[search.GetLocalIndex(otherCoords)];
+			if (costToOther == FLT_MAX) continue;
+
+			SectorEdge edge;
+			edge.m_toTile = otherNode.m_tileIndex;
+			edge.m_cost = costToOther;
+			node.m_edges.push_back(edge);
+		}
+
+		for (SectorCrossing const& crossing : crossings) {
+			if (crossing.m_tileIndex != node.m_tileIndex) continue;
+
+			SectorEdge edge;
+			edge.m_toTile = crossing.m_neighborTileIndex;
+			edge.m_cost = GetTileCost(crossing.m_neighborTileIndex, tileTypes);
+			node.m_edges.push_back(edge);
+		}
+	}
+
+	m_sectors[sectorIndex] = sector;
+}
+
+void SectorGraph::AddBorderCrossings(std::vector<SectorCrossing>& crossings, IntVec2 const& borderStart, IntVec2 const& borderStep, IntVec2 const& crossingStep, int borderLength, std::vector<eTileType> const& tileTypes) const
+{
+	int openStart = -1;
+	for (int borderIndex = 0; borderIndex <= borderLength; borderIndex++) {
+		bool isOpen = false;
+		if (borderIndex < borderLength) {
+			IntVec2 tileCoords = borderStart + (borderStep * borderIndex);
+			IntVec2 neighborCoords = tileCoords + crossingStep;
+			isOpen = (GetTileCost((tileCoords.y * m_mapWidth) + tileCoords.x, tileTypes) != FLT_MAX) && (GetTileCost((neighborCoords.y * m_mapWidth) + neighborCoords.x, tileTypes) != FLT_MAX);
+		}
+
+		if (isOpen) {
+			if (openStart == -1) openStart = borderIndex;
+			continue;
+		}
+		if (openStart == -1) continue;
+
+		int openEnd = borderIndex - 1;
+		int crossingIndexes[3] = { openStart + ((openEnd - openStart) / 2), -1, -1 };
+		if ((openEnd - openStart + 1) >= SECTOR_WIDTH_FOR_THREE_CROSSINGS) {
+			crossingIndexes[1] = openStart;
+			crossingIndexes[2] = openEnd;
+		}
+
+		for (int crossingIndex : crossingIndexes) {
+			if (crossingIndex == -1) continue;
+
+			IntVec2 tileCoords = borderStart + (borderStep * crossingIndex);
+			IntVec2 neighborCoords = tileCoords + crossingStep;
+			SectorCrossing crossing;
+			crossing.m_tileIndex = (tileCoords.y * m_mapWidth) + tileCoords.x;
+			crossing.m_neighborTileIndex = (neighborCoords.y * m_mapWidth) + neighborCoords.x;
+			crossings.push_back(crossing);
+		}
+		openStart = -1;
+	}
+}
+
+void SectorGraph::PrepareSectorSearch(SectorSearch& search, int sectorIndex, std::vector<eTileType> const& tileTypes) const
+{
+	GetSectorBounds(sectorIndex, search.m_mins, search.m_maxs);
+	for (int localIndex = 0; localIndex < SECTOR_WIDTH * SECTOR_WIDTH; localIndex++) {
+		search.m_tileCosts[localIndex] = FLT_MAX;
+	}
+
+	for (int tileY = search.m_mins.y; tileY <= search.m_maxs.y; tileY++) {
+		for (int tileX = search.m_mins.x; tileX <= search.m_maxs.x; tileX++) {
+			int localIndex = ((tileY - search.m_mins.y) * SECTOR_WIDTH) + (tileX - search.m_mins.x);
+			search.m_tileCosts[localIndex] = GetTileCost((tileY * m_mapWidth) + tileX, tileTypes);
+		}
+	}
+}
+
+// Dijkstra over the tiles of the prepared sector. Towards source, costs are of going from each tile to the source instead
+// of the other way around, and m_cameFrom holds the next step towards it. Tiles outside the sector cost FLT_MAX, so the
+// search never leaves it. Given a target tile it is an A* that stops there instead, and only the costs of the tiles on
+// the way to the target are final
+void SectorGraph::SearchSector(SectorSearch& search, int sourceTile, bool isTowardsSource, int targetTile) const
+{
+	for (int localIndex = 0; localIndex < SECTOR_WIDTH * SECTOR_WIDTH; localIndex++) {
+		search.m_costs[localIndex] = FLT_MAX;
+		search.m_cameFrom[localIndex] = -1;
+	}
+
+	search.m_sourceIndex = search.GetLocalIndex(IntVec2(sourceTile % m_mapWidth, sourceTile / m_mapWidth));
+	search.m_targetIndex = (targetTile == -1) ? -1 : search.GetLocalIndex(IntVec2(targetTile % m_mapWidth, targetTile / m_mapWidth));
+	search.m_costs[search.m_sourceIndex] = 0.0f;
+
+	// Cost plus heuristic, local index
+	std::vector<std::pair<float, int>>& openTiles = search.m_openTiles;
+	std::greater<std::pair<float, int>> isLowerCost;
+	openTiles.clear();
+	openTiles.push_back(std::pair<float, int>(search.GetHeuristic(search.m_sourceIndex), search.m_sourceIndex));
+
+	while (!openTiles.empty()) {
+		std::pop_heap(openTiles.begin(), openTiles.end(), isLowerCost);
+		int currentIndex = openTiles.back().second;
+		float currentCost = openTiles.back().first - search.GetHeuristic(currentIndex);
+		openTiles.pop_back();
+		if (currentCost > search.m_costs[currentIndex]) continue;
+		if (currentIndex == search.m_targetIndex) return;
+
+		// Stepping from a neighbor onto this tile, when searching towards the source
+		float costOntoTile = (isTowardsSource) ? search.m_tileCosts[currentIndex] : 0.0f;
+		if (costOntoTile == FLT_MAX) continue;
+
+		int localX = currentIndex % SECTOR_WIDTH;
+		int localY = currentIndex / SECTOR_WIDTH;
+		int neighborIndexes[] = {
+			(localX < SECTOR_WIDTH - 1) ? currentIndex + 1 : -1,
+			(localX > 0) ? currentIndex - 1 : -1,
+			(localY < SECTOR_WIDTH - 1) ? currentIndex + SECTOR_WIDTH : -1,
+			(localY > 0) ? currentIndex - SECTOR_WIDTH : -1
+		};
+
+		for (int neighborIndex : neighborIndexes) {
+			if (neighborIndex == -1) continue;
+
+			float neighborTileCost = search.m_tileCosts[neighborIndex];
+			if (neighborTileCost == FLT_MAX) continue;
+
+			float neighborCost = currentCost + ((isTowardsSource) ? costOntoTile : neighborTileCost);
+			if (neighborCost >= search.m_costs[neighborIndex]) continue;
+
+			search.m_costs[neighborIndex] = neighborCost;
+			search.m_cameFrom[neighborIndex] = currentIndex;
+			openTiles.push_back(std::pair<float, int>(neighborCost + search.GetHeuristic(neighborIndex), neighborIndex));
+			std::push_heap(openTiles.begin(), openTiles.end(), isLowerCost);
+		}
+	}
+}
+
+int SectorGraph::GetTileIndex(SectorSearch const& search, int localIndex) const
+{
+	return ((search.m_mins.y + (localIndex / SECTOR_WIDTH)) * m_mapWidth) + search.m_mins.x + (localIndex % SECTOR_WIDTH);
+}
+
+// Appends the tiles after the source of a search up to toTile. The path must currently end at the source
+bool SectorGraph::AddSearchedPath(std::vector<int>& tilePath, SectorSearch const& search, int toTile) const
+{
+	IntVec2 toCoords = IntVec2(toTile % m_mapWidth, toTile / m_mapWidth);
+	if (!search.IsInSector(toCoords)) return false;
+
+	int toIndex = search.GetLocalIndex(toCoords);
+	if (search.m_costs[toIndex] == FLT_MAX) return false;
+
+	size_t firstAddedIndex = tilePath.size();
+	for (int localIndex = toIndex; localIndex != search.m_sourceIndex; localIndex = search.m_cameFrom[localIndex]) {
+		tilePath.push_back(GetTileIndex(search, localIndex));
+	}
+	std::reverse(tilePath.begin() + firstAddedIndex, tilePath.end());
+	return true;
+}
+
+bool SectorGraph::FindPath(std::vector<IntVec2>& resultPath, IntVec2 const& start, IntVec2 const& goal, std::vector<eTileType> const& tileTypes, float heuristicWeight) const
+{
+	int startTile = (start.y * m_mapWidth) + start.x;
+	int goalTile = (goal.y * m_mapWidth) + goal.x;
+	int startSector = GetSectorIndex(start);
+	int goalSector = GetSectorIndex(goal);
+	if ((startSector == goalSector) || !m_sectors[startSector] || !m_sectors[goalSector]) return false;
+
+	SectorSearch startSearch;
+	SectorSearch goalSearch;
+	PrepareSectorSearch(startSearch, startSector, tileTypes);
+	SearchSector(startSearch, startTile, false);
+	PrepareSectorSearch(goalSearch, goalSector, tileTypes);
+	SearchSector(goalSearch, goalTile, true);
+
+	// A* over the crossings, from the ones the start can reach in its sector to the ones that reach the goal in its own
+	typedef std::pair<float, int> OpenNode;
+	std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode>> openNodes;
+	std::unordered_map<int, float> nodeCosts;
+	std::unordered_map<int, int> nodeCameFrom;
+
+	for (SectorNode const& node : m_sectors[startSector]->m_nodes) {
+		IntVec2 nodeCoords = IntVec2(node.m_tileIndex % m_mapWidth, node.m_tileIndex / m_mapWidth);
+		float nodeCost = startSearch.m_costs[startSearch.GetLocalIndex(nodeCoords)];
+		if (nodeCost == FLT_MAX) continue;
+
+		nodeCosts[node.m_tileIndex] = nodeCost;
+		nodeCameFrom[node.m_tileIndex] = startTile;
+		openNodes.push(OpenNode(nodeCost + ((float)GetTaxicabDistance2D(nodeCoords, goal) * heuristicWeight), node.m_tileIndex));
+	}
+
+	float bestPathCost = FLT_MAX;
+	int lastNodeTile = -1;
+	while (!openNodes.empty()) {
+		OpenNode currentNode = openNodes.top();
+		openNodes.pop();
+		if (currentNode.first >= bestPathCost) break;
+
+		int nodeTile = currentNode.second;
+		IntVec2 nodeCoords = IntVec2(nodeTile % m_mapWidth, nodeTile / m_mapWidth);
+		float nodeCost = nodeCosts[nodeTile];
+		if (currentNode.first > nodeCost + ((float)GetTaxicabDistance2D(nodeCoords, goal) * heuristicWeight)) continue;
+
+		int nodeSector = GetSectorIndex(nodeCoords);
+		if (nodeSector == goalSector) {
+			float costToGoal = goalSearch.m_costs[goalSearch.GetLocalIndex(nodeCoords)];
+			if ((costToGoal != FLT_MAX) && (nodeCost + costToGoal < bestPathCost)) {
+				bestPathCost = nodeCost + costToGoal;
+				lastNodeTile = nodeTile;
+			}
+		}
+
+		Sector const* sector = m_sectors[nodeSector].get();
+		SectorNode const* node = (sector) ? sector->FindNode(nodeTile) : nullptr;
+		if (!node) continue;
+
+		for (SectorEdge const& edge : node->m_edges) {
+			float newCost = nodeCost + edge.m_cost;
+			std::unordered_map<int, float>::const_iterator foundCost = nodeCosts.find(edge.m_toTile);
+			if ((foundCost != nodeCosts.end()) && (foundCost->second <= newCost)) continue;
+
+			nodeCosts[edge.m_toTile] = newCost;
+			nodeCameFrom[edge.m_toTile] = nodeTile;
+			IntVec2 toCoords = IntVec2(edge.m_toTile % m_mapWidth, edge.m_toTile / m_mapWidth);
+			openNodes.push(OpenNode(newCost + ((float)GetTaxicabDistance2D(toCoords, goal) * heuristicWeight), edge.m_toTile));
+		}
+	}
+
+	if (lastNodeTile == -1) return false;
+
+	std::vector<int> crossingPath;
+	for (int nodeTile = lastNodeTile; nodeTile != startTile; nodeTile = nodeCameFrom[nodeTile]) {
+		crossingPath.push_back(nodeTile);
+	}
+	crossingPath.push_back(startTile);
+	std::reverse(crossingPath.begin(), crossingPath.end());
+
+	// Refine: each step between crossings is either across a border, or a path inside one sector. The graph may be a
+	// turn behind the tiles, in which case a step can turn out blocked and the caller falls back to a flat search
+	std::vector<int> tilePath;
+	tilePath.push_back(startTile);
+	SectorSearch refineSearch;
+	for (int crossingIndex = 1; crossingIndex < (int)crossingPath.size(); crossingIndex++) {
+		int fromTile = crossingPath[crossingIndex - 1];
+		int toTile = crossingPath[crossingIndex];
+		int fromSector = GetSectorIndex(fromTile);
+		if (fromSector != GetSectorIndex(toTile)) {
+			if (GetTileCost(toTile, tileTypes) == FLT_MAX) return false;
+			tilePath.push_back(toTile);
+			continue;
+		}
+
+		if (fromTile == startTile) {
+			if (!AddSearchedPath(tilePath, startSearch, toTile)) return false;
+			continue;
+		}
+
+		PrepareSectorSearch(refineSearch, fromSector, tileTypes);
+		SearchSector(refineSearch, fromTile, false, toTile);
+		if (!AddSearchedPath(tilePath, refineSearch, toTile)) return false;
+	}
+
+	int lastNodeIndex = goalSearch.GetLocalIndex(IntVec2(lastNodeTile % m_mapWidth, lastNodeTile / m_mapWidth));
+	for (int localIndex = goalSearch.m_cameFrom[lastNodeIndex]; localIndex != -1; localIndex = goalSearch.m_cameFrom[localIndex]) {
+		tilePath.push_back(GetTileIndex(goalSearch, localIndex));
+	}
+
+	// Same layout as Colony::ConstructPathForAStar: the goal, then every tile from the goal back to the start
+	resultPath.push_back(goal);
+	for (int pathIndex = (int)tilePath.size() - 1; pathIndex >= 0; pathIndex--) {
+		int tileIndex = tilePath[pathIndex];
+		resultPath.emplace_back(tileIndex % m_mapWidth, tileIndex / m_mapWidth);
+	}
+	return true;
+}
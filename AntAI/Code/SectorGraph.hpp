@@ -0,0 +1,72 @@
+#pragma once
+#include "Common.hpp"
+#include "Tile.hpp"
+#include <memory>
+
+// Hierarchical pathfinding (HPA*) over square sectors of the map. Each sector keeps the tiles where it can be crossed
+// into a neighbor sector, with the cost to reach every other one of its crossings. Long paths are searched over those
+// crossings, then refined one sector at a time, so a search never expands more than a sector of tiles at once
+constexpr int SECTOR_WIDTH = 16;
+constexpr int SECTOR_WIDTH_FOR_THREE_CROSSINGS = 6; // Open stretches of a border this long get a crossing at each end too
+
+struct SectorEdge {
+	int m_toTile = -1;
+	float m_cost = 0.0f;
+};
+
+struct SectorNode {
+	int m_tileIndex = -1;
+	std::vector<SectorEdge> m_edges; // To the other crossings of the sector, then across the border
+};
+
+struct Sector {
+	std::vector<SectorNode> m_nodes;
+
+	SectorNode const* FindNode(int tileIndex) const;
+};
+
+// Tiles on one sector's side of a border, with the tile they cross into
+struct SectorCrossing {
+	int m_tileIndex = -1;
+	int m_neighborTileIndex = -1;
+};
+
+class SectorGraph {
+public:
+	SectorGraph(eAgentType agentType, int mapWidth);
+
+	// Tile costs are read from the given tile types only, so a rebuild job never touches the colony's live tiles
+	void RebuildSector(int sectorIndex, std::vector<eTileType> const& tileTypes);
+	bool IsSectorBuilt(int sectorIndex) const { return m_sectors[sectorIndex] != nullptr; }
+
+	// Fills resultPath like Colony::GetAStarPath does, goal first. False if either end is in a sector not built yet, or
+	// the goal can't be reached through the crossings. The search over the crossings weighs its heuristic by
+	// heuristicWeight, the same as the tile search
+	bool FindPath(std::vector<IntVec2>& resultPath, IntVec2 const& start, IntVec2 const& goal, std::vector<eTileType> const& tileTypes, float heuristicWeight = 1.0f) const;
+
+	int GetNumSectors() const { return m_sectorsPerRow * m_sectorsPerRow; }
+	int GetSectorIndex(int tileIndex) const;
+	int GetSectorIndex(IntVec2 const& tileCoords) const;
+
+private:
+	struct SectorSearch;
+
+	void GetSectorBounds(int sectorIndex, IntVec2& out_mins, IntVec2& out_maxs) const;
+	void AddBorderCrossings(std::vector<SectorCrossing>& crossings, IntVec2 const& borderStart, IntVec2 const& borderStep, IntVec2 const& crossingStep, int borderLength, std::vector<eTileType> const& tileTypes) const;
+	void PrepareSectorSearch(SectorSearch& search, int sectorIndex, std::vector<eTileType> const& tileTypes) const;
+	void SearchSector(SectorSearch& search, int sourceTile, bool isTowardsSource, int targetTile = -1) const;
+	int GetTileIndex(SectorSearch const& search, int localIndex) const;
+	bool AddSearchedPath(std::vector<int>& tilePath, SectorSearch const& search, int toTile) const;
+	float GetTileCost(int tileIndex, std::vector<eTileType> const& tileTypes) const;
+
+private:
+	eAgentType m_agentType = AGENT_TYPE_WORKER;
+	int m_mapWidth = 0;
+	int m_sectorsPerRow = 0;
+
+	// A sector is replaced as a whole when rebuilt, so copies of the graph share every sector that didn't change
+	std::vector<std::shared_ptr<Sector const>> m_sectors;
+};
+
+// Published graphs are never modified, the same as heatmap snapshots
+typedef std::shared_ptr<SectorGraph const> SectorGraphSnapshot;
@@ -1,11 +1,12 @@
 #include "ThreadSafeStructures.hpp"
 #include <Engine/Core/ErrorWarningAssert.hpp>
+#include <string.h>
 
 //------------------------------------------------------------------------------------------------
 // Thread-safe globals
 //
 std::atomic<eTurnStatus>			g_threadSafe_turnStatus;	// Thread-safe wrapper around eTurnStatus
-ThreadSafe_ArenaTurnStateForPlayer	g_threadSafe_turnInfo;		// Middle "hand-off" buffer of triple-buffering scheme
+ThreadSafe_ArenaTurnStateForPlayer	g_threadSafe_turnInfo;		// Triple buffer, handed off by index swapping
 ThreadSafe_PlayerTurnOrders			g_threadSafe_turnOrders;	// Middle "hand-off" buffer of triple-buffering scheme
 std::atomic<int>					g_threadSafe_turnNumberOfLatestUpdateReceived = 0;
 std::atomic<int>					g_threadSafe_turnNumberOfLatestTurnOrdersSent = 0;
@@ -35,21 +36,51 @@ const char* GetNameForTurnStatus( eTurnStatus turnStatus )
 //////////////////////////////////////////////////////////////////////////////////////////////////
 // ThreadSafe_TurnInfo
 //////////////////////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------------------------
+void ThreadSafe_ArenaTurnStateForPlayer::SetMapWidth( int mapWidth )
+{
+	m_numUsedTiles = mapWidth * mapWidth;
+	if( m_numUsedTiles > MAX_ARENA_TILES || m_numUsedTiles <= 0 )
+	{
+		m_numUsedTiles = MAX_ARENA_TILES;
+	}
+}
+
+
 //------------------------------------------------------------------------------------------------
 void ThreadSafe_ArenaTurnStateForPlayer::CopyFrom( const ArenaTurnStateForPlayer& copyFrom )
 {
-	m_mutex.lock();
-	m_arenaState = copyFrom;
-	m_mutex.unlock();
+	// Most of the struct is fixed-size arrays that are only partly used; copy just the used part
+	ArenaTurnStateForPlayer& backBuffer = m_buffers[ m_backIndex ];
+	backBuffer.turnNumber = copyFrom.turnNumber;
+	backBuffer.currentNutrients = copyFrom.currentNutrients;
+	backBuffer.numFaults = copyFrom.numFaults;
+	backBuffer.nutrientsLostDueToFault = copyFrom.nutrientsLostDueToFault;
+	backBuffer.nutrientsLostDueToQueenDamage = copyFrom.nutrientsLostDueToQueenDamage;
+	backBuffer.nutrientsLostDueToQueenSuffocation = copyFrom.nutrientsLostDueToQueenSuffocation;
+	backBuffer.numReports = copyFrom.numReports;
+	backBuffer.numObservedAgents = copyFrom.numObservedAgents;
+	memcpy( backBuffer.agentReports, copyFrom.agentReports, sizeof( AgentReport ) * copyFrom.numReports );
+	memcpy( backBuffer.observedAgents, copyFrom.observedAgents, sizeof( ObservedAgent ) * copyFrom.numObservedAgents );
+	memcpy( backBuffer.observedTiles, copyFrom.observedTiles, sizeof( eTileType ) * m_numUsedTiles );
+	memcpy( backBuffer.tilesThatHaveFood, copyFrom.tilesThatHaveFood, sizeof( bool ) * m_numUsedTiles );
+
+	// Release: the reader that picks up this index sees everything written above
+	int previousMiddle = m_middleIndex.exchange( m_backIndex | MIDDLE_IS_NEW_FLAG, std::memory_order_acq_rel );
+	m_backIndex = previousMiddle & ~MIDDLE_IS_NEW_FLAG;
 }
 
 
 //------------------------------------------------------------------------------------------------
-void ThreadSafe_ArenaTurnStateForPlayer::CopyTo( ArenaTurnStateForPlayer& copyTo ) const
+const ArenaTurnStateForPlayer& ThreadSafe_ArenaTurnStateForPlayer::AcquireLatest()
 {
-	m_mutex.lock();
-	copyTo = m_arenaState;
-	m_mutex.unlock();
+	if( ( m_middleIndex.load( std::memory_order_relaxed ) & MIDDLE_IS_NEW_FLAG ) != 0 )
+	{
+		int previousMiddle = m_middleIndex.exchange( m_frontIndex, std::memory_order_acq_rel );
+		m_frontIndex = previousMiddle & ~MIDDLE_IS_NEW_FLAG;
+	}
+
+	return m_buffers[ m_frontIndex ];
 }
 
 
@@ -33,18 +33,35 @@ extern ThreadSafe_PlayerTurnOrders			g_threadSafe_turnOrders;
 //////////////////////////////////////////////////////////////////////////////////////////////////
 // ThreadSafe_ArenaTurnStateForPlayer
 //
-// A thread-safe (self-protecting) version of the ArenaTurnStateForPlayer struct.
-// Used as middle buffer in triple-buffering scheme (to avoid lengthy blocking on read or write).
+// Lock-free triple buffer of ArenaTurnStateForPlayer; one writer (the Arena's calling thread) and
+//	one reader (our primary thread).  The writer fills its back buffer and swaps it with the middle
+//	one; the reader swaps its front buffer with the middle one when a new state has been published.
+//	Each side only ever touches the buffer it owns, so neither blocks nor copies on the other.
 //////////////////////////////////////////////////////////////////////////////////////////////////
 class ThreadSafe_ArenaTurnStateForPlayer
 {
 public:
+	// Only the used part of observedTiles[] and tilesThatHaveFood[] is copied once this is known
+	void SetMapWidth( int mapWidth );
+
+	// Writer side: copies into the back buffer, then publishes it
 	void CopyFrom( const ArenaTurnStateForPlayer& copyFrom );
-	void CopyTo( ArenaTurnStateForPlayer& copyTo ) const;
+
+	// Reader side: takes the most recently published state, if there is a newer one.  The returned
+	//	state is not written to until the next call to AcquireLatest, which hands it back to the
+	//	writer.  Anything that still reads it (jobs queued for that turn) must be finished first
+	const ArenaTurnStateForPlayer& AcquireLatest();
+	const ArenaTurnStateForPlayer& GetFront() const { return m_buffers[ m_frontIndex ]; }
 
 private:
-	ArenaTurnStateForPlayer		m_arenaState;
-	mutable std::mutex			m_mutex;
+	static constexpr int NUM_BUFFERS			= 3;
+	static constexpr int MIDDLE_IS_NEW_FLAG		= 0x4;	// Set in m_middleIndex while the middle buffer has not been read yet
+
+	ArenaTurnStateForPlayer		m_buffers[ NUM_BUFFERS ];
+	int							m_backIndex = 0;		// Writer only
+	std::atomic<int>			m_middleIndex = 1;
+	int							m_frontIndex = 2;		// Reader only
+	int							m_numUsedTiles = MAX_ARENA_TILES;
 };
 
 
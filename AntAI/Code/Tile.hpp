@@ -1,7 +1,11 @@
 #pragma once
 #include "Common.hpp"
+#include <memory>
 
 struct Tile {
 	eTileType m_type = TILE_TYPE_UNSEEN;
 	bool m_hasFood = false;
-};
\ No newline at end of file
+};
+
+// Tile types as they were when a job was queued. Jobs read their copy while the primary thread keeps updating the tiles
+typedef std::shared_ptr<std::vector<eTileType> const> TileTypesSnapshot;
@@ -0,0 +1,1104 @@
+//-----------------------------------------------------------------------------------------------
+// HeadlessArena.cpp
+//
+#include "HeadlessArena.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+
+//-----------------------------------------------------------------------------------------------
+// Debug interface handed to the player; nothing is drawn, LogText goes to stdout with verbose=1
+//
+static bool s_isLogTextEnabled = false;
+
+static void RequestPause() {}
+static void LogText( char const* format, ... )
+{
+	if( !s_isLogTextEnabled )
+		return;
+
+	va_list variableArgumentList;
+	va_start( variableArgumentList, format );
+	vprintf( format, variableArgumentList );
+	va_end( variableArgumentList );
+	printf( "\n" );
+}
+static void SetMoodText( char const* format, ... ) { (void)format; }
+static void QueueDrawWorldText( float posX, float posY, float anchorU, float anchorV, float height, Color8 color, char const* format, ... )
+{
+	(void)posX; (void)posY; (void)anchorU; (void)anchorV; (void)height; (void)color; (void)format;
+}
+static void QueueDrawVertexArray( int count, const VertexPC* vertices ) { (void)count; (void)vertices; }
+static void FlushQueuedDraws() {}
+static bool IsDebugging() { return false; }
+static bool IsKeyDown( char const* keyShortName ) { (void)keyShortName; return false; }
+static void GetMouseWorldPos( float& out_mouseWorldX, float& out_mouseWorldY ) { out_mouseWorldX = -1.0f; out_mouseWorldY = -1.0f; }
+static void RegisterEvent( const char* eventName, EventFunc func ) { (void)eventName; (void)func; }
+
+
+//-----------------------------------------------------------------------------------------------
+static void RunPlayerThread( PlayerThreadEntryFunc playerThreadEntry, int threadIndex )
+{
+	playerThreadEntry( threadIndex );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static double GetSecondsSince( std::chrono::steady_clock::time_point const& startTime )
+{
+	return std::chrono::duration<double>( std::chrono::steady_clock::now() - startTime ).count();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool ArenaConfig::SetFromText( std::string const& keyEqualsValue )
+{
+	size_t equalsIndex = keyEqualsValue.find( '=' );
+	if( equalsIndex == std::string::npos )
+		return false;
+
+	std::string key = keyEqualsValue.substr( 0, equalsIndex );
+	std::string value = keyEqualsValue.substr( equalsIndex + 1 );
+	char const* valueText = value.c_str();
+	char* parseEnd = nullptr;
+	double number = strtod( valueText, &parseEnd );
+	bool isNumber = !value.empty() && ( *parseEnd == '\0' );
+
+	if( key == "player" )				{ playerPath = value; return true; }
+	if( key == "csv" )					{ csvPath = value; return true; }
+	if( !isNumber )						return false;
+
+	if( key == "seed" )					{ seed = (unsigned int)number; return true; }
+	if( key == "width" )				{ mapWidth = (int)number; return ( mapWidth >= 8 ) && ( mapWidth <= MAX_ARENA_WIDTH ); }
+	if( key == "turns" )				{ numTurns = (int)number; return numTurns > 0; }
+	if( key == "threads" )				{ numThreads = (int)number; return numThreads > 0; }
+	if( key == "deadlineMs" )			{ maxTurnSeconds = number * 0.001; return maxTurnSeconds > 0.0; }
+	if( key == "minTurnMs" )			{ minTurnSeconds = number * 0.001; return true; }
+	if( key == "fog" )					{ fogOfWar = ( number != 0.0 ); return true; }
+	if( key == "enemies" )				{ numEnemies = (int)number; return true; }
+	if( key == "verbose" )				{ verbose = ( number != 0.0 ); return true; }
+	if( key == "maxPopulation" )		{ maxPopulation = (int)number; return maxPopulation <= MAX_AGENTS_PER_PLAYER; }
+	if( key == "nutrients" )			{ startingNutrients = (int)number; return true; }
+	if( key == "suddenDeath" )			{ turnsUntilSuddenDeath = (int)number; return true; }
+	if( key == "scouts" )				{ startingAgents[ AGENT_TYPE_SCOUT ] = (int)number; return true; }
+	if( key == "workers" )				{ startingAgents[ AGENT_TYPE_WORKER ] = (int)number; return true; }
+	if( key == "soldiers" )				{ startingAgents[ AGENT_TYPE_SOLDIER ] = (int)number; return true; }
+	if( key == "queens" )				{ startingAgents[ AGENT_TYPE_QUEEN ] = (int)number; return true; }
+	if( key == "food" )					{ foodStrandsPer100Tiles = (float)number; return true; }
+	if( key == "foodPerTurn" )			{ foodSpawnedPerTurnPer100Tiles = (float)number; return true; }
+	if( key == "dirt" )					{ dirtStrandsPer100Tiles = (float)number; return true; }
+	if( key == "stone" )				{ stoneStrandsPer100Tiles = (float)number; return true; }
+	if( key == "water" )				{ waterStrandsPer100Tiles = (float)number; return true; }
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+uint32_t ArenaRandom::RollRandomUInt()
+{
+	m_state += 0x9e3779b97f4a7c15ull;
+	uint64_t mixed = m_state;
+	mixed = ( mixed ^ ( mixed >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+	mixed = ( mixed ^ ( mixed >> 27 ) ) * 0x94d049bb133111ebull;
+	return (uint32_t)( ( mixed ^ ( mixed >> 31 ) ) >> 32 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int ArenaRandom::RollRandomIntInRange( int minInclusive, int maxInclusive )
+{
+	uint32_t range = (uint32_t)( maxInclusive - minInclusive ) + 1;
+	return minInclusive + (int)( RollRandomUInt() % range );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+float ArenaRandom::RollRandomFloatZeroToOne()
+{
+	return (float)( RollRandomUInt() >> 8 ) * ( 1.0f / 16777216.0f );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+HeadlessArena::HeadlessArena( ArenaConfig const& config )
+	: m_config( config )
+	, m_random( config.seed )
+{
+	s_isLogTextEnabled = config.verbose;
+	m_turnState = new ArenaTurnStateForPlayer();
+	m_turnOrders = new PlayerTurnOrders();
+
+	SetupMatchInfo();
+	GenerateMap();
+	SpawnStartingAgents();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+HeadlessArena::~HeadlessArena()
+{
+	delete m_turnState;
+	m_turnState = nullptr;
+	delete m_turnOrders;
+	m_turnOrders = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool HeadlessArena::LoadPlayer( std::string& out_error )
+{
+	return m_player.Load( m_config.playerPath, out_error );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::SetupMatchInfo()
+{
+	MatchInfo& matchInfo = m_startupInfo.matchInfo;
+	matchInfo.numPlayers = ( m_config.numEnemies > 0 ) ? 2 : 1;
+	matchInfo.numTeams = matchInfo.numPlayers;
+	matchInfo.mapWidth = (short)m_config.mapWidth;
+	matchInfo.fogOfWar = m_config.fogOfWar;
+	matchInfo.teamSharedVision = false;
+	matchInfo.teamSharedResources = false;
+	matchInfo.nutrientsEarnedPerFoodEatenByQueen = m_config.nutrientsPerFoodEaten;
+	matchInfo.nutrientLossPerAttackerStrength = m_config.nutrientLossPerAttackerStrength;
+	matchInfo.nutrientLossForQueenSuffocation = 10000;
+	matchInfo.numTurnsBeforeSuddenDeath = m_config.turnsUntilSuddenDeath;
+	matchInfo.suddenDeathTurnsPerUpkeepIncrease = m_config.suddenDeathTurnsPerUpkeepIncrease;
+	matchInfo.colonyMaxPopulation = m_config.maxPopulation;
+	matchInfo.startingNutrients = m_config.startingNutrients;
+	matchInfo.foodCarryExhaustPenalty = m_config.foodCarryExhaustPenalty;
+	matchInfo.tileCarryExhaustPenalty = m_config.tileCarryExhaustPenalty;
+	matchInfo.combatStrengthQueenAuraBonus = 0;
+	matchInfo.combatStrengthQueenAuraDistance = 0;
+
+	// AgentDefinitions.xml; tiles without a listed penalty are free to enter unless solid, and can't be dug
+	static char const* const AGENT_NAMES[ NUM_AGENT_TYPES ] = { "Scout", "Worker", "Soldier", "Queen" };
+	static int const COSTS_TO_BIRTH[ NUM_AGENT_TYPES ]		= { 500, 500, 500, 10000 };
+	static int const EXHAUST_AFTER_BIRTH[ NUM_AGENT_TYPES ]	= { 1, 1, 1, 3 };
+	static int const UPKEEPS[ NUM_AGENT_TYPES ]				= { 1, 2, 3, 10 };
+	static int const VISIBILITY_RANGES[ NUM_AGENT_TYPES ]	= { 8, 4, 4, 6 };
+	static int const COMBAT_STRENGTHS[ NUM_AGENT_TYPES ]	= { 1, 1, 2, 0 };
+	static int const COMBAT_PRIORITIES[ NUM_AGENT_TYPES ]	= { 20, 10, 40, 0 };
+	static int const SACRIFICE_PRIORITIES[ NUM_AGENT_TYPES ] = { 40, 30, 20, 0 };
+	for( int typeIndex = 0; typeIndex < NUM_AGENT_TYPES; typeIndex++ )
+	{
+		AgentTypeInfo& typeInfo = matchInfo.agentTypeInfos[ typeIndex ];
+		typeInfo.name = AGENT_NAMES[ typeIndex ];
+		typeInfo.costToBirth = COSTS_TO_BIRTH[ typeIndex ];
+		typeInfo.exhaustAfterBirth = EXHAUST_AFTER_BIRTH[ typeIndex ];
+		typeInfo.upkeepPerTurn = UPKEEPS[ typeIndex ];
+		typeInfo.visibilityRange = VISIBILITY_RANGES[ typeIndex ];
+		typeInfo.combatStrength = COMBAT_STRENGTHS[ typeIndex ];
+		typeInfo.combatPriority = COMBAT_PRIORITIES[ typeIndex ];
+		typeInfo.sacrificePriority = SACRIFICE_PRIORITIES[ typeIndex ];
+		typeInfo.canCarryFood = ( typeIndex == AGENT_TYPE_WORKER );
+		typeInfo.canCarryTiles = ( typeIndex == AGENT_TYPE_WORKER );
+		typeInfo.canBirth = ( typeIndex == AGENT_TYPE_QUEEN );
+
+		for( int tileType = 0; tileType < NUM_TILE_TYPES; tileType++ )
+		{
+			bool isSolid = ( tileType == TILE_TYPE_DIRT ) || ( tileType == TILE_TYPE_STONE );
+			typeInfo.moveExhaustPenalties[ tileType ] = isSolid ? TILE_IMPASSABLE : 0;
+			typeInfo.digExhaustPenalties[ tileType ] = DIG_IMPOSSIBLE;
+		}
+	}
+
+	AgentTypeInfo* typeInfos = matchInfo.agentTypeInfos;
+	typeInfos[ AGENT_TYPE_SCOUT ].moveExhaustPenalties[ TILE_TYPE_DIRT ] = 0;
+	typeInfos[ AGENT_TYPE_WORKER ].moveExhaustPenalties[ TILE_TYPE_DIRT ] = 1;
+	typeInfos[ AGENT_TYPE_WORKER ].digExhaustPenalties[ TILE_TYPE_DIRT ] = 1;
+	typeInfos[ AGENT_TYPE_QUEEN ].moveExhaustPenalties[ TILE_TYPE_AIR ] = 1;
+	typeInfos[ AGENT_TYPE_QUEEN ].moveExhaustPenalties[ TILE_TYPE_WATER ] = 1;
+	typeInfos[ AGENT_TYPE_QUEEN ].moveExhaustPenalties[ TILE_TYPE_CORPSE_BRIDGE ] = 1;
+
+	PlayerInfo& playerInfo = m_startupInfo.yourPlayerInfo;
+	playerInfo.playerID = PLAYER_ID;
+	playerInfo.teamID = PLAYER_TEAM_ID;
+	playerInfo.teamSize = 1;
+	playerInfo.color = Color8( 255, 200, 0 );
+
+	m_startupInfo.expectedThreadCount = m_config.numThreads;
+	m_startupInfo.maxTurnSeconds = m_config.maxTurnSeconds;
+	m_startupInfo.freeFaultCount = INT32_MAX;
+	m_startupInfo.nutrientPenaltyPerFault = 0;
+	m_startupInfo.agentsKilledPerFault = 0;
+
+	m_debugInterface.RequestPause = RequestPause;
+	m_debugInterface.LogText = LogText;
+	m_debugInterface.SetMoodText = SetMoodText;
+	m_debugInterface.QueueDrawWorldText = QueueDrawWorldText;
+	m_debugInterface.QueueDrawVertexArray = QueueDrawVertexArray;
+	m_debugInterface.FlushQueuedDraws = FlushQueuedDraws;
+	m_debugInterface.IsDebugging = IsDebugging;
+	m_debugInterface.IsKeyDown = IsKeyDown;
+	m_debugInterface.GetMouseWorldPos = GetMouseWorldPos;
+	m_startupInfo.debugInterface = &m_debugInterface;
+	m_startupInfo.RegisterEvent = RegisterEvent;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Air fill, stone edge, then random-walk strands of each tile type; the colony starts in a
+//	cleared pocket somewhere in the middle half of the map
+//
+void HeadlessArena::GenerateMap()
+{
+	int mapWidth = m_config.mapWidth;
+	int numTiles = mapWidth * mapWidth;
+	m_tiles.assign( numTiles, TILE_TYPE_AIR );
+	m_tileHasFood.assign( numTiles, 0 );
+	m_isTileVisible.assign( numTiles, 0 );
+
+	for( int edgeIndex = 0; edgeIndex < mapWidth; edgeIndex++ )
+	{
+		m_tiles[ GetTileIndex( edgeIndex, 0 ) ] = TILE_TYPE_STONE;
+		m_tiles[ GetTileIndex( edgeIndex, mapWidth - 1 ) ] = TILE_TYPE_STONE;
+		m_tiles[ GetTileIndex( 0, edgeIndex ) ] = TILE_TYPE_STONE;
+		m_tiles[ GetTileIndex( mapWidth - 1, edgeIndex ) ] = TILE_TYPE_STONE;
+	}
+
+	AddStrands( TILE_TYPE_DIRT, m_config.dirtStrandsPer100Tiles, m_config.dirtStrandLength );
+	AddStrands( TILE_TYPE_STONE, m_config.stoneStrandsPer100Tiles, m_config.stoneStrandLength );
+	AddStrands( TILE_TYPE_WATER, m_config.waterStrandsPer100Tiles, m_config.waterStrandLength );
+
+	m_startX = m_random.RollRandomIntInRange( mapWidth / 4, ( 3 * mapWidth ) / 4 );
+	m_startY = m_random.RollRandomIntInRange( mapWidth / 4, ( 3 * mapWidth ) / 4 );
+	for( int tileY = m_startY - 2; tileY <= m_startY + 2; tileY++ )
+	{
+		for( int tileX = m_startX - 2; tileX <= m_startX + 2; tileX++ )
+		{
+			m_tiles[ GetTileIndex( tileX, tileY ) ] = TILE_TYPE_AIR;
+		}
+	}
+
+	int numFood = (int)( m_config.foodStrandsPer100Tiles * (float)numTiles * 0.01f );
+	for( int foodIndex = 0; foodIndex < numFood; foodIndex++ )
+	{
+		int tileIndex = GetTileIndex( m_random.RollRandomIntInRange( 1, mapWidth - 2 ), m_random.RollRandomIntInRange( 1, mapWidth - 2 ) );
+		eTileType tileType = m_tiles[ tileIndex ];
+		if( tileType == TILE_TYPE_AIR || tileType == TILE_TYPE_DIRT )
+		{
+			m_tileHasFood[ tileIndex ] = 1;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::AddStrands( eTileType tileType, float strandsPer100Tiles, int strandLength )
+{
+	int mapWidth = m_config.mapWidth;
+	int numStrands = (int)( strandsPer100Tiles * (float)( mapWidth * mapWidth ) * 0.01f );
+	static int const STEP_X[ 4 ] = { 1, 0, -1, 0 };
+	static int const STEP_Y[ 4 ] = { 0, 1, 0, -1 };
+
+	for( int strandIndex = 0; strandIndex < numStrands; strandIndex++ )
+	{
+		int tileX = m_random.RollRandomIntInRange( 1, mapWidth - 2 );
+		int tileY = m_random.RollRandomIntInRange( 1, mapWidth - 2 );
+		for( int stepIndex = 0; stepIndex < strandLength; stepIndex++ )
+		{
+			m_tiles[ GetTileIndex( tileX, tileY ) ] = tileType;
+
+			int direction = m_random.RollRandomIntInRange( 0, 3 );
+			int nextX = tileX + STEP_X[ direction ];
+			int nextY = tileY + STEP_Y[ direction ];
+			if( nextX >= 1 && nextX <= mapWidth - 2 && nextY >= 1 && nextY <= mapWidth - 2 )
+			{
+				tileX = nextX;
+				tileY = nextY;
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::SpawnStartingAgents()
+{
+	m_nutrients = m_config.startingNutrients;
+	m_agents.reserve( MAX_AGENTS_PER_PLAYER * 2 );
+
+	for( int typeIndex = NUM_AGENT_TYPES - 1; typeIndex >= 0; typeIndex-- )
+	{
+		for( int agentIndex = 0; agentIndex < m_config.startingAgents[ typeIndex ]; agentIndex++ )
+		{
+			if( GetNumLivingPlayerAgents() >= m_config.maxPopulation )
+				break;
+
+			// Queens can't share a tile, so they line up along the pocket
+			int tileX = m_startX;
+			int tileY = m_startY;
+			if( typeIndex == AGENT_TYPE_QUEEN )
+			{
+				tileX = m_startX - 2 + ( agentIndex % 5 );
+				tileY = m_startY - 2 + ( ( agentIndex / 5 ) % 5 );
+			}
+
+			SpawnAgent( PLAYER_ID, (eAgentType)typeIndex, tileX, tileY );
+		}
+	}
+
+	SpawnEnemies();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+HeadlessArena::Agent& HeadlessArena::SpawnAgent( PlayerID playerID, eAgentType type, int tileX, int tileY )
+{
+	Agent newAgent;
+	newAgent.agentID = ( (AgentID)playerID << 24 ) | m_nextAgentSerial;
+	newAgent.playerID = playerID;
+	newAgent.type = type;
+	newAgent.tileX = (short)tileX;
+	newAgent.tileY = (short)tileY;
+	newAgent.result = AGENT_WAS_CREATED;
+	m_nextAgentSerial++;
+
+	m_agents.push_back( newAgent );
+	return m_agents.back();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Enemies appear on random open tiles away from the colony's start, and are replaced when killed
+//
+void HeadlessArena::SpawnEnemies()
+{
+	int numLivingEnemies = 0;
+	for( Agent const& agent : m_agents )
+	{
+		if( !IsPlayerAgent( agent ) && IsAlive( agent ) )
+			numLivingEnemies++;
+	}
+
+	int mapWidth = m_config.mapWidth;
+	for( int attempt = 0; ( numLivingEnemies < m_config.numEnemies ) && ( attempt < 4 * m_config.numEnemies ); attempt++ )
+	{
+		int tileX = m_random.RollRandomIntInRange( 1, mapWidth - 2 );
+		int tileY = m_random.RollRandomIntInRange( 1, mapWidth - 2 );
+		int distanceFromStart = abs( tileX - m_startX ) + abs( tileY - m_startY );
+		if( m_tiles[ GetTileIndex( tileX, tileY ) ] != TILE_TYPE_AIR || distanceFromStart < mapWidth / 4 )
+			continue;
+
+		eAgentType enemyType = ( numLivingEnemies % 3 == 0 ) ? AGENT_TYPE_WORKER : AGENT_TYPE_SOLDIER;
+		SpawnAgent( ENEMY_PLAYER_ID, enemyType, tileX, tileY );
+		numLivingEnemies++;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::RunMatch()
+{
+	m_player.PreGameStartup( m_startupInfo );
+
+	std::vector<std::thread> playerThreads;
+	for( int threadIndex = 0; threadIndex < m_config.numThreads; threadIndex++ )
+	{
+		playerThreads.emplace_back( RunPlayerThread, m_player.PlayerThreadEntry, threadIndex );
+	}
+
+	for( m_turnNumber = 1; m_turnNumber <= m_config.numTurns; m_turnNumber++ )
+	{
+		std::chrono::steady_clock::time_point turnStartTime = std::chrono::steady_clock::now();
+
+		BuildTurnState();
+		RemoveDeadAgents();
+		if( GetNumLivingPlayerAgents() == 0 )
+			break;
+
+		TurnTiming turnTiming;
+		turnTiming.turnNumber = m_turnNumber;
+		m_numFaultsThisTurn = 0;
+		m_numSuicidesThisTurn = 0;
+		m_nutrientsLostToQueenDamage = 0;
+		if( !CollectOrders( turnTiming ) )
+		{
+			m_turnOrders->numberOfOrders = 0; // Late orders are dropped and the whole colony holds
+			m_numFaultsThisTurn++;
+		}
+
+		ResolveOrders();
+
+		MoveEnemies();
+		ResolveCombat();
+		PayUpkeep();
+		SpawnFood();
+		SpawnEnemies();
+		m_totalFaults += m_numFaultsThisTurn;
+
+		turnTiming.numAgents = GetNumLivingPlayerAgents();
+		turnTiming.nutrients = m_nutrients;
+		m_turnStats.AddTurn( turnTiming );
+
+		double turnSeconds = GetSecondsSince( turnStartTime );
+		if( turnSeconds < m_config.minTurnSeconds )
+		{
+			std::this_thread::sleep_for( std::chrono::duration<double>( m_config.minTurnSeconds - turnSeconds ) );
+		}
+	}
+
+	MatchResults matchResults;
+	m_player.PostGameShutdown( matchResults );
+	for( std::thread& playerThread : playerThreads )
+	{
+		playerThread.join();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reports go out for every living agent and for agents that died last turn, then the dead are removed
+//
+void HeadlessArena::BuildTurnState()
+{
+	ArenaTurnStateForPlayer& turnState = *m_turnState;
+	turnState.turnNumber = m_turnNumber;
+	turnState.currentNutrients = m_nutrients;
+	turnState.numFaults = m_numFaultsThisTurn;
+	turnState.nutrientsLostDueToFault = 0;
+	turnState.nutrientsLostDueToQueenDamage = m_nutrientsLostToQueenDamage;
+	turnState.nutrientsLostDueToQueenSuffocation = 0;
+
+	turnState.numReports = 0;
+	for( Agent const& agent : m_agents )
+	{
+		if( !IsPlayerAgent( agent ) || turnState.numReports >= MAX_REPORTS_PER_PLAYER )
+			continue;
+
+		AgentReport& report = turnState.agentReports[ turnState.numReports ];
+		report.agentID = agent.agentID;
+		report.tileX = agent.tileX;
+		report.tileY = agent.tileY;
+		report.exhaustion = agent.exhaustion;
+		report.receivedCombatDamage = agent.receivedCombatDamage;
+		report.receivedSuffocationDamage = agent.receivedSuffocationDamage;
+		report.type = agent.type;
+		report.state = agent.state;
+		report.result = agent.result;
+		turnState.numReports++;
+	}
+
+	UpdateVisibility();
+
+	int numTiles = m_config.mapWidth * m_config.mapWidth;
+	for( int tileIndex = 0; tileIndex < numTiles; tileIndex++ )
+	{
+		bool isVisible = m_isTileVisible[ tileIndex ] != 0;
+		turnState.observedTiles[ tileIndex ] = isVisible ? m_tiles[ tileIndex ] : TILE_TYPE_UNSEEN;
+		turnState.tilesThatHaveFood[ tileIndex ] = isVisible && ( m_tileHasFood[ tileIndex ] != 0 );
+	}
+
+	turnState.numObservedAgents = 0;
+	for( Agent const& agent : m_agents )
+	{
+		if( IsPlayerAgent( agent ) || !IsAlive( agent ) || !m_isTileVisible[ GetTileIndex( agent.tileX, agent.tileY ) ] )
+			continue;
+
+		ObservedAgent& observedAgent = turnState.observedAgents[ turnState.numObservedAgents ];
+		observedAgent.agentID = agent.agentID;
+		observedAgent.playerID = agent.playerID;
+		observedAgent.teamID = ENEMY_TEAM_ID;
+		observedAgent.tileX = agent.tileX;
+		observedAgent.tileY = agent.tileY;
+		observedAgent.receivedCombatDamage = agent.receivedCombatDamage;
+		observedAgent.receivedSuffocationDamage = agent.receivedSuffocationDamage;
+		observedAgent.type = agent.type;
+		observedAgent.state = agent.state;
+		observedAgent.lastObservedAction = agent.lastOrder;
+		turnState.numObservedAgents++;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Each living player agent sees a taxicab diamond of its type's visibilityRange
+//
+void HeadlessArena::UpdateVisibility()
+{
+	if( !m_config.fogOfWar )
+	{
+		std::fill( m_isTileVisible.begin(), m_isTileVisible.end(), (unsigned char)1 );
+		return;
+	}
+
+	std::fill( m_isTileVisible.begin(), m_isTileVisible.end(), (unsigned char)0 );
+	int mapWidth = m_config.mapWidth;
+	for( Agent const& agent : m_agents )
+	{
+		if( !IsPlayerAgent( agent ) || !IsAlive( agent ) )
+			continue;
+
+		int range = m_startupInfo.matchInfo.agentTypeInfos[ agent.type ].visibilityRange;
+		int minY = std::max( agent.tileY - range, 0 );
+		int maxY = std::min( agent.tileY + range, mapWidth - 1 );
+		for( int tileY = minY; tileY <= maxY; tileY++ )
+		{
+			int rangeX = range - abs( tileY - agent.tileY );
+			int minX = std::max( agent.tileX - rangeX, 0 );
+			int maxX = std::min( agent.tileX + rangeX, mapWidth - 1 );
+			memset( &m_isTileVisible[ GetTileIndex( minX, tileY ) ], 1, (size_t)( maxX - minX + 1 ) );
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Same handshake as the arena: hand over the turn state, then keep asking for orders until the
+//	player has them or the turn's deadline passes
+//
+bool HeadlessArena::CollectOrders( TurnTiming& out_turnTiming )
+{
+	std::chrono::steady_clock::time_point requestStartTime = std::chrono::steady_clock::now();
+	m_player.ReceiveTurnState( *m_turnState );
+	out_turnTiming.receiveSeconds = GetSecondsSince( requestStartTime );
+
+	bool hasOrders = false;
+	m_turnOrders->numberOfOrders = 0;
+	while( true )
+	{
+		out_turnTiming.numOrderRequests++;
+		if( m_player.TurnOrderRequest( m_turnNumber, m_turnOrders ) )
+		{
+			hasOrders = true;
+			break;
+		}
+
+		if( GetSecondsSince( requestStartTime ) >= m_config.maxTurnSeconds )
+			break;
+
+		std::this_thread::yield();
+	}
+
+	out_turnTiming.ordersSeconds = GetSecondsSince( requestStartTime );
+	out_turnTiming.missedDeadline = !hasOrders || ( out_turnTiming.ordersSeconds > m_config.maxTurnSeconds );
+	return !out_turnTiming.missedDeadline;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Orders run one at a time in the order given; agents without an order hold
+//
+void HeadlessArena::ResolveOrders()
+{
+	m_agentIndexesByID.clear();
+	for( int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++ )
+	{
+		Agent& agent = m_agents[ agentIndex ];
+		agent.receivedCombatDamage = 0;
+		agent.receivedSuffocationDamage = 0;
+		if( IsPlayerAgent( agent ) )
+		{
+			m_agentIndexesByID[ agent.agentID ] = agentIndex;
+			agent.lastOrder = NUM_ORDERS; // Not ordered yet
+		}
+	}
+
+	int numAgentsBeforeBirths = (int)m_agents.size();
+	int numOrders = std::min( std::max( m_turnOrders->numberOfOrders, 0 ), MAX_ORDERS_PER_PLAYER );
+	for( int orderIndex = 0; orderIndex < numOrders; orderIndex++ )
+	{
+		AgentOrder const& agentOrder = m_turnOrders->orders[ orderIndex ];
+		std::unordered_map<AgentID, int>::const_iterator foundAgent = m_agentIndexesByID.find( agentOrder.agentID );
+		if( foundAgent == m_agentIndexesByID.end() || agentOrder.order >= NUM_ORDERS )
+		{
+			m_numFaultsThisTurn++;
+			continue;
+		}
+
+		Agent& agent = m_agents[ foundAgent->second ];
+		if( agent.lastOrder != NUM_ORDERS || !IsAlive( agent ) )
+		{
+			m_numFaultsThisTurn++;
+			continue;
+		}
+
+		ResolveOrder( foundAgent->second, agentOrder.order );
+	}
+
+	for( int agentIndex = 0; agentIndex < numAgentsBeforeBirths; agentIndex++ )
+	{
+		Agent& agent = m_agents[ agentIndex ];
+		if( IsPlayerAgent( agent ) && IsAlive( agent ) && agent.lastOrder == NUM_ORDERS )
+		{
+			ResolveOrder( agentIndex, ORDER_HOLD );
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::ResolveOrder( int agentIndex, eOrderCode order )
+{
+	Agent& agent = m_agents[ agentIndex ];
+	AgentTypeInfo const& typeInfo = m_startupInfo.matchInfo.agentTypeInfos[ agent.type ];
+	agent.lastOrder = order;
+
+	if( agent.exhaustion > 0 )
+	{
+		agent.exhaustion--;
+		agent.result = ( order == ORDER_HOLD ) ? AGENT_ORDER_SUCCESS_HELD : AGENT_ORDER_ERROR_EXHAUSTED;
+		return;
+	}
+
+	switch( order )
+	{
+	case ORDER_MOVE_EAST:	ResolveMove( agent, agent.tileX + 1, agent.tileY ); break;
+	case ORDER_MOVE_NORTH:	ResolveMove( agent, agent.tileX, agent.tileY + 1 ); break;
+	case ORDER_MOVE_WEST:	ResolveMove( agent, agent.tileX - 1, agent.tileY ); break;
+	case ORDER_MOVE_SOUTH:	ResolveMove( agent, agent.tileX, agent.tileY - 1 ); break;
+	case ORDER_DIG_HERE:	ResolveDig( agent, agent.tileX, agent.tileY, true ); break;
+	case ORDER_DIG_EAST:	ResolveDig( agent, agent.tileX + 1, agent.tileY, false ); break;
+	case ORDER_DIG_NORTH:	ResolveDig( agent, agent.tileX, agent.tileY + 1, false ); break;
+	case ORDER_DIG_WEST:	ResolveDig( agent, agent.tileX - 1, agent.tileY, false ); break;
+	case ORDER_DIG_SOUTH:	ResolveDig( agent, agent.tileX, agent.tileY - 1, false ); break;
+
+	case ORDER_PICK_UP_FOOD:
+	{
+		int tileIndex = GetTileIndex( agent.tileX, agent.tileY );
+		if( !typeInfo.canCarryFood )					agent.result = AGENT_ORDER_ERROR_CANT_CARRY_FOOD;
+		else if( agent.state != STATE_NORMAL )			agent.result = AGENT_ORDER_ERROR_ALREADY_CARRYING_FOOD;
+		else if( !m_tileHasFood[ tileIndex ] )			agent.result = AGENT_ORDER_ERROR_NO_FOOD_PRESENT;
+		else
+		{
+			m_tileHasFood[ tileIndex ] = 0;
+			agent.state = STATE_HOLDING_FOOD;
+			agent.result = AGENT_ORDER_SUCCESS_PICKUP;
+		}
+		break;
+	}
+
+	case ORDER_PICK_UP_TILE:
+	{
+		int tileIndex = GetTileIndex( agent.tileX, agent.tileY );
+		if( !typeInfo.canCarryTiles )					agent.result = AGENT_ORDER_ERROR_CANT_CARRY_TILE;
+		else if( agent.state != STATE_NORMAL )			agent.result = AGENT_ORDER_ERROR_ALREADY_CARRYING_FOOD;
+		else if( m_tiles[ tileIndex ] != TILE_TYPE_DIRT )	agent.result = AGENT_ORDER_ERROR_CANT_DIG_INVALID_TILE;
+		else
+		{
+			m_tiles[ tileIndex ] = TILE_TYPE_AIR;
+			agent.state = STATE_HOLDING_DIRT;
+			agent.result = AGENT_ORDER_SUCCESS_PICKUP;
+		}
+		break;
+	}
+
+	case ORDER_DROP_CARRIED_OBJECT:	ResolveDrop( agent ); break;
+	case ORDER_BIRTH_SCOUT:			ResolveBirth( agent, AGENT_TYPE_SCOUT ); break;
+	case ORDER_BIRTH_WORKER:		ResolveBirth( agent, AGENT_TYPE_WORKER ); break;
+	case ORDER_BIRTH_SOLDIER:		ResolveBirth( agent, AGENT_TYPE_SOLDIER ); break;
+	case ORDER_BIRTH_QUEEN:			ResolveBirth( agent, AGENT_TYPE_QUEEN ); break;
+
+	case ORDER_SUICIDE:
+		KillAgent( agent, AGENT_ORDER_SUCCESS_SUICIDE );
+		m_numSuicidesThisTurn++;
+		break;
+
+	default: // Hold and emotes
+		agent.result = AGENT_ORDER_SUCCESS_HELD;
+		break;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::ResolveMove( Agent& agent, int targetX, int targetY )
+{
+	if( !IsInBounds( targetX, targetY ) )
+	{
+		agent.result = AGENT_ORDER_ERROR_OUT_OF_BOUNDS;
+		return;
+	}
+
+	int targetIndex = GetTileIndex( targetX, targetY );
+	eTileType targetType = m_tiles[ targetIndex ];
+	int movePenalty = m_startupInfo.matchInfo.agentTypeInfos[ agent.type ].moveExhaustPenalties[ targetType ];
+	if( movePenalty == TILE_IMPASSABLE )
+	{
+		agent.result = AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE;
+		return;
+	}
+
+	if( agent.type == AGENT_TYPE_QUEEN && IsQueenAt( targetX, targetY, &agent ) )
+	{
+		agent.result = AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_QUEEN;
+		return;
+	}
+
+	agent.tileX = (short)targetX;
+	agent.tileY = (short)targetY;
+	agent.exhaustion = (short)movePenalty;
+	if( agent.state == STATE_HOLDING_FOOD )	agent.exhaustion += (short)m_config.foodCarryExhaustPenalty;
+	if( agent.state == STATE_HOLDING_DIRT )	agent.exhaustion += (short)m_config.tileCarryExhaustPenalty;
+	agent.result = AGENT_ORDER_SUCCESS_MOVED;
+
+	if( targetType == TILE_TYPE_WATER )
+	{
+		m_tiles[ targetIndex ] = TILE_TYPE_CORPSE_BRIDGE;
+		KillAgent( agent, AGENT_KILLED_BY_WATER );
+		return;
+	}
+
+	if( agent.type == AGENT_TYPE_QUEEN && m_tileHasFood[ targetIndex ] )
+	{
+		m_tileHasFood[ targetIndex ] = 0;
+		m_nutrients += m_config.nutrientsPerFoodEaten;
+		m_totalFoodEaten++;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::ResolveDig( Agent& agent, int targetX, int targetY, bool isDigHere )
+{
+	if( !IsInBounds( targetX, targetY ) )
+	{
+		agent.result = AGENT_ORDER_ERROR_OUT_OF_BOUNDS;
+		return;
+	}
+
+	if( agent.state != STATE_NORMAL )
+	{
+		agent.result = AGENT_ORDER_ERROR_CANT_DIG_WHILE_CARRYING;
+		return;
+	}
+
+	int targetIndex = GetTileIndex( targetX, targetY );
+	eTileType targetType = m_tiles[ targetIndex ];
+	int digPenalty = m_startupInfo.matchInfo.agentTypeInfos[ agent.type ].digExhaustPenalties[ targetType ];
+	if( digPenalty == DIG_IMPOSSIBLE )
+	{
+		agent.result = AGENT_ORDER_ERROR_CANT_DIG_INVALID_TILE;
+		return;
+	}
+
+	m_tiles[ targetIndex ] = ( targetType == TILE_TYPE_CORPSE_BRIDGE ) ? TILE_TYPE_WATER : TILE_TYPE_AIR;
+	agent.exhaustion = isDigHere ? 0 : (short)digPenalty;
+	agent.result = AGENT_ORDER_SUCCESS_DUG;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::ResolveDrop( Agent& agent )
+{
+	int tileIndex = GetTileIndex( agent.tileX, agent.tileY );
+	if( agent.state == STATE_HOLDING_FOOD )
+	{
+		if( IsQueenAt( agent.tileX, agent.tileY, nullptr ) )
+		{
+			m_nutrients += m_config.nutrientsPerFoodEaten;
+			m_totalFoodEaten++;
+		}
+		else
+		{
+			m_tileHasFood[ tileIndex ] = 1;
+		}
+	}
+	else if( agent.state == STATE_HOLDING_DIRT )
+	{
+		m_tiles[ tileIndex ] = TILE_TYPE_DIRT;
+
+		// Agents that can't stand in dirt suffocate; the queen survives and the colony pays for it
+		for( Agent& otherAgent : m_agents )
+		{
+			if( !IsAlive( otherAgent ) || otherAgent.tileX != agent.tileX || otherAgent.tileY != agent.tileY )
+				continue;
+			if( m_startupInfo.matchInfo.agentTypeInfos[ otherAgent.type ].moveExhaustPenalties[ TILE_TYPE_DIRT ] != TILE_IMPASSABLE )
+				continue;
+
+			otherAgent.receivedSuffocationDamage = 1;
+			if( otherAgent.type != AGENT_TYPE_QUEEN )
+			{
+				KillAgent( otherAgent, AGENT_KILLED_BY_SUFFOCATION );
+			}
+		}
+	}
+	else
+	{
+		agent.result = AGENT_ORDER_ERROR_NOT_CARRYING;
+		return;
+	}
+
+	agent.state = STATE_NORMAL;
+	agent.result = AGENT_ORDER_SUCCESS_DROP;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::ResolveBirth( Agent& agent, eAgentType birthType )
+{
+	AgentTypeInfo const& birthTypeInfo = m_startupInfo.matchInfo.agentTypeInfos[ birthType ];
+	if( !m_startupInfo.matchInfo.agentTypeInfos[ agent.type ].canBirth )
+	{
+		agent.result = AGENT_ORDER_ERROR_CANT_BIRTH;
+		return;
+	}
+
+	if( GetNumLivingPlayerAgents() >= m_config.maxPopulation )
+	{
+		agent.result = AGENT_ORDER_ERROR_MAXIMUM_POPULATION_REACHED;
+		return;
+	}
+
+	if( m_nutrients < birthTypeInfo.costToBirth )
+	{
+		agent.result = AGENT_ORDER_ERROR_INSUFFICIENT_FOOD;
+		return;
+	}
+
+	m_nutrients -= birthTypeInfo.costToBirth;
+	agent.exhaustion = (short)birthTypeInfo.exhaustAfterBirth;
+	agent.result = AGENT_ORDER_SUCCESS_GAVE_BIRTH;
+	int tileX = agent.tileX;
+	int tileY = agent.tileY;
+	SpawnAgent( PLAYER_ID, birthType, tileX, tileY ); // May reallocate m_agents; agent is not used after this
+	m_totalBirths++;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::MoveEnemies()
+{
+	static eOrderCode const MOVE_ORDERS[ 4 ] = { ORDER_MOVE_EAST, ORDER_MOVE_NORTH, ORDER_MOVE_WEST, ORDER_MOVE_SOUTH };
+	static int const STEP_X[ 4 ] = { 1, 0, -1, 0 };
+	static int const STEP_Y[ 4 ] = { 0, 1, 0, -1 };
+
+	for( Agent& agent : m_agents )
+	{
+		if( IsPlayerAgent( agent ) || !IsAlive( agent ) )
+			continue;
+
+		int direction = m_random.RollRandomIntInRange( 0, 3 );
+		int targetX = agent.tileX + STEP_X[ direction ];
+		int targetY = agent.tileY + STEP_Y[ direction ];
+		agent.lastOrder = MOVE_ORDERS[ direction ];
+		agent.receivedCombatDamage = 0;
+
+		eTileType targetType = IsInBounds( targetX, targetY ) ? m_tiles[ GetTileIndex( targetX, targetY ) ] : TILE_TYPE_STONE;
+		if( targetType == TILE_TYPE_AIR || targetType == TILE_TYPE_CORPSE_BRIDGE )
+		{
+			agent.tileX = (short)targetX;
+			agent.tileY = (short)targetY;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Agents of both colonies on the same tile duel; the weaker one dies, or both on a tie. Queens
+//	don't die in combat, the colony loses nutrients for each attacker's strength instead
+//
+void HeadlessArena::ResolveCombat()
+{
+	if( m_config.numEnemies <= 0 )
+		return;
+
+	AgentTypeInfo const* typeInfos = m_startupInfo.matchInfo.agentTypeInfos;
+	std::vector<int> strongestEnemyAtTile( m_tiles.size(), -1 );
+	for( int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++ )
+	{
+		Agent const& agent = m_agents[ agentIndex ];
+		if( IsPlayerAgent( agent ) || !IsAlive( agent ) )
+			continue;
+
+		int& strongestEnemy = strongestEnemyAtTile[ GetTileIndex( agent.tileX, agent.tileY ) ];
+		if( strongestEnemy == -1 || typeInfos[ agent.type ].combatStrength > typeInfos[ m_agents[ strongestEnemy ].type ].combatStrength )
+		{
+			strongestEnemy = agentIndex;
+		}
+	}
+
+	for( Agent& agent : m_agents )
+	{
+		if( !IsPlayerAgent( agent ) || !IsAlive( agent ) )
+			continue;
+
+		int enemyIndex = strongestEnemyAtTile[ GetTileIndex( agent.tileX, agent.tileY ) ];
+		if( enemyIndex == -1 || !IsAlive( m_agents[ enemyIndex ] ) )
+			continue;
+
+		Agent& enemy = m_agents[ enemyIndex ];
+		int agentStrength = typeInfos[ agent.type ].combatStrength;
+		int enemyStrength = typeInfos[ enemy.type ].combatStrength;
+		agent.receivedCombatDamage = 1;
+		enemy.receivedCombatDamage = 1;
+
+		if( agent.type == AGENT_TYPE_QUEEN )
+		{
+			int nutrientLoss = enemyStrength * m_config.nutrientLossPerAttackerStrength;
+			m_nutrients -= nutrientLoss;
+			m_nutrientsLostToQueenDamage += nutrientLoss;
+			continue;
+		}
+
+		if( agentStrength <= enemyStrength )	KillAgent( agent, AGENT_KILLED_BY_ENEMY );
+		if( enemyStrength <= agentStrength )	KillAgent( enemy, AGENT_KILLED_BY_ENEMY );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Upkeep for every living agent plus the sudden death burden; a starving colony loses its
+//	highest sacrificePriority agent, unless one was suicided this turn
+//
+void HeadlessArena::PayUpkeep()
+{
+	AgentTypeInfo const* typeInfos = m_startupInfo.matchInfo.agentTypeInfos;
+	int upkeep = 0;
+	for( Agent const& agent : m_agents )
+	{
+		if( IsPlayerAgent( agent ) && IsAlive( agent ) )
+			upkeep += typeInfos[ agent.type ].upkeepPerTurn;
+	}
+
+	int turnsIntoSuddenDeath = m_turnNumber - m_config.turnsUntilSuddenDeath;
+	if( turnsIntoSuddenDeath > 0 && m_config.suddenDeathTurnsPerUpkeepIncrease > 0 )
+	{
+		upkeep += turnsIntoSuddenDeath / m_config.suddenDeathTurnsPerUpkeepIncrease;
+	}
+
+	m_nutrients -= upkeep;
+	if( GetNumLivingPlayerAgents( AGENT_TYPE_QUEEN ) == 0 )
+	{
+		m_nutrients = std::min( m_nutrients, -1 );
+	}
+
+	if( m_nutrients >= 0 || m_numSuicidesThisTurn > 0 )
+		return;
+
+	Agent* sacrificedAgent = nullptr;
+	for( Agent& agent : m_agents )
+	{
+		if( !IsPlayerAgent( agent ) || !IsAlive( agent ) )
+			continue;
+
+		if( !sacrificedAgent || typeInfos[ agent.type ].sacrificePriority > typeInfos[ sacrificedAgent->type ].sacrificePriority )
+		{
+			sacrificedAgent = &agent;
+		}
+	}
+
+	if( sacrificedAgent )
+	{
+		KillAgent( *sacrificedAgent, AGENT_KILLED_BY_STARVATION );
+	}
+	m_nutrients = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::SpawnFood()
+{
+	if( m_turnNumber >= m_config.turnsUntilSuddenDeath )
+		return;
+
+	int mapWidth = m_config.mapWidth;
+	m_foodToSpawn += m_config.foodSpawnedPerTurnPer100Tiles * (float)( mapWidth * mapWidth ) * 0.01f;
+	while( m_foodToSpawn >= 1.0f )
+	{
+		m_foodToSpawn -= 1.0f;
+		int tileIndex = GetTileIndex( m_random.RollRandomIntInRange( 1, mapWidth - 2 ), m_random.RollRandomIntInRange( 1, mapWidth - 2 ) );
+		eTileType tileType = m_tiles[ tileIndex ];
+		if( tileType == TILE_TYPE_AIR || tileType == TILE_TYPE_DIRT )
+		{
+			m_tileHasFood[ tileIndex ] = 1;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::KillAgent( Agent& agent, eAgentOrderResult causeOfDeath )
+{
+	if( !IsAlive( agent ) )
+		return;
+
+	// Whatever was carried falls where the agent died
+	if( agent.state == STATE_HOLDING_FOOD )
+	{
+		m_tileHasFood[ GetTileIndex( agent.tileX, agent.tileY ) ] = 1;
+	}
+
+	agent.state = STATE_DEAD;
+	agent.result = causeOfDeath;
+	if( IsPlayerAgent( agent ) )
+	{
+		m_totalDeaths++;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::RemoveDeadAgents()
+{
+	int numLiving = 0;
+	for( int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++ )
+	{
+		if( !IsAlive( m_agents[ agentIndex ] ) )
+			continue;
+
+		m_agents[ numLiving ] = m_agents[ agentIndex ];
+		numLiving++;
+	}
+
+	m_agents.resize( numLiving );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool HeadlessArena::IsInBounds( int tileX, int tileY ) const
+{
+	return ( tileX >= 0 ) && ( tileY >= 0 ) && ( tileX < m_config.mapWidth ) && ( tileY < m_config.mapWidth );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int HeadlessArena::GetNumLivingPlayerAgents( eAgentType type ) const
+{
+	int numAgents = 0;
+	for( Agent const& agent : m_agents )
+	{
+		if( IsPlayerAgent( agent ) && IsAlive( agent ) && ( type == INVALID_AGENT_TYPE || agent.type == type ) )
+			numAgents++;
+	}
+
+	return numAgents;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool HeadlessArena::IsQueenAt( int tileX, int tileY, Agent const* ignoredAgent ) const
+{
+	for( Agent const& agent : m_agents )
+	{
+		if( &agent == ignoredAgent || !IsPlayerAgent( agent ) || !IsAlive( agent ) || agent.type != AGENT_TYPE_QUEEN )
+			continue;
+
+		if( agent.tileX == tileX && agent.tileY == tileY )
+			return true;
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void HeadlessArena::PrintMatchSummary() const
+{
+	int mapWidth = m_config.mapWidth;
+	printf( "player             %s by %s\n", m_player.GivePlayerName(), m_player.GiveAuthorName() );
+	printf( "match              seed %u, %dx%d map, %d threads, %d enemies, fog %s\n", m_config.seed, mapWidth, mapWidth,
+		m_config.numThreads, m_config.numEnemies, m_config.fogOfWar ? "on" : "off" );
+	printf( "colony             %d agents (%d queens, %d workers, %d scouts, %d soldiers), %d nutrients\n",
+		GetNumLivingPlayerAgents(), GetNumLivingPlayerAgents( AGENT_TYPE_QUEEN ), GetNumLivingPlayerAgents( AGENT_TYPE_WORKER ),
+		GetNumLivingPlayerAgents( AGENT_TYPE_SCOUT ), GetNumLivingPlayerAgents( AGENT_TYPE_SOLDIER ), m_nutrients );
+	printf( "                   %d food eaten, %d births, %d deaths, %d faults\n", m_totalFoodEaten, m_totalBirths, m_totalDeaths, m_totalFaults );
+}
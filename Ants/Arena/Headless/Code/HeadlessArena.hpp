@@ -0,0 +1,173 @@
+//-----------------------------------------------------------------------------------------------
+// HeadlessArena.hpp
+//
+// A windowless stand-in for the Arena server, for benchmarking one player on Linux. It generates
+//	a map from a seed the same way MapDefinitions.xml describes them (strands of dirt, stone and
+//	water, single food tiles), plays the player's colony against optional scripted enemies with the
+//	rules of AgentDefinitions.xml / MatchDefinitions.xml, and drives the player's entry points in
+//	real time, timing every turn.
+//
+// Rules the headless arena does not model: queen combat aura, team play, fault penalties (faults
+//	are only counted), and tile drops suffocating queens.
+//
+#pragma once
+#include "ArenaPlayerInterface.hpp"
+#include "PlayerLibrary.hpp"
+#include "TurnStats.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+// Defaults are the "Final" match and map definitions, and the stock agent definitions
+struct ArenaConfig
+{
+	std::string	playerPath = "./libAntAI.so";
+	unsigned int seed = 1;
+	int		mapWidth = 100;
+	int		numTurns = 500;
+	int		numThreads = 4;
+	double	maxTurnSeconds = 0.030;		// Orders not returned within this long after ReceiveTurnState count as a missed deadline
+	double	minTurnSeconds = 0.0;		// Like minTurnTime in MatchDefinitions.xml; 0 runs turns back to back
+	bool	fogOfWar = true;
+	int		numEnemies = 0;				// Scripted enemy soldiers/workers wandering the map
+	std::string	csvPath;				// Per-turn timings are written here when set
+	bool	verbose = false;			// Echo the player's LogText
+
+	int		maxPopulation = 200;
+	int		startingNutrients = 2000;
+	int		nutrientsPerFoodEaten = 1000;
+	int		nutrientLossPerAttackerStrength = 10;
+	int		turnsUntilSuddenDeath = 1500;
+	int		suddenDeathTurnsPerUpkeepIncrease = 1;
+	int		foodCarryExhaustPenalty = 1;
+	int		tileCarryExhaustPenalty = 1;
+	int		startingAgents[ NUM_AGENT_TYPES ] = { 2, 2, 1, 1 };	// Scouts, workers, soldiers, queens
+
+	float	foodStrandsPer100Tiles = 25.0f;
+	float	foodSpawnedPerTurnPer100Tiles = 0.01f;
+	float	dirtStrandsPer100Tiles = 1.5f;
+	int		dirtStrandLength = 15;
+	float	stoneStrandsPer100Tiles = 2.5f;
+	int		stoneStrandLength = 6;
+	float	waterStrandsPer100Tiles = 0.5f;
+	int		waterStrandLength = 4;
+
+	// Sets one "key=value" command line option; false if the key is unknown or the value doesn't parse
+	bool SetFromText( std::string const& keyEqualsValue );
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Small deterministic generator (splitmix64), so a seed gives the same map on every platform
+class ArenaRandom
+{
+public:
+	explicit ArenaRandom( unsigned int seed ) : m_state( seed ) {}
+
+	uint32_t	RollRandomUInt();
+	int			RollRandomIntInRange( int minInclusive, int maxInclusive );
+	float		RollRandomFloatZeroToOne();
+
+private:
+	uint64_t m_state = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+class HeadlessArena
+{
+public:
+	explicit HeadlessArena( ArenaConfig const& config );
+	~HeadlessArena();
+
+	bool LoadPlayer( std::string& out_error );
+	void RunMatch();
+	void PrintMatchSummary() const;
+	TurnStats const& GetTurnStats() const { return m_turnStats; }
+
+private:
+	struct Agent
+	{
+		AgentID				agentID = 0;
+		PlayerID			playerID = 0;
+		eAgentType			type = AGENT_TYPE_WORKER;
+		eAgentState			state = STATE_NORMAL;
+		eAgentOrderResult	result = AGENT_WAS_CREATED;
+		eOrderCode			lastOrder = ORDER_HOLD;
+		short				tileX = 0;
+		short				tileY = 0;
+		short				exhaustion = 0;
+		short				receivedCombatDamage = 0;
+		short				receivedSuffocationDamage = 0;
+	};
+
+	void SetupMatchInfo();
+	void GenerateMap();
+	void AddStrands( eTileType tileType, float strandsPer100Tiles, int strandLength );
+	void SpawnStartingAgents();
+	Agent& SpawnAgent( PlayerID playerID, eAgentType type, int tileX, int tileY );
+	void SpawnEnemies();
+
+	void BuildTurnState();
+	void UpdateVisibility();
+	bool CollectOrders( TurnTiming& out_turnTiming );
+	void ResolveOrders();
+	void ResolveOrder( int agentIndex, eOrderCode order );
+	void ResolveMove( Agent& agent, int targetX, int targetY );
+	void ResolveDig( Agent& agent, int targetX, int targetY, bool isDigHere );
+	void ResolveDrop( Agent& agent );
+	void ResolveBirth( Agent& agent, eAgentType birthType );
+	void MoveEnemies();
+	void ResolveCombat();
+	void PayUpkeep();
+	void SpawnFood();
+	void KillAgent( Agent& agent, eAgentOrderResult causeOfDeath );
+	void RemoveDeadAgents();
+
+	bool IsInBounds( int tileX, int tileY ) const;
+	int GetTileIndex( int tileX, int tileY ) const { return tileY * m_config.mapWidth + tileX; }
+	bool IsAlive( Agent const& agent ) const { return agent.state != STATE_DEAD; }
+	bool IsPlayerAgent( Agent const& agent ) const { return agent.playerID == PLAYER_ID; }
+	int GetNumLivingPlayerAgents( eAgentType type = INVALID_AGENT_TYPE ) const;
+	bool IsQueenAt( int tileX, int tileY, Agent const* ignoredAgent ) const;
+
+private:
+	static constexpr PlayerID	PLAYER_ID = 100;
+	static constexpr TeamID		PLAYER_TEAM_ID = 200;
+	static constexpr PlayerID	ENEMY_PLAYER_ID = 101;
+	static constexpr TeamID		ENEMY_TEAM_ID = 201;
+
+	ArenaConfig					m_config;
+	ArenaRandom					m_random;
+	PlayerLibrary				m_player;
+	StartupInfo					m_startupInfo = {};
+	DebugInterface				m_debugInterface = {};
+
+	std::vector<eTileType>		m_tiles;
+	std::vector<unsigned char>	m_tileHasFood;
+	std::vector<unsigned char>	m_isTileVisible;
+	int							m_startX = 0;
+	int							m_startY = 0;
+	float						m_foodToSpawn = 0.0f;
+
+	std::vector<Agent>			m_agents;
+	std::unordered_map<AgentID, int> m_agentIndexesByID;
+	AgentID						m_nextAgentSerial = 1;
+
+	ArenaTurnStateForPlayer*	m_turnState = nullptr;	// Too big for the stack; allocated once
+	PlayerTurnOrders*			m_turnOrders = nullptr;
+	int							m_turnNumber = 0;
+	int							m_nutrients = 0;
+	int							m_numFaultsThisTurn = 0;
+	int							m_numSuicidesThisTurn = 0;
+	int							m_nutrientsLostToQueenDamage = 0;
+
+	int							m_totalFaults = 0;
+	int							m_totalFoodEaten = 0;
+	int							m_totalBirths = 0;
+	int							m_totalDeaths = 0;
+	TurnStats					m_turnStats;
+};
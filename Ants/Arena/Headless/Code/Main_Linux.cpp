@@ -0,0 +1,74 @@
+//-----------------------------------------------------------------------------------------------
+// Main_Linux.cpp
+//
+// Usage: headless_arena [key=value ...]
+//	e.g. headless_arena player=./libAntAI.so seed=7 turns=1000 threads=4 csv=turns.csv
+//
+#include "HeadlessArena.hpp"
+#include <stdio.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------------------------
+static void PrintUsage()
+{
+	printf( "usage: headless_arena [key=value ...]\n" );
+	printf( "  player=PATH        player shared library (default ./libAntAI.so)\n" );
+	printf( "  seed=N             map and enemy seed (default 1)\n" );
+	printf( "  width=N            map width (default 100)\n" );
+	printf( "  turns=N            turns to play (default 500)\n" );
+	printf( "  threads=N          PlayerThreadEntry threads (default 4)\n" );
+	printf( "  deadlineMs=N       orders deadline per turn (default 30)\n" );
+	printf( "  minTurnMs=N        pace turns to at least this long (default 0)\n" );
+	printf( "  fog=0|1            fog of war (default 1)\n" );
+	printf( "  enemies=N          scripted enemy agents (default 0)\n" );
+	printf( "  csv=PATH           write per-turn timings\n" );
+	printf( "  verbose=0|1        echo the player's LogText\n" );
+	printf( "  maxPopulation, nutrients, suddenDeath, scouts, workers, soldiers, queens,\n" );
+	printf( "  food, foodPerTurn, dirt, stone, water   match and map overrides\n" );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+	ArenaConfig config;
+	for( int argIndex = 1; argIndex < argc; argIndex++ )
+	{
+		if( strcmp( argv[ argIndex ], "-h" ) == 0 || strcmp( argv[ argIndex ], "--help" ) == 0 )
+		{
+			PrintUsage();
+			return 0;
+		}
+
+		if( !config.SetFromText( argv[ argIndex ] ) )
+		{
+			fprintf( stderr, "headless_arena: bad option \"%s\"\n", argv[ argIndex ] );
+			PrintUsage();
+			return 2;
+		}
+	}
+
+	HeadlessArena* arena = new HeadlessArena( config );
+	std::string loadError;
+	if( !arena->LoadPlayer( loadError ) )
+	{
+		fprintf( stderr, "headless_arena: can't load %s: %s\n", config.playerPath.c_str(), loadError.c_str() );
+		delete arena;
+		return 1;
+	}
+
+	arena->RunMatch();
+	arena->PrintMatchSummary();
+	arena->GetTurnStats().PrintSummary( config.maxTurnSeconds );
+
+	int exitCode = 0;
+	if( !config.csvPath.empty() && !arena->GetTurnStats().WriteCSV( config.csvPath ) )
+	{
+		fprintf( stderr, "headless_arena: can't write %s\n", config.csvPath.c_str() );
+		exitCode = 1;
+	}
+
+	delete arena;
+	return exitCode;
+}
@@ -0,0 +1,90 @@
+//-----------------------------------------------------------------------------------------------
+// PlayerLibrary.cpp
+//
+#include "PlayerLibrary.hpp"
+#include <dlfcn.h>
+
+
+//-----------------------------------------------------------------------------------------------
+PlayerLibrary::~PlayerLibrary()
+{
+	Unload();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool PlayerLibrary::Load( std::string const& libraryPath, std::string& out_error )
+{
+	Unload();
+	out_error.clear();
+
+	// RTLD_NOW so a player with unresolved symbols fails here instead of in the middle of a match
+	m_handle = dlopen( libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL );
+	if( !m_handle )
+	{
+		char const* loadError = dlerror();
+		out_error = loadError ? loadError : "dlopen failed";
+		return false;
+	}
+
+	GiveCommonInterfaceVersion	= (GiveCommandInterfaceVersionFunc) FindFunction( "GiveCommonInterfaceVersion", out_error );
+	GivePlayerName				= (GivePlayerNameFunc) FindFunction( "GivePlayerName", out_error );
+	GiveAuthorName				= (GiveAuthorNameFunc) FindFunction( "GiveAuthorName", out_error );
+	PreGameStartup				= (PreGameStartupFunc) FindFunction( "PreGameStartup", out_error );
+	PostGameShutdown			= (PostGameShutdownFunc) FindFunction( "PostGameShutdown", out_error );
+	PlayerThreadEntry			= (PlayerThreadEntryFunc) FindFunction( "PlayerThreadEntry", out_error );
+	ReceiveTurnState			= (ReceiveTurnStateFunc) FindFunction( "ReceiveTurnState", out_error );
+	TurnOrderRequest			= (TurnOrderRequestFunc) FindFunction( "TurnOrderRequest", out_error );
+
+	bool hasAllFunctions = GiveCommonInterfaceVersion && GivePlayerName && GiveAuthorName && PreGameStartup && PostGameShutdown
+		&& PlayerThreadEntry && ReceiveTurnState && TurnOrderRequest;
+	if( !hasAllFunctions )
+	{
+		Unload();
+		return false;
+	}
+
+	int playerInterfaceVersion = GiveCommonInterfaceVersion();
+	if( playerInterfaceVersion != COMMON_INTERFACE_VERSION_NUMBER )
+	{
+		out_error = "player was built against interface version " + std::to_string( playerInterfaceVersion ) + ", arena uses "
+			+ std::to_string( COMMON_INTERFACE_VERSION_NUMBER );
+		Unload();
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void PlayerLibrary::Unload()
+{
+	if( m_handle )
+	{
+		dlclose( m_handle );
+		m_handle = nullptr;
+	}
+
+	GiveCommonInterfaceVersion = nullptr;
+	GivePlayerName = nullptr;
+	GiveAuthorName = nullptr;
+	PreGameStartup = nullptr;
+	PostGameShutdown = nullptr;
+	PlayerThreadEntry = nullptr;
+	ReceiveTurnState = nullptr;
+	TurnOrderRequest = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void* PlayerLibrary::FindFunction( char const* functionName, std::string& out_error )
+{
+	void* function = dlsym( m_handle, functionName );
+	if( !function && out_error.empty() )
+	{
+		out_error = std::string( "player does not export " ) + functionName;
+	}
+
+	return function;
+}
@@ -0,0 +1,42 @@
+//-----------------------------------------------------------------------------------------------
+// PlayerLibrary.hpp
+//
+// Loads a player built as a shared library (.so) and finds the entry points declared in
+//	ArenaPlayerInterface.hpp, the same way the Windows arena does with LoadLibrary/GetProcAddress.
+//
+#pragma once
+#include "ArenaPlayerInterface.hpp"
+#include <string>
+
+
+//-----------------------------------------------------------------------------------------------
+class PlayerLibrary
+{
+public:
+	PlayerLibrary() = default;
+	~PlayerLibrary();
+	PlayerLibrary( PlayerLibrary const& copyFrom ) = delete;
+	PlayerLibrary& operator=( PlayerLibrary const& copyFrom ) = delete;
+
+	// Fills out_error and returns false if the library can't be opened, misses an entry point, or
+	//	was built against a different COMMON_INTERFACE_VERSION_NUMBER
+	bool Load( std::string const& libraryPath, std::string& out_error );
+	void Unload();
+	bool IsLoaded() const { return m_handle != nullptr; }
+
+public:
+	GiveCommandInterfaceVersionFunc	GiveCommonInterfaceVersion = nullptr;
+	GivePlayerNameFunc				GivePlayerName = nullptr;
+	GiveAuthorNameFunc				GiveAuthorName = nullptr;
+	PreGameStartupFunc				PreGameStartup = nullptr;
+	PostGameShutdownFunc			PostGameShutdown = nullptr;
+	PlayerThreadEntryFunc			PlayerThreadEntry = nullptr;
+	ReceiveTurnStateFunc			ReceiveTurnState = nullptr;
+	TurnOrderRequestFunc			TurnOrderRequest = nullptr;
+
+private:
+	void* FindFunction( char const* functionName, std::string& out_error );
+
+private:
+	void* m_handle = nullptr;
+};
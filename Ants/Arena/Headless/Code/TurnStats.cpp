@@ -0,0 +1,154 @@
+//-----------------------------------------------------------------------------------------------
+// TurnStats.cpp
+//
+#include "TurnStats.hpp"
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------------------------
+static double GetPercentile( std::vector<double>& values, double fraction )
+{
+	if( values.empty() )
+		return 0.0;
+
+	std::sort( values.begin(), values.end() );
+	size_t rank = (size_t)ceil( fraction * (double)values.size() );
+	rank = std::max( rank, (size_t)1 );
+	rank = std::min( rank, values.size() );
+	return values[ rank - 1 ];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int TurnStats::GetNumMissedDeadlines() const
+{
+	int numMissed = 0;
+	for( TurnTiming const& turnTiming : m_turns )
+	{
+		if( turnTiming.missedDeadline )
+			numMissed++;
+	}
+
+	return numMissed;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+double TurnStats::GetOrdersPercentile( double fraction ) const
+{
+	std::vector<double> values;
+	values.reserve( m_turns.size() );
+	for( TurnTiming const& turnTiming : m_turns )
+	{
+		values.push_back( turnTiming.ordersSeconds );
+	}
+
+	return GetPercentile( values, fraction );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+double TurnStats::GetReceivePercentile( double fraction ) const
+{
+	std::vector<double> values;
+	values.reserve( m_turns.size() );
+	for( TurnTiming const& turnTiming : m_turns )
+	{
+		values.push_back( turnTiming.receiveSeconds );
+	}
+
+	return GetPercentile( values, fraction );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+double TurnStats::GetAverageOrdersSeconds() const
+{
+	if( m_turns.empty() )
+		return 0.0;
+
+	double totalSeconds = 0.0;
+	for( TurnTiming const& turnTiming : m_turns )
+	{
+		totalSeconds += turnTiming.ordersSeconds;
+	}
+
+	return totalSeconds / (double)m_turns.size();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TurnStats::PrintSummary( double maxTurnSeconds ) const
+{
+	double const MS = 1000.0;
+	printf( "turns              %d\n", GetNumTurns() );
+	printf( "orders latency ms  avg %.3f  p50 %.3f  p90 %.3f  p99 %.3f  p99.9 %.3f  max %.3f\n",
+		GetAverageOrdersSeconds() * MS, GetOrdersPercentile( 0.5 ) * MS, GetOrdersPercentile( 0.9 ) * MS,
+		GetOrdersPercentile( 0.99 ) * MS, GetOrdersPercentile( 0.999 ) * MS, GetOrdersPercentile( 1.0 ) * MS );
+	printf( "receive ms         p50 %.3f  p99 %.3f  max %.3f\n",
+		GetReceivePercentile( 0.5 ) * MS, GetReceivePercentile( 0.99 ) * MS, GetReceivePercentile( 1.0 ) * MS );
+	printf( "missed deadlines   %d (deadline %.1f ms)\n", GetNumMissedDeadlines(), maxTurnSeconds * MS );
+	printf( "peak memory        %zu KB (current %zu KB)\n", GetPeakResidentKB(), GetCurrentResidentKB() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool TurnStats::WriteCSV( std::string const& filePath ) const
+{
+	FILE* file = fopen( filePath.c_str(), "w" );
+	if( !file )
+		return false;
+
+	fprintf( file, "turn,receive_us,orders_us,order_requests,missed_deadline,agents,nutrients\n" );
+	for( TurnTiming const& turnTiming : m_turns )
+	{
+		fprintf( file, "%d,%.1f,%.1f,%d,%d,%d,%d\n", turnTiming.turnNumber, turnTiming.receiveSeconds * 1000000.0,
+			turnTiming.ordersSeconds * 1000000.0, turnTiming.numOrderRequests, turnTiming.missedDeadline ? 1 : 0,
+			turnTiming.numAgents, turnTiming.nutrients );
+	}
+
+	fclose( file );
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads one "Name:   1234 kB" line from /proc/self/status
+static size_t ReadProcStatusKB( char const* fieldName )
+{
+	FILE* file = fopen( "/proc/self/status", "r" );
+	if( !file )
+		return 0;
+
+	size_t fieldNameLength = strlen( fieldName );
+	size_t valueKB = 0;
+	char line[ 256 ];
+	while( fgets( line, sizeof( line ), file ) )
+	{
+		if( strncmp( line, fieldName, fieldNameLength ) == 0 && line[ fieldNameLength ] == ':' )
+		{
+			sscanf( line + fieldNameLength + 1, "%zu", &valueKB );
+			break;
+		}
+	}
+
+	fclose( file );
+	return valueKB;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+size_t GetCurrentResidentKB()
+{
+	return ReadProcStatusKB( "VmRSS" );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+size_t GetPeakResidentKB()
+{
+	return ReadProcStatusKB( "VmHWM" );
+}
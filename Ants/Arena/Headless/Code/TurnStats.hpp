@@ -0,0 +1,48 @@
+//-----------------------------------------------------------------------------------------------
+// TurnStats.hpp
+//
+// Per-turn timings collected by the headless arena, and the summary printed at the end of a match.
+//
+#pragma once
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+struct TurnTiming
+{
+	int		turnNumber = 0;
+	double	receiveSeconds = 0.0;	// Time spent inside ReceiveTurnState
+	double	ordersSeconds = 0.0;	// From calling ReceiveTurnState to TurnOrderRequest returning true
+	int		numOrderRequests = 0;	// TurnOrderRequest calls, including the ones that returned false
+	bool	missedDeadline = false;	// Orders weren't ready within maxTurnSeconds; the colony held this turn
+	int		numAgents = 0;
+	int		nutrients = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+class TurnStats
+{
+public:
+	void AddTurn( TurnTiming const& turnTiming ) { m_turns.push_back( turnTiming ); }
+	int GetNumTurns() const { return (int)m_turns.size(); }
+	int GetNumMissedDeadlines() const;
+
+	// Nearest-rank percentile of the order latency, in seconds; fraction is 0..1
+	double GetOrdersPercentile( double fraction ) const;
+	double GetReceivePercentile( double fraction ) const;
+	double GetAverageOrdersSeconds() const;
+
+	void PrintSummary( double maxTurnSeconds ) const;
+	bool WriteCSV( std::string const& filePath ) const;
+
+private:
+	std::vector<TurnTiming> m_turns;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Resident memory of this process (arena + player), in kilobytes; 0 where unavailable
+size_t GetCurrentResidentKB();
+size_t GetPeakResidentKB();
@@ -574,6 +574,8 @@ void Game::UpdateDelaunay2D(float deltaSeconds)
 	UpdateDeveloperCheatCodes(deltaSeconds);
 	CheckForConvexPoly2DOverlap();
 
+	m_triangulation2D.Update(m_convexPoly->GetPoly(), m_artificialPoints, m_maxDelaunay2DStep);
+
 	//DisplayClocksInfo();
 
 
@@ -696,12 +698,10 @@ void Game::UpdateInputDelaunay2D(float deltaSeconds)
 		m_allPolygons.erase(vecIterator);
 		m_allPolygonsColors.erase(m_allPolygonsColors.begin() + index);
 
-		std::vector<DelaunayTriangle> triangulatedPoly = TriangulateConvexPoly2D(m_convexPoly->GetPoly(),m_artificialPoints, true);
-		std::vector<DelaunayEdge> voronoiRegionEdges = GetVoronoiDiagramFromConvexPoly(triangulatedPoly, m_convexPoly->GetPoly(), m_artificialPoints);
-
 		Vec2 prevMiddlePos = m_convexPoly->GetPoly().m_middlePoint;
 
-		std::vector<DelaunayConvexPoly2D> subPolys = SplitConvexPoly(voronoiRegionEdges, m_convexPoly->GetPoly());
+		m_triangulation2D.Update(m_convexPoly->GetPoly(), m_artificialPoints); // Already built if nothing changed since the last frame
+		std::vector<DelaunayConvexPoly2D> subPolys = m_triangulation2D.GetSplitPolys();
 
 
 		for (int subPolyInd = 0; subPolyInd < subPolys.size(); subPolyInd++) {
@@ -778,6 +778,8 @@ void Game::UpdateDelaunay3D(float deltaSeconds)
 	UpdateDeveloperCheatCodes(deltaSeconds);
 	UpdateEntities(deltaSeconds);
 
+	m_triangulation3D.Update(m_convexPoly3D->GetPoly(), m_maxDelaunay3DStep);
+
 
 
 	//DisplayClocksInfo();
@@ -1255,9 +1257,7 @@ void Game::RenderDelaunay2D() const
 
 	std::vector<Vertex_PCU> verts;
 
-	std::vector<DelaunayTriangle> triangulatedPoly = TriangulateConvexPoly2D(m_convexPoly->GetPoly(), m_artificialPoints, true, 0.1f, m_maxDelaunay2DStep);
-	std::vector<DelaunayTriangle> triangulatedPolyExcludeSuper = TriangulateConvexPoly2D(m_convexPoly->GetPoly(), m_artificialPoints, false, 0.1f, m_maxDelaunay2DStep);
-	DelaunayTriangle const& superTriangle = GetASuperTriangleFromPoly(m_convexPoly->GetPoly());
+	DelaunayTriangle const& superTriangle = m_triangulation2D.GetSuperTriangle();
 
 	g_theRenderer->BindTexture(nullptr);
 
@@ -1274,7 +1274,7 @@ void Game::RenderDelaunay2D() const
 
 	if (m_drawVoronoiRegions) {
 
-		std::vector<DelaunayEdge> voronoi = GetVoronoiDiagramFromConvexPoly(triangulatedPoly, m_convexPoly->GetPoly(), m_artificialPoints);
+		std::vector<DelaunayEdge> const& voronoi = m_triangulation2D.GetVoronoiEdges();
 
 		if (m_maxVoronoiStep2D <= -1) m_maxVoronoiStep2D = (int)voronoi.size();
 		if (m_maxVoronoiStep2D > (int)voronoi.size()) m_maxVoronoiStep2D = 1;
@@ -1293,7 +1293,7 @@ void Game::RenderDelaunay2D() const
 	}
 
 	if (m_drawTriangleMesh) {
-		std::vector<DelaunayTriangle>const& drawingTriangles = (m_drawSuperTriangle) ? triangulatedPoly : triangulatedPolyExcludeSuper;
+		std::vector<DelaunayTriangle>const& drawingTriangles = m_triangulation2D.GetTriangles(m_drawSuperTriangle);
 
 		for (int triangleIndex = 0; triangleIndex < drawingTriangles.size(); triangleIndex++) {
 			DelaunayTriangle const& triangle = drawingTriangles[triangleIndex];
@@ -1341,13 +1341,17 @@ void Game::RenderDelaunay3D() const
 	g_theRenderer->SetModelMatrix(Mat44());
 
 
-	DelaunayTetrahedron superTetra = GetASuperTetrahedronPoly(m_convexPoly3D->GetPoly());
+	DelaunayTetrahedron const& superTetra = m_triangulation3D.GetSuperTetrahedron();
 
-	std::vector<DelaunayTetrahedron> triangulatedPoly3D = TriangulateConvexPoly3D(m_convexPoly3D->GetPoly(), true, 0.1f, m_maxDelaunay3DStep);
-	std::vector<DelaunayTetrahedron> triangulatedExludingSuperTetra = TriangulateConvexPoly3D(m_convexPoly3D->GetPoly(), false, 0.1f, m_maxDelaunay3DStep);
+	if (g_drawDebug) {
+		std::vector<Vec3> const& badFaceCenters = m_triangulation3D.GetLastBadFaceCenters();
+		for (int badFaceInd = 0; badFaceInd < badFaceCenters.size(); badFaceInd++) {
+			DebugAddWorldPoint(badFaceCenters[badFaceInd], 0.15f, 0.0f, Rgba8::YELLOW, Rgba8::YELLOW, DebugRenderMode::USEDEPTH);
+		}
+	}
 
 	if (m_drawTriangleMesh) {
-		std::vector<DelaunayTetrahedron> const& drawTriangulation = (m_drawSuperTetra) ? triangulatedPoly3D : triangulatedExludingSuperTetra;
+		std::vector<DelaunayTetrahedron> const& drawTriangulation = m_triangulation3D.GetTetrahedrons(m_drawSuperTetra);
 		for (int tetraInd = 0; tetraInd < drawTriangulation.size(); tetraInd++) {
 			DelaunayTetrahedron const& tetrahedron = drawTriangulation[tetraInd];
 			tetrahedron.AddVertsForWireframe(verts, Rgba8::RED, 0.005f);
@@ -1368,10 +1372,7 @@ void Game::RenderDelaunay3D() const
 
 
 	if (m_drawVoronoiRegions) {
-		std::vector<DelaunayEdge3D> voronoiEdges = GetVoronoiDiagramFromConvexPoly3D(triangulatedPoly3D, m_convexPoly3D->GetPoly());
-		std::vector<DelaunayEdge3D> voronoiEdgesExcludeProjections = GetVoronoiDiagramFromConvexPoly3D(triangulatedPoly3D, m_convexPoly3D->GetPoly(), false);
-
-		std::vector<DelaunayEdge3D> const& drawnVoronoiEdges = (m_drawVoronoiEdgeProjections) ? voronoiEdges : voronoiEdgesExcludeProjections;
+		std::vector<DelaunayEdge3D> const& drawnVoronoiEdges = m_triangulation3D.GetVoronoiEdges(m_drawVoronoiEdgeProjections);
 
 		if (m_maxVoronoiStep > (int)drawnVoronoiEdges.size()) m_maxVoronoiStep = 1;
 		if (m_maxVoronoiStep < -1) m_maxVoronoiStep = (int)drawnVoronoiEdges.size();
@@ -3,6 +3,8 @@
 #include "Engine/Renderer/Camera.hpp"
 #include "Game/Framework/GameCommon.hpp"
 #include "Game/Gameplay/Entity.hpp"
+#include "Game/Gameplay/Triangulation.hpp"
+#include "Game/Gameplay/Triangulation3D.hpp"
 
 enum class GameState {
 	AttractScreen = -1,
@@ -187,6 +189,9 @@ private:
 	DelaunayShape2D* m_convexPoly = nullptr;
 	DelaunayShape3D* m_convexPoly3D = nullptr;
 
+	DelaunayTriangulation2D m_triangulation2D; // Of m_convexPoly and m_artificialPoints
+	DelaunayTriangulation3D m_triangulation3D;
+
 	std::vector<DelaunayShape2D*> m_allPolygons;
 	std::vector<DelaunayShape2D*> m_normalColorPolys;
 	std::vector<DelaunayShape2D*> m_highlightedPolys;
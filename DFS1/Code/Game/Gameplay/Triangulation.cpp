@@ -299,153 +299,347 @@ void DelaunayTriangle::CalculateCircumcenter()
 	m_circumcenterRadius = (m_vertexes[1] - m_circumcenter).GetLength();
 }
 
+// Predicates in double so nearly cocircular seed points don't flip the result between neighboring triangles
+static double GetOrientation2D(Vec2 const& pointA, Vec2 const& pointB, Vec2 const& point)
+{
+	double abX = (double)pointB.x - (double)pointA.x;
+	double abY = (double)pointB.y - (double)pointA.y;
+	double apX = (double)point.x - (double)pointA.x;
+	double apY = (double)point.y - (double)pointA.y;
+	return (abX * apY) - (abY * apX);
+}
 
+static double GetInCircle2D(Vec2 const& pointA, Vec2 const& pointB, Vec2 const& pointC, Vec2 const& point)
+{
+	double aX = (double)pointA.x - (double)point.x;
+	double aY = (double)pointA.y - (double)point.y;
+	double bX = (double)pointB.x - (double)point.x;
+	double bY = (double)pointB.y - (double)point.y;
+	double cX = (double)pointC.x - (double)point.x;
+	double cY = (double)pointC.y - (double)point.y;
+
+	double aSqr = (aX * aX) + (aY * aY);
+	double bSqr = (bX * bX) + (bY * bY);
+	double cSqr = (cX * cX) + (cY * cY);
+
+	return (aX * ((bY * cSqr) - (bSqr * cY))) - (aY * ((bX * cSqr) - (bSqr * cX))) + (aSqr * ((bX * cY) - (bY * cX)));
+}
 
-std::vector<DelaunayTriangle> TriangulateConvexPoly2D(DelaunayConvexPoly2D const& convexPoly, std::vector<Vec2> const& artificialPoints, bool includeSuperTriangle, float toleranceVertexDistance, int maxSteps)
+static unsigned int GetHilbertIndex(unsigned int x, unsigned int y)
 {
+	unsigned int index = 0;
+	for (unsigned int side = 1u << 15; side > 0; side >>= 1) {
+		unsigned int rotateX = (x & side) ? 1u : 0u;
+		unsigned int rotateY = (y & side) ? 1u : 0u;
+		index += side * side * ((3u * rotateX) ^ rotateY);
+		if (rotateY == 0) {
+			if (rotateX == 1) {
+				x = side - 1 - (x & (side - 1));
+				y = side - 1 - (y & (side - 1));
+			}
+			unsigned int temp = x;
+			x = y;
+			y = temp;
+		}
+	}
+	return index;
+}
 
-	std::vector<DelaunayTriangle> calculatedTriangles;
-	calculatedTriangles.reserve(convexPoly.m_vertexes.size() * 5);
+// Biased randomized insertion order: shuffled, then split in rounds that double in size, each sorted along a Hilbert curve.
+// Consecutive points land next to each other, so the walk is short, while the rounds keep the expected cavity size constant
+static void GetBRIOInsertionOrder(std::vector<Vec2> const& points, std::vector<int>& order)
+{
+	int pointCount = (int)points.size();
+	order.resize(pointCount);
+	for (int pointIndex = 0; pointIndex < pointCount; pointIndex++) {
+		order[pointIndex] = pointIndex;
+	}
 
+	// The Engine rng can't be seeded, and the same points must give the same triangulation every time
+	unsigned int hashState = 0x9E3779B9u ^ (unsigned int)pointCount;
+	for (int pointIndex = pointCount - 1; pointIndex > 0; pointIndex--) {
+		hashState ^= hashState << 13;
+		hashState ^= hashState >> 17;
+		hashState ^= hashState << 5;
+		int swapIndex = (int)(hashState % (unsigned int)(pointIndex + 1));
+		std::swap(order[pointIndex], order[swapIndex]);
+	}
 
-	DelaunayTriangle superTriangle = GetASuperTriangleFromPoly(convexPoly);
-	calculatedTriangles.push_back(DelaunayTriangle(superTriangle));
+	Vec2 mins = Vec2(FLT_MAX, FLT_MAX);
+	Vec2 maxs = Vec2(-FLT_MAX, -FLT_MAX);
+	for (int pointIndex = 0; pointIndex < pointCount; pointIndex++) {
+		Vec2 const& point = points[pointIndex];
+		mins.x = (point.x < mins.x) ? point.x : mins.x;
+		mins.y = (point.y < mins.y) ? point.y : mins.y;
+		maxs.x = (point.x > maxs.x) ? point.x : maxs.x;
+		maxs.y = (point.y > maxs.y) ? point.y : maxs.y;
+	}
 
-	if (convexPoly.m_vertexes.size() < 3) {
-		return calculatedTriangles;
+	float boundsSize = ((maxs.x - mins.x) > (maxs.y - mins.y)) ? (maxs.x - mins.x) : (maxs.y - mins.y);
+	float hilbertScale = (boundsSize > 0.0f) ? (65535.0f / boundsSize) : 0.0f;
+	std::vector<unsigned int> hilbertIndexes;
+	hilbertIndexes.resize(pointCount);
+	for (int pointIndex = 0; pointIndex < pointCount; pointIndex++) {
+		Vec2 const& point = points[pointIndex];
+		unsigned int x = (unsigned int)((point.x - mins.x) * hilbertScale);
+		unsigned int y = (unsigned int)((point.y - mins.y) * hilbertScale);
+		hilbertIndexes[pointIndex] = GetHilbertIndex(x, y);
 	}
 
-	std::vector<Vec2> pointsToInsert;
-	pointsToInsert.insert(pointsToInsert.end(), convexPoly.m_vertexes.begin(), convexPoly.m_vertexes.end());
-	pointsToInsert.insert(pointsToInsert.end(), artificialPoints.begin(), artificialPoints.end());
+	auto isEarlierOnCurve = [&hilbertIndexes](int indexA, int indexB) { return hilbertIndexes[indexA] < hilbertIndexes[indexB]; };
+	int roundEnd = pointCount;
+	while (roundEnd > 0) {
+		int roundStart = (roundEnd > 64) ? roundEnd / 2 : 0;
+		std::sort(order.begin() + roundStart, order.begin() + roundEnd, isEarlierOnCurve);
+		roundEnd = roundStart;
+	}
+}
 
-	int maxLoops = (maxSteps == -1) ? (int)pointsToInsert.size() : maxSteps;
-
-	std::vector<DelaunayTriangle> badTriangles;
-	for (int vertexIndex = 0; vertexIndex < maxLoops; vertexIndex++) {
-		std::vector<DelaunayEdge> allEdges;
-		std::vector<DelaunayEdge> badEdges;
-		Vec2 const& vertex = pointsToInsert[vertexIndex];
-
-		for (int triangleIndex = 0; triangleIndex < calculatedTriangles.size(); triangleIndex++) {
-			DelaunayTriangle& triangle = calculatedTriangles[triangleIndex];
-			if (triangle.IsPointAVertex(vertex)) continue;
-			if (triangle.IsPointInsideCircumcenter(vertex)) {
-				badTriangles.push_back(triangle);
-				DelaunayEdge triangleEdges[3];
-				triangle.GetEdges(triangleEdges);
-
-				for (int edgeIndex = 0; edgeIndex < 3; edgeIndex++) {
-					if (std::find(allEdges.begin(), allEdges.end(), triangleEdges[edgeIndex]) != allEdges.end()) {
-						badEdges.push_back(triangleEdges[edgeIndex]);
-					}
-					else {
-						allEdges.push_back(triangleEdges[edgeIndex]);
-					}
-				}
-				calculatedTriangles.erase(calculatedTriangles.begin() + triangleIndex);
-				triangleIndex--;
-			}
+DelaunayMesh2D::DelaunayMesh2D(DelaunayTriangle const& superTriangle, int expectedPointCount)
+{
+	Reset(superTriangle, expectedPointCount);
+}
 
-		}
+void DelaunayMesh2D::Reset(DelaunayTriangle const& superTriangle, int expectedPointCount)
+{
+	m_vertexes.clear();
+	m_triangles.clear();
+	m_lastTriangle = 0;
+
+	m_vertexes.reserve(expectedPointCount + 3);
+	m_triangles.reserve((expectedPointCount * 2) + 1);
+
+	m_vertexes.push_back(superTriangle.m_vertexes[0]);
+	m_vertexes.push_back(superTriangle.m_vertexes[1]);
+	m_vertexes.push_back(superTriangle.m_vertexes[2]);
+	if (GetOrientation2D(m_vertexes[0], m_vertexes[1], m_vertexes[2]) < 0.0) {
+		std::swap(m_vertexes[1], m_vertexes[2]);
+	}
 
-		for (int edgeIndex = 0; edgeIndex < allEdges.size(); edgeIndex++) {
-			DelaunayEdge const& edge = allEdges[edgeIndex];
-			if (std::find(badEdges.begin(), badEdges.end(), allEdges[edgeIndex]) == badEdges.end()) {
-				bool areSomeVertexEqual = (edge.m_pointA - edge.m_pointB).GetLengthSquared() < toleranceVertexDistance;
-				areSomeVertexEqual = areSomeVertexEqual || ((edge.m_pointA - vertex).GetLengthSquared() < toleranceVertexDistance);
-				areSomeVertexEqual = areSomeVertexEqual || ((edge.m_pointB - vertex).GetLengthSquared() < toleranceVertexDistance);
-				if (!areSomeVertexEqual) {
-					DelaunayTriangle newTriangle(edge.m_pointA, edge.m_pointB, vertex);
-					if (newTriangle.IsTriangleCollapsed()) continue; // Warning. Collapsed triangles are common in this algorithm. It's a question of how collapsed I allow it to be
-					auto it = std::find(badTriangles.begin(), badTriangles.end(), newTriangle);
+	DelaunayMeshTriangle rootTriangle;
+	rootTriangle.m_vertexes[0] = 0;
+	rootTriangle.m_vertexes[1] = 1;
+	rootTriangle.m_vertexes[2] = 2;
+	m_triangles.push_back(rootTriangle);
+}
 
-					if (it == badTriangles.end()) {
-						calculatedTriangles.emplace_back(edge.m_pointA, edge.m_pointB, vertex);
-					}
+bool DelaunayMesh2D::InsertPoint(Vec2 const& point, float toleranceSqr)
+{
+	int containingTriangle = FindContainingTriangle(point);
+	if (containingTriangle == -1) return false;
+
+	FloodFillCavity(containingTriangle, point);
+
+	// The closest vertex to the point is always on the cavity boundary, and so is every vertex of the new triangles
+	for (int edgeIndex = 0; edgeIndex < m_cavityEdges.size(); edgeIndex++) {
+		CavityEdge const& edge = m_cavityEdges[edgeIndex];
+		Vec2 const& vertexA = m_vertexes[edge.m_vertexA];
+		Vec2 const& vertexB = m_vertexes[edge.m_vertexB];
+		if ((vertexA - point).GetLengthSquared() < toleranceSqr) return false;
+		if (GetOrientation2D(vertexA, vertexB, point) <= 0.0) return false; // Would be collapsed or flipped
+	}
+
+	int newVertex = (int)m_vertexes.size();
+	m_vertexes.push_back(point);
+
+	if (m_cavityEdgeByVertex.size() < m_vertexes.size()) {
+		m_cavityEdgeByVertex.resize(m_vertexes.capacity());
+	}
 
+	// The cavity always has two triangles less than edges, so its slots are reused and the remaining two appended
+	for (int edgeIndex = 0; edgeIndex < m_cavityEdges.size(); edgeIndex++) {
+		CavityEdge& edge = m_cavityEdges[edgeIndex];
+		if (edgeIndex < m_cavityTriangles.size()) {
+			edge.m_newTriangle = m_cavityTriangles[edgeIndex];
+		}
+		else {
+			edge.m_newTriangle = (int)m_triangles.size();
+			m_triangles.emplace_back();
+		}
+		m_cavityEdgeByVertex[edge.m_vertexA] = edgeIndex;
+	}
+
+	for (int edgeIndex = 0; edgeIndex < m_cavityEdges.size(); edgeIndex++) {
+		CavityEdge const& edge = m_cavityEdges[edgeIndex];
+		DelaunayMeshTriangle& triangle = m_triangles[edge.m_newTriangle];
+		triangle.m_vertexes[0] = edge.m_vertexA;
+		triangle.m_vertexes[1] = edge.m_vertexB;
+		triangle.m_vertexes[2] = newVertex;
+
+		triangle.m_neighbors[0] = m_cavityEdges[m_cavityEdgeByVertex[edge.m_vertexB]].m_newTriangle; // Shares B -> new vertex
+		triangle.m_neighbors[2] = edge.m_outsideTriangle;
+
+		// The previous fan triangle ends at A
+		triangle.m_neighbors[1] = -1;
+		if (edge.m_outsideTriangle != -1) {
+			DelaunayMeshTriangle& outsideTriangle = m_triangles[edge.m_outsideTriangle];
+			for (int vertexIndex = 0; vertexIndex < 3; vertexIndex++) {
+				int outsideVertex = outsideTriangle.m_vertexes[vertexIndex];
+				if ((outsideVertex != edge.m_vertexA) && (outsideVertex != edge.m_vertexB)) {
+					outsideTriangle.m_neighbors[vertexIndex] = edge.m_newTriangle;
+					break;
 				}
 			}
 		}
 	}
 
-	if (includeSuperTriangle) return calculatedTriangles;
+	for (int edgeIndex = 0; edgeIndex < m_cavityEdges.size(); edgeIndex++) {
+		CavityEdge const& edge = m_cavityEdges[edgeIndex];
+		int nextTriangle = m_triangles[edge.m_newTriangle].m_neighbors[0];
+		m_triangles[nextTriangle].m_neighbors[1] = edge.m_newTriangle;
+	}
 
-	std::vector<DelaunayTriangle> resultingTriangles;
-	resultingTriangles.reserve(convexPoly.m_vertexes.size() - 2); // A convex poly should have this a mount of triangles if triangulated correctly
+	m_lastTriangle = m_cavityEdges[0].m_newTriangle;
+	return true;
+}
 
-	for (int triangleIndex = 0; triangleIndex < calculatedTriangles.size(); triangleIndex++) {
-		DelaunayTriangle const& triangle = calculatedTriangles[triangleIndex];
-		if (triangle.ContainsAnyTriangleVertex(superTriangle)) continue;
-		resultingTriangles.push_back(triangle);
+void DelaunayMesh2D::InsertPoints(std::vector<Vec2> const& points, float toleranceSqr, int maxPoints)
+{
+	if (maxPoints >= 0) {
+		int pointCount = (maxPoints < points.size()) ? maxPoints : (int)points.size();
+		for (int pointIndex = 0; pointIndex < pointCount; pointIndex++) {
+			InsertPoint(points[pointIndex], toleranceSqr);
+		}
+		return;
 	}
 
+	std::vector<int> insertionOrder;
+	GetBRIOInsertionOrder(points, insertionOrder);
+	for (int orderIndex = 0; orderIndex < insertionOrder.size(); orderIndex++) {
+		InsertPoint(points[insertionOrder[orderIndex]], toleranceSqr);
+	}
+}
 
-
-	return resultingTriangles;
+bool DelaunayMesh2D::TouchesSuperTriangle(int triangleIndex) const
+{
+	DelaunayMeshTriangle const& triangle = m_triangles[triangleIndex];
+	return (triangle.m_vertexes[0] < 3) || (triangle.m_vertexes[1] < 3) || (triangle.m_vertexes[2] < 3);
 }
 
-std::vector<DelaunayTriangle> TriangulatePointSet2D(std::vector<Vec2> const& pointSet, bool includeSuperTriangle)
+DelaunayTriangle const DelaunayMesh2D::GetTriangle(int triangleIndex) const
 {
-	std::vector<DelaunayTriangle> calculatedTriangles;
+	DelaunayMeshTriangle const& triangle = m_triangles[triangleIndex];
+	return DelaunayTriangle(m_vertexes[triangle.m_vertexes[0]], m_vertexes[triangle.m_vertexes[1]], m_vertexes[triangle.m_vertexes[2]]);
+}
 
-	if (pointSet.size() < 3) {
-		return calculatedTriangles;
+void DelaunayMesh2D::GetTriangles(std::vector<DelaunayTriangle>& triangles, bool includeSuperTriangle) const
+{
+	triangles.reserve(triangles.size() + m_triangles.size());
+	for (int triangleIndex = 0; triangleIndex < m_triangles.size(); triangleIndex++) {
+		if (!includeSuperTriangle && TouchesSuperTriangle(triangleIndex)) continue;
+		triangles.push_back(GetTriangle(triangleIndex));
 	}
-	DelaunayTriangle superTriangle = GetASuperTriangleFromPointSet2D(pointSet);
-	calculatedTriangles.push_back(DelaunayTriangle(superTriangle));
-
-	for (int vertexIndex = 0; vertexIndex < pointSet.size(); vertexIndex++) {
-		//for (int vertexIndex = 0; vertexIndex < 2; vertexIndex++) {
-		std::vector<DelaunayTriangle> badTriangles;
-		std::vector<DelaunayEdge> allEdges;
-		std::vector<DelaunayEdge> badEdges;
-		Vec2 const& vertex = pointSet[vertexIndex];
-
-		for (int triangleIndex = 0; triangleIndex < calculatedTriangles.size(); triangleIndex++) {
-			DelaunayTriangle& triangle = calculatedTriangles[triangleIndex];
-			if (triangle.IsPointAVertex(vertex)) continue;
-			if (triangle.IsPointInsideCircumcenter(vertex)) {
-				badTriangles.push_back(triangle);
-				DelaunayEdge triangleEdges[3];
-				triangle.GetEdges(triangleEdges);
-
-				for (int edgeIndex = 0; edgeIndex < 3; edgeIndex++) {
-					if (std::find(allEdges.begin(), allEdges.end(), triangleEdges[edgeIndex]) != allEdges.end()) {
-						badEdges.push_back(triangleEdges[edgeIndex]);
-					}
-					else {
-						allEdges.push_back(triangleEdges[edgeIndex]);
-					}
-				}
-				calculatedTriangles.erase(calculatedTriangles.begin() + triangleIndex);
-				triangleIndex--;
-			}
+}
 
+int DelaunayMesh2D::FindContainingTriangle(Vec2 const& point) const
+{
+	int currentTriangle = m_lastTriangle;
+	int maxSteps = (int)m_triangles.size() + 3;
+
+	// Cross whichever edge has the point on its far side. Starting the check on a different edge each step keeps the walk
+	// from cycling around degenerate configurations
+	for (int stepIndex = 0; stepIndex < maxSteps; stepIndex++) {
+		DelaunayMeshTriangle const& triangle = m_triangles[currentTriangle];
+		int nextTriangle = currentTriangle;
+		for (int edgeCount = 0; edgeCount < 3; edgeCount++) {
+			int edgeIndex = (stepIndex + edgeCount) % 3;
+			Vec2 const& edgeStart = m_vertexes[triangle.m_vertexes[(edgeIndex + 1) % 3]];
+			Vec2 const& edgeEnd = m_vertexes[triangle.m_vertexes[(edgeIndex + 2) % 3]];
+			if (GetOrientation2D(edgeStart, edgeEnd, point) < 0.0) {
+				nextTriangle = triangle.m_neighbors[edgeIndex];
+				break;
+			}
 		}
 
-		for (int edgeIndex = 0; edgeIndex < allEdges.size(); edgeIndex++) {
-			DelaunayEdge const& edge = allEdges[edgeIndex];
-			if (std::find(badEdges.begin(), badEdges.end(), allEdges[edgeIndex]) == badEdges.end()) {
-				calculatedTriangles.emplace_back(edge.m_pointA, edge.m_pointB, vertex);
+		if (nextTriangle == -1) return -1; // Outside the super triangle
+		if (nextTriangle == currentTriangle) return currentTriangle;
+		currentTriangle = nextTriangle;
+	}
+
+	return -1;
+}
+
+bool DelaunayMesh2D::IsPointInsideCircumcircle(int triangleIndex, Vec2 const& point) const
+{
+	DelaunayMeshTriangle const& triangle = m_triangles[triangleIndex];
+	return GetInCircle2D(m_vertexes[triangle.m_vertexes[0]], m_vertexes[triangle.m_vertexes[1]], m_vertexes[triangle.m_vertexes[2]], point) > 0.0;
+}
+
+void DelaunayMesh2D::FloodFillCavity(int startTriangle, Vec2 const& point)
+{
+	m_insertionStamp++;
+	if (m_cavityStamps.size() < m_triangles.size()) {
+		m_cavityStamps.resize(m_triangles.capacity(), 0);
+	}
+
+	m_cavityTriangles.clear();
+	m_cavityEdges.clear();
+	m_floodStack.clear();
+
+	m_cavityStamps[startTriangle] = m_insertionStamp;
+	m_floodStack.push_back(startTriangle);
+
+	while (!m_floodStack.empty()) {
+		int triangleIndex = m_floodStack.back();
+		m_floodStack.pop_back();
+		m_cavityTriangles.push_back(triangleIndex);
+
+		DelaunayMeshTriangle const& triangle = m_triangles[triangleIndex];
+		for (int edgeIndex = 0; edgeIndex < 3; edgeIndex++) {
+			int neighborIndex = triangle.m_neighbors[edgeIndex];
+			if ((neighborIndex != -1) && (m_cavityStamps[neighborIndex] == m_insertionStamp)) continue;
+
+			if ((neighborIndex != -1) && IsPointInsideCircumcircle(neighborIndex, point)) {
+				m_cavityStamps[neighborIndex] = m_insertionStamp;
+				m_floodStack.push_back(neighborIndex);
+				continue;
 			}
+
+			CavityEdge cavityEdge;
+			cavityEdge.m_vertexA = triangle.m_vertexes[(edgeIndex + 1) % 3];
+			cavityEdge.m_vertexB = triangle.m_vertexes[(edgeIndex + 2) % 3];
+			cavityEdge.m_outsideTriangle = neighborIndex;
+			m_cavityEdges.push_back(cavityEdge);
 		}
 	}
+}
 
+std::vector<DelaunayTriangle> TriangulateConvexPoly2D(DelaunayConvexPoly2D const& convexPoly, std::vector<Vec2> const& artificialPoints, bool includeSuperTriangle, float toleranceVertexDistance, int maxSteps)
+{
+	std::vector<DelaunayTriangle> calculatedTriangles;
 
+	DelaunayTriangle superTriangle = GetASuperTriangleFromPoly(convexPoly);
+	if (convexPoly.m_vertexes.size() < 3) {
+		calculatedTriangles.push_back(superTriangle);
+		return calculatedTriangles;
+	}
 
-	if (includeSuperTriangle) return calculatedTriangles;
+	std::vector<Vec2> pointsToInsert;
+	pointsToInsert.reserve(convexPoly.m_vertexes.size() + artificialPoints.size());
+	pointsToInsert.insert(pointsToInsert.end(), convexPoly.m_vertexes.begin(), convexPoly.m_vertexes.end());
+	pointsToInsert.insert(pointsToInsert.end(), artificialPoints.begin(), artificialPoints.end());
 
-	std::vector<DelaunayTriangle> resultingTriangles;
-	resultingTriangles.reserve(pointSet.size() - 2); // A convex poly should have this a mount of triangles if triangulated correctly
+	DelaunayMesh2D mesh(superTriangle, (int)pointsToInsert.size());
+	mesh.InsertPoints(pointsToInsert, toleranceVertexDistance, maxSteps); // The tolerance was always compared against squared lengths
+	mesh.GetTriangles(calculatedTriangles, includeSuperTriangle);
 
-	for (int triangleIndex = 0; triangleIndex < calculatedTriangles.size(); triangleIndex++) {
-		DelaunayTriangle const& triangle = calculatedTriangles[triangleIndex];
-		if (triangle.ContainsAnyTriangleVertex(superTriangle)) continue;
-		resultingTriangles.push_back(triangle);
+	return calculatedTriangles;
+}
+
+std::vector<DelaunayTriangle> TriangulatePointSet2D(std::vector<Vec2> const& pointSet, bool includeSuperTriangle)
+{
+	std::vector<DelaunayTriangle> calculatedTriangles;
+
+	if (pointSet.size() < 3) {
+		return calculatedTriangles;
 	}
 
-	return resultingTriangles;
+	DelaunayTriangle superTriangle = GetASuperTriangleFromPointSet2D(pointSet);
+	DelaunayMesh2D mesh(superTriangle, (int)pointSet.size());
+	mesh.InsertPoints(pointSet, 0.025f * 0.025f); // Same as the default IsPointAVertex tolerance
+	mesh.GetTriangles(calculatedTriangles, includeSuperTriangle);
+
+	return calculatedTriangles;
 }
 
 std::vector<DelaunayEdge> GetVoronoiDiagram(std::vector<DelaunayTriangle> const& triangleMesh)
@@ -474,6 +668,26 @@ std::vector<DelaunayEdge> GetVoronoiDiagram(std::vector<DelaunayTriangle> const&
 	return voronoiDiagram;
 }
 
+// The edge between both circumcenters, plus the pieces joining its crossing with the poly to the poly edge it crosses
+static void AddClippedVoronoiEdge(std::vector<DelaunayEdge>& voronoiDiagram, DelaunayTriangle const& triangleA, DelaunayTriangle const& triangleB, DelaunayConvexPoly2D const& convexPoly)
+{
+	DelaunayEdge newEdge(triangleA.GetCircumcenter(), triangleB.GetCircumcenter());
+	DelaunayRaycast2D clippingResult = newEdge.ClipEdge(convexPoly);
+
+	voronoiDiagram.push_back(newEdge);
+
+	if (clippingResult.m_didImpact) {
+		voronoiDiagram.emplace_back(clippingResult.m_impactedEdgeVertexA, clippingResult.m_impactPos);
+		voronoiDiagram.emplace_back(clippingResult.m_impactedEdgeVertexB, clippingResult.m_impactPos);
+	}
+}
+
+static void RemoveCollapsedVoronoiEdges(std::vector<DelaunayEdge>& voronoiDiagram)
+{
+	auto isCollapsed = [](DelaunayEdge const& edge) { return GetDistanceSquared2D(edge.m_pointA, edge.m_pointB) < 0.000025f; };
+	voronoiDiagram.erase(std::remove_if(voronoiDiagram.begin(), voronoiDiagram.end(), isCollapsed), voronoiDiagram.end());
+}
+
 std::vector<DelaunayEdge> GetVoronoiDiagramFromConvexPoly(std::vector<DelaunayTriangle> const& triangleMesh, DelaunayConvexPoly2D const& convexPoly, std::vector<Vec2> const& artificialPoints)
 {
 	std::vector<DelaunayEdge> voronoiDiagram;
@@ -487,35 +701,125 @@ std::vector<DelaunayEdge> GetVoronoiDiagramFromConvexPoly(std::vector<DelaunayTr
 			if (!IsComposedOfInterestPoints(triangleA, convexPoly, artificialPoints) && !IsComposedOfInterestPoints(triangleB, convexPoly, artificialPoints)) continue;
 
 			if (triangleA.DoTrianglesShareEdge(triangleB)) {
-				DelaunayEdge newEdge(triangleA.GetCircumcenter(), triangleB.GetCircumcenter());
-				DelaunayRaycast2D clippingResult = newEdge.ClipEdge(convexPoly);
+				AddClippedVoronoiEdge(voronoiDiagram, triangleA, triangleB, convexPoly);
+			}
+		}
+	}
 
-				voronoiDiagram.push_back(newEdge);
+	RemoveCollapsedVoronoiEdges(voronoiDiagram);
 
-				if (clippingResult.m_didImpact) {
-					voronoiDiagram.emplace_back(clippingResult.m_impactedEdgeVertexA, clippingResult.m_impactPos);
-					voronoiDiagram.emplace_back(clippingResult.m_impactedEdgeVertexB, clippingResult.m_impactPos);
-				}
-			}
+	return voronoiDiagram;
+}
+
+bool DelaunayTriangulation2D::Update(DelaunayConvexPoly2D const& convexPoly, std::vector<Vec2> const& artificialPoints, int maxSteps, float toleranceVertexDistance)
+{
+	if (IsBuiltFrom(convexPoly, artificialPoints, maxSteps, toleranceVertexDistance)) return false;
+
+	m_isBuilt = true;
+	m_convexPoly = convexPoly;
+	m_artificialPoints = artificialPoints;
+	m_maxSteps = maxSteps;
+	m_toleranceVertexDistance = toleranceVertexDistance;
+
+	m_areInnerTrianglesBuilt = false;
+	m_areVoronoiEdgesBuilt = false;
+	m_areSplitPolysBuilt = false;
+
+	std::vector<Vec2> pointsToInsert;
+	pointsToInsert.reserve(convexPoly.m_vertexes.size() + artificialPoints.size());
+	pointsToInsert.insert(pointsToInsert.end(), convexPoly.m_vertexes.begin(), convexPoly.m_vertexes.end());
+	pointsToInsert.insert(pointsToInsert.end(), artificialPoints.begin(), artificialPoints.end());
+
+	m_superTriangle = GetASuperTriangleFromPoly(convexPoly);
+	m_mesh.Reset(m_superTriangle, (int)pointsToInsert.size());
+	if (convexPoly.m_vertexes.size() >= 3) {
+		m_mesh.InsertPoints(pointsToInsert, toleranceVertexDistance, maxSteps);
+	}
+
+	m_triangles.clear();
+	m_mesh.GetTriangles(m_triangles, true);
+
+	return true;
+}
+
+std::vector<DelaunayTriangle> const& DelaunayTriangulation2D::GetTriangles(bool includeSuperTriangle) const
+{
+	if (includeSuperTriangle) return m_triangles;
+
+	if (!m_areInnerTrianglesBuilt) {
+		m_innerTriangles.clear();
+		for (int triangleIndex = 0; triangleIndex < m_triangles.size(); triangleIndex++) {
+			if (m_mesh.TouchesSuperTriangle(triangleIndex)) continue;
+			m_innerTriangles.push_back(m_triangles[triangleIndex]);
 		}
+		m_areInnerTrianglesBuilt = true;
+	}
+
+	return m_innerTriangles;
+}
+
+std::vector<DelaunayEdge> const& DelaunayTriangulation2D::GetVoronoiEdges() const
+{
+	if (!m_areVoronoiEdgesBuilt) {
+		BuildVoronoiEdges();
+		m_areVoronoiEdgesBuilt = true;
+	}
+
+	return m_voronoiEdges;
+}
+
+std::vector<DelaunayConvexPoly2D> const& DelaunayTriangulation2D::GetSplitPolys() const
+{
+	if (!m_areSplitPolysBuilt) {
+		m_splitPolys = SplitConvexPoly(GetVoronoiEdges(), m_convexPoly);
+		m_areSplitPolysBuilt = true;
 	}
 
+	return m_splitPolys;
+}
 
-	for (std::vector<DelaunayEdge>::iterator edgeIt = voronoiDiagram.begin(); edgeIt != voronoiDiagram.end();) {
-		DelaunayEdge const& edge = *edgeIt;
+bool DelaunayTriangulation2D::IsBuiltFrom(DelaunayConvexPoly2D const& convexPoly, std::vector<Vec2> const& artificialPoints, int maxSteps, float toleranceVertexDistance) const
+{
+	if (!m_isBuilt) return false;
+	if ((maxSteps != m_maxSteps) || (toleranceVertexDistance != m_toleranceVertexDistance)) return false;
+	if (convexPoly.m_middlePoint != m_convexPoly.m_middlePoint) return false; // Not recalculated when a vertex is added, and the super triangle depends on it
 
-		float distanceBetVerts = GetDistanceSquared2D(edge.m_pointA, edge.m_pointB);
+	return (convexPoly.m_vertexes == m_convexPoly.m_vertexes) && (artificialPoints == m_artificialPoints);
+}
 
-		if (distanceBetVerts < (0.000025f)) {
-			edgeIt = voronoiDiagram.erase(edgeIt);
+// The mesh links already say which triangles share an edge, so every pair is visited once instead of testing them all.
+// Pairs are visited in the same order as GetVoronoiDiagramFromConvexPoly, so stepping through the edges looks the same
+void DelaunayTriangulation2D::BuildVoronoiEdges() const
+{
+	m_voronoiEdges.clear();
+
+	for (int triangleIndex = 0; triangleIndex < m_mesh.m_triangles.size(); triangleIndex++) {
+		DelaunayMeshTriangle const& triangle = m_mesh.m_triangles[triangleIndex];
+
+		int laterNeighbors[3] = {};
+		int laterNeighborCount = 0;
+		for (int edgeIndex = 0; edgeIndex < 3; edgeIndex++) {
+			int neighborIndex = triangle.m_neighbors[edgeIndex];
+			if (neighborIndex <= triangleIndex) continue;
+
+			int insertIndex = laterNeighborCount;
+			while ((insertIndex > 0) && (laterNeighbors[insertIndex - 1] > neighborIndex)) {
+				laterNeighbors[insertIndex] = laterNeighbors[insertIndex - 1];
+				insertIndex--;
+			}
+			laterNeighbors[insertIndex] = neighborIndex;
+			laterNeighborCount++;
 		}
-		else {
-			edgeIt++;
+
+		for (int neighborIndex = 0; neighborIndex < laterNeighborCount; neighborIndex++) {
+			int otherTriangleIndex = laterNeighbors[neighborIndex];
+			if (m_mesh.TouchesSuperTriangle(triangleIndex) && m_mesh.TouchesSuperTriangle(otherTriangleIndex)) continue;
+
+			AddClippedVoronoiEdge(m_voronoiEdges, m_triangles[triangleIndex], m_triangles[otherTriangleIndex], m_convexPoly);
 		}
 	}
 
-
-	return voronoiDiagram;
+	RemoveCollapsedVoronoiEdges(m_voronoiEdges);
 }
 
 
@@ -1,8 +1,8 @@
 #pragma once
 #include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/ConvexPoly2D.hpp"
 #include <vector>
 
-struct DelaunayConvexPoly2D;
 struct Vertex_PCU;
 
 
@@ -80,6 +80,97 @@ private:
 	void CalculateCircumcenter();
 };
 
+// Index based Delaunay triangulation, built one point at a time. Vertexes 0 to 2 are the super triangle. Triangles are
+// counter clockwise and know the triangle across each of their edges, so a new point is found by walking towards it from
+// the last insertion, and the triangles it invalidates are flood filled from there instead of testing the whole mesh
+struct DelaunayMeshTriangle {
+	int m_vertexes[3] = { -1, -1, -1 };
+	int m_neighbors[3] = { -1, -1, -1 }; // Across the edge facing m_vertexes[i], -1 past the super triangle
+};
+
+class DelaunayMesh2D {
+public:
+	DelaunayMesh2D() = default;
+	DelaunayMesh2D(DelaunayTriangle const& superTriangle, int expectedPointCount = 0);
+
+	void Reset(DelaunayTriangle const& superTriangle, int expectedPointCount = 0); // Keeps the memory of the previous mesh
+
+	// False if the point is outside the super triangle, closer than toleranceSqr (squared) to a vertex, or would leave a collapsed triangle
+	bool InsertPoint(Vec2 const& point, float toleranceSqr);
+	// Every point in BRIO order, or only the first maxPoints in the given order so the triangulation can be stepped through
+	void InsertPoints(std::vector<Vec2> const& points, float toleranceSqr, int maxPoints = -1);
+
+	int GetTriangleCount() const { return (int)m_triangles.size(); }
+	bool TouchesSuperTriangle(int triangleIndex) const;
+	DelaunayTriangle const GetTriangle(int triangleIndex) const;
+	void GetTriangles(std::vector<DelaunayTriangle>& triangles, bool includeSuperTriangle) const;
+
+public:
+	std::vector<Vec2> m_vertexes;
+	std::vector<DelaunayMeshTriangle> m_triangles;
+
+private:
+	struct CavityEdge {
+		int m_vertexA = -1;
+		int m_vertexB = -1;
+		int m_outsideTriangle = -1;
+		int m_newTriangle = -1;
+	};
+
+	int FindContainingTriangle(Vec2 const& point) const;
+	bool IsPointInsideCircumcircle(int triangleIndex, Vec2 const& point) const;
+	void FloodFillCavity(int startTriangle, Vec2 const& point);
+
+private:
+	int m_lastTriangle = 0;
+	int m_insertionStamp = 0;
+
+	// Scratch space reused by every insertion
+	std::vector<int> m_cavityStamps; // Per triangle, the insertion whose cavity it was last added to
+	std::vector<int> m_cavityTriangles;
+	std::vector<int> m_floodStack;
+	std::vector<CavityEdge> m_cavityEdges;
+	std::vector<int> m_cavityEdgeByVertex; // Cavity edge starting at each vertex, only valid for the current cavity
+};
+
+// Triangulation of a convex poly and its artificial points, with the Voronoi edges and split polys built from it. Update
+// only rebuilds when the poly, the points or the step differ from the last build, and each view is built the first time
+// it's asked for after that, so frames where nothing changed don't recompute anything
+class DelaunayTriangulation2D {
+public:
+	// True if the triangulation had to be rebuilt
+	bool Update(DelaunayConvexPoly2D const& convexPoly, std::vector<Vec2> const& artificialPoints, int maxSteps = -1, float toleranceVertexDistance = 0.1f);
+	void Invalidate() { m_isBuilt = false; }
+
+	DelaunayTriangle const& GetSuperTriangle() const { return m_superTriangle; }
+	std::vector<DelaunayTriangle> const& GetTriangles(bool includeSuperTriangle) const;
+	std::vector<DelaunayEdge> const& GetVoronoiEdges() const; // Same as GetVoronoiDiagramFromConvexPoly on the triangles with the super triangle
+	std::vector<DelaunayConvexPoly2D> const& GetSplitPolys() const;
+
+private:
+	bool IsBuiltFrom(DelaunayConvexPoly2D const& convexPoly, std::vector<Vec2> const& artificialPoints, int maxSteps, float toleranceVertexDistance) const;
+	void BuildVoronoiEdges() const;
+
+private:
+	bool m_isBuilt = false;
+	DelaunayConvexPoly2D m_convexPoly = DelaunayConvexPoly2D(std::vector<Vec2>());
+	std::vector<Vec2> m_artificialPoints;
+	int m_maxSteps = -1;
+	float m_toleranceVertexDistance = 0.0f;
+
+	DelaunayMesh2D m_mesh;
+	DelaunayTriangle m_superTriangle;
+	std::vector<DelaunayTriangle> m_triangles; // One per mesh triangle, super triangle included
+
+	// Built on demand
+	mutable bool m_areInnerTrianglesBuilt = false;
+	mutable bool m_areVoronoiEdgesBuilt = false;
+	mutable bool m_areSplitPolysBuilt = false;
+	mutable std::vector<DelaunayTriangle> m_innerTriangles;
+	mutable std::vector<DelaunayEdge> m_voronoiEdges;
+	mutable std::vector<DelaunayConvexPoly2D> m_splitPolys;
+};
+
 DelaunayTriangle const GetASuperTriangleFromPoly(DelaunayConvexPoly2D const& convexPoly);
 std::vector<DelaunayTriangle> TriangulateConvexPoly2D(DelaunayConvexPoly2D const& convexPoly, std::vector<Vec2> const& artificialPoints, bool includeSuperTriangle = false, float toleranceVertexDistance = 0.1f, int maxSteps = -1);
 std::vector<DelaunayTriangle> TriangulatePointSet2D(std::vector<Vec2> const& pointSet, bool includeSuperTriangle = false);
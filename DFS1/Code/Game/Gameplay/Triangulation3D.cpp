@@ -247,7 +247,7 @@ void DelaunayTetrahedron::AddVertsForFace(std::vector<Vertex_PCU>& verts, Rgba8
 
 }
 
-std::vector<DelaunayTetrahedron> TriangulateConvexPoly3D(ConvexPoly3D const& convexPoly, bool includeSuperTriangle, float toleranceVertexDistance, int maxStep)
+std::vector<DelaunayTetrahedron> TriangulateConvexPoly3D(ConvexPoly3D const& convexPoly, bool includeSuperTriangle, float toleranceVertexDistance, int maxStep, std::vector<Vec3>* out_lastBadFaceCenters)
 {
 
 	int maxLoops = (maxStep == -1) ? (int)convexPoly.m_vertexes.size() : maxStep;
@@ -290,7 +290,13 @@ std::vector<DelaunayTetrahedron> TriangulateConvexPoly3D(ConvexPoly3D const& con
 
 		}
 
-		if (g_drawDebug && vertexIndex == maxLoops - 1) {
+		if (out_lastBadFaceCenters && vertexIndex == maxLoops - 1) {
+			out_lastBadFaceCenters->clear();
+			for (int badFaceInd = 0; badFaceInd < badFaces.size(); badFaceInd++) {
+				out_lastBadFaceCenters->push_back(badFaces[badFaceInd].GetCenter());
+			}
+		}
+		else if (g_drawDebug && vertexIndex == maxLoops - 1) {
 			for (int badFaceInd = 0; badFaceInd < badFaces.size(); badFaceInd++) {
 				DelaunayFace3D const& face = badFaces[badFaceInd];
 
@@ -592,3 +598,69 @@ std::vector<DelaunayEdge3D> GetVoronoiDiagramFromConvexPoly3D(std::vector<Delaun
 	return voronoiDiagram;
 }
 
+
+bool DelaunayTriangulation3D::Update(ConvexPoly3D const& convexPoly, int maxStep, float toleranceVertexDistance)
+{
+	if (IsBuiltFrom(convexPoly, maxStep, toleranceVertexDistance)) return false;
+
+	m_isBuilt = true;
+	m_convexPoly = convexPoly;
+	for (int faceIndex = 0; faceIndex < m_convexPoly.m_faces.size(); faceIndex++) {
+		m_convexPoly.m_faces[faceIndex].m_owningPolygon = &m_convexPoly;
+	}
+	m_maxStep = maxStep;
+	m_toleranceVertexDistance = toleranceVertexDistance;
+
+	m_areInnerTetrahedronsBuilt = false;
+	m_areVoronoiEdgesBuilt[0] = false;
+	m_areVoronoiEdgesBuilt[1] = false;
+
+	m_superTetrahedron = GetASuperTetrahedronPoly(m_convexPoly);
+	m_lastBadFaceCenters.clear();
+	m_tetrahedrons = TriangulateConvexPoly3D(m_convexPoly, true, toleranceVertexDistance, maxStep, &m_lastBadFaceCenters);
+
+	return true;
+}
+
+std::vector<DelaunayTetrahedron> const& DelaunayTriangulation3D::GetTetrahedrons(bool includeSuperTetrahedron) const
+{
+	if (includeSuperTetrahedron) return m_tetrahedrons;
+
+	if (!m_areInnerTetrahedronsBuilt) {
+		m_innerTetrahedrons.clear();
+		for (int tetrahedronIndex = 0; tetrahedronIndex < m_tetrahedrons.size(); tetrahedronIndex++) {
+			DelaunayTetrahedron const& tetrahedron = m_tetrahedrons[tetrahedronIndex];
+			if (tetrahedron.ContainsAnyTetrahedronVertex(m_superTetrahedron)) continue;
+			m_innerTetrahedrons.push_back(tetrahedron);
+		}
+		m_areInnerTetrahedronsBuilt = true;
+	}
+
+	return m_innerTetrahedrons;
+}
+
+std::vector<DelaunayEdge3D> const& DelaunayTriangulation3D::GetVoronoiEdges(bool includeEdgeProjections) const
+{
+	int cacheIndex = (includeEdgeProjections) ? 1 : 0;
+	if (!m_areVoronoiEdgesBuilt[cacheIndex]) {
+		m_voronoiEdges[cacheIndex] = GetVoronoiDiagramFromConvexPoly3D(m_tetrahedrons, m_convexPoly, includeEdgeProjections);
+		m_areVoronoiEdgesBuilt[cacheIndex] = true;
+	}
+
+	return m_voronoiEdges[cacheIndex];
+}
+
+bool DelaunayTriangulation3D::IsBuiltFrom(ConvexPoly3D const& convexPoly, int maxStep, float toleranceVertexDistance) const
+{
+	if (!m_isBuilt) return false;
+	if ((maxStep != m_maxStep) || (toleranceVertexDistance != m_toleranceVertexDistance)) return false;
+	if (!(convexPoly.m_middlePoint == m_convexPoly.m_middlePoint)) return false;
+	if (!(convexPoly.m_vertexes == m_convexPoly.m_vertexes)) return false;
+	if (convexPoly.m_faces.size() != m_convexPoly.m_faces.size()) return false;
+
+	for (int faceIndex = 0; faceIndex < convexPoly.m_faces.size(); faceIndex++) {
+		if (convexPoly.m_faces[faceIndex].m_faceIndexes != m_convexPoly.m_faces[faceIndex].m_faceIndexes) return false;
+	}
+
+	return true;
+}
@@ -1,12 +1,11 @@
 #pragma once
 #include "Engine/Math/Vec3.hpp"
+#include "Game/Gameplay/ConvexPoly3D.hpp"
 #include <vector>
 
 struct Vertex_PCU;
 struct Rgba8;
 
-class ConvexPoly3D;
-
 struct DelaunayRaycast3D {
 	bool m_didImpact = false;
 	Vec3 m_impactPos = Vec3::ZERO;
@@ -121,6 +120,39 @@ private:
 	void AddVertsForFace(std::vector<Vertex_PCU>& verts, Rgba8 const& faceColor, Vec3 const& pointA, Vec3 const& pointB, Vec3 const& pointC) const;
 };
 
-std::vector<DelaunayTetrahedron> TriangulateConvexPoly3D(ConvexPoly3D const& convexPoly, bool includeSuperTriangle, float toleranceVertexDistance, int maxStep = -1);
+// Bad faces of the last inserted vertex go to out_lastBadFaceCenters when given, otherwise they're drawn for a frame while debugging
+std::vector<DelaunayTetrahedron> TriangulateConvexPoly3D(ConvexPoly3D const& convexPoly, bool includeSuperTriangle, float toleranceVertexDistance, int maxStep = -1, std::vector<Vec3>* out_lastBadFaceCenters = nullptr);
 DelaunayTetrahedron const GetASuperTetrahedronPoly(ConvexPoly3D const& convexPoly);
-std::vector<DelaunayEdge3D> GetVoronoiDiagramFromConvexPoly3D(std::vector<DelaunayTetrahedron> const& tetrahedronMesh, ConvexPoly3D const& convexPoly, bool includeEdgeProjections = true);
\ No newline at end of file
+std::vector<DelaunayEdge3D> GetVoronoiDiagramFromConvexPoly3D(std::vector<DelaunayTetrahedron> const& tetrahedronMesh, ConvexPoly3D const& convexPoly, bool includeEdgeProjections = true);
+
+// Same as DelaunayTriangulation2D: rebuilt only when the poly or the step change, and every view built the first time it's asked for
+class DelaunayTriangulation3D {
+public:
+	// True if the triangulation had to be rebuilt
+	bool Update(ConvexPoly3D const& convexPoly, int maxStep = -1, float toleranceVertexDistance = 0.1f);
+	void Invalidate() { m_isBuilt = false; }
+
+	DelaunayTetrahedron const& GetSuperTetrahedron() const { return m_superTetrahedron; }
+	std::vector<DelaunayTetrahedron> const& GetTetrahedrons(bool includeSuperTetrahedron) const;
+	std::vector<DelaunayEdge3D> const& GetVoronoiEdges(bool includeEdgeProjections) const;
+	std::vector<Vec3> const& GetLastBadFaceCenters() const { return m_lastBadFaceCenters; } // Faces re-triangulated by the last inserted vertex
+
+private:
+	bool IsBuiltFrom(ConvexPoly3D const& convexPoly, int maxStep, float toleranceVertexDistance) const;
+
+private:
+	bool m_isBuilt = false;
+	ConvexPoly3D m_convexPoly = ConvexPoly3D(std::vector<Vec3>(), std::vector<Face>()); // Its faces point back to this copy, not the original
+	int m_maxStep = -1;
+	float m_toleranceVertexDistance = 0.0f;
+
+	DelaunayTetrahedron m_superTetrahedron;
+	std::vector<DelaunayTetrahedron> m_tetrahedrons; // Super tetrahedron included
+	std::vector<Vec3> m_lastBadFaceCenters;
+
+	// Built on demand
+	mutable bool m_areInnerTetrahedronsBuilt = false;
+	mutable bool m_areVoronoiEdgesBuilt[2] = { false, false }; // Without, with edge projections
+	mutable std::vector<DelaunayTetrahedron> m_innerTetrahedrons;
+	mutable std::vector<DelaunayEdge3D> m_voronoiEdges[2];
+};
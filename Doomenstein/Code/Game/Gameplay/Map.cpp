@@ -446,25 +446,43 @@ RaycastResultDoomenstein Map::RaycastAll(Vec3 const& start, Vec3 const& directio
 RaycastResultDoomenstein Map::RaycastWorldActors(Vec3 const& start, Vec3 const& direction, float distance, RaycastFilter const& filter) const
 {
 	RaycastResultDoomenstein closestImpact = {};
+	closestImpact.m_startPosition = start;
+	closestImpact.m_forwardNormal = direction;
+	closestImpact.m_maxDistance = distance;
 	closestImpact.m_impactDist = FLT_MAX;
+
+	m_raycastActorCylinders.Clear();
+	m_raycastActors.clear();
 	for (int actorIndex = 0; actorIndex < m_actors.size(); actorIndex++) {
 		Actor* actor = m_actors[actorIndex];
 		if (!actor || actor == filter.m_ignoreActor || actor->m_definition->m_flying) continue;
-		RaycastResult3D baseRaycastVsActor = RaycastVsZCylinder(start, direction, distance, actor->m_position, actor->m_physicsRadius, actor->m_physicsHeight);
-		RaycastResultDoomenstein raycastVsActor(baseRaycastVsActor);
-
-		if (raycastVsActor.m_didImpact) {
-			raycastVsActor.m_impactActor = actor;
-			if (closestImpact.m_didImpact) {
-				if (raycastVsActor.m_impactDist < closestImpact.m_impactDist) {
-					closestImpact = raycastVsActor;
-				}
-			}
-			else {
-				closestImpact = raycastVsActor;
-			}
-		}
+		m_raycastActorCylinders.AddCylinder(actor->m_position, actor->m_physicsRadius, actor->m_physicsHeight);
+		m_raycastActors.push_back(actor);
 	}
+
+	RaycastHit nearestHit = RaycastVsZCylinders3D(start, direction, distance, m_raycastActorCylinders);
+	if (!nearestHit.DidImpact()) return closestImpact;
+
+	Actor* actor = m_raycastActors[nearestHit.m_index];
+	closestImpact.m_didImpact = true;
+	closestImpact.m_impactActor = actor;
+	closestImpact.m_impactDist = nearestHit.m_impactDist;
+	closestImpact.m_impactFraction = nearestHit.m_impactDist / distance;
+	closestImpact.m_impactPos = start + direction * nearestHit.m_impactDist;
+
+	Vec3 dispFromAxis = closestImpact.m_impactPos - actor->m_position;
+	dispFromAxis.z = 0.0f;
+	float capRadius = actor->m_physicsRadius * 0.999f;
+	if (nearestHit.m_impactDist == 0.0f) {
+		closestImpact.m_impactNormal = direction;
+	}
+	else if (dispFromAxis.GetLengthSquared() < capRadius * capRadius) {
+		closestImpact.m_impactNormal = (direction.z < 0.0f) ? Vec3(0.0f, 0.0f, 1.0f) : Vec3(0.0f, 0.0f, -1.0f);
+	}
+	else {
+		closestImpact.m_impactNormal = dispFromAxis.GetNormalized();
+	}
+
 	return closestImpact;
 }
 
@@ -144,6 +144,10 @@ protected:
 	std::vector<Player*> m_playerControllers;
 	std::vector<AI*> m_AIControllers;
 	int m_actorSalt = 0x0000fffe;
+
+	// Scratch for RaycastWorldActors, refilled on every call since actors move between raycasts
+	mutable ZCylinderPacket3D m_raycastActorCylinders;
+	mutable std::vector<Actor*> m_raycastActors;
 	AABB3 m_bounds = AABB3::ZERO_TO_ONE;
 
 	// Rendering
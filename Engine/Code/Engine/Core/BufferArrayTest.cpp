@@ -0,0 +1,291 @@
+#include "Engine/Core/BufferArrayTest.hpp"
+#include "Engine/Core/BufferUtils.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PNCU.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+static char const* GetEndiannessName(BufferEndianness endianness)
+{
+	return (endianness == BufferEndianness::BIGENDIAN) ? "big endian" : "little endian";
+}
+
+// Every 4 bytes get a random float's bits, so float words hold real numbers and integer words arbitrary values
+static void FillWithRandomBytes(void* out_bytes, size_t numBytes, RandomNumberGenerator& rng)
+{
+	unsigned char* bytes = static_cast<unsigned char*>(out_bytes);
+	for (size_t byteIndex = 0; byteIndex < numBytes; byteIndex += 4) {
+		float word = rng.GetRandomFloatInRange(-1000.0f, 1000.0f);
+		memcpy(bytes + byteIndex, &word, (numBytes - byteIndex < 4) ? (numBytes - byteIndex) : 4);
+	}
+}
+
+// Wire formats are spelled out one character per word: 'b' a byte copied as is, 's' 2, 'w' 4 and 'd' 8 byte swapped words.
+// They are written out here rather than read from BufferArrayLayout, so a wrong layout shows up as a mismatch
+static void AppendElementByWords(BufferWriter const& writer, unsigned char const* element, char const* wireFormat)
+{
+	for (char const* word = wireFormat; *word != '\0'; word++) {
+		if (*word == 'b') {
+			writer.AppendeByte(*element);
+			element += 1;
+		}
+		else if (*word == 's') {
+			unsigned short value;
+			memcpy(&value, element, 2);
+			writer.AppendUShort(value);
+			element += 2;
+		}
+		else if (*word == 'w') {
+			unsigned int value;
+			memcpy(&value, element, 4);
+			writer.AppendUint32(value);
+			element += 4;
+		}
+		else {
+			double value;
+			memcpy(&value, element, 8);
+			writer.AppendDouble(value);
+			element += 8;
+		}
+	}
+}
+
+static void ParseElementByWords(BufferParser& parser, unsigned char* out_element, char const* wireFormat)
+{
+	for (char const* word = wireFormat; *word != '\0'; word++) {
+		if (*word == 'b') {
+			*out_element = parser.ParseByte();
+			out_element += 1;
+		}
+		else if (*word == 's') {
+			unsigned short value = parser.ParseUShort();
+			memcpy(out_element, &value, 2);
+			out_element += 2;
+		}
+		else if (*word == 'w') {
+			unsigned int value = parser.ParseUint32();
+			memcpy(out_element, &value, 4);
+			out_element += 4;
+		}
+		else {
+			double value = parser.ParseDouble();
+			memcpy(out_element, &value, 8);
+			out_element += 8;
+		}
+	}
+}
+
+template<typename T_Element>
+static bool CheckArrayRoundTrip(char const* typeName, char const* wireFormat, int numElements, BufferEndianness endianness, RandomNumberGenerator& rng, std::string& out_error)
+{
+	size_t numBytes = (size_t)numElements * sizeof(T_Element);
+	char const* endiannessName = GetEndiannessName(endianness);
+
+	std::vector<T_Element> elements(numElements);
+	FillWithRandomBytes(elements.data(), numBytes, rng);
+
+	// The array and the word by word writes have to put the same bytes on the wire
+	std::vector<unsigned char> arrayBuffer;
+	std::vector<unsigned char> wordBuffer;
+	BufferWriter arrayWriter(arrayBuffer, endianness);
+	BufferWriter wordWriter(wordBuffer, endianness);
+	arrayWriter.AppendArray(elements);
+	for (T_Element const& element : elements) {
+		AppendElementByWords(wordWriter, reinterpret_cast<unsigned char const*>(&element), wireFormat);
+	}
+	if (arrayBuffer != wordBuffer) {
+		out_error = Stringf("AppendArray<%s> in %s does not write the same bytes as appending each word of it", typeName, endiannessName);
+		return false;
+	}
+
+	std::vector<T_Element> parsedElements(numElements);
+	BufferParser arrayParser(arrayBuffer, endianness);
+	if (!arrayParser.ParseArray(parsedElements.data(), numElements) || (arrayParser.GetRemainingSize() != 0) || (memcmp(parsedElements.data(), elements.data(), numBytes) != 0)) {
+		out_error = Stringf("ParseArray<%s> in %s did not read back what AppendArray wrote", typeName, endiannessName);
+		return false;
+	}
+
+	// The vector overload appends after what is already there
+	std::vector<T_Element> appendedElements(1, elements[0]);
+	BufferParser vectorParser(arrayBuffer, endianness);
+	if (!vectorParser.ParseArray(appendedElements, numElements) || (appendedElements.size() != elements.size() + 1) || (memcmp(appendedElements.data() + 1, elements.data(), numBytes) != 0)) {
+		out_error = Stringf("ParseArray<%s> into a vector in %s did not append what AppendArray wrote", typeName, endiannessName);
+		return false;
+	}
+
+	BufferParser wordParser(arrayBuffer, endianness);
+	for (int elementIndex = 0; elementIndex < numElements; elementIndex++) {
+		T_Element parsedElement;
+		ParseElementByWords(wordParser, reinterpret_cast<unsigned char*>(&parsedElement), wireFormat);
+		if (memcmp(&parsedElement, &elements[elementIndex], sizeof(T_Element)) != 0) {
+			out_error = Stringf("Parsing each word of %s %d in %s does not match what AppendArray wrote", typeName, elementIndex, endiannessName);
+			return false;
+		}
+	}
+
+	// ViewArray only hands out elements that need no swapping, and does not move when it refuses
+	BufferParser viewParser(arrayBuffer, endianness);
+	T_Element const* viewedElements = viewParser.ViewArray<T_Element>(numElements);
+	bool canView = (endianness == GetNativeEndianness()) || (strspn(wireFormat, "b") == strlen(wireFormat));
+	if (canView && ((viewedElements == nullptr) || (memcmp(viewedElements, elements.data(), numBytes) != 0))) {
+		out_error = Stringf("ViewArray<%s> in %s did not point at the written elements", typeName, endiannessName);
+		return false;
+	}
+	if (!canView && ((viewedElements != nullptr) || (viewParser.GetRemainingSize() != numBytes))) {
+		out_error = Stringf("ViewArray<%s> in %s handed out elements that need byte swapping", typeName, endiannessName);
+		return false;
+	}
+
+	return true;
+}
+
+static bool CheckArrayRoundTrips(int numElements, BufferEndianness endianness, RandomNumberGenerator& rng, BufferArrayTestResults& results)
+{
+	// Known bytes first, so both sides of the round trip cannot agree on the wrong order
+	std::vector<unsigned char> buffer;
+	BufferWriter writer(buffer, endianness);
+	unsigned int const value = 0x01020304;
+	writer.AppendArray(&value, 1);
+	unsigned char const bigEndianBytes[4] = { 0x01, 0x02, 0x03, 0x04 };
+	unsigned char const littleEndianBytes[4] = { 0x04, 0x03, 0x02, 0x01 };
+	unsigned char const* expectedBytes = (endianness == BufferEndianness::BIGENDIAN) ? bigEndianBytes : littleEndianBytes;
+	if ((buffer.size() != 4) || (memcmp(buffer.data(), expectedBytes, 4) != 0)) {
+		results.m_error = Stringf("AppendArray<unsigned int> in %s wrote its bytes in the wrong order", GetEndiannessName(endianness));
+		return false;
+	}
+
+	bool didPass = CheckArrayRoundTrip<char>("char", "b", numElements, endianness, rng, results.m_error)
+		&& CheckArrayRoundTrip<short>("short", "s", numElements, endianness, rng, results.m_error)
+		&& CheckArrayRoundTrip<int>("int", "w", numElements, endianness, rng, results.m_error)
+		&& CheckArrayRoundTrip<double>("double", "d", numElements, endianness, rng, results.m_error)
+		&& CheckArrayRoundTrip<Rgba8>("Rgba8", "bbbb", numElements, endianness, rng, results.m_error)
+		&& CheckArrayRoundTrip<Vec3>("Vec3", "www", numElements, endianness, rng, results.m_error)
+		&& CheckArrayRoundTrip<Vertex_PCU>("Vertex_PCU", "wwwbbbbww", numElements, endianness, rng, results.m_error)
+		&& CheckArrayRoundTrip<Vertex_PNCU>("Vertex_PNCU", "wwwwwwbbbbww", numElements, endianness, rng, results.m_error)
+		&& CheckArrayRoundTrip<Mat44>("Mat44", "wwwwwwwwwwwwwwww", numElements, endianness, rng, results.m_error);
+	if (didPass) {
+		results.m_numRoundTrips += 9;
+	}
+	return didPass;
+}
+
+static bool CheckParseArrayOutOfBounds(BufferEndianness endianness, BufferArrayTestResults& results)
+{
+	// A partial element past the whole ones, so the size check has to round down
+	std::vector<Vec3> elements(16, Vec3(1.0f, 2.0f, 3.0f));
+	std::vector<unsigned char> buffer;
+	BufferWriter writer(buffer, endianness);
+	writer.AppendArray(elements);
+	writer.AppendeByte(0);
+
+	Vec3 parsedElements[17];
+	for (Vec3& parsedElement : parsedElements) {
+		parsedElement = Vec3(-1.0f, -1.0f, -1.0f);
+	}
+
+	BufferParser parser(buffer, endianness);
+	if (parser.ParseArray(parsedElements, 17)) {
+		results.m_error = "ParseArray read an element that is only partly in the buffer";
+		return false;
+	}
+	for (Vec3 const& parsedElement : parsedElements) {
+		if (parsedElement != Vec3(-1.0f, -1.0f, -1.0f)) {
+			results.m_error = "ParseArray wrote elements out before finding they do not fit";
+			return false;
+		}
+	}
+
+	// A count this big would wrap count * elementSize around to something small, and must not size the vector either
+	std::vector<Vec3> parsedVector(2);
+	if (parser.ParseArray(parsedVector, SIZE_MAX) || (parsedVector.size() != 2)) {
+		results.m_error = "ParseArray into a vector accepted a count that overflows the buffer size";
+		return false;
+	}
+
+	if (parser.GetRemainingSize() != buffer.size()) {
+		results.m_error = "ParseArray moved through the buffer when it failed";
+		return false;
+	}
+
+	// The parser is still usable after refusing
+	if (!parser.ParseArray(parsedElements, 16) || (parser.GetRemainingSize() != 1) || (parsedElements[15] != elements[15])) {
+		results.m_error = "ParseArray could not read the whole elements after refusing to read past the end";
+		return false;
+	}
+	return true;
+}
+
+static double GetMBPerSecond(size_t numBytes, int repeats, double seconds)
+{
+	return (seconds > 0.0) ? ((double)numBytes * (double)repeats / (1024.0 * 1024.0)) / seconds : 0.0;
+}
+
+static void RunBufferArrayBenchmark(BufferArrayTestConfig const& config, BufferEndianness endianness, RandomNumberGenerator& rng, double& out_elementwiseMBPerSecond, double& out_arrayMBPerSecond)
+{
+	int numElements = config.m_numElements;
+	int repeats = config.m_benchmarkRepeats;
+	size_t numBytes = (size_t)numElements * sizeof(Vertex_PNCU);
+
+	std::vector<Vertex_PNCU> verts(numElements);
+	FillWithRandomBytes(verts.data(), numBytes, rng);
+	std::vector<Vertex_PNCU> parsedVerts(numElements);
+	std::vector<unsigned char> buffer;
+	buffer.reserve(numBytes);
+
+	double startTime = GetCurrentTimeSeconds();
+	for (int repeat = 0; repeat < repeats; repeat++) {
+		buffer.clear();
+		BufferWriter writer(buffer, endianness);
+		for (Vertex_PNCU const& vert : verts) {
+			writer.AppendVec3(vert.m_position);
+			writer.AppendVec3(vert.m_normal);
+			writer.AppendRgba(vert.m_color);
+			writer.AppendVec2(vert.m_uvTexCoords);
+		}
+
+		BufferParser parser(buffer, endianness);
+		for (Vertex_PNCU& parsedVert : parsedVerts) {
+			parsedVert.m_position = parser.ParseVec3();
+			parsedVert.m_normal = parser.ParseVec3();
+			parsedVert.m_color = parser.ParseRgba();
+			parsedVert.m_uvTexCoords = parser.ParseVec2();
+		}
+	}
+	out_elementwiseMBPerSecond = GetMBPerSecond(numBytes, repeats, GetCurrentTimeSeconds() - startTime);
+
+	startTime = GetCurrentTimeSeconds();
+	for (int repeat = 0; repeat < repeats; repeat++) {
+		buffer.clear();
+		BufferWriter writer(buffer, endianness);
+		writer.AppendArray(verts);
+
+		BufferParser parser(buffer, endianness);
+		parser.ParseArray(parsedVerts.data(), numElements);
+	}
+	out_arrayMBPerSecond = GetMBPerSecond(numBytes, repeats, GetCurrentTimeSeconds() - startTime);
+}
+
+BufferArrayTestResults RunBufferArrayTest(BufferArrayTestConfig const& config)
+{
+	BufferArrayTestResults results;
+	RandomNumberGenerator rng;
+
+	if (!CheckArrayRoundTrips(config.m_numElements, BufferEndianness::LITTLEENDIAN, rng, results)) return results;
+	if (!CheckArrayRoundTrips(config.m_numElements, BufferEndianness::BIGENDIAN, rng, results)) return results;
+
+	BufferEndianness nativeEndianness = GetNativeEndianness();
+	BufferEndianness swappedEndianness = (nativeEndianness == BufferEndianness::LITTLEENDIAN) ? BufferEndianness::BIGENDIAN : BufferEndianness::LITTLEENDIAN;
+	if (config.m_checkOutOfBounds && !CheckParseArrayOutOfBounds(swappedEndianness, results)) return results;
+
+	RunBufferArrayBenchmark(config, nativeEndianness, rng, results.m_nativeElementwiseMBPerSecond, results.m_nativeArrayMBPerSecond);
+	RunBufferArrayBenchmark(config, swappedEndianness, rng, results.m_swappedElementwiseMBPerSecond, results.m_swappedArrayMBPerSecond);
+	results.m_succeeded = true;
+	return results;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <string>
+
+struct BufferArrayTestConfig {
+	int m_numElements = 10007;
+	int m_benchmarkRepeats = 20;
+	bool m_checkOutOfBounds = true;	// Goes through the parser's recoverable warning, so in the engine this pops its dialogue twice
+};
+
+struct BufferArrayTestResults {
+	bool m_succeeded = false;
+	std::string m_error;
+	int m_numRoundTrips = 0;
+	// Writing and then parsing m_numElements Vertex_PNCUs, in MB of wire data per second
+	double m_nativeElementwiseMBPerSecond = 0.0;
+	double m_nativeArrayMBPerSecond = 0.0;
+	double m_swappedElementwiseMBPerSecond = 0.0;
+	double m_swappedArrayMBPerSecond = 0.0;
+};
+
+// Round trips random arrays of every kind of element layout through BufferWriter::AppendArray and BufferParser::ParseArray
+// and ViewArray, in both little and big endian. The bytes written have to match writing each word with the single value
+// Append functions, and everything has to parse back unchanged. Then checks that ParseArray refuses to read past the end
+// without touching anything, and times the array functions against going element by element
+BufferArrayTestResults RunBufferArrayTest(BufferArrayTestConfig const& config);
@@ -17,6 +17,9 @@
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Core/Vertex_PNCU.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+#include "Game/EngineBuildPreferences.hpp"
+#include <string.h>
 
 BufferEndianness GetNativeEndianness()
 {
@@ -59,6 +62,63 @@ void Flip8Bytes(unsigned char* bytesToFlip) {
 
 }
 
+void Flip4ByteWords(unsigned char* words, size_t numWords)
+{
+	size_t wordIndex = 0;
+#if !defined(ENGINE_DISABLE_SIMD)
+	for (; wordIndex + 4 <= numWords; wordIndex += 4) {
+		__m128i* wordsToFlip = reinterpret_cast<__m128i*>(words + wordIndex * 4);
+		__m128i value = _mm_loadu_si128(wordsToFlip);
+		// Swap the bytes inside each 16 bit half, then the halves themselves
+		value = _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+		value = _mm_shufflelo_epi16(value, SIMD_SHUFFLE_MASK(1, 0, 3, 2));
+		value = _mm_shufflehi_epi16(value, SIMD_SHUFFLE_MASK(1, 0, 3, 2));
+		_mm_storeu_si128(wordsToFlip, value);
+	}
+#endif
+	for (; wordIndex < numWords; wordIndex++) {
+		Flip4Bytes(words + wordIndex * 4);
+	}
+}
+
+void FlipArrayBytes(unsigned char* elements, size_t count, size_t elementSize, size_t swapSize, unsigned int swapMask)
+{
+	if (swapSize == 0) return;
+
+	size_t wordsPerElement = elementSize / swapSize;
+	unsigned int allWordsMask = (wordsPerElement >= 32) ? 0xFFFFFFFF : ((1u << wordsPerElement) - 1);
+
+	if (swapSize == 4) {
+		// Flip every word, then flip back the few that are raw bytes
+		Flip4ByteWords(elements, count * wordsPerElement);
+		if ((swapMask & allWordsMask) == allWordsMask) return;
+
+		for (size_t elementIndex = 0; elementIndex < count; elementIndex++) {
+			unsigned char* element = elements + elementIndex * elementSize;
+			for (size_t wordIndex = 0; wordIndex < wordsPerElement; wordIndex++) {
+				if ((swapMask & (1u << wordIndex)) == 0) {
+					Flip4Bytes(element + wordIndex * 4);
+				}
+			}
+		}
+		return;
+	}
+
+	for (size_t elementIndex = 0; elementIndex < count; elementIndex++) {
+		unsigned char* element = elements + elementIndex * elementSize;
+		for (size_t wordIndex = 0; wordIndex < wordsPerElement; wordIndex++) {
+			if ((swapMask & (1u << wordIndex)) == 0) continue;
+
+			if (swapSize == 2) {
+				Flip2Bytes(element + wordIndex * 2);
+			}
+			else if (swapSize == 8) {
+				Flip8Bytes(element + wordIndex * 8);
+			}
+		}
+	}
+}
+
 BufferParser::BufferParser(std::vector<unsigned char> const& buffer, BufferEndianness endianness) :
 	m_data(buffer.data()),
 	m_size(buffer.size())
@@ -333,62 +393,51 @@ IntVec3 BufferParser::ParseIntVec3()
 
 Vec2 BufferParser::ParseVec2()
 {
-	float x = ParseFloat();
-	float y = ParseFloat();
-
-	return Vec2(x, y);
+	Vec2 vec2;
+	ParseArray(&vec2, 1);
+	return vec2;
 }
 
 Vec3 BufferParser::ParseVec3()
 {
-	float x = ParseFloat();
-	float y = ParseFloat();
-	float z = ParseFloat();
-
-	return Vec3(x, y, z);
+	Vec3 vec3;
+	ParseArray(&vec3, 1);
+	return vec3;
 }
 
 Vec4 BufferParser::ParseVec4()
 {
-	float x = ParseFloat();
-	float y = ParseFloat();
-	float z = ParseFloat();
-	float w = ParseFloat();
-
-	return Vec4(x, y, z, w);
+	Vec4 vec4;
+	ParseArray(&vec4, 1);
+	return vec4;
 }
 
 Vertex_PCU BufferParser::ParseVertexPCU()
 {
-	Vec3 position = ParseVec3();
-	Rgba8 color = ParseRgba();
-	Vec2 uv = ParseVec2();
-
-	return Vertex_PCU(position, color, uv);
+	Vertex_PCU vertex;
+	ParseArray(&vertex, 1);
+	return vertex;
 }
 
 Vertex_PNCU BufferParser::ParseVertexPNCU()
 {
-	Vec3 position = ParseVec3();
-	Vec3 normals = ParseVec3();
-	Rgba8 color = ParseRgba();
-	Vec2 uv = ParseVec2();
-
-	return Vertex_PNCU(position, normals, color, uv);
+	Vertex_PNCU vertex;
+	ParseArray(&vertex, 1);
+	return vertex;
 }
 
 AABB2 BufferParser::ParseAABB2()
 {
-	Vec2 mins = ParseVec2();
-	Vec2 maxs = ParseVec2();
-	return AABB2(mins, maxs);
+	AABB2 bounds;
+	ParseArray(&bounds, 1);
+	return bounds;
 }
 
 AABB3 BufferParser::ParseAABB3()
 {
-	Vec3 mins = ParseVec3();
-	Vec3 maxs = ParseVec3();
-	return AABB3(mins, maxs);
+	AABB3 bounds;
+	ParseArray(&bounds, 1);
+	return bounds;
 }
 
 OBB2 BufferParser::ParseOBB2()
@@ -444,12 +493,51 @@ IntRange BufferParser::ParseIntRange()
 Mat44 BufferParser::ParseMat44()
 {
 	Mat44 newMat;
-	for (int floatInd = 0; floatInd < 16; floatInd++) {
-		newMat.m_values[floatInd] = ParseFloat();
-	}
+	ParseArray(&newMat, 1);
 	return newMat;
 }
 
+// Divides instead of multiplying, a count read from a corrupt buffer could overflow count * elementSize
+bool BufferParser::CheckArrayBounds(size_t count, size_t elementSize) const
+{
+	if (count > (GetRemainingSize() / elementSize)) {
+		ERROR_RECOVERABLE("TRYING TO PARSE BEYOND BUFFER END");
+		return false;
+	}
+	return true;
+}
+
+bool BufferParser::ParseArrayBytes(void* out_elements, size_t count, size_t elementSize, size_t swapSize, unsigned int swapMask)
+{
+	if (!CheckArrayBounds(count, elementSize)) return false;
+
+	size_t totalSize = count * elementSize;
+	if (totalSize == 0) return true;
+
+	memcpy(out_elements, m_data + m_currentPosition, totalSize);
+	m_currentPosition += totalSize;
+
+	if (m_shouldFlipBytes) {
+		FlipArrayBytes((unsigned char*)out_elements, count, elementSize, swapSize, swapMask);
+	}
+
+	return true;
+}
+
+void const* BufferParser::ViewArrayBytes(size_t count, size_t elementSize, size_t swapSize, size_t alignment)
+{
+	if (m_shouldFlipBytes && (swapSize > 0)) return nullptr;
+
+	if (count > (GetRemainingSize() / elementSize)) return nullptr;
+	size_t totalSize = count * elementSize;
+
+	unsigned char const* elements = m_data + m_currentPosition;
+	if ((reinterpret_cast<uintptr_t>(elements) % alignment) != 0) return nullptr;
+
+	m_currentPosition += totalSize;
+	return elements;
+}
+
 size_t BufferParser::GetTotalSize() const
 {
 	return m_size;
@@ -499,6 +587,16 @@ void BufferWriter::OverwriteUint32(unsigned int startingPosition, unsigned int n
 
 }
 
+void BufferWriter::Reserve(size_t additionalBytes) const
+{
+	size_t requiredCapacity = m_buffer->size() + additionalBytes;
+	size_t currentCapacity = m_buffer->capacity();
+	if (requiredCapacity <= currentCapacity) return;
+
+	size_t doubledCapacity = currentCapacity * 2;
+	m_buffer->reserve((doubledCapacity > requiredCapacity) ? doubledCapacity : requiredCapacity);
+}
+
 void BufferWriter::SetEndianness(BufferEndianness newEndianness)
 {
 	m_endianness = newEndianness;
@@ -576,6 +674,23 @@ void BufferWriter::AppendFloat(float floatToadd) const
 	Append4Bytes(asArray);
 }
 
+void BufferWriter::AppendArrayBytes(void const* elements, size_t count, size_t elementSize, size_t swapSize, unsigned int swapMask) const
+{
+	size_t totalSize = count * elementSize;
+	if (totalSize == 0) return;
+
+	Reserve(totalSize);
+	size_t writeStart = m_buffer->size();
+	m_buffer->resize(writeStart + totalSize);
+
+	unsigned char* writePos = m_buffer->data() + writeStart;
+	memcpy(writePos, elements, totalSize);
+
+	if (m_shouldFlipBytes) {
+		FlipArrayBytes(writePos, count, elementSize, swapSize, swapMask);
+	}
+}
+
 void BufferWriter::Append4Bytes(unsigned char* bytesToAdd) const
 {
 	if (m_shouldFlipBytes) {
@@ -627,51 +742,37 @@ void BufferWriter::AppendIntVec3(IntVec3 const& intVec3ToAdd) const
 
 void BufferWriter::AppendVec2(Vec2 const& vec2ToAdd) const
 {
-	AppendFloat(vec2ToAdd.x);
-	AppendFloat(vec2ToAdd.y);
+	AppendArray(&vec2ToAdd, 1);
 }
 
 void BufferWriter::AppendVec3(Vec3 const& vec3ToAdd) const
 {
-	AppendFloat(vec3ToAdd.x);
-	AppendFloat(vec3ToAdd.y);
-	AppendFloat(vec3ToAdd.z);
+	AppendArray(&vec3ToAdd, 1);
 }
 
 void BufferWriter::AppendVec4(Vec4 const& vec4ToAdd) const
 {
-	AppendFloat(vec4ToAdd.x);
-	AppendFloat(vec4ToAdd.y);
-	AppendFloat(vec4ToAdd.z);
-	AppendFloat(vec4ToAdd.w);
+	AppendArray(&vec4ToAdd, 1);
 }
 
 void BufferWriter::AppendVertexPCU(Vertex_PCU const& vertexToAdd) const
 {
-	AppendVec3(vertexToAdd.m_position);
-	AppendRgba(vertexToAdd.m_color);
-	AppendVec2(vertexToAdd.m_uvTexCoords);
+	AppendArray(&vertexToAdd, 1);
 }
 
 void BufferWriter::AppendVertexPNCU(Vertex_PNCU const& vertexToAdd) const
 {
-	AppendVec3(vertexToAdd.m_position);
-	AppendVec3(vertexToAdd.m_normal);
-	AppendRgba(vertexToAdd.m_color);
-	AppendVec2(vertexToAdd.m_uvTexCoords);
-
+	AppendArray(&vertexToAdd, 1);
 }
 
 void BufferWriter::AppendAABB2(AABB2 const& aabb2ToAdd) const
 {
-	AppendVec2(aabb2ToAdd.m_mins);
-	AppendVec2(aabb2ToAdd.m_maxs);
+	AppendArray(&aabb2ToAdd, 1);
 }
 
 void BufferWriter::AppendAABB3(AABB3 const& aabb3ToAdd) const
 {
-	AppendVec3(aabb3ToAdd.m_mins);
-	AppendVec3(aabb3ToAdd.m_maxs);
+	AppendArray(&aabb3ToAdd, 1);
 }
 
 void BufferWriter::AppendOBB2(OBB2 const& obb2ToAdd) const
@@ -713,8 +814,6 @@ void BufferWriter::AppendIntRange(IntRange const& intRangeToAdd) const
 
 void BufferWriter::AppendMat44(Mat44 const& matToAdd) const
 {
-	for (int floatInd = 0; floatInd < 16; floatInd++) {
-		AppendFloat(matToAdd.m_values[floatInd]);
-	}
+	AppendArray(&matToAdd, 1);
 }
 
@@ -25,6 +25,46 @@ struct FloatRange;
 struct IntRange;
 struct OBB2;
 struct Mat44;
+struct AABB2TreeNode;
+
+// Wire layout of the types ParseArray/AppendArray move in bulk. Their in-memory layout has to match the wire format:
+// SIZE bytes per element, made of words of SWAP_SIZE bytes where bit i of SWAP_MASK says whether word i gets byte
+// swapped. Unmasked words (Rgba8 channels) are copied as they are
+template<typename T_Element>
+struct BufferArrayLayout;
+
+#define BUFFER_ARRAY_LAYOUT(elementType, elementSize, swapSize, swapMask) \
+	template<> struct BufferArrayLayout<elementType> { \
+		static constexpr size_t SIZE = elementSize; \
+		static constexpr size_t SWAP_SIZE = swapSize; \
+		static constexpr unsigned int SWAP_MASK = swapMask; \
+	};
+
+BUFFER_ARRAY_LAYOUT(char, 1, 0, 0)
+BUFFER_ARRAY_LAYOUT(unsigned char, 1, 0, 0)
+BUFFER_ARRAY_LAYOUT(short, 2, 2, 0b1)
+BUFFER_ARRAY_LAYOUT(unsigned short, 2, 2, 0b1)
+BUFFER_ARRAY_LAYOUT(int, 4, 4, 0b1)
+BUFFER_ARRAY_LAYOUT(unsigned int, 4, 4, 0b1)
+BUFFER_ARRAY_LAYOUT(float, 4, 4, 0b1)
+BUFFER_ARRAY_LAYOUT(double, 8, 8, 0b1)
+BUFFER_ARRAY_LAYOUT(Rgba8, 4, 0, 0)
+BUFFER_ARRAY_LAYOUT(IntVec2, 8, 4, 0b11)
+BUFFER_ARRAY_LAYOUT(IntVec3, 12, 4, 0b111)
+BUFFER_ARRAY_LAYOUT(Vec2, 8, 4, 0b11)
+BUFFER_ARRAY_LAYOUT(Vec3, 12, 4, 0b111)
+BUFFER_ARRAY_LAYOUT(Vec4, 16, 4, 0b1111)
+BUFFER_ARRAY_LAYOUT(Vertex_PCU, 24, 4, 0b110111)
+BUFFER_ARRAY_LAYOUT(Vertex_PNCU, 36, 4, 0b110111111)
+BUFFER_ARRAY_LAYOUT(AABB2, 16, 4, 0b1111)
+BUFFER_ARRAY_LAYOUT(AABB3, 24, 4, 0b111111)
+BUFFER_ARRAY_LAYOUT(Plane2D, 12, 4, 0b111)
+BUFFER_ARRAY_LAYOUT(Plane3D, 16, 4, 0b1111)
+BUFFER_ARRAY_LAYOUT(EulerAngles, 12, 4, 0b111)
+BUFFER_ARRAY_LAYOUT(FloatRange, 8, 4, 0b11)
+BUFFER_ARRAY_LAYOUT(IntRange, 8, 4, 0b11)
+BUFFER_ARRAY_LAYOUT(Mat44, 64, 4, 0xFFFF)
+BUFFER_ARRAY_LAYOUT(AABB2TreeNode, 36, 4, 0b111111111)
 
 BufferEndianness GetNativeEndianness();
 class BufferParser {
@@ -63,11 +103,26 @@ public:
 	IntRange ParseIntRange();
 	Mat44 ParseMat44();
 
+	// Bounds checked once for the whole array, then copied straight out of the buffer and byte swapped in bulk if needed.
+	// On failure nothing is read and the elements are left untouched. The vector overload appends to the vector
+	template<typename T_Element>
+	bool ParseArray(T_Element* out_elements, size_t count);
+	template<typename T_Element>
+	bool ParseArray(std::vector<T_Element>& out_elements, size_t count);
+	// Zero-copy alternative: points at the elements inside the buffer and skips past them. Returns nullptr, without
+	// moving, when they would need byte swapping, are misaligned or do not fit; ParseArray then copies them instead
+	template<typename T_Element>
+	T_Element const* ViewArray(size_t count);
+
 	size_t GetTotalSize() const;
 	size_t GetRemainingSize() const;
 	BufferEndianness GetEndianness() const { return m_endianness; }
 	void SetEndianness(BufferEndianness newEndianness);
 private:
+	bool CheckArrayBounds(size_t count, size_t elementSize) const;
+	bool ParseArrayBytes(void* out_elements, size_t count, size_t elementSize, size_t swapSize, unsigned int swapMask);
+	void const* ViewArrayBytes(size_t count, size_t elementSize, size_t swapSize, size_t alignment);
+
 	bool m_shouldFlipBytes = false;
 	unsigned char const* m_data;
 	size_t m_size = 0;
@@ -83,6 +138,8 @@ public:
 	BufferWriter(std::vector<unsigned char>* buffer, BufferEndianness endianness = BufferEndianness::DEFAULT);
 
 	void OverwriteUint32(unsigned int startingPosition, unsigned int newInt32) const;
+	// Makes room for at least additionalBytes more, at least doubling the capacity so repeated calls stay amortized
+	void Reserve(size_t additionalBytes) const;
 	void SetEndianness(BufferEndianness newEndianness);
 	BufferEndianness GetEndianness() const { return m_endianness; }
 
@@ -114,10 +171,60 @@ public:
 	void AppendFloatRange(FloatRange const& floatRangeToAdd) const;
 	void AppendIntRange(IntRange const& intRangeToAdd) const;
 	void AppendMat44(Mat44 const& matToAdd) const;
+
+	// One resize and copy for the whole array, byte swapped in place afterwards if needed
+	template<typename T_Element>
+	void AppendArray(T_Element const* elements, size_t count) const;
+	template<typename T_Element>
+	void AppendArray(std::vector<T_Element> const& elements) const;
 private:
 	void Append4Bytes(unsigned char* bytesToAdd) const;
+	void AppendArrayBytes(void const* elements, size_t count, size_t elementSize, size_t swapSize, unsigned int swapMask) const;
 
 	std::vector<unsigned char>* m_buffer;
 	bool m_shouldFlipBytes = false;
 	BufferEndianness m_endianness = BufferEndianness::DEFAULT;
 };
+
+
+template<typename T_Element>
+bool BufferParser::ParseArray(T_Element* out_elements, size_t count)
+{
+	static_assert(sizeof(T_Element) == BufferArrayLayout<T_Element>::SIZE, "ELEMENT MEMORY LAYOUT DOES NOT MATCH ITS WIRE LAYOUT");
+	return ParseArrayBytes(out_elements, count, BufferArrayLayout<T_Element>::SIZE, BufferArrayLayout<T_Element>::SWAP_SIZE, BufferArrayLayout<T_Element>::SWAP_MASK);
+}
+
+template<typename T_Element>
+bool BufferParser::ParseArray(std::vector<T_Element>& out_elements, size_t count)
+{
+	// Bounds first: count usually comes from the buffer itself and must not size the vector before it is checked
+	if (!CheckArrayBounds(count, BufferArrayLayout<T_Element>::SIZE)) return false;
+
+	size_t firstElement = out_elements.size();
+	out_elements.resize(firstElement + count);
+	bool didParse = ParseArray(out_elements.data() + firstElement, count);
+	if (!didParse) {
+		out_elements.resize(firstElement);
+	}
+	return didParse;
+}
+
+template<typename T_Element>
+T_Element const* BufferParser::ViewArray(size_t count)
+{
+	static_assert(sizeof(T_Element) == BufferArrayLayout<T_Element>::SIZE, "ELEMENT MEMORY LAYOUT DOES NOT MATCH ITS WIRE LAYOUT");
+	return static_cast<T_Element const*>(ViewArrayBytes(count, BufferArrayLayout<T_Element>::SIZE, BufferArrayLayout<T_Element>::SWAP_SIZE, alignof(T_Element)));
+}
+
+template<typename T_Element>
+void BufferWriter::AppendArray(T_Element const* elements, size_t count) const
+{
+	static_assert(sizeof(T_Element) == BufferArrayLayout<T_Element>::SIZE, "ELEMENT MEMORY LAYOUT DOES NOT MATCH ITS WIRE LAYOUT");
+	AppendArrayBytes(elements, count, BufferArrayLayout<T_Element>::SIZE, BufferArrayLayout<T_Element>::SWAP_SIZE, BufferArrayLayout<T_Element>::SWAP_MASK);
+}
+
+template<typename T_Element>
+void BufferWriter::AppendArray(std::vector<T_Element> const& elements) const
+{
+	AppendArray(elements.data(), elements.size());
+}
@@ -5,6 +5,9 @@
 #include "Engine/Network/RemoteConsole.hpp"
 #include "Engine/Core/XmlUtils.hpp"
 #include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/SIMDTransformTest.hpp"
+#include "Engine/Core/BufferArrayTest.hpp"
+#include <cstring>
 #include <filesystem>
 #include "Game//EngineBuildPreferences.hpp"
 
@@ -25,6 +28,8 @@ DevConsole::DevConsole(DevConsoleConfig const& config) :
 	SubscribeEventCallbackFunction("Clear", Command_Clear);
 	SubscribeEventCallbackFunction("Help", Command_Help);
 	SubscribeEventCallbackFunction("PasteText", Command_Paste_Text);
+	SubscribeEventCallbackFunction("SIMDTransformTest", Command_SIMDTransformTest);
+	SubscribeEventCallbackFunction("BufferArrayTest", Command_BufferArrayTest);
 	SubscribeEventCallbackFunction("ExecuteXMLFile", this, &DevConsole::EventExecuteXMLFile);
 	m_caretStopwatch.Start(&m_clock, 0.5f);
 	m_commandHistory.resize(m_maxCommandHistory);
@@ -42,17 +47,19 @@ DevConsole::~DevConsole()
 
 void DevConsole::Startup()
 {
-	
-	m_linesMutex.lock();
+	if (m_config.m_maxLinesKept < 1) m_config.m_maxLinesKept = 1;
 	m_lines.clear();
-	m_lines.reserve(600);
-	m_linesMutex.unlock();
+	m_lines.resize(m_config.m_maxLinesKept);
+	m_newestLineIndex = -1;
+	m_numLines = 0;
+	m_areTextVertsValid = false;
 
 	AddLine(INFO_MINOR_COLOR, "Type help for a list of commands");
 
 #if defined(ENGINE_USE_NETWORK)
 	RemoteConsoleConfig remoteConfig;
 	remoteConfig.m_console = this;
+	remoteConfig.m_useCommandThread = m_config.m_useRemoteCommandThread;
 
 	m_remoteConsole = new RemoteConsole(remoteConfig);
 	m_remoteConsole->Startup();
@@ -72,6 +79,8 @@ void DevConsole::BeginFrame()
 	if (changeVisibility) {
 		m_caretVisible = !m_caretVisible;
 	}
+
+	ConsumeLoggedLines();
 }
 
 void DevConsole::EndFrame()
@@ -89,27 +98,9 @@ bool DevConsole::Execute(std::string const& consoleCommandText)
 	for (int commandIndex = 0; commandIndex < multipleCommands.size(); commandIndex++) {
 		std::string const& commandString = multipleCommands[commandIndex];
 		if (commandString.empty() || IsStringAllWhitespace(commandString)) continue;
-		Strings nameArgumentPairs = ProcessCommandLine(commandString);
-
-		std::string commandName = TrimStringCopy(nameArgumentPairs[0]);
-
-
 		EventArgs commandArgs;
 		AddLine(INFO_MINOR_COLOR, consoleCommandText);
-		for (int argsIndex = 1; argsIndex < nameArgumentPairs.size(); argsIndex += 2) {
-			int nextArg = argsIndex + 1;
-
-			std::string argName = TrimStringCopy(nameArgumentPairs[argsIndex]);
-			std::string argValue = "";
-			if (nextArg < nameArgumentPairs.size()) {
-				argValue = TrimStringCopy(nameArgumentPairs[nextArg]);
-				commandArgs.SetValue(argName, argValue);
-			}
-			else {
-				AddLine(DevConsole::WARNING_COLOR, Stringf("Malformed argument: %s", argName.c_str()));
-			}
-
-		}
+		std::string commandName = ParseCommand(commandString, commandArgs);
 
 		bool wasEventFired = g_theEventSystem->FireEvent(commandName, commandArgs);
 
@@ -127,6 +118,46 @@ bool DevConsole::Execute(std::string const& consoleCommandText)
 	return true;
 }
 
+bool DevConsole::ExecuteFromThread(std::string const& consoleCommandText)
+{
+	if (consoleCommandText.empty()) return false;
+	Strings multipleCommands = SplitStringOnDelimiter(consoleCommandText, '\n');
+	for (int commandIndex = 0; commandIndex < multipleCommands.size(); commandIndex++) {
+		std::string const& commandString = multipleCommands[commandIndex];
+		if (commandString.empty() || IsStringAllWhitespace(commandString)) continue;
+
+		EventArgs commandArgs;
+		std::string commandName = ParseCommand(commandString, commandArgs);
+		if (!g_theEventSystem->FireEvent(commandName, commandArgs)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+std::string DevConsole::ParseCommand(std::string const& commandString, EventArgs& out_commandArgs)
+{
+	Strings nameArgumentPairs = ProcessCommandLine(commandString);
+
+	for (int argsIndex = 1; argsIndex < nameArgumentPairs.size(); argsIndex += 2) {
+		int nextArg = argsIndex + 1;
+
+		std::string argName = TrimStringCopy(nameArgumentPairs[argsIndex]);
+		std::string argValue = "";
+		if (nextArg < nameArgumentPairs.size()) {
+			argValue = TrimStringCopy(nameArgumentPairs[nextArg]);
+			out_commandArgs.SetValue(argName, argValue);
+		}
+		else {
+			AddLine(DevConsole::WARNING_COLOR, Stringf("Malformed argument: %s", argName.c_str()));
+		}
+
+	}
+
+	return TrimStringCopy(nameArgumentPairs[0]);
+}
+
 bool DevConsole::EventExecuteXMLFile(EventArgs& args)
 {
 	std::string fileName = args.GetValue("filename", "unnamed");
@@ -178,9 +209,35 @@ bool DevConsole::ExecuteXmlCommandScriptFile(std::filesystem::path const& filePa
 
 void DevConsole::AddLine(Rgba8 const& color, std::string const& text)
 {
-	m_linesMutex.lock();
-	m_lines.emplace_back(color, text, m_frameNumber);
-	m_linesMutex.unlock();
+	m_logRing.PushLine(color, text.data(), text.size(), m_frameNumber.load(std::memory_order_relaxed));
+}
+
+void DevConsole::ConsumeLoggedLines() const
+{
+	if (m_lines.empty()) return; // Not started yet, lines wait in the ring
+
+	int maxLines = (int)m_lines.size();
+	for (;;) {
+		int nextLineIndex = (m_newestLineIndex + 1) % maxLines;
+		if (!m_logRing.PopLine(m_lines[nextLineIndex])) break;
+
+		m_newestLineIndex = nextLineIndex;
+		if (m_numLines < maxLines) m_numLines++;
+		m_numLinesConsumed++;
+	}
+
+	uint32_t numDroppedLines = m_logRing.GetNumDroppedLines();
+	if (numDroppedLines != m_numDroppedLinesReported) {
+		m_newestLineIndex = (m_newestLineIndex + 1) % maxLines;
+		DevConsoleLine& warningLine = m_lines[m_newestLineIndex];
+		warningLine.m_color = WARNING_COLOR;
+		warningLine.m_text = Stringf("%u log lines dropped, the console log ring was full", numDroppedLines - m_numDroppedLinesReported);
+		warningLine.m_frameNumber = m_frameNumber.load(std::memory_order_relaxed);
+		warningLine.m_layoutCellHeight = 0.0f;
+		if (m_numLines < maxLines) m_numLines++;
+		m_numLinesConsumed++;
+		m_numDroppedLinesReported = numDroppedLines;
+	}
 }
 
 void DevConsole::Render(AABB2 const& bounds, Renderer* rendererOverride) const
@@ -240,9 +297,9 @@ void DevConsole::SetRenderer(Renderer* newRenderer)
 
 void DevConsole::Clear()
 {
-	m_linesMutex.lock();
-	m_lines.clear();
-	m_linesMutex.unlock();
+	ConsumeLoggedLines();
+	m_numLines = 0;
+	m_areTextVertsValid = false;
 }
 
 void DevConsole::Render_OpenFull(AABB2 const& bounds, Renderer& renderer, BitmapFont& font, float fontAspect) const
@@ -263,26 +320,29 @@ void DevConsole::Render_OpenFull(AABB2 const& bounds, Renderer& renderer, Bitmap
 	AddVertsForAABB2D(blackOverlayVerts, bounds, Rgba8::TRANSPARENT_BLACK);
 	AddVertsForAABB2D(whiteInputOverlayVerts, inputBounds, Rgba8::TRANSPARENT_WHITE);
 
-	std::vector<Vertex_PCU> textVerts;
-	textVerts.reserve(m_lines.size() * 40);
-
-	int roundedUpMaxLinesShown = RoundDownToInt(m_config.m_maxLinesShown) + 2;
-	float lineWidth = 0;
+	ConsumeLoggedLines();
 
-	m_linesMutex.lock();
-	for (int lineIndex = (int)m_lines.size() - 1; lineIndex >= 0; lineIndex-- && roundedUpMaxLinesShown >= 0, roundedUpMaxLinesShown--) {
-		DevConsoleLine const& line = m_lines[lineIndex];
-		lineWidth = font.GetTextWidth(cellHeight, line.m_text);
+	bool isLayoutUnchanged = m_areTextVertsValid && (m_textVertsLinesConsumed == m_numLinesConsumed) && (m_textVertsAspect == fontAspect) &&
+		(m_textVertsBounds.m_mins == bounds.m_mins) && (m_textVertsBounds.m_maxs == bounds.m_maxs);
 
-		AABB2 lineAABB2(Vec2::ZERO, Vec2(lineWidth, cellHeight));
-		bounds.AlignABB2WithinBounds(lineAABB2, Vec2(0.0f, 1.0f));
+	if (!isLayoutUnchanged) {
+		// Visible lines keep their glyph verts from earlier frames, only lines that just scrolled in are laid out
+		m_textVerts.clear();
+		int maxLines = (int)m_lines.size();
+		int numLinesShown = RoundDownToInt(m_config.m_maxLinesShown) + 2;
+		if (numLinesShown > m_numLines) numLinesShown = m_numLines;
 
-		lineAABB2.m_mins.y = minGroupTextHeight + (((int)m_lines.size() - 1 - lineIndex) * cellHeight);
+		for (int rowIndex = 0; rowIndex < numLinesShown; rowIndex++) {
+			int lineIndex = (m_newestLineIndex - rowIndex + maxLines) % maxLines;
+			Vec2 lineMins(bounds.m_mins.x, minGroupTextHeight + ((float)rowIndex * cellHeight));
+			AddTextVertsForLine(m_lines[lineIndex], font, fontAspect, cellHeight, lineMins);
+		}
 
-		font.AddVertsForTextInBox2D(textVerts, lineAABB2, cellHeight, line.m_text, line.m_color, fontAspect, Vec2::ZERO, TextBoxMode::OVERRUN);
+		m_textVertsLinesConsumed = m_numLinesConsumed;
+		m_textVertsAspect = fontAspect;
+		m_textVertsBounds = bounds;
+		m_areTextVertsValid = true;
 	}
-
-	m_linesMutex.unlock();
 	//#TODO DX12 FIXTHIS
 
 	renderer.BindTexture(nullptr);
@@ -293,7 +353,7 @@ void DevConsole::Render_OpenFull(AABB2 const& bounds, Renderer& renderer, Bitmap
 	Render_InputCaret(renderer, font, fontAspect, cellHeight);
 
 	renderer.BindTexture(&font.GetTexture());
-	renderer.DrawVertexArray(textVerts);
+	renderer.DrawVertexArray(m_textVerts);
 
 	Render_UserInput(renderer, font, fontAspect, cellHeight);
 
@@ -302,6 +362,25 @@ void DevConsole::Render_OpenFull(AABB2 const& bounds, Renderer& renderer, Bitmap
 #endif
 }
 
+void DevConsole::AddTextVertsForLine(DevConsoleLine& line, BitmapFont& font, float fontAspect, float cellHeight, Vec2 const& lineMins) const
+{
+	if (line.m_layoutCellHeight != cellHeight || line.m_layoutAspect != fontAspect) {
+		line.m_verts.clear();
+		float lineWidth = font.GetTextWidth(cellHeight, line.m_text, fontAspect);
+		AABB2 lineAABB2(Vec2::ZERO, Vec2(lineWidth, cellHeight));
+		font.AddVertsForTextInBox2D(line.m_verts, lineAABB2, cellHeight, line.m_text, line.m_color, fontAspect, Vec2::ZERO, TextBoxMode::OVERRUN);
+		line.m_layoutCellHeight = cellHeight;
+		line.m_layoutAspect = fontAspect;
+	}
+
+	Vec3 lineOffset(lineMins.x, lineMins.y, 0.0f);
+	for (int vertIndex = 0; vertIndex < (int)line.m_verts.size(); vertIndex++) {
+		Vertex_PCU vert = line.m_verts[vertIndex];
+		vert.m_position += lineOffset;
+		m_textVerts.push_back(vert);
+	}
+}
+
 void DevConsole::Render_InputCaret(Renderer& renderer, BitmapFont& font, float fontAspect, float cellHeight) const
 {
 	std::string strAtCaretPos = m_inputText.substr(0, m_caretPosition);
@@ -425,6 +504,80 @@ DevConsoleLine::DevConsoleLine(Rgba8 const& color, std::string const& text, int
 {
 }
 
+DevConsoleLogRing::DevConsoleLogRing()
+{
+	m_slots = new DevConsoleLogSlot[DEVCONSOLE_LOG_RING_LINES];
+	m_arena = new char[DEVCONSOLE_LOG_ARENA_SIZE];
+}
+
+DevConsoleLogRing::~DevConsoleLogRing()
+{
+	delete[] m_slots;
+	m_slots = nullptr;
+	delete[] m_arena;
+	m_arena = nullptr;
+}
+
+bool DevConsoleLogRing::PushLine(Rgba8 const& color, char const* text, size_t textLength, int frameNumber)
+{
+	uint32_t length = (textLength > DEVCONSOLE_MAX_LINE_LENGTH) ? DEVCONSOLE_MAX_LINE_LENGTH : (uint32_t)textLength;
+
+	// Claim the slot and the arena range together, so the consumer can release both in line order
+	uint64_t reserved = m_reserved.load(std::memory_order_relaxed);
+	uint32_t linePosition = 0;
+	uint32_t textStart = 0;
+	for (;;) {
+		linePosition = (uint32_t)(reserved >> 32);
+		uint32_t arenaPosition = (uint32_t)reserved;
+
+		// Text never wraps around the arena; the tail end is skipped instead
+		uint32_t arenaIndex = arenaPosition & (DEVCONSOLE_LOG_ARENA_SIZE - 1);
+		uint32_t padding = (arenaIndex + length > DEVCONSOLE_LOG_ARENA_SIZE) ? DEVCONSOLE_LOG_ARENA_SIZE - arenaIndex : 0;
+		textStart = arenaPosition + padding;
+		uint32_t newArenaPosition = textStart + length;
+
+		bool isRingFull = (linePosition + 1 - m_releasedLines.load(std::memory_order_acquire)) > DEVCONSOLE_LOG_RING_LINES;
+		bool isArenaFull = (newArenaPosition - m_releasedArena.load(std::memory_order_acquire)) > DEVCONSOLE_LOG_ARENA_SIZE;
+		if (isRingFull || isArenaFull) {
+			m_numDroppedLines.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		uint64_t newReserved = ((uint64_t)(linePosition + 1) << 32) | newArenaPosition;
+		if (m_reserved.compare_exchange_weak(reserved, newReserved, std::memory_order_relaxed)) break;
+	}
+
+	if (length > 0) {
+		memcpy(&m_arena[textStart & (DEVCONSOLE_LOG_ARENA_SIZE - 1)], text, length);
+	}
+
+	DevConsoleLogSlot& slot = m_slots[linePosition & (DEVCONSOLE_LOG_RING_LINES - 1)];
+	slot.m_color = color;
+	slot.m_frameNumber = frameNumber;
+	slot.m_textStart = textStart;
+	slot.m_textLength = length;
+	slot.m_sequence.store(linePosition + 1, std::memory_order_release);
+	return true;
+}
+
+bool DevConsoleLogRing::PopLine(DevConsoleLine& out_line)
+{
+	uint32_t linePosition = m_releasedLines.load(std::memory_order_relaxed);
+	DevConsoleLogSlot& slot = m_slots[linePosition & (DEVCONSOLE_LOG_RING_LINES - 1)];
+
+	// Lines are consumed in order, so a producer still writing holds back the lines claimed after it
+	if (slot.m_sequence.load(std::memory_order_acquire) != linePosition + 1) return false;
+
+	out_line.m_color = slot.m_color;
+	out_line.m_frameNumber = slot.m_frameNumber;
+	out_line.m_text.assign(&m_arena[slot.m_textStart & (DEVCONSOLE_LOG_ARENA_SIZE - 1)], slot.m_textLength);
+	out_line.m_layoutCellHeight = 0.0f;
+
+	m_releasedArena.store(slot.m_textStart + slot.m_textLength, std::memory_order_release);
+	m_releasedLines.store(linePosition + 1, std::memory_order_release);
+	return true;
+}
+
 bool DevConsole::Command_Test(EventArgs& args)
 {
 	UNUSED(args);
@@ -569,3 +722,52 @@ bool DevConsole::Command_Paste_Text(EventArgs& args)
 
 	return false;
 }
+
+bool DevConsole::Command_SIMDTransformTest(EventArgs& args)
+{
+	SIMDTransformTestConfig config;
+	config.m_numVerts = args.GetValue("verts", config.m_numVerts);
+	config.m_numMatrices = args.GetValue("matrices", config.m_numMatrices);
+	config.m_benchmarkRepeats = args.GetValue("repeats", config.m_benchmarkRepeats);
+
+	if (config.m_numVerts < 1 || config.m_numMatrices < 2 || config.m_benchmarkRepeats < 1) {
+		g_theConsole->AddLine(DevConsole::ERROR_COLOR, "SIMDTransformTest: verts and repeats have to be at least 1, matrices at least 2");
+		return false;
+	}
+
+	SIMDTransformTestResults results = RunSIMDTransformTest(config);
+	if (!results.m_succeeded) {
+		g_theConsole->AddLine(DevConsole::ERROR_COLOR, Stringf("SIMDTransformTest failed: %s", results.m_error.c_str()));
+		return false;
+	}
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR_COLOR, Stringf("SIMDTransformTest: SIMD matches scalar, max error position %g, normal %g, append %g, inverse %g", results.m_maxPositionError, results.m_maxNormalError, results.m_maxAppendError, results.m_maxInverseError));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR_COLOR, Stringf("  %d verts: scalar %.3f ms, SIMD %.3f ms", config.m_numVerts, results.m_scalarTransformMs, results.m_simdTransformMs));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR_COLOR, Stringf("  %d appends: scalar %.3f ms, SIMD %.3f ms", config.m_numMatrices - 1, results.m_scalarAppendMs, results.m_simdAppendMs));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR_COLOR, Stringf("  %d inverses: scalar %.3f ms, SIMD %.3f ms", config.m_numMatrices, results.m_scalarInverseMs, results.m_simdInverseMs));
+	return true;
+}
+
+bool DevConsole::Command_BufferArrayTest(EventArgs& args)
+{
+	BufferArrayTestConfig config;
+	config.m_numElements = args.GetValue("elements", config.m_numElements);
+	config.m_benchmarkRepeats = args.GetValue("repeats", config.m_benchmarkRepeats);
+	config.m_checkOutOfBounds = args.GetValue("outOfBounds", config.m_checkOutOfBounds);
+
+	if (config.m_numElements < 1 || config.m_benchmarkRepeats < 1) {
+		g_theConsole->AddLine(DevConsole::ERROR_COLOR, "BufferArrayTest: elements and repeats have to be at least 1");
+		return false;
+	}
+
+	BufferArrayTestResults results = RunBufferArrayTest(config);
+	if (!results.m_succeeded) {
+		g_theConsole->AddLine(DevConsole::ERROR_COLOR, Stringf("BufferArrayTest failed: %s", results.m_error.c_str()));
+		return false;
+	}
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR_COLOR, Stringf("BufferArrayTest: %d array round trips matched%s", results.m_numRoundTrips, config.m_checkOutOfBounds ? ", out of bounds parses refused" : ""));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR_COLOR, Stringf("  %d Vertex_PNCUs native: element by element %.0f MB/s, array %.0f MB/s", config.m_numElements, results.m_nativeElementwiseMBPerSecond, results.m_nativeArrayMBPerSecond));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR_COLOR, Stringf("  %d Vertex_PNCUs swapped: element by element %.0f MB/s, array %.0f MB/s", config.m_numElements, results.m_swappedElementwiseMBPerSecond, results.m_swappedArrayMBPerSecond));
+	return true;
+}
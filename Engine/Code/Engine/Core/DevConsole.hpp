@@ -5,10 +5,12 @@
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/Stopwatch.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <vector>
-#include <mutex>
 
 class Renderer;
 class BitmapFont;
@@ -16,11 +18,51 @@ class RemoteConsole;
 
 struct DevConsoleLine {
 
+	DevConsoleLine() = default;
 	DevConsoleLine(Rgba8 const& color, std::string const& text, int frameNumber);
 
 	Rgba8 m_color = Rgba8::WHITE;
 	std::string m_text = "";
 	int m_frameNumber = 0;
+
+	// Glyph verts laid out with the line's mins at the origin, reused until the cell height or aspect changes
+	std::vector<Vertex_PCU> m_verts;
+	float m_layoutCellHeight = 0.0f;
+	float m_layoutAspect = 0.0f;
+};
+
+constexpr uint32_t DEVCONSOLE_LOG_RING_LINES = 4096;		// Power of two
+constexpr uint32_t DEVCONSOLE_LOG_ARENA_SIZE = 1 << 20;		// Power of two
+constexpr uint32_t DEVCONSOLE_MAX_LINE_LENGTH = 4096;		// Longer lines are cut
+
+struct DevConsoleLogSlot {
+	std::atomic<uint32_t> m_sequence = 0; // Line position + 1 once the line is published
+	Rgba8 m_color = Rgba8::WHITE;
+	int m_frameNumber = 0;
+	uint32_t m_textStart = 0;
+	uint32_t m_textLength = 0;
+};
+
+// Bounded multi-producer, single-consumer queue of console lines. Text is copied into one shared arena instead of
+// owning strings. A producer claims its slot and its arena range with a single CAS, so slots and text come out in
+// the same order. When either is full the line is dropped and counted rather than blocking the logging thread
+class DevConsoleLogRing {
+public:
+	DevConsoleLogRing();
+	~DevConsoleLogRing();
+
+	bool PushLine(Rgba8 const& color, char const* text, size_t textLength, int frameNumber);
+	// Consumer side, only ever called from one thread. Reuses out_line's string capacity
+	bool PopLine(DevConsoleLine& out_line);
+	uint32_t GetNumDroppedLines() const { return m_numDroppedLines.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<uint64_t> m_reserved = 0;			// Line position in the high 32 bits, arena position in the low 32
+	std::atomic<uint32_t> m_releasedLines = 0;
+	std::atomic<uint32_t> m_releasedArena = 0;
+	std::atomic<uint32_t> m_numDroppedLines = 0;
+	DevConsoleLogSlot* m_slots = nullptr;
+	char* m_arena = nullptr;
 };
 
 enum class DevConsoleMode {
@@ -35,6 +77,8 @@ struct DevConsoleConfig {
 	float m_fontAspect = 0.6f;
 	float m_maxLinesShown = 20.5f;
 	int m_maxCommandHistory = 128;
+	int m_maxLinesKept = 1024;
+	bool m_useRemoteCommandThread = false; // Lets remote commands marked thread safe run off the frame
 };
 
 namespace tinyxml2 {
@@ -56,6 +100,8 @@ public:
 	void EndFrame();
 
 	bool Execute(std::string const& consoleCommandText);
+	// Same parsing and events as Execute, but leaves the command history alone so it can run off the main thread
+	bool ExecuteFromThread(std::string const& consoleCommandText);
 	bool EventExecuteXMLFile(EventArgs& args);
 	bool ExecuteXmlCommandScriptNode(XMLElement const& cmdScriptXmlElement);
 	bool ExecuteXmlCommandScriptFile(std::filesystem::path const& filePath);
@@ -81,6 +127,8 @@ public:
 	static bool Command_Clear(EventArgs& args);
 	static bool Command_Help(EventArgs& args);
 	static bool Command_Paste_Text(EventArgs& args);
+	static bool Command_SIMDTransformTest(EventArgs& args);
+	static bool Command_BufferArrayTest(EventArgs& args);
 
 	Clock m_clock;
 	RemoteConsole* m_remoteConsole = nullptr;
@@ -91,13 +139,28 @@ protected:
 	void Render_UserInput(Renderer& renderer, BitmapFont& font, float fontAspect, float cellHeight) const;
 
 	std::vector<std::string> ProcessCommandLine(std::string const& commandLine) const;
+	std::string ParseCommand(std::string const& commandString, EventArgs& out_commandArgs); // Returns the command name
+	void ConsumeLoggedLines() const;
+	void AddTextVertsForLine(DevConsoleLine& line, BitmapFont& font, float fontAspect, float cellHeight, Vec2 const& lineMins) const;
 protected:
 	DevConsoleConfig m_config;
 	DevConsoleMode m_mode = DevConsoleMode::HIDDEN;
 
-	mutable std::mutex m_linesMutex;
-	std::vector<DevConsoleLine> m_lines;
-	int m_frameNumber = 0;
+	// AddLine only pushes into the ring; the main thread moves lines into m_lines, a circular history that reuses its strings
+	DevConsoleLogRing m_logRing;
+	mutable std::vector<DevConsoleLine> m_lines;
+	mutable int m_newestLineIndex = -1;
+	mutable int m_numLines = 0;
+	mutable uint32_t m_numLinesConsumed = 0;
+	mutable uint32_t m_numDroppedLinesReported = 0;
+	std::atomic<int> m_frameNumber = 0;
+
+	// Text verts of the visible lines, rebuilt only when a line scrolls in or the layout changes
+	mutable std::vector<Vertex_PCU> m_textVerts;
+	mutable uint32_t m_textVertsLinesConsumed = 0;
+	mutable AABB2 m_textVertsBounds;
+	mutable float m_textVertsAspect = 0.0f;
+	mutable bool m_areTextVertsValid = false;
 
 	Stopwatch m_caretStopwatch;
 	std::string m_inputText;
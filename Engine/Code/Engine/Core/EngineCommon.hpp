@@ -11,6 +11,8 @@
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/ProfileLogScope.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include <float.h>
+#include <limits.h>
 #include <string>
 
 class NamedProperties;
@@ -0,0 +1,8 @@
+#include "Engine/Core/EntityPool.hpp"
+
+EntityPoolHandle const EntityPoolHandle::INVALID;
+
+EntityPoolHandle::EntityPoolHandle(int index, int salt) :
+	m_data(((unsigned int)index << 16) | ((unsigned int)salt & 0xffff))
+{
+}
@@ -0,0 +1,185 @@
+#pragma once
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <new>
+#include <utility>
+#include <vector>
+
+// Slot index in the high 16 bits, salt in the low 16 bits, same layout as Doomenstein's ActorUID. The salt goes up every
+// time the slot is freed, so a handle to a destroyed entity stops resolving even after the slot is reused
+struct EntityPoolHandle {
+public:
+	EntityPoolHandle() = default;
+	EntityPoolHandle(int index, int salt);
+
+	void Invalidate() { m_data = INVALID_DATA; }
+	bool IsValid() const { return m_data != INVALID_DATA; }
+	int GetIndex() const { return (int)(m_data >> 16); }
+	int GetSalt() const { return (int)(m_data & 0xffff); }
+	bool operator==(EntityPoolHandle const& other) const { return m_data == other.m_data; }
+	bool operator!=(EntityPoolHandle const& other) const { return m_data != other.m_data; }
+
+	static EntityPoolHandle const INVALID;
+
+private:
+	static constexpr unsigned int INVALID_DATA = 0xffffffff;
+	unsigned int m_data = INVALID_DATA;
+};
+
+constexpr int ENTITY_POOL_MAX_CAPACITY = 0xffff; // Slot 0xffff with salt 0xffff would read as INVALID
+
+// Fixed capacity storage for one entity type. All slots are allocated once, up front, as one contiguous block; entities
+// are constructed in place and freed slots are reused, so spawning never goes to the heap. Entities never move while
+// alive, so raw pointers stay good until Destroy. Live entities are also listed in a packed array: loop over
+// GetCount/GetItem instead of scanning every slot
+template <typename T>
+class EntityPool {
+public:
+	explicit EntityPool(int capacity);
+	~EntityPool();
+	EntityPool(EntityPool const& copyFrom) = delete;
+	EntityPool& operator=(EntityPool const& copyFrom) = delete;
+
+	// Returns nullptr when every slot is taken
+	template <typename... ConstructorArgs>
+	T* Create(ConstructorArgs&&... args);
+	// Destroying moves the last live entity into the freed spot of the packed array. Loop backwards when destroying
+	// while iterating
+	void Destroy(T* item);
+	void Destroy(EntityPoolHandle const& handle);
+	void Clear();
+
+	int GetCount() const { return (int)m_liveSlots.size(); }
+	int GetCapacity() const { return m_capacity; }
+	bool IsFull() const { return m_freeSlots.empty(); }
+	T* GetItem(int liveIndex) { return m_slots + m_liveSlots[liveIndex]; }
+	T const* GetItem(int liveIndex) const { return m_slots + m_liveSlots[liveIndex]; }
+
+	bool Owns(T const* item) const { return (item >= m_slots) && (item < m_slots + m_capacity); }
+	EntityPoolHandle GetHandle(T const* item) const;
+	// nullptr if the entity the handle pointed to has been destroyed
+	T* Get(EntityPoolHandle const& handle);
+	T const* Get(EntityPoolHandle const& handle) const;
+
+private:
+	int GetSlotIndex(T const* item) const { return (int)(item - m_slots); }
+	bool IsHandleLive(EntityPoolHandle const& handle) const;
+
+private:
+	T* m_slots = nullptr;
+	int m_capacity = 0;
+	std::vector<unsigned short> m_salts;
+	std::vector<int> m_liveIndexes;		// Per slot, position in m_liveSlots, -1 while free
+	std::vector<int> m_liveSlots;
+	std::vector<int> m_freeSlots;		// Used as a stack, so the most recently freed (still cached) slot goes first
+};
+
+template <typename T>
+EntityPool<T>::EntityPool(int capacity) :
+	m_capacity(capacity)
+{
+	GUARANTEE_OR_DIE((capacity > 0) && (capacity < ENTITY_POOL_MAX_CAPACITY), "ENTITY POOL CAPACITY OUT OF RANGE");
+
+	m_slots = static_cast<T*>(::operator new(sizeof(T) * (size_t)capacity, std::align_val_t(alignof(T))));
+	m_salts.resize((size_t)capacity, 0);
+	m_liveIndexes.resize((size_t)capacity, -1);
+	m_liveSlots.reserve((size_t)capacity);
+	m_freeSlots.reserve((size_t)capacity);
+	for (int slotIndex = capacity - 1; slotIndex >= 0; slotIndex--) {
+		m_freeSlots.push_back(slotIndex);
+	}
+}
+
+template <typename T>
+EntityPool<T>::~EntityPool()
+{
+	Clear();
+	::operator delete(m_slots, std::align_val_t(alignof(T)));
+	m_slots = nullptr;
+}
+
+template <typename T>
+template <typename... ConstructorArgs>
+T* EntityPool<T>::Create(ConstructorArgs&&... args)
+{
+	if (m_freeSlots.empty()) return nullptr;
+
+	int slotIndex = m_freeSlots.back();
+	m_freeSlots.pop_back();
+
+	T* item = new (m_slots + slotIndex) T(std::forward<ConstructorArgs>(args)...);
+	m_liveIndexes[slotIndex] = (int)m_liveSlots.size();
+	m_liveSlots.push_back(slotIndex);
+	return item;
+}
+
+template <typename T>
+void EntityPool<T>::Destroy(T* item)
+{
+	if (!item) return;
+	GUARANTEE_OR_DIE(Owns(item), "DESTROYING AN ENTITY THAT DOES NOT BELONG TO THIS POOL");
+
+	int slotIndex = GetSlotIndex(item);
+	int liveIndex = m_liveIndexes[slotIndex];
+	if (liveIndex == -1) {
+		ERROR_RECOVERABLE("DESTROYING AN ENTITY TWICE");
+		return;
+	}
+
+	item->~T();
+
+	int lastSlotIndex = m_liveSlots.back();
+	m_liveSlots[liveIndex] = lastSlotIndex;
+	m_liveIndexes[lastSlotIndex] = liveIndex;
+	m_liveSlots.pop_back();
+
+	m_liveIndexes[slotIndex] = -1;
+	m_salts[slotIndex]++;
+	m_freeSlots.push_back(slotIndex);
+}
+
+template <typename T>
+void EntityPool<T>::Destroy(EntityPoolHandle const& handle)
+{
+	if (!IsHandleLive(handle)) return;
+	Destroy(m_slots + handle.GetIndex());
+}
+
+template <typename T>
+void EntityPool<T>::Clear()
+{
+	for (int liveIndex = GetCount() - 1; liveIndex >= 0; liveIndex--) {
+		Destroy(GetItem(liveIndex));
+	}
+}
+
+template <typename T>
+EntityPoolHandle EntityPool<T>::GetHandle(T const* item) const
+{
+	if (!item || !Owns(item)) return EntityPoolHandle::INVALID;
+
+	int slotIndex = GetSlotIndex(item);
+	if (m_liveIndexes[slotIndex] == -1) return EntityPoolHandle::INVALID;
+	return EntityPoolHandle(slotIndex, m_salts[slotIndex]);
+}
+
+template <typename T>
+T* EntityPool<T>::Get(EntityPoolHandle const& handle)
+{
+	return IsHandleLive(handle) ? (m_slots + handle.GetIndex()) : nullptr;
+}
+
+template <typename T>
+T const* EntityPool<T>::Get(EntityPoolHandle const& handle) const
+{
+	return IsHandleLive(handle) ? (m_slots + handle.GetIndex()) : nullptr;
+}
+
+template <typename T>
+bool EntityPool<T>::IsHandleLive(EntityPoolHandle const& handle) const
+{
+	if (!handle.IsValid()) return false;
+
+	int slotIndex = handle.GetIndex();
+	if (slotIndex >= m_capacity) return false;
+	return (m_liveIndexes[slotIndex] != -1) && (m_salts[slotIndex] == (unsigned short)handle.GetSalt());
+}
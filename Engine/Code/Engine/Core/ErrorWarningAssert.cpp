@@ -13,6 +13,7 @@
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include <stdarg.h>
+#include <string.h>
 #include <iostream>
 
 
@@ -48,7 +49,7 @@ void DebuggerPrintf( char const* messageFormat, ... )
 	char messageLiteral[ MESSAGE_MAX_LENGTH ];
 	va_list variableArgumentList;
 	va_start( variableArgumentList, messageFormat );
-	vsnprintf_s( messageLiteral, MESSAGE_MAX_LENGTH, _TRUNCATE, messageFormat, variableArgumentList );
+	vsnprintf( messageLiteral, MESSAGE_MAX_LENGTH, messageFormat, variableArgumentList );
 	va_end( variableArgumentList );
 	messageLiteral[ MESSAGE_MAX_LENGTH - 1 ] = '\0'; // In case vsnprintf overran (doesn't auto-terminate)
 
@@ -81,6 +82,36 @@ UINT GetWindowsMessageBoxIconFlagForSeverityLevel( MsgSeverityLevel severity )
 #endif
 
 
+//-----------------------------------------------------------------------------------------------
+// Platform pieces used by FatalError and RecoverableWarning; without dialogues there is nothing
+//	to break into, so the other platforms just print the message
+//
+static bool IsDebuggerAttached()
+{
+#if defined( PLATFORM_WINDOWS )
+	return (IsDebuggerPresent() == TRUE);
+#else
+	return false;
+#endif
+}
+
+
+static void ShowSystemCursor()
+{
+#if defined( PLATFORM_WINDOWS )
+	ShowCursor( TRUE );
+#endif
+}
+
+
+static void BreakIntoDebugger()
+{
+#if defined( PLATFORM_WINDOWS )
+	__debugbreak();
+#endif
+}
+
+
 //-----------------------------------------------------------------------------------------------
 char const* FindStartOfFileNameWithinFilePath( char const* filePath )
 {
@@ -182,7 +213,7 @@ int SystemDialogue_YesNoCancel( std::string const& messageTitle, std::string con
 
 
 //-----------------------------------------------------------------------------------------------
-__declspec( noreturn ) void FatalError( char const* filePath, char const* functionName, int lineNum, std::string const& reasonForError, char const* conditionText )
+[[noreturn]] void FatalError( char const* filePath, char const* functionName, int lineNum, std::string const& reasonForError, char const* conditionText )
 {
 	std::string errorMessage = reasonForError;
 	if( reasonForError.empty() )
@@ -198,7 +229,7 @@ __declspec( noreturn ) void FatalError( char const* filePath, char const* functi
 	std::string fullMessageTitle = appName + " :: Error";
 	std::string fullMessageText = errorMessage;
 	fullMessageText += "\n\nThe application will now close.\n";
-	bool isDebuggerPresent = (IsDebuggerPresent() == TRUE);
+	bool isDebuggerPresent = IsDebuggerAttached();
 	if( isDebuggerPresent )
 	{
 		fullMessageText += "\nDEBUGGER DETECTED!\nWould you like to break and debug?\n  (Yes=debug, No=quit)\n";
@@ -224,16 +255,16 @@ __declspec( noreturn ) void FatalError( char const* filePath, char const* functi
 	if( isDebuggerPresent )
 	{
 		bool isAnswerYes = SystemDialogue_YesNo( fullMessageTitle, fullMessageText, MsgSeverityLevel::FATAL );
-		ShowCursor( TRUE );
+		ShowSystemCursor();
 		if( isAnswerYes )
 		{
-			__debugbreak();
+			BreakIntoDebugger();
 		}
 	}
 	else
 	{
 		SystemDialogue_Okay( fullMessageTitle, fullMessageText, MsgSeverityLevel::FATAL );
-		ShowCursor( TRUE );
+		ShowSystemCursor();
 	}
 
 	exit( 0 );
@@ -257,7 +288,7 @@ void RecoverableWarning( char const* filePath, char const* functionName, int lin
 	std::string fullMessageTitle = appName + " :: Warning";
 	std::string fullMessageText = errorMessage;
 
-	bool isDebuggerPresent = (IsDebuggerPresent() == TRUE);
+	bool isDebuggerPresent = IsDebuggerAttached();
 	if( isDebuggerPresent )
 	{
 		fullMessageText += "\n\nDEBUGGER DETECTED!\nWould you like to continue running?\n  (Yes=continue, No=quit, Cancel=debug)\n";
@@ -287,19 +318,19 @@ void RecoverableWarning( char const* filePath, char const* functionName, int lin
 	if( isDebuggerPresent )
 	{
 		int answerCode = SystemDialogue_YesNoCancel( fullMessageTitle, fullMessageText, MsgSeverityLevel::WARNING );
-		ShowCursor( TRUE );
+		ShowSystemCursor();
 		if( answerCode == 0 ) // "NO"
 		{
 			exit( 0 );
 		}
 		else if( answerCode == -1 ) // "CANCEL"
-		{			__debugbreak();
+		{			BreakIntoDebugger();
 		}
 	}
 	else
 	{
 		bool isAnswerYes = SystemDialogue_YesNo( fullMessageTitle, fullMessageText, MsgSeverityLevel::WARNING );
-		ShowCursor( TRUE );
+		ShowSystemCursor();
 		if( !isAnswerYes )
 		{
 			exit( 0 );
@@ -5,6 +5,7 @@
 #include <mutex>
 
 class NamedProperties;
+class EventSystem;
 
 typedef NamedProperties EventArgs;
 typedef bool (*EventCallbackFunction)(EventArgs& args);
@@ -6,6 +6,15 @@
 #include <iostream>
 #include <fstream>
 
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 
 bool FileExists(const std::string& filename)
 {
@@ -37,23 +46,17 @@ int FileWriteFromBuffer(std::vector<uint8_t>& inBuffer, const std::string& filen
 
 int FileReadToBuffer(std::vector<uint8_t>& outBuffer, const std::string& filename)
 {
-	std::ifstream inFile(filename, std::ifstream::in | std::ifstream::binary);
-	size_t fileSize = static_cast<size_t>(inFile.tellg());
-
-	inFile.seekg(0, std::ios::end);
-
-	fileSize = static_cast<size_t>(inFile.tellg()) - fileSize;
-	outBuffer.resize(fileSize);
-
-	inFile.seekg(0, std::ios::beg);
-
+	std::ifstream inFile(filename, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
 	if (!inFile.is_open()) {
-		inFile.close();
 		ERROR_RECOVERABLE(Stringf("ERROR TRYING TO OPEN THE FILE, MAY NOT EXIST %s", filename.c_str()));
+		return -1;
 	}
-	else {
-		inFile.read(reinterpret_cast<char*>(outBuffer.data()), fileSize);
-	}
+
+	size_t fileSize = static_cast<size_t>(inFile.tellg());
+	inFile.seekg(0, std::ios::beg);
+
+	outBuffer.resize(fileSize);
+	inFile.read(reinterpret_cast<char*>(outBuffer.data()), fileSize);
 
 	if (inFile.bad()) {
 		inFile.close();
@@ -67,16 +70,285 @@ int FileReadToBuffer(std::vector<uint8_t>& outBuffer, const std::string& filenam
 
 int FileReadToString(std::string& outString, const std::string& filename)
 {
-	std::vector<uint8_t> fileBuffer;
-	int result = FileReadToBuffer(fileBuffer, filename);
-	if (result != 0) {
+	// Mapped and copied once straight into the string, instead of going through an intermediate buffer
+	MappedFile file;
+	if (!file.Open(filename)) {
+		ERROR_RECOVERABLE(Stringf("ERROR TRYING TO OPEN THE FILE, MAY NOT EXIST %s", filename.c_str()));
+		return -1;
+	}
+
+	outString.assign(reinterpret_cast<char const*>(file.GetData()), file.GetSize());
+
+	return 0;
+}
+
+int FileAppendFromBuffer(std::vector<uint8_t> const& inBuffer, const std::string& filename)
+{
+	std::ofstream outfile(filename, std::ios::binary | std::ios::out | std::ios::app);
+	if (!outfile.is_open()) {
+		ERROR_RECOVERABLE(Stringf("ERROR TRYING TO OPEN THE FILE FOR APPENDING: %s", filename.c_str()));
 		return -1;
 	}
 
-	fileBuffer.push_back('\0');
+	outfile.write(reinterpret_cast<char const*>(inBuffer.data()), inBuffer.size() * sizeof(uint8_t));
 
-	outString = std::string((char*)fileBuffer.data());
+	if (outfile.bad()) {
+		ERROR_RECOVERABLE(Stringf("ERROR TRYING TO APPEND FROM BUFFER TO FILE: %s", filename.c_str()));
+		return -1;
+	}
 
+	outfile.close();
 	return 0;
 }
 
+int FileOverwriteBytes(void const* bytes, size_t numBytes, size_t fileOffset, const std::string& filename)
+{
+	std::fstream outfile(filename, std::ios::binary | std::ios::in | std::ios::out);
+	if (!outfile.is_open()) {
+		ERROR_RECOVERABLE(Stringf("ERROR TRYING TO OPEN THE FILE FOR OVERWRITING: %s", filename.c_str()));
+		return -1;
+	}
+
+	outfile.seekp(fileOffset, std::ios::beg);
+	outfile.write(reinterpret_cast<char const*>(bytes), numBytes);
+
+	if (outfile.bad()) {
+		ERROR_RECOVERABLE(Stringf("ERROR TRYING TO OVERWRITE BYTES IN FILE: %s", filename.c_str()));
+		return -1;
+	}
+
+	outfile.close();
+	return 0;
+}
+
+MappedFile::MappedFile(std::string const& filename)
+{
+	Open(filename);
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& moveFrom) noexcept
+{
+	TakeOver(moveFrom);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& moveFrom) noexcept
+{
+	if (this != &moveFrom) {
+		Close();
+		TakeOver(moveFrom);
+	}
+	return *this;
+}
+
+void MappedFile::TakeOver(MappedFile& moveFrom)
+{
+	m_filename = std::move(moveFrom.m_filename);
+	m_data = moveFrom.m_data;
+	m_size = moveFrom.m_size;
+	m_isOpen = moveFrom.m_isOpen;
+#if defined(_WIN32)
+	m_fileHandle = moveFrom.m_fileHandle;
+	m_mappingHandle = moveFrom.m_mappingHandle;
+	moveFrom.m_fileHandle = nullptr;
+	moveFrom.m_mappingHandle = nullptr;
+#else
+	m_fileDescriptor = moveFrom.m_fileDescriptor;
+	moveFrom.m_fileDescriptor = -1;
+#endif
+	moveFrom.m_data = nullptr;
+	moveFrom.m_size = 0;
+	moveFrom.m_isOpen = false;
+}
+
+#if defined(_WIN32)
+bool MappedFile::Open(std::string const& filename)
+{
+	Close();
+
+	HANDLE fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize)) {
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	m_fileHandle = fileHandle;
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+	m_filename = filename;
+	m_isOpen = true;
+
+	// Zero sized files cannot be mapped
+	if (m_size == 0) return true;
+
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle == nullptr) {
+		Close();
+		return false;
+	}
+	m_mappingHandle = mappingHandle;
+
+	m_data = static_cast<unsigned char const*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (m_data == nullptr) {
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_data) {
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mappingHandle) {
+		CloseHandle(m_mappingHandle);
+	}
+	if (m_fileHandle) {
+		CloseHandle(m_fileHandle);
+	}
+
+	m_data = nullptr;
+	m_mappingHandle = nullptr;
+	m_fileHandle = nullptr;
+	m_size = 0;
+	m_isOpen = false;
+	m_filename.clear();
+}
+#else
+bool MappedFile::Open(std::string const& filename)
+{
+	Close();
+
+	int fileDescriptor = open(filename.c_str(), O_RDONLY);
+	if (fileDescriptor < 0) return false;
+
+	struct stat fileStats;
+	if (fstat(fileDescriptor, &fileStats) != 0) {
+		close(fileDescriptor);
+		return false;
+	}
+
+	m_fileDescriptor = fileDescriptor;
+	m_size = static_cast<size_t>(fileStats.st_size);
+	m_filename = filename;
+	m_isOpen = true;
+
+	// Zero sized files cannot be mapped
+	if (m_size == 0) return true;
+
+	void* mappedData = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	if (mappedData == MAP_FAILED) {
+		Close();
+		return false;
+	}
+	madvise(mappedData, m_size, MADV_SEQUENTIAL);
+	m_data = static_cast<unsigned char const*>(mappedData);
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_data) {
+		munmap(const_cast<unsigned char*>(m_data), m_size);
+	}
+	if (m_fileDescriptor >= 0) {
+		close(m_fileDescriptor);
+	}
+
+	m_data = nullptr;
+	m_fileDescriptor = -1;
+	m_size = 0;
+	m_isOpen = false;
+	m_filename.clear();
+}
+#endif
+
+FileReadJob::FileReadJob(std::string const& filename, int jobType, void* userData) :
+	Job::Job(jobType),
+	m_filename(filename),
+	m_userData(userData)
+{
+}
+
+void FileReadJob::Execute()
+{
+	m_succeeded = m_file.Open(m_filename);
+}
+
+AsyncFileReader::AsyncFileReader(JobSystem* jobSystem) :
+	m_jobSystem(jobSystem)
+{
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+	Shutdown();
+}
+
+void AsyncFileReader::Startup()
+{
+	if (m_ioThread) return;
+	m_isQuitting = false;
+	m_ioThread = new std::thread(&AsyncFileReader::IOThreadMain, this);
+}
+
+void AsyncFileReader::Shutdown()
+{
+	if (!m_ioThread) return;
+
+	m_pendingReadsMutex.lock();
+	m_isQuitting = true;
+	m_pendingReadsMutex.unlock();
+	m_pendingReadsCondition.notify_all();
+
+	m_ioThread->join();
+	delete m_ioThread;
+	m_ioThread = nullptr;
+
+	for (FileReadJob* pendingRead : m_pendingReads) {
+		delete pendingRead;
+	}
+	m_pendingReads.clear();
+	m_numPendingReads = 0;
+}
+
+void AsyncFileReader::QueueRead(FileReadJob* readJob)
+{
+	m_pendingReadsMutex.lock();
+	m_pendingReads.push_back(readJob);
+	m_pendingReadsMutex.unlock();
+
+	m_numPendingReads++;
+	m_pendingReadsCondition.notify_one();
+}
+
+void AsyncFileReader::IOThreadMain()
+{
+	while (true) {
+		FileReadJob* readJob = nullptr;
+		{
+			std::unique_lock<std::mutex> pendingLock(m_pendingReadsMutex);
+			while (m_pendingReads.empty() && !m_isQuitting) {
+				m_pendingReadsCondition.wait(pendingLock);
+			}
+			if (m_isQuitting) return;
+
+			readJob = m_pendingReads.front();
+			m_pendingReads.pop_front();
+		}
+
+		readJob->Execute();
+		readJob->OnFinished();
+		m_numPendingReads--;
+		m_jobSystem->PostCompletedJob(readJob);
+	}
+}
@@ -1,6 +1,12 @@
 #pragma once
 
+#include "Engine/Core/JobSystem.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <filesystem>
 
@@ -8,4 +14,84 @@ bool FileExists(const std::string& filename);
 int FileWriteFromBuffer(std::vector<uint8_t>& inBuffer, const std::string& filename);
 int FileReadToBuffer(std::vector<uint8_t>& outBuffer, const std::string& filename);
 int FileReadToString(std::string& outString, const std::string& filename);
+// Both leave the rest of an existing file untouched; meant for formats that append new data and patch an offset
+int FileAppendFromBuffer(std::vector<uint8_t> const& inBuffer, const std::string& filename);
+int FileOverwriteBytes(void const* bytes, size_t numBytes, size_t fileOffset, const std::string& filename);
 
+// Read-only view of a whole file mapped into memory. The bytes are valid until the file is closed or the MappedFile is
+// destroyed; parse them in place (BufferParser takes a pointer and size) instead of copying them out
+class MappedFile {
+public:
+	MappedFile() = default;
+	explicit MappedFile(std::string const& filename);
+	~MappedFile();
+
+	MappedFile(MappedFile const& copyFrom) = delete;
+	MappedFile& operator=(MappedFile const& copyFrom) = delete;
+	MappedFile(MappedFile&& moveFrom) noexcept;
+	MappedFile& operator=(MappedFile&& moveFrom) noexcept;
+
+	bool Open(std::string const& filename);
+	void Close();
+
+	bool IsOpen() const { return m_isOpen; }
+	unsigned char const* GetData() const { return m_data; }
+	size_t GetSize() const { return m_size; }
+	std::string const& GetFilename() const { return m_filename; }
+
+private:
+	void TakeOver(MappedFile& moveFrom);
+
+private:
+	std::string m_filename;
+	unsigned char const* m_data = nullptr; // nullptr for empty files, which are still considered open
+	size_t m_size = 0;
+	bool m_isOpen = false;
+#if defined(_WIN32)
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+#else
+	int m_fileDescriptor = -1;
+#endif
+};
+
+// Result of an async read. m_file is mapped on the I/O thread, then the job is posted straight to the job system's
+// completed queue, where it is retrieved like any other job. Pick a jobType the game's completed-job dispatch handles
+class FileReadJob : public Job {
+public:
+	FileReadJob(std::string const& filename, int jobType = DEFAULT_JOB_ID, void* userData = nullptr);
+
+	virtual void Execute() override;
+	virtual void OnFinished() override {}
+
+	std::string m_filename;
+	MappedFile m_file;
+	void* m_userData = nullptr;
+	bool m_succeeded = false;
+};
+
+// Owns one I/O thread that services reads in submission order so that disk access never stalls the job workers
+class AsyncFileReader {
+public:
+	AsyncFileReader(JobSystem* jobSystem);
+	~AsyncFileReader();
+
+	void Startup();
+	void Shutdown(); // Reads still pending are deleted without completing
+
+	void QueueRead(FileReadJob* readJob);
+	int GetNumPendingReads() const { return m_numPendingReads; }
+
+private:
+	void IOThreadMain();
+
+private:
+	JobSystem* m_jobSystem = nullptr;
+	std::thread* m_ioThread = nullptr;
+	std::atomic<bool> m_isQuitting = false;
+
+	std::deque<FileReadJob*> m_pendingReads;
+	std::mutex m_pendingReadsMutex;
+	std::condition_variable m_pendingReadsCondition;
+	std::atomic<int> m_numPendingReads = 0;
+};
@@ -148,6 +148,14 @@ void JobSystem::QueueJob(Job* job)
 
 }
 
+void JobSystem::QueueJob(Job* job, JobBatch& batch)
+{
+	job->m_batch = &batch;
+	batch.m_jobs.push_back(job);
+	batch.m_pendingJobs++;
+	QueueJob(job);
+}
+
 void JobSystem::MarkJobAsCompleted(Job* job)
 {
 	if (job->m_executionId < 0) return;
@@ -159,6 +167,13 @@ void JobSystem::MarkJobAsCompleted(Job* job)
 
 	m_jobsOnExecutionMutex.unlock(); // unlock
 
+	// The batch owner may delete the job as soon as the pending count drops, so the job can't be touched after that
+	JobBatch* batch = job->m_batch;
+	if (batch) {
+		m_amountOfExecutingJobs--;
+		batch->m_pendingJobs--;
+		return;
+	}
 
 	m_completedJobsMutex.lock(); // lock
 
@@ -170,6 +185,15 @@ void JobSystem::MarkJobAsCompleted(Job* job)
 
 }
 
+void JobSystem::PostCompletedJob(Job* job)
+{
+	m_completedJobsMutex.lock(); // lock
+
+	m_completedJobs.push_back(job);
+
+	m_completedJobsMutex.unlock(); // unlock
+}
+
 Job* JobSystem::RetrieveCompletedJob()
 {
 	m_completedJobsMutex.lock();
@@ -183,10 +207,42 @@ Job* JobSystem::RetrieveCompletedJob()
 	return completedJob;
 }
 
+bool JobSystem::ExecuteQueuedBatchJob(JobBatch& batch)
+{
+	Job* batchJob = nullptr;
+	m_queuedJobsMutex.lock(); // lock
+
+	for (std::deque<Job*>::iterator dequeIt = m_queuedJobs.begin(); dequeIt != m_queuedJobs.end(); dequeIt++) {
+		if (*dequeIt && ((*dequeIt)->m_batch == &batch)) {
+			batchJob = *dequeIt;
+			m_queuedJobs.erase(dequeIt);
+			break;
+		}
+	}
+
+	m_queuedJobsMutex.unlock(); // unlock
+
+	if (!batchJob) return false;
+
+	m_amountOfQueuedJobs--;
+	m_amountOfExecutingJobs++;
+	batchJob->Execute();
+	batchJob->OnFinished();
+	m_amountOfExecutingJobs--;
+	batch.m_pendingJobs--;
+	return true;
+}
+
 void JobSystem::ClearQueuedJobs()
 {
 	m_amountOfQueuedJobs = 0;
 	m_queuedJobsMutex.lock();
+	// Dropped batch jobs never run, so they stop counting as pending or their batch would wait forever
+	for (Job* job : m_queuedJobs) {
+		if (job && job->m_batch) {
+			job->m_batch->m_pendingJobs--;
+		}
+	}
 	m_queuedJobs.clear();
 	m_queuedJobsMutex.unlock();
 
@@ -229,6 +285,35 @@ void JobSystem::SetThreadJobType(int threadId, int jobType)
 	m_workerThreads[threadId]->m_threadJobType = jobType;
 }
 
+JobBatch::JobBatch(JobSystem* jobSystem) :
+	m_jobSystem(jobSystem)
+{
+}
+
+JobBatch::~JobBatch()
+{
+	WaitAndDeleteJobs();
+}
+
+void JobBatch::QueueJob(Job* job)
+{
+	m_jobSystem->QueueJob(job, *this);
+}
+
+void JobBatch::WaitAndDeleteJobs()
+{
+	while (m_pendingJobs > 0) {
+		if (!m_jobSystem->ExecuteQueuedBatchJob(*this)) {
+			std::this_thread::yield();
+		}
+	}
+
+	for (Job* job : m_jobs) {
+		delete job;
+	}
+	m_jobs.clear();
+}
+
 Job::Job(int jobType) :
 	m_jobType(jobType)
 {
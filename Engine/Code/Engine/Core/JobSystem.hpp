@@ -1,6 +1,8 @@
 #pragma once
+#include <atomic>
 #include <deque>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 
@@ -9,6 +11,7 @@ struct JobSystemConfig {
 };
 
 class Job;
+class JobBatch;
 class JobWorkerThread;
 
 constexpr int MULTIPURPOSE_THREAD = ~0;
@@ -28,10 +31,13 @@ public:
 
 	Job* ClaimJobToExecute(int threadJobType);
 	void QueueJob(Job* job);
+	void QueueJob(Job* job, JobBatch& batch); // Batch jobs skip the completed queue, see JobBatch
 	void MarkJobAsCompleted(Job* job);
+	void PostCompletedJob(Job* job); // For jobs executed outside the worker threads, e.g. by an I/O thread
 	Job* RetrieveCompletedJob();
+	bool ExecuteQueuedBatchJob(JobBatch& batch); // Runs one of the batch's queued jobs on the calling thread, false if none is queued
 
-	void ClearQueuedJobs();
+	void ClearQueuedJobs(); // Queued batch jobs are dropped from their batch's pending count, the batch still deletes them
 	void ClearCompletedJobs();
 	void WaitUntilCurrentJobsCompletion();
 	void WaitUntilQueuedJobsCompletion();
@@ -76,10 +82,34 @@ protected:
 
 protected:
 	int m_executionId = -1;
+	JobBatch* m_batch = nullptr;
 
 
 };
 
+// Jobs queued through a batch never go to the completed queue, so a system that needs to wait for its own jobs
+// doesn't pull (and delete) jobs that belong to someone else. The batch owns its jobs and deletes them once they are done.
+// While waiting, the calling thread runs the batch's jobs that are still queued, so the wait ends even without workers
+class JobBatch {
+
+public:
+	JobBatch(JobSystem* jobSystem);
+	~JobBatch(); // Waits for the jobs still in flight before deleting them
+
+	void QueueJob(Job* job);
+	void WaitAndDeleteJobs();
+
+	int GetNumJobs() const { return (int)m_jobs.size(); }
+	bool IsDone() const { return m_pendingJobs == 0; }
+
+private:
+	friend class JobSystem;
+	JobSystem* m_jobSystem = nullptr;
+	std::vector<Job*> m_jobs;
+	std::atomic<int> m_pendingJobs = 0;
+
+};
+
 class JobWorkerThread {
 
 public:
@@ -0,0 +1,7 @@
+#pragma once
+
+// CRT functions that are spelled differently outside of Windows. Include this instead of redefining them per file
+#if !defined( _WIN32 )
+#include <strings.h>
+#define _stricmp strcasecmp
+#endif
@@ -0,0 +1,334 @@
+#include "Engine/Core/SIMDTransformTest.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/Vertex_PNCU.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// Column by column, one multiply-add at a time, the way Mat44::Append reads without SIMD
+static Mat44 const GetScalarAppended(Mat44 const& matrix, Mat44 const& appendThis)
+{
+	Mat44 result;
+	for (int column = 0; column < 4; column++) {
+		for (int row = 0; row < 4; row++) {
+			float value = 0.0f;
+			for (int term = 0; term < 4; term++) {
+				value += matrix.m_values[(term * 4) + row] * appendThis.m_values[(column * 4) + term];
+			}
+			result.m_values[(column * 4) + row] = value;
+		}
+	}
+	return result;
+}
+
+// Cofactor expansion over 2x2 sub-determinants, in doubles. Reading the basis-major values as rows inverts the transpose,
+// and writing them back the same way transposes it again
+static Mat44 const GetScalarInverted(Mat44 const& matrix)
+{
+	double a[16];
+	for (int valueIndex = 0; valueIndex < 16; valueIndex++) {
+		a[valueIndex] = (double)matrix.m_values[valueIndex];
+	}
+
+	double s0 = a[0] * a[5] - a[4] * a[1];
+	double s1 = a[0] * a[6] - a[4] * a[2];
+	double s2 = a[0] * a[7] - a[4] * a[3];
+	double s3 = a[1] * a[6] - a[5] * a[2];
+	double s4 = a[1] * a[7] - a[5] * a[3];
+	double s5 = a[2] * a[7] - a[6] * a[3];
+
+	double c5 = a[10] * a[15] - a[14] * a[11];
+	double c4 = a[9] * a[15] - a[13] * a[11];
+	double c3 = a[9] * a[14] - a[13] * a[10];
+	double c2 = a[8] * a[15] - a[12] * a[11];
+	double c1 = a[8] * a[14] - a[12] * a[10];
+	double c0 = a[8] * a[13] - a[12] * a[9];
+
+	double invDeterminant = 1.0 / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+	double inverse[16] = {
+		( a[5] * c5 - a[6] * c4 + a[7] * c3),
+		(-a[1] * c5 + a[2] * c4 - a[3] * c3),
+		( a[13] * s5 - a[14] * s4 + a[15] * s3),
+		(-a[9] * s5 + a[10] * s4 - a[11] * s3),
+		(-a[4] * c5 + a[6] * c2 - a[7] * c1),
+		( a[0] * c5 - a[2] * c2 + a[3] * c1),
+		(-a[12] * s5 + a[14] * s2 - a[15] * s1),
+		( a[8] * s5 - a[10] * s2 + a[11] * s1),
+		( a[4] * c4 - a[5] * c2 + a[7] * c0),
+		(-a[0] * c4 + a[1] * c2 - a[3] * c0),
+		( a[12] * s4 - a[13] * s2 + a[15] * s0),
+		(-a[8] * s4 + a[9] * s2 - a[11] * s0),
+		(-a[4] * c3 + a[5] * c1 - a[6] * c0),
+		( a[0] * c3 - a[1] * c1 + a[2] * c0),
+		(-a[12] * s3 + a[13] * s1 - a[14] * s0),
+		( a[8] * s3 - a[9] * s1 + a[10] * s0),
+	};
+
+	Mat44 result;
+	for (int valueIndex = 0; valueIndex < 16; valueIndex++) {
+		result.m_values[valueIndex] = (float)(inverse[valueIndex] * invDeterminant);
+	}
+	return result;
+}
+
+// Rotated, non-uniformly scaled and translated, so it is well conditioned but not orthonormal
+static Mat44 const GetRandomAffineTransform(RandomNumberGenerator& rng)
+{
+	Mat44 transform = Mat44::CreateTranslation3D(Vec3(rng.GetRandomFloatInRange(-50.0f, 50.0f), rng.GetRandomFloatInRange(-50.0f, 50.0f), rng.GetRandomFloatInRange(-50.0f, 50.0f)));
+	transform = GetScalarAppended(transform, Mat44::CreateZRotationDegrees(rng.GetRandomFloatInRange(0.0f, 360.0f)));
+	transform = GetScalarAppended(transform, Mat44::CreateYRotationDegrees(rng.GetRandomFloatInRange(-90.0f, 90.0f)));
+	transform = GetScalarAppended(transform, Mat44::CreateXRotationDegrees(rng.GetRandomFloatInRange(0.0f, 360.0f)));
+	return GetScalarAppended(transform, Mat44::CreateNonUniformScale3D(Vec3(rng.GetRandomFloatInRange(0.5f, 4.0f), rng.GetRandomFloatInRange(0.5f, 4.0f), rng.GetRandomFloatInRange(0.5f, 4.0f))));
+}
+
+static Mat44 const GetRandomMatrix(RandomNumberGenerator& rng)
+{
+	Mat44 matrix;
+	for (int valueIndex = 0; valueIndex < 16; valueIndex++) {
+		matrix.m_values[valueIndex] = rng.GetRandomFloatInRange(-10.0f, 10.0f);
+	}
+	return matrix;
+}
+
+static Vec3 const GetRandomPosition(RandomNumberGenerator& rng)
+{
+	return Vec3(rng.GetRandomFloatInRange(-100.0f, 100.0f), rng.GetRandomFloatInRange(-100.0f, 100.0f), rng.GetRandomFloatInRange(-100.0f, 100.0f));
+}
+
+static Vec3 const GetRandomDirection(RandomNumberGenerator& rng)
+{
+	Vec3 direction;
+	do {
+		direction = Vec3(rng.GetRandomFloatInRange(-1.0f, 1.0f), rng.GetRandomFloatInRange(-1.0f, 1.0f), rng.GetRandomFloatInRange(-1.0f, 1.0f));
+	} while (direction.GetLength() < 0.1f);
+	return direction.GetNormalized();
+}
+
+// Errors are relative to the largest value compared, so cancellation in one component does not read as a large error
+static float GetMaxError(float const* values, float const* expectedValues, int numValues)
+{
+	float largestValue = 1.0f;
+	float maxDifference = 0.0f;
+	for (int valueIndex = 0; valueIndex < numValues; valueIndex++) {
+		float magnitude = fabsf(expectedValues[valueIndex]);
+		float difference = fabsf(values[valueIndex] - expectedValues[valueIndex]);
+		if (magnitude > largestValue) largestValue = magnitude;
+		if (difference > maxDifference) maxDifference = difference;
+	}
+	return maxDifference / largestValue;
+}
+
+static float GetMaxError(Vec3 const& value, Vec3 const& expectedValue)
+{
+	float values[3] = { value.x, value.y, value.z };
+	float expectedValues[3] = { expectedValue.x, expectedValue.y, expectedValue.z };
+	return GetMaxError(values, expectedValues, 3);
+}
+
+static float GetMaxError(Mat44 const& value, Mat44 const& expectedValue)
+{
+	return GetMaxError(value.m_values, expectedValue.m_values, 16);
+}
+
+static bool CheckPositionTransforms(SIMDTransformTestConfig const& config, RandomNumberGenerator& rng, SIMDTransformTestResults& results)
+{
+	std::vector<Vertex_PCU> verts(config.m_numVerts);
+	for (Vertex_PCU& vert : verts) {
+		vert = Vertex_PCU(GetRandomPosition(rng), Rgba8((unsigned char)rng.GetRandomIntLessThan(256), (unsigned char)rng.GetRandomIntLessThan(256), (unsigned char)rng.GetRandomIntLessThan(256), (unsigned char)rng.GetRandomIntLessThan(256)), Vec2(rng.GetRandomFloatZeroUpToOne(), rng.GetRandomFloatZeroUpToOne()));
+	}
+
+	// TransformVertexArray3D
+	Mat44 transform = GetRandomAffineTransform(rng);
+	std::vector<Vertex_PCU> simdVerts = verts;
+	TransformVertexArray3D(config.m_numVerts, simdVerts.data(), transform);
+	for (int vertIndex = 0; vertIndex < config.m_numVerts; vertIndex++) {
+		Vertex_PCU expectedVert = verts[vertIndex];
+		TransformPosition3D(expectedVert.m_position, transform);
+		float error = GetMaxError(simdVerts[vertIndex].m_position, expectedVert.m_position);
+		if (error > results.m_maxPositionError) results.m_maxPositionError = error;
+
+		// The kernels write 12 bytes per vert; the color and UVs after them have to come through untouched
+		if (memcmp(&simdVerts[vertIndex].m_color, &expectedVert.m_color, sizeof(Vertex_PCU) - sizeof(Vec3)) != 0) {
+			results.m_error = Stringf("TransformVertexArray3D changed more than the position of vert %d", vertIndex);
+			return false;
+		}
+	}
+
+	// TransformVertexArrayXY3D
+	float uniformScale = rng.GetRandomFloatInRange(0.5f, 4.0f);
+	float rotationDegrees = rng.GetRandomFloatInRange(0.0f, 360.0f);
+	Vec2 translation = Vec2(rng.GetRandomFloatInRange(-50.0f, 50.0f), rng.GetRandomFloatInRange(-50.0f, 50.0f));
+	simdVerts = verts;
+	TransformVertexArrayXY3D(config.m_numVerts, simdVerts.data(), uniformScale, rotationDegrees, translation);
+	for (int vertIndex = 0; vertIndex < config.m_numVerts; vertIndex++) {
+		Vertex_PCU expectedVert = verts[vertIndex];
+		TransformPositionXY3D(expectedVert.m_position, uniformScale, rotationDegrees, translation);
+		float error = GetMaxError(simdVerts[vertIndex].m_position, expectedVert.m_position);
+		if (error > results.m_maxPositionError) results.m_maxPositionError = error;
+
+		if (memcmp(&simdVerts[vertIndex].m_color, &expectedVert.m_color, sizeof(Vertex_PCU) - sizeof(Vec3)) != 0) {
+			results.m_error = Stringf("TransformVertexArrayXY3D changed more than the position of vert %d", vertIndex);
+			return false;
+		}
+	}
+
+	if (results.m_maxPositionError > config.m_tolerance) {
+		results.m_error = Stringf("Transformed positions are off by up to %g", results.m_maxPositionError);
+		return false;
+	}
+	return true;
+}
+
+static bool CheckNormalTransforms(SIMDTransformTestConfig const& config, RandomNumberGenerator& rng, SIMDTransformTestResults& results)
+{
+	std::vector<Vertex_PNCU> verts(config.m_numVerts);
+	for (Vertex_PNCU& vert : verts) {
+		vert = Vertex_PNCU(GetRandomPosition(rng), GetRandomDirection(rng), Rgba8::WHITE, Vec2(rng.GetRandomFloatZeroUpToOne(), rng.GetRandomFloatZeroUpToOne()));
+	}
+
+	Mat44 transform = GetRandomAffineTransform(rng);
+	Mat44 normalTransform = GetScalarInverted(transform);
+	normalTransform.Transpose();
+
+	std::vector<Vertex_PNCU> simdVerts = verts;
+	TransformVertexArray3D(config.m_numVerts, simdVerts.data(), transform);
+	for (int vertIndex = 0; vertIndex < config.m_numVerts; vertIndex++) {
+		Vec3 expectedPosition = transform.TransformPosition3D(verts[vertIndex].m_position);
+		Vec3 expectedNormal = normalTransform.TransformVectorQuantity3D(verts[vertIndex].m_normal).GetNormalized();
+
+		float positionError = GetMaxError(simdVerts[vertIndex].m_position, expectedPosition);
+		float normalError = GetMaxError(simdVerts[vertIndex].m_normal, expectedNormal);
+		if (positionError > results.m_maxPositionError) results.m_maxPositionError = positionError;
+		if (normalError > results.m_maxNormalError) results.m_maxNormalError = normalError;
+	}
+
+	if (results.m_maxPositionError > config.m_tolerance) {
+		results.m_error = Stringf("Transformed PNCU positions are off by up to %g", results.m_maxPositionError);
+		return false;
+	}
+	if (results.m_maxNormalError > config.m_tolerance) {
+		results.m_error = Stringf("Transformed normals are off by up to %g", results.m_maxNormalError);
+		return false;
+	}
+	return true;
+}
+
+static bool CheckMatrices(SIMDTransformTestConfig const& config, RandomNumberGenerator& rng, SIMDTransformTestResults& results)
+{
+	// Half general 4x4s, half affine transforms; only the affine ones are inverted since random 4x4s can be near singular
+	std::vector<Mat44> matrices(config.m_numMatrices);
+	std::vector<Mat44> appendMatrices(config.m_numMatrices);
+	for (int matrixIndex = 0; matrixIndex < config.m_numMatrices; matrixIndex++) {
+		bool isGeneral = (matrixIndex % 2) == 0;
+		matrices[matrixIndex] = isGeneral ? GetRandomMatrix(rng) : GetRandomAffineTransform(rng);
+		appendMatrices[matrixIndex] = isGeneral ? GetRandomMatrix(rng) : GetRandomAffineTransform(rng);
+	}
+
+	for (int matrixIndex = 0; matrixIndex < config.m_numMatrices; matrixIndex++) {
+		Mat44 appended = matrices[matrixIndex];
+		appended.Append(appendMatrices[matrixIndex]);
+		float appendError = GetMaxError(appended, GetScalarAppended(matrices[matrixIndex], appendMatrices[matrixIndex]));
+		if (appendError > results.m_maxAppendError) results.m_maxAppendError = appendError;
+
+		if ((matrixIndex % 2) == 1) {
+			float inverseError = GetMaxError(matrices[matrixIndex].GetInverted(), GetScalarInverted(matrices[matrixIndex]));
+			if (inverseError > results.m_maxInverseError) results.m_maxInverseError = inverseError;
+		}
+	}
+
+	if (results.m_maxAppendError > config.m_tolerance) {
+		results.m_error = Stringf("Mat44::Append is off by up to %g", results.m_maxAppendError);
+		return false;
+	}
+	if (results.m_maxInverseError > config.m_tolerance) {
+		results.m_error = Stringf("Mat44::GetInverted is off by up to %g", results.m_maxInverseError);
+		return false;
+	}
+	return true;
+}
+
+static void RunSIMDTransformBenchmarks(SIMDTransformTestConfig const& config, RandomNumberGenerator& rng, SIMDTransformTestResults& results)
+{
+	int repeats = config.m_benchmarkRepeats;
+
+	// Rigid, so repeating it does not blow the positions up
+	Mat44 transform = Mat44::CreateTranslation3D(Vec3(1.0f, -2.0f, 3.0f));
+	transform = GetScalarAppended(transform, Mat44::CreateZRotationDegrees(rng.GetRandomFloatInRange(0.0f, 360.0f)));
+	std::vector<Vertex_PCU> verts(config.m_numVerts);
+	for (Vertex_PCU& vert : verts) {
+		vert.m_position = GetRandomPosition(rng);
+	}
+
+	double startTime = GetCurrentTimeSeconds();
+	for (int repeat = 0; repeat < repeats; repeat++) {
+		for (Vertex_PCU& vert : verts) {
+			TransformPosition3D(vert.m_position, transform);
+		}
+	}
+	results.m_scalarTransformMs = (GetCurrentTimeSeconds() - startTime) * 1000.0 / repeats;
+
+	startTime = GetCurrentTimeSeconds();
+	for (int repeat = 0; repeat < repeats; repeat++) {
+		TransformVertexArray3D(config.m_numVerts, verts.data(), transform);
+	}
+	results.m_simdTransformMs = (GetCurrentTimeSeconds() - startTime) * 1000.0 / repeats;
+
+	std::vector<Mat44> matrices(config.m_numMatrices);
+	std::vector<Mat44> outputs(config.m_numMatrices);
+	for (Mat44& matrix : matrices) {
+		matrix = GetRandomAffineTransform(rng);
+	}
+
+	startTime = GetCurrentTimeSeconds();
+	for (int repeat = 0; repeat < repeats; repeat++) {
+		for (int matrixIndex = 0; matrixIndex + 1 < config.m_numMatrices; matrixIndex++) {
+			outputs[matrixIndex] = GetScalarAppended(matrices[matrixIndex], matrices[matrixIndex + 1]);
+		}
+	}
+	results.m_scalarAppendMs = (GetCurrentTimeSeconds() - startTime) * 1000.0 / repeats;
+
+	startTime = GetCurrentTimeSeconds();
+	for (int repeat = 0; repeat < repeats; repeat++) {
+		for (int matrixIndex = 0; matrixIndex + 1 < config.m_numMatrices; matrixIndex++) {
+			outputs[matrixIndex] = matrices[matrixIndex];
+			outputs[matrixIndex].Append(matrices[matrixIndex + 1]);
+		}
+	}
+	results.m_simdAppendMs = (GetCurrentTimeSeconds() - startTime) * 1000.0 / repeats;
+
+	startTime = GetCurrentTimeSeconds();
+	for (int repeat = 0; repeat < repeats; repeat++) {
+		for (int matrixIndex = 0; matrixIndex < config.m_numMatrices; matrixIndex++) {
+			outputs[matrixIndex] = GetScalarInverted(matrices[matrixIndex]);
+		}
+	}
+	results.m_scalarInverseMs = (GetCurrentTimeSeconds() - startTime) * 1000.0 / repeats;
+
+	startTime = GetCurrentTimeSeconds();
+	for (int repeat = 0; repeat < repeats; repeat++) {
+		for (int matrixIndex = 0; matrixIndex < config.m_numMatrices; matrixIndex++) {
+			outputs[matrixIndex] = matrices[matrixIndex].GetInverted();
+		}
+	}
+	results.m_simdInverseMs = (GetCurrentTimeSeconds() - startTime) * 1000.0 / repeats;
+}
+
+SIMDTransformTestResults RunSIMDTransformTest(SIMDTransformTestConfig const& config)
+{
+	SIMDTransformTestResults results;
+	RandomNumberGenerator rng;
+
+	if (!CheckPositionTransforms(config, rng, results)) return results;
+	if (!CheckNormalTransforms(config, rng, results)) return results;
+	if (!CheckMatrices(config, rng, results)) return results;
+
+	RunSIMDTransformBenchmarks(config, rng, results);
+	results.m_succeeded = true;
+	return results;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+
+struct SIMDTransformTestConfig {
+	int m_numVerts = 100003;		// Not a multiple of 4, so the kernels' one-at-a-time tail runs too
+	int m_numMatrices = 4096;
+	int m_benchmarkRepeats = 20;
+	float m_tolerance = 0.0001f;	// Relative to the largest value compared
+};
+
+struct SIMDTransformTestResults {
+	bool m_succeeded = false;
+	std::string m_error;
+	float m_maxPositionError = 0.0f;
+	float m_maxNormalError = 0.0f;
+	float m_maxAppendError = 0.0f;
+	float m_maxInverseError = 0.0f;
+	double m_scalarTransformMs = 0.0;	// Per repeat, for all the verts
+	double m_simdTransformMs = 0.0;
+	double m_scalarAppendMs = 0.0;		// Per repeat, for all the matrices
+	double m_simdAppendMs = 0.0;
+	double m_scalarInverseMs = 0.0;
+	double m_simdInverseMs = 0.0;
+};
+
+// Checks the SSE batch vertex transforms and Mat44::Append/GetInverted against plain scalar versions of the same math
+// on random inputs, then times both. The scalar versions live in the test, so both sides run in the same build
+SIMDTransformTestResults RunSIMDTransformTest(SIMDTransformTestConfig const& config);
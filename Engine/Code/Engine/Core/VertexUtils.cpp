@@ -1,4 +1,5 @@
 #include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/OBB2.hpp"
 #include "Engine/Math/LineSegment2.hpp"
@@ -7,53 +8,370 @@
 #include "Engine/Math/Mat44.hpp"
 #include "Engine/Math/ConvexHull2D.hpp"
 #include "Engine/Math/ConvexPoly2D.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
 
-void TransformVertexArrayXY3D(int numVerts, Vertex_PCU* verts, float uniformScaleXY, float rotationDegreesAboutZ, Vec2 const& translationXY)
+//------------------------------------------------------------------------------------------------
+// Grows verts by vertexCount and returns where the new vertexes start. Capacity at least doubles when it runs out,
+// so a vector that is cleared and refilled every frame settles at its high-water mark and stops allocating
+template <typename T_VertexType>
+static T_VertexType* GrowVertexArray(std::vector<T_VertexType>& verts, int vertexCount)
+{
+	size_t startIndex = verts.size();
+	size_t newSize = startIndex + static_cast<size_t>(vertexCount);
+	if (newSize > verts.capacity()) {
+		verts.reserve((newSize > verts.capacity() * 2) ? newSize : verts.capacity() * 2);
+	}
+	verts.resize(newSize);
+	return verts.data() + startIndex;
+}
+
+template <typename T_ElementType>
+static void ReserveAdditional(std::vector<T_ElementType>& elements, int additionalCount)
 {
-	for (int vertIndex = 0; vertIndex < numVerts; vertIndex++) {
-		Vertex_PCU& vertex = verts[vertIndex];
-		TransformPositionXY3D(vertex.m_position, uniformScaleXY, rotationDegreesAboutZ, translationXY);
+	size_t newSize = elements.size() + static_cast<size_t>(additionalCount);
+	if (newSize > elements.capacity()) {
+		elements.reserve((newSize > elements.capacity() * 2) ? newSize : elements.capacity() * 2);
 	}
 }
 
+static void AddIndexesForQuad(std::vector<unsigned int>& indices, unsigned int bottomLeft, unsigned int bottomRight, unsigned int topRight, unsigned int topLeft)
+{
+	indices.push_back(bottomLeft);
+	indices.push_back(bottomRight);
+	indices.push_back(topRight);
+
+	indices.push_back(bottomLeft);
+	indices.push_back(topRight);
+	indices.push_back(topLeft);
+}
+
+// Unit i and j perpendicular to kBasis, falling back to world j when kBasis is (anti)parallel to world i
+static void GetPerpendicularBases(Vec3 const& kBasis, Vec3& iBasis, Vec3& jBasis)
+{
+	Vec3 worldIBasis = Vec3(1.0, 0.0f, 0.0f);
+	Vec3 worldJBasis = Vec3(0.0f, 1.0, 0.0f);
+
+	if (fabsf(DotProduct3D(kBasis, worldIBasis)) < 1.0f) {
+		jBasis = CrossProduct3D(kBasis, worldIBasis).GetNormalized();
+		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
+	}
+	else {
+		jBasis = CrossProduct3D(kBasis, worldJBasis).GetNormalized();
+		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
+	}
+}
+
+void TransformVertexArrayXY3D(int numVerts, Vertex_PCU* verts, float uniformScaleXY, float rotationDegreesAboutZ, Vec2 const& translationXY)
+{
+	Vec2 iBasis = Vec2(CosDegrees(rotationDegreesAboutZ), SinDegrees(rotationDegreesAboutZ)) * uniformScaleXY;
+	Vec2 jBasis = iBasis.GetRotated90Degrees();
+	TransformVertexArrayXY3D(numVerts, verts, iBasis, jBasis, translationXY);
+}
+
 void TransformVertexArrayXY3D(int numVerts, Vertex_PCU* verts, Vec2 const& iBasis, Vec2 const& jBasis, Vec2 const& translationXY)
 {
-	for (int vertIndex = 0; vertIndex < numVerts; vertIndex++) {
-		Vertex_PCU& vertex = verts[vertIndex];
-		TransformPositionXY3D(vertex.m_position, iBasis, jBasis, translationXY);
+	if (numVerts <= 0) return;
+	Mat44 transform(iBasis, jBasis, translationXY);
+	TransformPositionsStrided3D(numVerts, &verts[0].m_position.x, sizeof(Vertex_PCU), transform);
+}
+
+void TransformPositionsStrided3D(int numPositions, float* firstPosition, size_t strideInBytes, Mat44 const& transform)
+{
+	__m128 iBasis = _mm_loadu_ps(&transform.m_values[Mat44::Ix]);
+	__m128 jBasis = _mm_loadu_ps(&transform.m_values[Mat44::Jx]);
+	__m128 kBasis = _mm_loadu_ps(&transform.m_values[Mat44::Kx]);
+	__m128 translation = _mm_loadu_ps(&transform.m_values[Mat44::Tx]);
+
+	unsigned char* positionBytes = reinterpret_cast<unsigned char*>(firstPosition);
+	int positionIndex = 0;
+
+	// Four independent positions per iteration so the multiply-adds overlap instead of waiting on each other
+	for (; positionIndex + 4 <= numPositions; positionIndex += 4) {
+		float* positionA = reinterpret_cast<float*>(positionBytes + (strideInBytes * (positionIndex + 0)));
+		float* positionB = reinterpret_cast<float*>(positionBytes + (strideInBytes * (positionIndex + 1)));
+		float* positionC = reinterpret_cast<float*>(positionBytes + (strideInBytes * (positionIndex + 2)));
+		float* positionD = reinterpret_cast<float*>(positionBytes + (strideInBytes * (positionIndex + 3)));
+
+		__m128 resultA = SIMDTransformPosition(SIMDLoadFloat3(positionA), iBasis, jBasis, kBasis, translation);
+		__m128 resultB = SIMDTransformPosition(SIMDLoadFloat3(positionB), iBasis, jBasis, kBasis, translation);
+		__m128 resultC = SIMDTransformPosition(SIMDLoadFloat3(positionC), iBasis, jBasis, kBasis, translation);
+		__m128 resultD = SIMDTransformPosition(SIMDLoadFloat3(positionD), iBasis, jBasis, kBasis, translation);
+
+		SIMDStoreFloat3(positionA, resultA);
+		SIMDStoreFloat3(positionB, resultB);
+		SIMDStoreFloat3(positionC, resultC);
+		SIMDStoreFloat3(positionD, resultD);
+	}
+
+	for (; positionIndex < numPositions; positionIndex++) {
+		float* position = reinterpret_cast<float*>(positionBytes + (strideInBytes * positionIndex));
+		SIMDStoreFloat3(position, SIMDTransformPosition(SIMDLoadFloat3(position), iBasis, jBasis, kBasis, translation));
 	}
 }
 
-void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& tint, AABB2 UVs)
+void TransformNormalsStrided3D(int numNormals, float* firstNormal, size_t strideInBytes, Mat44 const& transform)
+{
+	// Normals go through the inverse transpose so they stay perpendicular under non-uniform scale
+	Mat44 normalTransform = transform.GetInverted();
+	normalTransform.Transpose();
+
+	__m128 iBasis = _mm_loadu_ps(&normalTransform.m_values[Mat44::Ix]);
+	__m128 jBasis = _mm_loadu_ps(&normalTransform.m_values[Mat44::Jx]);
+	__m128 kBasis = _mm_loadu_ps(&normalTransform.m_values[Mat44::Kx]);
+	__m128 const zero = _mm_setzero_ps();
+
+	unsigned char* normalBytes = reinterpret_cast<unsigned char*>(firstNormal);
+	for (int normalIndex = 0; normalIndex < numNormals; normalIndex++) {
+		float* normal = reinterpret_cast<float*>(normalBytes + (strideInBytes * normalIndex));
+		__m128 result = SIMDTransformVector(SIMDLoadFloat3(normal), iBasis, jBasis, kBasis);
+		result = _mm_and_ps(result, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+
+		__m128 lengthSquared = SIMDHorizontalAdd(_mm_mul_ps(result, result));
+		__m128 normalized = _mm_div_ps(result, _mm_sqrt_ps(lengthSquared));
+		// Degenerate normals stay zero instead of turning into NaNs
+		result = _mm_and_ps(normalized, _mm_cmpgt_ps(lengthSquared, zero));
+		SIMDStoreFloat3(normal, result);
+	}
+}
+
+
+//------------------------------------------------------------------------------------------------
+// Vertex counts
+int GetVertCountForAABB2D()
+{
+	return 6;
+}
+
+int GetVertCountForHollowAABB2D()
 {
-	verts.emplace_back(Vec3(bounds.m_mins.x, bounds.m_mins.y, 0.0f), tint, Vec2(UVs.m_mins.x, UVs.m_mins.y));
-	verts.emplace_back(Vec3(bounds.m_maxs.x, bounds.m_mins.y, 0.0f), tint, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
-	verts.emplace_back(Vec3(bounds.m_maxs.x, bounds.m_maxs.y, 0.0f), tint, Vec2(UVs.m_maxs.x, UVs.m_maxs.y));
+	return 24;
+}
 
-	verts.emplace_back(Vec3(bounds.m_mins.x, bounds.m_mins.y, 0.0f), tint, Vec2(UVs.m_mins.x, UVs.m_mins.y));
-	verts.emplace_back(Vec3(bounds.m_maxs.x, bounds.m_maxs.y, 0.0f), tint, Vec2(UVs.m_maxs.x, UVs.m_maxs.y));
-	verts.emplace_back(Vec3(bounds.m_mins.x, bounds.m_maxs.y, 0.0f), tint, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+int GetVertCountForOBB2D()
+{
+	return 6;
+}
+
+int GetVertCountForDisc2D(int sectionsAmount)
+{
+	return 3 * sectionsAmount;
+}
+
+int GetVertCountForLineSegment2D()
+{
+	return 6;
+}
+
+int GetVertCountForCapsule2D(int amountSectorsCapsEnds)
+{
+	return 6 + (6 * amountSectorsCapsEnds);
+}
+
+int GetVertCountForArrow2D()
+{
+	return GetVertCountForLineSegment2D() + 3;
+}
+
+int GetVertCountForDelaunayConvexPoly2D(DelaunayConvexPoly2D const& convexPoly)
+{
+	int pointCount = (int)convexPoly.m_vertexes.size();
+	return (pointCount > 1) ? 3 * pointCount : 0;
+}
+
+int GetVertCountForWireDelaunayConvexPoly2D(DelaunayConvexPoly2D const& convexPoly)
+{
+	return GetVertCountForLineSegment2D() * (int)convexPoly.m_vertexes.size();
+}
+
+int GetVertCountForConvexPoly2D(ConvexPoly2D const& convexPoly)
+{
+	return 3 * (int)convexPoly.m_ccwPoints.size();
+}
+
+int GetVertCountForWireConvexPoly2D(ConvexPoly2D const& convexPoly)
+{
+	return GetVertCountForLineSegment2D() * (int)convexPoly.m_ccwPoints.size();
+}
+
+int GetVertCountForConvexHull2D(ConvexHull2D const& convexHull)
+{
+	return GetVertCountForLineSegment2D() * (int)convexHull.m_planes.size();
+}
+
+int GetVertCountForQuad3D()
+{
+	return 6;
+}
+
+int GetVertCountForRoundedQuad3D()
+{
+	return 12;
+}
+
+int GetVertCountForLineSegment3D()
+{
+	return 6 * GetVertCountForQuad3D();
+}
+
+int GetVertCountForAABB3D()
+{
+	return 6 * GetVertCountForQuad3D();
+}
+
+int GetVertCountForWireAABB3D()
+{
+	return 12 * GetVertCountForLineSegment3D();
+}
+
+int GetVertCountForSphere(int stacks, int slices)
+{
+	return 6 * stacks * slices;
+}
+
+int GetVertCountForWireSphere(int stacks, int slices)
+{
+	return 3 * stacks * slices * GetVertCountForLineSegment3D();
+}
+
+int GetVertCountForCylinder(int slices)
+{
+	return 12 * slices;
+}
+
+int GetVertCountForWireCylinder(int slices)
+{
+	return 3 * slices * GetVertCountForLineSegment3D();
+}
+
+int GetVertCountForCone3D(int slices)
+{
+	return 6 * slices;
+}
+
+int GetVertCountForWireCone3D(int slices)
+{
+	return 3 * slices * GetVertCountForLineSegment3D();
+}
+
+int GetVertCountForArrow3D(int slices)
+{
+	return GetVertCountForCylinder(slices) + GetVertCountForCone3D(slices);
+}
+
+int GetVertCountForBasis3D()
+{
+	return 3 * GetVertCountForLineSegment3D();
 }
 
 //------------------------------------------------------------------------------------------------
-void AddVertsForAABB2D(std::vector<Vertex_PCU>& mesh, const AABB2& bounds, const Rgba8& tint, const Vec2& uvAtMins, const Vec2& uvAtMaxs)
+// Index counts. Vertex counts for the indexed shapes are the unique vertexes only
+int GetVertCountForIndexedQuad3D()
+{
+	return 4;
+}
+
+int GetIndexCountForIndexedQuad3D()
+{
+	return 6;
+}
+
+int GetVertCountForIndexedAABB3D()
+{
+	return 6 * GetVertCountForIndexedQuad3D();
+}
+
+int GetIndexCountForIndexedAABB3D()
+{
+	return 6 * GetIndexCountForIndexedQuad3D();
+}
+
+int GetVertCountForIndexedLineSegment3D()
+{
+	return GetVertCountForIndexedAABB3D();
+}
+
+int GetIndexCountForIndexedLineSegment3D()
+{
+	return GetIndexCountForIndexedAABB3D();
+}
+
+int GetVertCountForIndexedSphere(int stacks, int slices)
+{
+	return (stacks + 1) * (slices + 1);
+}
+
+int GetIndexCountForIndexedSphere(int stacks, int slices)
+{
+	return 6 * stacks * slices;
+}
+
+int GetVertCountForIndexedCylinder(int slices)
+{
+	// Side ring pair plus a center and ring per cap. The caps map UVs differently, so they cannot share the side vertexes
+	return (2 * (slices + 1)) + (2 * (slices + 2));
+}
+
+int GetIndexCountForIndexedCylinder(int slices)
+{
+	return 12 * slices;
+}
+
+int GetVertCountForIndexedCone3D(int slices)
+{
+	// The tip takes the U of each slice, so every slice gets its own tip vertex
+	return (slices + 1) + slices + (slices + 2);
+}
+
+int GetIndexCountForIndexedCone3D(int slices)
+{
+	return 6 * slices;
+}
+
+int GetVertCountForIndexedArrow3D(int slices)
+{
+	return GetVertCountForIndexedCylinder(slices) + GetVertCountForIndexedCone3D(slices);
+}
+
+int GetIndexCountForIndexedArrow3D(int slices)
+{
+	return GetIndexCountForIndexedCylinder(slices) + GetIndexCountForIndexedCone3D(slices);
+}
+
+//------------------------------------------------------------------------------------------------
+// 2D
+Vertex_PCU* AddVertsForAABB2D(Vertex_PCU* verts, AABB2 const& bounds, Rgba8 const& tint, AABB2 UVs)
+{
+	return AddVertsForAABB2D(verts, bounds, tint, UVs.m_mins, UVs.m_maxs);
+}
+
+Vertex_PCU* AddVertsForAABB2D(Vertex_PCU* verts, AABB2 const& bounds, Rgba8 const& tint, const Vec2& uvAtMins, const Vec2& uvAtMaxs)
 {
 	Vec3 pos0(bounds.m_mins.x, bounds.m_mins.y, 0.f);
 	Vec3 pos1(bounds.m_maxs.x, bounds.m_mins.y, 0.f);
 	Vec3 pos2(bounds.m_maxs.x, bounds.m_maxs.y, 0.f);
 	Vec3 pos3(bounds.m_mins.x, bounds.m_maxs.y, 0.f);
 
-	mesh.emplace_back(pos0, tint, Vec2(uvAtMins.x, uvAtMins.y));
-	mesh.emplace_back(pos1, tint, Vec2(uvAtMaxs.x, uvAtMins.y));
-	mesh.emplace_back(pos2, tint, Vec2(uvAtMaxs.x, uvAtMaxs.y));
+	*verts++ = Vertex_PCU(pos0, tint, Vec2(uvAtMins.x, uvAtMins.y));
+	*verts++ = Vertex_PCU(pos1, tint, Vec2(uvAtMaxs.x, uvAtMins.y));
+	*verts++ = Vertex_PCU(pos2, tint, Vec2(uvAtMaxs.x, uvAtMaxs.y));
 
-	mesh.emplace_back(pos0, tint, Vec2(uvAtMins.x, uvAtMins.y));
-	mesh.emplace_back(pos2, tint, Vec2(uvAtMaxs.x, uvAtMaxs.y));
-	mesh.emplace_back(pos3, tint, Vec2(uvAtMins.x, uvAtMaxs.y));
+	*verts++ = Vertex_PCU(pos0, tint, Vec2(uvAtMins.x, uvAtMins.y));
+	*verts++ = Vertex_PCU(pos2, tint, Vec2(uvAtMaxs.x, uvAtMaxs.y));
+	*verts++ = Vertex_PCU(pos3, tint, Vec2(uvAtMins.x, uvAtMaxs.y));
+	return verts;
 }
 
+void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& tint, AABB2 UVs)
+{
+	AddVertsForAABB2D(GrowVertexArray(verts, GetVertCountForAABB2D()), bounds, tint, UVs);
+}
 
-void AddVertsForHollowAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& bounds, float radius, Rgba8 const& tint)
+void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& tint, const Vec2& uvAtMins, const Vec2& uvAtMaxs)
+{
+	AddVertsForAABB2D(GrowVertexArray(verts, GetVertCountForAABB2D()), bounds, tint, uvAtMins, uvAtMaxs);
+}
+
+Vertex_PCU* AddVertsForHollowAABB2D(Vertex_PCU* verts, AABB2 const& bounds, float radius, Rgba8 const& tint)
 {
 	float halfRadius = radius * 0.5f;
 
@@ -68,123 +386,128 @@ void AddVertsForHollowAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& bounds
 	Vec3 outerLeftTop(bounds.m_mins.x - halfRadius, bounds.m_maxs.y + halfRadius, 0.f);
 
 	// Left frame Side
-	verts.emplace_back(outerLeftBottom, tint, Vec2::ZERO);
-	verts.emplace_back(innerLeftBottom, tint, Vec2::ZERO);
-	verts.emplace_back(innerLeftTop, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(outerLeftBottom, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(innerLeftBottom, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(innerLeftTop, tint, Vec2::ZERO);
 
-	verts.emplace_back(outerLeftBottom, tint, Vec2::ZERO);
-	verts.emplace_back(innerLeftTop, tint, Vec2::ZERO);
-	verts.emplace_back(outerLeftTop, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(outerLeftBottom, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(innerLeftTop, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(outerLeftTop, tint, Vec2::ZERO);
 
 	// Right Frame Side
-	verts.emplace_back(outerRightBottom, tint, Vec2::ZERO);
-	verts.emplace_back(innerRightBottom, tint, Vec2::ZERO);
-	verts.emplace_back(innerRightTop, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(outerRightBottom, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(innerRightBottom, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(innerRightTop, tint, Vec2::ZERO);
 
-	verts.emplace_back(outerRightBottom, tint, Vec2::ZERO);
-	verts.emplace_back(innerRightTop, tint, Vec2::ZERO);
-	verts.emplace_back(outerRightTop, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(outerRightBottom, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(innerRightTop, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(outerRightTop, tint, Vec2::ZERO);
 
 	// Top Frame Side
-	verts.emplace_back(innerLeftTop, tint, Vec2::ZERO);
-	verts.emplace_back(outerRightTop, tint, Vec2::ZERO);
-	verts.emplace_back(outerLeftTop, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(innerLeftTop, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(outerRightTop, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(outerLeftTop, tint, Vec2::ZERO);
 
-	verts.emplace_back(innerLeftTop, tint, Vec2::ZERO);
-	verts.emplace_back(innerRightTop, tint, Vec2::ZERO);
-	verts.emplace_back(outerRightTop, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(innerLeftTop, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(innerRightTop, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(outerRightTop, tint, Vec2::ZERO);
 
 	// Bottom Frame Side
-	verts.emplace_back(innerLeftBottom, tint, Vec2::ZERO);
-	verts.emplace_back(outerRightBottom, tint, Vec2::ZERO);
-	verts.emplace_back(outerLeftBottom, tint, Vec2::ZERO);
-
-	verts.emplace_back(innerLeftBottom, tint, Vec2::ZERO);
-	verts.emplace_back(innerRightBottom, tint, Vec2::ZERO);
-	verts.emplace_back(outerRightBottom, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(innerLeftBottom, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(outerRightBottom, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(outerLeftBottom, tint, Vec2::ZERO);
+
+	*verts++ = Vertex_PCU(innerLeftBottom, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(innerRightBottom, tint, Vec2::ZERO);
+	*verts++ = Vertex_PCU(outerRightBottom, tint, Vec2::ZERO);
+	return verts;
 }
 
-
-void AddVertsForOBB2D(std::vector<Vertex_PCU>& verts, OBB2 const& bounds, Rgba8 const& tint, const Vec2& uvAtMins, const Vec2& uvAtMaxs)
+void AddVertsForHollowAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& bounds, float radius, Rgba8 const& tint)
 {
-	Vec2* cornerPoints = bounds.GetCornerPoints();
-
-	Vec2& bottomLeftCorner = cornerPoints[0];
-	Vec2& bottomRightCorner = cornerPoints[1];
-	Vec2& topRightCorner = cornerPoints[2];
-	Vec2& topLeftCorner = cornerPoints[3];
+	AddVertsForHollowAABB2D(GrowVertexArray(verts, GetVertCountForHollowAABB2D()), bounds, radius, tint);
+}
 
-	verts.emplace_back(Vec3(bottomLeftCorner.x, bottomLeftCorner.y, 0.0f), tint, uvAtMins);
-	verts.emplace_back(Vec3(bottomRightCorner.x, bottomRightCorner.y, 0.0f), tint, Vec2(uvAtMaxs.x, uvAtMins.y));
-	verts.emplace_back(Vec3(topRightCorner.x, topRightCorner.y, 0.0f), tint, uvAtMaxs);
+Vertex_PCU* AddVertsForOBB2D(Vertex_PCU* verts, OBB2 const& bounds, Rgba8 const& tint, const Vec2& uvAtMins, const Vec2& uvAtMaxs)
+{
+	Vec2 cornerPoints[4];
+	Vec2* cornerPointsPtr = cornerPoints;
+	bounds.GetCornerPoints(cornerPointsPtr);
+
+	Vec2 const& bottomLeftCorner = cornerPoints[0];
+	Vec2 const& bottomRightCorner = cornerPoints[1];
+	Vec2 const& topRightCorner = cornerPoints[2];
+	Vec2 const& topLeftCorner = cornerPoints[3];
+
+	*verts++ = Vertex_PCU(Vec3(bottomLeftCorner.x, bottomLeftCorner.y, 0.0f), tint, uvAtMins);
+	*verts++ = Vertex_PCU(Vec3(bottomRightCorner.x, bottomRightCorner.y, 0.0f), tint, Vec2(uvAtMaxs.x, uvAtMins.y));
+	*verts++ = Vertex_PCU(Vec3(topRightCorner.x, topRightCorner.y, 0.0f), tint, uvAtMaxs);
+
+	*verts++ = Vertex_PCU(Vec3(bottomLeftCorner.x, bottomLeftCorner.y, 0.0f), tint, uvAtMins);
+	*verts++ = Vertex_PCU(Vec3(topRightCorner.x, topRightCorner.y, 0.0f), tint, uvAtMaxs);
+	*verts++ = Vertex_PCU(Vec3(topLeftCorner.x, topLeftCorner.y, 0.0f), tint, Vec2(uvAtMins.x, uvAtMaxs.y));
+	return verts;
+}
 
-	verts.emplace_back(Vec3(bottomLeftCorner.x, bottomLeftCorner.y, 0.0f), tint, uvAtMins);
-	verts.emplace_back(Vec3(topRightCorner.x, topRightCorner.y, 0.0f), tint, uvAtMaxs);
-	verts.emplace_back(Vec3(topLeftCorner.x, topLeftCorner.y, 0.0f), tint, Vec2(uvAtMins.x, uvAtMaxs.y));
+Vertex_PCU* AddVertsForOBB2D(Vertex_PCU* verts, OBB2 const& bounds, Rgba8 const& tint, AABB2 UVs)
+{
+	return AddVertsForOBB2D(verts, bounds, tint, UVs.m_mins, UVs.m_maxs);
+}
 
-	delete[] cornerPoints;
+void AddVertsForOBB2D(std::vector<Vertex_PCU>& verts, OBB2 const& bounds, Rgba8 const& tint, const Vec2& uvAtMins, const Vec2& uvAtMaxs)
+{
+	AddVertsForOBB2D(GrowVertexArray(verts, GetVertCountForOBB2D()), bounds, tint, uvAtMins, uvAtMaxs);
 }
 
 void AddVertsForOBB2D(std::vector<Vertex_PCU>& verts, OBB2 const& bounds, Rgba8 const& tint, AABB2 UVs)
 {
-	Vec2* cornerPoints = bounds.GetCornerPoints();
-
-	Vec2& bottomLeftCorner = cornerPoints[0];
-	Vec2& bottomRightCorner = cornerPoints[1];
-	Vec2& topRightCorner = cornerPoints[2];
-	Vec2& topLeftCorner = cornerPoints[3];
-
-	verts.emplace_back(Vec3(bottomLeftCorner.x, bottomLeftCorner.y, 0.0f), tint, UVs.m_mins);
-	verts.emplace_back(Vec3(bottomRightCorner.x, bottomRightCorner.y, 0.0f), tint, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
-	verts.emplace_back(Vec3(topRightCorner.x, topRightCorner.y, 0.0f), tint, UVs.m_maxs);
-
-	verts.emplace_back(Vec3(bottomLeftCorner.x, bottomLeftCorner.y, 0.0f), tint, UVs.m_mins);
-	verts.emplace_back(Vec3(topRightCorner.x, topRightCorner.y, 0.0f), tint, UVs.m_maxs);
-	verts.emplace_back(Vec3(topLeftCorner.x, topLeftCorner.y, 0.0f), tint, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
-
-	delete[] cornerPoints;
+	AddVertsForOBB2D(GrowVertexArray(verts, GetVertCountForOBB2D()), bounds, tint, UVs.m_mins, UVs.m_maxs);
 }
 
-
-void AddVertsForDisc2D(std::vector<Vertex_PCU>& verts, Vec2 const& discCenter, float radius, Rgba8 tint, int sectionsAmount)
+Vertex_PCU* AddVertsForDisc2D(Vertex_PCU* verts, Vec2 const& discCenter, float radius, Rgba8 tint, int sectionsAmount)
 {
-
 	float deltaAngle = 360.0f / static_cast<float>(sectionsAmount);
 
 	float prevAngleCos = CosDegrees(0);
 	float prevAngleSin = SinDegrees(0);
 
-	for (float angle = deltaAngle; angle <= 360.0f; angle += deltaAngle) {
+	Vec2 halfUVs(0.5f, 0.5f);
+	Vec3 worldBottom(discCenter.x, discCenter.y, 0);
+
+	for (int sectionIndex = 1; sectionIndex <= sectionsAmount; sectionIndex++) {
+		float angle = deltaAngle * static_cast<float>(sectionIndex);
 		float currentAngleCos = CosDegrees(angle);
 		float currentAngleSin = SinDegrees(angle);
 
 		Vec2 localTop(prevAngleCos, prevAngleSin);
-		Vec2 halfUVs(0.5f, 0.5f);
 		localTop *= radius;
 
 		Vec2 localLeftTop(currentAngleCos, currentAngleSin);
-
 		localLeftTop *= radius;
 
-		Vec3 worldBottom(discCenter.x, discCenter.y, 0);
 		Vec3 worldTop(localTop.x + discCenter.x, localTop.y + discCenter.y, 0);
 		Vec3 worldLeftTop(localLeftTop.x + discCenter.x, localLeftTop.y + discCenter.y, 0);
 
-		verts.emplace_back(worldBottom, tint, halfUVs);
-		verts.emplace_back(worldTop, tint, halfUVs);
-		verts.emplace_back(worldLeftTop, tint, localTop * 0.5f);
+		*verts++ = Vertex_PCU(worldBottom, tint, halfUVs);
+		*verts++ = Vertex_PCU(worldTop, tint, halfUVs);
+		*verts++ = Vertex_PCU(worldLeftTop, tint, localTop * 0.5f);
 
 		prevAngleCos = currentAngleCos;
 		prevAngleSin = currentAngleSin;
 	}
+	return verts;
 }
 
-void AddVertsForLineSegment2D(std::vector<Vertex_PCU>& verts, LineSegment2 const& lineSegment, Rgba8 tint, float lineWidth, bool overhead)
+void AddVertsForDisc2D(std::vector<Vertex_PCU>& verts, Vec2 const& discCenter, float radius, Rgba8 tint, int sectionsAmount)
+{
+	AddVertsForDisc2D(GrowVertexArray(verts, GetVertCountForDisc2D(sectionsAmount)), discCenter, radius, tint, sectionsAmount);
+}
+
+Vertex_PCU* AddVertsForLineSegment2D(Vertex_PCU* verts, LineSegment2 const& lineSegment, Rgba8 tint, float lineWidth, bool overhead)
 {
 	Vec2 lineDir = (lineSegment.m_end - lineSegment.m_start).GetNormalized();
 	lineDir *= lineWidth * 0.5f;
 
-
 	Vec2 lineLeftDir = lineDir.GetRotated90Degrees();
 	lineLeftDir *= lineWidth * 0.5f;
 
@@ -196,18 +519,43 @@ void AddVertsForLineSegment2D(std::vector<Vertex_PCU>& verts, LineSegment2 const
 	Vec2 lineTopLeft = lineSegment.m_end + lineDir + lineLeftDir;
 	Vec2 lineTopRight = lineSegment.m_end + lineDir - lineLeftDir;
 
+	*verts++ = Vertex_PCU(Vec3(lineBottomLeft.x, lineBottomLeft.y, 0.0f), tint, Vec2());
+	*verts++ = Vertex_PCU(Vec3(lineTopRight.x, lineTopRight.y, 0.0f), tint, Vec2());
+	*verts++ = Vertex_PCU(Vec3(lineTopLeft.x, lineTopLeft.y, 0.0f), tint, Vec2());
+
+	*verts++ = Vertex_PCU(Vec3(lineBottomLeft.x, lineBottomLeft.y, 0.0f), tint, Vec2());
+	*verts++ = Vertex_PCU(Vec3(lineBottomRight.x, lineBottomRight.y, 0.0f), tint, Vec2());
+	*verts++ = Vertex_PCU(Vec3(lineTopRight.x, lineTopRight.y, 0.0f), tint, Vec2());
+	return verts;
+}
+
+void AddVertsForLineSegment2D(std::vector<Vertex_PCU>& verts, LineSegment2 const& lineSegment, Rgba8 tint, float lineWidth, bool overhead)
+{
+	AddVertsForLineSegment2D(GrowVertexArray(verts, GetVertCountForLineSegment2D()), lineSegment, tint, lineWidth, overhead);
+}
 
-	verts.emplace_back(Vec3(lineBottomLeft.x, lineBottomLeft.y, 0.0f), tint, Vec2());
-	verts.emplace_back(Vec3(lineTopRight.x, lineTopRight.y, 0.0f), tint, Vec2());
-	verts.emplace_back(Vec3(lineTopLeft.x, lineTopLeft.y, 0.0f), tint, Vec2());
+// Half disc swept counter clockwise from startingOrientation
+static Vertex_PCU* AddVertsForCapsuleEnd2D(Vertex_PCU* verts, Vec2 const& center, float radius, float startingOrientation, Rgba8 tint, int amountOfTriangles)
+{
+	float deltaDeg = 180.0f / static_cast<float>(amountOfTriangles);
+	float endingOrientation = startingOrientation + 180.0f;
+	Vec3 worldCenter(center);
+
+	for (int sectorIndex = 0; sectorIndex < amountOfTriangles; sectorIndex++) {
+		float currentOrientation = startingOrientation + deltaDeg * static_cast<float>(sectorIndex);
+		float nextOrientation = (sectorIndex == amountOfTriangles - 1) ? endingOrientation : startingOrientation + deltaDeg * static_cast<float>(sectorIndex + 1);
 
-	verts.emplace_back(Vec3(lineBottomLeft.x, lineBottomLeft.y, 0.0f), tint, Vec2());
-	verts.emplace_back(Vec3(lineBottomRight.x, lineBottomRight.y, 0.0f), tint, Vec2());
-	verts.emplace_back(Vec3(lineTopRight.x, lineTopRight.y, 0.0f), tint, Vec2());
+		Vec2 topSector = Vec2(CosDegrees(currentOrientation), SinDegrees(currentOrientation)) * radius + center;
+		Vec2 topLeftSector = Vec2(CosDegrees(nextOrientation), SinDegrees(nextOrientation)) * radius + center;
 
+		*verts++ = Vertex_PCU(worldCenter, tint, Vec2());
+		*verts++ = Vertex_PCU(Vec3(topSector), tint, Vec2());
+		*verts++ = Vertex_PCU(Vec3(topLeftSector), tint, Vec2());
+	}
+	return verts;
 }
 
-void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Capsule2 const& capsule, Rgba8 tint, int amountOfTriangles)
+Vertex_PCU* AddVertsForCapsule2D(Vertex_PCU* verts, Capsule2 const& capsule, Rgba8 tint, int amountOfTriangles)
 {
 	Vec2 lineLeftDir = (capsule.m_bone.m_end - capsule.m_bone.m_start).GetRotated90Degrees();
 	lineLeftDir.SetLength(capsule.m_radius);
@@ -218,95 +566,28 @@ void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Capsule2 const& capsul
 	Vec2 capsTopLeft = capsule.m_bone.m_end + lineLeftDir;
 	Vec2 capsTopRight = capsule.m_bone.m_end - lineLeftDir;
 
-	verts.emplace_back(Vec3(capsBottomLeft), tint, Vec2());
-	verts.emplace_back(Vec3(capsBottomRight), tint, Vec2());
-	verts.emplace_back(Vec3(capsTopRight), tint, Vec2());
+	*verts++ = Vertex_PCU(Vec3(capsBottomLeft), tint, Vec2());
+	*verts++ = Vertex_PCU(Vec3(capsBottomRight), tint, Vec2());
+	*verts++ = Vertex_PCU(Vec3(capsTopRight), tint, Vec2());
 
-	verts.emplace_back(Vec3(capsBottomLeft), tint, Vec2());
-	verts.emplace_back(Vec3(capsTopRight), tint, Vec2());
-	verts.emplace_back(Vec3(capsTopLeft), tint, Vec2());
-
-	float deltaDeg = 180.0f / amountOfTriangles;
+	*verts++ = Vertex_PCU(Vec3(capsBottomLeft), tint, Vec2());
+	*verts++ = Vertex_PCU(Vec3(capsTopRight), tint, Vec2());
+	*verts++ = Vertex_PCU(Vec3(capsTopLeft), tint, Vec2());
 
 	float startingOrientation = lineLeftDir.GetOrientationDegrees();
 	float endingOrientation = startingOrientation + 180.0f;
-	for (int sectorIndex = 0; sectorIndex < amountOfTriangles; sectorIndex++) {
-		float cosCurrentSector = CosDegrees(startingOrientation + deltaDeg * static_cast<float>(sectorIndex));
-		float sinCurrentSector = SinDegrees(startingOrientation + deltaDeg * static_cast<float>(sectorIndex));
-
-		float cosNextSector = 0.0f;
-		float sinNextSector = 0.0f;
-
-		if (sectorIndex == amountOfTriangles - 1) {
-			cosNextSector = CosDegrees(endingOrientation);
-			sinNextSector = SinDegrees(endingOrientation);
-		}
-		else {
-			cosNextSector = CosDegrees(startingOrientation + deltaDeg * static_cast<float>(sectorIndex + 1));
-			sinNextSector = SinDegrees(startingOrientation + deltaDeg * static_cast<float>(sectorIndex + 1));
-		}
-
-
-		Vec2 topSector(cosCurrentSector, sinCurrentSector);
-		Vec2 topLeftSector(cosNextSector, sinNextSector);
-
-		topLeftSector *= capsule.m_radius;
-		topSector *= capsule.m_radius;
-
-		topLeftSector += capsule.m_bone.m_start;
-		topSector += capsule.m_bone.m_start;
-
-		Vec3 worldTopSector(topSector);
-		Vec3 worldTopLeftSector(topLeftSector);
-		Vec3 capsuleVec3Start(capsule.m_bone.m_start);
-
-		verts.emplace_back(capsuleVec3Start, tint, Vec2());
-		verts.emplace_back(worldTopSector, tint, Vec2());
-		verts.emplace_back(worldTopLeftSector, tint, Vec2());
-	}
-
-	float tempStartOrientation = startingOrientation;
-	startingOrientation = endingOrientation;
-	endingOrientation = tempStartOrientation;
-
-	for (int sectorIndex = 0; sectorIndex < amountOfTriangles; sectorIndex++) {
-		float cosCurrentSector = CosDegrees(startingOrientation + deltaDeg * static_cast<float>(sectorIndex));
-		float sinCurrentSector = SinDegrees(startingOrientation + deltaDeg * static_cast<float>(sectorIndex));
-
-		float cosNextSector = 0.0f;
-		float sinNextSector = 0.0f;
-
-		if (sectorIndex == amountOfTriangles - 1) {
-			cosNextSector = CosDegrees(endingOrientation);
-			sinNextSector = SinDegrees(endingOrientation);
-		}
-		else {
-			cosNextSector = CosDegrees(startingOrientation + deltaDeg * static_cast<float>(sectorIndex + 1));
-			sinNextSector = SinDegrees(startingOrientation + deltaDeg * static_cast<float>(sectorIndex + 1));
-		}
-
-
-		Vec2 topSector(cosCurrentSector, sinCurrentSector);
-		Vec2 topLeftSector(cosNextSector, sinNextSector);
-
-		topLeftSector *= capsule.m_radius;
-		topSector *= capsule.m_radius;
 
-		topLeftSector += capsule.m_bone.m_end;
-		topSector += capsule.m_bone.m_end;
-
-		Vec3 worldTopSector(topSector);
-		Vec3 worldTopLeftSector(topLeftSector);
-		Vec3 capsuleVec3End(capsule.m_bone.m_end);
-
-		verts.emplace_back(capsuleVec3End, tint, Vec2());
-		verts.emplace_back(worldTopSector, tint, Vec2());
-		verts.emplace_back(worldTopLeftSector, tint, Vec2());
-	}
+	verts = AddVertsForCapsuleEnd2D(verts, capsule.m_bone.m_start, capsule.m_radius, startingOrientation, tint, amountOfTriangles);
+	verts = AddVertsForCapsuleEnd2D(verts, capsule.m_bone.m_end, capsule.m_radius, endingOrientation, tint, amountOfTriangles);
+	return verts;
+}
 
+void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Capsule2 const& capsule, Rgba8 tint, int amountSectorsCapsEnds)
+{
+	AddVertsForCapsule2D(GrowVertexArray(verts, GetVertCountForCapsule2D(amountSectorsCapsEnds)), capsule, tint, amountSectorsCapsEnds);
 }
 
-void AddVertsForArrow2D(std::vector<Vertex_PCU>& verts, Vec2 const& arrowStart, Vec2 const& arrowEnd, Rgba8 color, float arrowBodySize, float arrowHeadSize)
+Vertex_PCU* AddVertsForArrow2D(Vertex_PCU* verts, Vec2 const& arrowStart, Vec2 const& arrowEnd, Rgba8 color, float arrowBodySize, float arrowHeadSize)
 {
 	Vec2 arrowFwd = (arrowStart != arrowEnd) ? (arrowEnd - arrowStart).GetNormalized() : Vec2::ZERO;
 	LineSegment2 arrowLineSegment(arrowStart, arrowEnd - (arrowFwd * arrowHeadSize));
@@ -316,26 +597,31 @@ void AddVertsForArrow2D(std::vector<Vertex_PCU>& verts, Vec2 const& arrowStart,
 	Vec3 arrowRightVertexPos(arrowEnd - arrowLeft * 0.5f * arrowHeadSize - (arrowFwd * arrowHeadSize));
 	Vec3 arrowTopVertexPos(arrowEnd);
 
-	AddVertsForLineSegment2D(verts, arrowLineSegment, color, arrowBodySize);
-	verts.emplace_back(arrowLeftVertexPos, color, Vec2());
-	verts.emplace_back(arrowRightVertexPos, color, Vec2());
-	verts.emplace_back(arrowTopVertexPos, color, Vec2());
+	verts = AddVertsForLineSegment2D(verts, arrowLineSegment, color, arrowBodySize);
+	*verts++ = Vertex_PCU(arrowLeftVertexPos, color, Vec2());
+	*verts++ = Vertex_PCU(arrowRightVertexPos, color, Vec2());
+	*verts++ = Vertex_PCU(arrowTopVertexPos, color, Vec2());
+	return verts;
+}
 
+void AddVertsForArrow2D(std::vector<Vertex_PCU>& verts, Vec2 const& arrowStart, Vec2 const& arrowEnd, Rgba8 color, float arrowBodySize, float arrowHeadSize)
+{
+	AddVertsForArrow2D(GrowVertexArray(verts, GetVertCountForArrow2D()), arrowStart, arrowEnd, color, arrowBodySize, arrowHeadSize);
 }
 
-void AddVertsForDelaunayConvexPoly2D(std::vector<Vertex_PCU>& verts, DelaunayConvexPoly2D const& convexPoly, Rgba8 const& color, AABB2 const& UVs)
+Vertex_PCU* AddVertsForDelaunayConvexPoly2D(Vertex_PCU* verts, DelaunayConvexPoly2D const& convexPoly, Rgba8 const& color, AABB2 const& UVs)
 {
+	if (convexPoly.m_vertexes.size() < 2) return verts;
+
 	Vec2 const& middle = convexPoly.GetMiddlePoint();
 	AABB2 enclosingQuad = convexPoly.GetEnclosingAABB2();
 	Vec2 UVsAtMiddle = enclosingQuad.GetUVForPoint(middle);
 	Vec2 UVsForMiddleVertex = UVs.GetPointAtUV(UVsAtMiddle);
 
-
 	Vec2 prevPolyVert = convexPoly.m_vertexes[0];
 	Vec2 UvsAtPrevPoly = enclosingQuad.GetUVForPoint(prevPolyVert);
 	Vec2 UVsForPrevVertex = UVs.GetPointAtUV(UvsAtPrevPoly);
 
-
 	Vec2 firstPolyVert = prevPolyVert;
 	Vec2 firtPolyVertUVs = UVsForPrevVertex;
 	for (int polyVertexIndex = 1; polyVertexIndex < convexPoly.m_vertexes.size(); polyVertexIndex++) {
@@ -344,41 +630,54 @@ void AddVertsForDelaunayConvexPoly2D(std::vector<Vertex_PCU>& verts, DelaunayCon
 
 		Vec2 UVsForVertex = UVs.GetPointAtUV(UVsAtVertex);
 
-		verts.emplace_back(Vec3(prevPolyVert), color, UVsForPrevVertex);
-		verts.emplace_back(Vec3(polyVertex), color, UVsForVertex);
-		verts.emplace_back(Vec3(middle), color, UVsForMiddleVertex);
+		*verts++ = Vertex_PCU(Vec3(prevPolyVert), color, UVsForPrevVertex);
+		*verts++ = Vertex_PCU(Vec3(polyVertex), color, UVsForVertex);
+		*verts++ = Vertex_PCU(Vec3(middle), color, UVsForMiddleVertex);
 
 		prevPolyVert = polyVertex;
 		UVsForPrevVertex = UVsForVertex;
 
 		if (polyVertexIndex == convexPoly.m_vertexes.size() - 1) {
-			verts.emplace_back(Vec3(polyVertex), color, UVsForVertex);
-			verts.emplace_back(Vec3(firstPolyVert), color, firtPolyVertUVs);
-			verts.emplace_back(Vec3(middle), color, UVsForMiddleVertex);
-
+			*verts++ = Vertex_PCU(Vec3(polyVertex), color, UVsForVertex);
+			*verts++ = Vertex_PCU(Vec3(firstPolyVert), color, firtPolyVertUVs);
+			*verts++ = Vertex_PCU(Vec3(middle), color, UVsForMiddleVertex);
 		}
 	}
+	return verts;
+}
 
+void AddVertsForDelaunayConvexPoly2D(std::vector<Vertex_PCU>& verts, DelaunayConvexPoly2D const& convexPoly, Rgba8 const& color, AABB2 const& UVs)
+{
+	AddVertsForDelaunayConvexPoly2D(GrowVertexArray(verts, GetVertCountForDelaunayConvexPoly2D(convexPoly)), convexPoly, color, UVs);
 }
 
-void AddVertsForWireDelaunayConvexPoly2D(std::vector<Vertex_PCU>& verts, DelaunayConvexPoly2D const& convexPoly, Rgba8 const& color, float lineThickness)
+Vertex_PCU* AddVertsForWireDelaunayConvexPoly2D(Vertex_PCU* verts, DelaunayConvexPoly2D const& convexPoly, Rgba8 const& color, float lineThickness)
 {
+	if (convexPoly.m_vertexes.empty()) return verts;
+
 	LineSegment2 lastLineSegment(convexPoly.m_vertexes[convexPoly.m_vertexes.size() - 1], convexPoly.m_vertexes[0]);
-	AddVertsForLineSegment2D(verts, lastLineSegment, color, lineThickness, false);
+	verts = AddVertsForLineSegment2D(verts, lastLineSegment, color, lineThickness, false);
 
 	Vec2 prevPoint = convexPoly.m_vertexes[0];
 	for (int polyVertexIndex = 1; polyVertexIndex < convexPoly.m_vertexes.size(); polyVertexIndex++) {
 		Vec2 const& polyVertex = convexPoly.m_vertexes[polyVertexIndex];
 
 		LineSegment2 lineSegment(prevPoint, polyVertex);
-		AddVertsForLineSegment2D(verts, lineSegment, color, lineThickness, false);
+		verts = AddVertsForLineSegment2D(verts, lineSegment, color, lineThickness, false);
 		prevPoint = polyVertex;
 	}
+	return verts;
+}
 
+void AddVertsForWireDelaunayConvexPoly2D(std::vector<Vertex_PCU>& verts, DelaunayConvexPoly2D const& convexPoly, Rgba8 const& color, float lineThickness)
+{
+	AddVertsForWireDelaunayConvexPoly2D(GrowVertexArray(verts, GetVertCountForWireDelaunayConvexPoly2D(convexPoly)), convexPoly, color, lineThickness);
 }
 
-void AddVertsForConvexPoly2D(std::vector<Vertex_PCU>& verts, ConvexPoly2D const& convexPoly, Rgba8 const& color)
+Vertex_PCU* AddVertsForConvexPoly2D(Vertex_PCU* verts, ConvexPoly2D const& convexPoly, Rgba8 const& color)
 {
+	if (convexPoly.m_ccwPoints.empty()) return verts;
+
 	Vec2 middlePoint = convexPoly.GetCenter();
 	Vertex_PCU middleVertex;
 	middleVertex.m_color = color;
@@ -390,68 +689,119 @@ void AddVertsForConvexPoly2D(std::vector<Vertex_PCU>& verts, ConvexPoly2D const&
 		int nextIndex = pointIndex + 1;
 		Vec2 const& lineEnd = convexPoly.m_ccwPoints[nextIndex];
 
-		verts.emplace_back(middleVertex);
-		verts.emplace_back(Vec3(lineStart), color, Vec2::ZERO);
-		verts.emplace_back(Vec3(lineEnd), color, Vec2::ZERO);
+		*verts++ = middleVertex;
+		*verts++ = Vertex_PCU(Vec3(lineStart), color, Vec2::ZERO);
+		*verts++ = Vertex_PCU(Vec3(lineEnd), color, Vec2::ZERO);
 	}
 
 	Vec2 const& lastStart = convexPoly.m_ccwPoints[convexPoly.m_ccwPoints.size() - 1];
 	Vec2 const& lastEnd = convexPoly.m_ccwPoints[0];
 
-	verts.emplace_back(middleVertex);
-	verts.emplace_back(Vec3(lastStart), color, Vec2::ZERO);
-	verts.emplace_back(Vec3(lastEnd), color, Vec2::ZERO);
+	*verts++ = middleVertex;
+	*verts++ = Vertex_PCU(Vec3(lastStart), color, Vec2::ZERO);
+	*verts++ = Vertex_PCU(Vec3(lastEnd), color, Vec2::ZERO);
+	return verts;
 }
 
-void AddVertsForWireConvexPoly2D(std::vector<Vertex_PCU>& verts, ConvexPoly2D const& convexPoly, Rgba8 const& borderColor, float lineThickness)
+void AddVertsForConvexPoly2D(std::vector<Vertex_PCU>& verts, ConvexPoly2D const& convexPoly, Rgba8 const& color)
 {
+	AddVertsForConvexPoly2D(GrowVertexArray(verts, GetVertCountForConvexPoly2D(convexPoly)), convexPoly, color);
+}
+
+Vertex_PCU* AddVertsForWireConvexPoly2D(Vertex_PCU* verts, ConvexPoly2D const& convexPoly, Rgba8 const& borderColor, float lineThickness)
+{
+	if (convexPoly.m_ccwPoints.empty()) return verts;
+
 	for (int pointIndex = 0; pointIndex + 1 < (int)convexPoly.m_ccwPoints.size(); pointIndex++) {
 		Vec2 const& lineStart = convexPoly.m_ccwPoints[pointIndex];
 		int nextIndex = pointIndex + 1;
 		Vec2 const& lineEnd = convexPoly.m_ccwPoints[nextIndex];
-		AddVertsForLineSegment2D(verts, LineSegment2(lineStart, lineEnd), borderColor, lineThickness, false);
+		verts = AddVertsForLineSegment2D(verts, LineSegment2(lineStart, lineEnd), borderColor, lineThickness, false);
 	}
 	Vec2 const& lastStart = convexPoly.m_ccwPoints[convexPoly.m_ccwPoints.size() - 1];
 	Vec2 const& lastEnd = convexPoly.m_ccwPoints[0];
-	AddVertsForLineSegment2D(verts, LineSegment2(lastStart, lastEnd), borderColor, lineThickness,false);
+	return AddVertsForLineSegment2D(verts, LineSegment2(lastStart, lastEnd), borderColor, lineThickness, false);
 }
 
-void AddVertsForConvexHull2D(std::vector<Vertex_PCU>& verts, ConvexHull2D const& convexHull, Rgba8 const& color, float planeDrawDistance, float lineThickness)
+void AddVertsForWireConvexPoly2D(std::vector<Vertex_PCU>& verts, ConvexPoly2D const& convexPoly, Rgba8 const& borderColor, float lineThickness)
+{
+	AddVertsForWireConvexPoly2D(GrowVertexArray(verts, GetVertCountForWireConvexPoly2D(convexPoly)), convexPoly, borderColor, lineThickness);
+}
+
+Vertex_PCU* AddVertsForConvexHull2D(Vertex_PCU* verts, ConvexHull2D const& convexHull, Rgba8 const& color, float planeDrawDistance, float lineThickness)
 {
 	for (Plane2D const& plane : convexHull.m_planes) {
 		Vec2 middlePoint = plane.m_planeNormal * plane.m_distToPlane;
 		Vec2 lineStart = middlePoint + plane.m_planeNormal.GetRotated90Degrees()* planeDrawDistance;
 		Vec2 lineEnd = middlePoint - plane.m_planeNormal.GetRotated90Degrees()* planeDrawDistance;
 
-		AddVertsForLineSegment2D(verts, LineSegment2(lineStart, lineEnd), color, lineThickness);
+		verts = AddVertsForLineSegment2D(verts, LineSegment2(lineStart, lineEnd), color, lineThickness);
 	}
+	return verts;
+}
 
+void AddVertsForConvexHull2D(std::vector<Vertex_PCU>& verts, ConvexHull2D const& convexHull, Rgba8 const& color, float planeDrawDistance, float lineThickness)
+{
+	AddVertsForConvexHull2D(GrowVertexArray(verts, GetVertCountForConvexHull2D(convexHull)), convexHull, color, planeDrawDistance, lineThickness);
 }
 
+//------------------------------------------------------------------------------------------------
+// 3D
 void TransformVertexArray3D(int numVerts, Vertex_PCU* verts, Mat44 const& model)
 {
-	for (int vertIndex = 0; vertIndex < numVerts; vertIndex++) {
-		Vertex_PCU& vertex = verts[vertIndex];
-		TransformPosition3D(vertex.m_position, model);
-	}
+	if (numVerts <= 0) return;
+	TransformPositionsStrided3D(numVerts, &verts[0].m_position.x, sizeof(Vertex_PCU), model);
 }
 
-void AddVertsForLineSegment3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, Rgba8 const& color, float thickness)
+void TransformVertexArray3D(int numVerts, Vertex_PNCU* verts, Mat44 const& model)
+{
+	if (numVerts <= 0) return;
+	TransformPositionsStrided3D(numVerts, &verts[0].m_position.x, sizeof(Vertex_PNCU), model);
+	TransformNormalsStrided3D(numVerts, &verts[0].m_normal.x, sizeof(Vertex_PNCU), model);
+}
+
+Vertex_PCU* AddVertsForLineSegment3D(Vertex_PCU* verts, Vec3 const& start, Vec3 const& end, Rgba8 const& color, float thickness)
 {
 	Vec3 kBasis = (end - start).GetNormalized();
-	Vec3 worldIBasis = Vec3(1.0, 0.0f, 0.0f);
-	Vec3 worldJBasis = Vec3(0.0f, 1.0, 0.0f);
+	Vec3 iBasis, jBasis;
+	GetPerpendicularBases(kBasis, iBasis, jBasis);
 
-	Vec3 jBasis, iBasis;
+	kBasis *= thickness;
+	jBasis *= thickness;
+	iBasis *= thickness;
 
-	if (fabsf(DotProduct3D(kBasis, worldIBasis)) < 1.0f) {
-		jBasis = CrossProduct3D(kBasis, worldIBasis).GetNormalized();
-		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
-	}
-	else {
-		jBasis = CrossProduct3D(kBasis, worldJBasis).GetNormalized();
-		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
-	}
+	Vec3 const& rightFrontBottom = start - iBasis - jBasis - kBasis;
+	Vec3 const& rightBackBottom = start + iBasis - jBasis - kBasis;
+	Vec3 const& rightBackTop = end + iBasis - jBasis + kBasis;
+	Vec3 const& rightFrontTop = end - iBasis - jBasis + kBasis;
+
+	Vec3 const& leftFrontBottom = start - iBasis + jBasis - kBasis;
+	Vec3 const& leftBackBottom = start + iBasis + jBasis - kBasis;
+	Vec3 const& leftBackTop = end + iBasis + jBasis + kBasis;
+	Vec3 const& leftFrontTop = end - iBasis + jBasis + kBasis;
+
+	verts = AddVertsForQuad3D(verts, leftFrontBottom, rightFrontBottom, rightFrontTop, leftFrontTop, color); // Front
+	verts = AddVertsForQuad3D(verts, rightFrontBottom, rightBackBottom, rightBackTop, rightFrontTop, color); // Right
+	verts = AddVertsForQuad3D(verts, rightBackBottom, leftBackBottom, leftBackTop, rightBackTop, color); // Back
+	verts = AddVertsForQuad3D(verts, leftBackBottom, leftFrontBottom, leftFrontTop, leftBackTop, color); // Left
+	verts = AddVertsForQuad3D(verts, leftFrontTop, rightFrontTop, rightBackTop, leftBackTop, color); // Top
+	verts = AddVertsForQuad3D(verts, leftBackBottom, rightBackBottom, rightFrontBottom, leftFrontBottom, color); // Bottom;
+	return verts;
+}
+
+void AddVertsForLineSegment3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, Rgba8 const& color, float thickness)
+{
+	AddVertsForLineSegment3D(GrowVertexArray(verts, GetVertCountForLineSegment3D()), start, end, color, thickness);
+}
+
+void AddVertsForIndexedLineSegment3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, Vec3 const& start, Vec3 const& end, Rgba8 const& color, float thickness)
+{
+	ReserveAdditional(verts, GetVertCountForIndexedLineSegment3D());
+	ReserveAdditional(indices, GetIndexCountForIndexedLineSegment3D());
+
+	Vec3 kBasis = (end - start).GetNormalized();
+	Vec3 iBasis, jBasis;
+	GetPerpendicularBases(kBasis, iBasis, jBasis);
 
 	kBasis *= thickness;
 	jBasis *= thickness;
@@ -467,13 +817,12 @@ void AddVertsForLineSegment3D(std::vector<Vertex_PCU>& verts, Vec3 const& start,
 	Vec3 const& leftBackTop = end + iBasis + jBasis + kBasis;
 	Vec3 const& leftFrontTop = end - iBasis + jBasis + kBasis;
 
-	AddVertsForQuad3D(verts, leftFrontBottom, rightFrontBottom, rightFrontTop, leftFrontTop, color); // Front
-	AddVertsForQuad3D(verts, rightFrontBottom, rightBackBottom, rightBackTop, rightFrontTop, color); // Right
-	AddVertsForQuad3D(verts, rightBackBottom, leftBackBottom, leftBackTop, rightBackTop, color); // Back
-	AddVertsForQuad3D(verts, leftBackBottom, leftFrontBottom, leftFrontTop, leftBackTop, color); // Left
-	AddVertsForQuad3D(verts, leftFrontTop, rightFrontTop, rightBackTop, leftBackTop, color); // Top
-	AddVertsForQuad3D(verts, leftBackBottom, rightBackBottom, rightFrontBottom, leftFrontBottom, color); // Bottom;
-
+	AddVertsForIndexedQuad3D(verts, indices, leftFrontBottom, rightFrontBottom, rightFrontTop, leftFrontTop, color); // Front
+	AddVertsForIndexedQuad3D(verts, indices, rightFrontBottom, rightBackBottom, rightBackTop, rightFrontTop, color); // Right
+	AddVertsForIndexedQuad3D(verts, indices, rightBackBottom, leftBackBottom, leftBackTop, rightBackTop, color); // Back
+	AddVertsForIndexedQuad3D(verts, indices, leftBackBottom, leftFrontBottom, leftFrontTop, leftBackTop, color); // Left
+	AddVertsForIndexedQuad3D(verts, indices, leftFrontTop, rightFrontTop, rightBackTop, leftBackTop, color); // Top
+	AddVertsForIndexedQuad3D(verts, indices, leftBackBottom, rightBackBottom, rightFrontBottom, leftFrontBottom, color); // Bottom;
 }
 
 void AddVertsForIndexedQuad3D(std::vector<Vertex_PNCU>& verts, std::vector<unsigned int>& indices, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color, const AABB2& UVs)
@@ -482,78 +831,71 @@ void AddVertsForIndexedQuad3D(std::vector<Vertex_PNCU>& verts, std::vector<unsig
 	Vec3 jBasis = (topLeft - topRight).GetNormalized();
 	Vec3 quadNormal = CrossProduct3D(kBasis, jBasis);
 
-	int zero = (int)verts.size();
-	int one = zero + 1;
-	int two = zero + 2;
-	int three = zero + 3;
-
-	verts.emplace_back(bottomLeft, quadNormal, color, UVs.m_mins);
-	verts.emplace_back(bottomRight, quadNormal, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
-	verts.emplace_back(topLeft, quadNormal, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
-	verts.emplace_back(topRight, quadNormal, color, UVs.m_maxs);
-
-
-	indices.push_back(zero);
-	indices.push_back(one);
-	indices.push_back(three);
+	unsigned int zero = (unsigned int)verts.size();
+	Vertex_PNCU* quadVerts = GrowVertexArray(verts, GetVertCountForIndexedQuad3D());
+	quadVerts[0] = Vertex_PNCU(bottomLeft, quadNormal, color, UVs.m_mins);
+	quadVerts[1] = Vertex_PNCU(bottomRight, quadNormal, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
+	quadVerts[2] = Vertex_PNCU(topLeft, quadNormal, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+	quadVerts[3] = Vertex_PNCU(topRight, quadNormal, color, UVs.m_maxs);
 
-	indices.push_back(zero);
-	indices.push_back(three);
-	indices.push_back(two);
+	AddIndexesForQuad(indices, zero, zero + 1, zero + 3, zero + 2);
 }
 
 void AddVertsForIndexedQuad3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color, const AABB2& UVs)
 {
-	int zero = (int)verts.size();
-	int one = zero + 1;
-	int two = zero + 2;
-	int three = zero + 3;
-
-	verts.emplace_back(bottomLeft, color, UVs.m_mins);
-	verts.emplace_back(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
-	verts.emplace_back(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
-	verts.emplace_back(topRight, color, UVs.m_maxs);
-
-
-	indices.push_back(zero);
-	indices.push_back(one);
-	indices.push_back(three);
-
-	indices.push_back(zero);
-	indices.push_back(three);
-	indices.push_back(two);
+	unsigned int zero = (unsigned int)verts.size();
+	Vertex_PCU* quadVerts = GrowVertexArray(verts, GetVertCountForIndexedQuad3D());
+	quadVerts[0] = Vertex_PCU(bottomLeft, color, UVs.m_mins);
+	quadVerts[1] = Vertex_PCU(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
+	quadVerts[2] = Vertex_PCU(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+	quadVerts[3] = Vertex_PCU(topRight, color, UVs.m_maxs);
+
+	AddIndexesForQuad(indices, zero, zero + 1, zero + 3, zero + 2);
 }
 
-void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color, const AABB2& UVs)
+Vertex_PCU* AddVertsForQuad3D(Vertex_PCU* verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color, const AABB2& UVs)
 {
 	// Right Quad
-	verts.emplace_back(bottomLeft, color, UVs.m_mins);
-	verts.emplace_back(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
-	verts.emplace_back(topRight, color, UVs.m_maxs);
+	*verts++ = Vertex_PCU(bottomLeft, color, UVs.m_mins);
+	*verts++ = Vertex_PCU(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
+	*verts++ = Vertex_PCU(topRight, color, UVs.m_maxs);
 
 	// Left Quad
-	verts.emplace_back(bottomLeft, color, UVs.m_mins);
-	verts.emplace_back(topRight, color, UVs.m_maxs);
-	verts.emplace_back(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+	*verts++ = Vertex_PCU(bottomLeft, color, UVs.m_mins);
+	*verts++ = Vertex_PCU(topRight, color, UVs.m_maxs);
+	*verts++ = Vertex_PCU(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+	return verts;
 }
 
-void AddVertsForQuad3D(std::vector<Vertex_PNCU>& verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color, const AABB2& UVs)
+Vertex_PNCU* AddVertsForQuad3D(Vertex_PNCU* verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color, const AABB2& UVs)
 {
 	Vec3 kBasis = (topRight - bottomRight).GetNormalized();
 	Vec3 jBasis = (topLeft - topRight).GetNormalized();
 	Vec3 quadNormal = CrossProduct3D(kBasis, jBasis);
 
 	// Right Quad
-	verts.emplace_back(bottomLeft, quadNormal, color, UVs.m_mins);
-	verts.emplace_back(bottomRight, quadNormal, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
-	verts.emplace_back(topRight, quadNormal, color, UVs.m_maxs);
+	*verts++ = Vertex_PNCU(bottomLeft, quadNormal, color, UVs.m_mins);
+	*verts++ = Vertex_PNCU(bottomRight, quadNormal, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
+	*verts++ = Vertex_PNCU(topRight, quadNormal, color, UVs.m_maxs);
 
 	// Left Quad
-	verts.emplace_back(bottomLeft, quadNormal, color, UVs.m_mins);
-	verts.emplace_back(topRight, quadNormal, color, UVs.m_maxs);
-	verts.emplace_back(topLeft, quadNormal, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+	*verts++ = Vertex_PNCU(bottomLeft, quadNormal, color, UVs.m_mins);
+	*verts++ = Vertex_PNCU(topRight, quadNormal, color, UVs.m_maxs);
+	*verts++ = Vertex_PNCU(topLeft, quadNormal, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+	return verts;
 }
-void AddVertsForRoundedQuad3D(std::vector<Vertex_PNCU>& verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color, const AABB2& UVs)
+
+void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color, const AABB2& UVs)
+{
+	AddVertsForQuad3D(GrowVertexArray(verts, GetVertCountForQuad3D()), bottomLeft, bottomRight, topRight, topLeft, color, UVs);
+}
+
+void AddVertsForQuad3D(std::vector<Vertex_PNCU>& verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color, const AABB2& UVs)
+{
+	AddVertsForQuad3D(GrowVertexArray(verts, GetVertCountForQuad3D()), bottomLeft, bottomRight, topRight, topLeft, color, UVs);
+}
+
+Vertex_PNCU* AddVertsForRoundedQuad3D(Vertex_PNCU* verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color, const AABB2& UVs)
 {
 	Vec3 dispBetweenEdges = topRight - topLeft;
 	Vec3 kBasis = (topRight - bottomRight).GetNormalized();
@@ -568,27 +910,36 @@ void AddVertsForRoundedQuad3D(std::vector<Vertex_PNCU>& verts, Vec3 const& botto
 	Vec2 bottomMiddleUVs = UVs.GetPointAtUV(0.5f, 0.0f);
 	Vec2 topMiddleUVs = UVs.GetPointAtUV(0.5f, 1.0f);
 
+	// Left
+	*verts++ = Vertex_PNCU(bottomLeft, jBasis, color, UVs.m_mins);
+	*verts++ = Vertex_PNCU(bottomMiddle, quadNormal, color, bottomMiddleUVs);
+	*verts++ = Vertex_PNCU(topMiddle, quadNormal, color, topMiddleUVs);
 
-	// Left 
-	verts.emplace_back(bottomLeft, jBasis, color, UVs.m_mins);
-	verts.emplace_back(bottomMiddle, quadNormal, color, bottomMiddleUVs);
-	verts.emplace_back(topMiddle, quadNormal, color, topMiddleUVs);
-
-	verts.emplace_back(bottomLeft, jBasis, color, UVs.m_mins);
-	verts.emplace_back(topMiddle, quadNormal, color, topMiddleUVs);
-	verts.emplace_back(topLeft, jBasis, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+	*verts++ = Vertex_PNCU(bottomLeft, jBasis, color, UVs.m_mins);
+	*verts++ = Vertex_PNCU(topMiddle, quadNormal, color, topMiddleUVs);
+	*verts++ = Vertex_PNCU(topLeft, jBasis, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
 
 	// Right
-	verts.emplace_back(bottomMiddle, quadNormal, color, bottomMiddleUVs);
-	verts.emplace_back(bottomRight, -jBasis, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
-	verts.emplace_back(topRight, -jBasis, color, UVs.m_maxs);
+	*verts++ = Vertex_PNCU(bottomMiddle, quadNormal, color, bottomMiddleUVs);
+	*verts++ = Vertex_PNCU(bottomRight, -jBasis, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
+	*verts++ = Vertex_PNCU(topRight, -jBasis, color, UVs.m_maxs);
+
+	*verts++ = Vertex_PNCU(bottomMiddle, quadNormal, color, bottomMiddleUVs);
+	*verts++ = Vertex_PNCU(topRight, -jBasis, color, UVs.m_maxs);
+	*verts++ = Vertex_PNCU(topMiddle, quadNormal, color, topMiddleUVs);
+	return verts;
+}
 
-	verts.emplace_back(bottomMiddle, quadNormal, color, bottomMiddleUVs);
-	verts.emplace_back(topRight, -jBasis, color, UVs.m_maxs);
-	verts.emplace_back(topMiddle, quadNormal, color, topMiddleUVs);
+void AddVertsForRoundedQuad3D(std::vector<Vertex_PNCU>& verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color, const AABB2& UVs)
+{
+	AddVertsForRoundedQuad3D(GrowVertexArray(verts, GetVertCountForRoundedQuad3D()), bottomLeft, bottomRight, topRight, topLeft, color, UVs);
 }
+
 void AddVertsForIndexedAABB3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
 {
+	ReserveAdditional(verts, GetVertCountForIndexedAABB3D());
+	ReserveAdditional(indices, GetIndexCountForIndexedAABB3D());
+
 	Vec3 corners[8];
 	bounds.GetCorners(corners);
 
@@ -609,8 +960,11 @@ void AddVertsForIndexedAABB3D(std::vector<Vertex_PCU>& verts, std::vector<unsign
 	AddVertsForIndexedQuad3D(verts, indices, leftFrontBottom, leftBackBottom, rightBackBottom, rightFrontBottom, color, UVs); // Bottom;
 }
 
-void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+void AddVertsForIndexedAABB3D(std::vector<Vertex_PNCU>& verts, std::vector<unsigned int>& indices, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
 {
+	ReserveAdditional(verts, GetVertCountForIndexedAABB3D());
+	ReserveAdditional(indices, GetIndexCountForIndexedAABB3D());
+
 	Vec3 corners[8];
 	bounds.GetCorners(corners);
 
@@ -623,16 +977,38 @@ void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, cons
 	Vec3 const& leftBackTop = corners[6];
 	Vec3 const& leftFrontTop = corners[7];
 
-	AddVertsForQuad3D(verts, leftFrontBottom, rightFrontBottom, rightFrontTop, leftFrontTop, color, UVs); // Front
-	AddVertsForQuad3D(verts, rightFrontBottom, rightBackBottom, rightBackTop, rightFrontTop, color, UVs); // Right
-	AddVertsForQuad3D(verts, rightBackBottom, leftBackBottom, leftBackTop, rightBackTop, color, UVs); // Back
-	AddVertsForQuad3D(verts, leftBackBottom, leftFrontBottom, leftFrontTop, leftBackTop, color, UVs); // Left
-	AddVertsForQuad3D(verts, rightFrontTop, rightBackTop, leftBackTop, leftFrontTop, color, UVs); // Top
-	AddVertsForQuad3D(verts, leftFrontBottom, leftBackBottom, rightBackBottom, rightFrontBottom, color, UVs); // Bottom;
+	AddVertsForIndexedQuad3D(verts, indices, leftFrontBottom, rightFrontBottom, rightFrontTop, leftFrontTop, color, UVs); // Front
+	AddVertsForIndexedQuad3D(verts, indices, rightFrontBottom, rightBackBottom, rightBackTop, rightFrontTop, color, UVs); // Right
+	AddVertsForIndexedQuad3D(verts, indices, rightBackBottom, leftBackBottom, leftBackTop, rightBackTop, color, UVs); // Back
+	AddVertsForIndexedQuad3D(verts, indices, leftBackBottom, leftFrontBottom, leftFrontTop, leftBackTop, color, UVs); // Left
+	AddVertsForIndexedQuad3D(verts, indices, rightFrontTop, rightBackTop, leftBackTop, leftFrontTop, color, UVs); // Top
+	AddVertsForIndexedQuad3D(verts, indices, leftFrontBottom, leftBackBottom, rightBackBottom, rightFrontBottom, color, UVs); // Bottom;
+}
+
+Vertex_PCU* AddVertsForAABB3D(Vertex_PCU* verts, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+{
+	Vec3 corners[8];
+	bounds.GetCorners(corners);
+
+	Vec3 const& rightFrontBottom = corners[0];
+	Vec3 const& rightBackBottom = corners[1];
+	Vec3 const& rightBackTop = corners[2];
+	Vec3 const& rightFrontTop = corners[3];
+	Vec3 const& leftFrontBottom = corners[4];
+	Vec3 const& leftBackBottom = corners[5];
+	Vec3 const& leftBackTop = corners[6];
+	Vec3 const& leftFrontTop = corners[7];
 
+	verts = AddVertsForQuad3D(verts, leftFrontBottom, rightFrontBottom, rightFrontTop, leftFrontTop, color, UVs); // Front
+	verts = AddVertsForQuad3D(verts, rightFrontBottom, rightBackBottom, rightBackTop, rightFrontTop, color, UVs); // Right
+	verts = AddVertsForQuad3D(verts, rightBackBottom, leftBackBottom, leftBackTop, rightBackTop, color, UVs); // Back
+	verts = AddVertsForQuad3D(verts, leftBackBottom, leftFrontBottom, leftFrontTop, leftBackTop, color, UVs); // Left
+	verts = AddVertsForQuad3D(verts, rightFrontTop, rightBackTop, leftBackTop, leftFrontTop, color, UVs); // Top
+	verts = AddVertsForQuad3D(verts, leftFrontBottom, leftBackBottom, rightBackBottom, rightFrontBottom, color, UVs); // Bottom;
+	return verts;
 }
 
-void AddVertsForAABB3D(std::vector<Vertex_PNCU>& verts, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+Vertex_PNCU* AddVertsForAABB3D(Vertex_PNCU* verts, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
 {
 	Vec3 corners[8];
 	bounds.GetCorners(corners);
@@ -646,16 +1022,26 @@ void AddVertsForAABB3D(std::vector<Vertex_PNCU>& verts, const AABB3& bounds, con
 	Vec3 const& leftBackTop = corners[6];
 	Vec3 const& leftFrontTop = corners[7];
 
-	AddVertsForQuad3D(verts, leftFrontBottom, rightFrontBottom, rightFrontTop, leftFrontTop, color, UVs); // Front
-	AddVertsForQuad3D(verts, rightFrontBottom, rightBackBottom, rightBackTop, rightFrontTop, color, UVs); // Right
-	AddVertsForQuad3D(verts, rightBackBottom, leftBackBottom, leftBackTop, rightBackTop, color, UVs); // Back
-	AddVertsForQuad3D(verts, leftBackBottom, leftFrontBottom, leftFrontTop, leftBackTop, color, UVs); // Left
-	AddVertsForQuad3D(verts, rightFrontTop, rightBackTop, leftBackTop, leftFrontTop, color, UVs); // Top
-	AddVertsForQuad3D(verts, leftFrontBottom, leftBackBottom, rightBackBottom, rightFrontBottom, color, UVs); // Bottom;
+	verts = AddVertsForQuad3D(verts, leftFrontBottom, rightFrontBottom, rightFrontTop, leftFrontTop, color, UVs); // Front
+	verts = AddVertsForQuad3D(verts, rightFrontBottom, rightBackBottom, rightBackTop, rightFrontTop, color, UVs); // Right
+	verts = AddVertsForQuad3D(verts, rightBackBottom, leftBackBottom, leftBackTop, rightBackTop, color, UVs); // Back
+	verts = AddVertsForQuad3D(verts, leftBackBottom, leftFrontBottom, leftFrontTop, leftBackTop, color, UVs); // Left
+	verts = AddVertsForQuad3D(verts, rightFrontTop, rightBackTop, leftBackTop, leftFrontTop, color, UVs); // Top
+	verts = AddVertsForQuad3D(verts, leftFrontBottom, leftBackBottom, rightBackBottom, rightFrontBottom, color, UVs); // Bottom;
+	return verts;
+}
 
+void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+{
+	AddVertsForAABB3D(GrowVertexArray(verts, GetVertCountForAABB3D()), bounds, color, UVs);
 }
 
-void AddVertsForWireAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const Rgba8& color)
+void AddVertsForAABB3D(std::vector<Vertex_PNCU>& verts, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+{
+	AddVertsForAABB3D(GrowVertexArray(verts, GetVertCountForAABB3D()), bounds, color, UVs);
+}
+
+Vertex_PCU* AddVertsForWireAABB3D(Vertex_PCU* verts, const AABB3& bounds, const Rgba8& color)
 {
 	Vec3 corners[8];
 	bounds.GetCorners(corners);
@@ -669,74 +1055,72 @@ void AddVertsForWireAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds,
 	Vec3 const& leftBackTop = corners[6];
 	Vec3 const& leftFrontTop = corners[7];
 
-	AddVertsForLineSegment3D(verts, leftFrontBottom, leftFrontTop, color);
-	AddVertsForLineSegment3D(verts, leftFrontBottom, rightFrontBottom, color);
-	AddVertsForLineSegment3D(verts, rightFrontBottom, rightFrontTop, color);
-	AddVertsForLineSegment3D(verts, leftFrontTop, rightFrontTop, color);
+	verts = AddVertsForLineSegment3D(verts, leftFrontBottom, leftFrontTop, color);
+	verts = AddVertsForLineSegment3D(verts, leftFrontBottom, rightFrontBottom, color);
+	verts = AddVertsForLineSegment3D(verts, rightFrontBottom, rightFrontTop, color);
+	verts = AddVertsForLineSegment3D(verts, leftFrontTop, rightFrontTop, color);
+
+	verts = AddVertsForLineSegment3D(verts, leftBackBottom, leftBackTop, color);
+	verts = AddVertsForLineSegment3D(verts, leftBackBottom, rightBackBottom, color);
+	verts = AddVertsForLineSegment3D(verts, rightBackBottom, rightBackTop, color);
+	verts = AddVertsForLineSegment3D(verts, leftBackTop, rightBackTop, color);
+
+	verts = AddVertsForLineSegment3D(verts, leftFrontBottom, leftBackBottom, color);
+	verts = AddVertsForLineSegment3D(verts, leftFrontTop, leftBackTop, color);
+	verts = AddVertsForLineSegment3D(verts, rightFrontBottom, rightBackBottom, color);
+	verts = AddVertsForLineSegment3D(verts, rightFrontTop, rightBackTop, color);
+	return verts;
+}
 
-	AddVertsForLineSegment3D(verts, leftBackBottom, leftBackTop, color);
-	AddVertsForLineSegment3D(verts, leftBackBottom, rightBackBottom, color);
-	AddVertsForLineSegment3D(verts, rightBackBottom, rightBackTop, color);
-	AddVertsForLineSegment3D(verts, leftBackTop, rightBackTop, color);
+void AddVertsForWireAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const Rgba8& color)
+{
+	AddVertsForWireAABB3D(GrowVertexArray(verts, GetVertCountForWireAABB3D()), bounds, color);
+}
 
-	AddVertsForLineSegment3D(verts, leftFrontBottom, leftBackBottom, color);
-	AddVertsForLineSegment3D(verts, leftFrontTop, leftBackTop, color);
-	AddVertsForLineSegment3D(verts, rightFrontBottom, rightBackBottom, color);
-	AddVertsForLineSegment3D(verts, rightFrontTop, rightBackTop, color);
+// Position on the unit sphere for the given yaw and pitch, matching the pitch-down convention of the sphere builders
+static Vec3 GetUnitSpherePosition(float cosYaw, float sinYaw, float cosPitch, float sinPitch)
+{
+	return Vec3(cosYaw * cosPitch, sinYaw * cosPitch, -sinPitch);
 }
 
-void AddVertsForSphere(std::vector<Vertex_PCU>& verts, float radius, int stacks, int slices, Rgba8 const& color, AABB2 const& UVs)
+Vertex_PCU* AddVertsForSphere(Vertex_PCU* verts, float radius, int stacks, int slices, Rgba8 const& color, AABB2 const& UVs)
 {
 	float yawDegDelta = 360.0f / static_cast<float>(slices);
 	float pitchDegDelta = 180.0f / static_cast<float>(stacks);
 
-	float prevCosYaw = -1.0f;
-	float prevSinYaw = -1.0f;
-
-	float prevCosPitch = -1.0f;
-	float prevSinPitch = -1.0f;
+	float prevCosYaw = 1.0f;
+	float prevSinYaw = 0.0f;
 
-	for (float yaw = yawDegDelta; yaw <= 360.0f; yaw += yawDegDelta) {
+	for (int sliceIndex = 1; sliceIndex <= slices; sliceIndex++) {
+		float yaw = yawDegDelta * static_cast<float>(sliceIndex);
 		float cosYaw = CosDegrees(yaw);
 		float sinYaw = SinDegrees(yaw);
 
-		if (yaw == yawDegDelta) {
-			prevCosYaw = CosDegrees(yaw - yawDegDelta);
-			prevSinYaw = SinDegrees(yaw - yawDegDelta);
-		}
-
 		float leftU = RangeMapClamped(yaw - yawDegDelta, 0.0f, 360.0f, UVs.m_mins.x, UVs.m_maxs.x);
 		float rightU = RangeMapClamped(yaw, 0.0f, 360.0f, UVs.m_mins.x, UVs.m_maxs.x);
-		for (float pitch = -90.0f + pitchDegDelta; pitch <= 90.0f; pitch += pitchDegDelta) {
+
+		float prevCosPitch = 0.0f;
+		float prevSinPitch = -1.0f;
+		for (int stackIndex = 1; stackIndex <= stacks; stackIndex++) {
+			float pitch = -90.0f + pitchDegDelta * static_cast<float>(stackIndex);
 			float cosPitch = CosDegrees(pitch);
 			float sinPitch = SinDegrees(pitch);
 
-			if (pitch == -90.0f + pitchDegDelta) {
-				prevCosPitch = CosDegrees(pitch - pitchDegDelta);
-				prevSinPitch = SinDegrees(pitch - pitchDegDelta);
-			}
-
-			Vec3 rightBottomPos(cosYaw * cosPitch, sinYaw * cosPitch, -sinPitch);
-			Vec3 rightTopPos(cosYaw * prevCosPitch, sinYaw * prevCosPitch, -prevSinPitch);
-			Vec3 leftTopPos(prevCosYaw * prevCosPitch, prevSinYaw * prevCosPitch, -prevSinPitch);
-			Vec3 leftBottomPos(prevCosYaw * cosPitch, prevSinYaw * cosPitch, -sinPitch);
-
-			rightBottomPos *= radius;
-			rightTopPos *= radius;
-			leftTopPos *= radius;
-			leftBottomPos *= radius;
-
+			Vec3 rightBottomPos = GetUnitSpherePosition(cosYaw, sinYaw, cosPitch, sinPitch) * radius;
+			Vec3 rightTopPos = GetUnitSpherePosition(cosYaw, sinYaw, prevCosPitch, prevSinPitch) * radius;
+			Vec3 leftTopPos = GetUnitSpherePosition(prevCosYaw, prevSinYaw, prevCosPitch, prevSinPitch) * radius;
+			Vec3 leftBottomPos = GetUnitSpherePosition(prevCosYaw, prevSinYaw, cosPitch, sinPitch) * radius;
 
 			float topV = RangeMapClamped(pitch - pitchDegDelta, 90.0f, -90.0f, UVs.m_mins.y, UVs.m_maxs.y);
 			float bottomV = RangeMapClamped(pitch, 90.0f, -90.0f, UVs.m_mins.y, UVs.m_maxs.y);
 
-			verts.emplace_back(leftBottomPos, color, Vec2(leftU, bottomV));
-			verts.emplace_back(rightBottomPos, color, Vec2(rightU, bottomV));
-			verts.emplace_back(rightTopPos, color, Vec2(rightU, topV));
+			*verts++ = Vertex_PCU(leftBottomPos, color, Vec2(leftU, bottomV));
+			*verts++ = Vertex_PCU(rightBottomPos, color, Vec2(rightU, bottomV));
+			*verts++ = Vertex_PCU(rightTopPos, color, Vec2(rightU, topV));
 
-			verts.emplace_back(leftBottomPos, color, Vec2(leftU, bottomV));
-			verts.emplace_back(rightTopPos, color, Vec2(rightU, topV));
-			verts.emplace_back(leftTopPos, color, Vec2(leftU, topV));
+			*verts++ = Vertex_PCU(leftBottomPos, color, Vec2(leftU, bottomV));
+			*verts++ = Vertex_PCU(rightTopPos, color, Vec2(rightU, topV));
+			*verts++ = Vertex_PCU(leftTopPos, color, Vec2(leftU, topV));
 
 			prevCosPitch = cosPitch;
 			prevSinPitch = sinPitch;
@@ -745,65 +1129,52 @@ void AddVertsForSphere(std::vector<Vertex_PCU>& verts, float radius, int stacks,
 		prevCosYaw = cosYaw;
 		prevSinYaw = sinYaw;
 	}
+	return verts;
 }
 
-
-void AddVertsForSphere(std::vector<Vertex_PNCU>& verts, float radius, int stacks, int slices, Rgba8 const& color, AABB2 const& UVs)
+Vertex_PNCU* AddVertsForSphere(Vertex_PNCU* verts, float radius, int stacks, int slices, Rgba8 const& color, AABB2 const& UVs)
 {
 	float yawDegDelta = 360.0f / static_cast<float>(slices);
 	float pitchDegDelta = 180.0f / static_cast<float>(stacks);
 
-	float prevCosYaw = -1.0f;
-	float prevSinYaw = -1.0f;
-
-	float prevCosPitch = -1.0f;
-	float prevSinPitch = -1.0f;
+	float prevCosYaw = 1.0f;
+	float prevSinYaw = 0.0f;
 
-	for (float yaw = yawDegDelta; yaw <= 360.0f; yaw += yawDegDelta) {
+	for (int sliceIndex = 1; sliceIndex <= slices; sliceIndex++) {
+		float yaw = yawDegDelta * static_cast<float>(sliceIndex);
 		float cosYaw = CosDegrees(yaw);
 		float sinYaw = SinDegrees(yaw);
 
-		if (yaw == yawDegDelta) {
-			prevCosYaw = CosDegrees(yaw - yawDegDelta);
-			prevSinYaw = SinDegrees(yaw - yawDegDelta);
-		}
-
 		float leftU = RangeMapClamped(yaw - yawDegDelta, 0.0f, 360.0f, UVs.m_mins.x, UVs.m_maxs.x);
 		float rightU = RangeMapClamped(yaw, 0.0f, 360.0f, UVs.m_mins.x, UVs.m_maxs.x);
-		for (float pitch = -90.0f + pitchDegDelta; pitch <= 90.0f; pitch += pitchDegDelta) {
+
+		float prevCosPitch = 0.0f;
+		float prevSinPitch = -1.0f;
+		for (int stackIndex = 1; stackIndex <= stacks; stackIndex++) {
+			float pitch = -90.0f + pitchDegDelta * static_cast<float>(stackIndex);
 			float cosPitch = CosDegrees(pitch);
 			float sinPitch = SinDegrees(pitch);
 
-			if (pitch == -90.0f + pitchDegDelta) {
-				prevCosPitch = CosDegrees(pitch - pitchDegDelta);
-				prevSinPitch = SinDegrees(pitch - pitchDegDelta);
-			}
-
-			Vec3 rightBottomPos(cosYaw * cosPitch, sinYaw * cosPitch, -sinPitch);
-			Vec3 rightTopPos(cosYaw * prevCosPitch, sinYaw * prevCosPitch, -prevSinPitch);
-			Vec3 leftTopPos(prevCosYaw * prevCosPitch, prevSinYaw * prevCosPitch, -prevSinPitch);
-			Vec3 leftBottomPos(prevCosYaw * cosPitch, prevSinYaw * cosPitch, -sinPitch);
-
-			Vec3 rightBottomNormal = rightBottomPos;
-			Vec3 leftBottomNormal = leftBottomPos;
-			Vec3 rightTopNormal = rightTopPos;
-			Vec3 leftTopNormal = rightTopNormal;
-			rightBottomPos *= radius;
-			rightTopPos *= radius;
-			leftTopPos *= radius;
-			leftBottomPos *= radius;
+			Vec3 rightBottomNormal = GetUnitSpherePosition(cosYaw, sinYaw, cosPitch, sinPitch);
+			Vec3 rightTopNormal = GetUnitSpherePosition(cosYaw, sinYaw, prevCosPitch, prevSinPitch);
+			Vec3 leftTopNormal = GetUnitSpherePosition(prevCosYaw, prevSinYaw, prevCosPitch, prevSinPitch);
+			Vec3 leftBottomNormal = GetUnitSpherePosition(prevCosYaw, prevSinYaw, cosPitch, sinPitch);
 
+			Vec3 rightBottomPos = rightBottomNormal * radius;
+			Vec3 rightTopPos = rightTopNormal * radius;
+			Vec3 leftTopPos = leftTopNormal * radius;
+			Vec3 leftBottomPos = leftBottomNormal * radius;
 
 			float topV = RangeMapClamped(pitch - pitchDegDelta, 90.0f, -90.0f, UVs.m_mins.y, UVs.m_maxs.y);
 			float bottomV = RangeMapClamped(pitch, 90.0f, -90.0f, UVs.m_mins.y, UVs.m_maxs.y);
 
-			verts.emplace_back(leftBottomPos, leftBottomNormal, color, Vec2(leftU, bottomV));
-			verts.emplace_back(rightBottomPos, rightBottomNormal, color, Vec2(rightU, bottomV));
-			verts.emplace_back(rightTopPos, rightTopNormal, color, Vec2(rightU, topV));
+			*verts++ = Vertex_PNCU(leftBottomPos, leftBottomNormal, color, Vec2(leftU, bottomV));
+			*verts++ = Vertex_PNCU(rightBottomPos, rightBottomNormal, color, Vec2(rightU, bottomV));
+			*verts++ = Vertex_PNCU(rightTopPos, rightTopNormal, color, Vec2(rightU, topV));
 
-			verts.emplace_back(leftBottomPos, leftBottomNormal, color, Vec2(leftU, bottomV));
-			verts.emplace_back(rightTopPos, rightTopNormal, color, Vec2(rightU, topV));
-			verts.emplace_back(leftTopPos, leftTopNormal, color, Vec2(leftU, topV));
+			*verts++ = Vertex_PNCU(leftBottomPos, leftBottomNormal, color, Vec2(leftU, bottomV));
+			*verts++ = Vertex_PNCU(rightTopPos, rightTopNormal, color, Vec2(rightU, topV));
+			*verts++ = Vertex_PNCU(leftTopPos, leftTopNormal, color, Vec2(leftU, topV));
 
 			prevCosPitch = cosPitch;
 			prevSinPitch = sinPitch;
@@ -812,8 +1183,87 @@ void AddVertsForSphere(std::vector<Vertex_PNCU>& verts, float radius, int stacks
 		prevCosYaw = cosYaw;
 		prevSinYaw = sinYaw;
 	}
+	return verts;
 }
-void AddVertsForWireSphere(std::vector<Vertex_PCU>& verts, float radius, int stacks, int slices, Rgba8 const& color)
+
+void AddVertsForSphere(std::vector<Vertex_PCU>& verts, float radius, int stacks, int slices, Rgba8 const& color, AABB2 const& UVs)
+{
+	AddVertsForSphere(GrowVertexArray(verts, GetVertCountForSphere(stacks, slices)), radius, stacks, slices, color, UVs);
+}
+
+void AddVertsForSphere(std::vector<Vertex_PNCU>& verts, float radius, int stacks, int slices, Rgba8 const& color, AABB2 const& UVs)
+{
+	AddVertsForSphere(GrowVertexArray(verts, GetVertCountForSphere(stacks, slices)), radius, stacks, slices, color, UVs);
+}
+
+// Grid of (slices + 1) x (stacks + 1) vertexes; the seam column is duplicated so U can wrap from 0 to 1
+static void AddIndexesForSphereGrid(std::vector<unsigned int>& indices, unsigned int firstVertex, int stacks, int slices)
+{
+	unsigned int columnHeight = (unsigned int)stacks + 1;
+	for (int sliceIndex = 0; sliceIndex < slices; sliceIndex++) {
+		unsigned int leftColumn = firstVertex + (unsigned int)sliceIndex * columnHeight;
+		unsigned int rightColumn = leftColumn + columnHeight;
+		for (int stackIndex = 0; stackIndex < stacks; stackIndex++) {
+			unsigned int leftTop = leftColumn + (unsigned int)stackIndex;
+			unsigned int rightTop = rightColumn + (unsigned int)stackIndex;
+			AddIndexesForQuad(indices, leftTop + 1, rightTop + 1, rightTop, leftTop);
+		}
+	}
+}
+
+void AddVertsForIndexedSphere(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, float radius, int stacks, int slices, Rgba8 const& color, AABB2 const& UVs)
+{
+	ReserveAdditional(indices, GetIndexCountForIndexedSphere(stacks, slices));
+	unsigned int firstVertex = (unsigned int)verts.size();
+	Vertex_PCU* sphereVerts = GrowVertexArray(verts, GetVertCountForIndexedSphere(stacks, slices));
+
+	float yawDegDelta = 360.0f / static_cast<float>(slices);
+	float pitchDegDelta = 180.0f / static_cast<float>(stacks);
+
+	for (int sliceIndex = 0; sliceIndex <= slices; sliceIndex++) {
+		float yaw = yawDegDelta * static_cast<float>(sliceIndex);
+		float cosYaw = CosDegrees(yaw);
+		float sinYaw = SinDegrees(yaw);
+		float u = RangeMapClamped(yaw, 0.0f, 360.0f, UVs.m_mins.x, UVs.m_maxs.x);
+
+		for (int stackIndex = 0; stackIndex <= stacks; stackIndex++) {
+			float pitch = -90.0f + pitchDegDelta * static_cast<float>(stackIndex);
+			float v = RangeMapClamped(pitch, 90.0f, -90.0f, UVs.m_mins.y, UVs.m_maxs.y);
+			Vec3 position = GetUnitSpherePosition(cosYaw, sinYaw, CosDegrees(pitch), SinDegrees(pitch)) * radius;
+			*sphereVerts++ = Vertex_PCU(position, color, Vec2(u, v));
+		}
+	}
+
+	AddIndexesForSphereGrid(indices, firstVertex, stacks, slices);
+}
+
+void AddVertsForIndexedSphere(std::vector<Vertex_PNCU>& verts, std::vector<unsigned int>& indices, float radius, int stacks, int slices, Rgba8 const& color, AABB2 const& UVs)
+{
+	ReserveAdditional(indices, GetIndexCountForIndexedSphere(stacks, slices));
+	unsigned int firstVertex = (unsigned int)verts.size();
+	Vertex_PNCU* sphereVerts = GrowVertexArray(verts, GetVertCountForIndexedSphere(stacks, slices));
+
+	float yawDegDelta = 360.0f / static_cast<float>(slices);
+	float pitchDegDelta = 180.0f / static_cast<float>(stacks);
+
+	for (int sliceIndex = 0; sliceIndex <= slices; sliceIndex++) {
+		float yaw = yawDegDelta * static_cast<float>(sliceIndex);
+		float cosYaw = CosDegrees(yaw);
+		float sinYaw = SinDegrees(yaw);
+		float u = RangeMapClamped(yaw, 0.0f, 360.0f, UVs.m_mins.x, UVs.m_maxs.x);
+
+		for (int stackIndex = 0; stackIndex <= stacks; stackIndex++) {
+			float pitch = -90.0f + pitchDegDelta * static_cast<float>(stackIndex);
+			float v = RangeMapClamped(pitch, 90.0f, -90.0f, UVs.m_mins.y, UVs.m_maxs.y);
+			Vec3 normal = GetUnitSpherePosition(cosYaw, sinYaw, CosDegrees(pitch), SinDegrees(pitch));
+			*sphereVerts++ = Vertex_PNCU(normal * radius, normal, color, Vec2(u, v));
+		}
+	}
+
+	AddIndexesForSphereGrid(indices, firstVertex, stacks, slices);
+}
+
+Vertex_PCU* AddVertsForWireSphere(Vertex_PCU* verts, float radius, int stacks, int slices, Rgba8 const& color)
 {
 	float yawDegDelta = 360.0f / static_cast<float>(slices);
 	float pitchDegDelta = 180.0f / static_cast<float>(stacks);
@@ -821,30 +1271,26 @@ void AddVertsForWireSphere(std::vector<Vertex_PCU>& verts, float radius, int sta
 	float prevCosYaw = 1.0f;
 	float prevSinYaw = 0.0f;
 
-	float prevCosPitch = 0.0f;
-	float prevSinPitch = -1.0f;
-
-	for (float yaw = yawDegDelta; yaw <= 360.0f; yaw += yawDegDelta) {
+	for (int sliceIndex = 1; sliceIndex <= slices; sliceIndex++) {
+		float yaw = yawDegDelta * static_cast<float>(sliceIndex);
 		float cosYaw = CosDegrees(yaw);
 		float sinYaw = SinDegrees(yaw);
 
-		for (float pitch = -90.0f + pitchDegDelta; pitch <= 90.0f; pitch += pitchDegDelta) {
+		float prevCosPitch = 0.0f;
+		float prevSinPitch = -1.0f;
+		for (int stackIndex = 1; stackIndex <= stacks; stackIndex++) {
+			float pitch = -90.0f + pitchDegDelta * static_cast<float>(stackIndex);
 			float cosPitch = CosDegrees(pitch);
 			float sinPitch = SinDegrees(pitch);
 
-			Vec3 rightBottomPos(cosYaw * cosPitch, sinYaw * cosPitch, -sinPitch);
-			Vec3 rightTopPos(cosYaw * prevCosPitch, sinYaw * prevCosPitch, -prevSinPitch);
-			Vec3 leftTopPos(prevCosYaw * prevCosPitch, prevSinYaw * prevCosPitch, -prevSinPitch);
-			Vec3 leftBottomPos(prevCosYaw * cosPitch, prevSinYaw * cosPitch, -sinPitch);
+			Vec3 rightBottomPos = GetUnitSpherePosition(cosYaw, sinYaw, cosPitch, sinPitch) * radius;
+			Vec3 rightTopPos = GetUnitSpherePosition(cosYaw, sinYaw, prevCosPitch, prevSinPitch) * radius;
+			Vec3 leftTopPos = GetUnitSpherePosition(prevCosYaw, prevSinYaw, prevCosPitch, prevSinPitch) * radius;
+			Vec3 leftBottomPos = GetUnitSpherePosition(prevCosYaw, prevSinYaw, cosPitch, sinPitch) * radius;
 
-			rightBottomPos *= radius;
-			rightTopPos *= radius;
-			leftTopPos *= radius;
-			leftBottomPos *= radius;
-
-			AddVertsForLineSegment3D(verts, leftBottomPos, rightBottomPos, color);
-			AddVertsForLineSegment3D(verts, rightBottomPos, rightTopPos, color);
-			AddVertsForLineSegment3D(verts, leftTopPos, rightTopPos, color);
+			verts = AddVertsForLineSegment3D(verts, leftBottomPos, rightBottomPos, color);
+			verts = AddVertsForLineSegment3D(verts, rightBottomPos, rightTopPos, color);
+			verts = AddVertsForLineSegment3D(verts, leftTopPos, rightTopPos, color);
 
 			prevCosPitch = cosPitch;
 			prevSinPitch = sinPitch;
@@ -852,41 +1298,32 @@ void AddVertsForWireSphere(std::vector<Vertex_PCU>& verts, float radius, int sta
 
 		prevCosYaw = cosYaw;
 		prevSinYaw = sinYaw;
-		prevCosPitch = 0.0f;
-		prevSinPitch = -1.0f;
 	}
+	return verts;
 }
 
-void AddVertsForCylinder(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
+void AddVertsForWireSphere(std::vector<Vertex_PCU>& verts, float radius, int stacks, int slices, Rgba8 const& color)
 {
-	verts.reserve(size_t(8) * slices);
+	AddVertsForWireSphere(GrowVertexArray(verts, GetVertCountForWireSphere(stacks, slices)), radius, stacks, slices, color);
+}
 
+Vertex_PCU* AddVertsForCylinder(Vertex_PCU* verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
+{
 	Vec3 kBasis = (end - start).GetNormalized();
-	Vec3 worldIBasis = Vec3(1.0, 0.0f, 0.0f);
-	Vec3 worldJBasis = Vec3(0.0f, 1.0, 0.0f);
-
-	Vec3 jBasis, iBasis;
-
-	if (fabsf(DotProduct3D(kBasis, worldIBasis)) < 1) {
-		jBasis = CrossProduct3D(kBasis, worldIBasis).GetNormalized();
-		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
-	}
-	else {
-		jBasis = CrossProduct3D(kBasis, worldJBasis).GetNormalized();
-		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
-	}
+	Vec3 iBasis, jBasis;
+	GetPerpendicularBases(kBasis, iBasis, jBasis);
 	iBasis *= radius;
 	jBasis *= radius;
 
 	float degDelta = 360.0f / static_cast<float>(slices);
 
-
 	float prevCosYaw = 1.0f;
 	float prevSinYaw = 0.0f;
 	float leftU = UVs.m_mins.x;
 	Vec2 midUVs = (UVs.m_maxs + UVs.m_mins) * 0.5f;
 
-	for (float yaw = degDelta; yaw <= 360.0f; yaw += degDelta) {
+	for (int sliceIndex = 1; sliceIndex <= slices; sliceIndex++) {
+		float yaw = degDelta * static_cast<float>(sliceIndex);
 		float sinYaw = SinDegrees(yaw);
 		float cosYaw = CosDegrees(yaw);
 
@@ -898,13 +1335,13 @@ void AddVertsForCylinder(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3
 
 		float rightU = RangeMapClamped(yaw, 0.0f, 360.0f, UVs.m_mins.x, UVs.m_maxs.x);
 
-		verts.emplace_back(bottomLeft, color, Vec2(leftU, UVs.m_mins.y));
-		verts.emplace_back(bottomRight, color, Vec2(rightU, UVs.m_mins.y));
-		verts.emplace_back(topRight, color, Vec2(rightU, UVs.m_maxs.y));
+		*verts++ = Vertex_PCU(bottomLeft, color, Vec2(leftU, UVs.m_mins.y));
+		*verts++ = Vertex_PCU(bottomRight, color, Vec2(rightU, UVs.m_mins.y));
+		*verts++ = Vertex_PCU(topRight, color, Vec2(rightU, UVs.m_maxs.y));
 
-		verts.emplace_back(bottomLeft, color, Vec2(leftU, UVs.m_mins.y));
-		verts.emplace_back(topRight, color, Vec2(rightU, UVs.m_maxs.y));
-		verts.emplace_back(topLeft, color, Vec2(leftU, UVs.m_maxs.y));
+		*verts++ = Vertex_PCU(bottomLeft, color, Vec2(leftU, UVs.m_mins.y));
+		*verts++ = Vertex_PCU(topRight, color, Vec2(rightU, UVs.m_maxs.y));
+		*verts++ = Vertex_PCU(topLeft, color, Vec2(leftU, UVs.m_maxs.y));
 
 		float leftTopU = midUVs.x + RangeMap(prevCosYaw, 0.0f, 1.0f, 0.0f, midUVs.x);
 		float rightTopU = midUVs.x + RangeMap(cosYaw, 0.0f, 1.0f, 0.0f, midUVs.x);
@@ -912,40 +1349,93 @@ void AddVertsForCylinder(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3
 		float leftTopV = midUVs.y + RangeMap(prevSinYaw, 0.0f, 1.0f, 0.0f, midUVs.y);
 		float rightTopV = midUVs.y + RangeMap(sinYaw, 0.0f, 1.0f, 0.0f, midUVs.y);
 
+		*verts++ = Vertex_PCU(start, color, midUVs);
+		*verts++ = Vertex_PCU(bottomRight, color, Vec2(rightTopU, UVs.m_maxs.y - rightTopV));
+		*verts++ = Vertex_PCU(bottomLeft, color, Vec2(leftTopU, UVs.m_maxs.y - leftTopV));
 
-		verts.emplace_back(start, color, midUVs);
-		verts.emplace_back(bottomRight, color, Vec2(rightTopU, UVs.m_maxs.y - rightTopV));
-		verts.emplace_back(bottomLeft, color, Vec2(leftTopU, UVs.m_maxs.y - leftTopV));
-
-		verts.emplace_back(end, color, midUVs);
-		verts.emplace_back(topLeft, color, Vec2(leftTopU, leftTopV));
-		verts.emplace_back(topRight, color, Vec2(rightTopU, rightTopV));
+		*verts++ = Vertex_PCU(end, color, midUVs);
+		*verts++ = Vertex_PCU(topLeft, color, Vec2(leftTopU, leftTopV));
+		*verts++ = Vertex_PCU(topRight, color, Vec2(rightTopU, rightTopV));
 
 		leftU = rightU;
 		prevCosYaw = cosYaw;
 		prevSinYaw = sinYaw;
 	}
+	return verts;
+}
 
+void AddVertsForCylinder(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
+{
+	AddVertsForCylinder(GrowVertexArray(verts, GetVertCountForCylinder(slices)), start, end, radius, slices, color, UVs);
 }
 
-void AddVertsForWireCylinder(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color)
+void AddVertsForIndexedCylinder(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
 {
-	verts.reserve(size_t(18) * slices);
+	ReserveAdditional(indices, GetIndexCountForIndexedCylinder(slices));
+	unsigned int firstVertex = (unsigned int)verts.size();
+	Vertex_PCU* cylinderVerts = GrowVertexArray(verts, GetVertCountForIndexedCylinder(slices));
 
 	Vec3 kBasis = (end - start).GetNormalized();
-	Vec3 worldIBasis = Vec3(1.0, 0.0f, 0.0f);
-	Vec3 worldJBasis = Vec3(0.0f, 1.0, 0.0f);
+	Vec3 iBasis, jBasis;
+	GetPerpendicularBases(kBasis, iBasis, jBasis);
+	iBasis *= radius;
+	jBasis *= radius;
+
+	float degDelta = 360.0f / static_cast<float>(slices);
+	Vec2 midUVs = (UVs.m_maxs + UVs.m_mins) * 0.5f;
 
-	Vec3 jBasis, iBasis;
+	unsigned int ringSize = (unsigned int)slices + 1;
+	unsigned int sideBottomRing = firstVertex;
+	unsigned int sideTopRing = sideBottomRing + ringSize;
+	unsigned int bottomCenter = sideTopRing + ringSize;
+	unsigned int bottomCapRing = bottomCenter + 1;
+	unsigned int topCenter = bottomCapRing + ringSize;
+	unsigned int topCapRing = topCenter + 1;
 
-	if (DotProduct3D(kBasis, worldIBasis) < 1) {
-		jBasis = CrossProduct3D(kBasis, worldIBasis).GetNormalized();
-		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
+	Vertex_PCU* bottomSide = cylinderVerts;
+	Vertex_PCU* topSide = bottomSide + ringSize;
+	Vertex_PCU* bottomCap = topSide + ringSize;
+	Vertex_PCU* topCap = bottomCap + ringSize + 1;
+
+	*bottomCap++ = Vertex_PCU(start, color, midUVs);
+	*topCap++ = Vertex_PCU(end, color, midUVs);
+
+	for (int sliceIndex = 0; sliceIndex <= slices; sliceIndex++) {
+		float yaw = degDelta * static_cast<float>(sliceIndex);
+		float sinYaw = SinDegrees(yaw);
+		float cosYaw = CosDegrees(yaw);
+
+		Vec3 bottomPos = (iBasis * cosYaw) + (jBasis * sinYaw) + start;
+		Vec3 topPos = (iBasis * cosYaw) + (jBasis * sinYaw) + end;
+		float u = RangeMapClamped(yaw, 0.0f, 360.0f, UVs.m_mins.x, UVs.m_maxs.x);
+
+		float capU = midUVs.x + RangeMap(cosYaw, 0.0f, 1.0f, 0.0f, midUVs.x);
+		float capV = midUVs.y + RangeMap(sinYaw, 0.0f, 1.0f, 0.0f, midUVs.y);
+
+		*bottomSide++ = Vertex_PCU(bottomPos, color, Vec2(u, UVs.m_mins.y));
+		*topSide++ = Vertex_PCU(topPos, color, Vec2(u, UVs.m_maxs.y));
+		*bottomCap++ = Vertex_PCU(bottomPos, color, Vec2(capU, UVs.m_maxs.y - capV));
+		*topCap++ = Vertex_PCU(topPos, color, Vec2(capU, capV));
 	}
-	else {
-		jBasis = CrossProduct3D(kBasis, worldJBasis).GetNormalized();
-		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
+
+	for (unsigned int sliceIndex = 0; sliceIndex < (unsigned int)slices; sliceIndex++) {
+		AddIndexesForQuad(indices, sideBottomRing + sliceIndex, sideBottomRing + sliceIndex + 1, sideTopRing + sliceIndex + 1, sideTopRing + sliceIndex);
+
+		indices.push_back(bottomCenter);
+		indices.push_back(bottomCapRing + sliceIndex + 1);
+		indices.push_back(bottomCapRing + sliceIndex);
+
+		indices.push_back(topCenter);
+		indices.push_back(topCapRing + sliceIndex);
+		indices.push_back(topCapRing + sliceIndex + 1);
 	}
+}
+
+Vertex_PCU* AddVertsForWireCylinder(Vertex_PCU* verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color)
+{
+	Vec3 kBasis = (end - start).GetNormalized();
+	Vec3 iBasis, jBasis;
+	GetPerpendicularBases(kBasis, iBasis, jBasis);
 	iBasis *= radius;
 	jBasis *= radius;
 
@@ -954,7 +1444,8 @@ void AddVertsForWireCylinder(std::vector<Vertex_PCU>& verts, Vec3 const& start,
 	float prevCosYaw = 1.0f;
 	float prevSinYaw = 0.0f;
 
-	for (float yaw = degDelta; yaw <= 360.0f; yaw += degDelta) {
+	for (int sliceIndex = 1; sliceIndex <= slices; sliceIndex++) {
+		float yaw = degDelta * static_cast<float>(sliceIndex);
 		float sinYaw = SinDegrees(yaw);
 		float cosYaw = CosDegrees(yaw);
 
@@ -964,33 +1455,26 @@ void AddVertsForWireCylinder(std::vector<Vertex_PCU>& verts, Vec3 const& start,
 		Vec3 topLeft = (iBasis * prevCosYaw) + (jBasis * prevSinYaw) + end;
 		Vec3 topRight = (iBasis * cosYaw) + (jBasis * sinYaw) + end;
 
-		AddVertsForLineSegment3D(verts, bottomLeft, bottomRight, color);
-		AddVertsForLineSegment3D(verts, bottomRight, topRight, color);
-		AddVertsForLineSegment3D(verts, topLeft, topRight, color);
+		verts = AddVertsForLineSegment3D(verts, bottomLeft, bottomRight, color);
+		verts = AddVertsForLineSegment3D(verts, bottomRight, topRight, color);
+		verts = AddVertsForLineSegment3D(verts, topLeft, topRight, color);
 
 		prevCosYaw = cosYaw;
 		prevSinYaw = sinYaw;
 	}
+	return verts;
 }
 
-void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
+void AddVertsForWireCylinder(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color)
 {
-	verts.reserve(size_t(6) * slices);
+	AddVertsForWireCylinder(GrowVertexArray(verts, GetVertCountForWireCylinder(slices)), start, end, radius, slices, color);
+}
 
+Vertex_PCU* AddVertsForCone3D(Vertex_PCU* verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
+{
 	Vec3 kBasis = (end - start).GetNormalized();
-	Vec3 worldIBasis = Vec3(1.0, 0.0f, 0.0f);
-	Vec3 worldJBasis = Vec3(0.0f, 1.0, 0.0f);
-
-	Vec3 jBasis, iBasis;
-
-	if (fabsf(DotProduct3D(kBasis, worldIBasis)) < 1) {
-		jBasis = CrossProduct3D(kBasis, worldIBasis).GetNormalized();
-		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
-	}
-	else {
-		jBasis = CrossProduct3D(kBasis, worldJBasis).GetNormalized();
-		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
-	}
+	Vec3 iBasis, jBasis;
+	GetPerpendicularBases(kBasis, iBasis, jBasis);
 	iBasis *= radius;
 	jBasis *= radius;
 
@@ -1001,7 +1485,8 @@ void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 c
 	float leftU = UVs.m_mins.x;
 	Vec2 midUVs = (UVs.m_maxs + UVs.m_mins) * 0.5f;
 
-	for (float yaw = degDelta; yaw <= 360.0f; yaw += degDelta) {
+	for (int sliceIndex = 1; sliceIndex <= slices; sliceIndex++) {
+		float yaw = degDelta * static_cast<float>(sliceIndex);
 		float sinYaw = SinDegrees(yaw);
 		float cosYaw = CosDegrees(yaw);
 
@@ -1010,9 +1495,9 @@ void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 c
 
 		float rightU = RangeMapClamped(yaw, 0.0f, 360.0f, UVs.m_mins.x, UVs.m_maxs.x);
 
-		verts.emplace_back(bottomLeft, color, Vec2(leftU, UVs.m_mins.y));
-		verts.emplace_back(bottomRight, color, Vec2(rightU, UVs.m_mins.y));
-		verts.emplace_back(end, color, Vec2(rightU, UVs.m_maxs.y));
+		*verts++ = Vertex_PCU(bottomLeft, color, Vec2(leftU, UVs.m_mins.y));
+		*verts++ = Vertex_PCU(bottomRight, color, Vec2(rightU, UVs.m_mins.y));
+		*verts++ = Vertex_PCU(end, color, Vec2(rightU, UVs.m_maxs.y));
 
 		float leftTopU = midUVs.x + RangeMap(prevCosYaw, 0.0f, 1.0f, 0.0f, midUVs.x);
 		float rightTopU = midUVs.x + RangeMap(cosYaw, 0.0f, 1.0f, 0.0f, midUVs.x);
@@ -1020,35 +1505,84 @@ void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 c
 		float leftTopV = midUVs.y + RangeMap(prevSinYaw, 0.0f, 1.0f, 0.0f, midUVs.y);
 		float rightTopV = midUVs.y + RangeMap(sinYaw, 0.0f, 1.0f, 0.0f, midUVs.y);
 
-
-		verts.emplace_back(start, color, midUVs);
-		verts.emplace_back(bottomRight, color, Vec2(rightTopU, UVs.m_maxs.y - rightTopV));
-		verts.emplace_back(bottomLeft, color, Vec2(leftTopU, UVs.m_maxs.y - leftTopV));
+		*verts++ = Vertex_PCU(start, color, midUVs);
+		*verts++ = Vertex_PCU(bottomRight, color, Vec2(rightTopU, UVs.m_maxs.y - rightTopV));
+		*verts++ = Vertex_PCU(bottomLeft, color, Vec2(leftTopU, UVs.m_maxs.y - leftTopV));
 
 		leftU = rightU;
 		prevCosYaw = cosYaw;
 		prevSinYaw = sinYaw;
 	}
+	return verts;
 }
 
-void AddVertsForWireCone3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
+void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
+{
+	AddVertsForCone3D(GrowVertexArray(verts, GetVertCountForCone3D(slices)), start, end, radius, slices, color, UVs);
+}
+
+void AddVertsForIndexedCone3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
 {
-	verts.reserve(size_t(6) * slices);
+	ReserveAdditional(indices, GetIndexCountForIndexedCone3D(slices));
+	unsigned int firstVertex = (unsigned int)verts.size();
+	Vertex_PCU* coneVerts = GrowVertexArray(verts, GetVertCountForIndexedCone3D(slices));
 
 	Vec3 kBasis = (end - start).GetNormalized();
-	Vec3 worldIBasis = Vec3(1.0, 0.0f, 0.0f);
-	Vec3 worldJBasis = Vec3(0.0f, 1.0, 0.0f);
+	Vec3 iBasis, jBasis;
+	GetPerpendicularBases(kBasis, iBasis, jBasis);
+	iBasis *= radius;
+	jBasis *= radius;
 
-	Vec3 jBasis, iBasis;
+	float degDelta = 360.0f / static_cast<float>(slices);
+	Vec2 midUVs = (UVs.m_maxs + UVs.m_mins) * 0.5f;
 
-	if (fabsf(DotProduct3D(kBasis, worldIBasis)) < 1) {
-		jBasis = CrossProduct3D(kBasis, worldIBasis).GetNormalized();
-		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
+	unsigned int ringSize = (unsigned int)slices + 1;
+	unsigned int sideRing = firstVertex;
+	unsigned int tips = sideRing + ringSize;
+	unsigned int baseCenter = tips + (unsigned int)slices;
+	unsigned int baseRing = baseCenter + 1;
+
+	Vertex_PCU* sideVerts = coneVerts;
+	Vertex_PCU* tipVerts = sideVerts + ringSize;
+	Vertex_PCU* baseVerts = tipVerts + slices;
+
+	*baseVerts++ = Vertex_PCU(start, color, midUVs);
+
+	for (int sliceIndex = 0; sliceIndex <= slices; sliceIndex++) {
+		float yaw = degDelta * static_cast<float>(sliceIndex);
+		float sinYaw = SinDegrees(yaw);
+		float cosYaw = CosDegrees(yaw);
+
+		Vec3 ringPos = (iBasis * cosYaw) + (jBasis * sinYaw) + start;
+		float u = RangeMapClamped(yaw, 0.0f, 360.0f, UVs.m_mins.x, UVs.m_maxs.x);
+
+		float baseU = midUVs.x + RangeMap(cosYaw, 0.0f, 1.0f, 0.0f, midUVs.x);
+		float baseV = midUVs.y + RangeMap(sinYaw, 0.0f, 1.0f, 0.0f, midUVs.y);
+
+		*sideVerts++ = Vertex_PCU(ringPos, color, Vec2(u, UVs.m_mins.y));
+		*baseVerts++ = Vertex_PCU(ringPos, color, Vec2(baseU, UVs.m_maxs.y - baseV));
+		if (sliceIndex > 0) {
+			*tipVerts++ = Vertex_PCU(end, color, Vec2(u, UVs.m_maxs.y));
+		}
 	}
-	else {
-		jBasis = CrossProduct3D(kBasis, worldJBasis).GetNormalized();
-		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
+
+	for (unsigned int sliceIndex = 0; sliceIndex < (unsigned int)slices; sliceIndex++) {
+		indices.push_back(sideRing + sliceIndex);
+		indices.push_back(sideRing + sliceIndex + 1);
+		indices.push_back(tips + sliceIndex);
+
+		indices.push_back(baseCenter);
+		indices.push_back(baseRing + sliceIndex + 1);
+		indices.push_back(baseRing + sliceIndex);
 	}
+}
+
+Vertex_PCU* AddVertsForWireCone3D(Vertex_PCU* verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
+{
+	UNUSED(UVs);
+	Vec3 kBasis = (end - start).GetNormalized();
+	Vec3 iBasis, jBasis;
+	GetPerpendicularBases(kBasis, iBasis, jBasis);
 	iBasis *= radius;
 	jBasis *= radius;
 
@@ -1056,49 +1590,57 @@ void AddVertsForWireCone3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Ve
 
 	float prevCosYaw = 1.0f;
 	float prevSinYaw = 0.0f;
-	Vec2 midUVs = (UVs.m_maxs + UVs.m_mins) * 0.5f;
 
-	for (float yaw = degDelta; yaw <= 360.0f; yaw += degDelta) {
+	for (int sliceIndex = 1; sliceIndex <= slices; sliceIndex++) {
+		float yaw = degDelta * static_cast<float>(sliceIndex);
 		float sinYaw = SinDegrees(yaw);
 		float cosYaw = CosDegrees(yaw);
 
 		Vec3 bottomLeft = (iBasis * prevCosYaw) + (jBasis * prevSinYaw) + start;
 		Vec3 bottomRight = (iBasis * cosYaw) + (jBasis * sinYaw) + start;
 
-		AddVertsForLineSegment3D(verts, bottomLeft, bottomRight, color, 0.001f);
-		AddVertsForLineSegment3D(verts, bottomLeft, end, color, 0.001f);
-		AddVertsForLineSegment3D(verts, bottomRight, end, color, 0.001f);
+		verts = AddVertsForLineSegment3D(verts, bottomLeft, bottomRight, color, 0.001f);
+		verts = AddVertsForLineSegment3D(verts, bottomLeft, end, color, 0.001f);
+		verts = AddVertsForLineSegment3D(verts, bottomRight, end, color, 0.001f);
 
 		prevCosYaw = cosYaw;
 		prevSinYaw = sinYaw;
 	}
+	return verts;
 }
 
-void AddVertsForArrow3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
+void AddVertsForWireCone3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
+{
+	AddVertsForWireCone3D(GrowVertexArray(verts, GetVertCountForWireCone3D(slices)), start, end, radius, slices, color, UVs);
+}
+
+Vertex_PCU* AddVertsForArrow3D(Vertex_PCU* verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
 {
 	Vec3 kBasis = (end - start).GetNormalized();
-	Vec3 worldIBasis = Vec3(1.0, 0.0f, 0.0f);
-	Vec3 worldJBasis = Vec3(0.0f, 1.0, 0.0f);
+	float arrowLength = (end - start).GetLength();
+	Vec3 arrowBodyEnd = start + (kBasis * arrowLength * 0.85f);
+	verts = AddVertsForCylinder(verts, start, arrowBodyEnd, radius, slices, color, UVs);
+	return AddVertsForCone3D(verts, arrowBodyEnd, end, radius * 1.5f, slices, color, UVs);
+}
 
-	Vec3 jBasis, iBasis;
+void AddVertsForArrow3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
+{
+	AddVertsForArrow3D(GrowVertexArray(verts, GetVertCountForArrow3D(slices)), start, end, radius, slices, color, UVs);
+}
 
-	if (fabsf(DotProduct3D(kBasis, worldIBasis)) < 1) {
-		jBasis = CrossProduct3D(kBasis, worldIBasis).GetNormalized();
-		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
-	}
-	else {
-		jBasis = CrossProduct3D(kBasis, worldJBasis).GetNormalized();
-		iBasis = CrossProduct3D(jBasis, kBasis).GetNormalized();
-	}
+void AddVertsForIndexedArrow3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, Vec3 const& start, Vec3 const& end, float radius, int slices, Rgba8 const& color, AABB2 const& UVs)
+{
+	ReserveAdditional(verts, GetVertCountForIndexedArrow3D(slices));
+	ReserveAdditional(indices, GetIndexCountForIndexedArrow3D(slices));
 
+	Vec3 kBasis = (end - start).GetNormalized();
 	float arrowLength = (end - start).GetLength();
 	Vec3 arrowBodyEnd = start + (kBasis * arrowLength * 0.85f);
-	AddVertsForCylinder(verts, start, arrowBodyEnd, radius, slices, color, UVs);
-	AddVertsForCone3D(verts, arrowBodyEnd, end, radius * 1.5f, slices, color, UVs);
-
+	AddVertsForIndexedCylinder(verts, indices, start, arrowBodyEnd, radius, slices, color, UVs);
+	AddVertsForIndexedCone3D(verts, indices, arrowBodyEnd, end, radius * 1.5f, slices, color, UVs);
 }
 
-void AddVertsForBasis3D(std::vector<Vertex_PCU>& verts, Mat44 const& model, float basisSize, float lineThickness)
+Vertex_PCU* AddVertsForBasis3D(Vertex_PCU* verts, Mat44 const& model, float basisSize, float lineThickness)
 {
 	Vec3 iBasis = model.GetIBasis3D().GetNormalized();
 	Vec3 jBasis = model.GetJBasis3D().GetNormalized();
@@ -1110,7 +1652,12 @@ void AddVertsForBasis3D(std::vector<Vertex_PCU>& verts, Mat44 const& model, floa
 
 	Vec3 const translation = model.GetTranslation3D();
 
-	AddVertsForLineSegment3D(verts, translation, translation + iBasis, Rgba8::RED, lineThickness);
-	AddVertsForLineSegment3D(verts, translation, translation + jBasis, Rgba8::GREEN, lineThickness);
-	AddVertsForLineSegment3D(verts, translation, translation + kBasis, Rgba8::BLUE, lineThickness);
+	verts = AddVertsForLineSegment3D(verts, translation, translation + iBasis, Rgba8::RED, lineThickness);
+	verts = AddVertsForLineSegment3D(verts, translation, translation + jBasis, Rgba8::GREEN, lineThickness);
+	return AddVertsForLineSegment3D(verts, translation, translation + kBasis, Rgba8::BLUE, lineThickness);
+}
+
+void AddVertsForBasis3D(std::vector<Vertex_PCU>& verts, Mat44 const& model, float basisSize, float lineThickness)
+{
+	AddVertsForBasis3D(GrowVertexArray(verts, GetVertCountForBasis3D()), model, basisSize, lineThickness);
 }
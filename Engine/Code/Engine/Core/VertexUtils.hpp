@@ -15,6 +15,52 @@ struct DelaunayConvexPoly2D;
 class ConvexPoly2D;
 class ConvexHull2D;
 
+// Batch transforms over strided arrays, so they work on any vertex layout. Stride is in bytes
+void TransformPositionsStrided3D(int numPositions, float* firstPosition, size_t strideInBytes, Mat44 const& transform);
+void TransformNormalsStrided3D(int numNormals, float* firstNormal, size_t strideInBytes, Mat44 const& transform);
+
+// Exact vertex counts each builder writes, so callers can reserve up front or size a stack array for the pointer overloads
+int GetVertCountForAABB2D();
+int GetVertCountForHollowAABB2D();
+int GetVertCountForOBB2D();
+int GetVertCountForDisc2D(int sectionsAmount = 60);
+int GetVertCountForLineSegment2D();
+int GetVertCountForCapsule2D(int amountSectorsCapsEnds = 32);
+int GetVertCountForArrow2D();
+int GetVertCountForDelaunayConvexPoly2D(DelaunayConvexPoly2D const& convexPoly);
+int GetVertCountForWireDelaunayConvexPoly2D(DelaunayConvexPoly2D const& convexPoly);
+int GetVertCountForConvexPoly2D(ConvexPoly2D const& convexPoly);
+int GetVertCountForWireConvexPoly2D(ConvexPoly2D const& convexPoly);
+int GetVertCountForConvexHull2D(ConvexHull2D const& convexHull);
+int GetVertCountForQuad3D();
+int GetVertCountForRoundedQuad3D();
+int GetVertCountForLineSegment3D();
+int GetVertCountForAABB3D();
+int GetVertCountForWireAABB3D();
+int GetVertCountForSphere(int stacks = 16, int slices = 32);
+int GetVertCountForWireSphere(int stacks = 16, int slices = 32);
+int GetVertCountForCylinder(int slices = 16);
+int GetVertCountForWireCylinder(int slices = 16);
+int GetVertCountForCone3D(int slices = 16);
+int GetVertCountForWireCone3D(int slices = 16);
+int GetVertCountForArrow3D(int slices = 16);
+int GetVertCountForBasis3D();
+
+int GetVertCountForIndexedQuad3D();
+int GetIndexCountForIndexedQuad3D();
+int GetVertCountForIndexedAABB3D();
+int GetIndexCountForIndexedAABB3D();
+int GetVertCountForIndexedLineSegment3D();
+int GetIndexCountForIndexedLineSegment3D();
+int GetVertCountForIndexedSphere(int stacks = 16, int slices = 32);
+int GetIndexCountForIndexedSphere(int stacks = 16, int slices = 32);
+int GetVertCountForIndexedCylinder(int slices = 16);
+int GetIndexCountForIndexedCylinder(int slices = 16);
+int GetVertCountForIndexedCone3D(int slices = 16);
+int GetIndexCountForIndexedCone3D(int slices = 16);
+int GetVertCountForIndexedArrow3D(int slices = 16);
+int GetIndexCountForIndexedArrow3D(int slices = 16);
+
 // 2D 
 void TransformVertexArrayXY3D(int numVerts, Vertex_PCU* verts, float uniformScaleXY, float rotationDegreesAboutZ, Vec2 const& translationXY);
 void TransformVertexArrayXY3D(int numVerts, Vertex_PCU* verts, Vec2 const& iBasis, Vec2 const& jBasis, Vec2 const& translationXY);
@@ -33,12 +79,28 @@ void AddVertsForConvexPoly2D(std::vector<Vertex_PCU>& verts, ConvexPoly2D const&
 void AddVertsForWireConvexPoly2D(std::vector<Vertex_PCU>& verts, ConvexPoly2D const& convexPoly, Rgba8 const& borderColor, float lineThickness = 0.5f);
 void AddVertsForConvexHull2D(std::vector<Vertex_PCU>& verts, ConvexHull2D const& convexHull, Rgba8 const& color, float planeDrawDistance, float lineThickness = 0.5f);
 
+// 2D, writing through a pointer. The caller guarantees room for GetVertCountFor* vertexes; returns one past the last vertex written
+Vertex_PCU* AddVertsForAABB2D(Vertex_PCU* verts, AABB2 const& bounds, Rgba8 const& tint, AABB2 UVs = AABB2::ZERO_TO_ONE);
+Vertex_PCU* AddVertsForAABB2D(Vertex_PCU* verts, AABB2 const& bounds, Rgba8 const& tint, const Vec2& uvAtMins, const Vec2& uvAtMaxs);
+Vertex_PCU* AddVertsForHollowAABB2D(Vertex_PCU* verts, AABB2 const& bounds, float radius, Rgba8 const& tint);
+Vertex_PCU* AddVertsForOBB2D(Vertex_PCU* verts, OBB2 const& bounds, Rgba8 const& tint, const Vec2& uvAtMins = Vec2::ZERO, const Vec2& uvAtMaxs = Vec2::ONE);
+Vertex_PCU* AddVertsForOBB2D(Vertex_PCU* verts, OBB2 const& bounds, Rgba8 const& tint, AABB2 UVs);
+Vertex_PCU* AddVertsForDisc2D(Vertex_PCU* verts, Vec2 const& discCenter, float radius, Rgba8 tint, int sectionsAmount = 60);
+Vertex_PCU* AddVertsForLineSegment2D(Vertex_PCU* verts, LineSegment2 const& lineSegment, Rgba8 tint, float lineWidth = 0.2f, bool overhead = true);
+Vertex_PCU* AddVertsForCapsule2D(Vertex_PCU* verts, Capsule2 const& capsule, Rgba8 tint, int amountSectorsCapsEnds = 32);
+Vertex_PCU* AddVertsForArrow2D(Vertex_PCU* verts, Vec2 const& arrowStart, Vec2 const& arrowEnd, Rgba8 color = Rgba8::WHITE, float arrowBodySize = 0.2f, float arrowHeadSize = 2.0f);
+Vertex_PCU* AddVertsForDelaunayConvexPoly2D(Vertex_PCU* verts, DelaunayConvexPoly2D const& convexPoly, Rgba8 const& color, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+Vertex_PCU* AddVertsForWireDelaunayConvexPoly2D(Vertex_PCU* verts, DelaunayConvexPoly2D const& convexPoly, Rgba8 const& color, float lineThickness = 0.5f);
+Vertex_PCU* AddVertsForConvexPoly2D(Vertex_PCU* verts, ConvexPoly2D const& convexPoly, Rgba8 const& color);
+Vertex_PCU* AddVertsForWireConvexPoly2D(Vertex_PCU* verts, ConvexPoly2D const& convexPoly, Rgba8 const& borderColor, float lineThickness = 0.5f);
+Vertex_PCU* AddVertsForConvexHull2D(Vertex_PCU* verts, ConvexHull2D const& convexHull, Rgba8 const& color, float planeDrawDistance, float lineThickness = 0.5f);
+
 // 3D 
 void TransformVertexArray3D(int numVerts, Vertex_PCU* verts, Mat44 const& model);
+void TransformVertexArray3D(int numVerts, Vertex_PNCU* verts, Mat44 const& model);
 void AddVertsForLineSegment3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, Rgba8 const& color = Rgba8::WHITE,float thickness = 0.0125f);
 void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
 void AddVertsForAABB3D(std::vector<Vertex_PNCU>& verts, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
-void AddVertsForIndexedAABB3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
 void AddVertsForWireAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE);
 void AddVertsForSphere(std::vector<Vertex_PCU>& verts, float radius, int stacks = 16, int slices = 32, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
 void AddVertsForSphere(std::vector<Vertex_PNCU>& verts, float radius, int stacks = 16, int slices = 32, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
@@ -51,6 +113,34 @@ void AddVertsForArrow3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3
 void AddVertsForBasis3D(std::vector<Vertex_PCU>& verts, Mat44 const& model, float basisSize, float lineThickness);
 void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
 void AddVertsForQuad3D(std::vector<Vertex_PNCU>& verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
-void AddVertsForRoundedQuad3D(std::vector<Vertex_PNCU>& vertexes, Vec3 const& topLeft, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForRoundedQuad3D(std::vector<Vertex_PNCU>& vertexes, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+
+// 3D, writing through a pointer. Same contract as the 2D pointer overloads
+Vertex_PCU* AddVertsForLineSegment3D(Vertex_PCU* verts, Vec3 const& start, Vec3 const& end, Rgba8 const& color = Rgba8::WHITE, float thickness = 0.0125f);
+Vertex_PCU* AddVertsForAABB3D(Vertex_PCU* verts, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+Vertex_PNCU* AddVertsForAABB3D(Vertex_PNCU* verts, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+Vertex_PCU* AddVertsForWireAABB3D(Vertex_PCU* verts, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE);
+Vertex_PCU* AddVertsForSphere(Vertex_PCU* verts, float radius, int stacks = 16, int slices = 32, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+Vertex_PNCU* AddVertsForSphere(Vertex_PNCU* verts, float radius, int stacks = 16, int slices = 32, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+Vertex_PCU* AddVertsForWireSphere(Vertex_PCU* verts, float radius, int stacks = 16, int slices = 32, Rgba8 const& color = Rgba8::WHITE);
+Vertex_PCU* AddVertsForCylinder(Vertex_PCU* verts, Vec3 const& start, Vec3 const& end, float radius, int slices = 16, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+Vertex_PCU* AddVertsForWireCylinder(Vertex_PCU* verts, Vec3 const& start, Vec3 const& end, float radius, int slices = 16, Rgba8 const& color = Rgba8::WHITE);
+Vertex_PCU* AddVertsForCone3D(Vertex_PCU* verts, Vec3 const& start, Vec3 const& end, float radius, int slices = 16, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+Vertex_PCU* AddVertsForWireCone3D(Vertex_PCU* verts, Vec3 const& start, Vec3 const& end, float radius, int slices = 16, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+Vertex_PCU* AddVertsForArrow3D(Vertex_PCU* verts, Vec3 const& start, Vec3 const& end, float radius, int slices = 16, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+Vertex_PCU* AddVertsForBasis3D(Vertex_PCU* verts, Mat44 const& model, float basisSize, float lineThickness);
+Vertex_PCU* AddVertsForQuad3D(Vertex_PCU* verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+Vertex_PNCU* AddVertsForQuad3D(Vertex_PNCU* verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+Vertex_PNCU* AddVertsForRoundedQuad3D(Vertex_PNCU* verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+
+// 3D indexed. Shared vertexes are emitted once, so these are the cheaper choice for meshes that get uploaded and kept
 void AddVertsForIndexedQuad3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
 void AddVertsForIndexedQuad3D(std::vector<Vertex_PNCU>& verts, std::vector<unsigned int>& indices, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForIndexedAABB3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForIndexedAABB3D(std::vector<Vertex_PNCU>& verts, std::vector<unsigned int>& indices, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForIndexedLineSegment3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, Vec3 const& start, Vec3 const& end, Rgba8 const& color = Rgba8::WHITE, float thickness = 0.0125f);
+void AddVertsForIndexedSphere(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, float radius, int stacks = 16, int slices = 32, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForIndexedSphere(std::vector<Vertex_PNCU>& verts, std::vector<unsigned int>& indices, float radius, int stacks = 16, int slices = 32, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForIndexedCylinder(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, Vec3 const& start, Vec3 const& end, float radius, int slices = 16, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForIndexedCone3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, Vec3 const& start, Vec3 const& end, float radius, int slices = 16, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForIndexedArrow3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indices, Vec3 const& start, Vec3 const& end, float radius, int slices = 16, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
@@ -0,0 +1,879 @@
+#include "Engine/Math/AABB2Tree.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include <algorithm>
+#include <utility>
+
+constexpr int AABB2_TREE_STACK_SIZE = 256;
+constexpr int AABB2_TREE_SAH_BINS = 16;
+constexpr int AABB2_TREE_MIN_ITEMS_PER_JOB = 256;
+
+// Plain floats indexed by axis: the build shuffles and merges these a lot and Vec2 copies are not free
+struct AABB2TreeBuildBounds {
+	float m_mins[2] = { FLT_MAX, FLT_MAX };
+	float m_maxs[2] = { -FLT_MAX, -FLT_MAX };
+};
+
+struct AABB2TreeBuildItem {
+	AABB2TreeBuildBounds m_bounds;
+	float m_center[2] = {};
+	int m_itemIndex = -1;
+};
+
+// Builds one subtree into the node range reserved for it
+class AABB2TreeBuildJob : public Job {
+public:
+	AABB2TreeBuildJob(AABB2Tree* tree, std::vector<AABB2TreeBuildItem>& buildItems, int first, int count, int nodeIndex, int parentIndex, std::vector<int>* out_proxyIds);
+
+protected:
+	virtual void Execute() override;
+	virtual void OnFinished() override;
+
+private:
+	AABB2Tree* m_tree = nullptr;
+	std::vector<AABB2TreeBuildItem>& m_buildItems;
+	int m_first = 0;
+	int m_count = 0;
+	int m_nodeIndex = -1;
+	int m_parentIndex = -1;
+	std::vector<int>* m_proxyIds = nullptr;
+};
+
+// Half perimeter, all the SAH needs is something proportional to the chance of a random ray hitting the box
+static float GetBoundsCost(AABB2 const& bounds)
+{
+	return (bounds.m_maxs.x - bounds.m_mins.x) + (bounds.m_maxs.y - bounds.m_mins.y);
+}
+
+static AABB2 GetUnion(AABB2 const& boundsA, AABB2 const& boundsB)
+{
+	Vec2 mins((boundsA.m_mins.x < boundsB.m_mins.x) ? boundsA.m_mins.x : boundsB.m_mins.x, (boundsA.m_mins.y < boundsB.m_mins.y) ? boundsA.m_mins.y : boundsB.m_mins.y);
+	Vec2 maxs((boundsA.m_maxs.x > boundsB.m_maxs.x) ? boundsA.m_maxs.x : boundsB.m_maxs.x, (boundsA.m_maxs.y > boundsB.m_maxs.y) ? boundsA.m_maxs.y : boundsB.m_maxs.y);
+	return AABB2(mins, maxs);
+}
+
+// Slab test. The entry distance is 0 when the ray starts inside the box
+static bool GetRayEntryDistance(AABB2 const& bounds, Vec2 const& rayStart, Vec2 const& invForward, float maxDistance, float& out_entryDist)
+{
+	float minXEntry = (bounds.m_mins.x - rayStart.x) * invForward.x;
+	float maxXEntry = (bounds.m_maxs.x - rayStart.x) * invForward.x;
+	float minYEntry = (bounds.m_mins.y - rayStart.y) * invForward.y;
+	float maxYEntry = (bounds.m_maxs.y - rayStart.y) * invForward.y;
+
+	float enterX = (minXEntry < maxXEntry) ? minXEntry : maxXEntry;
+	float exitX = (minXEntry < maxXEntry) ? maxXEntry : minXEntry;
+	float enterY = (minYEntry < maxYEntry) ? minYEntry : maxYEntry;
+	float exitY = (minYEntry < maxYEntry) ? maxYEntry : minYEntry;
+
+	float enterDist = (enterX > enterY) ? enterX : enterY;
+	float exitDist = (exitX < exitY) ? exitX : exitY;
+
+	if (exitDist < enterDist || exitDist < 0.0f || enterDist > maxDistance) return false;
+
+	out_entryDist = (enterDist > 0.0f) ? enterDist : 0.0f;
+	return true;
+}
+
+static float GetDistanceToBounds(AABB2 const& bounds, Vec2 const& point)
+{
+	return GetDistance2D(point, bounds.GetNearestPoint(point));
+}
+
+// Bins the item centers along each axis, sweeps the bins for the cheapest split and reorders the items so the first
+// child's come first. Returns how many items go to the first child
+static void StretchBuildBounds(AABB2TreeBuildBounds& bounds, AABB2TreeBuildBounds const& boundsToInclude)
+{
+	for (int axis = 0; axis < 2; axis++) {
+		bounds.m_mins[axis] = (bounds.m_mins[axis] < boundsToInclude.m_mins[axis]) ? bounds.m_mins[axis] : boundsToInclude.m_mins[axis];
+		bounds.m_maxs[axis] = (bounds.m_maxs[axis] > boundsToInclude.m_maxs[axis]) ? bounds.m_maxs[axis] : boundsToInclude.m_maxs[axis];
+	}
+}
+
+static float GetBuildBoundsCost(AABB2TreeBuildBounds const& bounds)
+{
+	return (bounds.m_maxs[0] - bounds.m_mins[0]) + (bounds.m_maxs[1] - bounds.m_mins[1]);
+}
+
+static int PartitionBuildItems(std::vector<AABB2TreeBuildItem>& buildItems, int first, int count)
+{
+	AABB2TreeBuildBounds centerBounds;
+	for (int itemIndex = first; itemIndex < first + count; itemIndex++) {
+		AABB2TreeBuildItem const& buildItem = buildItems[itemIndex];
+		for (int axis = 0; axis < 2; axis++) {
+			centerBounds.m_mins[axis] = (centerBounds.m_mins[axis] < buildItem.m_center[axis]) ? centerBounds.m_mins[axis] : buildItem.m_center[axis];
+			centerBounds.m_maxs[axis] = (centerBounds.m_maxs[axis] > buildItem.m_center[axis]) ? centerBounds.m_maxs[axis] : buildItem.m_center[axis];
+		}
+	}
+
+	// Bin the centers along each axis and sweep the bins for the cheapest split
+	int bestAxis = -1;
+	int bestSplitBin = 0;
+	float bestCost = FLT_MAX;
+	for (int axis = 0; axis < 2; axis++) {
+		float axisMin = centerBounds.m_mins[axis];
+		float axisExtent = centerBounds.m_maxs[axis] - axisMin;
+		if (axisExtent <= 0.0f) continue;
+
+		AABB2TreeBuildBounds binBounds[AABB2_TREE_SAH_BINS];
+		int binCounts[AABB2_TREE_SAH_BINS] = {};
+		float binScale = (float)AABB2_TREE_SAH_BINS / axisExtent;
+		for (int itemIndex = first; itemIndex < first + count; itemIndex++) {
+			AABB2TreeBuildItem const& buildItem = buildItems[itemIndex];
+			int bin = (int)((buildItem.m_center[axis] - axisMin) * binScale);
+			bin = (bin < AABB2_TREE_SAH_BINS) ? bin : AABB2_TREE_SAH_BINS - 1;
+			StretchBuildBounds(binBounds[bin], buildItem.m_bounds);
+			binCounts[bin]++;
+		}
+
+		float rightCosts[AABB2_TREE_SAH_BINS] = {};
+		AABB2TreeBuildBounds rightBounds;
+		int rightCount = 0;
+		for (int bin = AABB2_TREE_SAH_BINS - 1; bin > 0; bin--) {
+			if (binCounts[bin] > 0) {
+				StretchBuildBounds(rightBounds, binBounds[bin]);
+				rightCount += binCounts[bin];
+			}
+			rightCosts[bin] = (rightCount > 0) ? GetBuildBoundsCost(rightBounds) * (float)rightCount : 0.0f;
+		}
+
+		AABB2TreeBuildBounds leftBounds;
+		int leftCount = 0;
+		for (int splitBin = 1; splitBin < AABB2_TREE_SAH_BINS; splitBin++) {
+			int bin = splitBin - 1;
+			if (binCounts[bin] > 0) {
+				StretchBuildBounds(leftBounds, binBounds[bin]);
+				leftCount += binCounts[bin];
+			}
+			if (leftCount == 0 || leftCount == count) continue;
+
+			float splitCost = GetBuildBoundsCost(leftBounds) * (float)leftCount + rightCosts[splitBin];
+			if (splitCost < bestCost) {
+				bestCost = splitCost;
+				bestAxis = axis;
+				bestSplitBin = splitBin;
+			}
+		}
+	}
+
+	int firstRightItem = first + count / 2;
+	if (bestAxis != -1) {
+		float axisMin = centerBounds.m_mins[bestAxis];
+		float binScale = (float)AABB2_TREE_SAH_BINS / (centerBounds.m_maxs[bestAxis] - axisMin);
+		firstRightItem = first;
+		for (int itemIndex = first; itemIndex < first + count; itemIndex++) {
+			int bin = (int)((buildItems[itemIndex].m_center[bestAxis] - axisMin) * binScale);
+			if (bin < bestSplitBin) {
+				if (itemIndex != firstRightItem) {
+					std::swap(buildItems[itemIndex], buildItems[firstRightItem]);
+				}
+				firstRightItem++;
+			}
+		}
+	}
+
+	// All centers on top of each other, any split is as good as another
+	if (firstRightItem == first || firstRightItem == first + count) {
+		firstRightItem = first + count / 2;
+	}
+
+	return firstRightItem - first;
+}
+
+void AABB2Tree::Build(std::vector<AABB2> const& itemBounds, std::vector<int>* out_proxyIds)
+{
+	std::vector<AABB2TreeBuildItem> buildItems;
+	if (!PrepareBuild(itemBounds, buildItems, out_proxyIds)) return;
+
+	BuildNode(buildItems, 0, (int)buildItems.size(), 0, -1, out_proxyIds);
+}
+
+void AABB2Tree::BuildParallel(std::vector<AABB2> const& itemBounds, JobSystem* jobSystem, std::vector<int>* out_proxyIds)
+{
+	int numThreads = (jobSystem) ? jobSystem->GetNumThreads() : 0;
+	if (numThreads <= 0) {
+		Build(itemBounds, out_proxyIds);
+		return;
+	}
+
+	std::vector<AABB2TreeBuildItem> buildItems;
+	if (!PrepareBuild(itemBounds, buildItems, out_proxyIds)) return;
+
+	// A few subtrees per thread keeps the workers busy when the splits come out uneven
+	int itemsPerJob = (int)buildItems.size() / (numThreads * 4);
+	itemsPerJob = (itemsPerJob > AABB2_TREE_MIN_ITEMS_PER_JOB) ? itemsPerJob : AABB2_TREE_MIN_ITEMS_PER_JOB;
+
+	// Only this build's jobs are waited on and deleted: other systems share the job system's completed queue
+	std::vector<int> splitNodes;
+	JobBatch buildJobs(jobSystem);
+	BuildNodeParallel(buildItems, 0, (int)buildItems.size(), 0, -1, out_proxyIds, buildJobs, itemsPerJob, splitNodes);
+	buildJobs.WaitAndDeleteJobs();
+
+	// Split nodes were recorded parents first, so walking them backwards finishes children before parents
+	for (int splitIndex = (int)splitNodes.size() - 1; splitIndex >= 0; splitIndex--) {
+		FinishInternalNode(splitNodes[splitIndex]);
+	}
+}
+
+bool AABB2Tree::PrepareBuild(std::vector<AABB2> const& itemBounds, std::vector<AABB2TreeBuildItem>& out_buildItems, std::vector<int>* out_proxyIds)
+{
+	Clear();
+	int itemCount = (int)itemBounds.size();
+	if (out_proxyIds) {
+		out_proxyIds->assign(itemCount, -1);
+	}
+	if (itemCount == 0) return false;
+
+	out_buildItems.resize(itemCount);
+	for (int itemIndex = 0; itemIndex < itemCount; itemIndex++) {
+		AABB2TreeBuildItem& buildItem = out_buildItems[itemIndex];
+		AABB2 const& bounds = itemBounds[itemIndex];
+		buildItem.m_bounds.m_mins[0] = bounds.m_mins.x;
+		buildItem.m_bounds.m_mins[1] = bounds.m_mins.y;
+		buildItem.m_bounds.m_maxs[0] = bounds.m_maxs.x;
+		buildItem.m_bounds.m_maxs[1] = bounds.m_maxs.y;
+		buildItem.m_center[0] = (bounds.m_mins.x + bounds.m_maxs.x) * 0.5f;
+		buildItem.m_center[1] = (bounds.m_mins.y + bounds.m_maxs.y) * 0.5f;
+		buildItem.m_itemIndex = itemIndex;
+	}
+
+	// A subtree over n items always takes 2n - 1 nodes, so every subtree gets its own contiguous range up front:
+	// the node itself, then the first child's subtree, then the second child's. Subtrees never touch each other's nodes
+	m_nodes.resize((size_t)(2 * itemCount - 1));
+	m_rootIndex = 0;
+	m_proxyCount = itemCount;
+	return true;
+}
+
+void AABB2Tree::BuildNode(std::vector<AABB2TreeBuildItem>& buildItems, int first, int count, int nodeIndex, int parentIndex, std::vector<int>* out_proxyIds)
+{
+	AABB2TreeNode& node = m_nodes[nodeIndex];
+	node.m_parent = parentIndex;
+
+	if (count == 1) {
+		AABB2TreeBuildItem const& buildItem = buildItems[first];
+		node.m_bounds = AABB2(buildItem.m_bounds.m_mins[0], buildItem.m_bounds.m_mins[1], buildItem.m_bounds.m_maxs[0], buildItem.m_bounds.m_maxs[1]);
+		node.m_itemIndex = buildItem.m_itemIndex;
+		node.m_height = 0;
+		if (out_proxyIds) {
+			(*out_proxyIds)[buildItem.m_itemIndex] = nodeIndex;
+		}
+		return;
+	}
+
+	int firstCount = PartitionBuildItems(buildItems, first, count);
+	node.m_firstChild = nodeIndex + 1;
+	node.m_secondChild = nodeIndex + 2 * firstCount;
+
+	BuildNode(buildItems, first, firstCount, node.m_firstChild, nodeIndex, out_proxyIds);
+	BuildNode(buildItems, first + firstCount, count - firstCount, node.m_secondChild, nodeIndex, out_proxyIds);
+	FinishInternalNode(nodeIndex);
+}
+
+int AABB2Tree::BuildNodeParallel(std::vector<AABB2TreeBuildItem>& buildItems, int first, int count, int nodeIndex, int parentIndex, std::vector<int>* out_proxyIds, JobBatch& jobBatch, int itemsPerJob, std::vector<int>& splitNodes)
+{
+	if (count <= itemsPerJob) {
+		jobBatch.QueueJob(new AABB2TreeBuildJob(this, buildItems, first, count, nodeIndex, parentIndex, out_proxyIds));
+		return 1;
+	}
+
+	splitNodes.push_back(nodeIndex);
+
+	AABB2TreeNode& node = m_nodes[nodeIndex];
+	node.m_parent = parentIndex;
+
+	int firstCount = PartitionBuildItems(buildItems, first, count);
+	node.m_firstChild = nodeIndex + 1;
+	node.m_secondChild = nodeIndex + 2 * firstCount;
+
+	int numJobs = BuildNodeParallel(buildItems, first, firstCount, node.m_firstChild, nodeIndex, out_proxyIds, jobBatch, itemsPerJob, splitNodes);
+	numJobs += BuildNodeParallel(buildItems, first + firstCount, count - firstCount, node.m_secondChild, nodeIndex, out_proxyIds, jobBatch, itemsPerJob, splitNodes);
+	return numJobs;
+}
+
+void AABB2Tree::FinishInternalNode(int nodeIndex)
+{
+	AABB2TreeNode& node = m_nodes[nodeIndex];
+	AABB2TreeNode const& firstChildNode = m_nodes[node.m_firstChild];
+	AABB2TreeNode const& secondChildNode = m_nodes[node.m_secondChild];
+	node.m_itemIndex = -1;
+	node.m_bounds = GetUnion(firstChildNode.m_bounds, secondChildNode.m_bounds);
+	node.m_height = 1 + ((firstChildNode.m_height > secondChildNode.m_height) ? firstChildNode.m_height : secondChildNode.m_height);
+}
+
+AABB2TreeBuildJob::AABB2TreeBuildJob(AABB2Tree* tree, std::vector<AABB2TreeBuildItem>& buildItems, int first, int count, int nodeIndex, int parentIndex, std::vector<int>* out_proxyIds) :
+	Job(DEFAULT_JOB_ID),
+	m_tree(tree),
+	m_buildItems(buildItems),
+	m_first(first),
+	m_count(count),
+	m_nodeIndex(nodeIndex),
+	m_parentIndex(parentIndex),
+	m_proxyIds(out_proxyIds)
+{
+}
+
+void AABB2TreeBuildJob::Execute()
+{
+	m_tree->BuildNode(m_buildItems, m_first, m_count, m_nodeIndex, m_parentIndex, m_proxyIds);
+}
+
+void AABB2TreeBuildJob::OnFinished()
+{
+}
+
+void AABB2Tree::Clear()
+{
+	m_nodes.clear();
+	m_rootIndex = -1;
+	m_freeListHead = -1;
+	m_proxyCount = 0;
+}
+
+bool AABB2Tree::SetNodes(AABB2TreeNode const* nodes, int numNodes, int rootIndex, std::vector<int>* out_proxyIds)
+{
+	Clear();
+	if (out_proxyIds) {
+		out_proxyIds->clear();
+	}
+	if (numNodes <= 0) return (rootIndex == -1);
+	if ((rootIndex < 0) || (rootIndex >= numNodes)) return false;
+
+	// Copy assigned rather than copy constructed: the node assignments are all inline, where Vec2's copy constructor is not
+	m_nodes.resize((size_t)numNodes);
+	std::copy(nodes, nodes + numNodes, m_nodes.begin());
+	m_rootIndex = rootIndex;
+	if (!IsStructureValid()) {
+		Clear();
+		return false;
+	}
+
+	// Free nodes are rethreaded rather than trusted, the saved list may reference nodes past the end
+	for (int nodeIndex = numNodes - 1; nodeIndex >= 0; nodeIndex--) {
+		AABB2TreeNode& node = m_nodes[nodeIndex];
+		if (node.m_height == -1) {
+			node.m_parent = m_freeListHead;
+			m_freeListHead = nodeIndex;
+			continue;
+		}
+
+		if (!node.IsLeaf()) continue;
+		m_proxyCount++;
+
+		if (out_proxyIds) {
+			if (node.m_itemIndex >= (int)out_proxyIds->size()) {
+				out_proxyIds->resize((size_t)node.m_itemIndex + 1, -1);
+			}
+			(*out_proxyIds)[node.m_itemIndex] = nodeIndex;
+		}
+	}
+
+	return true;
+}
+
+// Walks the whole tree once from the root. Every node in use has to be reached exactly once, agree with its parent
+// and its height, and sit shallow enough for the fixed traversal stacks. Leaf item indexes have to be unique and
+// non-negative, and are bounded by the node count since there can't be more leaves than nodes
+bool AABB2Tree::IsStructureValid() const
+{
+	int numNodes = (int)m_nodes.size();
+	if (m_nodes[m_rootIndex].m_parent != -1) return false;
+
+	std::vector<bool> isVisited((size_t)numNodes, false);
+	std::vector<bool> isItemUsed((size_t)numNodes, false);
+	std::vector<int> visitOrder;
+	std::vector<std::pair<int, int>> nodeStack; // Node index and depth
+	visitOrder.reserve((size_t)numNodes);
+	nodeStack.push_back(std::make_pair(m_rootIndex, 0));
+
+	while (!nodeStack.empty()) {
+		int nodeIndex = nodeStack.back().first;
+		int depth = nodeStack.back().second;
+		nodeStack.pop_back();
+
+		AABB2TreeNode const& node = m_nodes[nodeIndex];
+		if (isVisited[nodeIndex] || (node.m_height == -1)) return false;
+		if (depth > AABB2_TREE_STACK_SIZE - 2) return false;
+		isVisited[nodeIndex] = true;
+		visitOrder.push_back(nodeIndex);
+
+		if (node.IsLeaf()) {
+			if ((node.m_secondChild != -1) || (node.m_height != 0)) return false;
+			if ((node.m_itemIndex < 0) || (node.m_itemIndex >= numNodes) || isItemUsed[node.m_itemIndex]) return false;
+			isItemUsed[node.m_itemIndex] = true;
+			continue;
+		}
+
+		int children[2] = { node.m_firstChild, node.m_secondChild };
+		for (int childIndex : children) {
+			if ((childIndex < 0) || (childIndex >= numNodes)) return false;
+			if (m_nodes[childIndex].m_parent != nodeIndex) return false;
+			nodeStack.push_back(std::make_pair(childIndex, depth + 1));
+		}
+	}
+
+	// Nodes in use that hang off nothing would be counted as proxies but never found by a query
+	for (int nodeIndex = 0; nodeIndex < numNodes; nodeIndex++) {
+		if ((m_nodes[nodeIndex].m_height != -1) && !isVisited[nodeIndex]) return false;
+	}
+
+	// Children are always visited after their parent, so going backwards checks heights bottom up
+	for (int visitIndex = (int)visitOrder.size() - 1; visitIndex >= 0; visitIndex--) {
+		AABB2TreeNode const& node = m_nodes[visitOrder[visitIndex]];
+		if (node.IsLeaf()) continue;
+		int firstHeight = m_nodes[node.m_firstChild].m_height;
+		int secondHeight = m_nodes[node.m_secondChild].m_height;
+		if (node.m_height != 1 + ((firstHeight > secondHeight) ? firstHeight : secondHeight)) return false;
+	}
+
+	return true;
+}
+
+int AABB2Tree::InsertProxy(AABB2 const& bounds, int itemIndex)
+{
+	int proxyId = AllocateNode();
+	AABB2TreeNode& leaf = m_nodes[proxyId];
+	leaf.m_bounds = bounds;
+	leaf.m_itemIndex = itemIndex;
+	leaf.m_height = 0;
+
+	InsertLeaf(proxyId);
+	m_proxyCount++;
+	return proxyId;
+}
+
+void AABB2Tree::RemoveProxy(int proxyId)
+{
+	ASSERT_OR_DIE(m_nodes[proxyId].IsLeaf() && m_nodes[proxyId].m_height == 0, "REMOVING A NODE THAT IS NOT A PROXY");
+
+	RemoveLeaf(proxyId);
+	FreeNode(proxyId);
+	m_proxyCount--;
+}
+
+void AABB2Tree::MoveProxy(int proxyId, AABB2 const& newBounds)
+{
+	RemoveLeaf(proxyId);
+	m_nodes[proxyId].m_bounds = newBounds;
+	InsertLeaf(proxyId);
+}
+
+void AABB2Tree::SetProxyBounds(int proxyId, AABB2 const& newBounds)
+{
+	m_nodes[proxyId].m_bounds = newBounds;
+}
+
+void AABB2Tree::Refit()
+{
+	if (m_rootIndex == -1) return;
+
+	// Parents always come before their children in this order, so walking it backwards refits bottom-up
+	std::vector<int> nodeOrder;
+	nodeOrder.reserve(m_nodes.size());
+	nodeOrder.push_back(m_rootIndex);
+	for (int orderIndex = 0; orderIndex < (int)nodeOrder.size(); orderIndex++) {
+		AABB2TreeNode const& node = m_nodes[nodeOrder[orderIndex]];
+		if (node.IsLeaf()) continue;
+		nodeOrder.push_back(node.m_firstChild);
+		nodeOrder.push_back(node.m_secondChild);
+	}
+
+	for (int orderIndex = (int)nodeOrder.size() - 1; orderIndex >= 0; orderIndex--) {
+		AABB2TreeNode& node = m_nodes[nodeOrder[orderIndex]];
+		if (node.IsLeaf()) continue;
+		node.m_bounds = GetUnion(m_nodes[node.m_firstChild].m_bounds, m_nodes[node.m_secondChild].m_bounds);
+	}
+}
+
+RaycastHit AABB2Tree::Raycast(Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance, AABB2TreeRaycastCallback itemCallback, void* userData) const
+{
+	RaycastHit nearestHit;
+	if (m_rootIndex == -1) return nearestHit;
+
+	Vec2 invForward(1.0f / rayForward.x, 1.0f / rayForward.y);
+	float searchDistance = maxDistance;
+
+	int nodeStack[AABB2_TREE_STACK_SIZE];
+	float entryDistStack[AABB2_TREE_STACK_SIZE];
+	int stackSize = 0;
+
+	float rootEntryDist = 0.0f;
+	if (!GetRayEntryDistance(m_nodes[m_rootIndex].m_bounds, rayStart, invForward, searchDistance, rootEntryDist)) return nearestHit;
+	nodeStack[stackSize] = m_rootIndex;
+	entryDistStack[stackSize] = rootEntryDist;
+	stackSize++;
+
+	while (stackSize > 0) {
+		stackSize--;
+		AABB2TreeNode const& node = m_nodes[nodeStack[stackSize]];
+		float nodeEntryDist = entryDistStack[stackSize];
+		if (nodeEntryDist > searchDistance) continue;
+
+		if (node.IsLeaf()) {
+			float impactDist = (itemCallback) ? itemCallback(userData, node.m_itemIndex, rayStart, rayForward, searchDistance) : nodeEntryDist;
+			if (impactDist < 0.0f || impactDist > searchDistance) continue;
+			if (nearestHit.DidImpact() && impactDist >= nearestHit.m_impactDist) continue;
+
+			nearestHit.m_impactDist = impactDist;
+			nearestHit.m_index = node.m_itemIndex;
+			searchDistance = impactDist;
+			continue;
+		}
+
+		float firstEntryDist = 0.0f;
+		float secondEntryDist = 0.0f;
+		bool hitsFirst = GetRayEntryDistance(m_nodes[node.m_firstChild].m_bounds, rayStart, invForward, searchDistance, firstEntryDist);
+		bool hitsSecond = GetRayEntryDistance(m_nodes[node.m_secondChild].m_bounds, rayStart, invForward, searchDistance, secondEntryDist);
+
+		ASSERT_OR_DIE(stackSize + 2 <= AABB2_TREE_STACK_SIZE, "AABB2 TREE IS TOO DEEP TO TRAVERSE");
+
+		// Farther child goes in first so the nearer one is visited first and can shrink the ray
+		bool isFirstNearer = firstEntryDist <= secondEntryDist;
+		int farChild = (isFirstNearer) ? node.m_secondChild : node.m_firstChild;
+		int nearChild = (isFirstNearer) ? node.m_firstChild : node.m_secondChild;
+		bool hitsFar = (isFirstNearer) ? hitsSecond : hitsFirst;
+		bool hitsNear = (isFirstNearer) ? hitsFirst : hitsSecond;
+
+		if (hitsFar) {
+			nodeStack[stackSize] = farChild;
+			entryDistStack[stackSize] = (isFirstNearer) ? secondEntryDist : firstEntryDist;
+			stackSize++;
+		}
+		if (hitsNear) {
+			nodeStack[stackSize] = nearChild;
+			entryDistStack[stackSize] = (isFirstNearer) ? firstEntryDist : secondEntryDist;
+			stackSize++;
+		}
+	}
+
+	return nearestHit;
+}
+
+void AABB2Tree::GetOverlappingItems(AABB2 const& bounds, std::vector<int>& out_itemIndexes) const
+{
+	if (m_rootIndex == -1) return;
+
+	int nodeStack[AABB2_TREE_STACK_SIZE];
+	int stackSize = 0;
+	nodeStack[stackSize++] = m_rootIndex;
+
+	while (stackSize > 0) {
+		AABB2TreeNode const& node = m_nodes[nodeStack[--stackSize]];
+		if (!DoAABB2sOverlap(node.m_bounds, bounds)) continue;
+
+		if (node.IsLeaf()) {
+			out_itemIndexes.push_back(node.m_itemIndex);
+			continue;
+		}
+
+		ASSERT_OR_DIE(stackSize + 2 <= AABB2_TREE_STACK_SIZE, "AABB2 TREE IS TOO DEEP TO TRAVERSE");
+		nodeStack[stackSize++] = node.m_secondChild;
+		nodeStack[stackSize++] = node.m_firstChild;
+	}
+}
+
+void AABB2Tree::GetOverlappingItems(Vec2 const& discCenter, float discRadius, std::vector<int>& out_itemIndexes) const
+{
+	if (m_rootIndex == -1) return;
+
+	int nodeStack[AABB2_TREE_STACK_SIZE];
+	int stackSize = 0;
+	nodeStack[stackSize++] = m_rootIndex;
+
+	while (stackSize > 0) {
+		AABB2TreeNode const& node = m_nodes[nodeStack[--stackSize]];
+		if (!DoDiscAndAABB2Overlap(discCenter, discRadius, node.m_bounds)) continue;
+
+		if (node.IsLeaf()) {
+			out_itemIndexes.push_back(node.m_itemIndex);
+			continue;
+		}
+
+		ASSERT_OR_DIE(stackSize + 2 <= AABB2_TREE_STACK_SIZE, "AABB2 TREE IS TOO DEEP TO TRAVERSE");
+		nodeStack[stackSize++] = node.m_secondChild;
+		nodeStack[stackSize++] = node.m_firstChild;
+	}
+}
+
+int AABB2Tree::GetNearestItem(Vec2 const& point, float maxDistance, AABB2TreeDistanceCallback itemCallback, void* userData, float* out_distance) const
+{
+	int nearestItem = -1;
+	float nearestDist = maxDistance;
+	if (m_rootIndex == -1) return nearestItem;
+
+	int nodeStack[AABB2_TREE_STACK_SIZE];
+	float distStack[AABB2_TREE_STACK_SIZE];
+	int stackSize = 0;
+	nodeStack[stackSize] = m_rootIndex;
+	distStack[stackSize] = GetDistanceToBounds(m_nodes[m_rootIndex].m_bounds, point);
+	stackSize++;
+
+	while (stackSize > 0) {
+		stackSize--;
+		AABB2TreeNode const& node = m_nodes[nodeStack[stackSize]];
+		float nodeDist = distStack[stackSize];
+		if (nodeDist > nearestDist) continue;
+
+		if (node.IsLeaf()) {
+			float itemDist = (itemCallback) ? itemCallback(userData, node.m_itemIndex, point) : nodeDist;
+			if (itemDist > nearestDist) continue;
+			if ((nearestItem != -1) && (itemDist >= nearestDist)) continue;
+
+			nearestItem = node.m_itemIndex;
+			nearestDist = itemDist;
+			continue;
+		}
+
+		ASSERT_OR_DIE(stackSize + 2 <= AABB2_TREE_STACK_SIZE, "AABB2 TREE IS TOO DEEP TO TRAVERSE");
+
+		float firstDist = GetDistanceToBounds(m_nodes[node.m_firstChild].m_bounds, point);
+		float secondDist = GetDistanceToBounds(m_nodes[node.m_secondChild].m_bounds, point);
+		bool isFirstNearer = firstDist <= secondDist;
+
+		nodeStack[stackSize] = (isFirstNearer) ? node.m_secondChild : node.m_firstChild;
+		distStack[stackSize] = (isFirstNearer) ? secondDist : firstDist;
+		stackSize++;
+		nodeStack[stackSize] = (isFirstNearer) ? node.m_firstChild : node.m_secondChild;
+		distStack[stackSize] = (isFirstNearer) ? firstDist : secondDist;
+		stackSize++;
+	}
+
+	if (out_distance && nearestItem != -1) {
+		*out_distance = nearestDist;
+	}
+	return nearestItem;
+}
+
+int AABB2Tree::GetHeight() const
+{
+	return (m_rootIndex == -1) ? 0 : m_nodes[m_rootIndex].m_height;
+}
+
+int AABB2Tree::AllocateNode()
+{
+	if (m_freeListHead == -1) {
+		m_nodes.emplace_back();
+		AABB2TreeNode& newNode = m_nodes.back();
+		newNode.m_height = 0;
+		return (int)m_nodes.size() - 1;
+	}
+
+	int nodeIndex = m_freeListHead;
+	AABB2TreeNode& node = m_nodes[nodeIndex];
+	m_freeListHead = node.m_parent;
+	node = AABB2TreeNode();
+	node.m_height = 0;
+	return nodeIndex;
+}
+
+void AABB2Tree::FreeNode(int nodeIndex)
+{
+	AABB2TreeNode& node = m_nodes[nodeIndex];
+	node = AABB2TreeNode();
+	node.m_parent = m_freeListHead;
+	m_freeListHead = nodeIndex;
+}
+
+void AABB2Tree::InsertLeaf(int leafIndex)
+{
+	if (m_rootIndex == -1) {
+		m_rootIndex = leafIndex;
+		m_nodes[leafIndex].m_parent = -1;
+		return;
+	}
+
+	// Walk down to the sibling that grows the tree's total perimeter the least
+	AABB2 leafBounds = m_nodes[leafIndex].m_bounds;
+	int siblingIndex = m_rootIndex;
+	while (!m_nodes[siblingIndex].IsLeaf()) {
+		AABB2TreeNode const& node = m_nodes[siblingIndex];
+		float nodeCost = GetBoundsCost(node.m_bounds);
+		float combinedCost = GetBoundsCost(GetUnion(node.m_bounds, leafBounds));
+
+		float newParentCost = 2.0f * combinedCost;
+		float inheritedCost = 2.0f * (combinedCost - nodeCost);
+
+		AABB2TreeNode const& firstChild = m_nodes[node.m_firstChild];
+		AABB2TreeNode const& secondChild = m_nodes[node.m_secondChild];
+		float firstCost = GetBoundsCost(GetUnion(firstChild.m_bounds, leafBounds)) + inheritedCost;
+		float secondCost = GetBoundsCost(GetUnion(secondChild.m_bounds, leafBounds)) + inheritedCost;
+		if (!firstChild.IsLeaf()) firstCost -= GetBoundsCost(firstChild.m_bounds);
+		if (!secondChild.IsLeaf()) secondCost -= GetBoundsCost(secondChild.m_bounds);
+
+		if (newParentCost < firstCost && newParentCost < secondCost) break;
+		siblingIndex = (firstCost < secondCost) ? node.m_firstChild : node.m_secondChild;
+	}
+
+	int oldParentIndex = m_nodes[siblingIndex].m_parent;
+	int newParentIndex = AllocateNode();
+	AABB2TreeNode& newParent = m_nodes[newParentIndex];
+	newParent.m_parent = oldParentIndex;
+	newParent.m_bounds = GetUnion(leafBounds, m_nodes[siblingIndex].m_bounds);
+	newParent.m_height = m_nodes[siblingIndex].m_height + 1;
+	newParent.m_firstChild = siblingIndex;
+	newParent.m_secondChild = leafIndex;
+
+	if (oldParentIndex == -1) {
+		m_rootIndex = newParentIndex;
+	}
+	else {
+		AABB2TreeNode& oldParent = m_nodes[oldParentIndex];
+		if (oldParent.m_firstChild == siblingIndex) {
+			oldParent.m_firstChild = newParentIndex;
+		}
+		else {
+			oldParent.m_secondChild = newParentIndex;
+		}
+	}
+
+	m_nodes[siblingIndex].m_parent = newParentIndex;
+	m_nodes[leafIndex].m_parent = newParentIndex;
+
+	RefitAncestors(m_nodes[leafIndex].m_parent);
+}
+
+void AABB2Tree::RemoveLeaf(int leafIndex)
+{
+	if (leafIndex == m_rootIndex) {
+		m_rootIndex = -1;
+		return;
+	}
+
+	int parentIndex = m_nodes[leafIndex].m_parent;
+	AABB2TreeNode const& parent = m_nodes[parentIndex];
+	int grandParentIndex = parent.m_parent;
+	int siblingIndex = (parent.m_firstChild == leafIndex) ? parent.m_secondChild : parent.m_firstChild;
+
+	FreeNode(parentIndex);
+	m_nodes[siblingIndex].m_parent = grandParentIndex;
+	m_nodes[leafIndex].m_parent = -1;
+
+	if (grandParentIndex == -1) {
+		m_rootIndex = siblingIndex;
+		return;
+	}
+
+	AABB2TreeNode& grandParent = m_nodes[grandParentIndex];
+	if (grandParent.m_firstChild == parentIndex) {
+		grandParent.m_firstChild = siblingIndex;
+	}
+	else {
+		grandParent.m_secondChild = siblingIndex;
+	}
+
+	RefitAncestors(grandParentIndex);
+}
+
+void AABB2Tree::RefitAncestors(int nodeIndex)
+{
+	while (nodeIndex != -1) {
+		nodeIndex = Balance(nodeIndex);
+
+		AABB2TreeNode& node = m_nodes[nodeIndex];
+		AABB2TreeNode const& firstChild = m_nodes[node.m_firstChild];
+		AABB2TreeNode const& secondChild = m_nodes[node.m_secondChild];
+		node.m_bounds = GetUnion(firstChild.m_bounds, secondChild.m_bounds);
+		node.m_height = 1 + ((firstChild.m_height > secondChild.m_height) ? firstChild.m_height : secondChild.m_height);
+
+		nodeIndex = node.m_parent;
+	}
+}
+
+// Rotates the taller child up when the children's heights differ by more than one. Returns the node now in nodeIndex's place
+int AABB2Tree::Balance(int nodeIndex)
+{
+	AABB2TreeNode& nodeA = m_nodes[nodeIndex];
+	if (nodeA.IsLeaf() || nodeA.m_height < 2) return nodeIndex;
+
+	int indexB = nodeA.m_firstChild;
+	int indexC = nodeA.m_secondChild;
+	AABB2TreeNode& nodeB = m_nodes[indexB];
+	AABB2TreeNode& nodeC = m_nodes[indexC];
+
+	int balance = nodeC.m_height - nodeB.m_height;
+	if (balance > 1) {
+		int indexF = nodeC.m_firstChild;
+		int indexG = nodeC.m_secondChild;
+		AABB2TreeNode& nodeF = m_nodes[indexF];
+		AABB2TreeNode& nodeG = m_nodes[indexG];
+
+		nodeC.m_firstChild = nodeIndex;
+		nodeC.m_parent = nodeA.m_parent;
+		nodeA.m_parent = indexC;
+
+		if (nodeC.m_parent == -1) {
+			m_rootIndex = indexC;
+		}
+		else if (m_nodes[nodeC.m_parent].m_firstChild == nodeIndex) {
+			m_nodes[nodeC.m_parent].m_firstChild = indexC;
+		}
+		else {
+			m_nodes[nodeC.m_parent].m_secondChild = indexC;
+		}
+
+		if (nodeF.m_height > nodeG.m_height) {
+			nodeC.m_secondChild = indexF;
+			nodeA.m_secondChild = indexG;
+			nodeG.m_parent = nodeIndex;
+			nodeA.m_bounds = GetUnion(nodeB.m_bounds, nodeG.m_bounds);
+			nodeC.m_bounds = GetUnion(nodeA.m_bounds, nodeF.m_bounds);
+			nodeA.m_height = 1 + ((nodeB.m_height > nodeG.m_height) ? nodeB.m_height : nodeG.m_height);
+			nodeC.m_height = 1 + ((nodeA.m_height > nodeF.m_height) ? nodeA.m_height : nodeF.m_height);
+		}
+		else {
+			nodeC.m_secondChild = indexG;
+			nodeA.m_secondChild = indexF;
+			nodeF.m_parent = nodeIndex;
+			nodeA.m_bounds = GetUnion(nodeB.m_bounds, nodeF.m_bounds);
+			nodeC.m_bounds = GetUnion(nodeA.m_bounds, nodeG.m_bounds);
+			nodeA.m_height = 1 + ((nodeB.m_height > nodeF.m_height) ? nodeB.m_height : nodeF.m_height);
+			nodeC.m_height = 1 + ((nodeA.m_height > nodeG.m_height) ? nodeA.m_height : nodeG.m_height);
+		}
+
+		return indexC;
+	}
+
+	if (balance < -1) {
+		int indexD = nodeB.m_firstChild;
+		int indexE = nodeB.m_secondChild;
+		AABB2TreeNode& nodeD = m_nodes[indexD];
+		AABB2TreeNode& nodeE = m_nodes[indexE];
+
+		nodeB.m_firstChild = nodeIndex;
+		nodeB.m_parent = nodeA.m_parent;
+		nodeA.m_parent = indexB;
+
+		if (nodeB.m_parent == -1) {
+			m_rootIndex = indexB;
+		}
+		else if (m_nodes[nodeB.m_parent].m_firstChild == nodeIndex) {
+			m_nodes[nodeB.m_parent].m_firstChild = indexB;
+		}
+		else {
+			m_nodes[nodeB.m_parent].m_secondChild = indexB;
+		}
+
+		if (nodeD.m_height > nodeE.m_height) {
+			nodeB.m_secondChild = indexD;
+			nodeA.m_firstChild = indexE;
+			nodeE.m_parent = nodeIndex;
+			nodeA.m_bounds = GetUnion(nodeC.m_bounds, nodeE.m_bounds);
+			nodeB.m_bounds = GetUnion(nodeA.m_bounds, nodeD.m_bounds);
+			nodeA.m_height = 1 + ((nodeC.m_height > nodeE.m_height) ? nodeC.m_height : nodeE.m_height);
+			nodeB.m_height = 1 + ((nodeA.m_height > nodeD.m_height) ? nodeA.m_height : nodeD.m_height);
+		}
+		else {
+			nodeB.m_secondChild = indexE;
+			nodeA.m_firstChild = indexD;
+			nodeD.m_parent = nodeIndex;
+			nodeA.m_bounds = GetUnion(nodeC.m_bounds, nodeD.m_bounds);
+			nodeB.m_bounds = GetUnion(nodeA.m_bounds, nodeE.m_bounds);
+			nodeA.m_height = 1 + ((nodeC.m_height > nodeD.m_height) ? nodeC.m_height : nodeD.m_height);
+			nodeB.m_height = 1 + ((nodeA.m_height > nodeE.m_height) ? nodeA.m_height : nodeE.m_height);
+		}
+
+		return indexB;
+	}
+
+	return nodeIndex;
+}
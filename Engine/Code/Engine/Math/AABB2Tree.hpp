@@ -0,0 +1,89 @@
+#pragma once
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+#include <float.h>
+#include <vector>
+
+struct AABB2TreeBuildItem;
+class AABB2TreeBuildJob;
+class JobBatch;
+class JobSystem;
+
+// Exact test against the item stored in a leaf. Returns the distance along the ray, negative if the item is missed
+typedef float (*AABB2TreeRaycastCallback)(void* userData, int itemIndex, Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance);
+// Exact distance from a point to the item stored in a leaf
+typedef float (*AABB2TreeDistanceCallback)(void* userData, int itemIndex, Vec2 const& point);
+
+struct AABB2TreeNode {
+	AABB2 m_bounds = AABB2::ZERO_TO_ONE;
+	int m_parent = -1; // Next free node while the node is in the free list
+	int m_firstChild = -1;
+	int m_secondChild = -1;
+	int m_itemIndex = -1;
+	int m_height = -1; // 0 for leaves, -1 for free nodes
+
+	bool IsLeaf() const { return m_firstChild == -1; }
+};
+
+// Bounding volume hierarchy over AABB2s, stored as one flat node array. Leaves are "proxies": their node index is
+// handed out as the proxy id and stays valid until the proxy is removed, no matter how the tree is restructured
+class AABB2Tree {
+public:
+	AABB2Tree() = default;
+	~AABB2Tree() = default;
+
+	// Top-down binned SAH build; replaces the current contents. Item indexes are the positions in itemBounds
+	void Build(std::vector<AABB2> const& itemBounds, std::vector<int>* out_proxyIds = nullptr);
+	// Same tree as Build. The top levels are split on the calling thread and the subtrees below are built as jobs in a
+	// JobBatch. Only those jobs are waited on, and the calling thread builds any still queued, so other queued work is fine
+	void BuildParallel(std::vector<AABB2> const& itemBounds, JobSystem* jobSystem, std::vector<int>* out_proxyIds = nullptr);
+	void Clear();
+	// Replaces the contents with a node array taken from GetNodes, e.g. straight out of a loaded file. One copy, nothing
+	// is rebuilt; the free list and proxy count are recovered from the nodes. Item indexes are whatever the nodes hold,
+	// as long as no two leaves share one and none is negative
+	bool SetNodes(AABB2TreeNode const* nodes, int numNodes, int rootIndex, std::vector<int>* out_proxyIds = nullptr);
+
+	// Incremental changes. Inserts pick the cheapest sibling by perimeter and rebalance with tree rotations
+	int InsertProxy(AABB2 const& bounds, int itemIndex);
+	void RemoveProxy(int proxyId);
+	void MoveProxy(int proxyId, AABB2 const& newBounds);
+
+	// Only touches the leaf. Call Refit once after updating a batch of proxies, before querying again
+	void SetProxyBounds(int proxyId, AABB2 const& newBounds);
+	void Refit();
+
+	// Nearest item along the ray. Without a callback, the items are their bounds
+	RaycastHit Raycast(Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance, AABB2TreeRaycastCallback itemCallback = nullptr, void* userData = nullptr) const;
+	void GetOverlappingItems(AABB2 const& bounds, std::vector<int>& out_itemIndexes) const;
+	void GetOverlappingItems(Vec2 const& discCenter, float discRadius, std::vector<int>& out_itemIndexes) const;
+	int GetNearestItem(Vec2 const& point, float maxDistance = FLT_MAX, AABB2TreeDistanceCallback itemCallback = nullptr, void* userData = nullptr, float* out_distance = nullptr) const;
+
+	int GetRootIndex() const { return m_rootIndex; }
+	int GetHeight() const;
+	int GetProxyCount() const { return m_proxyCount; }
+	AABB2TreeNode const& GetNode(int nodeIndex) const { return m_nodes[nodeIndex]; }
+	std::vector<AABB2TreeNode> const& GetNodes() const { return m_nodes; }
+	AABB2 const& GetProxyBounds(int proxyId) const { return m_nodes[proxyId].m_bounds; }
+	int GetItemIndex(int proxyId) const { return m_nodes[proxyId].m_itemIndex; }
+
+private:
+	int AllocateNode();
+	void FreeNode(int nodeIndex);
+	void InsertLeaf(int leafIndex);
+	void RemoveLeaf(int leafIndex);
+	void RefitAncestors(int nodeIndex);
+	int Balance(int nodeIndex);
+	bool PrepareBuild(std::vector<AABB2> const& itemBounds, std::vector<AABB2TreeBuildItem>& out_buildItems, std::vector<int>* out_proxyIds);
+	void BuildNode(std::vector<AABB2TreeBuildItem>& buildItems, int first, int count, int nodeIndex, int parentIndex, std::vector<int>* out_proxyIds);
+	int BuildNodeParallel(std::vector<AABB2TreeBuildItem>& buildItems, int first, int count, int nodeIndex, int parentIndex, std::vector<int>* out_proxyIds, JobBatch& jobBatch, int itemsPerJob, std::vector<int>& splitNodes);
+	void FinishInternalNode(int nodeIndex);
+	bool IsStructureValid() const;
+
+	friend class AABB2TreeBuildJob;
+
+private:
+	std::vector<AABB2TreeNode> m_nodes;
+	int m_rootIndex = -1;
+	int m_freeListHead = -1;
+	int m_proxyCount = 0;
+};
@@ -0,0 +1,651 @@
+#include "Engine/Math/AABB3Tree.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <utility>
+
+constexpr int AABB3_TREE_STACK_SIZE = 256;
+constexpr int AABB3_TREE_SAH_BINS = 16;
+
+struct AABB3TreeBuildItem {
+	AABB3 m_bounds;
+	Vec3 m_center;
+	int m_itemIndex = -1;
+};
+
+// Half surface area, all the SAH needs is something proportional to the chance of a random ray hitting the box
+static float GetBoundsCost(AABB3 const& bounds)
+{
+	Vec3 dims = bounds.m_maxs - bounds.m_mins;
+	return (dims.x * dims.y) + (dims.y * dims.z) + (dims.z * dims.x);
+}
+
+static AABB3 GetUnion(AABB3 const& boundsA, AABB3 const& boundsB)
+{
+	Vec3 mins((boundsA.m_mins.x < boundsB.m_mins.x) ? boundsA.m_mins.x : boundsB.m_mins.x, (boundsA.m_mins.y < boundsB.m_mins.y) ? boundsA.m_mins.y : boundsB.m_mins.y, (boundsA.m_mins.z < boundsB.m_mins.z) ? boundsA.m_mins.z : boundsB.m_mins.z);
+	Vec3 maxs((boundsA.m_maxs.x > boundsB.m_maxs.x) ? boundsA.m_maxs.x : boundsB.m_maxs.x, (boundsA.m_maxs.y > boundsB.m_maxs.y) ? boundsA.m_maxs.y : boundsB.m_maxs.y, (boundsA.m_maxs.z > boundsB.m_maxs.z) ? boundsA.m_maxs.z : boundsB.m_maxs.z);
+	return AABB3(mins, maxs);
+}
+
+static float GetAxisValue(Vec3 const& vec, int axis)
+{
+	if (axis == 0) return vec.x;
+	return (axis == 1) ? vec.y : vec.z;
+}
+
+// Slab test. The entry distance is 0 when the ray starts inside the box
+static bool GetRayEntryDistance(AABB3 const& bounds, Vec3 const& rayStart, Vec3 const& invForward, float maxDistance, float& out_entryDist)
+{
+	float minXEntry = (bounds.m_mins.x - rayStart.x) * invForward.x;
+	float maxXEntry = (bounds.m_maxs.x - rayStart.x) * invForward.x;
+	float minYEntry = (bounds.m_mins.y - rayStart.y) * invForward.y;
+	float maxYEntry = (bounds.m_maxs.y - rayStart.y) * invForward.y;
+	float minZEntry = (bounds.m_mins.z - rayStart.z) * invForward.z;
+	float maxZEntry = (bounds.m_maxs.z - rayStart.z) * invForward.z;
+
+	float enterX = (minXEntry < maxXEntry) ? minXEntry : maxXEntry;
+	float exitX = (minXEntry < maxXEntry) ? maxXEntry : minXEntry;
+	float enterY = (minYEntry < maxYEntry) ? minYEntry : maxYEntry;
+	float exitY = (minYEntry < maxYEntry) ? maxYEntry : minYEntry;
+	float enterZ = (minZEntry < maxZEntry) ? minZEntry : maxZEntry;
+	float exitZ = (minZEntry < maxZEntry) ? maxZEntry : minZEntry;
+
+	float enterDist = (enterX > enterY) ? enterX : enterY;
+	enterDist = (enterDist > enterZ) ? enterDist : enterZ;
+	float exitDist = (exitX < exitY) ? exitX : exitY;
+	exitDist = (exitDist < exitZ) ? exitDist : exitZ;
+
+	if (exitDist < enterDist || exitDist < 0.0f || enterDist > maxDistance) return false;
+
+	out_entryDist = (enterDist > 0.0f) ? enterDist : 0.0f;
+	return true;
+}
+
+static float GetDistanceToBounds(AABB3 const& bounds, Vec3 const& point)
+{
+	return GetDistance3D(point, bounds.GetNearestPoint(point));
+}
+
+void AABB3Tree::Build(std::vector<AABB3> const& itemBounds, std::vector<int>* out_proxyIds)
+{
+	Clear();
+	int itemCount = (int)itemBounds.size();
+	if (out_proxyIds) {
+		out_proxyIds->assign(itemCount, -1);
+	}
+	if (itemCount == 0) return;
+
+	std::vector<AABB3TreeBuildItem> buildItems;
+	buildItems.resize(itemCount);
+	for (int itemIndex = 0; itemIndex < itemCount; itemIndex++) {
+		AABB3TreeBuildItem& buildItem = buildItems[itemIndex];
+		buildItem.m_bounds = itemBounds[itemIndex];
+		buildItem.m_center = itemBounds[itemIndex].GetCenter();
+		buildItem.m_itemIndex = itemIndex;
+	}
+
+	m_nodes.reserve((size_t)(2 * itemCount - 1));
+	m_rootIndex = BuildNode(buildItems, 0, itemCount, -1, out_proxyIds);
+	m_proxyCount = itemCount;
+}
+
+int AABB3Tree::BuildNode(std::vector<AABB3TreeBuildItem>& buildItems, int first, int count, int parentIndex, std::vector<int>* out_proxyIds)
+{
+	int nodeIndex = AllocateNode();
+	m_nodes[nodeIndex].m_parent = parentIndex;
+
+	if (count == 1) {
+		AABB3TreeBuildItem const& buildItem = buildItems[first];
+		AABB3TreeNode& leaf = m_nodes[nodeIndex];
+		leaf.m_bounds = buildItem.m_bounds;
+		leaf.m_itemIndex = buildItem.m_itemIndex;
+		leaf.m_height = 0;
+		if (out_proxyIds) {
+			(*out_proxyIds)[buildItem.m_itemIndex] = nodeIndex;
+		}
+		return nodeIndex;
+	}
+
+	AABB3 centerBounds(buildItems[first].m_center, buildItems[first].m_center);
+	for (int itemIndex = first + 1; itemIndex < first + count; itemIndex++) {
+		centerBounds.StretchToIncludePoint(buildItems[itemIndex].m_center);
+	}
+
+	// Bin the centers along each axis and sweep the bins for the cheapest split
+	int bestAxis = -1;
+	int bestSplitBin = 0;
+	float bestCost = FLT_MAX;
+	for (int axis = 0; axis < 3; axis++) {
+		float axisMin = GetAxisValue(centerBounds.m_mins, axis);
+		float axisExtent = GetAxisValue(centerBounds.m_maxs, axis) - axisMin;
+		if (axisExtent <= 0.0f) continue;
+
+		AABB3 binBounds[AABB3_TREE_SAH_BINS];
+		int binCounts[AABB3_TREE_SAH_BINS] = {};
+		float binScale = (float)AABB3_TREE_SAH_BINS / axisExtent;
+		for (int itemIndex = first; itemIndex < first + count; itemIndex++) {
+			AABB3TreeBuildItem const& buildItem = buildItems[itemIndex];
+			int bin = (int)((GetAxisValue(buildItem.m_center, axis) - axisMin) * binScale);
+			bin = (bin < AABB3_TREE_SAH_BINS) ? bin : AABB3_TREE_SAH_BINS - 1;
+			binBounds[bin] = (binCounts[bin] == 0) ? buildItem.m_bounds : GetUnion(binBounds[bin], buildItem.m_bounds);
+			binCounts[bin]++;
+		}
+
+		float rightCosts[AABB3_TREE_SAH_BINS] = {};
+		AABB3 rightBounds;
+		int rightCount = 0;
+		for (int bin = AABB3_TREE_SAH_BINS - 1; bin > 0; bin--) {
+			if (binCounts[bin] > 0) {
+				rightBounds = (rightCount == 0) ? binBounds[bin] : GetUnion(rightBounds, binBounds[bin]);
+				rightCount += binCounts[bin];
+			}
+			rightCosts[bin] = (rightCount > 0) ? GetBoundsCost(rightBounds) * (float)rightCount : 0.0f;
+		}
+
+		AABB3 leftBounds;
+		int leftCount = 0;
+		for (int splitBin = 1; splitBin < AABB3_TREE_SAH_BINS; splitBin++) {
+			int bin = splitBin - 1;
+			if (binCounts[bin] > 0) {
+				leftBounds = (leftCount == 0) ? binBounds[bin] : GetUnion(leftBounds, binBounds[bin]);
+				leftCount += binCounts[bin];
+			}
+			if (leftCount == 0 || leftCount == count) continue;
+
+			float splitCost = GetBoundsCost(leftBounds) * (float)leftCount + rightCosts[splitBin];
+			if (splitCost < bestCost) {
+				bestCost = splitCost;
+				bestAxis = axis;
+				bestSplitBin = splitBin;
+			}
+		}
+	}
+
+	int firstRightItem = first + count / 2;
+	if (bestAxis != -1) {
+		float axisMin = GetAxisValue(centerBounds.m_mins, bestAxis);
+		float binScale = (float)AABB3_TREE_SAH_BINS / (GetAxisValue(centerBounds.m_maxs, bestAxis) - axisMin);
+		firstRightItem = first;
+		for (int itemIndex = first; itemIndex < first + count; itemIndex++) {
+			int bin = (int)((GetAxisValue(buildItems[itemIndex].m_center, bestAxis) - axisMin) * binScale);
+			if (bin < bestSplitBin) {
+				std::swap(buildItems[itemIndex], buildItems[firstRightItem]);
+				firstRightItem++;
+			}
+		}
+	}
+
+	// All centers on top of each other, any split is as good as another
+	if (firstRightItem == first || firstRightItem == first + count) {
+		firstRightItem = first + count / 2;
+	}
+
+	int firstChild = BuildNode(buildItems, first, firstRightItem - first, nodeIndex, out_proxyIds);
+	int secondChild = BuildNode(buildItems, firstRightItem, first + count - firstRightItem, nodeIndex, out_proxyIds);
+
+	AABB3TreeNode& node = m_nodes[nodeIndex];
+	AABB3TreeNode const& firstChildNode = m_nodes[firstChild];
+	AABB3TreeNode const& secondChildNode = m_nodes[secondChild];
+	node.m_firstChild = firstChild;
+	node.m_secondChild = secondChild;
+	node.m_bounds = GetUnion(firstChildNode.m_bounds, secondChildNode.m_bounds);
+	node.m_height = 1 + ((firstChildNode.m_height > secondChildNode.m_height) ? firstChildNode.m_height : secondChildNode.m_height);
+
+	return nodeIndex;
+}
+
+void AABB3Tree::Clear()
+{
+	m_nodes.clear();
+	m_rootIndex = -1;
+	m_freeListHead = -1;
+	m_proxyCount = 0;
+}
+
+int AABB3Tree::InsertProxy(AABB3 const& bounds, int itemIndex)
+{
+	int proxyId = AllocateNode();
+	AABB3TreeNode& leaf = m_nodes[proxyId];
+	leaf.m_bounds = bounds;
+	leaf.m_itemIndex = itemIndex;
+	leaf.m_height = 0;
+
+	InsertLeaf(proxyId);
+	m_proxyCount++;
+	return proxyId;
+}
+
+void AABB3Tree::RemoveProxy(int proxyId)
+{
+	ASSERT_OR_DIE(m_nodes[proxyId].IsLeaf() && m_nodes[proxyId].m_height == 0, "REMOVING A NODE THAT IS NOT A PROXY");
+
+	RemoveLeaf(proxyId);
+	FreeNode(proxyId);
+	m_proxyCount--;
+}
+
+void AABB3Tree::MoveProxy(int proxyId, AABB3 const& newBounds)
+{
+	RemoveLeaf(proxyId);
+	m_nodes[proxyId].m_bounds = newBounds;
+	InsertLeaf(proxyId);
+}
+
+void AABB3Tree::SetProxyBounds(int proxyId, AABB3 const& newBounds)
+{
+	m_nodes[proxyId].m_bounds = newBounds;
+}
+
+void AABB3Tree::Refit()
+{
+	if (m_rootIndex == -1) return;
+
+	// Parents always come before their children in this order, so walking it backwards refits bottom-up
+	std::vector<int> nodeOrder;
+	nodeOrder.reserve(m_nodes.size());
+	nodeOrder.push_back(m_rootIndex);
+	for (int orderIndex = 0; orderIndex < (int)nodeOrder.size(); orderIndex++) {
+		AABB3TreeNode const& node = m_nodes[nodeOrder[orderIndex]];
+		if (node.IsLeaf()) continue;
+		nodeOrder.push_back(node.m_firstChild);
+		nodeOrder.push_back(node.m_secondChild);
+	}
+
+	for (int orderIndex = (int)nodeOrder.size() - 1; orderIndex >= 0; orderIndex--) {
+		AABB3TreeNode& node = m_nodes[nodeOrder[orderIndex]];
+		if (node.IsLeaf()) continue;
+		node.m_bounds = GetUnion(m_nodes[node.m_firstChild].m_bounds, m_nodes[node.m_secondChild].m_bounds);
+	}
+}
+
+RaycastHit AABB3Tree::Raycast(Vec3 const& rayStart, Vec3 const& rayForward, float maxDistance, AABB3TreeRaycastCallback itemCallback, void* userData) const
+{
+	RaycastHit nearestHit;
+	if (m_rootIndex == -1) return nearestHit;
+
+	Vec3 invForward(1.0f / rayForward.x, 1.0f / rayForward.y, 1.0f / rayForward.z);
+	float searchDistance = maxDistance;
+
+	int nodeStack[AABB3_TREE_STACK_SIZE];
+	float entryDistStack[AABB3_TREE_STACK_SIZE];
+	int stackSize = 0;
+
+	float rootEntryDist = 0.0f;
+	if (!GetRayEntryDistance(m_nodes[m_rootIndex].m_bounds, rayStart, invForward, searchDistance, rootEntryDist)) return nearestHit;
+	nodeStack[stackSize] = m_rootIndex;
+	entryDistStack[stackSize] = rootEntryDist;
+	stackSize++;
+
+	while (stackSize > 0) {
+		stackSize--;
+		AABB3TreeNode const& node = m_nodes[nodeStack[stackSize]];
+		float nodeEntryDist = entryDistStack[stackSize];
+		if (nodeEntryDist > searchDistance) continue;
+
+		if (node.IsLeaf()) {
+			float impactDist = (itemCallback) ? itemCallback(userData, node.m_itemIndex, rayStart, rayForward, searchDistance) : nodeEntryDist;
+			if (impactDist < 0.0f || impactDist > searchDistance) continue;
+			if (nearestHit.DidImpact() && impactDist >= nearestHit.m_impactDist) continue;
+
+			nearestHit.m_impactDist = impactDist;
+			nearestHit.m_index = node.m_itemIndex;
+			searchDistance = impactDist;
+			continue;
+		}
+
+		float firstEntryDist = 0.0f;
+		float secondEntryDist = 0.0f;
+		bool hitsFirst = GetRayEntryDistance(m_nodes[node.m_firstChild].m_bounds, rayStart, invForward, searchDistance, firstEntryDist);
+		bool hitsSecond = GetRayEntryDistance(m_nodes[node.m_secondChild].m_bounds, rayStart, invForward, searchDistance, secondEntryDist);
+
+		ASSERT_OR_DIE(stackSize + 2 <= AABB3_TREE_STACK_SIZE, "AABB3 TREE IS TOO DEEP TO TRAVERSE");
+
+		// Farther child goes in first so the nearer one is visited first and can shrink the ray
+		bool isFirstNearer = firstEntryDist <= secondEntryDist;
+		int farChild = (isFirstNearer) ? node.m_secondChild : node.m_firstChild;
+		int nearChild = (isFirstNearer) ? node.m_firstChild : node.m_secondChild;
+		bool hitsFar = (isFirstNearer) ? hitsSecond : hitsFirst;
+		bool hitsNear = (isFirstNearer) ? hitsFirst : hitsSecond;
+
+		if (hitsFar) {
+			nodeStack[stackSize] = farChild;
+			entryDistStack[stackSize] = (isFirstNearer) ? secondEntryDist : firstEntryDist;
+			stackSize++;
+		}
+		if (hitsNear) {
+			nodeStack[stackSize] = nearChild;
+			entryDistStack[stackSize] = (isFirstNearer) ? firstEntryDist : secondEntryDist;
+			stackSize++;
+		}
+	}
+
+	return nearestHit;
+}
+
+void AABB3Tree::GetOverlappingItems(AABB3 const& bounds, std::vector<int>& out_itemIndexes) const
+{
+	if (m_rootIndex == -1) return;
+
+	int nodeStack[AABB3_TREE_STACK_SIZE];
+	int stackSize = 0;
+	nodeStack[stackSize++] = m_rootIndex;
+
+	while (stackSize > 0) {
+		AABB3TreeNode const& node = m_nodes[nodeStack[--stackSize]];
+		if (!DoAABB3sOverlap(node.m_bounds, bounds)) continue;
+
+		if (node.IsLeaf()) {
+			out_itemIndexes.push_back(node.m_itemIndex);
+			continue;
+		}
+
+		ASSERT_OR_DIE(stackSize + 2 <= AABB3_TREE_STACK_SIZE, "AABB3 TREE IS TOO DEEP TO TRAVERSE");
+		nodeStack[stackSize++] = node.m_secondChild;
+		nodeStack[stackSize++] = node.m_firstChild;
+	}
+}
+
+void AABB3Tree::GetOverlappingItems(Vec3 const& sphereCenter, float sphereRadius, std::vector<int>& out_itemIndexes) const
+{
+	if (m_rootIndex == -1) return;
+
+	int nodeStack[AABB3_TREE_STACK_SIZE];
+	int stackSize = 0;
+	nodeStack[stackSize++] = m_rootIndex;
+
+	while (stackSize > 0) {
+		AABB3TreeNode const& node = m_nodes[nodeStack[--stackSize]];
+		if (!DoSphereAndAABB3Overlap(sphereCenter, sphereRadius, node.m_bounds)) continue;
+
+		if (node.IsLeaf()) {
+			out_itemIndexes.push_back(node.m_itemIndex);
+			continue;
+		}
+
+		ASSERT_OR_DIE(stackSize + 2 <= AABB3_TREE_STACK_SIZE, "AABB3 TREE IS TOO DEEP TO TRAVERSE");
+		nodeStack[stackSize++] = node.m_secondChild;
+		nodeStack[stackSize++] = node.m_firstChild;
+	}
+}
+
+int AABB3Tree::GetNearestItem(Vec3 const& point, float maxDistance, AABB3TreeDistanceCallback itemCallback, void* userData, float* out_distance) const
+{
+	int nearestItem = -1;
+	float nearestDist = maxDistance;
+	if (m_rootIndex == -1) return nearestItem;
+
+	int nodeStack[AABB3_TREE_STACK_SIZE];
+	float distStack[AABB3_TREE_STACK_SIZE];
+	int stackSize = 0;
+	nodeStack[stackSize] = m_rootIndex;
+	distStack[stackSize] = GetDistanceToBounds(m_nodes[m_rootIndex].m_bounds, point);
+	stackSize++;
+
+	while (stackSize > 0) {
+		stackSize--;
+		AABB3TreeNode const& node = m_nodes[nodeStack[stackSize]];
+		float nodeDist = distStack[stackSize];
+		if (nodeDist > nearestDist) continue;
+
+		if (node.IsLeaf()) {
+			float itemDist = (itemCallback) ? itemCallback(userData, node.m_itemIndex, point) : nodeDist;
+			if (itemDist > nearestDist) continue;
+			if ((nearestItem != -1) && (itemDist >= nearestDist)) continue;
+
+			nearestItem = node.m_itemIndex;
+			nearestDist = itemDist;
+			continue;
+		}
+
+		ASSERT_OR_DIE(stackSize + 2 <= AABB3_TREE_STACK_SIZE, "AABB3 TREE IS TOO DEEP TO TRAVERSE");
+
+		float firstDist = GetDistanceToBounds(m_nodes[node.m_firstChild].m_bounds, point);
+		float secondDist = GetDistanceToBounds(m_nodes[node.m_secondChild].m_bounds, point);
+		bool isFirstNearer = firstDist <= secondDist;
+
+		nodeStack[stackSize] = (isFirstNearer) ? node.m_secondChild : node.m_firstChild;
+		distStack[stackSize] = (isFirstNearer) ? secondDist : firstDist;
+		stackSize++;
+		nodeStack[stackSize] = (isFirstNearer) ? node.m_firstChild : node.m_secondChild;
+		distStack[stackSize] = (isFirstNearer) ? firstDist : secondDist;
+		stackSize++;
+	}
+
+	if (out_distance && nearestItem != -1) {
+		*out_distance = nearestDist;
+	}
+	return nearestItem;
+}
+
+int AABB3Tree::GetHeight() const
+{
+	return (m_rootIndex == -1) ? 0 : m_nodes[m_rootIndex].m_height;
+}
+
+int AABB3Tree::AllocateNode()
+{
+	if (m_freeListHead == -1) {
+		m_nodes.emplace_back();
+		AABB3TreeNode& newNode = m_nodes.back();
+		newNode.m_height = 0;
+		return (int)m_nodes.size() - 1;
+	}
+
+	int nodeIndex = m_freeListHead;
+	AABB3TreeNode& node = m_nodes[nodeIndex];
+	m_freeListHead = node.m_parent;
+	node = AABB3TreeNode();
+	node.m_height = 0;
+	return nodeIndex;
+}
+
+void AABB3Tree::FreeNode(int nodeIndex)
+{
+	AABB3TreeNode& node = m_nodes[nodeIndex];
+	node = AABB3TreeNode();
+	node.m_parent = m_freeListHead;
+	m_freeListHead = nodeIndex;
+}
+
+void AABB3Tree::InsertLeaf(int leafIndex)
+{
+	if (m_rootIndex == -1) {
+		m_rootIndex = leafIndex;
+		m_nodes[leafIndex].m_parent = -1;
+		return;
+	}
+
+	// Walk down to the sibling that grows the tree's total surface area the least
+	AABB3 leafBounds = m_nodes[leafIndex].m_bounds;
+	int siblingIndex = m_rootIndex;
+	while (!m_nodes[siblingIndex].IsLeaf()) {
+		AABB3TreeNode const& node = m_nodes[siblingIndex];
+		float nodeCost = GetBoundsCost(node.m_bounds);
+		float combinedCost = GetBoundsCost(GetUnion(node.m_bounds, leafBounds));
+
+		float newParentCost = 2.0f * combinedCost;
+		float inheritedCost = 2.0f * (combinedCost - nodeCost);
+
+		AABB3TreeNode const& firstChild = m_nodes[node.m_firstChild];
+		AABB3TreeNode const& secondChild = m_nodes[node.m_secondChild];
+		float firstCost = GetBoundsCost(GetUnion(firstChild.m_bounds, leafBounds)) + inheritedCost;
+		float secondCost = GetBoundsCost(GetUnion(secondChild.m_bounds, leafBounds)) + inheritedCost;
+		if (!firstChild.IsLeaf()) firstCost -= GetBoundsCost(firstChild.m_bounds);
+		if (!secondChild.IsLeaf()) secondCost -= GetBoundsCost(secondChild.m_bounds);
+
+		if (newParentCost < firstCost && newParentCost < secondCost) break;
+		siblingIndex = (firstCost < secondCost) ? node.m_firstChild : node.m_secondChild;
+	}
+
+	int oldParentIndex = m_nodes[siblingIndex].m_parent;
+	int newParentIndex = AllocateNode();
+	AABB3TreeNode& newParent = m_nodes[newParentIndex];
+	newParent.m_parent = oldParentIndex;
+	newParent.m_bounds = GetUnion(leafBounds, m_nodes[siblingIndex].m_bounds);
+	newParent.m_height = m_nodes[siblingIndex].m_height + 1;
+	newParent.m_firstChild = siblingIndex;
+	newParent.m_secondChild = leafIndex;
+
+	if (oldParentIndex == -1) {
+		m_rootIndex = newParentIndex;
+	}
+	else {
+		AABB3TreeNode& oldParent = m_nodes[oldParentIndex];
+		if (oldParent.m_firstChild == siblingIndex) {
+			oldParent.m_firstChild = newParentIndex;
+		}
+		else {
+			oldParent.m_secondChild = newParentIndex;
+		}
+	}
+
+	m_nodes[siblingIndex].m_parent = newParentIndex;
+	m_nodes[leafIndex].m_parent = newParentIndex;
+
+	RefitAncestors(m_nodes[leafIndex].m_parent);
+}
+
+void AABB3Tree::RemoveLeaf(int leafIndex)
+{
+	if (leafIndex == m_rootIndex) {
+		m_rootIndex = -1;
+		return;
+	}
+
+	int parentIndex = m_nodes[leafIndex].m_parent;
+	AABB3TreeNode const& parent = m_nodes[parentIndex];
+	int grandParentIndex = parent.m_parent;
+	int siblingIndex = (parent.m_firstChild == leafIndex) ? parent.m_secondChild : parent.m_firstChild;
+
+	FreeNode(parentIndex);
+	m_nodes[siblingIndex].m_parent = grandParentIndex;
+	m_nodes[leafIndex].m_parent = -1;
+
+	if (grandParentIndex == -1) {
+		m_rootIndex = siblingIndex;
+		return;
+	}
+
+	AABB3TreeNode& grandParent = m_nodes[grandParentIndex];
+	if (grandParent.m_firstChild == parentIndex) {
+		grandParent.m_firstChild = siblingIndex;
+	}
+	else {
+		grandParent.m_secondChild = siblingIndex;
+	}
+
+	RefitAncestors(grandParentIndex);
+}
+
+void AABB3Tree::RefitAncestors(int nodeIndex)
+{
+	while (nodeIndex != -1) {
+		nodeIndex = Balance(nodeIndex);
+
+		AABB3TreeNode& node = m_nodes[nodeIndex];
+		AABB3TreeNode const& firstChild = m_nodes[node.m_firstChild];
+		AABB3TreeNode const& secondChild = m_nodes[node.m_secondChild];
+		node.m_bounds = GetUnion(firstChild.m_bounds, secondChild.m_bounds);
+		node.m_height = 1 + ((firstChild.m_height > secondChild.m_height) ? firstChild.m_height : secondChild.m_height);
+
+		nodeIndex = node.m_parent;
+	}
+}
+
+// Rotates the taller child up when the children's heights differ by more than one. Returns the node now in nodeIndex's place
+int AABB3Tree::Balance(int nodeIndex)
+{
+	AABB3TreeNode& nodeA = m_nodes[nodeIndex];
+	if (nodeA.IsLeaf() || nodeA.m_height < 2) return nodeIndex;
+
+	int indexB = nodeA.m_firstChild;
+	int indexC = nodeA.m_secondChild;
+	AABB3TreeNode& nodeB = m_nodes[indexB];
+	AABB3TreeNode& nodeC = m_nodes[indexC];
+
+	int balance = nodeC.m_height - nodeB.m_height;
+	if (balance > 1) {
+		int indexF = nodeC.m_firstChild;
+		int indexG = nodeC.m_secondChild;
+		AABB3TreeNode& nodeF = m_nodes[indexF];
+		AABB3TreeNode& nodeG = m_nodes[indexG];
+
+		nodeC.m_firstChild = nodeIndex;
+		nodeC.m_parent = nodeA.m_parent;
+		nodeA.m_parent = indexC;
+
+		if (nodeC.m_parent == -1) {
+			m_rootIndex = indexC;
+		}
+		else if (m_nodes[nodeC.m_parent].m_firstChild == nodeIndex) {
+			m_nodes[nodeC.m_parent].m_firstChild = indexC;
+		}
+		else {
+			m_nodes[nodeC.m_parent].m_secondChild = indexC;
+		}
+
+		if (nodeF.m_height > nodeG.m_height) {
+			nodeC.m_secondChild = indexF;
+			nodeA.m_secondChild = indexG;
+			nodeG.m_parent = nodeIndex;
+			nodeA.m_bounds = GetUnion(nodeB.m_bounds, nodeG.m_bounds);
+			nodeC.m_bounds = GetUnion(nodeA.m_bounds, nodeF.m_bounds);
+			nodeA.m_height = 1 + ((nodeB.m_height > nodeG.m_height) ? nodeB.m_height : nodeG.m_height);
+			nodeC.m_height = 1 + ((nodeA.m_height > nodeF.m_height) ? nodeA.m_height : nodeF.m_height);
+		}
+		else {
+			nodeC.m_secondChild = indexG;
+			nodeA.m_secondChild = indexF;
+			nodeF.m_parent = nodeIndex;
+			nodeA.m_bounds = GetUnion(nodeB.m_bounds, nodeF.m_bounds);
+			nodeC.m_bounds = GetUnion(nodeA.m_bounds, nodeG.m_bounds);
+			nodeA.m_height = 1 + ((nodeB.m_height > nodeF.m_height) ? nodeB.m_height : nodeF.m_height);
+			nodeC.m_height = 1 + ((nodeA.m_height > nodeG.m_height) ? nodeA.m_height : nodeG.m_height);
+		}
+
+		return indexC;
+	}
+
+	if (balance < -1) {
+		int indexD = nodeB.m_firstChild;
+		int indexE = nodeB.m_secondChild;
+		AABB3TreeNode& nodeD = m_nodes[indexD];
+		AABB3TreeNode& nodeE = m_nodes[indexE];
+
+		nodeB.m_firstChild = nodeIndex;
+		nodeB.m_parent = nodeA.m_parent;
+		nodeA.m_parent = indexB;
+
+		if (nodeB.m_parent == -1) {
+			m_rootIndex = indexB;
+		}
+		else if (m_nodes[nodeB.m_parent].m_firstChild == nodeIndex) {
+			m_nodes[nodeB.m_parent].m_firstChild = indexB;
+		}
+		else {
+			m_nodes[nodeB.m_parent].m_secondChild = indexB;
+		}
+
+		if (nodeD.m_height > nodeE.m_height) {
+			nodeB.m_secondChild = indexD;
+			nodeA.m_firstChild = indexE;
+			nodeE.m_parent = nodeIndex;
+			nodeA.m_bounds = GetUnion(nodeC.m_bounds, nodeE.m_bounds);
+			nodeB.m_bounds = GetUnion(nodeA.m_bounds, nodeD.m_bounds);
+			nodeA.m_height = 1 + ((nodeC.m_height > nodeE.m_height) ? nodeC.m_height : nodeE.m_height);
+			nodeB.m_height = 1 + ((nodeA.m_height > nodeD.m_height) ? nodeA.m_height : nodeD.m_height);
+		}
+		else {
+			nodeB.m_secondChild = indexE;
+			nodeA.m_firstChild = indexD;
+			nodeD.m_parent = nodeIndex;
+			nodeA.m_bounds = GetUnion(nodeC.m_bounds, nodeD.m_bounds);
+			nodeB.m_bounds = GetUnion(nodeA.m_bounds, nodeE.m_bounds);
+			nodeA.m_height = 1 + ((nodeC.m_height > nodeD.m_height) ? nodeC.m_height : nodeD.m_height);
+			nodeB.m_height = 1 + ((nodeA.m_height > nodeE.m_height) ? nodeA.m_height : nodeE.m_height);
+		}
+
+		return indexB;
+	}
+
+	return nodeIndex;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+#include <float.h>
+#include <vector>
+
+struct AABB3TreeBuildItem;
+
+// Exact test against the item stored in a leaf. Returns the distance along the ray, negative if the item is missed
+typedef float (*AABB3TreeRaycastCallback)(void* userData, int itemIndex, Vec3 const& rayStart, Vec3 const& rayForward, float maxDistance);
+// Exact distance from a point to the item stored in a leaf
+typedef float (*AABB3TreeDistanceCallback)(void* userData, int itemIndex, Vec3 const& point);
+
+struct AABB3TreeNode {
+	AABB3 m_bounds = AABB3::ZERO_TO_ONE;
+	int m_parent = -1; // Next free node while the node is in the free list
+	int m_firstChild = -1;
+	int m_secondChild = -1;
+	int m_itemIndex = -1;
+	int m_height = -1; // 0 for leaves, -1 for free nodes
+
+	bool IsLeaf() const { return m_firstChild == -1; }
+};
+
+// Bounding volume hierarchy over AABB3s, stored as one flat node array. Leaves are "proxies": their node index is
+// handed out as the proxy id and stays valid until the proxy is removed, no matter how the tree is restructured
+class AABB3Tree {
+public:
+	AABB3Tree() = default;
+	~AABB3Tree() = default;
+
+	// Top-down binned SAH build; replaces the current contents. Item indexes are the positions in itemBounds
+	void Build(std::vector<AABB3> const& itemBounds, std::vector<int>* out_proxyIds = nullptr);
+	void Clear();
+
+	// Incremental changes. Inserts pick the cheapest sibling by surface area and rebalance with tree rotations
+	int InsertProxy(AABB3 const& bounds, int itemIndex);
+	void RemoveProxy(int proxyId);
+	void MoveProxy(int proxyId, AABB3 const& newBounds);
+
+	// Only touches the leaf. Call Refit once after updating a batch of proxies, before querying again
+	void SetProxyBounds(int proxyId, AABB3 const& newBounds);
+	void Refit();
+
+	// Nearest item along the ray. Without a callback, the items are their bounds
+	RaycastHit Raycast(Vec3 const& rayStart, Vec3 const& rayForward, float maxDistance, AABB3TreeRaycastCallback itemCallback = nullptr, void* userData = nullptr) const;
+	void GetOverlappingItems(AABB3 const& bounds, std::vector<int>& out_itemIndexes) const;
+	void GetOverlappingItems(Vec3 const& sphereCenter, float sphereRadius, std::vector<int>& out_itemIndexes) const;
+	int GetNearestItem(Vec3 const& point, float maxDistance = FLT_MAX, AABB3TreeDistanceCallback itemCallback = nullptr, void* userData = nullptr, float* out_distance = nullptr) const;
+
+	int GetRootIndex() const { return m_rootIndex; }
+	int GetHeight() const;
+	int GetProxyCount() const { return m_proxyCount; }
+	AABB3TreeNode const& GetNode(int nodeIndex) const { return m_nodes[nodeIndex]; }
+	std::vector<AABB3TreeNode> const& GetNodes() const { return m_nodes; }
+	AABB3 const& GetProxyBounds(int proxyId) const { return m_nodes[proxyId].m_bounds; }
+	int GetItemIndex(int proxyId) const { return m_nodes[proxyId].m_itemIndex; }
+
+private:
+	int AllocateNode();
+	void FreeNode(int nodeIndex);
+	void InsertLeaf(int leafIndex);
+	void RemoveLeaf(int leafIndex);
+	void RefitAncestors(int nodeIndex);
+	int Balance(int nodeIndex);
+	int BuildNode(std::vector<AABB3TreeBuildItem>& buildItems, int first, int count, int parentIndex, std::vector<int>* out_proxyIds);
+
+private:
+	std::vector<AABB3TreeNode> m_nodes;
+	int m_rootIndex = -1;
+	int m_freeListHead = -1;
+	int m_proxyCount = 0;
+};
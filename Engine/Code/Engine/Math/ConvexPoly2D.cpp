@@ -6,6 +6,7 @@
 #include "Engine/Math/Plane2D.hpp"
 #include "Engine/Core/BufferUtils.hpp"
 #include <algorithm>
+#include <float.h>
 
 DelaunayConvexPoly2D::DelaunayConvexPoly2D(std::vector<Vec2> vertexes) :
 	m_vertexes(vertexes)
@@ -271,9 +272,7 @@ void ConvexPoly2D::WritePolyToBuffer(std::vector<unsigned char>& buffer) const
 	BufferWriter bufWriter(buffer);
 
 	bufWriter.AppendeByte((unsigned char)m_ccwPoints.size());
-	for (Vec2 const& vertex : m_ccwPoints) {
-		bufWriter.AppendVec2(vertex);
-	}
+	bufWriter.AppendArray(m_ccwPoints);
 
 }
 
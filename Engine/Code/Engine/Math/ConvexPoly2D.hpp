@@ -61,6 +61,10 @@ public:
 
 	friend void AddVertsForConvexPoly2D(std::vector<Vertex_PCU>& verts, ConvexPoly2D const& convexPoly, Rgba8 const& color);
 	friend void AddVertsForWireConvexPoly2D(std::vector<Vertex_PCU>& verts, ConvexPoly2D const& convexPoly, Rgba8 const& borderColor, float lineThickness);
+	friend Vertex_PCU* AddVertsForConvexPoly2D(Vertex_PCU* verts, ConvexPoly2D const& convexPoly, Rgba8 const& color);
+	friend Vertex_PCU* AddVertsForWireConvexPoly2D(Vertex_PCU* verts, ConvexPoly2D const& convexPoly, Rgba8 const& borderColor, float lineThickness);
+	friend int GetVertCountForConvexPoly2D(ConvexPoly2D const& convexPoly);
+	friend int GetVertCountForWireConvexPoly2D(ConvexPoly2D const& convexPoly);
 	AABB2 GetBoundingBox() const;
 
 	void WritePolyToBuffer(std::vector<unsigned char>& buffer) const;
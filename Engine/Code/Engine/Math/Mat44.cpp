@@ -3,7 +3,29 @@
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/Vec4.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Game/EngineBuildPreferences.hpp"
+
+#if !defined(ENGINE_DISABLE_SIMD)
+// 2x2 matrices packed as (m00, m01, m10, m11)
+static __m128 Mat2Mul(__m128 const& a, __m128 const& b)
+{
+	return _mm_add_ps(_mm_mul_ps(a, SIMD_SWIZZLE(b, 0, 3, 0, 3)), _mm_mul_ps(SIMD_SWIZZLE(a, 1, 0, 3, 2), SIMD_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+// adj(a) * b
+static __m128 Mat2AdjMul(__m128 const& a, __m128 const& b)
+{
+	return _mm_sub_ps(_mm_mul_ps(SIMD_SWIZZLE(a, 3, 3, 0, 0), b), _mm_mul_ps(SIMD_SWIZZLE(a, 1, 1, 2, 2), SIMD_SWIZZLE(b, 2, 3, 0, 1)));
+}
+
+// a * adj(b)
+static __m128 Mat2MulAdj(__m128 const& a, __m128 const& b)
+{
+	return _mm_sub_ps(_mm_mul_ps(a, SIMD_SWIZZLE(b, 3, 0, 3, 0)), _mm_mul_ps(SIMD_SWIZZLE(a, 1, 0, 3, 2), SIMD_SWIZZLE(b, 2, 1, 2, 1)));
+}
+#endif
 
 Mat44::Mat44()
 {
@@ -370,6 +392,7 @@ Vec4 const Mat44::GetTranslation4D() const
 
 Mat44 const Mat44::GetInverted() const
 {
+#if defined(ENGINE_DISABLE_SIMD)
 	double inv[16];
 	double det;
 	double m[16];
@@ -500,6 +523,52 @@ Mat44 const Mat44::GetInverted() const
 	}
 
 	return ret;
+#else
+	// Block-wise inverse over the four 2x2 sub-matrices. The basis vectors are loaded as rows, which inverts the transpose,
+	// and storing the rows back out transposes it again
+	__m128 iBasis = _mm_loadu_ps(&m_values[Ix]);
+	__m128 jBasis = _mm_loadu_ps(&m_values[Jx]);
+	__m128 kBasis = _mm_loadu_ps(&m_values[Kx]);
+	__m128 tBasis = _mm_loadu_ps(&m_values[Tx]);
+
+	__m128 A = _mm_movelh_ps(iBasis, jBasis);
+	__m128 B = _mm_movehl_ps(jBasis, iBasis);
+	__m128 C = _mm_movelh_ps(kBasis, tBasis);
+	__m128 D = _mm_movehl_ps(tBasis, kBasis);
+
+	// (|A| |B| |C| |D|)
+	__m128 subDeterminants = _mm_sub_ps(
+		_mm_mul_ps(SIMD_SHUFFLE(iBasis, kBasis, 0, 2, 0, 2), SIMD_SHUFFLE(jBasis, tBasis, 1, 3, 1, 3)),
+		_mm_mul_ps(SIMD_SHUFFLE(iBasis, kBasis, 1, 3, 1, 3), SIMD_SHUFFLE(jBasis, tBasis, 0, 2, 0, 2)));
+	__m128 detA = SIMD_SPLAT(subDeterminants, 0);
+	__m128 detB = SIMD_SPLAT(subDeterminants, 1);
+	__m128 detC = SIMD_SPLAT(subDeterminants, 2);
+	__m128 detD = SIMD_SPLAT(subDeterminants, 3);
+
+	__m128 adjDMulC = Mat2AdjMul(D, C);
+	__m128 adjAMulB = Mat2AdjMul(A, B);
+	__m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, adjDMulC));
+	__m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, adjAMulB));
+	__m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, adjAMulB));
+	__m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, adjDMulC));
+
+	// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+	__m128 trace = SIMDHorizontalAdd(_mm_mul_ps(adjAMulB, SIMD_SWIZZLE(adjDMulC, 0, 2, 1, 3)));
+	__m128 determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+	__m128 invDeterminant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+
+	X = _mm_mul_ps(X, invDeterminant);
+	Y = _mm_mul_ps(Y, invDeterminant);
+	Z = _mm_mul_ps(Z, invDeterminant);
+	W = _mm_mul_ps(W, invDeterminant);
+
+	Mat44 ret;
+	_mm_storeu_ps(&ret.m_values[Ix], SIMD_SHUFFLE(X, Y, 3, 1, 3, 1));
+	_mm_storeu_ps(&ret.m_values[Jx], SIMD_SHUFFLE(X, Y, 2, 0, 2, 0));
+	_mm_storeu_ps(&ret.m_values[Kx], SIMD_SHUFFLE(Z, W, 3, 1, 3, 1));
+	_mm_storeu_ps(&ret.m_values[Tx], SIMD_SHUFFLE(Z, W, 2, 0, 2, 0));
+	return ret;
+#endif
 }
 
 void Mat44::SetTranslation2D(Vec2 const& translationXY)
@@ -615,6 +684,7 @@ void Mat44::SetIJKT4D(Vec4 const& iBasis4D, Vec4 const& jBasis4D, Vec4 const& kB
 
 void Mat44::Append(Mat44 const& appendThis)
 {
+#if defined(ENGINE_DISABLE_SIMD)
 	Mat44 result;
 	result.m_values[Ix] = (m_values[Ix] * appendThis.m_values[Ix]) + (m_values[Jx] * appendThis.m_values[Iy]) + (m_values[Kx] * appendThis.m_values[Iz]) + (m_values[Tx] * appendThis.m_values[Iw]);
 	result.m_values[Jx] = (m_values[Ix] * appendThis.m_values[Jx]) + (m_values[Jx] * appendThis.m_values[Jy]) + (m_values[Kx] * appendThis.m_values[Jz]) + (m_values[Tx] * appendThis.m_values[Jw]);
@@ -637,6 +707,22 @@ void Mat44::Append(Mat44 const& appendThis)
 	result.m_values[Tw] = (m_values[Iw] * appendThis.m_values[Tx]) + (m_values[Jw] * appendThis.m_values[Ty]) + (m_values[Kw] * appendThis.m_values[Tz]) + (m_values[Tw] * appendThis.m_values[Tw]);
 
 	*this = result;
+#else
+	__m128 iBasis = _mm_loadu_ps(&m_values[Ix]);
+	__m128 jBasis = _mm_loadu_ps(&m_values[Jx]);
+	__m128 kBasis = _mm_loadu_ps(&m_values[Kx]);
+	__m128 tBasis = _mm_loadu_ps(&m_values[Tx]);
+
+	// Each result column is this matrix applied to the matching column of appendThis
+	for (int column = 0; column < 16; column += 4) {
+		__m128 appendColumn = _mm_loadu_ps(&appendThis.m_values[column]);
+		__m128 result = _mm_mul_ps(iBasis, SIMD_SPLAT(appendColumn, 0));
+		result = _mm_add_ps(result, _mm_mul_ps(jBasis, SIMD_SPLAT(appendColumn, 1)));
+		result = _mm_add_ps(result, _mm_mul_ps(kBasis, SIMD_SPLAT(appendColumn, 2)));
+		result = _mm_add_ps(result, _mm_mul_ps(tBasis, SIMD_SPLAT(appendColumn, 3)));
+		_mm_storeu_ps(&m_values[column], result);
+	}
+#endif
 }
 
 void Mat44::AppendZRotation(float degreesRotationAboutZ)
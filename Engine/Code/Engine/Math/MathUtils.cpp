@@ -15,6 +15,7 @@
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Math/ConvexPoly2D.hpp"
 #include "Engine/Math/ConvexHull2D.hpp"
+#include <float.h>
 
 float ConvertDegreesToRadians(float degrees) {
 	return degrees * static_cast<float>(M_PI) / 180.0f;
@@ -4,12 +4,15 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/FloatRange.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/OBB2.hpp"
 #include "Engine/Math/Plane2D.hpp"
 #include "Engine/Math/ConvexHull2D.hpp"
 #include "Engine/Math/ConvexPoly2D.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include <algorithm>
+#include <float.h>
 
 
 RaycastResult2D RaycastVsDisc(Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance, Vec2 const& discCenter, float discRadius)
@@ -431,7 +434,9 @@ RaycastResult3D RaycastVsZCylinder(Vec3 const& rayStart, Vec3 const& rayForward,
 			return raycastResult;
 		}
 
+		// The disc test only bounds the xy distance, so the wall and caps are checked against the ray's 3D length too
 		if (cylinderAllowedRange.IsOnRange(hitPos.z)) {
+			if (rayLengthAtHit > maxDistance) return raycastResult;
 			raycastResult.m_didImpact = true;
 			raycastResult.m_impactPos = hitPos;
 			raycastResult.m_impactDist = GetDistance3D(rayStart, hitPos);
@@ -446,7 +451,7 @@ RaycastResult3D RaycastVsZCylinder(Vec3 const& rayStart, Vec3 const& rayForward,
 			rayLengthAtHit = (distToTop * distToTop) + (xyDistToHit * xyDistToHit);
 			rayLengthAtHit = sqrtf(rayLengthAtHit);
 			hitPos = rayStart + rayForward * rayLengthAtHit;
-			if (!IsPointInsideDisc2D(Vec2(hitPos.x, hitPos.y), Vec2(cylinderBase.x, cylinderBase.y), cylinderRadius)) return raycastResult;
+			if (!IsPointInsideDisc2D(Vec2(hitPos.x, hitPos.y), Vec2(cylinderBase.x, cylinderBase.y), cylinderRadius) || (rayLengthAtHit > maxDistance)) return raycastResult;
 			raycastResult.m_didImpact = true;
 			raycastResult.m_impactPos = hitPos;
 			raycastResult.m_impactDist = rayLengthAtHit;
@@ -462,7 +467,7 @@ RaycastResult3D RaycastVsZCylinder(Vec3 const& rayStart, Vec3 const& rayForward,
 			rayLengthAtHit = (distToTop * distToTop) + (xyDistToHit * xyDistToHit);
 			rayLengthAtHit = sqrtf(rayLengthAtHit);
 			hitPos = rayStart + rayForward * rayLengthAtHit;
-			if (!IsPointInsideDisc2D(Vec2(hitPos.x, hitPos.y), Vec2(cylinderBase.x, cylinderBase.y), cylinderRadius)) return raycastResult;
+			if (!IsPointInsideDisc2D(Vec2(hitPos.x, hitPos.y), Vec2(cylinderBase.x, cylinderBase.y), cylinderRadius) || (rayLengthAtHit > maxDistance)) return raycastResult;
 			raycastResult.m_didImpact = true;
 			raycastResult.m_impactPos = hitPos;
 			raycastResult.m_impactDist = rayLengthAtHit;
@@ -702,3 +707,606 @@ RaycastResult3D RaycastVsPlane(Vec3 const& rayStart, Vec3 const& rayForward, flo
 	return raycastResult;
 }
 
+void DiscPacket2D::AddDisc(Vec2 const& center, float radius)
+{
+	m_centersX.push_back(center.x);
+	m_centersY.push_back(center.y);
+	m_radii.push_back(radius);
+}
+
+void DiscPacket2D::Reserve(int count)
+{
+	m_centersX.reserve(count);
+	m_centersY.reserve(count);
+	m_radii.reserve(count);
+}
+
+void DiscPacket2D::Clear()
+{
+	m_centersX.clear();
+	m_centersY.clear();
+	m_radii.clear();
+}
+
+void AABB2Packet2D::AddBox(AABB2 const& box)
+{
+	m_minsX.push_back(box.m_mins.x);
+	m_minsY.push_back(box.m_mins.y);
+	m_maxsX.push_back(box.m_maxs.x);
+	m_maxsY.push_back(box.m_maxs.y);
+}
+
+void AABB2Packet2D::Reserve(int count)
+{
+	m_minsX.reserve(count);
+	m_minsY.reserve(count);
+	m_maxsX.reserve(count);
+	m_maxsY.reserve(count);
+}
+
+void AABB2Packet2D::Clear()
+{
+	m_minsX.clear();
+	m_minsY.clear();
+	m_maxsX.clear();
+	m_maxsY.clear();
+}
+
+void SpherePacket3D::AddSphere(Vec3 const& center, float radius)
+{
+	m_centersX.push_back(center.x);
+	m_centersY.push_back(center.y);
+	m_centersZ.push_back(center.z);
+	m_radii.push_back(radius);
+}
+
+void SpherePacket3D::Reserve(int count)
+{
+	m_centersX.reserve(count);
+	m_centersY.reserve(count);
+	m_centersZ.reserve(count);
+	m_radii.reserve(count);
+}
+
+void SpherePacket3D::Clear()
+{
+	m_centersX.clear();
+	m_centersY.clear();
+	m_centersZ.clear();
+	m_radii.clear();
+}
+
+void AABB3Packet3D::AddBox(AABB3 const& box)
+{
+	m_minsX.push_back(box.m_mins.x);
+	m_minsY.push_back(box.m_mins.y);
+	m_minsZ.push_back(box.m_mins.z);
+	m_maxsX.push_back(box.m_maxs.x);
+	m_maxsY.push_back(box.m_maxs.y);
+	m_maxsZ.push_back(box.m_maxs.z);
+}
+
+void AABB3Packet3D::Reserve(int count)
+{
+	m_minsX.reserve(count);
+	m_minsY.reserve(count);
+	m_minsZ.reserve(count);
+	m_maxsX.reserve(count);
+	m_maxsY.reserve(count);
+	m_maxsZ.reserve(count);
+}
+
+void AABB3Packet3D::Clear()
+{
+	m_minsX.clear();
+	m_minsY.clear();
+	m_minsZ.clear();
+	m_maxsX.clear();
+	m_maxsY.clear();
+	m_maxsZ.clear();
+}
+
+void ZCylinderPacket3D::AddCylinder(Vec3 const& base, float radius, float height)
+{
+	m_basesX.push_back(base.x);
+	m_basesY.push_back(base.y);
+	m_basesZ.push_back(base.z);
+	m_radii.push_back(radius);
+	m_heights.push_back(height);
+}
+
+void ZCylinderPacket3D::Reserve(int count)
+{
+	m_basesX.reserve(count);
+	m_basesY.reserve(count);
+	m_basesZ.reserve(count);
+	m_radii.reserve(count);
+	m_heights.reserve(count);
+}
+
+void ZCylinderPacket3D::Clear()
+{
+	m_basesX.clear();
+	m_basesY.clear();
+	m_basesZ.clear();
+	m_radii.clear();
+	m_heights.clear();
+}
+
+void RayPacket2D::AddRay(Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance)
+{
+	m_startsX.push_back(rayStart.x);
+	m_startsY.push_back(rayStart.y);
+	m_forwardsX.push_back(rayForward.x);
+	m_forwardsY.push_back(rayForward.y);
+	m_maxDistances.push_back(maxDistance);
+}
+
+void RayPacket2D::Reserve(int count)
+{
+	m_startsX.reserve(count);
+	m_startsY.reserve(count);
+	m_forwardsX.reserve(count);
+	m_forwardsY.reserve(count);
+	m_maxDistances.reserve(count);
+}
+
+void RayPacket2D::Clear()
+{
+	m_startsX.clear();
+	m_startsY.clear();
+	m_forwardsX.clear();
+	m_forwardsY.clear();
+	m_maxDistances.clear();
+}
+
+void RayPacket3D::AddRay(Vec3 const& rayStart, Vec3 const& rayForward, float maxDistance)
+{
+	m_startsX.push_back(rayStart.x);
+	m_startsY.push_back(rayStart.y);
+	m_startsZ.push_back(rayStart.z);
+	m_forwardsX.push_back(rayForward.x);
+	m_forwardsY.push_back(rayForward.y);
+	m_forwardsZ.push_back(rayForward.z);
+	m_maxDistances.push_back(maxDistance);
+}
+
+void RayPacket3D::Reserve(int count)
+{
+	m_startsX.reserve(count);
+	m_startsY.reserve(count);
+	m_startsZ.reserve(count);
+	m_forwardsX.reserve(count);
+	m_forwardsY.reserve(count);
+	m_forwardsZ.reserve(count);
+	m_maxDistances.reserve(count);
+}
+
+void RayPacket3D::Clear()
+{
+	m_startsX.clear();
+	m_startsY.clear();
+	m_startsZ.clear();
+	m_forwardsX.clear();
+	m_forwardsY.clear();
+	m_forwardsZ.clear();
+	m_maxDistances.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------
+// Batched kernels. Each one tests four ray/shape pairs and returns the impact distance per lane, FLT_MAX on a miss
+static inline __m128 SelectLanes(__m128 const& mask, __m128 const& ifTrue, __m128 const& ifFalse)
+{
+	return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+// The last group of a packet can be partial; missing lanes are zero filled and discarded by the callers
+static inline __m128 LoadLanes(std::vector<float> const& values, int first)
+{
+	int valueCount = (int)values.size();
+	if (first + 4 <= valueCount) return _mm_loadu_ps(values.data() + first);
+
+	float lanes[4] = {};
+	for (int laneIndex = 0; first + laneIndex < valueCount; laneIndex++) {
+		lanes[laneIndex] = values[first + laneIndex];
+	}
+	return _mm_loadu_ps(lanes);
+}
+
+static __m128 GetDiscImpactDists(__m128 const& startX, __m128 const& startY, __m128 const& fwdX, __m128 const& fwdY, __m128 const& maxDist,
+	__m128 const& centerX, __m128 const& centerY, __m128 const& radius)
+{
+	__m128 const zero = _mm_setzero_ps();
+	__m128 dispX = _mm_sub_ps(centerX, startX);
+	__m128 dispY = _mm_sub_ps(centerY, startY);
+
+	__m128 fwdDist = _mm_add_ps(_mm_mul_ps(dispX, fwdX), _mm_mul_ps(dispY, fwdY));
+	__m128 leftDist = _mm_sub_ps(_mm_mul_ps(dispY, fwdX), _mm_mul_ps(dispX, fwdY));
+	__m128 radiusSqr = _mm_mul_ps(radius, radius);
+	__m128 distSqr = _mm_add_ps(_mm_mul_ps(dispX, dispX), _mm_mul_ps(dispY, dispY));
+
+	__m128 halfChordSqr = _mm_sub_ps(radiusSqr, _mm_mul_ps(leftDist, leftDist));
+	__m128 impactDist = _mm_sub_ps(fwdDist, _mm_sqrt_ps(_mm_max_ps(halfChordSqr, zero)));
+
+	__m128 isStartInside = _mm_cmplt_ps(distSqr, radiusSqr);
+	__m128 didImpact = _mm_and_ps(_mm_cmpgt_ps(halfChordSqr, zero), _mm_cmpgt_ps(fwdDist, zero));
+	didImpact = _mm_and_ps(didImpact, _mm_cmple_ps(impactDist, maxDist));
+
+	impactDist = SelectLanes(isStartInside, zero, impactDist);
+	return SelectLanes(_mm_or_ps(isStartInside, didImpact), impactDist, _mm_set1_ps(FLT_MAX));
+}
+
+static __m128 GetBox2DImpactDists(__m128 const& startX, __m128 const& startY, __m128 const& fwdX, __m128 const& fwdY, __m128 const& maxDist,
+	__m128 const& minX, __m128 const& minY, __m128 const& maxX, __m128 const& maxY)
+{
+	__m128 const zero = _mm_setzero_ps();
+	__m128 const one = _mm_set1_ps(1.0f);
+	__m128 invFwdX = _mm_div_ps(one, fwdX);
+	__m128 invFwdY = _mm_div_ps(one, fwdY);
+
+	__m128 minXEntry = _mm_mul_ps(_mm_sub_ps(minX, startX), invFwdX);
+	__m128 maxXEntry = _mm_mul_ps(_mm_sub_ps(maxX, startX), invFwdX);
+	__m128 minYEntry = _mm_mul_ps(_mm_sub_ps(minY, startY), invFwdY);
+	__m128 maxYEntry = _mm_mul_ps(_mm_sub_ps(maxY, startY), invFwdY);
+
+	__m128 enterDist = _mm_max_ps(_mm_min_ps(minXEntry, maxXEntry), _mm_min_ps(minYEntry, maxYEntry));
+	__m128 exitDist = _mm_min_ps(_mm_max_ps(minXEntry, maxXEntry), _mm_max_ps(minYEntry, maxYEntry));
+
+	__m128 isStartInside = _mm_and_ps(_mm_cmplt_ps(minX, startX), _mm_cmplt_ps(startX, maxX));
+	isStartInside = _mm_and_ps(isStartInside, _mm_and_ps(_mm_cmplt_ps(minY, startY), _mm_cmplt_ps(startY, maxY)));
+
+	__m128 didImpact = _mm_and_ps(_mm_cmple_ps(enterDist, exitDist), _mm_cmpge_ps(exitDist, zero));
+	didImpact = _mm_and_ps(didImpact, _mm_cmple_ps(enterDist, maxDist));
+
+	__m128 impactDist = SelectLanes(isStartInside, zero, _mm_max_ps(enterDist, zero));
+	return SelectLanes(_mm_or_ps(isStartInside, didImpact), impactDist, _mm_set1_ps(FLT_MAX));
+}
+
+static __m128 GetSphereImpactDists(__m128 const& startX, __m128 const& startY, __m128 const& startZ, __m128 const& fwdX, __m128 const& fwdY, __m128 const& fwdZ, __m128 const& maxDist,
+	__m128 const& centerX, __m128 const& centerY, __m128 const& centerZ, __m128 const& radius)
+{
+	__m128 const zero = _mm_setzero_ps();
+	__m128 dispX = _mm_sub_ps(centerX, startX);
+	__m128 dispY = _mm_sub_ps(centerY, startY);
+	__m128 dispZ = _mm_sub_ps(centerZ, startZ);
+
+	__m128 fwdDist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dispX, fwdX), _mm_mul_ps(dispY, fwdY)), _mm_mul_ps(dispZ, fwdZ));
+	__m128 distSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dispX, dispX), _mm_mul_ps(dispY, dispY)), _mm_mul_ps(dispZ, dispZ));
+	__m128 radiusSqr = _mm_mul_ps(radius, radius);
+
+	__m128 halfChordSqr = _mm_sub_ps(radiusSqr, _mm_sub_ps(distSqr, _mm_mul_ps(fwdDist, fwdDist)));
+	__m128 impactDist = _mm_sub_ps(fwdDist, _mm_sqrt_ps(_mm_max_ps(halfChordSqr, zero)));
+
+	__m128 isStartInside = _mm_cmplt_ps(distSqr, radiusSqr);
+	__m128 didImpact = _mm_and_ps(_mm_cmpge_ps(halfChordSqr, zero), _mm_cmpge_ps(impactDist, zero));
+	didImpact = _mm_and_ps(didImpact, _mm_cmple_ps(impactDist, maxDist));
+
+	impactDist = SelectLanes(isStartInside, zero, impactDist);
+	return SelectLanes(_mm_or_ps(isStartInside, didImpact), impactDist, _mm_set1_ps(FLT_MAX));
+}
+
+static __m128 GetBox3DImpactDists(__m128 const& startX, __m128 const& startY, __m128 const& startZ, __m128 const& fwdX, __m128 const& fwdY, __m128 const& fwdZ, __m128 const& maxDist,
+	__m128 const& minX, __m128 const& minY, __m128 const& minZ, __m128 const& maxX, __m128 const& maxY, __m128 const& maxZ)
+{
+	__m128 const zero = _mm_setzero_ps();
+	__m128 const one = _mm_set1_ps(1.0f);
+	__m128 invFwdX = _mm_div_ps(one, fwdX);
+	__m128 invFwdY = _mm_div_ps(one, fwdY);
+	__m128 invFwdZ = _mm_div_ps(one, fwdZ);
+
+	__m128 minXEntry = _mm_mul_ps(_mm_sub_ps(minX, startX), invFwdX);
+	__m128 maxXEntry = _mm_mul_ps(_mm_sub_ps(maxX, startX), invFwdX);
+	__m128 minYEntry = _mm_mul_ps(_mm_sub_ps(minY, startY), invFwdY);
+	__m128 maxYEntry = _mm_mul_ps(_mm_sub_ps(maxY, startY), invFwdY);
+	__m128 minZEntry = _mm_mul_ps(_mm_sub_ps(minZ, startZ), invFwdZ);
+	__m128 maxZEntry = _mm_mul_ps(_mm_sub_ps(maxZ, startZ), invFwdZ);
+
+	__m128 enterDist = _mm_max_ps(_mm_max_ps(_mm_min_ps(minXEntry, maxXEntry), _mm_min_ps(minYEntry, maxYEntry)), _mm_min_ps(minZEntry, maxZEntry));
+	__m128 exitDist = _mm_min_ps(_mm_min_ps(_mm_max_ps(minXEntry, maxXEntry), _mm_max_ps(minYEntry, maxYEntry)), _mm_max_ps(minZEntry, maxZEntry));
+
+	__m128 isStartInside = _mm_and_ps(_mm_cmplt_ps(minX, startX), _mm_cmplt_ps(startX, maxX));
+	isStartInside = _mm_and_ps(isStartInside, _mm_and_ps(_mm_cmplt_ps(minY, startY), _mm_cmplt_ps(startY, maxY)));
+	isStartInside = _mm_and_ps(isStartInside, _mm_and_ps(_mm_cmplt_ps(minZ, startZ), _mm_cmplt_ps(startZ, maxZ)));
+
+	__m128 didImpact = _mm_and_ps(_mm_cmple_ps(enterDist, exitDist), _mm_cmpge_ps(exitDist, zero));
+	didImpact = _mm_and_ps(didImpact, _mm_cmple_ps(enterDist, maxDist));
+
+	__m128 impactDist = SelectLanes(isStartInside, zero, _mm_max_ps(enterDist, zero));
+	return SelectLanes(_mm_or_ps(isStartInside, didImpact), impactDist, _mm_set1_ps(FLT_MAX));
+}
+
+// Nearest of the side wall and the cap facing the ray. Unlike RaycastVsZCylinder, the cap is tested even when the wall is missed
+static __m128 GetZCylinderImpactDists(__m128 const& startX, __m128 const& startY, __m128 const& startZ, __m128 const& fwdX, __m128 const& fwdY, __m128 const& fwdZ, __m128 const& maxDist,
+	__m128 const& baseX, __m128 const& baseY, __m128 const& baseZ, __m128 const& radius, __m128 const& height)
+{
+	__m128 const zero = _mm_setzero_ps();
+	__m128 const noImpact = _mm_set1_ps(FLT_MAX);
+	__m128 topZ = _mm_add_ps(baseZ, height);
+	__m128 dispX = _mm_sub_ps(baseX, startX);
+	__m128 dispY = _mm_sub_ps(baseY, startY);
+	__m128 radiusSqr = _mm_mul_ps(radius, radius);
+	__m128 xyDistSqr = _mm_add_ps(_mm_mul_ps(dispX, dispX), _mm_mul_ps(dispY, dispY));
+
+	__m128 isStartInside = _mm_and_ps(_mm_cmplt_ps(xyDistSqr, radiusSqr), _mm_and_ps(_mm_cmple_ps(baseZ, startZ), _mm_cmple_ps(startZ, topZ)));
+
+	// Side wall: solve |start.xy + fwd.xy * t - base.xy| = radius for the entry t
+	__m128 xyFwdLengthSqr = _mm_add_ps(_mm_mul_ps(fwdX, fwdX), _mm_mul_ps(fwdY, fwdY));
+	__m128 xyFwdDist = _mm_add_ps(_mm_mul_ps(dispX, fwdX), _mm_mul_ps(dispY, fwdY));
+	__m128 discriminant = _mm_sub_ps(_mm_mul_ps(xyFwdDist, xyFwdDist), _mm_mul_ps(xyFwdLengthSqr, _mm_sub_ps(xyDistSqr, radiusSqr)));
+	__m128 sideDist = _mm_div_ps(_mm_sub_ps(xyFwdDist, _mm_sqrt_ps(_mm_max_ps(discriminant, zero))), xyFwdLengthSqr);
+	__m128 sideZ = _mm_add_ps(startZ, _mm_mul_ps(fwdZ, sideDist));
+
+	__m128 didImpactSide = _mm_and_ps(_mm_cmpgt_ps(xyFwdLengthSqr, zero), _mm_cmpge_ps(discriminant, zero));
+	didImpactSide = _mm_and_ps(didImpactSide, _mm_cmpge_ps(sideDist, zero));
+	didImpactSide = _mm_and_ps(didImpactSide, _mm_and_ps(_mm_cmple_ps(baseZ, sideZ), _mm_cmple_ps(sideZ, topZ)));
+
+	// Caps: a ray going down can only enter through the top, a ray going up only through the base
+	__m128 capZ = SelectLanes(_mm_cmplt_ps(fwdZ, zero), topZ, baseZ);
+	__m128 capDist = _mm_div_ps(_mm_sub_ps(capZ, startZ), fwdZ);
+	__m128 capDispX = _mm_sub_ps(_mm_add_ps(startX, _mm_mul_ps(fwdX, capDist)), baseX);
+	__m128 capDispY = _mm_sub_ps(_mm_add_ps(startY, _mm_mul_ps(fwdY, capDist)), baseY);
+	__m128 capDistSqr = _mm_add_ps(_mm_mul_ps(capDispX, capDispX), _mm_mul_ps(capDispY, capDispY));
+
+	__m128 didImpactCap = _mm_and_ps(_mm_cmpneq_ps(fwdZ, zero), _mm_cmpge_ps(capDist, zero));
+	didImpactCap = _mm_and_ps(didImpactCap, _mm_cmple_ps(capDistSqr, radiusSqr));
+
+	__m128 impactDist = _mm_min_ps(SelectLanes(didImpactSide, sideDist, noImpact), SelectLanes(didImpactCap, capDist, noImpact));
+	__m128 didImpact = _mm_and_ps(_mm_or_ps(didImpactSide, didImpactCap), _mm_cmple_ps(impactDist, maxDist));
+
+	impactDist = SelectLanes(isStartInside, zero, impactDist);
+	return SelectLanes(_mm_or_ps(isStartInside, didImpact), impactDist, noImpact);
+}
+
+// Keeps the nearest lane that beats the current hit. Before the first hit, anything within the ray's max distance counts
+static void UpdateNearestHit(RaycastHit& nearestHit, __m128 const& impactDists, int first, int count)
+{
+	__m128 bestDist = (nearestHit.DidImpact()) ? _mm_set1_ps(nearestHit.m_impactDist) : _mm_set1_ps(FLT_MAX);
+	int closerLanes = _mm_movemask_ps(_mm_cmplt_ps(impactDists, bestDist));
+	if (count - first < 4) {
+		closerLanes &= (1 << (count - first)) - 1;
+	}
+	if (closerLanes == 0) return;
+
+	float laneDists[4];
+	_mm_storeu_ps(laneDists, impactDists);
+	for (int laneIndex = 0; laneIndex < 4; laneIndex++) {
+		if (!(closerLanes & (1 << laneIndex))) continue;
+		if (nearestHit.DidImpact() && laneDists[laneIndex] >= nearestHit.m_impactDist) continue;
+		nearestHit.m_impactDist = laneDists[laneIndex];
+		nearestHit.m_index = first + laneIndex;
+	}
+}
+
+static int WriteStreamHits(RaycastHit* out_hits, __m128 const& impactDists, int first, int count)
+{
+	float laneDists[4];
+	_mm_storeu_ps(laneDists, impactDists);
+
+	int hitCount = 0;
+	int laneCount = (count - first < 4) ? count - first : 4;
+	for (int laneIndex = 0; laneIndex < laneCount; laneIndex++) {
+		RaycastHit& hit = out_hits[first + laneIndex];
+		if (laneDists[laneIndex] == FLT_MAX) {
+			hit = RaycastHit();
+			continue;
+		}
+		hit.m_impactDist = laneDists[laneIndex];
+		hit.m_index = first + laneIndex;
+		hitCount++;
+	}
+	return hitCount;
+}
+
+// While searching, the ray is clipped to the nearest hit so far
+static __m128 GetSearchDistance(RaycastHit const& nearestHit, float maxDistance)
+{
+	return _mm_set1_ps((nearestHit.DidImpact()) ? nearestHit.m_impactDist : maxDistance);
+}
+
+RaycastHit RaycastVsDiscs2D(Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance, DiscPacket2D const& discs)
+{
+	__m128 startX = _mm_set1_ps(rayStart.x);
+	__m128 startY = _mm_set1_ps(rayStart.y);
+	__m128 fwdX = _mm_set1_ps(rayForward.x);
+	__m128 fwdY = _mm_set1_ps(rayForward.y);
+
+	RaycastHit nearestHit;
+	int discCount = discs.GetCount();
+	for (int first = 0; first < discCount; first += 4) {
+		__m128 impactDists = GetDiscImpactDists(startX, startY, fwdX, fwdY, GetSearchDistance(nearestHit, maxDistance),
+			LoadLanes(discs.m_centersX, first), LoadLanes(discs.m_centersY, first), LoadLanes(discs.m_radii, first));
+
+		UpdateNearestHit(nearestHit, impactDists, first, discCount);
+		if (nearestHit.DidImpact() && nearestHit.m_impactDist <= 0.0f) break;
+	}
+
+	return nearestHit;
+}
+
+RaycastHit RaycastVsBoxes2D(Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance, AABB2Packet2D const& boxes)
+{
+	__m128 startX = _mm_set1_ps(rayStart.x);
+	__m128 startY = _mm_set1_ps(rayStart.y);
+	__m128 fwdX = _mm_set1_ps(rayForward.x);
+	__m128 fwdY = _mm_set1_ps(rayForward.y);
+
+	RaycastHit nearestHit;
+	int boxCount = boxes.GetCount();
+	for (int first = 0; first < boxCount; first += 4) {
+		__m128 impactDists = GetBox2DImpactDists(startX, startY, fwdX, fwdY, GetSearchDistance(nearestHit, maxDistance),
+			LoadLanes(boxes.m_minsX, first), LoadLanes(boxes.m_minsY, first), LoadLanes(boxes.m_maxsX, first), LoadLanes(boxes.m_maxsY, first));
+
+		UpdateNearestHit(nearestHit, impactDists, first, boxCount);
+		if (nearestHit.DidImpact() && nearestHit.m_impactDist <= 0.0f) break;
+	}
+
+	return nearestHit;
+}
+
+RaycastHit RaycastVsSpheres3D(Vec3 const& rayStart, Vec3 const& rayForward, float maxDistance, SpherePacket3D const& spheres)
+{
+	__m128 startX = _mm_set1_ps(rayStart.x);
+	__m128 startY = _mm_set1_ps(rayStart.y);
+	__m128 startZ = _mm_set1_ps(rayStart.z);
+	__m128 fwdX = _mm_set1_ps(rayForward.x);
+	__m128 fwdY = _mm_set1_ps(rayForward.y);
+	__m128 fwdZ = _mm_set1_ps(rayForward.z);
+
+	RaycastHit nearestHit;
+	int sphereCount = spheres.GetCount();
+	for (int first = 0; first < sphereCount; first += 4) {
+		__m128 impactDists = GetSphereImpactDists(startX, startY, startZ, fwdX, fwdY, fwdZ, GetSearchDistance(nearestHit, maxDistance),
+			LoadLanes(spheres.m_centersX, first), LoadLanes(spheres.m_centersY, first), LoadLanes(spheres.m_centersZ, first), LoadLanes(spheres.m_radii, first));
+
+		UpdateNearestHit(nearestHit, impactDists, first, sphereCount);
+		if (nearestHit.DidImpact() && nearestHit.m_impactDist <= 0.0f) break;
+	}
+
+	return nearestHit;
+}
+
+RaycastHit RaycastVsBoxes3D(Vec3 const& rayStart, Vec3 const& rayForward, float maxDistance, AABB3Packet3D const& boxes)
+{
+	__m128 startX = _mm_set1_ps(rayStart.x);
+	__m128 startY = _mm_set1_ps(rayStart.y);
+	__m128 startZ = _mm_set1_ps(rayStart.z);
+	__m128 fwdX = _mm_set1_ps(rayForward.x);
+	__m128 fwdY = _mm_set1_ps(rayForward.y);
+	__m128 fwdZ = _mm_set1_ps(rayForward.z);
+
+	RaycastHit nearestHit;
+	int boxCount = boxes.GetCount();
+	for (int first = 0; first < boxCount; first += 4) {
+		__m128 impactDists = GetBox3DImpactDists(startX, startY, startZ, fwdX, fwdY, fwdZ, GetSearchDistance(nearestHit, maxDistance),
+			LoadLanes(boxes.m_minsX, first), LoadLanes(boxes.m_minsY, first), LoadLanes(boxes.m_minsZ, first),
+			LoadLanes(boxes.m_maxsX, first), LoadLanes(boxes.m_maxsY, first), LoadLanes(boxes.m_maxsZ, first));
+
+		UpdateNearestHit(nearestHit, impactDists, first, boxCount);
+		if (nearestHit.DidImpact() && nearestHit.m_impactDist <= 0.0f) break;
+	}
+
+	return nearestHit;
+}
+
+RaycastHit RaycastVsZCylinders3D(Vec3 const& rayStart, Vec3 const& rayForward, float maxDistance, ZCylinderPacket3D const& cylinders)
+{
+	__m128 startX = _mm_set1_ps(rayStart.x);
+	__m128 startY = _mm_set1_ps(rayStart.y);
+	__m128 startZ = _mm_set1_ps(rayStart.z);
+	__m128 fwdX = _mm_set1_ps(rayForward.x);
+	__m128 fwdY = _mm_set1_ps(rayForward.y);
+	__m128 fwdZ = _mm_set1_ps(rayForward.z);
+
+	RaycastHit nearestHit;
+	int cylinderCount = cylinders.GetCount();
+	for (int first = 0; first < cylinderCount; first += 4) {
+		__m128 impactDists = GetZCylinderImpactDists(startX, startY, startZ, fwdX, fwdY, fwdZ, GetSearchDistance(nearestHit, maxDistance),
+			LoadLanes(cylinders.m_basesX, first), LoadLanes(cylinders.m_basesY, first), LoadLanes(cylinders.m_basesZ, first),
+			LoadLanes(cylinders.m_radii, first), LoadLanes(cylinders.m_heights, first));
+
+		UpdateNearestHit(nearestHit, impactDists, first, cylinderCount);
+		if (nearestHit.DidImpact() && nearestHit.m_impactDist <= 0.0f) break;
+	}
+
+	return nearestHit;
+}
+
+int RaycastVsDisc(RayPacket2D const& rays, Vec2 const& discCenter, float discRadius, RaycastHit* out_hits)
+{
+	__m128 centerX = _mm_set1_ps(discCenter.x);
+	__m128 centerY = _mm_set1_ps(discCenter.y);
+	__m128 radius = _mm_set1_ps(discRadius);
+
+	int hitCount = 0;
+	int rayCount = rays.GetCount();
+	for (int first = 0; first < rayCount; first += 4) {
+		__m128 impactDists = GetDiscImpactDists(LoadLanes(rays.m_startsX, first), LoadLanes(rays.m_startsY, first),
+			LoadLanes(rays.m_forwardsX, first), LoadLanes(rays.m_forwardsY, first), LoadLanes(rays.m_maxDistances, first), centerX, centerY, radius);
+
+		hitCount += WriteStreamHits(out_hits, impactDists, first, rayCount);
+	}
+
+	return hitCount;
+}
+
+int RaycastVsBox(RayPacket2D const& rays, AABB2 const& box, RaycastHit* out_hits)
+{
+	__m128 minX = _mm_set1_ps(box.m_mins.x);
+	__m128 minY = _mm_set1_ps(box.m_mins.y);
+	__m128 maxX = _mm_set1_ps(box.m_maxs.x);
+	__m128 maxY = _mm_set1_ps(box.m_maxs.y);
+
+	int hitCount = 0;
+	int rayCount = rays.GetCount();
+	for (int first = 0; first < rayCount; first += 4) {
+		__m128 impactDists = GetBox2DImpactDists(LoadLanes(rays.m_startsX, first), LoadLanes(rays.m_startsY, first),
+			LoadLanes(rays.m_forwardsX, first), LoadLanes(rays.m_forwardsY, first), LoadLanes(rays.m_maxDistances, first), minX, minY, maxX, maxY);
+
+		hitCount += WriteStreamHits(out_hits, impactDists, first, rayCount);
+	}
+
+	return hitCount;
+}
+
+int RaycastVsSphere(RayPacket3D const& rays, Vec3 const& sphereCenter, float sphereRadius, RaycastHit* out_hits)
+{
+	__m128 centerX = _mm_set1_ps(sphereCenter.x);
+	__m128 centerY = _mm_set1_ps(sphereCenter.y);
+	__m128 centerZ = _mm_set1_ps(sphereCenter.z);
+	__m128 radius = _mm_set1_ps(sphereRadius);
+
+	int hitCount = 0;
+	int rayCount = rays.GetCount();
+	for (int first = 0; first < rayCount; first += 4) {
+		__m128 impactDists = GetSphereImpactDists(LoadLanes(rays.m_startsX, first), LoadLanes(rays.m_startsY, first), LoadLanes(rays.m_startsZ, first),
+			LoadLanes(rays.m_forwardsX, first), LoadLanes(rays.m_forwardsY, first), LoadLanes(rays.m_forwardsZ, first), LoadLanes(rays.m_maxDistances, first),
+			centerX, centerY, centerZ, radius);
+
+		hitCount += WriteStreamHits(out_hits, impactDists, first, rayCount);
+	}
+
+	return hitCount;
+}
+
+int RaycastVsBox3D(RayPacket3D const& rays, AABB3 const& box, RaycastHit* out_hits)
+{
+	__m128 minX = _mm_set1_ps(box.m_mins.x);
+	__m128 minY = _mm_set1_ps(box.m_mins.y);
+	__m128 minZ = _mm_set1_ps(box.m_mins.z);
+	__m128 maxX = _mm_set1_ps(box.m_maxs.x);
+	__m128 maxY = _mm_set1_ps(box.m_maxs.y);
+	__m128 maxZ = _mm_set1_ps(box.m_maxs.z);
+
+	int hitCount = 0;
+	int rayCount = rays.GetCount();
+	for (int first = 0; first < rayCount; first += 4) {
+		__m128 impactDists = GetBox3DImpactDists(LoadLanes(rays.m_startsX, first), LoadLanes(rays.m_startsY, first), LoadLanes(rays.m_startsZ, first),
+			LoadLanes(rays.m_forwardsX, first), LoadLanes(rays.m_forwardsY, first), LoadLanes(rays.m_forwardsZ, first), LoadLanes(rays.m_maxDistances, first),
+			minX, minY, minZ, maxX, maxY, maxZ);
+
+		hitCount += WriteStreamHits(out_hits, impactDists, first, rayCount);
+	}
+
+	return hitCount;
+}
+
+int RaycastVsZCylinder(RayPacket3D const& rays, Vec3 const& cylinderBase, float cylinderRadius, float cylinderHeight, RaycastHit* out_hits)
+{
+	__m128 baseX = _mm_set1_ps(cylinderBase.x);
+	__m128 baseY = _mm_set1_ps(cylinderBase.y);
+	__m128 baseZ = _mm_set1_ps(cylinderBase.z);
+	__m128 radius = _mm_set1_ps(cylinderRadius);
+	__m128 height = _mm_set1_ps(cylinderHeight);
+
+	int hitCount = 0;
+	int rayCount = rays.GetCount();
+	for (int first = 0; first < rayCount; first += 4) {
+		__m128 impactDists = GetZCylinderImpactDists(LoadLanes(rays.m_startsX, first), LoadLanes(rays.m_startsY, first), LoadLanes(rays.m_startsZ, first),
+			LoadLanes(rays.m_forwardsX, first), LoadLanes(rays.m_forwardsY, first), LoadLanes(rays.m_forwardsZ, first), LoadLanes(rays.m_maxDistances, first),
+			baseX, baseY, baseZ, radius, height);
+
+		hitCount += WriteStreamHits(out_hits, impactDists, first, rayCount);
+	}
+
+	return hitCount;
+}
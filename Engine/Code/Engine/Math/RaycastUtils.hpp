@@ -1,6 +1,7 @@
 #pragma once
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Math/Vec3.hpp"
+#include <vector>
 
 struct AABB2;
 struct AABB3;
@@ -38,6 +39,106 @@ struct RaycastResult3D {
 	bool m_maxDistanceReached = false;
 };
 
+// Compact result for the batched queries. m_index is the shape (packet queries) or ray (stream queries) that was hit, -1 on miss
+struct RaycastHit {
+	float m_impactDist = 0.0f;
+	int m_index = -1;
+
+	bool DidImpact() const { return m_index >= 0; }
+};
+
+// Shapes stored as SoA so the batched queries can test four at a time. Indexes match the order shapes were added
+struct DiscPacket2D {
+	std::vector<float> m_centersX;
+	std::vector<float> m_centersY;
+	std::vector<float> m_radii;
+
+	void AddDisc(Vec2 const& center, float radius);
+	void Reserve(int count);
+	void Clear();
+	int GetCount() const { return (int)m_radii.size(); }
+};
+
+struct AABB2Packet2D {
+	std::vector<float> m_minsX;
+	std::vector<float> m_minsY;
+	std::vector<float> m_maxsX;
+	std::vector<float> m_maxsY;
+
+	void AddBox(AABB2 const& box);
+	void Reserve(int count);
+	void Clear();
+	int GetCount() const { return (int)m_minsX.size(); }
+};
+
+struct SpherePacket3D {
+	std::vector<float> m_centersX;
+	std::vector<float> m_centersY;
+	std::vector<float> m_centersZ;
+	std::vector<float> m_radii;
+
+	void AddSphere(Vec3 const& center, float radius);
+	void Reserve(int count);
+	void Clear();
+	int GetCount() const { return (int)m_radii.size(); }
+};
+
+struct AABB3Packet3D {
+	std::vector<float> m_minsX;
+	std::vector<float> m_minsY;
+	std::vector<float> m_minsZ;
+	std::vector<float> m_maxsX;
+	std::vector<float> m_maxsY;
+	std::vector<float> m_maxsZ;
+
+	void AddBox(AABB3 const& box);
+	void Reserve(int count);
+	void Clear();
+	int GetCount() const { return (int)m_minsX.size(); }
+};
+
+struct ZCylinderPacket3D {
+	std::vector<float> m_basesX;
+	std::vector<float> m_basesY;
+	std::vector<float> m_basesZ;
+	std::vector<float> m_radii;
+	std::vector<float> m_heights;
+
+	void AddCylinder(Vec3 const& base, float radius, float height);
+	void Reserve(int count);
+	void Clear();
+	int GetCount() const { return (int)m_radii.size(); }
+};
+
+// Ray forwards are expected to be normalized, same as the single ray functions
+struct RayPacket2D {
+	std::vector<float> m_startsX;
+	std::vector<float> m_startsY;
+	std::vector<float> m_forwardsX;
+	std::vector<float> m_forwardsY;
+	std::vector<float> m_maxDistances;
+
+	void AddRay(Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance);
+	void Reserve(int count);
+	void Clear();
+	int GetCount() const { return (int)m_maxDistances.size(); }
+};
+
+struct RayPacket3D {
+	std::vector<float> m_startsX;
+	std::vector<float> m_startsY;
+	std::vector<float> m_startsZ;
+	std::vector<float> m_forwardsX;
+	std::vector<float> m_forwardsY;
+	std::vector<float> m_forwardsZ;
+	std::vector<float> m_maxDistances;
+
+	void AddRay(Vec3 const& rayStart, Vec3 const& rayForward, float maxDistance);
+	void Reserve(int count);
+	void Clear();
+	int GetCount() const { return (int)m_maxDistances.size(); }
+};
+
 RaycastResult2D RaycastVsDisc(Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance, Vec2 const& discCenter, float discRadius);
 RaycastResult2D RaycastVsBox(Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance, AABB2 const& box);
 RaycastResult2D RaycastVsOBB2D(Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance, OBB2 const& box);
@@ -57,3 +158,18 @@ RaycastResult3D RaycastVsRaycast3D(Vec3 const& rayStartA, Vec3 const& rayForward
 
 // Planes are infinite, therefore, any extra discard logic must be done outside of this function, maybe #TODO add raycast vs specific plane sections
 RaycastResult3D RaycastVsPlane(Vec3 const& rayStart, Vec3 const& rayForward, float maxDistance, Vec3 const& pointOnplane, Vec3 const& planeNormal, float tolerance = 0.025f);
+
+// Packet queries: one ray against every shape in the packet, returns the nearest impact. Ties go to the lowest index
+// The ray shrinks to the nearest impact found so far, and the search stops as soon as the ray starts inside a shape
+RaycastHit RaycastVsDiscs2D(Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance, DiscPacket2D const& discs);
+RaycastHit RaycastVsBoxes2D(Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance, AABB2Packet2D const& boxes);
+RaycastHit RaycastVsSpheres3D(Vec3 const& rayStart, Vec3 const& rayForward, float maxDistance, SpherePacket3D const& spheres);
+RaycastHit RaycastVsBoxes3D(Vec3 const& rayStart, Vec3 const& rayForward, float maxDistance, AABB3Packet3D const& boxes);
+RaycastHit RaycastVsZCylinders3D(Vec3 const& rayStart, Vec3 const& rayForward, float maxDistance, ZCylinderPacket3D const& cylinders);
+
+// Stream queries: every ray in the packet against one shape. out_hits needs rays.GetCount() entries; returns how many rays hit
+int RaycastVsDisc(RayPacket2D const& rays, Vec2 const& discCenter, float discRadius, RaycastHit* out_hits);
+int RaycastVsBox(RayPacket2D const& rays, AABB2 const& box, RaycastHit* out_hits);
+int RaycastVsSphere(RayPacket3D const& rays, Vec3 const& sphereCenter, float sphereRadius, RaycastHit* out_hits);
+int RaycastVsBox3D(RayPacket3D const& rays, AABB3 const& box, RaycastHit* out_hits);
+int RaycastVsZCylinder(RayPacket3D const& rays, Vec3 const& cylinderBase, float cylinderRadius, float cylinderHeight, RaycastHit* out_hits);
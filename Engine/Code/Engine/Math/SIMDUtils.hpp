@@ -0,0 +1,50 @@
+#pragma once
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+// ---------------------------------------------------------------------------------------------------------------------
+// SSE helpers shared by the batch math kernels. SSE2 is the x64 baseline, so nothing here needs a runtime check.
+// Games can #define ENGINE_DISABLE_SIMD in EngineBuildPreferences.hpp to fall back to the scalar Mat44 paths
+#define SIMD_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+#define SIMD_SWIZZLE(vec, x, y, z, w) _mm_shuffle_ps((vec), (vec), SIMD_SHUFFLE_MASK(x, y, z, w))
+#define SIMD_SPLAT(vec, lane) _mm_shuffle_ps((vec), (vec), SIMD_SHUFFLE_MASK(lane, lane, lane, lane))
+#define SIMD_SHUFFLE(vecA, vecB, x, y, z, w) _mm_shuffle_ps((vecA), (vecB), SIMD_SHUFFLE_MASK(x, y, z, w))
+
+// Loads 3 floats into xyz and zero into w, never reading past the third float
+inline __m128 SIMDLoadFloat3(float const* xyz)
+{
+	__m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const*>(xyz)));
+	__m128 z = _mm_load_ss(xyz + 2);
+	return _mm_movelh_ps(xy, z);
+}
+
+// Stores xyz, leaving whatever follows the third float untouched
+inline void SIMDStoreFloat3(float* xyz, __m128 const& value)
+{
+	_mm_store_sd(reinterpret_cast<double*>(xyz), _mm_castps_pd(value));
+	_mm_store_ss(xyz + 2, _mm_movehl_ps(value, value));
+}
+
+// Horizontal sum, broadcast to all lanes
+inline __m128 SIMDHorizontalAdd(__m128 const& value)
+{
+	__m128 sum = _mm_add_ps(value, SIMD_SWIZZLE(value, 1, 0, 3, 2));
+	return _mm_add_ps(sum, SIMD_SWIZZLE(sum, 2, 3, 0, 1));
+}
+
+// Transforms one xyz1 point by a column-major matrix held in 4 registers
+inline __m128 SIMDTransformPosition(__m128 const& position, __m128 const& iBasis, __m128 const& jBasis, __m128 const& kBasis, __m128 const& translation)
+{
+	__m128 result = _mm_mul_ps(SIMD_SPLAT(position, 0), iBasis);
+	result = _mm_add_ps(result, _mm_mul_ps(SIMD_SPLAT(position, 1), jBasis));
+	result = _mm_add_ps(result, _mm_mul_ps(SIMD_SPLAT(position, 2), kBasis));
+	return _mm_add_ps(result, translation);
+}
+
+// Transforms one xyz0 vector by a column-major matrix held in 3 registers
+inline __m128 SIMDTransformVector(__m128 const& vector, __m128 const& iBasis, __m128 const& jBasis, __m128 const& kBasis)
+{
+	__m128 result = _mm_mul_ps(SIMD_SPLAT(vector, 0), iBasis);
+	result = _mm_add_ps(result, _mm_mul_ps(SIMD_SPLAT(vector, 1), jBasis));
+	return _mm_add_ps(result, _mm_mul_ps(SIMD_SPLAT(vector, 2), kBasis));
+}
@@ -3,6 +3,8 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Network/NetworkCommon.hpp"
+#include "Engine/Network/NetworkStressTest.hpp"
+#include "Engine/Network/RemoteConsole.hpp"
 
 NetworkSystem* g_theNetwork = nullptr;
 
@@ -17,11 +19,16 @@ NetworkSystem::~NetworkSystem()
 
 void NetworkSystem::Startup()
 {	
+#if defined(_WIN32)
 	WORD version = MAKEWORD(2,2);
 	WSADATA data;
 
 	int errorCode = ::WSAStartup(version, &data);
 	GUARANTEE_OR_DIE(errorCode == 0, "COULD NOT INITIALIZE THE NETWORK SYSTEM");
+#endif
+
+	SubscribeEventCallbackFunction("NetStressTest", NetworkSystem::Command_NetStressTest);
+	RemoteConsole::MarkCommandThreadSafe("NetStressTest"); // Owns its sockets and only reports through AddLine
 }
 
 void NetworkSystem::BeginFrame()
@@ -34,6 +41,34 @@ void NetworkSystem::EndFrame()
 
 void NetworkSystem::Shutdown()
 {
+	UnsubscribeEventCallbackFunction("NetStressTest", NetworkSystem::Command_NetStressTest);
+
+#if defined(_WIN32)
 	::WSACleanup();	
+#endif
 }
 
+bool NetworkSystem::Command_NetStressTest(EventArgs& args)
+{
+	NetStressTestConfig config;
+	config.m_numClients = args.GetValue("clients", config.m_numClients);
+	config.m_messagesPerClient = args.GetValue("messages", config.m_messagesPerClient);
+	config.m_messagesInFlight = args.GetValue("inFlight", config.m_messagesInFlight);
+	config.m_messageSize = args.GetValue("size", config.m_messageSize);
+	config.m_port = (uint16_t)args.GetValue("port", (int)config.m_port);
+
+	if (config.m_numClients < 1 || config.m_messagesPerClient < 1 || config.m_messagesInFlight < 1) {
+		g_theConsole->AddLine(DevConsole::ERROR_COLOR, "NetStressTest: clients, messages and inFlight have to be at least 1");
+		return false;
+	}
+
+	NetStressTestResults results = RunNetworkStressTest(config);
+	if (!results.m_succeeded) {
+		g_theConsole->AddLine(DevConsole::ERROR_COLOR, Stringf("NetStressTest failed: %s", results.m_error.c_str()));
+		return false;
+	}
+
+	g_theConsole->AddLine(DevConsole::INFO_MAJOR_COLOR, Stringf("NetStressTest: %d clients, %d round trips in %.3f s", results.m_numClients, results.m_numRoundTrips, results.m_seconds));
+	g_theConsole->AddLine(DevConsole::INFO_MINOR_COLOR, Stringf("  %.0f msgs/s, latency avg %.3f ms, p99 %.3f ms, max %.3f ms", results.m_messagesPerSecond, results.m_averageLatencyMs, results.m_p99LatencyMs, results.m_maxLatencyMs));
+	return true;
+}
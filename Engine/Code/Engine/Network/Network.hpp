@@ -1,4 +1,5 @@
 #pragma once
+#include "Engine/Core/EventSystem.hpp"
 
 struct NetworkSystemConfig {
 
@@ -15,6 +16,8 @@ public:
 	void EndFrame();
 	void Shutdown();
 
+	static bool Command_NetStressTest(EventArgs& args);
+
 
 private:
 	NetworkSystemConfig m_config;
@@ -1,7 +1,9 @@
 #include "Engine/Network/NetworkAddress.hpp"
 #include "Engine/Network/NetworkCommon.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#if defined(_WIN32)
 #include <WS2tcpip.h>
+#endif
 
 std::string NetworkAddress::ToString() const
 {
@@ -22,11 +24,14 @@ bool NetworkAddress::operator==(NetworkAddress const& otherAddress) const
 NetworkAddress NetworkAddress::FromString(std::string const& str)
 {
 	Strings parts = SplitStringOnDelimiter(str, ':');
+	if (parts.size() < 2) {
+		return NetworkAddress();
+	}
 
-	IN_ADDR addr;
+	in_addr addr;
 	int result = ::inet_pton(AF_INET, parts[0].c_str(), &addr);
 	
-	if (result == SOCKET_ERROR) {
+	if (result != 1) {
 		return NetworkAddress();
 	}
 
@@ -34,7 +39,7 @@ NetworkAddress NetworkAddress::FromString(std::string const& str)
 	
 	NetworkAddress address;
 
-	address.m_address = ::ntohl(addr.S_un.S_addr);
+	address.m_address = ::ntohl(addr.s_addr);
 	address.m_port = port;
 
 	return address;
@@ -74,7 +79,7 @@ std::vector<NetworkAddress> NetworkAddress::GetAllInternal(uint16_t port)
 	while (iter != nullptr) {
 		NetworkAddress newInternal;
 		sockaddr_in* ipv4 = (sockaddr_in*) iter->ai_addr;
-		newInternal.m_address = ::ntohl(ipv4->sin_addr.S_un.S_addr);
+		newInternal.m_address = ::ntohl(ipv4->sin_addr.s_addr);
 		newInternal.m_port = port;
 
 		internalAddresses.push_back(newInternal);
@@ -83,5 +88,6 @@ std::vector<NetworkAddress> NetworkAddress::GetAllInternal(uint16_t port)
 
 	}
 
+	::freeaddrinfo(addresses);
 	return internalAddresses;
 }
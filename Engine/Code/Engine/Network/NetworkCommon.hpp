@@ -1,4 +1,7 @@
 #pragma once
+#include <cstdint>
+
+#if defined(_WIN32)
 
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -8,5 +11,76 @@
 #include <winsock2.h>
 #pragma comment(lib, "ws2_32.lib")
 
+typedef int SocketAddressLength;
+constexpr int SOCKET_SEND_FLAGS = 0;
+
+inline int GetLastSocketError() { return ::WSAGetLastError(); }
+inline bool IsSocketErrorNonFatal(int errorCode) { return (errorCode == 0) || (errorCode == WSAEWOULDBLOCK) || (errorCode == WSAEINPROGRESS); }
+inline void CloseSocketHandle(uintptr_t handle) { ::closesocket((SOCKET)handle); }
+inline void SetSocketHandleBlocking(uintptr_t handle, bool isBlocking)
+{
+	u_long nonBlocking = isBlocking ? 0 : 1;
+	::ioctlsocket((SOCKET)handle, FIONBIO, &nonBlocking);
+}
+inline int PollSocketHandles(WSAPOLLFD* pollFds, unsigned long numFds, int timeoutMs) { return ::WSAPoll(pollFds, numFds, timeoutMs); }
+
+// Scatter/gather I/O: one call reads into or writes from several separate buffers
+typedef WSABUF SocketBuffer;
+inline void SetSocketBuffer(SocketBuffer& buffer, void const* data, size_t size) { buffer.buf = (CHAR*)data; buffer.len = (ULONG)size; }
+inline int SendSocketBuffers(uintptr_t handle, SocketBuffer* buffers, int numBuffers)
+{
+	DWORD bytesSent = 0;
+	if (::WSASend((SOCKET)handle, buffers, (DWORD)numBuffers, &bytesSent, 0, nullptr, nullptr) == SOCKET_ERROR) return SOCKET_ERROR;
+	return (int)bytesSent;
+}
+inline int ReceiveSocketBuffers(uintptr_t handle, SocketBuffer* buffers, int numBuffers)
+{
+	DWORD bytesReceived = 0;
+	DWORD flags = 0;
+	if (::WSARecv((SOCKET)handle, buffers, (DWORD)numBuffers, &bytesReceived, &flags, nullptr, nullptr) == SOCKET_ERROR) return SOCKET_ERROR;
+	return (int)bytesReceived;
+}
+
+#else
 
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
 
+// Winsock names kept on POSIX, so the socket code only branches where the APIs really differ
+typedef pollfd WSAPOLLFD;
+typedef socklen_t SocketAddressLength;
+constexpr int SOCKET_SEND_FLAGS = MSG_NOSIGNAL; // A peer that hung up should close the connection, not raise SIGPIPE
+#define INVALID_SOCKET (~(uintptr_t)0)
+#define SOCKET_ERROR (-1)
+
+inline int GetLastSocketError() { return errno; }
+inline bool IsSocketErrorNonFatal(int errorCode) { return (errorCode == 0) || (errorCode == EWOULDBLOCK) || (errorCode == EAGAIN) || (errorCode == EINPROGRESS) || (errorCode == EINTR); }
+inline void CloseSocketHandle(uintptr_t handle) { ::close((int)handle); }
+inline void SetSocketHandleBlocking(uintptr_t handle, bool isBlocking)
+{
+	int flags = ::fcntl((int)handle, F_GETFL, 0);
+	flags = isBlocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK);
+	::fcntl((int)handle, F_SETFL, flags);
+}
+inline int PollSocketHandles(WSAPOLLFD* pollFds, unsigned long numFds, int timeoutMs) { return ::poll(pollFds, (nfds_t)numFds, timeoutMs); }
+
+typedef iovec SocketBuffer;
+inline void SetSocketBuffer(SocketBuffer& buffer, void const* data, size_t size) { buffer.iov_base = (void*)data; buffer.iov_len = size; }
+inline int SendSocketBuffers(uintptr_t handle, SocketBuffer* buffers, int numBuffers)
+{
+	msghdr message = {};
+	message.msg_iov = buffers;
+	message.msg_iovlen = (size_t)numBuffers;
+	return (int)::sendmsg((int)handle, &message, SOCKET_SEND_FLAGS);
+}
+inline int ReceiveSocketBuffers(uintptr_t handle, SocketBuffer* buffers, int numBuffers) { return (int)::readv((int)handle, buffers, numBuffers); }
+
+#endif
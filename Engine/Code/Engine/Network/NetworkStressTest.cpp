@@ -0,0 +1,207 @@
+#include "Engine/Network/NetworkStressTest.hpp"
+#include "Engine/Network/NetworkAddress.hpp"
+#include "Engine/Network/SocketPoller.hpp"
+#include "Engine/Network/TCPConnection.hpp"
+#include "Engine/Network/TCPServer.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <unordered_map>
+
+struct NetStressTestClient {
+	TCPConnection* m_connection = nullptr;
+	int m_numSent = 0;
+	int m_numReceived = 0;
+	std::vector<double> m_sendTimes;
+};
+
+static void AcceptStressTestConnections(TCPServer& server, SocketPoller& serverPoller, std::vector<TCPConnection*>& serverConnections)
+{
+	for (TCPConnection* connection = server.Accept(); connection != nullptr; connection = server.Accept()) {
+		connection->SetBlocking(false);
+		serverConnections.push_back(connection);
+		serverPoller.AddSocket(connection, SOCKET_EVENT_READ);
+	}
+}
+
+static void SendStressTestMessage(NetStressTestClient& client, std::string& messageScratch, int messageSize)
+{
+	// Sequence number, padded out to the message size
+	char sequenceText[16];
+	int sequenceLength = snprintf(sequenceText, sizeof(sequenceText), "%d", client.m_numSent);
+	messageScratch.assign(sequenceText, sequenceLength);
+	if ((int)messageScratch.size() < messageSize) {
+		messageScratch.resize(messageSize, ' ');
+	}
+
+	client.m_sendTimes[client.m_numSent] = GetCurrentTimeSeconds();
+	client.m_numSent++;
+	client.m_connection->SendFrame(false, messageScratch);
+}
+
+static int ParseStressTestSequence(std::string_view text)
+{
+	int sequence = 0;
+	int digitIndex = 0;
+	for (; digitIndex < (int)text.size() && text[digitIndex] >= '0' && text[digitIndex] <= '9'; digitIndex++) {
+		sequence = sequence * 10 + (text[digitIndex] - '0');
+	}
+	return (digitIndex > 0) ? sequence : -1;
+}
+
+NetStressTestResults RunNetworkStressTest(NetStressTestConfig const& config)
+{
+	NetStressTestResults results;
+	results.m_numClients = config.m_numClients;
+
+	TCPServer server;
+	if (!server.Host(config.m_port, (uint32_t)config.m_numClients)) {
+		results.m_error = Stringf("Could not host on port %u", config.m_port);
+		return results;
+	}
+	server.SetBlocking(false);
+
+	SocketPoller serverPoller;
+	SocketPoller clientPoller;
+	serverPoller.Startup();
+	clientPoller.Startup();
+
+	std::vector<TCPConnection*> serverConnections;
+	std::vector<NetStressTestClient> clients(config.m_numClients);
+	std::unordered_map<Socket*, int> clientIndexes;
+	NetworkAddress serverAddress = NetworkAddress::GetLoopBack(config.m_port);
+
+	for (int clientIndex = 0; clientIndex < config.m_numClients; clientIndex++) {
+		NetStressTestClient& client = clients[clientIndex];
+		client.m_connection = new TCPConnection();
+		client.m_sendTimes.resize(config.m_messagesPerClient);
+
+		if (!client.m_connection->Connect(serverAddress)) {
+			results.m_error = Stringf("Client %d could not connect", clientIndex);
+			break;
+		}
+		client.m_connection->SetBlocking(false);
+		client.m_connection->CheckForConnection();
+		clientPoller.AddSocket(client.m_connection, SOCKET_EVENT_READ);
+		clientIndexes[client.m_connection] = clientIndex;
+
+		// Keep the listen backlog from filling up while the rest connect
+		AcceptStressTestConnections(server, serverPoller, serverConnections);
+	}
+
+	std::vector<SocketPollResult> pollResults;
+	std::vector<TCPMessageView> messages;
+	std::string messageScratch;
+	std::vector<double> latencies;
+	latencies.reserve((size_t)config.m_numClients * config.m_messagesPerClient);
+
+	double startTime = GetCurrentTimeSeconds();
+	int numClientsDone = 0;
+
+	if (results.m_error.empty()) {
+		for (int clientIndex = 0; clientIndex < config.m_numClients; clientIndex++) {
+			NetStressTestClient& client = clients[clientIndex];
+			while (client.m_numSent < config.m_messagesPerClient && client.m_numSent < config.m_messagesInFlight) {
+				SendStressTestMessage(client, messageScratch, config.m_messageSize);
+			}
+		}
+	}
+
+	while (results.m_error.empty() && numClientsDone < config.m_numClients) {
+		if (GetCurrentTimeSeconds() - startTime > config.m_timeoutSeconds) {
+			results.m_error = Stringf("Timed out with %d of %d clients done", numClientsDone, config.m_numClients);
+			break;
+		}
+
+		AcceptStressTestConnections(server, serverPoller, serverConnections);
+
+		// Server side: echo every frame straight back
+		pollResults.clear();
+		serverPoller.Poll(pollResults, 0);
+		for (int resultIndex = 0; resultIndex < (int)pollResults.size(); resultIndex++) {
+			TCPConnection* connection = (TCPConnection*)pollResults[resultIndex].m_socket;
+			if (!connection->CheckForConnection()) continue;
+
+			messages.clear();
+			connection->ReceiveFrames(messages);
+			for (int messageIndex = 0; messageIndex < (int)messages.size(); messageIndex++) {
+				connection->SendFrame(true, messages[messageIndex].m_text);
+			}
+		}
+
+		for (int connectionIndex = 0; connectionIndex < (int)serverConnections.size(); connectionIndex++) {
+			serverConnections[connectionIndex]->FlushSends();
+		}
+
+		// Client side: time each reply, then send the next request
+		pollResults.clear();
+		clientPoller.Poll(pollResults, 1);
+		double receiveTime = GetCurrentTimeSeconds();
+		for (int resultIndex = 0; resultIndex < (int)pollResults.size(); resultIndex++) {
+			TCPConnection* connection = (TCPConnection*)pollResults[resultIndex].m_socket;
+			if (!connection->CheckForConnection()) continue;
+
+			NetStressTestClient* client = &clients[clientIndexes[connection]];
+
+			messages.clear();
+			connection->ReceiveFrames(messages);
+			for (int messageIndex = 0; messageIndex < (int)messages.size(); messageIndex++) {
+				int sequence = ParseStressTestSequence(messages[messageIndex].m_text);
+				if (sequence < 0 || sequence >= client->m_numSent) continue;
+
+				latencies.push_back(receiveTime - client->m_sendTimes[sequence]);
+				client->m_numReceived++;
+				if (client->m_numSent < config.m_messagesPerClient) {
+					SendStressTestMessage(*client, messageScratch, config.m_messageSize);
+				}
+				else if (client->m_numReceived == config.m_messagesPerClient) {
+					numClientsDone++;
+				}
+			}
+
+			if (connection->IsClosed()) {
+				results.m_error = "A client lost its connection";
+				break;
+			}
+		}
+
+		for (int clientIndex = 0; clientIndex < config.m_numClients; clientIndex++) {
+			clients[clientIndex].m_connection->FlushSends();
+		}
+	}
+
+	results.m_seconds = GetCurrentTimeSeconds() - startTime;
+	results.m_numRoundTrips = (int)latencies.size();
+	results.m_succeeded = results.m_error.empty();
+
+	if (!latencies.empty()) {
+		std::sort(latencies.begin(), latencies.end());
+		double totalLatency = 0.0;
+		for (int latencyIndex = 0; latencyIndex < (int)latencies.size(); latencyIndex++) {
+			totalLatency += latencies[latencyIndex];
+		}
+		results.m_averageLatencyMs = 1000.0 * totalLatency / (double)latencies.size();
+		results.m_p99LatencyMs = 1000.0 * latencies[(latencies.size() * 99) / 100];
+		results.m_maxLatencyMs = 1000.0 * latencies.back();
+	}
+	if (results.m_seconds > 0.0) {
+		results.m_messagesPerSecond = (2.0 * (double)results.m_numRoundTrips) / results.m_seconds;
+	}
+
+	for (int clientIndex = 0; clientIndex < config.m_numClients; clientIndex++) {
+		clientPoller.RemoveSocket(clients[clientIndex].m_connection);
+		clients[clientIndex].m_connection->Close();
+		delete clients[clientIndex].m_connection;
+	}
+	for (int connectionIndex = 0; connectionIndex < (int)serverConnections.size(); connectionIndex++) {
+		serverPoller.RemoveSocket(serverConnections[connectionIndex]);
+		serverConnections[connectionIndex]->Close();
+		delete serverConnections[connectionIndex];
+	}
+	clientPoller.Shutdown();
+	serverPoller.Shutdown();
+	server.Close();
+
+	return results;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+struct NetStressTestConfig {
+	int m_numClients = 256;
+	int m_messagesPerClient = 200;
+	int m_messagesInFlight = 4; // Per client. Clients keep this many requests out before waiting for replies
+	int m_messageSize = 32;
+	uint16_t m_port = 3200;
+	double m_timeoutSeconds = 30.0;
+};
+
+struct NetStressTestResults {
+	bool m_succeeded = false;
+	std::string m_error;
+	int m_numClients = 0;
+	int m_numRoundTrips = 0;
+	double m_seconds = 0.0;
+	double m_messagesPerSecond = 0.0; // Both directions count
+	double m_averageLatencyMs = 0.0;
+	double m_p99LatencyMs = 0.0;
+	double m_maxLatencyMs = 0.0;
+};
+
+// Loopback round trip test: hosts a server and connects m_numClients clients to it on this thread, all driven by
+// SocketPollers. Every client sends numbered frames, the server echoes each one back, and latency is measured from
+// the send to the matching reply
+NetStressTestResults RunNetworkStressTest(NetStressTestConfig const& config);
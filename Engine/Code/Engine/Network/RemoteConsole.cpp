@@ -4,11 +4,13 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Network/TCPServer.hpp"
 #include "Engine/Network/NetworkCommon.hpp"
+#include <algorithm>
 
 RemoteConsole* currentRemoteConsole = nullptr;
 
 
 std::vector<std::string> RemoteConsole::s_invalidRCCmds = { "rckick", "rcleave", "rca", "rchost", "rcjoin" };
+std::vector<std::string> RemoteConsole::s_threadSafeRCCmds;
 
 RemoteConsole::RemoteConsole(RemoteConsoleConfig const& config) :
 	m_config(config),
@@ -21,6 +23,12 @@ RemoteConsole::RemoteConsole(RemoteConsoleConfig const& config) :
 void RemoteConsole::Startup()
 {
 	m_state = RemoteConsoleState::DISCONNECTED;
+	m_poller.Startup();
+
+	if (m_config.m_useCommandThread) {
+		m_isQuitting = false;
+		m_commandThread = new std::thread(&RemoteConsole::CommandThreadMain, this);
+	}
 
 	SubscribeEventCallbackFunction("RCJoin", RCJoin);
 	SubscribeEventCallbackFunction("RCHost", RCHost);
@@ -55,6 +63,21 @@ void RemoteConsole::Shutdown()
 	UnsubscribeEventCallbackFunction("RCLeave", RCLeave);
 	UnsubscribeEventCallbackFunction("RCBan", RCBan);
 
+	if (m_commandThread) {
+		{
+			std::lock_guard<std::mutex> threadCommandsLock(m_threadCommandsMutex);
+			m_isQuitting = true;
+		}
+		m_threadCommandsCondition.notify_all();
+		m_commandThread->join();
+		delete m_commandThread;
+		m_commandThread = nullptr;
+	}
+	m_threadCommands.clear();
+	m_finishedThreadCommands.clear();
+
+	ClearConnections();
+	m_poller.Shutdown();
 }
 
 void RemoteConsole::TryToHost(uint16_t port)
@@ -87,7 +110,7 @@ void RemoteConsole::TryToJoin(NetworkAddress const& hostAddr)
 	TCPConnection* connection = new TCPConnection();
 	if (connection->Connect(hostAddr)) {
 		connection->SetBlocking(false);
-		m_connections.push_back(connection);
+		AddConnection(connection);
 		m_state = RemoteConsoleState::CLIENT;
 	}
 	else {
@@ -99,7 +122,7 @@ void RemoteConsole::TryToJoin(NetworkAddress const& hostAddr)
 			m_devConsole->AddLine(DevConsole::ERROR_COLOR, Stringf("Failed to join on address %s", hostAddr.ToString().c_str()));
 		}
 		else {
-			m_connections.push_back(connection);
+			AddConnection(connection);
 			m_state = RemoteConsoleState::JOINING;
 			m_devConsole->AddLine(DevConsole::INFO_MINOR_COLOR, Stringf("Trying to join: %s", hostAddr.ToString().c_str()));
 		}
@@ -135,24 +158,15 @@ void RemoteConsole::ProcessConnections()
 	if (m_state == RemoteConsoleState::DISCONNECTED) return;
 
 	if (m_server && m_state == RemoteConsoleState::HOST) {
-		TCPConnection* cp = m_server->Accept();
-		if (cp) {
-			auto addressIt = std::find(m_blacklistAddresses.begin(), m_blacklistAddresses.end(), cp->m_address);
-			if (addressIt == m_blacklistAddresses.end()) {
-				m_connections.push_back(cp);
-			}
-			else {
-				cp->Close();
-				delete cp;
-
-			}
-		}
+		AcceptConnections();
 	}
 
-	// process connections
+	ReceiveMessages();
+	ExecuteQueuedCommands();
+	SendFinishedThreadCommands();
 
-	int index = 0;
-	for (std::vector<TCPConnection*>::iterator it = m_connections.begin(); it != m_connections.end(); index++) {
+	// Every reply from this frame leaves in one send per connection
+	for (std::vector<TCPConnection*>::iterator it = m_connections.begin(); it != m_connections.end();) {
 
 		TCPConnection* connection = *it;
 
@@ -163,27 +177,9 @@ void RemoteConsole::ProcessConnections()
 		}
 
 		if (isConnected) {
-			size_t received = connection->ReceiveFull();
-			if (received > 0) {
-				bool isEcho = connection->IsMessageEcho();
-				std::string msg = connection->GetLastMessage();
-
-				EventArgs args;
-				args.SetValue("msg", msg);
-				args.SetValue("cmd", msg);
-				args.SetValue("isReceiving", "true");
-				args.SetValue("idx", std::to_string(index));
-				if (isEcho) {
-					args.SetValue("addr", connection->m_address.ToString());
-					FireEvent("RCEcho", args);
-				}
-				else {
-					FireEvent("RC", args);
-				}
-
-			}
-
+			connection->FlushSends();
 		}
+
 		if (connection->IsClosed()) {
 			if (m_state == RemoteConsoleState::CLIENT) {
 				m_devConsole->AddLine(DevConsole::WARNING_COLOR, "Connection terminated, returning to disconnected state");
@@ -194,6 +190,7 @@ void RemoteConsole::ProcessConnections()
 				m_state = RemoteConsoleState::DISCONNECTED;
 			}
 			it = m_connections.erase(it);
+			RemoveConnection(connection);
 		}
 		else {
 			it++;
@@ -201,67 +198,187 @@ void RemoteConsole::ProcessConnections()
 	}
 }
 
-void RemoteConsole::SendCommand(int connIndex, std::string const& cmd)
+void RemoteConsole::AddConnection(TCPConnection* connection)
 {
-	if (connIndex < 0 || connIndex >= m_connections.size()) {
-		return;
+	m_connections.push_back(connection);
+	m_poller.AddSocket(connection, SOCKET_EVENT_READ);
+}
+
+void RemoteConsole::AcceptConnections()
+{
+	// Everything waiting in the backlog, not one per frame
+	for (TCPConnection* cp = m_server->Accept(); cp != nullptr; cp = m_server->Accept()) {
+		auto addressIt = std::find(m_blacklistAddresses.begin(), m_blacklistAddresses.end(), cp->m_address);
+		if (addressIt == m_blacklistAddresses.end()) {
+			cp->SetBlocking(false); // Only Winsock hands the listen socket's mode down to accepted sockets
+			AddConnection(cp);
+		}
+		else {
+			cp->Close();
+			delete cp;
+		}
 	}
+}
 
-	TCPConnection* conn = m_connections[connIndex];
+void RemoteConsole::ReceiveMessages()
+{
+	m_pollResults.clear();
+	m_poller.Poll(m_pollResults, 0);
+
+	// Echo handlers can kick connections and free the polled sockets, so the ids are taken before any of them runs
+	m_polledConnectionIds.clear();
+	for (int resultIndex = 0; resultIndex < (int)m_pollResults.size(); resultIndex++) {
+		m_polledConnectionIds.push_back(((TCPConnection*)m_pollResults[resultIndex].m_socket)->GetConnectionId());
+	}
 
-	//unsigned char buffer[512];
-	size_t payloadSize = 1 // Echo
-		+ 2 // cmd size with null
-		+ cmd.size() + 1;
+	for (int resultIndex = 0; resultIndex < (int)m_polledConnectionIds.size(); resultIndex++) {
+		uint64_t connectionId = m_polledConnectionIds[resultIndex];
+		int connectionIndex = GetConnectionIndex(connectionId);
+		if (connectionIndex < 0) continue;
+
+		TCPConnection* connection = m_connections[connectionIndex];
+		if (!connection->CheckForConnection()) continue;
+
+		m_receivedMessages.clear();
+		connection->ReceiveFrames(m_receivedMessages);
+
+		for (int messageIndex = 0; messageIndex < (int)m_receivedMessages.size(); messageIndex++) {
+			TCPMessageView const& message = m_receivedMessages[messageIndex];
+			int index = GetConnectionIndex(connectionId);
+			if (index < 0) break;
+
+			// Commands wait in the queue, so a burst of them is spread over frames instead of stalling this one
+			if (!message.m_isEcho) {
+				RemoteCommand command;
+				command.m_connectionId = connectionId;
+				command.m_requestId = message.m_requestId;
+				command.m_command = std::string(message.m_text);
+				m_queuedCommands.push_back(command);
+				continue;
+			}
+
+			std::string text(message.m_text);
+			EventArgs args;
+			args.SetValue("msg", text);
+			// Typed values: NamedProperties only hands a value back as the type it was stored with
+			args.SetValue("isReceiving", true);
+			args.SetValue("idx", index);
+			args.SetValue("reqId", message.m_requestId);
+			args.SetValue("addr", connection->m_address.ToString());
+			FireEvent("RCEcho", args);
+		}
+	}
+}
 
-	//size_t packetSize = 2 + payloadSize;
+void RemoteConsole::ExecuteQueuedCommands()
+{
+	for (int commandCount = 0; commandCount < m_config.m_maxCommandsPerFrame && !m_queuedCommands.empty(); commandCount++) {
+		RemoteCommand command = m_queuedCommands.front();
+		m_queuedCommands.pop_front();
+
+		int index = GetConnectionIndex(command.m_connectionId);
+		if (index < 0) continue;
+
+		EventArgs args;
+		args.SetValue("cmd", command.m_command);
+		args.SetValue("isReceiving", true);
+		args.SetValue("idx", index);
+		args.SetValue("reqId", command.m_requestId);
+		FireEvent("RC", args);
+	}
+}
 
-	RDCHeader header;
-	header.m_payloadSize = ::htons((u_short)payloadSize);
+void RemoteConsole::QueueThreadCommand(RemoteCommand const& command)
+{
+	{
+		std::lock_guard<std::mutex> threadCommandsLock(m_threadCommandsMutex);
+		m_threadCommands.push_back(command);
+	}
+	m_threadCommandsCondition.notify_one();
+}
 
-	RDCPayload payload;
-	payload.m_isEcho = false;
-	payload.m_messageSize = ::htons((uint16_t)(cmd.size() + 1));
-	conn->Send(&header, sizeof(header));
-	conn->Send(&payload, sizeof(payload));
-	conn->Send(&cmd[0], cmd.size() + 1);
+void RemoteConsole::SendFinishedThreadCommands()
+{
+	std::deque<RemoteCommand> finishedCommands;
+	{
+		std::lock_guard<std::mutex> finishedLock(m_finishedThreadCommandsMutex);
+		finishedCommands.swap(m_finishedThreadCommands);
+	}
 
+	for (int commandIndex = 0; commandIndex < (int)finishedCommands.size(); commandIndex++) {
+		RemoteCommand const& command = finishedCommands[commandIndex];
+		int index = GetConnectionIndex(command.m_connectionId);
+		if (index < 0) continue;
 
+		std::string commandName = SplitStringOnDelimiter(command.m_command, ' ')[0];
+		if (command.m_wasExecuted) {
+			SendEcho(index, "Executing command: " + commandName, command.m_requestId);
+		}
+		else {
+			SendEcho(index, "Command not recognized: " + commandName, command.m_requestId);
+		}
+	}
 }
 
-void RemoteConsole::SendCommand(std::string const& cmd)
+void RemoteConsole::CommandThreadMain()
 {
-	for (int connIndex = 0; connIndex < m_connections.size(); connIndex++) {
-		SendCommand(connIndex, cmd);
+	while (true) {
+		RemoteCommand command;
+		{
+			std::unique_lock<std::mutex> threadCommandsLock(m_threadCommandsMutex);
+			while (m_threadCommands.empty() && !m_isQuitting) {
+				m_threadCommandsCondition.wait(threadCommandsLock);
+			}
+			if (m_isQuitting) return;
+
+			command = m_threadCommands.front();
+			m_threadCommands.pop_front();
+		}
+
+		// Only the event runs here. Replies are sent from the frame thread, which owns the sockets
+		command.m_wasExecuted = m_devConsole->ExecuteFromThread(command.m_command);
+
+		std::lock_guard<std::mutex> finishedLock(m_finishedThreadCommandsMutex);
+		m_finishedThreadCommands.push_back(command);
 	}
+}
 
+int RemoteConsole::GetConnectionIndex(uint64_t connectionId) const
+{
+	for (int connIndex = 0; connIndex < (int)m_connections.size(); connIndex++) {
+		if (m_connections[connIndex]->GetConnectionId() == connectionId) return connIndex;
+	}
+	return -1;
 }
 
-void RemoteConsole::SendEcho(int connIndex, std::string const& echo)
+void RemoteConsole::SendCommand(int connIndex, std::string const& cmd)
 {
 	if (connIndex < 0 || connIndex >= m_connections.size()) {
 		return;
 	}
 
+	// Tagged so the echoes can be matched up, however many commands are in flight
 	TCPConnection* conn = m_connections[connIndex];
+	conn->SendFrame(false, cmd, m_nextRequestId);
+	m_nextRequestId = (m_nextRequestId == 0xFFFFFFFF) ? 1 : m_nextRequestId + 1;
+}
 
-	//unsigned char buffer[512];
-	size_t payloadSize = 1 // Echo
-		+ 2 // message size with null
-		+ echo.size() + 1;
-
-	//size_t packetSize = 2 + payloadSize;
+void RemoteConsole::SendCommand(std::string const& cmd)
+{
+	for (int connIndex = 0; connIndex < m_connections.size(); connIndex++) {
+		SendCommand(connIndex, cmd);
+	}
 
-	RDCHeader header;
-	header.m_payloadSize = ::htons((u_short)payloadSize);
+}
 
-	RDCPayload payload;
-	payload.m_isEcho = true;
-	payload.m_messageSize = ::htons((uint16_t)(echo.size() + 1));
-	conn->Send(&header, sizeof(header));
-	conn->Send(&payload, sizeof(payload));
+void RemoteConsole::SendEcho(int connIndex, std::string const& echo, uint32_t requestId)
+{
+	if (connIndex < 0 || connIndex >= m_connections.size()) {
+		return;
+	}
 
-	conn->Send(&echo[0], echo.size() + 1);
+	TCPConnection* conn = m_connections[connIndex];
+	conn->SendFrame(true, echo, requestId);
 }
 
 void RemoteConsole::SendEcho(std::string const& echo)
@@ -277,8 +394,8 @@ void RemoteConsole::KillConnection(NetworkAddress const& netAddress)
 	for (std::vector<TCPConnection*>::iterator addressIt = m_connections.begin(); addressIt != m_connections.end(); addressIt++) {
 		TCPConnection* connection = *addressIt;
 		if (connection->m_address == netAddress) {
-			connection->Close();
 			m_connections.erase(addressIt);
+			RemoveConnection(connection);
 			return;
 		}
 
@@ -288,10 +405,10 @@ void RemoteConsole::KillConnection(NetworkAddress const& netAddress)
 
 void RemoteConsole::KillConnection(int connIndex)
 {
-	if (connIndex < 0 || connIndex > m_connections.size()) return;
+	if (connIndex < 0 || connIndex >= m_connections.size()) return;
 	TCPConnection* connection = m_connections[connIndex];
-	connection->Close();
 	m_connections.erase(m_connections.begin() + connIndex);
+	RemoveConnection(connection);
 
 }
 
@@ -388,6 +505,7 @@ bool RemoteConsole::RPC(EventArgs& args)
 	std::string command = args.GetValue("cmd", "");
 	int connectionIndex = args.GetValue("idx", 0);
 	bool isReceiving = args.GetValue("isReceiving", false);
+	uint32_t requestId = args.GetValue("reqId", (uint32_t)0);
 
 
 	if (command.empty()) return true;
@@ -401,7 +519,7 @@ bool RemoteConsole::RPC(EventArgs& args)
 		if (AreStringsEqualCaseInsensitive(commandName, s_invalidRCCmds[bannedCmdInd])) {
 			if (isReceiving) {
 				std::string commandExecution = "Detected ban command: " + commandName;
-				currentRemoteConsole->SendEcho(connectionIndex, commandExecution);
+				currentRemoteConsole->SendEcho(connectionIndex, commandExecution, requestId);
 
 				return true;
 			}
@@ -412,15 +530,24 @@ bool RemoteConsole::RPC(EventArgs& args)
 
 
 	if (isReceiving) {
+		if (currentRemoteConsole->m_commandThread && IsCommandThreadSafe(commandName)) {
+			RemoteCommand threadCommand;
+			threadCommand.m_connectionId = currentRemoteConsole->m_connections[connectionIndex]->GetConnectionId();
+			threadCommand.m_requestId = requestId;
+			threadCommand.m_command = command;
+			currentRemoteConsole->QueueThreadCommand(threadCommand);
+			return true;
+		}
+
 		bool executedCmd = currentRemoteConsole->m_devConsole->Execute(command);
 		if (executedCmd) {
 			std::string commandExecution = "Executing command: " + commandName;
-			currentRemoteConsole->SendEcho(connectionIndex, commandExecution);
+			currentRemoteConsole->SendEcho(connectionIndex, commandExecution, requestId);
 		}
 		else {
 			std::string commandExecution = "Command not recognized: " + commandName;
 
-			currentRemoteConsole->SendEcho(connectionIndex, commandExecution);
+			currentRemoteConsole->SendEcho(connectionIndex, commandExecution, requestId);
 		}
 	}
 	else {
@@ -461,11 +588,12 @@ bool RemoteConsole::RCEcho(EventArgs& args)
 	bool isReceiving = args.GetValue("isReceiving", false);
 	bool isBroadCast = args.GetValue("broadcast", false);
 	std::string networkAddr = args.GetValue("addr", "localhost");
+	uint32_t requestId = args.GetValue("reqId", (uint32_t)0);
 
 	if (message.empty()) return true;
 
 	if (isReceiving) {
-		std::string fullMessage = Stringf("[Echo: %s]: ", networkAddr.c_str());
+		std::string fullMessage = (requestId != 0) ? Stringf("[Echo: %s #%u]: ", networkAddr.c_str(), requestId) : Stringf("[Echo: %s]: ", networkAddr.c_str());
 		fullMessage += message;
 		currentRemoteConsole->m_devConsole->AddLine(DevConsole::INFO_MINOR_COLOR, fullMessage);
 	}
@@ -519,16 +647,42 @@ bool RemoteConsole::RCBan(EventArgs& args)
 	return false;
 }
 
-void RemoteConsole::ClearConnections()
+void RemoteConsole::MarkCommandThreadSafe(std::string const& cmdName)
 {
-	for (int connInd = 0; connInd < m_connections.size(); connInd++) {
-		TCPConnection*& conn = m_connections[connInd];
-		if (conn) {
-			conn->Close();
-			delete conn;
-			conn = nullptr;
-		}
+	if (!IsCommandThreadSafe(cmdName)) {
+		s_threadSafeRCCmds.push_back(cmdName);
 	}
 }
 
+bool RemoteConsole::IsCommandThreadSafe(std::string const& cmdName)
+{
+	for (int cmdIndex = 0; cmdIndex < s_threadSafeRCCmds.size(); cmdIndex++) {
+		if (AreStringsEqualCaseInsensitive(cmdName, s_threadSafeRCCmds[cmdIndex])) return true;
+	}
+	return false;
+}
+
+void RemoteConsole::RemoveConnection(TCPConnection* connection)
+{
+	uint64_t connectionId = connection->GetConnectionId();
+	for (std::deque<RemoteCommand>::iterator commandIt = m_queuedCommands.begin(); commandIt != m_queuedCommands.end();) {
+		if (commandIt->m_connectionId == connectionId) {
+			commandIt = m_queuedCommands.erase(commandIt);
+		}
+		else {
+			commandIt++;
+		}
+	}
+
+	m_poller.RemoveSocket(connection);
+	connection->Close();
+	delete connection;
+}
 
+void RemoteConsole::ClearConnections()
+{
+	for (int connInd = 0; connInd < m_connections.size(); connInd++) {
+		RemoveConnection(m_connections[connInd]);
+	}
+	m_connections.clear();
+}
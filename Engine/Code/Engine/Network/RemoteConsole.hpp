@@ -1,28 +1,33 @@
 #pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <string>
 #include "Engine/Core/EventSystem.hpp"
+#include "Engine/Network/SocketPoller.hpp"
+#include "Engine/Network/TCPConnection.hpp"
 
 class DevConsole;
 class Renderer;
-class TCPConnection;
 class TCPServer;
 
 class NetworkAddress;
 
-struct RDCHeader {
-	uint16_t m_payloadSize;
-};
-
-#pragma pack(push,1)
-struct RDCPayload{
-	uint8_t m_isEcho;
-	uint16_t m_messageSize;
-};
-#pragma pack(pop)
-
 struct RemoteConsoleConfig {
 	DevConsole* m_console = nullptr;
+	int m_maxCommandsPerFrame = 64; // Received commands past this wait in the queue for the next frame
+	bool m_useCommandThread = false; // Commands marked thread safe run on a worker thread instead of the frame
+};
+
+// A command received from a connection. Replies carry the request id back, so clients can have many in flight
+struct RemoteCommand {
+	uint64_t m_connectionId = 0; // The connection may be gone by the time the command runs, see TCPConnection::GetConnectionId
+	uint32_t m_requestId = 0;
+	std::string m_command;
+	bool m_wasExecuted = false;
 };
 enum class RemoteConsoleState {
 	DISCONNECTED,
@@ -45,9 +50,10 @@ public:
 	void Update();
 	void Render(Renderer const& renderer);
 	void ProcessConnections();
+	void ExecuteQueuedCommands();
 	void SendCommand(int connIndex, std::string const& cmd);
 	void SendCommand(std::string const& cmd);
-	void SendEcho(int connIndex, std::string const& echo);
+	void SendEcho(int connIndex, std::string const& echo, uint32_t requestId = 0);
 	void SendEcho(std::string const& echo);
 
 	void KillConnection(NetworkAddress const& netAddress);
@@ -66,15 +72,42 @@ public:
 	static bool RCLeave(EventArgs& args);
 	static bool RCBan(EventArgs& args);
 
+	// Only for commands whose callbacks don't touch game or render state; they may run on the command thread
+	static void MarkCommandThreadSafe(std::string const& cmdName);
+	static bool IsCommandThreadSafe(std::string const& cmdName);
+
 public:
 	DevConsole* m_devConsole = nullptr;
 
 private:
+	void AddConnection(TCPConnection* connection);
+	void AcceptConnections();
+	void ReceiveMessages();
+	void RemoveConnection(TCPConnection* connection);
 	void ClearConnections();
+	int GetConnectionIndex(uint64_t connectionId) const;
+
+	void QueueThreadCommand(RemoteCommand const& command);
+	void SendFinishedThreadCommands();
+	void CommandThreadMain();
 
 	RemoteConsoleConfig m_config;
 	std::vector<TCPConnection*> m_connections;
 	TCPServer* m_server = nullptr;
+	SocketPoller m_poller;
+	std::vector<SocketPollResult> m_pollResults;
+	std::vector<uint64_t> m_polledConnectionIds;
+	std::vector<TCPMessageView> m_receivedMessages;
+	std::deque<RemoteCommand> m_queuedCommands;
+	uint32_t m_nextRequestId = 1;
+
+	std::thread* m_commandThread = nullptr;
+	std::atomic<bool> m_isQuitting = false;
+	std::deque<RemoteCommand> m_threadCommands;
+	std::mutex m_threadCommandsMutex;
+	std::condition_variable m_threadCommandsCondition;
+	std::deque<RemoteCommand> m_finishedThreadCommands;
+	std::mutex m_finishedThreadCommandsMutex;
 	uint16_t m_hostAttempt = 0;
 	uint16_t m_hostPort = 3121;
 
@@ -83,4 +116,5 @@ private:
 	RemoteConsoleState m_state = RemoteConsoleState::DISCONNECTED;
 	std::vector<NetworkAddress> m_blacklistAddresses;
 	static std::vector<std::string> s_invalidRCCmds;
+	static std::vector<std::string> s_threadSafeRCCmds;
 };
\ No newline at end of file
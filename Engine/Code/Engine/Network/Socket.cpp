@@ -21,28 +21,26 @@ bool Socket::IsClosed() const
 
 void Socket::SetBlocking(bool isBlocking)
 {
-	u_long non_blocking = isBlocking ? 0 : 1;
-	::ioctlsocket(m_socketHandle, FIONBIO, &non_blocking);
+	SetSocketHandleBlocking(m_socketHandle, isBlocking);
+}
+
+void Socket::SetNoDelay(bool isNoDelay)
+{
+	int noDelay = isNoDelay ? 1 : 0;
+	::setsockopt(m_socketHandle, IPPROTO_TCP, TCP_NODELAY, (char const*)&noDelay, (SocketAddressLength)sizeof(noDelay));
 }
 
 
 bool Socket::CheckForFatalError() 
 {
-	int errorCode = ::WSAGetLastError();
+	int errorCode = GetLastSocketError();
+	if (IsSocketErrorNonFatal(errorCode)) return false;
 
-	switch (errorCode)
-	{
-	case 0:
-	case WSAEWOULDBLOCK:
-		return false;
-		/*case WSAECONNRESET:
-			g_theConsole->AddLine(DevConsole::ERROR_COLOR, Stringf("Network System: Socket hit a fatal error: 0x%08x", errorCode));
-			return true;*/
-	default:
+	if (g_theConsole) {
 		g_theConsole->AddLine(DevConsole::ERROR_COLOR, Stringf("Network System: Socket hit a fatal error: 0x%08x", errorCode));
-		Close();
-		return true;
 	}
+	Close();
+	return true;
 
 }
 
@@ -50,7 +48,7 @@ void Socket::Close()
 {
 	if (IsValid())
 	{
-		::closesocket(m_socketHandle);
+		CloseSocketHandle(m_socketHandle);
 		m_socketHandle = INVALID_SOCKET;
 	}
 }
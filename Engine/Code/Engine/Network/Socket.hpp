@@ -13,6 +13,8 @@ public:
 	bool IsClosed() const;
 
 	void SetBlocking( bool isBlocking);
+	// Turns Nagle off, so small frames go out right away instead of waiting on the peer's delayed ack
+	void SetNoDelay(bool isNoDelay);
 
 	void Close();
 
@@ -0,0 +1,172 @@
+#include "Engine/Network/SocketPoller.hpp"
+#include "Engine/Network/Socket.hpp"
+#include "Engine/Network/NetworkCommon.hpp"
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#define SOCKET_POLLER_USE_EPOLL
+#endif
+
+#if defined(SOCKET_POLLER_USE_EPOLL)
+static uint32_t GetEpollEvents(unsigned int events)
+{
+	uint32_t epollEvents = EPOLLRDHUP;
+	if (events & SOCKET_EVENT_READ) epollEvents |= EPOLLIN;
+	if (events & SOCKET_EVENT_WRITE) epollEvents |= EPOLLOUT;
+	return epollEvents;
+}
+#endif
+
+SocketPoller::~SocketPoller()
+{
+	Shutdown();
+}
+
+bool SocketPoller::Startup()
+{
+#if defined(SOCKET_POLLER_USE_EPOLL)
+	if (m_epollHandle == -1) {
+		m_epollHandle = ::epoll_create1(EPOLL_CLOEXEC);
+	}
+	return m_epollHandle != -1;
+#else
+	return true;
+#endif
+}
+
+void SocketPoller::Shutdown()
+{
+#if defined(SOCKET_POLLER_USE_EPOLL)
+	if (m_epollHandle != -1) {
+		::close(m_epollHandle);
+		m_epollHandle = -1;
+	}
+#endif
+	m_sockets.clear();
+	m_socketEvents.clear();
+}
+
+bool SocketPoller::AddSocket(Socket* socket, unsigned int events)
+{
+	if (!socket || socket->IsClosed()) {
+		return false;
+	}
+
+#if defined(SOCKET_POLLER_USE_EPOLL)
+	epoll_event epollEvent = {};
+	epollEvent.events = GetEpollEvents(events);
+	epollEvent.data.ptr = socket;
+	if (::epoll_ctl(m_epollHandle, EPOLL_CTL_ADD, (int)socket->m_socketHandle, &epollEvent) == -1) {
+		return false;
+	}
+#endif
+
+	m_sockets.push_back(socket);
+	m_socketEvents.push_back(events);
+	return true;
+}
+
+bool SocketPoller::ModifySocket(Socket* socket, unsigned int events)
+{
+	for (int socketIndex = 0; socketIndex < (int)m_sockets.size(); socketIndex++) {
+		if (m_sockets[socketIndex] != socket) continue;
+
+		if (m_socketEvents[socketIndex] == events) {
+			return true;
+		}
+
+#if defined(SOCKET_POLLER_USE_EPOLL)
+		epoll_event epollEvent = {};
+		epollEvent.events = GetEpollEvents(events);
+		epollEvent.data.ptr = socket;
+		if (::epoll_ctl(m_epollHandle, EPOLL_CTL_MOD, (int)socket->m_socketHandle, &epollEvent) == -1) {
+			return false;
+		}
+#endif
+		m_socketEvents[socketIndex] = events;
+		return true;
+	}
+
+	return false;
+}
+
+void SocketPoller::RemoveSocket(Socket* socket)
+{
+	for (int socketIndex = 0; socketIndex < (int)m_sockets.size(); socketIndex++) {
+		if (m_sockets[socketIndex] != socket) continue;
+
+#if defined(SOCKET_POLLER_USE_EPOLL)
+		if (socket->IsValid()) {
+			epoll_event unusedEvent = {};
+			::epoll_ctl(m_epollHandle, EPOLL_CTL_DEL, (int)socket->m_socketHandle, &unusedEvent);
+		}
+#endif
+		// Order doesn't matter, swap with the last one
+		m_sockets[socketIndex] = m_sockets.back();
+		m_socketEvents[socketIndex] = m_socketEvents.back();
+		m_sockets.pop_back();
+		m_socketEvents.pop_back();
+		return;
+	}
+}
+
+int SocketPoller::Poll(std::vector<SocketPollResult>& out_results, int timeoutMs)
+{
+	if (m_sockets.empty()) {
+		return 0;
+	}
+
+	int numResults = 0;
+
+#if defined(SOCKET_POLLER_USE_EPOLL)
+	// Sized for every socket so one wait reports all of them. Waiting again for the rest would just hand back the
+	// same level-triggered sockets
+	std::vector<epoll_event> epollEvents(m_sockets.size());
+	int numReady = ::epoll_wait(m_epollHandle, epollEvents.data(), (int)epollEvents.size(), timeoutMs);
+	if (numReady <= 0) {
+		return 0;
+	}
+
+	for (int eventIndex = 0; eventIndex < numReady; eventIndex++) {
+		uint32_t epollFlags = epollEvents[eventIndex].events;
+
+		SocketPollResult result;
+		result.m_socket = (Socket*)epollEvents[eventIndex].data.ptr;
+		if (epollFlags & EPOLLIN) result.m_events |= SOCKET_EVENT_READ;
+		if (epollFlags & EPOLLOUT) result.m_events |= SOCKET_EVENT_WRITE;
+		if (epollFlags & (EPOLLHUP | EPOLLERR | EPOLLRDHUP)) result.m_events |= SOCKET_EVENT_CLOSED | SOCKET_EVENT_READ;
+
+		out_results.push_back(result);
+		numResults++;
+	}
+#else
+	std::vector<WSAPOLLFD> pollFds(m_sockets.size());
+	for (int socketIndex = 0; socketIndex < (int)m_sockets.size(); socketIndex++) {
+		pollFds[socketIndex].fd = m_sockets[socketIndex]->m_socketHandle;
+		pollFds[socketIndex].events = 0;
+		if (m_socketEvents[socketIndex] & SOCKET_EVENT_READ) pollFds[socketIndex].events |= POLLRDNORM;
+		if (m_socketEvents[socketIndex] & SOCKET_EVENT_WRITE) pollFds[socketIndex].events |= POLLWRNORM;
+	}
+
+	int numReady = PollSocketHandles(pollFds.data(), (unsigned long)pollFds.size(), timeoutMs);
+	if (numReady <= 0) {
+		return 0;
+	}
+
+	for (int socketIndex = 0; socketIndex < (int)pollFds.size(); socketIndex++) {
+		short pollFlags = pollFds[socketIndex].revents;
+		if (pollFlags == 0) continue;
+
+		SocketPollResult result;
+		result.m_socket = m_sockets[socketIndex];
+		if (pollFlags & POLLRDNORM) result.m_events |= SOCKET_EVENT_READ;
+		if (pollFlags & POLLWRNORM) result.m_events |= SOCKET_EVENT_WRITE;
+		if (pollFlags & (POLLHUP | POLLERR | POLLNVAL)) result.m_events |= SOCKET_EVENT_CLOSED | SOCKET_EVENT_READ;
+
+		out_results.push_back(result);
+		numResults++;
+	}
+#endif
+
+	return numResults;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+
+class Socket;
+
+enum SocketEventFlags : unsigned int {
+	SOCKET_EVENT_READ = 1 << 0,
+	SOCKET_EVENT_WRITE = 1 << 1,
+	SOCKET_EVENT_CLOSED = 1 << 2, // Hung up or errored. Any data still buffered can be read first
+};
+
+struct SocketPollResult {
+	Socket* m_socket = nullptr;
+	unsigned int m_events = 0;
+};
+
+// Readiness notifications for many non-blocking sockets. Uses epoll on Linux, so a poll only pays for the sockets
+// that have something to report; elsewhere it falls back to poll/WSAPoll over the registered list.
+// Level triggered: a socket keeps reporting until it has been drained
+class SocketPoller {
+public:
+	SocketPoller() = default;
+	~SocketPoller();
+
+	bool Startup();
+	void Shutdown();
+
+	bool AddSocket(Socket* socket, unsigned int events = SOCKET_EVENT_READ);
+	bool ModifySocket(Socket* socket, unsigned int events);
+	// Has to happen before the socket is closed
+	void RemoveSocket(Socket* socket);
+
+	// Appends one result per ready socket. Returns how many were appended
+	int Poll(std::vector<SocketPollResult>& out_results, int timeoutMs = 0);
+	int GetNumSockets() const { return (int)m_sockets.size(); }
+
+private:
+	int m_epollHandle = -1;
+	std::vector<Socket*> m_sockets;
+	std::vector<unsigned int> m_socketEvents;
+};
@@ -2,32 +2,47 @@
 #include "Engine/Network/NetworkCommon.hpp"
 #include "Engine/Network/NetworkAddress.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include <cstring>
+
+std::atomic<uint64_t> TCPConnection::s_nextConnectionId = 1;
+
+static size_t WriteVarint(uint8_t* out_bytes, uint32_t value)
+{
+	size_t numBytes = 0;
+	do {
+		uint8_t lowBits = (uint8_t)(value & 0x7F);
+		value >>= 7;
+		out_bytes[numBytes++] = (value > 0) ? (lowBits | 0x80) : lowBits;
+	} while (value > 0);
+	return numBytes;
+}
 
 bool TCPConnection::Connect(NetworkAddress const& address)
 {
-	sockaddr_in ipv4;
+	sockaddr_in ipv4 = {};
 
 	uint64_t uintAddr = address.m_address;
 	uint16_t port = address.m_port;
 
 	ipv4.sin_family = AF_INET;
-	ipv4.sin_addr.S_un.S_addr = ::htonl((ULONG)uintAddr);
+	ipv4.sin_addr.s_addr = ::htonl((uint32_t)uintAddr);
 	ipv4.sin_port = ::htons(port);
 
-	SOCKET sock = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	SocketHandle sock = (SocketHandle)::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
 	if (sock == INVALID_SOCKET) {
 		return false;
 	}
 
-	int result = ::connect(sock, (sockaddr*)&ipv4, (int)sizeof(ipv4));
+	int result = ::connect(sock, (sockaddr*)&ipv4, (SocketAddressLength)sizeof(ipv4));
 	if (result == SOCKET_ERROR) {
-		::closesocket(sock);
+		CloseSocketHandle(sock);
 		return false;
 	}
 
 	m_socketHandle = sock;
 	m_address = address;
 	m_connectionState = ConnectionState::CONNECTING;
+	SetNoDelay(true);
 	return true;
 }
 
@@ -37,19 +52,62 @@ size_t TCPConnection::Send(void const* data, size_t const dataSize)
 		return 0;
 	}
 
-	int bytesSent = ::send(m_socketHandle, (char const*)data, (int)dataSize, 0);
-	if (bytesSent > 0) {
-		GUARANTEE_OR_DIE(bytesSent == dataSize, "BYTES SENT ARE NOT THE FULL SIZE OF THE MESSAGE");
-		return bytesSent;
+	uint8_t const* bytes = (uint8_t const*)data;
+	size_t bytesSent = 0;
+
+	// Anything already queued has to go out first, and nothing goes out before the connect finishes
+	if (IsConnected() && FlushSends()) {
+		bytesSent = SendImmediate(bytes, dataSize);
+		if (IsClosed()) {
+			return 0;
+		}
 	}
-	else if (bytesSent == 0) {
-		Close();
-		return 0;
+
+	if (bytesSent < dataSize) {
+		m_sendBuffer.insert(m_sendBuffer.end(), bytes + bytesSent, bytes + dataSize);
 	}
-	else {
-		CheckForFatalError();
-		return 0;
+	return dataSize;
+}
+
+size_t TCPConnection::SendImmediate(uint8_t const* data, size_t dataSize)
+{
+	size_t totalSent = 0;
+	while (totalSent < dataSize) {
+		int bytesSent = ::send(m_socketHandle, (char const*)&data[totalSent], (int)(dataSize - totalSent), SOCKET_SEND_FLAGS);
+		if (bytesSent > 0) {
+			totalSent += (size_t)bytesSent;
+		}
+		else if (bytesSent == 0) {
+			Close();
+			break;
+		}
+		else {
+			CheckForFatalError();
+			break;
+		}
+	}
+	return totalSent;
+}
+
+bool TCPConnection::FlushSends()
+{
+	if (!HasPendingSends()) {
+		return true;
+	}
+
+	if (IsClosed() || !IsConnected()) {
+		return false;
 	}
+
+	m_sendOffset += SendImmediate(&m_sendBuffer[m_sendOffset], m_sendBuffer.size() - m_sendOffset);
+	if (m_sendOffset == m_sendBuffer.size()) {
+		// Keeps the capacity, so steady traffic stops allocating
+		m_sendBuffer.clear();
+		m_sendOffset = 0;
+		return true;
+	}
+
+	return false;
 }
 
 size_t TCPConnection::Receive(void* buff, size_t maxBytesToRead)
@@ -69,43 +127,191 @@ size_t TCPConnection::Receive(void* buff, size_t maxBytesToRead)
 
 }
 
-size_t TCPConnection::ReceiveFull()
+void TCPConnection::GrowReceiveBuffer()
 {
-	if ((m_bytesReceived < m_bytesExpected) || (m_bytesReceived == 0)) {
-		size_t bytesToRead = 0;
-		if (m_bytesReceived < 2 && m_bytesExpected == 0) {
-			Receive(&bytesToRead, 2);
-			if (bytesToRead < 2) return 0;
-			m_bytesExpected = ::ntohs((u_short)bytesToRead);
+	size_t oldCapacity = m_receiveBuffer.size();
+	size_t newCapacity = (oldCapacity == 0) ? CONNECTION_BUFFER_SIZE : oldCapacity * 2;
+	size_t usedSize = m_receiveEnd - m_receiveStart;
+
+	// Unwrapped into the start of the new buffer
+	std::vector<uint8_t> newBuffer(newCapacity);
+	for (size_t position = 0; position < usedSize;) {
+		size_t readIndex = (m_receiveStart + position) & (oldCapacity - 1);
+		size_t chunkSize = oldCapacity - readIndex;
+		chunkSize = (chunkSize < usedSize - position) ? chunkSize : usedSize - position;
+		memcpy(&newBuffer[position], &m_receiveBuffer[readIndex], chunkSize);
+		position += chunkSize;
+	}
+
+	m_receiveBuffer.swap(newBuffer);
+	m_receiveStart = 0;
+	m_receiveEnd = usedSize;
+}
+
+size_t TCPConnection::ReceiveAvailable()
+{
+	if (m_receiveBuffer.empty()) {
+		GrowReceiveBuffer();
+	}
+
+	size_t totalRead = 0;
+	while (!IsClosed()) {
+		size_t capacity = m_receiveBuffer.size();
+		size_t freeSpace = capacity - (m_receiveEnd - m_receiveStart);
+		if (freeSpace == 0) {
+			// A full ring with a frame ready at the front gets parsed first, whatever is left stays in the socket for
+			// the next call. Only a ring holding no complete frame, so a frame bigger than the ring, grows
+			if (IsFrontFrameReady() || (capacity >= 2 * FRAME_MAX_PAYLOAD_SIZE)) {
+				break;
+			}
+			GrowReceiveBuffer();
+			continue;
+		}
+
+		// The free space wraps around the end of the ring at most once, so two buffers cover it in one call
+		size_t writeIndex = m_receiveEnd & (capacity - 1);
+		size_t firstSize = capacity - writeIndex;
+		firstSize = (firstSize < freeSpace) ? firstSize : freeSpace;
+
+		SocketBuffer buffers[2];
+		int numBuffers = 1;
+		SetSocketBuffer(buffers[0], &m_receiveBuffer[writeIndex], firstSize);
+		if (firstSize < freeSpace) {
+			SetSocketBuffer(buffers[1], &m_receiveBuffer[0], freeSpace - firstSize);
+			numBuffers = 2;
+		}
+
+		int bytesRead = ReceiveSocketBuffers(m_socketHandle, buffers, numBuffers);
+		if (bytesRead > 0) {
+			m_receiveEnd += (size_t)bytesRead;
+			totalRead += (size_t)bytesRead;
+
+			// A short read means the socket is empty; asking again would only come back with "would block"
+			if ((size_t)bytesRead < freeSpace) {
+				break;
+			}
+		}
+		else if (bytesRead == 0) {
+			Close();
 		}
 		else {
-			bytesToRead = m_bytesExpected - m_bytesReceived;
+			CheckForFatalError();
+			break;
 		}
+	}
+	return totalRead;
+}
 
-		
-		m_bytesReceived += Receive(&m_buffer[m_bytesReceived], bytesToRead);
+int TCPConnection::ReceiveFrames(std::vector<TCPMessageView>& out_messages)
+{
+	ReceiveAvailable();
+
+	if (m_receiveBuffer.empty()) {
+		return 0;
 	}
 
+	int numFrames = 0;
+	size_t capacityMask = m_receiveBuffer.size() - 1;
 
-	if (m_bytesReceived > 0 && (m_bytesReceived >= m_bytesExpected)) {
-		size_t totalReceived = m_bytesReceived;
-		m_bytesReceived = 0;
-		m_bytesExpected = 0;
+	while (m_receiveStart < m_receiveEnd) {
+		size_t available = m_receiveEnd - m_receiveStart;
 
-		m_isLastMessageEcho = (bool)m_buffer[0];
-		size_t msgSize = 0;
-		msgSize |= ((size_t)m_buffer[1]) << 8;
-		msgSize |= m_buffer[2];
+		uint32_t payloadSize = 0;
+		size_t headerSize = ParseReceivedVarint(m_receiveStart, m_receiveEnd, payloadSize);
+		if (headerSize == 0) {
+			if (available >= 5) {
+				// Over-long varint, the stream can't be trusted anymore
+				Close();
+			}
+			break;
+		}
 
-		m_lastMessage = std::string((char*)&m_buffer[3], msgSize);
+		if (payloadSize == 0 || payloadSize > FRAME_MAX_PAYLOAD_SIZE) {
+			Close();
+			break;
+		}
 
-		memset(m_buffer, 0, CONNECTION_BUFFER_SIZE);
+		if (available < headerSize + payloadSize) {
+			break;
+		}
 
-		return totalReceived;
+		size_t flagsPosition = m_receiveStart + headerSize;
+		size_t payloadEnd = flagsPosition + payloadSize;
+		uint8_t flags = GetReceivedByte(flagsPosition);
+
+		TCPMessageView message;
+		message.m_isEcho = (flags & FRAME_FLAG_ECHO) != 0;
+
+		size_t textPosition = flagsPosition + 1;
+		if (flags & FRAME_FLAG_REQUEST_ID) {
+			size_t requestIdSize = ParseReceivedVarint(textPosition, payloadEnd, message.m_requestId);
+			if (requestIdSize == 0) {
+				Close();
+				break;
+			}
+			textPosition += requestIdSize;
+		}
+
+		size_t textSize = payloadEnd - textPosition;
+		size_t textIndex = textPosition & capacityMask;
+
+		if (textIndex + textSize <= m_receiveBuffer.size()) {
+			message.m_text = std::string_view((char const*)&m_receiveBuffer[textIndex], textSize);
+		}
+		else {
+			size_t firstSize = m_receiveBuffer.size() - textIndex;
+			m_wrappedFrame.assign((char const*)&m_receiveBuffer[textIndex], firstSize);
+			m_wrappedFrame.append((char const*)&m_receiveBuffer[0], textSize - firstSize);
+			message.m_text = m_wrappedFrame;
+		}
+
+		out_messages.push_back(message);
+		m_receiveStart += headerSize + payloadSize;
+		numFrames++;
 	}
 
-	return 0;
+	// An empty ring can start over at the front, so the next batch is less likely to wrap. The bytes stay put, so
+	// the views handed out above are still good
+	if (m_receiveStart == m_receiveEnd) {
+		m_receiveStart = 0;
+		m_receiveEnd = 0;
+	}
 
+	if (numFrames > 0) {
+		TCPMessageView const& lastMessage = out_messages.back();
+		m_isLastMessageEcho = lastMessage.m_isEcho;
+		m_lastMessage.assign(lastMessage.m_text.data(), lastMessage.m_text.size());
+	}
+
+	return numFrames;
+}
+
+bool TCPConnection::IsFrontFrameReady() const
+{
+	size_t available = m_receiveEnd - m_receiveStart;
+	uint32_t payloadSize = 0;
+	size_t headerSize = ParseReceivedVarint(m_receiveStart, m_receiveEnd, payloadSize);
+	if (headerSize == 0) {
+		return available >= 5;
+	}
+
+	if (payloadSize == 0 || payloadSize > FRAME_MAX_PAYLOAD_SIZE) {
+		return true;
+	}
+	return available >= headerSize + payloadSize;
+}
+
+size_t TCPConnection::ParseReceivedVarint(size_t position, size_t endPosition, uint32_t& out_value) const
+{
+	out_value = 0;
+	for (size_t byteIndex = 0; byteIndex < 5 && position + byteIndex < endPosition; byteIndex++) {
+		uint8_t varintByte = GetReceivedByte(position + byteIndex);
+		out_value |= (uint32_t)(varintByte & 0x7F) << (7 * byteIndex);
+		if ((varintByte & 0x80) == 0) {
+			return byteIndex + 1;
+		}
+	}
+	return 0;
 }
 
 bool TCPConnection::IsConnected() const
@@ -118,6 +324,61 @@ void TCPConnection::SendString(std::string const& str)
 	Send(str.c_str(), str.size() + 1);
 }
 
+void TCPConnection::SendFrame(bool isEcho, std::string_view message, uint32_t requestId)
+{
+	if (IsClosed()) {
+		return;
+	}
+
+	if (message.size() > FRAME_MAX_PAYLOAD_SIZE - FRAME_MAX_HEADER_SIZE) {
+		message = message.substr(0, FRAME_MAX_PAYLOAD_SIZE - FRAME_MAX_HEADER_SIZE);
+	}
+
+	// The size has to count the request id, so the flags and id are encoded first
+	uint8_t payloadHeader[1 + 5];
+	size_t payloadHeaderSize = 1;
+	payloadHeader[0] = isEcho ? FRAME_FLAG_ECHO : 0;
+	if (requestId != 0) {
+		payloadHeader[0] |= FRAME_FLAG_REQUEST_ID;
+		payloadHeaderSize += WriteVarint(&payloadHeader[1], requestId);
+	}
+
+	uint8_t header[FRAME_MAX_HEADER_SIZE];
+	size_t headerSize = WriteVarint(header, (uint32_t)(payloadHeaderSize + message.size()));
+	memcpy(&header[headerSize], payloadHeader, payloadHeaderSize);
+	headerSize += payloadHeaderSize;
+
+	size_t bytesSent = 0;
+
+	// Big frames with nothing queued ahead of them go out as header + message in one gathered send, no copy
+	if (message.size() >= FRAME_DIRECT_SEND_SIZE && IsConnected() && !HasPendingSends()) {
+		SocketBuffer buffers[2];
+		SetSocketBuffer(buffers[0], header, headerSize);
+		SetSocketBuffer(buffers[1], message.data(), message.size());
+
+		int result = SendSocketBuffers(m_socketHandle, buffers, 2);
+		if (result > 0) {
+			bytesSent = (size_t)result;
+		}
+		else if (result == SOCKET_ERROR && CheckForFatalError()) {
+			return;
+		}
+	}
+
+	if (bytesSent < headerSize) {
+		m_sendBuffer.insert(m_sendBuffer.end(), header + bytesSent, header + headerSize);
+		bytesSent = headerSize;
+	}
+	size_t messageOffset = bytesSent - headerSize;
+	if (messageOffset < message.size()) {
+		m_sendBuffer.insert(m_sendBuffer.end(), (uint8_t const*)message.data() + messageOffset, (uint8_t const*)message.data() + message.size());
+	}
+
+	if (m_sendBuffer.size() - m_sendOffset >= SEND_QUEUE_FLUSH_SIZE) {
+		FlushSends();
+	}
+}
+
 bool TCPConnection::CheckForConnection()
 {
 	if (IsConnected()) {
@@ -129,16 +390,17 @@ bool TCPConnection::CheckForConnection()
 	}
 
 
-	WSAPOLLFD poll;
+	WSAPOLLFD poll = {};
 	poll.fd = m_socketHandle;
 	poll.events = POLLWRNORM;
 
-	int result = WSAPoll(&poll, 1, 0);
+	int result = PollSocketHandles(&poll, 1, 0);
 	if (result == SOCKET_ERROR) {
 		Close();
+		return false;
 	}
 
-	if ((poll.revents & POLLHUP) != 0) {
+	if ((poll.revents & (POLLHUP | POLLERR)) != 0) {
 		Close();
 		return false;
 	}
@@ -1,9 +1,22 @@
 #pragma once
 #include "Engine/Network/TCPSocket.hpp"
 #include "Engine/Network/NetworkAddress.hpp"
+#include <atomic>
 #include <string>
+#include <string_view>
+#include <vector>
 
-constexpr size_t CONNECTION_BUFFER_SIZE = 4096;
+constexpr size_t CONNECTION_BUFFER_SIZE = 16384; // Starting size of the receive ring, grows for bigger frames
+// Frame: payload size as a varint (7 bits per byte, low bits first, up to 5 bytes), then the payload: 1 flag byte,
+// the request id as another varint when FRAME_FLAG_REQUEST_ID is set, then the message bytes
+constexpr size_t FRAME_MAX_HEADER_SIZE = 5 + 1 + 5;
+constexpr size_t FRAME_MAX_PAYLOAD_SIZE = 16 * 1024 * 1024; // Bigger sizes are treated as a corrupt stream
+constexpr uint8_t FRAME_FLAG_ECHO = 1 << 0;
+constexpr uint8_t FRAME_FLAG_REQUEST_ID = 1 << 1;
+// Frames at least this big skip the send queue when it's empty and go out straight from the caller's memory
+constexpr size_t FRAME_DIRECT_SEND_SIZE = 16384;
+// The send queue flushes on its own past this size, otherwise it waits for FlushSends
+constexpr size_t SEND_QUEUE_FLUSH_SIZE = 65536;
 
 enum class ConnectionState {
 	DISCONNECTED,
@@ -11,28 +24,64 @@ enum class ConnectionState {
 	CONNECTED
 };
 
+// Points into the connection's receive buffer. Only valid until the next receive call on that connection
+struct TCPMessageView {
+	bool m_isEcho = false;
+	uint32_t m_requestId = 0; // 0 when the sender didn't tag the frame
+	std::string_view m_text;
+};
+
 class TCPConnection : public TCPSocket {
 public:
 	bool Connect(NetworkAddress const& address);
+	// Raw bytes, no framing. Never blocks; whatever the socket can't take is queued behind the frames
 	size_t Send(void const* data, size_t const dataSize);
 	size_t Receive(void* buff, size_t maxBytesToRead);
-	size_t ReceiveFull();
+	// Reads until the socket would block. Returns the bytes read
+	size_t ReceiveAvailable();
+	// Drains the socket and appends a view of every complete frame. Partial frames stay buffered for the next call
+	int ReceiveFrames(std::vector<TCPMessageView>& out_messages);
+	// Returns true once nothing is left queued
+	bool FlushSends();
+	bool HasPendingSends() const { return m_sendOffset < m_sendBuffer.size(); }
 
 	bool IsConnected() const;
 	bool IsMessageEcho() const { return m_isLastMessageEcho; }
 
 	void SendString(std::string const& str);
+	// Queued until FlushSends, so a burst of frames leaves in as few sends as possible
+	void SendFrame(bool isEcho, std::string_view message, uint32_t requestId = 0);
 	bool CheckForConnection();
 
 	std::string GetLastMessage() const;
+	// Never reused, unlike the connection's address, so it can name a connection that may already be gone
+	uint64_t GetConnectionId() const { return m_connectionId; }
 public:
 	NetworkAddress m_address;
 
 private:
+	size_t SendImmediate(uint8_t const* data, size_t dataSize);
+	void GrowReceiveBuffer();
+	uint8_t GetReceivedByte(size_t position) const { return m_receiveBuffer[position & (m_receiveBuffer.size() - 1)]; }
+	// Returns the varint's size in bytes, 0 if it runs past endPosition or is longer than 5 bytes
+	size_t ParseReceivedVarint(size_t position, size_t endPosition, uint32_t& out_value) const;
+	// True when ReceiveFrames can deal with the front of the ring without more bytes: a complete frame or a corrupt header
+	bool IsFrontFrameReady() const;
+
+private:
+	static std::atomic<uint64_t> s_nextConnectionId;
+	uint64_t m_connectionId = s_nextConnectionId++;
+
 	ConnectionState m_connectionState = ConnectionState::DISCONNECTED;
-	uint8_t m_buffer[CONNECTION_BUFFER_SIZE] = {};
-	size_t m_bytesReceived = 0;
-	size_t m_bytesExpected = 0;
+
+	// Ring buffer, power of two sized. Positions only ever grow and are masked on access
+	std::vector<uint8_t> m_receiveBuffer;
+	size_t m_receiveStart = 0;
+	size_t m_receiveEnd = 0;
+	std::string m_wrappedFrame; // Copy of the one frame per batch that can straddle the end of the ring
+
+	std::vector<uint8_t> m_sendBuffer;
+	size_t m_sendOffset = 0;
 
 	std::string m_lastMessage = "";
 	bool m_isLastMessageEcho = true;
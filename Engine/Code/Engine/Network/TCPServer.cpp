@@ -9,29 +9,35 @@ bool TCPServer::Host(uint16_t service, uint32_t backlog)
 	hostingAddress.m_address = INADDR_ANY; // Any IP
 	hostingAddress.m_port = service;
 
-	SOCKET sock = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	SocketHandle sock = (SocketHandle)::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
 	if (sock == INVALID_SOCKET) {
-		::closesocket(sock);
 		return false;
 	}
 
-	sockaddr_in ipv4Addr;
+#if !defined(_WIN32)
+	// Lets a restarted host take the port back right away instead of waiting out TIME_WAIT
+	int reuseAddress = 1;
+	::setsockopt((int)sock, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress));
+#endif
+
+	sockaddr_in ipv4Addr = {};
 	ipv4Addr.sin_family = AF_INET;
-	ipv4Addr.sin_addr.S_un.S_addr = ::htonl((ULONG)hostingAddress.m_address);
+	ipv4Addr.sin_addr.s_addr = ::htonl((uint32_t)hostingAddress.m_address);
 	ipv4Addr.sin_port = ::htons(hostingAddress.m_port);
 
-	int result = ::bind(sock, (sockaddr*)&ipv4Addr, (int) sizeof(ipv4Addr));
+	int result = ::bind(sock, (sockaddr*)&ipv4Addr, (SocketAddressLength) sizeof(ipv4Addr));
 	if (SOCKET_ERROR == result) {
-		::closesocket(sock);
+		CloseSocketHandle(sock);
 		return false;
 	}
 
 	m_socketHandle = sock;
 	m_address = hostingAddress;
 
-	result = ::listen(sock, backlog);
+	result = ::listen(sock, (int)backlog);
 	if (result == SOCKET_ERROR) {
 		Close();
+		return false;
 	}
 
 	return true;
@@ -44,28 +50,29 @@ TCPConnection* TCPServer::Accept()
 	}
 
 	sockaddr_storage addr;
-	int addrLen = sizeof(addr);
+	SocketAddressLength addrLen = sizeof(addr);
 
-	SocketHandle handle = ::accept(m_socketHandle, (sockaddr*) &addr, &addrLen);
+	SocketHandle handle = (SocketHandle)::accept(m_socketHandle, (sockaddr*) &addr, &addrLen);
 
 	if (handle == INVALID_SOCKET) {
 		return nullptr;
 	}
 
 	if (addr.ss_family != AF_INET) {
-		::closesocket(handle);
+		CloseSocketHandle(handle);
 		return nullptr;
 	}
 
 	sockaddr_in* ipv4Addr = (sockaddr_in*)&addr;
 
 	NetworkAddress address;
-	address.m_address = ::ntohl(ipv4Addr->sin_addr.S_un.S_addr);
+	address.m_address = ::ntohl(ipv4Addr->sin_addr.s_addr);
 	address.m_port = ::ntohs(ipv4Addr->sin_port);
 
 	TCPConnection* connection = new TCPConnection();
 	connection->m_socketHandle = handle;
 	connection->m_address = address;
+	connection->SetNoDelay(true);
 
 	return connection;
 
@@ -1,13 +1,31 @@
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Math/AABB2.hpp"
-#include "Engine/Math/OBB2.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+static uint64_t HashCombine(uint64_t hash, uint64_t value)
+{
+	return hash ^ (value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2));
+}
+
+static uint64_t HashFloat(uint64_t hash, float value)
+{
+	uint32_t bits = 0;
+	memcpy(&bits, &value, sizeof(bits));
+	return HashCombine(hash, bits);
+}
 
 BitmapFont::BitmapFont(char const* fontFilePathNameWithNoExtension, Texture& fontTexture):
 	m_fontFilePathNameWithNoExtension(fontFilePathNameWithNoExtension),
 	m_fontGlyphsSpriteSheet(fontTexture, IntVec2(16, 16))
 {
+	for (int glyphIndex = 0; glyphIndex < BITMAP_FONT_NUM_GLYPHS; glyphIndex++) {
+		m_glyphUVs[glyphIndex] = m_fontGlyphsSpriteSheet.GetSpriteUVs(glyphIndex);
+		m_glyphAspects[glyphIndex] = 1.0f; // Fixed width font: every glyph advances one cell
+	}
 }
 
 Texture const& BitmapFont::GetTexture() const
@@ -17,26 +35,113 @@ Texture const& BitmapFont::GetTexture() const
 
 void BitmapFont::AddVertsForText2D(std::vector<Vertex_PCU>& vertexArray, Vec2 const& textMins, float cellHeight, std::string const& text, Rgba8 const& tint, float cellAspect, int maxGlyphsToDraw)
 {
-	Vec2 letterPosition = textMins;
-	letterPosition.x += cellAspect * cellHeight * 0.5f;
-	letterPosition.y += cellHeight * 0.5f;
-	for (int charIndex = 0, glyphsDrawn = 0; charIndex < text.size(); charIndex++, glyphsDrawn++) {
-		if (glyphsDrawn >= maxGlyphsToDraw) return;
-		int const& letter = text[charIndex];
-		AABB2 letterUVs = m_fontGlyphsSpriteSheet.GetSpriteUVs(letter);
-
-		OBB2 letterOBB2;
-		letterOBB2.m_center = letterPosition;
-		letterOBB2.m_halfDimensions = Vec2(cellAspect * cellHeight * 0.5f, cellHeight * 0.5f);
-
-		AddVertsForOBB2D(vertexArray, letterOBB2, tint, letterUVs);
-		letterPosition.x += cellAspect * cellHeight;
+	int numGlyphs = (int)text.size();
+	if (numGlyphs > maxGlyphsToDraw) numGlyphs = maxGlyphsToDraw;
+	if (numGlyphs <= 0) return;
+
+	size_t firstVertIndex = vertexArray.size();
+	vertexArray.resize(firstVertIndex + (size_t)numGlyphs * GetVertCountForAABB2D());
+	Vertex_PCU* verts = vertexArray.data() + firstVertIndex;
+
+	float cellWidth = cellAspect * cellHeight;
+	Vec2 letterMins = textMins;
+	for (int charIndex = 0; charIndex < numGlyphs; charIndex++) {
+		unsigned char letter = (unsigned char)text[charIndex];
+		float letterWidth = cellWidth * m_glyphAspects[letter];
+
+		AABB2 letterBounds(letterMins, Vec2(letterMins.x + letterWidth, letterMins.y + cellHeight));
+		verts = AddVertsForAABB2D(verts, letterBounds, tint, m_glyphUVs[letter]);
+		letterMins.x += letterWidth;
 	}
-
 }
 
 void BitmapFont::AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight, std::string const& text, Rgba8 const& tint,
 										float cellAspect, Vec2 const& alignment, TextBoxMode mode, int maxGlyphsToDraw)
+{
+	if ((int)text.size() > MAX_CACHED_TEXT_LAYOUT_LENGTH) {
+		BuildVertsForTextInBox2D(vertexArray, box, cellHeight, text, tint, cellAspect, alignment, mode, maxGlyphsToDraw);
+		return;
+	}
+
+	// Static HUD text is laid out once; later calls with the same text and box copy the cached verts and retint them
+	uint64_t layoutKey = std::hash<std::string_view>()(std::string_view(text));
+	layoutKey = HashFloat(layoutKey, box.m_mins.x);
+	layoutKey = HashFloat(layoutKey, box.m_mins.y);
+	layoutKey = HashFloat(layoutKey, box.m_maxs.x);
+	layoutKey = HashFloat(layoutKey, box.m_maxs.y);
+	layoutKey = HashFloat(layoutKey, cellHeight);
+	layoutKey = HashFloat(layoutKey, cellAspect);
+	layoutKey = HashFloat(layoutKey, alignment.x);
+	layoutKey = HashFloat(layoutKey, alignment.y);
+	layoutKey = HashCombine(layoutKey, (uint64_t)mode);
+	layoutKey = HashCombine(layoutKey, (uint64_t)(uint32_t)maxGlyphsToDraw);
+
+	std::lock_guard<std::mutex> cacheLock(m_layoutCacheMutex);
+	m_numLayoutLookups++;
+	auto layoutIter = m_layoutCache.find(layoutKey);
+	bool isCached = (layoutIter != m_layoutCache.end());
+	if (isCached) {
+		BitmapFontTextLayout const& layout = layoutIter->second;
+		isCached = (layout.m_text == text) && (layout.m_box.m_mins == box.m_mins) && (layout.m_box.m_maxs == box.m_maxs) && (layout.m_cellHeight == cellHeight) &&
+			(layout.m_cellAspect == cellAspect) && (layout.m_alignment == alignment) && (layout.m_mode == mode) && (layout.m_maxGlyphsToDraw == maxGlyphsToDraw);
+	}
+
+	if (!isCached) {
+		if (m_layoutCache.size() >= MAX_CACHED_TEXT_LAYOUTS) {
+			EvictStaleLayouts();
+		}
+
+		BitmapFontTextLayout& layout = m_layoutCache[layoutKey];
+		layout.m_text = text;
+		layout.m_box = box;
+		layout.m_cellHeight = cellHeight;
+		layout.m_cellAspect = cellAspect;
+		layout.m_alignment = alignment;
+		layout.m_mode = mode;
+		layout.m_maxGlyphsToDraw = maxGlyphsToDraw;
+		layout.m_verts.clear();
+		BuildVertsForTextInBox2D(layout.m_verts, box, cellHeight, text, Rgba8::WHITE, cellAspect, alignment, mode, maxGlyphsToDraw);
+		layoutIter = m_layoutCache.find(layoutKey);
+	}
+
+	BitmapFontTextLayout& layout = layoutIter->second;
+	layout.m_lastUsedLookup = m_numLayoutLookups;
+
+	size_t firstVertIndex = vertexArray.size();
+	vertexArray.resize(firstVertIndex + layout.m_verts.size());
+	Vertex_PCU* verts = vertexArray.data() + firstVertIndex;
+	for (int vertIndex = 0; vertIndex < (int)layout.m_verts.size(); vertIndex++) {
+		verts[vertIndex] = layout.m_verts[vertIndex];
+		verts[vertIndex].m_color = tint;
+	}
+}
+
+void BitmapFont::ClearLayoutCache()
+{
+	std::lock_guard<std::mutex> cacheLock(m_layoutCacheMutex);
+	m_layoutCache.clear();
+}
+
+void BitmapFont::EvictStaleLayouts()
+{
+	// Drops whatever was not drawn within the last half cache's worth of lookups; text that changes every frame ages out first
+	uint32_t const maxAge = MAX_CACHED_TEXT_LAYOUTS / 2;
+	for (auto layoutIter = m_layoutCache.begin(); layoutIter != m_layoutCache.end();) {
+		if ((m_numLayoutLookups - layoutIter->second.m_lastUsedLookup) > maxAge) {
+			layoutIter = m_layoutCache.erase(layoutIter);
+		}
+		else {
+			++layoutIter;
+		}
+	}
+
+	if (m_layoutCache.size() >= MAX_CACHED_TEXT_LAYOUTS) {
+		m_layoutCache.clear();
+	}
+}
+
+void BitmapFont::BuildVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight, std::string const& text, Rgba8 const& tint,
+										float cellAspect, Vec2 const& alignment, TextBoxMode mode, int maxGlyphsToDraw)
 {
 	Strings textSplitByNewline = SplitStringOnDelimiter(text, '\n');
 
@@ -89,13 +194,16 @@ void BitmapFont::AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AA
 
 float BitmapFont::GetTextWidth(float cellHeight, std::string const& text, float cellAspect) const
 {
-	return text.size() * cellHeight * cellAspect;
+	float textAspect = 0.0f;
+	for (int charIndex = 0; charIndex < (int)text.size(); charIndex++) {
+		textAspect += m_glyphAspects[(unsigned char)text[charIndex]];
+	}
+	return textAspect * cellHeight * cellAspect;
 }
 
 float BitmapFont::GetGlyphAspect(int glyphUnicode) const
 {
-	UNUSED(glyphUnicode);
-	return 1.0f;
+	return m_glyphAspects[glyphUnicode & (BITMAP_FONT_NUM_GLYPHS - 1)];
 }
 
 float BitmapFont::GetBiggestTextWidth(Strings const& stringsVector, float cellHeight, float cellAspect) const
@@ -3,8 +3,11 @@
 
 #include "Engine/Renderer/SpriteSheet.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
 
-struct Vertex_PCU;
 class Texture;
 
 enum class TextBoxMode {
@@ -12,6 +15,23 @@ enum class TextBoxMode {
 	OVERRUN
 };
 
+constexpr int BITMAP_FONT_NUM_GLYPHS = 256;
+constexpr int MAX_CACHED_TEXT_LAYOUTS = 1024;
+constexpr int MAX_CACHED_TEXT_LAYOUT_LENGTH = 256; // Longer text (console dumps, debug blobs) is laid out every call instead of cached
+
+// Verts of one AddVertsForTextInBox2D call, kept with everything that shaped them. The tint is applied when copying out
+struct BitmapFontTextLayout {
+	std::string m_text;
+	AABB2 m_box;
+	float m_cellHeight = 0.0f;
+	float m_cellAspect = 0.0f;
+	Vec2 m_alignment;
+	TextBoxMode m_mode = TextBoxMode::SHRINK_TO_FIT;
+	int m_maxGlyphsToDraw = 0;
+	std::vector<Vertex_PCU> m_verts;
+	uint32_t m_lastUsedLookup = 0;
+};
+
 
 class BitmapFont {
 	friend class Renderer;
@@ -29,12 +49,25 @@ public:
 		int maxGlyphsToDraw = ARBITRARILY_LARGE_INT_VALUE);
 
 	float GetTextWidth(float cellHeight, std::string const& text, float cellAspect = CELL_ASPECT) const;
+	void ClearLayoutCache();
 
 protected:
 	float GetGlyphAspect(int glyphUnicode) const;
 	float GetBiggestTextWidth(Strings const& stringsVector, float cellHeight, float cellAspect) const;
+	void BuildVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight, std::string const& text,
+		Rgba8 const& tint, float cellAspect, Vec2 const& alignment, TextBoxMode mode, int maxGlyphsToDraw);
+	void EvictStaleLayouts(); // Caller holds m_layoutCacheMutex
 
 protected:
 	std::string m_fontFilePathNameWithNoExtension;
 	SpriteSheet m_fontGlyphsSpriteSheet;
+
+	// Looked up once at load, so laying out and measuring text never goes back to the sprite sheet
+	AABB2 m_glyphUVs[BITMAP_FONT_NUM_GLYPHS];
+	float m_glyphAspects[BITMAP_FONT_NUM_GLYPHS];
+
+	// Fonts are shared, and debug text is built from any thread while the render thread draws the console and messages
+	std::mutex m_layoutCacheMutex;
+	std::unordered_map<uint64_t, BitmapFontTextLayout> m_layoutCache;
+	uint32_t m_numLayoutLookups = 0;
 };
\ No newline at end of file
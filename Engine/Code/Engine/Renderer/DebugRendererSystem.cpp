@@ -1,10 +1,11 @@
 #include "Engine/Renderer/DebugRendererSystem.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Core/VertexUtils.hpp"
-#include "Engine/Renderer/DebugShape.hpp"
+#include "Engine/Renderer/DebugShapePool.hpp"
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Renderer/Billboard.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
+#include <algorithm>
 #include <vector>
 
 class DebugRenderSystem {
@@ -16,11 +17,12 @@ public:
 	void Clear();
 	void CheckAllShapes();
 
-	void RenderWorldShapes(Camera const& camera) const;
-	void RenderScreenShapes(Camera const& camera) const;
-	void AddShape(DebugShape* newShape);
-	void AddWireShape(DebugShape* newShape);
-	void AddBillboard(DebugShape* newShape);
+	void RenderWorldShapes(Camera const& camera);
+	void RenderScreenShapes(Camera const& camera);
+	void AddShape(std::vector<Vertex_PCU> const& verts, DebugRenderMode mode, float duration, Rgba8 startColor, Rgba8 endColor, bool isWorldText = false);
+	void AddWireShape(std::vector<Vertex_PCU> const& verts, DebugRenderMode mode, float duration, Rgba8 const& startColor, Rgba8 const& endColor);
+	void AddBillboard(std::vector<Vertex_PCU> const& verts, Vec3 const& origin, float duration, Rgba8 const& startColor, Rgba8 const& endColor);
+	void AddScreenText(std::vector<Vertex_PCU> const& verts, std::string const& text, ScrenTextType screenTextType, float duration, Rgba8 const& startColor, Rgba8 const& endColor);
 	void SetRenderModes(DebugRenderMode renderMode) const;
 	BitmapFont* GetBitmapFont() const;
 
@@ -31,33 +33,44 @@ public:
 	Clock m_clock;
 
 private:
-	void RenderWireframeShapes(Renderer* renderer) const;
-	void RenderBillboardShapes(Renderer* renderer, Camera const& camera) const;
-	void RenderDebugShapes(Renderer* renderer) const;
-	void RenderTextDebugShapes(Renderer* renderer) const;
-	void RenderFreeScreenText(Renderer* renderer) const;
-	void RenderTextMessages(Renderer* renderer, Camera const& camera) const;
+	void RenderWireframeShapes(Renderer* renderer);
+	void RenderBillboardShapes(Renderer* renderer, Camera const& camera);
+	void RenderDebugShapes(Renderer* renderer);
+	void RenderTextDebugShapes(Renderer* renderer);
+	void RenderFreeScreenText(Renderer* renderer);
+	void RenderTextMessages(Renderer* renderer, Camera const& camera);
+	void RenderShapePool(Renderer* renderer, DebugShapePool& shapePool, Texture const* texture);
 private:
-	mutable std::mutex m_debugShapesMutex[(int)DebugRenderMode::NUM_DEBUG_RENDER_MODES];
-	std::vector<DebugShape*> m_debugShapes[(int)DebugRenderMode::NUM_DEBUG_RENDER_MODES];
-
-	mutable std::mutex m_debugTextShapesMutex[(int)DebugRenderMode::NUM_DEBUG_RENDER_MODES];
-	std::vector<DebugShape*> m_debugTextShapes[(int)DebugRenderMode::NUM_DEBUG_RENDER_MODES];
-
-	mutable std::mutex m_wireFrameShapesMutex;
-	std::vector<DebugShape*> m_wireframeShapes;
-
-	mutable std::mutex m_billboardsMutex;
-	std::vector<DebugShape*> m_billboards;
-
-	mutable std::mutex m_screenTextShapesMutex[(int)ScrenTextType::NUM_SCREEN_TEXT_TYPES];
-	std::vector<DebugShape*> m_screnTextShapes[(int)ScrenTextType::NUM_SCREEN_TEXT_TYPES];
+	// One pool per shape kind and render mode; each is drawn with a single call
+	DebugShapePool m_debugShapes[(int)DebugRenderMode::NUM_DEBUG_RENDER_MODES];
+	DebugShapePool m_debugTextShapes[(int)DebugRenderMode::NUM_DEBUG_RENDER_MODES];
+	DebugShapePool m_wireframeShapes;
+	DebugShapePool m_billboards;
+	DebugShapePool m_screnTextShapes[(int)ScrenTextType::NUM_SCREEN_TEXT_TYPES];
+
+	struct MessageLine {
+		uint64_t m_addOrder = 0;
+		DebugShapeList const* m_shapes = nullptr;
+		int m_shapeIndex = -1;
+	};
+
+	std::vector<Vertex_PCU> m_billboardVerts; // Rebuilt every frame, kept to reuse its capacity
+	std::vector<Vertex_PCU> m_textMessageVerts; // Rebuilt every frame, kept to reuse its capacity
+	std::vector<MessageLine> m_messageLines; // Rebuilt every frame, kept to reuse its capacity
 
 	DebugRenderConfig m_config;
 
 	Material* m_materials[(int)DebugRenderMode::NUM_DEBUG_RENDER_MODES] = {};
 };
 
+// Shape verts are built here before being copied into their pool, so adding a shape allocates nothing once warmed up
+static std::vector<Vertex_PCU>& GetScratchVerts()
+{
+	static thread_local std::vector<Vertex_PCU> s_scratchVerts;
+	s_scratchVerts.clear();
+	return s_scratchVerts;
+}
+
 
 DebugRenderSystem::DebugRenderSystem(DebugRenderConfig debugSystemConfig) :
 	m_config(debugSystemConfig),
@@ -72,57 +85,6 @@ DebugRenderSystem::~DebugRenderSystem()
 
 void DebugRenderSystem::Startup()
 {
-	int reserveSize = 100;
-
-	for (int debugRenderTypeIndex = 0; debugRenderTypeIndex < (int)DebugRenderMode::NUM_DEBUG_RENDER_MODES; debugRenderTypeIndex++) {
-		std::mutex& listMutex = m_debugShapesMutex[debugRenderTypeIndex];
-
-		listMutex.lock();
-
-		std::vector<DebugShape*>& debugShapeList = m_debugShapes[debugRenderTypeIndex];
-		debugShapeList.reserve(reserveSize);
-
-		listMutex.unlock();
-	}
-
-	for (int debugRenderTypeIndex = 0; debugRenderTypeIndex < (int)DebugRenderMode::NUM_DEBUG_RENDER_MODES; debugRenderTypeIndex++) {
-		std::mutex& listMutex = m_debugTextShapesMutex[debugRenderTypeIndex];
-
-		listMutex.lock();
-
-		std::vector<DebugShape*>& debugShapeList = m_debugTextShapes[debugRenderTypeIndex];
-		debugShapeList.reserve(reserveSize);
-
-		listMutex.unlock();
-	}
-
-
-	m_wireFrameShapesMutex.lock();
-
-	m_wireframeShapes.reserve(reserveSize);
-
-	m_wireFrameShapesMutex.unlock();
-
-
-	m_billboardsMutex.lock();
-
-	m_billboards.reserve(reserveSize);
-
-	m_billboards.clear();
-
-	m_billboardsMutex.unlock();
-
-	for (int screenShapeType = 0; screenShapeType < (int)ScrenTextType::NUM_SCREEN_TEXT_TYPES; screenShapeType++) {
-		std::mutex& listMutex = m_screenTextShapesMutex[screenShapeType];
-		listMutex.lock();
-
-		std::vector<DebugShape*>& debugShapeList = m_screnTextShapes[screenShapeType];
-		debugShapeList.reserve(reserveSize);
-
-		listMutex.unlock();
-	}
-
-
 	std::string enginePath = ENGINE_MAT_DIR;
 	m_materials[(int)DebugRenderMode::ALWAYS] = m_config.m_renderer->CreateOrGetMaterial(enginePath + "DebugAlwaysMaterial");
 	m_materials[(int)DebugRenderMode::USEDEPTH] = m_config.m_renderer->CreateOrGetMaterial(enginePath + "DebugDepthMaterial");
@@ -136,183 +98,67 @@ void DebugRenderSystem::Shutdown()
 
 void DebugRenderSystem::Clear()
 {
-
-	for (int debugRenderTypeIndex = 0; debugRenderTypeIndex < (int)DebugRenderMode::NUM_DEBUG_RENDER_MODES; debugRenderTypeIndex++) {
-		std::mutex& listMutex = m_debugShapesMutex[debugRenderTypeIndex];
-
-		listMutex.lock();
-
-		std::vector<DebugShape*>& debugShapeList = m_debugShapes[debugRenderTypeIndex];
-		for (int shapeIndex = 0; shapeIndex < debugShapeList.size(); shapeIndex++) {
-			DebugShape*& shape = debugShapeList[shapeIndex];
-			if (shape) {
-				delete shape;
-				shape = nullptr;
-			}
-		}
-		debugShapeList.clear();
-
-		listMutex.unlock();
-	}
-
 	for (int debugRenderTypeIndex = 0; debugRenderTypeIndex < (int)DebugRenderMode::NUM_DEBUG_RENDER_MODES; debugRenderTypeIndex++) {
-		std::mutex& listMutex = m_debugTextShapesMutex[debugRenderTypeIndex];
-
-		listMutex.lock();
-
-		std::vector<DebugShape*>& debugShapeList = m_debugTextShapes[debugRenderTypeIndex];
-		for (int shapeIndex = 0; shapeIndex < debugShapeList.size(); shapeIndex++) {
-			DebugShape*& shape = debugShapeList[shapeIndex];
-			if (shape) {
-				delete shape;
-				shape = nullptr;
-			}
-		}
-		debugShapeList.clear();
-
-		listMutex.unlock();
-	}
-
-
-	m_wireFrameShapesMutex.lock();
-
-	for (int shapeIndex = 0; shapeIndex < m_wireframeShapes.size(); shapeIndex++) {
-
-		DebugShape*& shape = m_wireframeShapes[shapeIndex];
-		if (shape) {
-			delete shape;
-			shape = nullptr;
-		}
+		DebugShapePool& shapePool = m_debugShapes[debugRenderTypeIndex];
+		shapePool.m_mutex.lock();
+		shapePool.Clear();
+		shapePool.m_mutex.unlock();
+
+		DebugShapePool& textShapePool = m_debugTextShapes[debugRenderTypeIndex];
+		textShapePool.m_mutex.lock();
+		textShapePool.Clear();
+		textShapePool.m_mutex.unlock();
 	}
-	m_wireframeShapes.clear();
 
-	m_wireFrameShapesMutex.unlock();
+	m_wireframeShapes.m_mutex.lock();
+	m_wireframeShapes.Clear();
+	m_wireframeShapes.m_mutex.unlock();
 
-
-	m_billboardsMutex.lock();
-
-	for (int shapeIndex = 0; shapeIndex < m_billboards.size(); shapeIndex++) {
-		DebugShape*& shape = m_billboards[shapeIndex];
-		if (shape) {
-			delete shape;
-			shape = nullptr;
-		}
-	}
-	m_billboards.clear();
-
-	m_billboardsMutex.unlock();
+	m_billboards.m_mutex.lock();
+	m_billboards.Clear();
+	m_billboards.m_mutex.unlock();
 
 	for (int screenShapeType = 0; screenShapeType < (int)ScrenTextType::NUM_SCREEN_TEXT_TYPES; screenShapeType++) {
-		std::mutex& listMutex = m_screenTextShapesMutex[screenShapeType];
-		listMutex.lock();
-
-		std::vector<DebugShape*>& debugShapeList = m_screnTextShapes[screenShapeType];
-		for (int shapeIndex = 0; shapeIndex < debugShapeList.size(); shapeIndex++) {
-			DebugShape*& shape = debugShapeList[shapeIndex];
-			if (shape) {
-				delete shape;
-				shape = nullptr;
-			}
-		}
-		debugShapeList.clear();
-
-		listMutex.unlock();
+		DebugShapePool& shapePool = m_screnTextShapes[screenShapeType];
+		shapePool.m_mutex.lock();
+		shapePool.Clear();
+		shapePool.m_mutex.unlock();
 	}
-
 }
 
 void DebugRenderSystem::CheckAllShapes()
 {
+	double currentTime = m_clock.GetTotalTime();
 
 	for (int debugRenderTypeIndex = 0; debugRenderTypeIndex < (int)DebugRenderMode::NUM_DEBUG_RENDER_MODES; debugRenderTypeIndex++) {
-		std::mutex& listMutex = m_debugShapesMutex[debugRenderTypeIndex];
-
-		std::vector<DebugShape*>& debugShapeList = m_debugShapes[debugRenderTypeIndex];
-
-		listMutex.lock();
-		for (int shapeIndex = 0; shapeIndex < debugShapeList.size(); shapeIndex++) {
-			DebugShape*& shape = debugShapeList[shapeIndex];
-			if (shape) {
-				if (shape->CanShapeBeDeleted()) {
-					delete shape;
-					shape = nullptr;
-				}
-			}
-		}
-		listMutex.unlock();
-
-	}
-
-	for (int debugRenderTypeIndex = 0; debugRenderTypeIndex < (int)DebugRenderMode::NUM_DEBUG_RENDER_MODES; debugRenderTypeIndex++) {
-
-		std::mutex& listMutex = m_debugTextShapesMutex[debugRenderTypeIndex];
-
-		listMutex.lock();
-		std::vector<DebugShape*>& debugShapeList = m_debugTextShapes[debugRenderTypeIndex];
-
-		for (int shapeIndex = 0; shapeIndex < debugShapeList.size(); shapeIndex++) {
-			DebugShape*& shape = debugShapeList[shapeIndex];
-			if (shape) {
-				if (shape->CanShapeBeDeleted()) {
-					delete shape;
-					shape = nullptr;
-				}
-			}
-		}
-
-		listMutex.unlock();
+		DebugShapePool& shapePool = m_debugShapes[debugRenderTypeIndex];
+		shapePool.m_mutex.lock();
+		shapePool.RemoveExpiredShapes(currentTime);
+		shapePool.m_mutex.unlock();
+
+		DebugShapePool& textShapePool = m_debugTextShapes[debugRenderTypeIndex];
+		textShapePool.m_mutex.lock();
+		textShapePool.RemoveExpiredShapes(currentTime);
+		textShapePool.m_mutex.unlock();
 	}
 
-	m_wireFrameShapesMutex.lock();
-
-	for (int shapeIndex = 0; shapeIndex < m_wireframeShapes.size(); shapeIndex++) {
-		DebugShape*& shape = m_wireframeShapes[shapeIndex];
-		if (shape) {
-			if (shape->CanShapeBeDeleted()) {
-				delete shape;
-				shape = nullptr;
-			}
-		}
-	}
+	m_wireframeShapes.m_mutex.lock();
+	m_wireframeShapes.RemoveExpiredShapes(currentTime);
+	m_wireframeShapes.m_mutex.unlock();
 
-	m_wireFrameShapesMutex.unlock();
-
-	m_billboardsMutex.lock();
-
-	for (int shapeIndex = 0; shapeIndex < m_billboards.size(); shapeIndex++) {
-		DebugShape*& shape = m_billboards[shapeIndex];
-		if (shape) {
-			if (shape->CanShapeBeDeleted()) {
-				delete shape;
-				shape = nullptr;
-			}
-		}
-	}
-
-	m_billboardsMutex.unlock();
+	m_billboards.m_mutex.lock();
+	m_billboards.RemoveExpiredShapes(currentTime);
+	m_billboards.m_mutex.unlock();
 
 	for (int screenTextTypeIndex = 0; screenTextTypeIndex < (int)ScrenTextType::NUM_SCREEN_TEXT_TYPES; screenTextTypeIndex++) {
-
-		std::mutex& listMutex = m_screenTextShapesMutex[screenTextTypeIndex];
-		listMutex.lock();
-
-		std::vector<DebugShape*>& debugShapeList = m_screnTextShapes[screenTextTypeIndex];
-		for (int shapeIndex = 0; shapeIndex < debugShapeList.size(); shapeIndex++) {
-			DebugShape*& shape = debugShapeList[shapeIndex];
-			if (shape) {
-				if (shape->CanShapeBeDeleted()) {
-					delete shape;
-					shape = nullptr;
-				}
-			}
-		}
-
-		listMutex.unlock();
+		DebugShapePool& shapePool = m_screnTextShapes[screenTextTypeIndex];
+		shapePool.m_mutex.lock();
+		shapePool.RemoveExpiredShapes(currentTime);
+		shapePool.m_mutex.unlock();
 	}
-
 }
 
-void DebugRenderSystem::RenderWorldShapes(Camera const& camera) const
+void DebugRenderSystem::RenderWorldShapes(Camera const& camera)
 {
 	if (!m_isVisible) return;
 	//#TODO DX12 FIXTHIS
@@ -330,101 +176,94 @@ void DebugRenderSystem::RenderWorldShapes(Camera const& camera) const
 
 }
 
-void DebugRenderSystem::RenderWireframeShapes(Renderer* renderer) const
+void DebugRenderSystem::RenderShapePool(Renderer* renderer, DebugShapePool& shapePool, Texture const* texture)
 {
-	SetRenderModes(DebugRenderMode::USEDEPTH);
+	// Verts are already in world space with their tint baked in, so the model constants stay at identity and white
+	shapePool.m_mutex.lock();
 
-	m_wireFrameShapesMutex.lock();
-
-	//#TODO DX12 FIXTHIS
+	shapePool.UpdateColors(m_clock.GetTotalTime());
+	if (shapePool.GetNumVerts() > 0) {
+		renderer->SetModelMatrix(Mat44());
+		renderer->SetModelColor(Rgba8::WHITE);
+		renderer->BindTexture(texture);
+	}
 
-	for (int shapeIndex = 0; shapeIndex < m_wireframeShapes.size(); shapeIndex++) {
-		DebugShape* const shape = m_wireframeShapes[shapeIndex];
-		if (shape) {
-			renderer->SetModelMatrix(shape->GetModelMatrix());
-			renderer->SetModelColor(shape->GetModelColor());
-			shape->Render(renderer);
+	for (int lifetimeIndex = 0; lifetimeIndex < (int)DebugShapeLifetime::NUM_DEBUG_SHAPE_LIFETIMES; lifetimeIndex++) {
+		DebugShapeList const& shapes = shapePool.GetShapeList((DebugShapeLifetime)lifetimeIndex);
+		if (shapes.GetNumVerts() > 0) {
+			renderer->DrawVertexArray((unsigned int)shapes.GetNumVerts(), shapes.GetVerts());
 		}
 	}
 
-	m_wireFrameShapesMutex.unlock();
+	shapePool.m_mutex.unlock();
 }
 
-void DebugRenderSystem::RenderBillboardShapes(Renderer* renderer, Camera const& camera) const
+void DebugRenderSystem::RenderWireframeShapes(Renderer* renderer)
+{
+	SetRenderModes(DebugRenderMode::USEDEPTH);
+	//#TODO DX12 FIXTHIS
+
+	RenderShapePool(renderer, m_wireframeShapes, nullptr);
+}
+
+void DebugRenderSystem::RenderBillboardShapes(Renderer* renderer, Camera const& camera)
 {
 	//#TODO DX12 FIXTHIS
 
 	renderer->BindMaterial(m_materials[(int)DebugRenderMode::ALWAYS]);
 	BitmapFont const* font = GetBitmapFont();
 
-	renderer->BindTexture(&font->GetTexture());
+	m_billboards.m_mutex.lock();
+
+	m_billboards.UpdateColors(m_clock.GetTotalTime());
 
-	m_billboardsMutex.lock();
+	// Billboards face the camera, so theirs are the only verts transformed again every frame
+	m_billboardVerts.clear();
+	m_billboardVerts.reserve(m_billboards.GetNumVerts());
+	for (int lifetimeIndex = 0; lifetimeIndex < (int)DebugShapeLifetime::NUM_DEBUG_SHAPE_LIFETIMES; lifetimeIndex++) {
+		DebugShapeList const& billboards = m_billboards.GetShapeList((DebugShapeLifetime)lifetimeIndex);
+		for (int shapeIndex = billboards.GetFirstShapeIndex(); shapeIndex < billboards.GetEndShapeIndex(); shapeIndex++) {
+			Vec3 const& origin = billboards.GetShapeOrigin(shapeIndex);
+			Mat44 modelMat = Billboard::GetModelMatrixForBillboard(origin, camera, BillboardType::CameraFacingXYZ);
+			modelMat.SetTranslation3D(origin);
 
-	for (int shapeIndex = 0; shapeIndex < m_billboards.size(); shapeIndex++) {
-		DebugShape* const shape = m_billboards[shapeIndex];
-		if (!shape) continue;
-		Mat44 modelMat = shape->GetBillboardModelMatrix(camera);
-		modelMat.SetTranslation3D(shape->GetModelMatrix().GetTranslation3D());
-		renderer->SetModelMatrix(modelMat);
-		renderer->SetModelColor(shape->GetModelColor());
-		shape->Render(renderer);
+			int firstVert = (int)m_billboardVerts.size();
+			int numVerts = billboards.GetShapeNumVerts(shapeIndex);
+			m_billboardVerts.insert(m_billboardVerts.end(), billboards.GetShapeVerts(shapeIndex), billboards.GetShapeVerts(shapeIndex) + numVerts);
+			TransformVertexArray3D(numVerts, m_billboardVerts.data() + firstVert, modelMat);
+		}
 	}
 
-	m_billboardsMutex.unlock();
+	m_billboards.m_mutex.unlock();
 
+	if (!m_billboardVerts.empty()) {
+		renderer->SetModelMatrix(Mat44());
+		renderer->SetModelColor(Rgba8::WHITE);
+		renderer->BindTexture(&font->GetTexture());
+		renderer->DrawVertexArray(m_billboardVerts);
+	}
 }
 
-void DebugRenderSystem::RenderDebugShapes(Renderer* renderer) const
+void DebugRenderSystem::RenderDebugShapes(Renderer* renderer)
 {
 	for (int debugRenderTypeIndex = 0; debugRenderTypeIndex < (int)DebugRenderMode::NUM_DEBUG_RENDER_MODES; debugRenderTypeIndex++) {
-
-		std::mutex& listMutex = m_debugShapesMutex[debugRenderTypeIndex];
-
-		listMutex.lock();
-
-		std::vector<DebugShape*>const& debugShapeList = m_debugShapes[debugRenderTypeIndex];
 		SetRenderModes((DebugRenderMode)debugRenderTypeIndex);
-
-		for (int shapeIndex = 0; shapeIndex < (int)debugShapeList.size(); shapeIndex++) {
-			DebugShape* const shape = debugShapeList[shapeIndex];
-			if (shape) {
-				renderer->SetModelMatrix(shape->GetModelMatrix());
-				renderer->SetModelColor(shape->GetModelColor());
-				shape->Render(renderer);
-			}
-		}
-
-		listMutex.unlock();
+		RenderShapePool(renderer, m_debugShapes[debugRenderTypeIndex], nullptr);
 	}
 }
 
-void DebugRenderSystem::RenderTextDebugShapes(Renderer* renderer) const
+void DebugRenderSystem::RenderTextDebugShapes(Renderer* renderer)
 {
+	BitmapFont const* font = GetBitmapFont();
 	for (int debugRenderTypeIndex = 0; debugRenderTypeIndex < (int)DebugRenderMode::NUM_DEBUG_RENDER_MODES; debugRenderTypeIndex++) {
-
-		std::mutex& listMutex = m_debugTextShapesMutex[debugRenderTypeIndex];
-		listMutex.lock();
-
-		std::vector<DebugShape*>const& debugShapeList = m_debugTextShapes[debugRenderTypeIndex];
 		SetRenderModes((DebugRenderMode)debugRenderTypeIndex);
 		//#TODO DX12 FIXTHIS
-
-		for (int shapeIndex = 0; shapeIndex < (int)debugShapeList.size(); shapeIndex++) {
-			DebugShape* const shape = debugShapeList[shapeIndex];
-			if (shape) {
-				renderer->SetModelMatrix(shape->GetModelMatrix());
-				renderer->SetModelColor(shape->GetModelColor());
-				shape->Render(renderer);
-			}
-		}
-
-		listMutex.unlock();
+		RenderShapePool(renderer, m_debugTextShapes[debugRenderTypeIndex], &font->GetTexture());
 	}
 }
 
 
-void DebugRenderSystem::RenderScreenShapes(Camera const& camera) const
+void DebugRenderSystem::RenderScreenShapes(Camera const& camera)
 {
 	if (!m_isVisible) return;
 
@@ -441,175 +280,109 @@ void DebugRenderSystem::RenderScreenShapes(Camera const& camera) const
 
 }
 
-void DebugRenderSystem::RenderFreeScreenText(Renderer* renderer) const
+void DebugRenderSystem::RenderFreeScreenText(Renderer* renderer)
 {
-	std::mutex& listMutex = m_screenTextShapesMutex[(int)ScrenTextType::FreeText];
-	listMutex.lock();
-
-
-	std::vector<DebugShape*>const& debugShapeList = m_screnTextShapes[(int)ScrenTextType::FreeText];
-	for (int shapeIndex = 0; shapeIndex < debugShapeList.size(); shapeIndex++) {
-		DebugShape const* shape = debugShapeList[shapeIndex];
-		if (shape) {
-			//#TODO DX12 FIXTHIS
-			renderer->SetModelMatrix(shape->GetModelMatrix());
-			renderer->SetModelColor(shape->GetModelColor());
-			shape->Render(renderer);
-		}
-	}
-
-	listMutex.unlock();
+	//#TODO DX12 FIXTHIS
+	BitmapFont const* font = GetBitmapFont();
+	RenderShapePool(renderer, m_screnTextShapes[(int)ScrenTextType::FreeText], &font->GetTexture());
 }
 
-void DebugRenderSystem::RenderTextMessages(Renderer* renderer, Camera const& camera) const
+void DebugRenderSystem::RenderTextMessages(Renderer* renderer, Camera const& camera)
 {
 	float cellHeight = camera.GetOrthoTopRight().y * 0.02f;
 
 	AABB2 bounds(camera.GetOrthoBottomLeft(), camera.GetOrthoTopRight());
-	AABB2 inputBounds(camera.GetOrthoBottomLeft(), camera.GetOrthoTopRight());
 	BitmapFont* font = GetBitmapFont();
 
 	float minGroupTextHeight = bounds.m_maxs.y;
 	float maxLinesShown = 21.5f;
 
-	std::mutex& listMutex = m_screenTextShapesMutex[(int)ScrenTextType::ScreenMessage];
-	listMutex.lock();
+	DebugShapePool& messages = m_screnTextShapes[(int)ScrenTextType::ScreenMessage];
+	messages.m_mutex.lock();
+	messages.UpdateColors(m_clock.GetTotalTime());
 
-	std::vector<DebugShape*> const& textShapes = m_screnTextShapes[(int)ScrenTextType::ScreenMessage];
+	std::vector<Vertex_PCU>& textVerts = m_textMessageVerts;
+	textVerts.clear();
 
-	std::vector<Vertex_PCU> textVerts;
-	textVerts.reserve(textShapes.size() * 40);
+	// The pool keeps messages by expiry time, but they are listed in the order they were added
+	std::vector<MessageLine>& messageLines = m_messageLines;
+	messageLines.clear();
+	for (int lifetimeIndex = 0; lifetimeIndex < (int)DebugShapeLifetime::NUM_DEBUG_SHAPE_LIFETIMES; lifetimeIndex++) {
+		DebugShapeList const& shapes = messages.GetShapeList((DebugShapeLifetime)lifetimeIndex);
+		for (int shapeIndex = shapes.GetFirstShapeIndex(); shapeIndex < shapes.GetEndShapeIndex(); shapeIndex++) {
+			messageLines.push_back(MessageLine{ shapes.GetShapeAddOrder(shapeIndex), &shapes, shapeIndex });
+		}
+	}
 
-	int roundedUpMaxLinesShown = RoundDownToInt(maxLinesShown) + 2;
-	float lineWidth = 0;
-	int renderLineIndex = 1;
-	for (int lineIndex = 0; lineIndex < textShapes.size(); lineIndex++ && roundedUpMaxLinesShown >= 0, roundedUpMaxLinesShown--) {
-		DebugShape const* shape = textShapes[lineIndex];
-		if (!shape) continue;
+	// Only the lines that fit on screen are ordered and laid out
+	int maxLinesDrawn = RoundDownToInt(maxLinesShown) + 2;
+	int numLinesDrawn = ((int)messageLines.size() < maxLinesDrawn) ? (int)messageLines.size() : maxLinesDrawn;
+	std::partial_sort(messageLines.begin(), messageLines.begin() + numLinesDrawn, messageLines.end(),
+		[](MessageLine const& lineA, MessageLine const& lineB) { return lineA.m_addOrder < lineB.m_addOrder; });
 
-		lineWidth = font->GetTextWidth(cellHeight, shape->m_text);
+	for (int lineIndex = 0; lineIndex < numLinesDrawn; lineIndex++) {
+		MessageLine const& messageLine = messageLines[lineIndex];
+		std::string const& text = messageLine.m_shapes->GetShapeText(messageLine.m_shapeIndex);
+		float lineWidth = font->GetTextWidth(cellHeight, text);
 
 		AABB2 lineAABB2(Vec2::ZERO, Vec2(lineWidth, cellHeight));
 		bounds.AlignABB2WithinBounds(lineAABB2, Vec2(0.0f, 1.0f));
 
+		int renderLineIndex = lineIndex + 1;
 		lineAABB2.m_mins.y = minGroupTextHeight - ((renderLineIndex) * (cellHeight * 2.0f));
-		Rgba8 textColor = Rgba8::InterpolateColors(shape->m_startColor, shape->m_endColor, shape->m_stopwach.GetElapsedFraction());
-		font->AddVertsForTextInBox2D(textVerts, lineAABB2, cellHeight, shape->m_text, textColor);
-		renderLineIndex++;
+		font->AddVertsForTextInBox2D(textVerts, lineAABB2, cellHeight, text, messageLine.m_shapes->GetShapeTint(messageLine.m_shapeIndex));
 	}
 
-	listMutex.unlock();
+	messages.m_mutex.unlock();
 	//#TODO DX12 FIXTHIS
 
 	renderer->SetModelMatrix(Mat44());
+	renderer->SetModelColor(Rgba8::WHITE);
 	renderer->BindTexture(&font->GetTexture());
 	if (textVerts.size() > 0) {
 		renderer->DrawVertexArray(textVerts);
 	}
 }
 
-void DebugRenderSystem::AddShape(DebugShape* newShape)
+void DebugRenderSystem::AddShape(std::vector<Vertex_PCU> const& verts, DebugRenderMode mode, float duration, Rgba8 startColor, Rgba8 endColor, bool isWorldText)
 {
-
-	if (newShape->m_stopwach.m_duration == -1.0f) {
-		newShape->m_stopwach.m_duration = FLT_MAX;
-	}
-
-	if (newShape->m_debugRenderMode == DebugRenderMode::XRAY) {
-		DebugShape* solidShape = new DebugShape(*newShape);
-		solidShape->m_debugRenderMode = DebugRenderMode::USEDEPTH;
-		AddShape(solidShape);
-		newShape->m_startColor.a = 120;
-		newShape->m_endColor.a = 120;
-	}
-
-
-	std::mutex& debugShapeListMutex = m_debugShapesMutex[(int)newShape->m_debugRenderMode];
-	debugShapeListMutex.lock();																// lock
-
-	std::vector<DebugShape*>& debugShapeList = m_debugShapes[(int)newShape->m_debugRenderMode];
-
-	std::mutex& textDebugMutex = m_debugTextShapesMutex[(int)newShape->m_debugRenderMode];
-	textDebugMutex.lock();																	// lock
-
-	std::vector<DebugShape*>& textDebugShapeList = m_debugTextShapes[(int)newShape->m_debugRenderMode];
-
-	std::vector<DebugShape*>& usedDebugShapeList = (newShape->m_isWorldText) ? textDebugShapeList : debugShapeList;
-
-
-	std::mutex& screenTextMutex = m_screenTextShapesMutex[(int)newShape->m_screenTextType];
-	screenTextMutex.lock();																	// lock
-
-	std::vector<DebugShape*>& screnTextShapeList = m_screnTextShapes[(int)newShape->m_screenTextType];
-
-	std::vector<DebugShape*>& usedShapeList = (newShape->m_isWorldShape) ? usedDebugShapeList : screnTextShapeList;
-
-	for (int shapeIndex = 0; shapeIndex < (int)usedShapeList.size(); shapeIndex++) {
-		DebugShape*& shape = usedShapeList[shapeIndex];
-		if (!shape) {
-			shape = newShape;
-
-			debugShapeListMutex.unlock();
-			textDebugMutex.unlock();
-			screenTextMutex.unlock();
-
-
-			return;
-		}
+	if (mode == DebugRenderMode::XRAY) {
+		AddShape(verts, DebugRenderMode::USEDEPTH, duration, startColor, endColor, isWorldText);
+		startColor.a = 120;
+		endColor.a = 120;
 	}
-	usedShapeList.push_back(newShape);
 
-
-	debugShapeListMutex.unlock();
-	textDebugMutex.unlock();
-	screenTextMutex.unlock();
+	DebugShapePool& shapePool = (isWorldText) ? m_debugTextShapes[(int)mode] : m_debugShapes[(int)mode];
+	shapePool.m_mutex.lock();
+	shapePool.AddShape(verts.data(), (int)verts.size(), m_clock.GetTotalTime(), duration, startColor, endColor);
+	shapePool.m_mutex.unlock();
 }
 
-void DebugRenderSystem::AddWireShape(DebugShape* newShape)
+void DebugRenderSystem::AddWireShape(std::vector<Vertex_PCU> const& verts, DebugRenderMode mode, float duration, Rgba8 const& startColor, Rgba8 const& endColor)
 {
-	if (newShape->m_stopwach.m_duration == -1.0f) {
-		newShape->m_stopwach.m_duration = FLT_MAX;
-	}
-
-	m_wireFrameShapesMutex.lock();
-
-	for (int shapeIndex = 0; shapeIndex < m_wireframeShapes.size(); shapeIndex++) {
-		DebugShape*& shape = m_wireframeShapes[shapeIndex];
-		if (!shape) {
-			shape = newShape;
-			m_wireFrameShapesMutex.unlock();
-			return;
-		}
-	}
-	m_wireframeShapes.push_back(newShape);
-	m_wireFrameShapesMutex.unlock();
+	// All wireframes draw in the depth tested pass; an xray wireframe is added twice, as it always has been
+	int numCopies = (mode == DebugRenderMode::XRAY) ? 2 : 1;
 
-	if (newShape->m_debugRenderMode == DebugRenderMode::XRAY) {
-		DebugShape* solidShape = new DebugShape(*newShape);
-		solidShape->m_debugRenderMode = DebugRenderMode::USEDEPTH;
-		AddWireShape(solidShape);
+	m_wireframeShapes.m_mutex.lock();
+	for (int copyIndex = 0; copyIndex < numCopies; copyIndex++) {
+		m_wireframeShapes.AddShape(verts.data(), (int)verts.size(), m_clock.GetTotalTime(), duration, startColor, endColor);
 	}
+	m_wireframeShapes.m_mutex.unlock();
 }
 
-void DebugRenderSystem::AddBillboard(DebugShape* newShape)
+void DebugRenderSystem::AddBillboard(std::vector<Vertex_PCU> const& verts, Vec3 const& origin, float duration, Rgba8 const& startColor, Rgba8 const& endColor)
 {
-	if (newShape->m_stopwach.m_duration == -1.0f) {
-		newShape->m_stopwach.m_duration = FLT_MAX;
-	}
-
-	m_billboardsMutex.lock();
-
-	for (int shapeIndex = 0; shapeIndex < m_billboards.size(); shapeIndex++) {
-		DebugShape*& shape = m_billboards[shapeIndex];
-		if (!shape) {
-			shape = newShape;
-			m_billboardsMutex.unlock();
-			return;
-		}
-	}
-	m_billboards.push_back(newShape);
+	m_billboards.m_mutex.lock();
+	m_billboards.AddShape(verts.data(), (int)verts.size(), m_clock.GetTotalTime(), duration, startColor, endColor, origin);
+	m_billboards.m_mutex.unlock();
+}
 
-	m_billboardsMutex.unlock();
+void DebugRenderSystem::AddScreenText(std::vector<Vertex_PCU> const& verts, std::string const& text, ScrenTextType screenTextType, float duration, Rgba8 const& startColor, Rgba8 const& endColor)
+{
+	DebugShapePool& shapePool = m_screnTextShapes[(int)screenTextType];
+	shapePool.m_mutex.lock();
+	shapePool.AddShape(verts.data(), (int)verts.size(), m_clock.GetTotalTime(), duration, startColor, endColor, Vec3::ZERO, text);
+	shapePool.m_mutex.unlock();
 }
 
 void DebugRenderSystem::SetRenderModes(DebugRenderMode renderMode) const
@@ -705,26 +478,24 @@ void DebugAddWorldPoint(const Vec3& pos, float radius, float duration, const Rgb
 	Mat44 modelMatrix;
 	modelMatrix.AppendTranslation3D(pos);
 
-	DebugShape* newShape = new DebugShape(modelMatrix, mode, duration, debugRenderSystem->GetClock(), startColor, endColor);
-	AddVertsForSphere(newShape->m_verts, radius, stacks, slices);
-	debugRenderSystem->AddShape(newShape);
+	std::vector<Vertex_PCU>& verts = GetScratchVerts();
+	AddVertsForSphere(verts, radius, stacks, slices);
+	TransformVertexArray3D((int)verts.size(), verts.data(), modelMatrix);
+	debugRenderSystem->AddShape(verts, mode, duration, startColor, endColor);
 }
 
 void DebugAddWorldLine(const Vec3& start, const Vec3& end, float radius, float duration, const Rgba8& startColor, const Rgba8& endColor, DebugRenderMode mode)
 {
-	Mat44 modelMatrix;
-	DebugShape* newShape = new DebugShape(modelMatrix, mode, duration, debugRenderSystem->GetClock(), startColor, endColor);
-	AddVertsForCylinder(newShape->m_verts, start, end, radius);
-	debugRenderSystem->AddShape(newShape);
+	std::vector<Vertex_PCU>& verts = GetScratchVerts();
+	AddVertsForCylinder(verts, start, end, radius);
+	debugRenderSystem->AddShape(verts, mode, duration, startColor, endColor);
 }
 
 void DebugAddWorldWireCylinder(const Vec3& base, const Vec3& top, float radius, float duration, const Rgba8& startColor, const Rgba8& endColor, DebugRenderMode mode)
 {
-	Mat44 modelMatrix;
-
-	DebugShape* newShape = new DebugShape(modelMatrix, mode, duration, debugRenderSystem->GetClock(), startColor, endColor);
-	AddVertsForCylinder(newShape->m_verts, base, top, radius);
-	debugRenderSystem->AddWireShape(newShape);
+	std::vector<Vertex_PCU>& verts = GetScratchVerts();
+	AddVertsForCylinder(verts, base, top, radius);
+	debugRenderSystem->AddWireShape(verts, mode, duration, startColor, endColor);
 }
 
 void DebugAddWorldWireSphere(const Vec3& center, float radius, float duration, const Rgba8& startColor, const Rgba8& endColor, DebugRenderMode mode, int stacks, int slices)
@@ -732,50 +503,44 @@ void DebugAddWorldWireSphere(const Vec3& center, float radius, float duration, c
 	Mat44 modelMatrix;
 	modelMatrix.AppendTranslation3D(center);
 
-	DebugShape* newShape = new DebugShape(modelMatrix, mode, duration, debugRenderSystem->GetClock(), startColor, endColor);
-	AddVertsForWireSphere(newShape->m_verts, radius, stacks, slices);
-	debugRenderSystem->AddWireShape(newShape);
+	std::vector<Vertex_PCU>& verts = GetScratchVerts();
+	AddVertsForWireSphere(verts, radius, stacks, slices);
+	TransformVertexArray3D((int)verts.size(), verts.data(), modelMatrix);
+	debugRenderSystem->AddWireShape(verts, mode, duration, startColor, endColor);
 }
 
 void DebugAddWorldArrow(const Vec3& start, const Vec3& end, float radius, float duration, const Rgba8& baseColor, const Rgba8& startColor, const Rgba8& endColor, DebugRenderMode mode)
 {
-	Mat44 modelMatrix;
-
-	DebugShape* newShape = new DebugShape(modelMatrix, mode, duration, debugRenderSystem->GetClock(), startColor, endColor);
-	AddVertsForArrow3D(newShape->m_verts, start, end, radius, 16, baseColor);
-	debugRenderSystem->AddShape(newShape);
+	std::vector<Vertex_PCU>& verts = GetScratchVerts();
+	AddVertsForArrow3D(verts, start, end, radius, 16, baseColor);
+	debugRenderSystem->AddShape(verts, mode, duration, startColor, endColor);
 }
 
 void DebugAddWorldBox(const AABB3& bounds, float duration, const Rgba8& startColor, const Rgba8& endColor, DebugRenderMode mode)
 {
-	Mat44 modelMatrix;
-
-	DebugShape* newShape = new DebugShape(modelMatrix, mode, duration, debugRenderSystem->GetClock(), startColor, endColor);
-	AddVertsForAABB3D(newShape->m_verts, bounds);
-	debugRenderSystem->AddShape(newShape);
+	std::vector<Vertex_PCU>& verts = GetScratchVerts();
+	AddVertsForAABB3D(verts, bounds);
+	debugRenderSystem->AddShape(verts, mode, duration, startColor, endColor);
 }
 
 void DebugAddWorldWireBox(const AABB3& bounds, float duration, const Rgba8& startColor, const Rgba8& endColor, DebugRenderMode mode)
 {
-	Mat44 modelMatrix;
-
-	DebugShape* newShape = new DebugShape(modelMatrix, mode, duration, debugRenderSystem->GetClock(), startColor, endColor);
-	AddVertsForWireAABB3D(newShape->m_verts, bounds);
-	debugRenderSystem->AddWireShape(newShape);
+	std::vector<Vertex_PCU>& verts = GetScratchVerts();
+	AddVertsForWireAABB3D(verts, bounds);
+	debugRenderSystem->AddWireShape(verts, mode, duration, startColor, endColor);
 }
 
 void DebugAddWorldBasis(const Mat44& basis, float duration, const Rgba8& startColor, const Rgba8& endColor, DebugRenderMode mode)
 {
-	Mat44 modelMatrix;
-	modelMatrix.AppendTranslation3D(basis.GetTranslation3D());
-
-	DebugShape* newShape = new DebugShape(modelMatrix, mode, duration, debugRenderSystem->GetClock(), startColor, endColor);
+	Vec3 origin = basis.GetTranslation3D();
 	float basisRadius = 0.075f;
 
-	AddVertsForArrow3D(newShape->m_verts, Vec3::ZERO, basis.GetIBasis3D(), basisRadius, 16, Rgba8::RED);
-	AddVertsForArrow3D(newShape->m_verts, Vec3::ZERO, basis.GetJBasis3D(), basisRadius, 16, Rgba8::GREEN);
-	AddVertsForArrow3D(newShape->m_verts, Vec3::ZERO, basis.GetKBasis3D(), basisRadius, 16, Rgba8::BLUE);
-	debugRenderSystem->AddShape(newShape);
+	std::vector<Vertex_PCU>& verts = GetScratchVerts();
+	verts.reserve(3 * GetVertCountForArrow3D(16));
+	AddVertsForArrow3D(verts, origin, origin + basis.GetIBasis3D(), basisRadius, 16, Rgba8::RED);
+	AddVertsForArrow3D(verts, origin, origin + basis.GetJBasis3D(), basisRadius, 16, Rgba8::GREEN);
+	AddVertsForArrow3D(verts, origin, origin + basis.GetKBasis3D(), basisRadius, 16, Rgba8::BLUE);
+	debugRenderSystem->AddShape(verts, mode, duration, startColor, endColor);
 
 }
 
@@ -785,24 +550,22 @@ void DebugAddWorldText(const std::string& text, const Mat44& transform, float te
 	AABB2 textBox;
 	textBox.SetDimensions(Vec2(font->GetTextWidth(textHeight, text), textHeight));
 
-	DebugShape* newShape = new DebugShape(transform, mode, duration, debugRenderSystem->GetClock(), startColor, endColor, &font->GetTexture());
-	newShape->m_isWorldText = true;
-	font->AddVertsForTextInBox2D(newShape->m_verts, textBox, textHeight, text, Rgba8::WHITE, 1.0f, alignment);
-	debugRenderSystem->AddShape(newShape);
+	std::vector<Vertex_PCU>& verts = GetScratchVerts();
+	font->AddVertsForTextInBox2D(verts, textBox, textHeight, text, Rgba8::WHITE, 1.0f, alignment);
+	TransformVertexArray3D((int)verts.size(), verts.data(), transform);
+	debugRenderSystem->AddShape(verts, mode, duration, startColor, endColor, true);
 }
 
 void DebugAddWorldBillboardText(const std::string& text, const Vec3& origin, float textHeight, const Vec2& alignment, float duration, const Rgba8& startColor, const Rgba8& endColor, DebugRenderMode mode)
 {
+	UNUSED(mode);
 	BitmapFont* font = debugRenderSystem->GetBitmapFont();
 	AABB2 textBox;
 	textBox.SetDimensions(Vec2(font->GetTextWidth(textHeight, text), textHeight));
 
-	Mat44 modelMatrix;
-	modelMatrix.SetTranslation3D(origin);
-
-	DebugShape* newShape = new DebugShape(modelMatrix, mode, duration, debugRenderSystem->GetClock(), startColor, endColor, &font->GetTexture());
-	font->AddVertsForTextInBox2D(newShape->m_verts, textBox, textHeight, text, Rgba8::WHITE, 1.0f, alignment);
-	debugRenderSystem->AddBillboard(newShape);
+	std::vector<Vertex_PCU>& verts = GetScratchVerts();
+	font->AddVertsForTextInBox2D(verts, textBox, textHeight, text, Rgba8::WHITE, 1.0f, alignment);
+	debugRenderSystem->AddBillboard(verts, origin, duration, startColor, endColor);
 
 }
 
@@ -813,20 +576,13 @@ void DebugAddScreenText(const std::string& text, const Vec2& position, float dur
 	textBox.m_mins = position;
 	textBox.m_maxs = Vec2(font->GetTextWidth(size, text), size) + position;
 
-	DebugShape* newShape = new DebugShape(text, ScrenTextType::FreeText, duration, debugRenderSystem->GetClock(), startColor, endColor, &font->GetTexture());
-	newShape->m_isWorldShape = false;
-	font->AddVertsForTextInBox2D(newShape->m_verts, textBox, size, text, Rgba8::WHITE, 1.0f, alignment);
-	debugRenderSystem->AddShape(newShape);
+	std::vector<Vertex_PCU>& verts = GetScratchVerts();
+	font->AddVertsForTextInBox2D(verts, textBox, size, text, Rgba8::WHITE, 1.0f, alignment);
+	debugRenderSystem->AddScreenText(verts, text, ScrenTextType::FreeText, duration, startColor, endColor);
 }
 
 void DebugAddMessage(const std::string& text, float duration, const Rgba8& startColor, const Rgba8& endColor)
 {
-	BitmapFont* font = debugRenderSystem->GetBitmapFont();
-	AABB2 textBox;
-
-	DebugShape* newShape = new DebugShape(text, ScrenTextType::ScreenMessage, duration, debugRenderSystem->GetClock(), startColor, endColor, &font->GetTexture());
-	newShape->m_isWorldShape = false;
-	debugRenderSystem->AddShape(newShape);
+	std::vector<Vertex_PCU>& verts = GetScratchVerts();
+	debugRenderSystem->AddScreenText(verts, text, ScrenTextType::ScreenMessage, duration, startColor, endColor);
 }
-
-
@@ -0,0 +1,271 @@
+#include "Engine/Renderer/DebugShapePool.hpp"
+#include <algorithm>
+#include <float.h>
+#include <iterator>
+#include <utility>
+
+// Same result as the shader multiplying the vertex color by the model color, rounded to bytes
+static void MultiplyColors(Rgba8& out_color, Rgba8 const& colorA, Rgba8 const& colorB)
+{
+	out_color.r = (unsigned char)((colorA.r * colorB.r + 127) / 255);
+	out_color.g = (unsigned char)((colorA.g * colorB.g + 127) / 255);
+	out_color.b = (unsigned char)((colorA.b * colorB.b + 127) / 255);
+	out_color.a = (unsigned char)((colorA.a * colorB.a + 127) / 255);
+}
+
+static bool DoesColorLerp(Rgba8 const& startColor, Rgba8 const& endColor, double duration)
+{
+	return !(startColor == endColor) && (duration > 0.0) && (duration < FLT_MAX);
+}
+
+// Moves the values at newOrder's indexes to firstIndex onwards, in that order
+template <typename T>
+static void ReorderValues(std::vector<T>& values, int firstIndex, std::vector<int> const& newOrder)
+{
+	std::vector<T> reorderedValues;
+	reorderedValues.reserve(newOrder.size());
+	for (int index : newOrder) {
+		reorderedValues.push_back(std::move(values[index]));
+	}
+	std::move(reorderedValues.begin(), reorderedValues.end(), values.begin() + firstIndex);
+}
+
+void DebugShapeList::Clear()
+{
+	m_expiryTimes.clear();
+	m_startTimes.clear();
+	m_durations.clear();
+	m_startColors.clear();
+	m_endColors.clear();
+	m_tints.clear();
+	m_firstVerts.clear();
+	m_numVerts.clear();
+	m_origins.clear();
+	m_texts.clear();
+	m_addOrders.clear();
+	m_verts.clear();
+	m_untintedColors.clear();
+
+	m_firstLiveShape = 0;
+	m_firstLiveVert = 0;
+}
+
+void DebugShapeList::EraseExpiredShapes()
+{
+	int numExpiredShapes = m_firstLiveShape;
+	int numExpiredVerts = m_firstLiveVert;
+
+	m_expiryTimes.erase(m_expiryTimes.begin(), m_expiryTimes.begin() + numExpiredShapes);
+	m_startTimes.erase(m_startTimes.begin(), m_startTimes.begin() + numExpiredShapes);
+	m_durations.erase(m_durations.begin(), m_durations.begin() + numExpiredShapes);
+	m_startColors.erase(m_startColors.begin(), m_startColors.begin() + numExpiredShapes);
+	m_endColors.erase(m_endColors.begin(), m_endColors.begin() + numExpiredShapes);
+	m_tints.erase(m_tints.begin(), m_tints.begin() + numExpiredShapes);
+	m_firstVerts.erase(m_firstVerts.begin(), m_firstVerts.begin() + numExpiredShapes);
+	m_numVerts.erase(m_numVerts.begin(), m_numVerts.begin() + numExpiredShapes);
+	m_origins.erase(m_origins.begin(), m_origins.begin() + numExpiredShapes);
+	m_texts.erase(m_texts.begin(), m_texts.begin() + numExpiredShapes);
+	m_addOrders.erase(m_addOrders.begin(), m_addOrders.begin() + numExpiredShapes);
+	m_verts.erase(m_verts.begin(), m_verts.begin() + numExpiredVerts);
+	m_untintedColors.erase(m_untintedColors.begin(), m_untintedColors.begin() + numExpiredVerts);
+
+	for (int shapeIndex = 0; shapeIndex < (int)m_firstVerts.size(); shapeIndex++) {
+		m_firstVerts[shapeIndex] -= numExpiredVerts;
+	}
+
+	m_firstLiveShape = 0;
+	m_firstLiveVert = 0;
+}
+
+void DebugShapeList::ReorderShapes(int firstShapeIndex, std::vector<int> const& newOrder)
+{
+	// The shapes from firstShapeIndex on own the tail of the vert array, so only that tail is rewritten
+	int firstVert = m_firstVerts[firstShapeIndex];
+	std::vector<Vertex_PCU> reorderedVerts;
+	std::vector<Rgba8> reorderedColors;
+	reorderedVerts.reserve(m_verts.size() - firstVert);
+	reorderedColors.reserve(m_verts.size() - firstVert);
+	for (int shapeIndex : newOrder) {
+		int shapeFirstVert = m_firstVerts[shapeIndex];
+		int shapeEndVert = shapeFirstVert + m_numVerts[shapeIndex];
+		reorderedVerts.insert(reorderedVerts.end(), m_verts.begin() + shapeFirstVert, m_verts.begin() + shapeEndVert);
+		reorderedColors.insert(reorderedColors.end(), m_untintedColors.begin() + shapeFirstVert, m_untintedColors.begin() + shapeEndVert);
+	}
+	std::copy(reorderedVerts.begin(), reorderedVerts.end(), m_verts.begin() + firstVert);
+	std::copy(reorderedColors.begin(), reorderedColors.end(), m_untintedColors.begin() + firstVert);
+
+	ReorderValues(m_expiryTimes, firstShapeIndex, newOrder);
+	ReorderValues(m_startTimes, firstShapeIndex, newOrder);
+	ReorderValues(m_durations, firstShapeIndex, newOrder);
+	ReorderValues(m_startColors, firstShapeIndex, newOrder);
+	ReorderValues(m_endColors, firstShapeIndex, newOrder);
+	ReorderValues(m_tints, firstShapeIndex, newOrder);
+	ReorderValues(m_numVerts, firstShapeIndex, newOrder);
+	ReorderValues(m_origins, firstShapeIndex, newOrder);
+	ReorderValues(m_texts, firstShapeIndex, newOrder);
+	ReorderValues(m_addOrders, firstShapeIndex, newOrder);
+
+	int shapeFirstVert = firstVert;
+	for (int shapeIndex = firstShapeIndex; shapeIndex < (int)m_firstVerts.size(); shapeIndex++) {
+		m_firstVerts[shapeIndex] = shapeFirstVert;
+		shapeFirstVert += m_numVerts[shapeIndex];
+	}
+}
+
+void DebugShapePool::AddShape(Vertex_PCU const* verts, int numVerts, double startTime, double duration, Rgba8 const& startColor, Rgba8 const& endColor, Vec3 const& origin, std::string const& text)
+{
+	bool isPersistent = (duration < 0.0);
+	if (isPersistent) duration = FLT_MAX;
+	double expiryTime = startTime + duration;
+
+	DebugShapeList& shapes = (isPersistent) ? m_persistentShapes : m_timedShapes;
+	int shapeIndex = (int)shapes.m_expiryTimes.size();
+	if (!isPersistent && (m_firstUnsortedShape == -1) && (shapeIndex > 0) && (expiryTime < shapes.m_expiryTimes.back())) {
+		m_firstUnsortedShape = shapeIndex;
+	}
+
+	shapes.m_expiryTimes.push_back(expiryTime);
+	shapes.m_startTimes.push_back(startTime);
+	shapes.m_durations.push_back(duration);
+	shapes.m_startColors.push_back(startColor);
+	shapes.m_endColors.push_back(endColor);
+	shapes.m_tints.push_back(startColor);
+	shapes.m_firstVerts.push_back((int)shapes.m_verts.size());
+	shapes.m_numVerts.push_back(numVerts);
+	shapes.m_origins.push_back(origin);
+	shapes.m_texts.push_back(text);
+	shapes.m_addOrders.push_back(m_numShapesAdded);
+	m_numShapesAdded++;
+
+	if (DoesColorLerp(startColor, endColor, duration)) {
+		m_numLerpingShapes++;
+	}
+
+	int firstVert = shapes.m_firstVerts[shapeIndex];
+	shapes.m_verts.insert(shapes.m_verts.end(), verts, verts + numVerts);
+	shapes.m_untintedColors.resize(shapes.m_verts.size());
+
+	Vertex_PCU* shapeVerts = shapes.m_verts.data() + firstVert;
+	Rgba8* untintedColors = shapes.m_untintedColors.data() + firstVert;
+	bool isTinted = !(startColor == Rgba8::WHITE);
+	for (int vertIndex = 0; vertIndex < numVerts; vertIndex++) {
+		untintedColors[vertIndex] = shapeVerts[vertIndex].m_color;
+		if (isTinted) {
+			MultiplyColors(shapeVerts[vertIndex].m_color, untintedColors[vertIndex], startColor);
+		}
+	}
+}
+
+void DebugShapePool::RemoveExpiredShapes(double currentTime)
+{
+	if (m_firstUnsortedShape != -1) {
+		SortByExpiryTime();
+	}
+
+	// Expired shapes are a prefix. A zero duration shape has expired by the end of the frame it was added in
+	DebugShapeList& shapes = m_timedShapes;
+	int endShapeIndex = (int)shapes.m_expiryTimes.size();
+	int newFirstLiveShape = (int)(std::upper_bound(shapes.m_expiryTimes.begin() + shapes.m_firstLiveShape, shapes.m_expiryTimes.end(), currentTime) - shapes.m_expiryTimes.begin());
+	for (int shapeIndex = shapes.m_firstLiveShape; shapeIndex < newFirstLiveShape; shapeIndex++) {
+		if (DoesColorLerp(shapes.m_startColors[shapeIndex], shapes.m_endColors[shapeIndex], shapes.m_durations[shapeIndex])) {
+			m_numLerpingShapes--;
+		}
+	}
+
+	shapes.m_firstLiveShape = newFirstLiveShape;
+	shapes.m_firstLiveVert = (shapes.m_firstLiveShape < endShapeIndex) ? shapes.m_firstVerts[shapes.m_firstLiveShape] : (int)shapes.m_verts.size();
+
+	if (shapes.m_firstLiveShape == endShapeIndex) {
+		shapes.Clear();
+	}
+	else if (shapes.m_firstLiveShape > (endShapeIndex - shapes.m_firstLiveShape)) {
+		// Compacts once the dead prefix outgrows the live shapes, so each shape is moved a bounded number of times
+		shapes.EraseExpiredShapes();
+	}
+}
+
+void DebugShapePool::UpdateColors(double currentTime)
+{
+	// Persistent shapes never lerp, their duration is infinite
+	if (m_numLerpingShapes == 0) return;
+
+	DebugShapeList& shapes = m_timedShapes;
+	int endShapeIndex = (int)shapes.m_expiryTimes.size();
+	for (int shapeIndex = shapes.m_firstLiveShape; shapeIndex < endShapeIndex; shapeIndex++) {
+		Rgba8 tint = GetTintAtTime(shapeIndex, currentTime);
+		if (tint == shapes.m_tints[shapeIndex]) continue;
+
+		shapes.m_tints[shapeIndex] = tint;
+		int firstVert = shapes.m_firstVerts[shapeIndex];
+		int endVert = firstVert + shapes.m_numVerts[shapeIndex];
+		for (int vertIndex = firstVert; vertIndex < endVert; vertIndex++) {
+			MultiplyColors(shapes.m_verts[vertIndex].m_color, shapes.m_untintedColors[vertIndex], tint);
+		}
+	}
+}
+
+void DebugShapePool::Clear()
+{
+	m_timedShapes.Clear();
+	m_persistentShapes.Clear();
+
+	m_numLerpingShapes = 0;
+	m_firstUnsortedShape = -1;
+}
+
+int DebugShapePool::GetNumShapes() const
+{
+	return m_timedShapes.GetNumShapes() + m_persistentShapes.GetNumShapes();
+}
+
+int DebugShapePool::GetNumVerts() const
+{
+	return m_timedShapes.GetNumVerts() + m_persistentShapes.GetNumVerts();
+}
+
+void DebugShapePool::SortByExpiryTime()
+{
+	// Only the shapes added out of order are sorted. They are then merged into the sorted shapes they overlap; the sorted
+	// shapes expiring before all of them stay where they are
+	DebugShapeList& shapes = m_timedShapes;
+	std::vector<double> const& expiryTimes = shapes.m_expiryTimes;
+	struct ExpiryTimeLess {
+		std::vector<double> const& m_times;
+		bool operator()(int shapeA, int shapeB) const { return m_times[shapeA] < m_times[shapeB]; }
+	};
+	ExpiryTimeLess isExpiringSooner{ expiryTimes };
+
+	int endShapeIndex = (int)expiryTimes.size();
+	std::vector<int> unsortedShapes;
+	unsortedShapes.reserve(endShapeIndex - m_firstUnsortedShape);
+	for (int shapeIndex = m_firstUnsortedShape; shapeIndex < endShapeIndex; shapeIndex++) {
+		unsortedShapes.push_back(shapeIndex);
+	}
+	std::stable_sort(unsortedShapes.begin(), unsortedShapes.end(), isExpiringSooner);
+
+	double earliestExpiryTime = expiryTimes[unsortedShapes[0]];
+	int firstMovedShape = (int)(std::upper_bound(expiryTimes.begin() + shapes.m_firstLiveShape, expiryTimes.begin() + m_firstUnsortedShape, earliestExpiryTime) - expiryTimes.begin());
+	std::vector<int> sortedShapes;
+	sortedShapes.reserve(m_firstUnsortedShape - firstMovedShape);
+	for (int shapeIndex = firstMovedShape; shapeIndex < m_firstUnsortedShape; shapeIndex++) {
+		sortedShapes.push_back(shapeIndex);
+	}
+
+	// Ties keep the sorted shapes first, so shapes with the same expiry time stay in the order they were added
+	std::vector<int> newOrder;
+	newOrder.reserve(endShapeIndex - firstMovedShape);
+	std::merge(sortedShapes.begin(), sortedShapes.end(), unsortedShapes.begin(), unsortedShapes.end(), std::back_inserter(newOrder), isExpiringSooner);
+	shapes.ReorderShapes(firstMovedShape, newOrder);
+
+	m_firstUnsortedShape = -1;
+}
+
+Rgba8 const DebugShapePool::GetTintAtTime(int shapeIndex, double currentTime) const
+{
+	DebugShapeList const& shapes = m_timedShapes;
+	double duration = shapes.m_durations[shapeIndex];
+	if ((duration == 0.0) || (duration >= FLT_MAX)) return shapes.m_startColors[shapeIndex];
+
+	float elapsedFraction = (float)((currentTime - shapes.m_startTimes[shapeIndex]) / duration);
+	return Rgba8::InterpolateColors(shapes.m_startColors[shapeIndex], shapes.m_endColors[shapeIndex], elapsedFraction);
+}
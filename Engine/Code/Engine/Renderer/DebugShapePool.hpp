@@ -0,0 +1,99 @@
+#pragma once
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class ScrenTextType {
+	ScreenMessage,
+	FreeText,
+	NUM_SCREEN_TEXT_TYPES
+};
+
+enum class DebugShapeLifetime {
+	TIMED,			// Kept sorted by expiry time
+	PERSISTENT,		// Negative durations. Never expire, so they stay in the order they were added until cleared
+	NUM_DEBUG_SHAPE_LIFETIMES
+};
+
+// Shapes of one lifetime, stored as parallel arrays. Their verts live back to back in one array, already in world space.
+// Shapes before the first live index have expired and are waiting to be compacted away
+class DebugShapeList {
+	friend class DebugShapePool;
+public:
+	int GetNumShapes() const { return (int)m_expiryTimes.size() - m_firstLiveShape; }
+	int GetFirstShapeIndex() const { return m_firstLiveShape; }
+	int GetEndShapeIndex() const { return (int)m_expiryTimes.size(); }
+	int GetNumVerts() const { return (int)m_verts.size() - m_firstLiveVert; }
+	Vertex_PCU const* GetVerts() const { return m_verts.data() + m_firstLiveVert; }
+
+	Vertex_PCU const* GetShapeVerts(int shapeIndex) const { return m_verts.data() + m_firstVerts[shapeIndex]; }
+	int GetShapeNumVerts(int shapeIndex) const { return m_numVerts[shapeIndex]; }
+	Vec3 const& GetShapeOrigin(int shapeIndex) const { return m_origins[shapeIndex]; }
+	std::string const& GetShapeText(int shapeIndex) const { return m_texts[shapeIndex]; }
+	Rgba8 const& GetShapeTint(int shapeIndex) const { return m_tints[shapeIndex]; }
+	uint64_t GetShapeAddOrder(int shapeIndex) const { return m_addOrders[shapeIndex]; }
+
+private:
+	void Clear();
+	void EraseExpiredShapes();
+	void ReorderShapes(int firstShapeIndex, std::vector<int> const& newOrder);
+
+private:
+	std::vector<double> m_expiryTimes;
+	std::vector<double> m_startTimes;
+	std::vector<double> m_durations;
+	std::vector<Rgba8> m_startColors;
+	std::vector<Rgba8> m_endColors;
+	std::vector<Rgba8> m_tints;				// Tint currently baked into the shape's verts
+	std::vector<int> m_firstVerts;
+	std::vector<int> m_numVerts;
+	std::vector<Vec3> m_origins;			// Billboard anchors
+	std::vector<std::string> m_texts;		// Screen messages, laid out when drawn
+	std::vector<uint64_t> m_addOrders;		// Position among every shape added to the pool, for callers that draw in add order
+
+	std::vector<Vertex_PCU> m_verts;
+	std::vector<Rgba8> m_untintedColors;	// One per vert
+
+	int m_firstLiveShape = 0;
+	int m_firstLiveVert = 0;
+};
+
+// Debug shapes of one kind and render mode. Timed and persistent shapes are kept in separate lists, so each list is drawn
+// with a single call. Timed shapes are kept sorted by expiry time: the expired ones are always a prefix and are dropped in
+// bulk by moving the first live index. Persistent shapes never expire and are never sorted
+class DebugShapePool {
+public:
+	DebugShapePool() = default;
+	~DebugShapePool() = default;
+
+	// A negative duration lives until cleared; a duration of 0 is drawn once
+	void AddShape(Vertex_PCU const* verts, int numVerts, double startTime, double duration, Rgba8 const& startColor, Rgba8 const& endColor,
+		Vec3 const& origin = Vec3::ZERO, std::string const& text = "");
+	void RemoveExpiredShapes(double currentTime);
+	// Retints only the verts of shapes whose color lerps, from the untinted vertex colors kept at add time
+	void UpdateColors(double currentTime);
+	void Clear();
+
+	int GetNumShapes() const;
+	int GetNumVerts() const;
+	DebugShapeList const& GetShapeList(DebugShapeLifetime lifetime) const { return (lifetime == DebugShapeLifetime::PERSISTENT) ? m_persistentShapes : m_timedShapes; }
+
+public:
+	mutable std::mutex m_mutex;
+
+private:
+	void SortByExpiryTime();
+	Rgba8 const GetTintAtTime(int shapeIndex, double currentTime) const;
+
+private:
+	DebugShapeList m_timedShapes;
+	DebugShapeList m_persistentShapes;
+
+	uint64_t m_numShapesAdded = 0;
+	int m_numLerpingShapes = 0;
+	int m_firstUnsortedShape = -1;	// Timed shapes from here on were added out of expiry order, -1 while sorted
+};
@@ -336,10 +336,8 @@ void MeshBuilder::Transform(Mat44 const& newTransform)
 {
 	m_importOptions.m_transform.Append(newTransform);
 
-	for (int vertexIndex = 0; vertexIndex < m_vertexes.size(); vertexIndex++) {
-		Vertex_PNCU& vertex = m_vertexes[vertexIndex];
-		vertex.m_position = newTransform.TransformPosition3D(vertex.m_position);
-	}
+	if (m_vertexes.empty()) return;
+	TransformVertexArray3D((int)m_vertexes.size(), m_vertexes.data(), newTransform);
 
 }
 
@@ -57,6 +57,13 @@ void App::Startup()
 	g_gameConfigBlackboard.SetValue("TEXT_CELL_HEIGHT", std::to_string(TEXT_CELL_HEIGHT));
 	g_gameConfigBlackboard.SetValue("TEXT_CELL_HEIGHT_ATTRACT_SCREEN", std::to_string(TEXT_CELL_HEIGHT_ATTRACT_SCREEN));
 
+	int workerThreadCount = (int)std::thread::hardware_concurrency() - 1; // The main thread steps a batch of the CPU hair solver itself
+	JobSystemConfig jobSystemConfig{
+	(workerThreadCount > 1) ? workerThreadCount : 1
+	};
+
+	g_theJobSystem = new JobSystem(jobSystemConfig);
+
 	EventSystemConfig eventSystemConfig;
 	g_theEventSystem = new EventSystem(eventSystemConfig);
 
@@ -85,6 +92,7 @@ void App::Startup()
 
 	g_theGame = new Game(this);
 
+	g_theJobSystem->Startup();
 	g_theEventSystem->Startup();
 	g_theInput->Startup();
 	g_theWindow->Startup();
@@ -168,6 +176,10 @@ void App::Shutdown()
 	delete g_theGame;
 	g_theGame = nullptr;
 
+	g_theJobSystem->Shutdown();
+	delete g_theJobSystem;
+	g_theJobSystem = nullptr;
+
 	g_theAudio->Shutdown();
 	delete g_theAudio;
 	g_theAudio = nullptr;
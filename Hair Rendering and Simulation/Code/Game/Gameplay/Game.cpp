@@ -12,6 +12,7 @@
 #include "Game/Gameplay/HairDisc.hpp"
 #include "Game/Gameplay/HairSphere.hpp"
 #include "Game/Gameplay/HairCollision.hpp"
+#include "Game/Gameplay/HairStrandSolver.hpp"
 #include "ThirdParty/ImGUI/imgui.h"
 #include "ThirdParty/ImGUI/imgui_impl_dx11.h"
 #include "ThirdParty/Squirrel/SmoothNoise.hpp"
@@ -569,6 +570,33 @@ void Game::StartupHairSimulation()
 	m_CPUSimulObject = new HairSimulGuide(initialParams); // If stiffness is too high, simulation kind of explodes. This is a good empirical value
 	DebugAddWorldBillboardText("Simulated CPU", m_CPUSimulObject->m_positions[0] + Vec3(0.0, 0.0f, 1.0f), 0.20f, Vec2(0.5f, 0.5f), -1.0f, Rgba8::WHITE, Rgba8::WHITE, DebugRenderMode::USEDEPTH);
 
+	// A full head on the batched CPU solver, roots spread over the top half of a sphere with the golden angle
+	int strandSolverCount = g_gameConfigBlackboard.GetValue("CPU_SOLVER_STRAND_COUNT", 4096);
+	float strandSolverHeadRadius = g_gameConfigBlackboard.GetValue("CPU_SOLVER_HEAD_RADIUS", 1.0f);
+	Vec3 headCenter = hairPos + Vec3(0.0f, -4.0f, 0.0f);
+
+	// Zero strands turns the batched solver off altogether
+	if (strandSolverCount > 0) {
+		std::vector<Vec3> rootPositions;
+		std::vector<Vec3> rootNormals;
+		rootPositions.reserve(strandSolverCount);
+		rootNormals.reserve(strandSolverCount);
+		for (int strandIndex = 0; strandIndex < strandSolverCount; strandIndex++) {
+			float normalZ = 1.0f - ((static_cast<float>(strandIndex) + 0.5f) / static_cast<float>(strandSolverCount));
+			float ringRadius = sqrtf(1.0f - (normalZ * normalZ));
+			float yawDegrees = static_cast<float>(strandIndex) * 137.50776f;
+
+			Vec3 rootNormal(CosDegrees(yawDegrees) * ringRadius, SinDegrees(yawDegrees) * ringRadius, normalZ);
+			rootPositions.push_back(headCenter + rootNormal * strandSolverHeadRadius);
+			rootNormals.push_back(rootNormal);
+		}
+
+		m_CPUStrandSolver = new HairStrandSolver(initialParams, rootPositions, rootNormals);
+		m_CPUStrandSolver->SetGrid(currentConstants->GridDimensions, currentConstants->GridCellWidth, currentConstants->GridCellHeight, headCenter);
+		m_CPUStrandSolver->AddCollisionSphere(headCenter, strandSolverHeadRadius);
+		DebugAddWorldBillboardText("Simulated CPU (Batched)", headCenter + Vec3(0.0, 0.0f, strandSolverHeadRadius + 1.0f), 0.20f, Vec2(0.5f, 0.5f), -1.0f, Rgba8::WHITE, Rgba8::WHITE, DebugRenderMode::USEDEPTH);
+	}
+
 	Light& firstLight = imGuiSettings.m_sceneLights[0];
 	firstLight.Enabled = true;
 	Rgba8::WHITE.GetAsFloats(firstLight.Color);
@@ -764,6 +792,9 @@ void Game::ShutdownHairSimulation()
 	delete m_CPUSimulObject;
 	m_CPUSimulObject = nullptr;
 
+	delete m_CPUStrandSolver;
+	m_CPUStrandSolver = nullptr;
+
 }
 
 void Game::UpdateGameState()
@@ -871,10 +902,28 @@ void Game::UpdateHairSimulation(float deltaSeconds)
 	m_CPUSimulObject->m_hairSimulationInitParams.isCurlyHair = currentConstants->IsHairCurly;
 	m_CPUSimulObject->m_gravity = currentConstants->Gravity;
 
-
+	float strandSolverMs = 0.0f;
+	if (IsCPUStrandSolverRunning()) {
+		double strandSolverStartTime = GetCurrentTimeSeconds();
+		m_CPUStrandSolver->AddForce(Vec3(0.0f, 0.0f, -9.8f));
+		m_CPUStrandSolver->Update(deltaSeconds);
+		strandSolverMs = static_cast<float>((GetCurrentTimeSeconds() - strandSolverStartTime) * 1000.0);
+		m_CPUStrandSolver->SetSimulationAlgorithm((SimulAlgorithm)currentConstants->SimulationAlgorithm, currentConstants->IsHairCurly);
+		m_CPUStrandSolver->SetSpringLengths(HairGuide::HairSegmentLength, currentConstants->BendInitialLength, currentConstants->TorsionInitialLength);
+		m_CPUStrandSolver->SetSpringStiffness(currentConstants->EdgeStiffness, currentConstants->BendStiffness, currentConstants->TorsionStiffness);
+		m_CPUStrandSolver->m_gravity = currentConstants->Gravity;
+		m_CPUStrandSolver->m_frictionCoefficient = currentConstants->FrictionCoefficient;
+		m_CPUStrandSolver->m_collisionTolerance = currentConstants->CollisionTolerance;
+	}
 
 
 	DebugAddMessage(Stringf("Mode: Hair Simulation"), 0.0f, Rgba8::BLUE, Rgba8::BLUE);
+	if (IsCPUStrandSolverRunning()) {
+		DebugAddMessage(Stringf("CPU Strands: %d, Batches: %d, Solver: %.2f ms (V to turn off)", m_CPUStrandSolver->GetStrandCount(), m_CPUStrandSolver->GetBatchCount(), strandSolverMs), 0.0f, Rgba8::WHITE, Rgba8::WHITE);
+	}
+	else if (m_CPUStrandSolver) {
+		DebugAddMessage("CPU Strands: off (V to turn on)", 0.0f, Rgba8::WHITE, Rgba8::WHITE);
+	}
 	DebugAddMessage("Press B to add wind (dependent on distance to object)", 0.0f, Rgba8::WHITE, Rgba8::WHITE);
 	DisplayClocksInfo();
 }
@@ -889,6 +938,10 @@ void Game::UpdateInputHairSimulation(float deltaSeconds)
 		m_nextState = GameState::AttractScreen;
 	}
 
+	if (g_theInput->WasKeyJustPressed('V')) {
+		m_isCPUStrandSolverEnabled = !m_isCPUStrandSolverEnabled;
+	}
+
 	if (g_theInput->IsKeyDown('B')) {
 		Vec3 dispToObject = m_CPUSimulObject->m_positions[0] - m_player->m_position;
 		float distToObject = dispToObject.GetLength();
@@ -897,6 +950,9 @@ void Game::UpdateInputHairSimulation(float deltaSeconds)
 
 		Vec3 force = dispToObject.GetNormalized() * forceMultiplier;
 		m_CPUSimulObject->AddForce(force);
+		if (IsCPUStrandSolverRunning()) {
+			m_CPUStrandSolver->AddForce(force);
+		}
 
 		currentConstants->ExternalForces += force;
 	}
@@ -908,6 +964,9 @@ void Game::UpdateInputHairSimulation(float deltaSeconds)
 
 		Vec3 force = Vec3(0.0f, 0.0f, 1.0f) * forceMultiplier;
 		m_CPUSimulObject->AddForce(force);
+		if (IsCPUStrandSolverRunning()) {
+			m_CPUStrandSolver->AddForce(force);
+		}
 
 		currentConstants->ExternalForces += force;
 	}
@@ -1905,6 +1964,9 @@ void Game::RenderHairSimulation() const
 
 	std::vector<Vertex_PNCU> simulTest;
 	m_CPUSimulObject->AddVerts(simulTest);
+	if (IsCPUStrandSolverRunning()) {
+		m_CPUStrandSolver->AddVerts(simulTest);
+	}
 
 	g_theRenderer->BindShader(m_diffuseMarschnerCPUSim);
 
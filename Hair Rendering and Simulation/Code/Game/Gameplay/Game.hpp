@@ -18,6 +18,7 @@ class App;
 class Player;
 class HairObject;
 class HairSimulGuide;	
+class HairStrandSolver;
 class Shader;
 class UnorderedAccessBuffer;
 class MeshBuilder;
@@ -122,6 +123,7 @@ private:
 
 	void UpdateHairSimulation(float deltaSeconds);
 	void UpdateInputHairSimulation(float deltaSeconds);
+	bool IsCPUStrandSolverRunning() const { return m_CPUStrandSolver && m_isCPUStrandSolverEnabled; }
 
 	void UpdateHairTessellation(float deltaSeconds);
 	void UpdateHairTessellationInput(float deltaSeconds);
@@ -285,6 +287,8 @@ private:
 	SSAOConstants* m_prevSSAO = nullptr;
 
 	HairSimulGuide* m_CPUSimulObject = nullptr;
+	HairStrandSolver* m_CPUStrandSolver = nullptr; // Not created when CPU_SOLVER_STRAND_COUNT is 0
+	bool m_isCPUStrandSolverEnabled = g_gameConfigBlackboard.GetValue("CPU_SOLVER_ENABLED", true); // V toggles it, the strands keep their state while off
 
 	bool m_areSSAOKernelsDirty = true;
 	UnorderedAccessBuffer* m_SSAOKernels = nullptr;
@@ -0,0 +1,887 @@
+#include "Game/Gameplay/HairStrandSolver.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Vertex_PNCU.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/SIMDUtils.hpp"
+
+// x, y and z of one Vec3 for HAIR_STRAND_LANES consecutive strands
+struct StrandLanes {
+	__m128 x;
+	__m128 y;
+	__m128 z;
+};
+
+// What GetSpringForce needs from a spring that doesn't change along the strand
+struct StrandSpring {
+	__m128 m_stiffnessOverLength;
+	__m128 m_velocityCoefficient;
+};
+
+static inline StrandLanes SplatLanes(Vec3 const& value)
+{
+	return StrandLanes{ _mm_set1_ps(value.x), _mm_set1_ps(value.y), _mm_set1_ps(value.z) };
+}
+
+static inline StrandLanes AddLanes(StrandLanes const& a, StrandLanes const& b)
+{
+	return StrandLanes{ _mm_add_ps(a.x, b.x), _mm_add_ps(a.y, b.y), _mm_add_ps(a.z, b.z) };
+}
+
+static inline StrandLanes SubtractLanes(StrandLanes const& a, StrandLanes const& b)
+{
+	return StrandLanes{ _mm_sub_ps(a.x, b.x), _mm_sub_ps(a.y, b.y), _mm_sub_ps(a.z, b.z) };
+}
+
+static inline StrandLanes ScaleLanes(StrandLanes const& a, __m128 const& scale)
+{
+	return StrandLanes{ _mm_mul_ps(a.x, scale), _mm_mul_ps(a.y, scale), _mm_mul_ps(a.z, scale) };
+}
+
+static inline StrandLanes DivideLanes(StrandLanes const& a, __m128 const& divisor)
+{
+	return StrandLanes{ _mm_div_ps(a.x, divisor), _mm_div_ps(a.y, divisor), _mm_div_ps(a.z, divisor) };
+}
+
+static inline __m128 DotLanes(StrandLanes const& a, StrandLanes const& b)
+{
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z));
+}
+
+static inline StrandLanes SelectLanes(__m128 const& mask, StrandLanes const& ifTrue, StrandLanes const& ifFalse)
+{
+	return StrandLanes{
+		_mm_or_ps(_mm_and_ps(mask, ifTrue.x), _mm_andnot_ps(mask, ifFalse.x)),
+		_mm_or_ps(_mm_and_ps(mask, ifTrue.y), _mm_andnot_ps(mask, ifFalse.y)),
+		_mm_or_ps(_mm_and_ps(mask, ifTrue.z), _mm_andnot_ps(mask, ifFalse.z))
+	};
+}
+
+// Same as HairSimulGuide::GetSpringForce, Vec3::GetNormalized included: zero displacements give a zero direction
+static inline StrandLanes GetSpringForceLanes(StrandLanes const& displacement, StrandLanes const& velocityDelta, StrandSpring const& spring, __m128 const& segmentLength)
+{
+	__m128 length = _mm_sqrt_ps(DotLanes(displacement, displacement));
+	__m128 isNonZero = _mm_cmpneq_ps(length, _mm_setzero_ps());
+	StrandLanes dir = SelectLanes(isNonZero, DivideLanes(displacement, length), StrandLanes{ _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() });
+
+	__m128 firstTermCoeff = _mm_mul_ps(_mm_sub_ps(DotLanes(displacement, dir), segmentLength), spring.m_stiffnessOverLength);
+	StrandLanes firstTerm = ScaleLanes(dir, firstTermCoeff);
+	StrandLanes secondTerm = ScaleLanes(ScaleLanes(dir, DotLanes(velocityDelta, dir)), spring.m_velocityCoefficient);
+	return AddLanes(firstTerm, secondTerm);
+}
+
+// Lowest of the 8 grid cells around each lane's position, and how far past it the position is along each axis. Lanes whose
+// 8 cells don't all fit in the grid are left out of m_validLanes
+struct TrilinearLanes {
+	int m_cellCoords[3][HAIR_STRAND_LANES];
+	int m_cellIndexes[HAIR_STRAND_LANES];
+	float m_fractions[3][HAIR_STRAND_LANES];
+	int m_validLanes = 0;
+};
+
+// Weight of the lower and upper cell along each axis
+static inline void GetTrilinearWeights(TrilinearLanes const& trilinear, int laneIndex, float out_weights[3][2])
+{
+	for (int axis = 0; axis < 3; axis++) {
+		out_weights[axis][1] = trilinear.m_fractions[axis][laneIndex];
+		out_weights[axis][0] = 1.0f - out_weights[axis][1];
+	}
+}
+
+static inline __m128 SelectMinLane(__m128 const& lanes)
+{
+	__m128 minLanes = _mm_min_ps(lanes, SIMD_SWIZZLE(lanes, 2, 3, 0, 1));
+	return _mm_min_ps(minLanes, SIMD_SWIZZLE(minLanes, 1, 0, 3, 2));
+}
+
+static inline __m128 SelectMaxLane(__m128 const& lanes)
+{
+	__m128 maxLanes = _mm_max_ps(lanes, SIMD_SWIZZLE(lanes, 2, 3, 0, 1));
+	return _mm_max_ps(maxLanes, SIMD_SWIZZLE(maxLanes, 1, 0, 3, 2));
+}
+
+static inline void AddToSplatBounds(HairGridSplat& splat, IntVec3 const& mins, IntVec3 const& maxs)
+{
+	if (splat.m_isEmpty) {
+		splat.m_mins = mins;
+		splat.m_maxs = maxs;
+		splat.m_isEmpty = false;
+		return;
+	}
+
+	splat.m_mins = IntVec3((mins.x < splat.m_mins.x) ? mins.x : splat.m_mins.x, (mins.y < splat.m_mins.y) ? mins.y : splat.m_mins.y, (mins.z < splat.m_mins.z) ? mins.z : splat.m_mins.z);
+	splat.m_maxs = IntVec3((maxs.x > splat.m_maxs.x) ? maxs.x : splat.m_maxs.x, (maxs.y > splat.m_maxs.y) ? maxs.y : splat.m_maxs.y, (maxs.z > splat.m_maxs.z) ? maxs.z : splat.m_maxs.z);
+}
+
+static inline StrandSpring MakeStrandSpring(float deltaSeconds, float stiffness, float initialLength, float segmentLength, float damping)
+{
+	return StrandSpring{ _mm_set1_ps(stiffness / initialLength), _mm_set1_ps(deltaSeconds * stiffness / (segmentLength + damping)) };
+}
+
+void HairStrandBatchJob::Execute()
+{
+	m_solver->ExecutePass(m_pass, m_jobIndex, m_firstStrand, m_strandCount, m_deltaSeconds);
+}
+
+void HairStrandBatchJob::OnFinished()
+{
+}
+
+HairStrandSolver::HairStrandSolver(HairSimulationInit const& simulationParams, std::vector<Vec3> const& rootPositions, std::vector<Vec3> const& rootNormals) :
+	m_simulationParams(simulationParams),
+	m_strandCount((int)rootPositions.size()),
+	m_segmentCount(simulationParams.segmentCount)
+{
+	GUARANTEE_OR_DIE(rootPositions.size() == rootNormals.size(), "HAIR STRAND SOLVER NEEDS ONE NORMAL PER ROOT");
+	GUARANTEE_OR_DIE(m_strandCount > 0, "HAIR STRAND SOLVER NEEDS AT LEAST ONE STRAND");
+
+	m_paddedStrandCount = ((m_strandCount + HAIR_STRAND_LANES - 1) / HAIR_STRAND_LANES) * HAIR_STRAND_LANES;
+	m_groupStride = (int)HairStrandChannel::NUM_CHANNELS * 3 * m_segmentCount * HAIR_STRAND_LANES;
+	m_buffer.resize((size_t)(m_paddedStrandCount / HAIR_STRAND_LANES) * m_groupStride, 0.0f);
+
+	m_segmentLength = HairGuide::HairSegmentLength;
+	m_bendInitialLength = sqrtf(m_segmentLength * m_segmentLength * 2);
+	m_torsionInitialLength = m_bendInitialLength * 2.0f;
+
+	// Padding strands copy the last root, so every lane holds a valid strand and no lane needs masking
+	for (int strandIndex = 0; strandIndex < m_paddedStrandCount; strandIndex++) {
+		int rootIndex = (strandIndex < m_strandCount) ? strandIndex : m_strandCount - 1;
+		Vec3 const& rootNormal = rootNormals[rootIndex];
+
+		Vec3 position = rootPositions[rootIndex];
+		for (int segmentIndex = 0; segmentIndex < m_segmentCount; segmentIndex++) {
+			SetStrandValue(HairStrandChannel::POSITION, strandIndex, segmentIndex, position);
+			SetStrandValue(HairStrandChannel::PREV_POSITION, strandIndex, segmentIndex, position);
+			position += m_segmentLength * rootNormal;
+		}
+
+		for (int particleIndex = 0; particleIndex < (m_segmentCount - 1); particleIndex++) {
+			Vec3 posOne = GetPosition(strandIndex, particleIndex);
+			Vec3 posTwo = GetPosition(strandIndex, particleIndex + 1);
+
+			Mat44 orthoBasis = GetOrthonormalBasis(posTwo - posOne);
+			Vec3 particlePos = (posTwo + posOne) * 0.5f;
+			particlePos += orthoBasis.GetKBasis3D().GetNormalized() * m_segmentLength;
+
+			SetStrandValue(HairStrandChannel::VIRTUAL_POSITION, strandIndex, particleIndex, particlePos);
+			SetStrandValue(HairStrandChannel::VIRTUAL_PREV_POSITION, strandIndex, particleIndex, particlePos);
+		}
+	}
+}
+
+void HairStrandSolver::Update(float deltaSeconds)
+{
+	m_stepForce = m_genForce + Vec3(0.0f, 0.0f, m_gravity);
+
+	RunPass(HairStrandPass::STEP, HAIR_STRANDS_PER_BATCH, deltaSeconds);
+
+	if (IsGridEnabled()) {
+		// One splat per thread that can run at once, each over a contiguous run of groups
+		int maxSplats = (g_theJobSystem) ? g_theJobSystem->GetNumThreads() + 1 : 1;
+		int splatCount = (GetBatchCount() < maxSplats) ? GetBatchCount() : maxSplats;
+		int groupCount = m_paddedStrandCount / HAIR_STRAND_LANES;
+		int strandsPerSplat = ((groupCount + splatCount - 1) / splatCount) * HAIR_STRAND_LANES;
+		splatCount = (m_paddedStrandCount + strandsPerSplat - 1) / strandsPerSplat;
+
+		while ((int)m_gridSplats.size() < splatCount) {
+			m_gridSplats.emplace_back();
+			m_gridSplats.back().m_cells.resize(m_grid.m_cells.size());
+		}
+
+		RunPass(HairStrandPass::SPLAT, strandsPerSplat, deltaSeconds);
+		ReduceSplats(splatCount);
+	}
+
+	if ((IsGridEnabled() || !m_collisionObjects.empty()) && (deltaSeconds > 0.0f)) {
+		RunPass(HairStrandPass::RESOLVE, HAIR_STRANDS_PER_BATCH, deltaSeconds);
+	}
+
+	m_genForce = Vec3::ZERO;
+}
+
+void HairStrandSolver::RunPass(HairStrandPass pass, int strandsPerJob, float deltaSeconds)
+{
+	int numJobs = (m_paddedStrandCount + strandsPerJob - 1) / strandsPerJob;
+	if (!g_theJobSystem || (numJobs <= 1)) {
+		for (int jobIndex = 0; jobIndex < numJobs; jobIndex++) {
+			int firstStrand = jobIndex * strandsPerJob;
+			int strandCount = (m_paddedStrandCount - firstStrand < strandsPerJob) ? m_paddedStrandCount - firstStrand : strandsPerJob;
+			ExecutePass(pass, jobIndex, firstStrand, strandCount, deltaSeconds);
+		}
+		return;
+	}
+
+	// The calling thread takes the last job instead of idling until the others come back
+	JobBatch passJobs(g_theJobSystem);
+	for (int jobIndex = 0; jobIndex < (numJobs - 1); jobIndex++) {
+		passJobs.QueueJob(new HairStrandBatchJob(this, pass, jobIndex, jobIndex * strandsPerJob, strandsPerJob, deltaSeconds));
+	}
+
+	int lastJobStart = (numJobs - 1) * strandsPerJob;
+	ExecutePass(pass, numJobs - 1, lastJobStart, m_paddedStrandCount - lastJobStart, deltaSeconds);
+
+	passJobs.WaitAndDeleteJobs();
+}
+
+void HairStrandSolver::ExecutePass(HairStrandPass pass, int jobIndex, int firstStrand, int strandCount, float deltaSeconds)
+{
+	switch (pass)
+	{
+	default:
+		ERROR_AND_DIE("UNSUPPORTED HAIR STRAND PASS");
+		break;
+	case HairStrandPass::STEP:
+		UpdateStrandBatch(firstStrand, strandCount, deltaSeconds);
+		break;
+	case HairStrandPass::SPLAT:
+		SplatStrandBatch(jobIndex, firstStrand, strandCount);
+		break;
+	case HairStrandPass::RESOLVE:
+		ResolveStrandBatch(firstStrand, strandCount, deltaSeconds);
+		break;
+	}
+}
+
+void HairStrandSolver::UpdateStrandBatch(int firstStrand, int strandCount, float deltaSeconds)
+{
+	for (int laneStart = firstStrand; laneStart < (firstStrand + strandCount); laneStart += HAIR_STRAND_LANES) {
+		switch (m_simulationParams.usedAlgorithm)
+		{
+		default:
+			ERROR_AND_DIE("UNSUPPORTED HAIR SIMULATION ALGORITHM");
+			break;
+		case SimulAlgorithm::DFTL:
+			UpdateDFTL(laneStart, deltaSeconds);
+			break;
+		case SimulAlgorithm::MASS_SPRINGS:
+			UpdateMassSprings(laneStart, deltaSeconds);
+			break;
+		}
+	}
+}
+
+// Trilinear splat of every moving segment, the root stays out like in the compute shader
+void HairStrandSolver::SplatStrandBatch(int splatIndex, int firstStrand, int strandCount)
+{
+	HairGridSplat& splat = m_gridSplats[splatIndex];
+	ClearGridSplat(splat);
+
+	int strideY = m_gridDimensions.x;
+	int strideZ = m_gridDimensions.x * m_gridDimensions.y;
+	for (int laneStart = firstStrand; laneStart < (firstStrand + strandCount); laneStart += HAIR_STRAND_LANES) {
+		// Padding strands would count the last strand again
+		int laneCount = ((m_strandCount - laneStart) < HAIR_STRAND_LANES) ? m_strandCount - laneStart : HAIR_STRAND_LANES;
+
+		for (int segmentIndex = 1; segmentIndex < m_segmentCount; segmentIndex++) {
+			TrilinearLanes trilinear;
+			GetTrilinearLanes(LoadLanes(HairStrandChannel::POSITION, segmentIndex, laneStart), trilinear);
+			float const* velocitiesX = GetLanes(HairStrandChannel::VELOCITY, 0, segmentIndex, laneStart);
+			float const* velocitiesY = GetLanes(HairStrandChannel::VELOCITY, 1, segmentIndex, laneStart);
+			float const* velocitiesZ = GetLanes(HairStrandChannel::VELOCITY, 2, segmentIndex, laneStart);
+
+			for (int laneIndex = 0; laneIndex < laneCount; laneIndex++) {
+				if (((trilinear.m_validLanes >> laneIndex) & 1) == 0) continue;
+
+				float weights[3][2];
+				GetTrilinearWeights(trilinear, laneIndex, weights);
+
+				HairGridCell* firstCell = &splat.m_cells[trilinear.m_cellIndexes[laneIndex]];
+				for (int offsetZ = 0; offsetZ < 2; offsetZ++) {
+					for (int offsetY = 0; offsetY < 2; offsetY++) {
+						for (int offsetX = 0; offsetX < 2; offsetX++) {
+							float weight = weights[0][offsetX] * weights[1][offsetY] * weights[2][offsetZ];
+							HairGridCell& cell = firstCell[offsetX + (offsetY * strideY) + (offsetZ * strideZ)];
+							cell.m_density += weight;
+							cell.m_momentum.x += velocitiesX[laneIndex] * weight;
+							cell.m_momentum.y += velocitiesY[laneIndex] * weight;
+							cell.m_momentum.z += velocitiesZ[laneIndex] * weight;
+						}
+					}
+				}
+
+				int cellX = trilinear.m_cellCoords[0][laneIndex];
+				int cellY = trilinear.m_cellCoords[1][laneIndex];
+				int cellZ = trilinear.m_cellCoords[2][laneIndex];
+				AddToSplatBounds(splat, IntVec3(cellX, cellY, cellZ), IntVec3(cellX + 1, cellY + 1, cellZ + 1));
+			}
+		}
+	}
+}
+
+void HairStrandSolver::ResolveStrandBatch(int firstStrand, int strandCount, float deltaSeconds)
+{
+	for (int laneStart = firstStrand; laneStart < (firstStrand + strandCount); laneStart += HAIR_STRAND_LANES) {
+		if (IsGridEnabled()) {
+			for (int segmentIndex = 1; segmentIndex < m_segmentCount; segmentIndex++) {
+				ApplyGridVelocity(laneStart, segmentIndex, deltaSeconds);
+			}
+		}
+
+		if (!m_collisionObjects.empty()) {
+			CollideGroup(laneStart, deltaSeconds);
+		}
+	}
+}
+
+void HairStrandSolver::AddForce(Vec3 const& force)
+{
+	m_genForce += force;
+}
+
+void HairStrandSolver::AddVerts(std::vector<Vertex_PNCU>& hairVertexes) const
+{
+	hairVertexes.reserve(hairVertexes.size() + ((size_t)m_strandCount * (m_segmentCount - 1) * 2));
+	for (int strandIndex = 0; strandIndex < m_strandCount; strandIndex++) {
+		Vec3 prevSegment = GetPosition(strandIndex, 0);
+		for (int segmentIndex = 1; segmentIndex < m_segmentCount; segmentIndex++) {
+			Vec3 currentSegment = GetPosition(strandIndex, segmentIndex);
+			hairVertexes.emplace_back(prevSegment, Vec3::ZERO, Rgba8::WHITE, Vec2::ZERO);
+			hairVertexes.emplace_back(currentSegment, Vec3::ZERO, Rgba8::WHITE, Vec2::ZERO);
+			prevSegment = currentSegment;
+		}
+	}
+}
+
+void HairStrandSolver::SetSimulationAlgorithm(SimulAlgorithm usedAlgorithm, bool isCurlyHair)
+{
+	m_simulationParams.usedAlgorithm = usedAlgorithm;
+	m_simulationParams.isCurlyHair = isCurlyHair;
+}
+
+void HairStrandSolver::SetSpringStiffness(float const& edgeStiffness, float const& bendStiffness, float const& torsionStiffness)
+{
+	m_simulationParams.edgeStiffness = edgeStiffness;
+	m_simulationParams.bendStiffness = bendStiffness;
+	m_simulationParams.torsionStiffness = torsionStiffness;
+}
+
+void HairStrandSolver::SetSpringLengths(float const& edgeLength, float const& bendLength, float const& torsionLength)
+{
+	m_segmentLength = edgeLength;
+	m_bendInitialLength = bendLength;
+	m_torsionInitialLength = torsionLength;
+}
+
+void HairStrandSolver::GetSpringLengths(float& edgeLength, float& bendLength, float& torsionLength) const
+{
+	edgeLength = m_segmentLength;
+	bendLength = m_bendInitialLength;
+	torsionLength = m_torsionInitialLength;
+}
+
+void HairStrandSolver::SetGrid(IntVec3 const& gridDimensions, float cellWidth, float cellHeight, Vec3 const& gridCenter)
+{
+	if ((gridDimensions.x <= 0) || (gridDimensions.y <= 0) || (gridDimensions.z <= 0)) {
+		m_gridDimensions = IntVec3::ZERO;
+		m_grid = HairGridSplat();
+		m_gridSplats.clear();
+		return;
+	}
+
+	GUARANTEE_OR_DIE((cellWidth > 0.0f) && (cellHeight > 0.0f), "HAIR GRID CELLS NEED A POSITIVE SIZE");
+	m_cellSize = Vec3(cellWidth, cellWidth, cellHeight);
+	m_gridOrigin = gridCenter - Vec3((float)gridDimensions.x * cellWidth, (float)gridDimensions.y * cellWidth, (float)gridDimensions.z * cellHeight) * 0.5f;
+
+	if (gridDimensions != m_gridDimensions) {
+		m_gridDimensions = gridDimensions;
+		m_grid = HairGridSplat();
+		m_grid.m_cells.resize((size_t)gridDimensions.x * gridDimensions.y * gridDimensions.z);
+		m_gridSplats.clear();
+	}
+}
+
+void HairStrandSolver::AddCollisionSphere(Vec3 const& position, float radius)
+{
+	HairCollisionObject collisionObject = {};
+	collisionObject.Position = position;
+	collisionObject.Radius = radius;
+	m_collisionObjects.push_back(collisionObject);
+}
+
+void HairStrandSolver::ClearCollisionObjects()
+{
+	m_collisionObjects.clear();
+}
+
+HairGridCell const HairStrandSolver::GetGridCell(IntVec3 const& cellCoords) const
+{
+	if (!IsGridEnabled()) return HairGridCell();
+	if ((cellCoords.x < 0) || (cellCoords.y < 0) || (cellCoords.z < 0)) return HairGridCell();
+	if ((cellCoords.x >= m_gridDimensions.x) || (cellCoords.y >= m_gridDimensions.y) || (cellCoords.z >= m_gridDimensions.z)) return HairGridCell();
+
+	return m_grid.m_cells[GetCellIndex(cellCoords.x, cellCoords.y, cellCoords.z)];
+}
+
+Vec3 const HairStrandSolver::GetPosition(int strandIndex, int segmentIndex) const
+{
+	return GetStrandValue(HairStrandChannel::POSITION, strandIndex, segmentIndex);
+}
+
+Vec3 const HairStrandSolver::GetVirtualParticlePosition(int strandIndex, int particleIndex) const
+{
+	return GetStrandValue(HairStrandChannel::VIRTUAL_POSITION, strandIndex, particleIndex);
+}
+
+void HairStrandSolver::UpdateDFTL(int firstStrand, float deltaSeconds)
+{
+	__m128 deltaTime = _mm_set1_ps(deltaSeconds);
+	__m128 deltaSqr = _mm_set1_ps(deltaSeconds * deltaSeconds);
+	__m128 segmentLength = _mm_set1_ps(m_segmentLength);
+	__m128 segmentLengthSqr = _mm_set1_ps(m_segmentLength * m_segmentLength);
+	__m128 negativeCorrectionDamping = _mm_set1_ps(-0.9f);
+	StrandLanes forceDisp = ScaleLanes(SplatLanes(m_stepForce), deltaSqr);
+
+	StrandLanes prevPos = LoadLanes(HairStrandChannel::POSITION, 0, firstStrand);
+	for (int positionInd = 1; positionInd < m_segmentCount; positionInd++) {
+		StrandLanes position = LoadLanes(HairStrandChannel::POSITION, positionInd, firstStrand);
+		StrandLanes velocity = LoadLanes(HairStrandChannel::VELOCITY, positionInd, firstStrand);
+
+		StrandLanes newPos = AddLanes(AddLanes(position, ScaleLanes(velocity, deltaTime)), forceDisp);
+
+		// Vec3::ClampLength to the segment length
+		StrandLanes distToCurrentPos = SubtractLanes(newPos, prevPos);
+		__m128 lengthSqr = DotLanes(distToCurrentPos, distToCurrentPos);
+		__m128 isTooLong = _mm_cmpgt_ps(lengthSqr, segmentLengthSqr);
+		StrandLanes clampedDist = ScaleLanes(DivideLanes(distToCurrentPos, _mm_sqrt_ps(lengthSqr)), segmentLength);
+		distToCurrentPos = SelectLanes(isTooLong, clampedDist, distToCurrentPos);
+
+		StrandLanes correctedPos = AddLanes(prevPos, distToCurrentPos);
+		StrandLanes correctionVec = SubtractLanes(correctedPos, newPos);
+
+		StrandLanes firstTerm = DivideLanes(SubtractLanes(correctedPos, position), deltaTime);
+		StrandLanes secondTerm = DivideLanes(ScaleLanes(correctionVec, negativeCorrectionDamping), deltaTime);
+
+		StoreLanes(HairStrandChannel::VELOCITY, positionInd, firstStrand, AddLanes(firstTerm, secondTerm));
+		StoreLanes(HairStrandChannel::POSITION, positionInd, firstStrand, correctedPos);
+		prevPos = correctedPos;
+	}
+}
+
+void HairStrandSolver::UpdateMassSprings(int firstStrand, float deltaSeconds)
+{
+	bool const& isCurly = m_simulationParams.isCurlyHair;
+	__m128 deltaTime = _mm_set1_ps(deltaSeconds);
+	__m128 halfDeltaTime = _mm_set1_ps(deltaSeconds * 0.5f);
+	__m128 mass = _mm_set1_ps(m_simulationParams.mass);
+	__m128 two = _mm_set1_ps(2.0f);
+	StrandLanes genForce = SplatLanes(m_stepForce);
+
+	ClearForces(firstStrand);
+	if (isCurly) {
+		CalculateRestitutionForcesCurly(firstStrand, deltaSeconds, false);
+	}
+	else {
+		CalculateRestitutionForcesStraight(firstStrand, deltaSeconds, false);
+	}
+
+	for (int index = 1; index < m_segmentCount; index++) {
+		StrandLanes force = AddLanes(LoadLanes(HairStrandChannel::FORCE, index, firstStrand), genForce);
+		StrandLanes velocity = LoadLanes(HairStrandChannel::VELOCITY, index, firstStrand);
+		StoreLanes(HairStrandChannel::HALF_VELOCITY, index, firstStrand, AddLanes(velocity, DivideLanes(ScaleLanes(force, halfDeltaTime), mass)));
+	}
+
+	if (!isCurly) {
+		for (int index = 0; index < (m_segmentCount - 1); index++) {
+			StrandLanes force = LoadLanes(HairStrandChannel::VIRTUAL_FORCE, index, firstStrand);
+			StrandLanes velocity = LoadLanes(HairStrandChannel::VIRTUAL_VELOCITY, index, firstStrand);
+			StoreLanes(HairStrandChannel::VIRTUAL_HALF_VELOCITY, index, firstStrand, AddLanes(velocity, DivideLanes(ScaleLanes(force, halfDeltaTime), mass)));
+		}
+	}
+
+	StoreLanes(HairStrandChannel::PREV_POSITION, 0, firstStrand, LoadLanes(HairStrandChannel::POSITION, 0, firstStrand));
+	for (int posIndex = 1; posIndex < m_segmentCount; posIndex++) {
+		StrandLanes position = LoadLanes(HairStrandChannel::POSITION, posIndex, firstStrand);
+		StrandLanes halfVelocity = LoadLanes(HairStrandChannel::HALF_VELOCITY, posIndex, firstStrand);
+		StoreLanes(HairStrandChannel::PREV_POSITION, posIndex, firstStrand, position);
+		StoreLanes(HairStrandChannel::POSITION, posIndex, firstStrand, AddLanes(position, ScaleLanes(halfVelocity, deltaTime)));
+	}
+
+	if (!isCurly) {
+		for (int posIndex = 0; posIndex < (m_segmentCount - 1); posIndex++) {
+			StrandLanes position = LoadLanes(HairStrandChannel::VIRTUAL_POSITION, posIndex, firstStrand);
+			StrandLanes halfVelocity = LoadLanes(HairStrandChannel::VIRTUAL_HALF_VELOCITY, posIndex, firstStrand);
+			StoreLanes(HairStrandChannel::VIRTUAL_PREV_POSITION, posIndex, firstStrand, position);
+			StoreLanes(HairStrandChannel::VIRTUAL_POSITION, posIndex, firstStrand, AddLanes(position, ScaleLanes(halfVelocity, deltaTime)));
+		}
+	}
+
+	ClearForces(firstStrand);
+	if (isCurly) {
+		CalculateRestitutionForcesCurly(firstStrand, deltaSeconds, true);
+	}
+	else {
+		CalculateRestitutionForcesStraight(firstStrand, deltaSeconds, true);
+	}
+
+	for (int index = 1; index < m_segmentCount; index++) {
+		StrandLanes force = AddLanes(LoadLanes(HairStrandChannel::FORCE, index, firstStrand), genForce);
+		StrandLanes velocity = LoadLanes(HairStrandChannel::VELOCITY, index, firstStrand);
+		StrandLanes halfVelocity = AddLanes(velocity, DivideLanes(ScaleLanes(force, halfDeltaTime), mass));
+		StoreLanes(HairStrandChannel::HALF_VELOCITY, index, firstStrand, halfVelocity);
+		StoreLanes(HairStrandChannel::VELOCITY, index, firstStrand, SubtractLanes(ScaleLanes(halfVelocity, two), velocity));
+	}
+
+	if (!isCurly) {
+		for (int index = 0; index < (m_segmentCount - 1); index++) {
+			StrandLanes force = LoadLanes(HairStrandChannel::VIRTUAL_FORCE, index, firstStrand);
+			StrandLanes velocity = LoadLanes(HairStrandChannel::VIRTUAL_VELOCITY, index, firstStrand);
+			StrandLanes halfVelocity = AddLanes(velocity, DivideLanes(ScaleLanes(force, halfDeltaTime), mass));
+			StoreLanes(HairStrandChannel::VIRTUAL_HALF_VELOCITY, index, firstStrand, halfVelocity);
+			StoreLanes(HairStrandChannel::VIRTUAL_VELOCITY, index, firstStrand, SubtractLanes(ScaleLanes(halfVelocity, two), velocity));
+		}
+	}
+}
+
+void HairStrandSolver::CalculateRestitutionForcesCurly(int firstStrand, float deltaSeconds, bool useHalfPosition)
+{
+	float const& damping = m_simulationParams.damping;
+	__m128 segmentLength = _mm_set1_ps(m_segmentLength);
+	StrandSpring edgeSpring = MakeStrandSpring(deltaSeconds, m_simulationParams.edgeStiffness, m_segmentLength, m_segmentLength, damping);
+	StrandSpring bendSpring = MakeStrandSpring(deltaSeconds, m_simulationParams.bendStiffness, m_bendInitialLength, m_segmentLength, damping);
+	StrandSpring torsionSpring = MakeStrandSpring(deltaSeconds, m_simulationParams.torsionStiffness, m_torsionInitialLength, m_segmentLength, damping);
+
+	for (int index = 0; index < m_segmentCount - 1; index++) {
+		bool calculateBend = ((index + 2) < m_segmentCount);
+		bool calculateTorsion = ((index + 3) < m_segmentCount);
+
+		StrandLanes posOne = LoadSpringPosition(index, firstStrand, useHalfPosition);
+		StrandLanes posTwo = LoadSpringPosition(index + 1, firstStrand, useHalfPosition);
+		StrandLanes velocity = LoadLanes(HairStrandChannel::VELOCITY, index, firstStrand);
+
+		StrandLanes velDiff = SubtractLanes(LoadLanes(HairStrandChannel::VELOCITY, index + 1, firstStrand), velocity);
+		StrandLanes resultingForce = GetSpringForceLanes(SubtractLanes(posTwo, posOne), velDiff, edgeSpring, segmentLength);
+		AddToLanes(HairStrandChannel::FORCE, index, firstStrand, resultingForce, 0.5f);
+		AddToLanes(HairStrandChannel::FORCE, index + 1, firstStrand, resultingForce, -0.5f);
+
+		if (calculateBend) {
+			StrandLanes posTwoBend = LoadSpringPosition(index + 2, firstStrand, useHalfPosition);
+			StrandLanes velDiffBend = SubtractLanes(LoadLanes(HairStrandChannel::VELOCITY, index + 2, firstStrand), velocity);
+			StrandLanes resultingForceBend = GetSpringForceLanes(SubtractLanes(posTwoBend, posOne), velDiffBend, bendSpring, segmentLength);
+			AddToLanes(HairStrandChannel::FORCE, index, firstStrand, resultingForceBend, 0.5f);
+			AddToLanes(HairStrandChannel::FORCE, index + 2, firstStrand, resultingForceBend, -0.5f);
+		}
+
+		if (calculateTorsion) {
+			StrandLanes posTwoTorsion = LoadSpringPosition(index + 3, firstStrand, useHalfPosition);
+			StrandLanes velDiffTorsion = SubtractLanes(LoadLanes(HairStrandChannel::VELOCITY, index + 3, firstStrand), velocity);
+			StrandLanes resultingForceTorsion = GetSpringForceLanes(SubtractLanes(posTwoTorsion, posOne), velDiffTorsion, torsionSpring, segmentLength);
+			AddToLanes(HairStrandChannel::FORCE, index, firstStrand, resultingForceTorsion, 0.5f);
+			AddToLanes(HairStrandChannel::FORCE, index + 3, firstStrand, resultingForceTorsion, -0.5f);
+		}
+	}
+}
+
+void HairStrandSolver::CalculateRestitutionForcesStraight(int firstStrand, float deltaSeconds, bool useHalfPosition)
+{
+	float const& damping = m_simulationParams.damping;
+	__m128 half = _mm_set1_ps(0.5f);
+	__m128 segmentLength = _mm_set1_ps(m_segmentLength);
+	StrandSpring edgeSpring = MakeStrandSpring(deltaSeconds, m_simulationParams.edgeStiffness, m_segmentLength, m_segmentLength, damping);
+	StrandSpring bendSpring = MakeStrandSpring(deltaSeconds, m_simulationParams.bendStiffness, m_bendInitialLength, m_segmentLength, damping);
+	StrandSpring torsionSpring = MakeStrandSpring(deltaSeconds, m_simulationParams.torsionStiffness, m_torsionInitialLength, m_segmentLength, damping);
+
+	for (int index = 0; index < m_segmentCount - 1; index++) {
+		bool calculateBend = ((index + 2) < m_segmentCount);
+
+		StrandLanes posOne = LoadSpringPosition(index, firstStrand, useHalfPosition);
+		StrandLanes posTwo = LoadSpringPosition(index + 1, firstStrand, useHalfPosition);
+		StrandLanes velocity = LoadLanes(HairStrandChannel::VELOCITY, index, firstStrand);
+
+		StrandLanes velDiff = SubtractLanes(LoadLanes(HairStrandChannel::VELOCITY, index + 1, firstStrand), velocity);
+		StrandLanes resultingForce = GetSpringForceLanes(SubtractLanes(posTwo, posOne), velDiff, edgeSpring, segmentLength);
+		AddToLanes(HairStrandChannel::FORCE, index, firstStrand, resultingForce, 0.5f);
+		AddToLanes(HairStrandChannel::FORCE, index + 1, firstStrand, resultingForce, -0.5f);
+
+		if (calculateBend) {
+			StrandLanes posTwoBend = LoadSpringPosition(index + 2, firstStrand, useHalfPosition);
+			StrandLanes velDiffBend = SubtractLanes(LoadLanes(HairStrandChannel::VELOCITY, index + 2, firstStrand), velocity);
+			StrandLanes resultingForceBend = GetSpringForceLanes(SubtractLanes(posTwoBend, posOne), velDiffBend, bendSpring, segmentLength);
+			AddToLanes(HairStrandChannel::FORCE, index, firstStrand, resultingForceBend, 0.5f);
+			AddToLanes(HairStrandChannel::FORCE, index + 2, firstStrand, resultingForceBend, -0.5f);
+		}
+	}
+
+	// Fake particles. Half positions pair both hair positions with the previous position of partIndex, like HairSimulGuide does
+	StrandLanes zero = SplatLanes(Vec3::ZERO);
+	for (int partIndex = 0; partIndex < (m_segmentCount - 1); partIndex++) {
+		bool calculateNextPart = (partIndex + 1) < (m_segmentCount - 1);
+		bool calculateTorsion = (partIndex - 1) > 0;
+
+		StrandLanes particlePos = LoadLanes(HairStrandChannel::VIRTUAL_POSITION, partIndex, firstStrand);
+		StrandLanes nextParticlePos = (calculateNextPart) ? LoadLanes(HairStrandChannel::VIRTUAL_POSITION, partIndex + 1, firstStrand) : zero;
+
+		StrandLanes previousHairPos = (calculateTorsion) ? LoadLanes(HairStrandChannel::POSITION, partIndex - 1, firstStrand) : zero;
+		StrandLanes currHairPos = LoadLanes(HairStrandChannel::POSITION, partIndex, firstStrand);
+		StrandLanes nextHairPos = LoadLanes(HairStrandChannel::POSITION, partIndex + 1, firstStrand);
+
+		if (useHalfPosition) {
+			StrandLanes prevPosition = LoadLanes(HairStrandChannel::PREV_POSITION, partIndex, firstStrand);
+			currHairPos = ScaleLanes(AddLanes(currHairPos, prevPosition), half);
+			nextHairPos = ScaleLanes(AddLanes(nextHairPos, prevPosition), half);
+
+			StrandLanes previousHairPrevPos = (calculateTorsion) ? LoadLanes(HairStrandChannel::PREV_POSITION, partIndex - 1, firstStrand) : zero;
+			previousHairPos = ScaleLanes(AddLanes(previousHairPos, previousHairPrevPos), half);
+		}
+
+		StrandLanes particleVelocity = LoadLanes(HairStrandChannel::VIRTUAL_VELOCITY, partIndex, firstStrand);
+
+		StrandLanes velocityDeltaCurr = SubtractLanes(particleVelocity, LoadLanes(HairStrandChannel::VELOCITY, partIndex, firstStrand));
+		StrandLanes forceCurrHair = GetSpringForceLanes(SubtractLanes(particlePos, currHairPos), velocityDeltaCurr, edgeSpring, segmentLength);
+		AddToLanes(HairStrandChannel::FORCE, partIndex, firstStrand, forceCurrHair, 0.5f);
+		AddToLanes(HairStrandChannel::VIRTUAL_FORCE, partIndex, firstStrand, forceCurrHair, -0.5f);
+
+		StrandLanes velocityDeltaNext = SubtractLanes(particleVelocity, LoadLanes(HairStrandChannel::VELOCITY, partIndex + 1, firstStrand));
+		StrandLanes forceNextHair = GetSpringForceLanes(SubtractLanes(nextHairPos, particlePos), velocityDeltaNext, edgeSpring, segmentLength);
+		AddToLanes(HairStrandChannel::VIRTUAL_FORCE, partIndex, firstStrand, forceNextHair, 0.5f);
+		AddToLanes(HairStrandChannel::FORCE, partIndex + 1, firstStrand, forceNextHair, -0.5f);
+
+		if (calculateNextPart) {
+			StrandLanes velocityDelta = SubtractLanes(LoadLanes(HairStrandChannel::VIRTUAL_VELOCITY, partIndex + 1, firstStrand), particleVelocity);
+			StrandLanes forceNextPart = GetSpringForceLanes(SubtractLanes(nextParticlePos, particlePos), velocityDelta, bendSpring, segmentLength);
+			AddToLanes(HairStrandChannel::VIRTUAL_FORCE, partIndex, firstStrand, forceNextPart, 0.5f);
+			AddToLanes(HairStrandChannel::VIRTUAL_FORCE, partIndex + 1, firstStrand, forceNextPart, -0.5f);
+		}
+
+		if (calculateTorsion) {
+			StrandLanes velocityDeltaTorsion = SubtractLanes(particleVelocity, LoadLanes(HairStrandChannel::VELOCITY, partIndex - 1, firstStrand));
+			StrandLanes forceTorsion = GetSpringForceLanes(SubtractLanes(particlePos, previousHairPos), velocityDeltaTorsion, torsionSpring, segmentLength);
+			AddToLanes(HairStrandChannel::FORCE, partIndex - 1, firstStrand, forceTorsion, 0.5f);
+			AddToLanes(HairStrandChannel::VIRTUAL_FORCE, partIndex, firstStrand, forceTorsion, -0.5f);
+		}
+	}
+}
+
+void HairStrandSolver::ClearForces(int firstStrand)
+{
+	StrandLanes zero = SplatLanes(Vec3::ZERO);
+	for (int segmentIndex = 0; segmentIndex < m_segmentCount; segmentIndex++) {
+		StoreLanes(HairStrandChannel::FORCE, segmentIndex, firstStrand, zero);
+		StoreLanes(HairStrandChannel::VIRTUAL_FORCE, segmentIndex, firstStrand, zero);
+	}
+}
+
+void HairStrandSolver::ReduceSplats(int splatCount)
+{
+	ClearGridSplat(m_grid);
+	for (int splatIndex = 0; splatIndex < splatCount; splatIndex++) {
+		HairGridSplat const& splat = m_gridSplats[splatIndex];
+		if (splat.m_isEmpty) continue;
+
+		for (int z = splat.m_mins.z; z <= splat.m_maxs.z; z++) {
+			for (int y = splat.m_mins.y; y <= splat.m_maxs.y; y++) {
+				for (int x = splat.m_mins.x; x <= splat.m_maxs.x; x++) {
+					int cellIndex = GetCellIndex(x, y, z);
+					HairGridCell& cell = m_grid.m_cells[cellIndex];
+					cell.m_density += splat.m_cells[cellIndex].m_density;
+					cell.m_momentum += splat.m_cells[cellIndex].m_momentum;
+				}
+			}
+		}
+
+		AddToSplatBounds(m_grid, splat.m_mins, splat.m_maxs);
+	}
+}
+
+void HairStrandSolver::ClearGridSplat(HairGridSplat& splat) const
+{
+	if (splat.m_isEmpty) return;
+
+	for (int z = splat.m_mins.z; z <= splat.m_maxs.z; z++) {
+		for (int y = splat.m_mins.y; y <= splat.m_maxs.y; y++) {
+			for (int x = splat.m_mins.x; x <= splat.m_maxs.x; x++) {
+				splat.m_cells[GetCellIndex(x, y, z)] = HairGridCell();
+			}
+		}
+	}
+
+	splat.m_isEmpty = true;
+}
+
+// Friction blends towards the grid velocity like the DFTL compute shader. Repulsion moves the segment m_repulsionCoefficient
+// cells per step down the density gradient, relative to the density around it
+void HairStrandSolver::ApplyGridVelocity(int firstStrand, int segmentIndex, float deltaSeconds)
+{
+	TrilinearLanes trilinear;
+	GetTrilinearLanes(LoadLanes(HairStrandChannel::POSITION, segmentIndex, firstStrand), trilinear);
+	if (trilinear.m_validLanes == 0) return;
+
+	float* velocitiesX = GetLanes(HairStrandChannel::VELOCITY, 0, segmentIndex, firstStrand);
+	float* velocitiesY = GetLanes(HairStrandChannel::VELOCITY, 1, segmentIndex, firstStrand);
+	float* velocitiesZ = GetLanes(HairStrandChannel::VELOCITY, 2, segmentIndex, firstStrand);
+
+	int strideY = m_gridDimensions.x;
+	int strideZ = m_gridDimensions.x * m_gridDimensions.y;
+	for (int laneIndex = 0; laneIndex < HAIR_STRAND_LANES; laneIndex++) {
+		if (((trilinear.m_validLanes >> laneIndex) & 1) == 0) continue;
+
+		float weights[3][2];
+		GetTrilinearWeights(trilinear, laneIndex, weights);
+
+		float density = 0.0f;
+		Vec3 momentum = Vec3::ZERO;
+		Vec3 densityGradient = Vec3::ZERO;
+		HairGridCell const* firstCell = &m_grid.m_cells[trilinear.m_cellIndexes[laneIndex]];
+		for (int offsetZ = 0; offsetZ < 2; offsetZ++) {
+			for (int offsetY = 0; offsetY < 2; offsetY++) {
+				for (int offsetX = 0; offsetX < 2; offsetX++) {
+					HairGridCell const& cell = firstCell[offsetX + (offsetY * strideY) + (offsetZ * strideZ)];
+					float weight = weights[0][offsetX] * weights[1][offsetY] * weights[2][offsetZ];
+					density += weight * cell.m_density;
+					momentum.x += weight * cell.m_momentum.x;
+					momentum.y += weight * cell.m_momentum.y;
+					momentum.z += weight * cell.m_momentum.z;
+
+					// Derivative of the trilinear weights along each axis, in cells
+					densityGradient.x += ((offsetX) ? 1.0f : -1.0f) * weights[1][offsetY] * weights[2][offsetZ] * cell.m_density;
+					densityGradient.y += ((offsetY) ? 1.0f : -1.0f) * weights[0][offsetX] * weights[2][offsetZ] * cell.m_density;
+					densityGradient.z += ((offsetZ) ? 1.0f : -1.0f) * weights[0][offsetX] * weights[1][offsetY] * cell.m_density;
+				}
+			}
+		}
+
+		if (density < HAIR_GRID_MIN_DENSITY) continue;
+
+		float gridVelocityScale = m_frictionCoefficient / density;
+		float repulsionScale = m_repulsionCoefficient / (density * deltaSeconds);
+		velocitiesX[laneIndex] = ((1.0f - m_frictionCoefficient) * velocitiesX[laneIndex]) + (gridVelocityScale * momentum.x) - (repulsionScale * densityGradient.x * m_cellSize.x);
+		velocitiesY[laneIndex] = ((1.0f - m_frictionCoefficient) * velocitiesY[laneIndex]) + (gridVelocityScale * momentum.y) - (repulsionScale * densityGradient.y * m_cellSize.y);
+		velocitiesZ[laneIndex] = ((1.0f - m_frictionCoefficient) * velocitiesZ[laneIndex]) + (gridVelocityScale * momentum.z) - (repulsionScale * densityGradient.z * m_cellSize.z);
+	}
+}
+
+// Pushes segments out of the collision spheres and adds the push to their velocity, like HandleCollision in the shaders.
+// Spheres that don't touch the bounds of the group are skipped without looking at its segments
+void HairStrandSolver::CollideGroup(int firstStrand, float deltaSeconds)
+{
+	if (m_segmentCount < 2) return;
+
+	StrandLanes groupMins = LoadLanes(HairStrandChannel::POSITION, 1, firstStrand);
+	StrandLanes groupMaxs = groupMins;
+	for (int segmentIndex = 2; segmentIndex < m_segmentCount; segmentIndex++) {
+		StrandLanes position = LoadLanes(HairStrandChannel::POSITION, segmentIndex, firstStrand);
+		groupMins = StrandLanes{ _mm_min_ps(groupMins.x, position.x), _mm_min_ps(groupMins.y, position.y), _mm_min_ps(groupMins.z, position.z) };
+		groupMaxs = StrandLanes{ _mm_max_ps(groupMaxs.x, position.x), _mm_max_ps(groupMaxs.y, position.y), _mm_max_ps(groupMaxs.z, position.z) };
+	}
+
+	Vec3 mins(_mm_cvtss_f32(SelectMinLane(groupMins.x)), _mm_cvtss_f32(SelectMinLane(groupMins.y)), _mm_cvtss_f32(SelectMinLane(groupMins.z)));
+	Vec3 maxs(_mm_cvtss_f32(SelectMaxLane(groupMaxs.x)), _mm_cvtss_f32(SelectMaxLane(groupMaxs.y)), _mm_cvtss_f32(SelectMaxLane(groupMaxs.z)));
+
+	__m128 zero = _mm_setzero_ps();
+	for (int objectIndex = 0; objectIndex < (int)m_collisionObjects.size(); objectIndex++) {
+		HairCollisionObject const& collisionObject = m_collisionObjects[objectIndex];
+		if (collisionObject.Radius <= 0.0f) continue;
+
+		Vec3 const& center = collisionObject.Position;
+		float radius = collisionObject.Radius + m_collisionTolerance;
+		if ((center.x + radius < mins.x) || (center.x - radius > maxs.x)) continue;
+		if ((center.y + radius < mins.y) || (center.y - radius > maxs.y)) continue;
+		if ((center.z + radius < mins.z) || (center.z - radius > maxs.z)) continue;
+
+		StrandLanes centerLanes = SplatLanes(center);
+		__m128 radiusLanes = _mm_set1_ps(radius);
+		__m128 radiusSqr = _mm_set1_ps(radius * radius);
+		for (int segmentIndex = 1; segmentIndex < m_segmentCount; segmentIndex++) {
+			StrandLanes position = LoadLanes(HairStrandChannel::POSITION, segmentIndex, firstStrand);
+			StrandLanes dispToPosition = SubtractLanes(position, centerLanes);
+			__m128 distSqr = DotLanes(dispToPosition, dispToPosition);
+			__m128 isInside = _mm_and_ps(_mm_cmplt_ps(distSqr, radiusSqr), _mm_cmpgt_ps(distSqr, zero));
+			if (_mm_movemask_ps(isInside) == 0) continue;
+
+			StrandLanes pushedPosition = AddLanes(centerLanes, ScaleLanes(dispToPosition, _mm_div_ps(radiusLanes, _mm_sqrt_ps(distSqr))));
+			StrandLanes correctedPosition = SelectLanes(isInside, pushedPosition, position);
+
+			StoreLanes(HairStrandChannel::POSITION, segmentIndex, firstStrand, correctedPosition);
+			AddToLanes(HairStrandChannel::VELOCITY, segmentIndex, firstStrand, SubtractLanes(correctedPosition, position), 1.0f / deltaSeconds);
+		}
+	}
+}
+
+// SSE2 has no floor, so truncation is moved down by one wherever it rounded up
+void HairStrandSolver::GetTrilinearLanes(StrandLanes const& position, TrilinearLanes& out_trilinear) const
+{
+	__m128 positions[3] = { position.x, position.y, position.z };
+	float gridOrigin[3] = { m_gridOrigin.x, m_gridOrigin.y, m_gridOrigin.z };
+	float cellSize[3] = { m_cellSize.x, m_cellSize.y, m_cellSize.z };
+	int gridDimensions[3] = { m_gridDimensions.x, m_gridDimensions.y, m_gridDimensions.z };
+
+	int validLanes = 0xF;
+	for (int axis = 0; axis < 3; axis++) {
+		__m128 gridCoords = _mm_mul_ps(_mm_sub_ps(positions[axis], _mm_set1_ps(gridOrigin[axis])), _mm_set1_ps(1.0f / cellSize[axis]));
+		__m128i cellCoords = _mm_cvttps_epi32(gridCoords);
+		__m128i roundedUp = _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(cellCoords), gridCoords));
+		cellCoords = _mm_add_epi32(cellCoords, roundedUp);
+
+		__m128i isOutside = _mm_or_si128(_mm_cmplt_epi32(cellCoords, _mm_setzero_si128()), _mm_cmpgt_epi32(cellCoords, _mm_set1_epi32(gridDimensions[axis] - 2)));
+		validLanes &= ~_mm_movemask_ps(_mm_castsi128_ps(isOutside));
+
+		_mm_storeu_ps(out_trilinear.m_fractions[axis], _mm_sub_ps(gridCoords, _mm_cvtepi32_ps(cellCoords)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out_trilinear.m_cellCoords[axis]), cellCoords);
+	}
+
+	out_trilinear.m_validLanes = validLanes;
+	for (int laneIndex = 0; laneIndex < HAIR_STRAND_LANES; laneIndex++) {
+		out_trilinear.m_cellIndexes[laneIndex] = GetCellIndex(out_trilinear.m_cellCoords[0][laneIndex], out_trilinear.m_cellCoords[1][laneIndex], out_trilinear.m_cellCoords[2][laneIndex]);
+	}
+}
+
+// firstStrand is the first strand of a group, or any strand for the per strand accessors below
+float* HairStrandSolver::GetLanes(HairStrandChannel channel, int axis, int segmentIndex, int firstStrand)
+{
+	int groupIndex = firstStrand / HAIR_STRAND_LANES;
+	int rowIndex = ((((int)channel * 3) + axis) * m_segmentCount) + segmentIndex;
+	return m_buffer.data() + ((size_t)groupIndex * m_groupStride) + (rowIndex * HAIR_STRAND_LANES);
+}
+
+float const* HairStrandSolver::GetLanes(HairStrandChannel channel, int axis, int segmentIndex, int firstStrand) const
+{
+	int groupIndex = firstStrand / HAIR_STRAND_LANES;
+	int rowIndex = ((((int)channel * 3) + axis) * m_segmentCount) + segmentIndex;
+	return m_buffer.data() + ((size_t)groupIndex * m_groupStride) + (rowIndex * HAIR_STRAND_LANES);
+}
+
+Vec3 const HairStrandSolver::GetStrandValue(HairStrandChannel channel, int strandIndex, int segmentIndex) const
+{
+	int laneIndex = strandIndex % HAIR_STRAND_LANES;
+	return Vec3(GetLanes(channel, 0, segmentIndex, strandIndex)[laneIndex], GetLanes(channel, 1, segmentIndex, strandIndex)[laneIndex], GetLanes(channel, 2, segmentIndex, strandIndex)[laneIndex]);
+}
+
+StrandLanes HairStrandSolver::LoadLanes(HairStrandChannel channel, int segmentIndex, int firstStrand) const
+{
+	return StrandLanes{
+		_mm_loadu_ps(GetLanes(channel, 0, segmentIndex, firstStrand)),
+		_mm_loadu_ps(GetLanes(channel, 1, segmentIndex, firstStrand)),
+		_mm_loadu_ps(GetLanes(channel, 2, segmentIndex, firstStrand))
+	};
+}
+
+// Spring ends are the midpoint of the last two positions for the second half of a mass spring step
+StrandLanes HairStrandSolver::LoadSpringPosition(int segmentIndex, int firstStrand, bool useHalfPosition) const
+{
+	StrandLanes position = LoadLanes(HairStrandChannel::POSITION, segmentIndex, firstStrand);
+	if (!useHalfPosition) return position;
+
+	StrandLanes prevPosition = LoadLanes(HairStrandChannel::PREV_POSITION, segmentIndex, firstStrand);
+	return ScaleLanes(AddLanes(position, prevPosition), _mm_set1_ps(0.5f));
+}
+
+void HairStrandSolver::StoreLanes(HairStrandChannel channel, int segmentIndex, int firstStrand, StrandLanes const& lanes)
+{
+	_mm_storeu_ps(GetLanes(channel, 0, segmentIndex, firstStrand), lanes.x);
+	_mm_storeu_ps(GetLanes(channel, 1, segmentIndex, firstStrand), lanes.y);
+	_mm_storeu_ps(GetLanes(channel, 2, segmentIndex, firstStrand), lanes.z);
+}
+
+void HairStrandSolver::AddToLanes(HairStrandChannel channel, int segmentIndex, int firstStrand, StrandLanes const& lanes, float scale)
+{
+	StrandLanes sum = AddLanes(LoadLanes(channel, segmentIndex, firstStrand), ScaleLanes(lanes, _mm_set1_ps(scale)));
+	StoreLanes(channel, segmentIndex, firstStrand, sum);
+}
+
+void HairStrandSolver::SetStrandValue(HairStrandChannel channel, int strandIndex, int segmentIndex, Vec3 const& value)
+{
+	int laneIndex = strandIndex % HAIR_STRAND_LANES;
+	GetLanes(channel, 0, segmentIndex, strandIndex)[laneIndex] = value.x;
+	GetLanes(channel, 1, segmentIndex, strandIndex)[laneIndex] = value.y;
+	GetLanes(channel, 2, segmentIndex, strandIndex)[laneIndex] = value.z;
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include <vector>
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Math/IntVec3.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Game/Gameplay/Hair.hpp"
+
+constexpr int HAIR_STRAND_LANES = 4; // Strands simulated together in one SSE register
+constexpr int HAIR_STRANDS_PER_BATCH = 256;
+
+// Per segment quantities, each stored as 3 rows (x, y, z) per segment. Virtual particles only use the first segmentCount - 1 rows
+enum class HairStrandChannel {
+	POSITION = 0,
+	PREV_POSITION,
+	VELOCITY,
+	HALF_VELOCITY,
+	FORCE,
+	VIRTUAL_POSITION,
+	VIRTUAL_PREV_POSITION,
+	VIRTUAL_VELOCITY,
+	VIRTUAL_HALF_VELOCITY,
+	VIRTUAL_FORCE,
+	NUM_CHANNELS
+};
+
+// Each Update runs these in order, every pass split in jobs over the strands
+enum class HairStrandPass {
+	STEP = 0, // Springs or DFTL
+	SPLAT, // Rasterize segments into the voxel grid, one grid copy per job
+	RESOLVE, // Grid friction and repulsion, then collision spheres
+	NUM_PASSES
+};
+
+constexpr float HAIR_GRID_MIN_DENSITY = 0.05f; // Same cutoff as the DFTL compute shader
+
+struct HairGridCell {
+	Vec3 m_momentum = Vec3::ZERO; // Sum of velocity * weight, divided by the density when read
+	float m_density = 0.0f;
+};
+
+// One copy of the voxel grid per splat job, so no two threads ever write the same cell. Only the cells inside the
+// bounds were written since the last clear
+struct HairGridSplat {
+	std::vector<HairGridCell> m_cells;
+	IntVec3 m_mins = IntVec3::ZERO;
+	IntVec3 m_maxs = IntVec3::ZERO;
+	bool m_isEmpty = true;
+};
+
+struct StrandLanes;
+struct TrilinearLanes;
+class HairStrandSolver;
+
+class HairStrandBatchJob : public Job {
+public:
+	HairStrandBatchJob(HairStrandSolver* solver, HairStrandPass pass, int jobIndex, int firstStrand, int strandCount, float deltaSeconds) :
+		Job::Job(DEFAULT_JOB_ID),
+		m_solver(solver),
+		m_pass(pass),
+		m_jobIndex(jobIndex),
+		m_firstStrand(firstStrand),
+		m_strandCount(strandCount),
+		m_deltaSeconds(deltaSeconds)
+	{}
+
+	virtual void Execute() override;
+	virtual void OnFinished() override;
+
+	HairStrandSolver* m_solver = nullptr;
+	HairStrandPass m_pass = HairStrandPass::STEP;
+	int m_jobIndex = 0;
+	int m_firstStrand = 0;
+	int m_strandCount = 0;
+	float m_deltaSeconds = 0.0f;
+};
+
+// CPU counterpart of HairSimulGuide for thousands of strands at once. Every strand shares the simulation parameters and
+// segment count, so the state lives in one SoA buffer with a fixed stride per segment. Strands are grouped HAIR_STRAND_LANES
+// at a time: each group owns one contiguous block holding every (channel, axis, segment) row for its strands, so stepping a
+// group stays in L1 and no two groups share a cache line. Strand batches run on the JobSystem, and each batch steps a group
+// per SSE register. The math follows HairSimulGuide term for term, so any one strand can be validated against a single guide
+// while the grid and the collision spheres are off.
+// Strand-strand interaction goes through a velocity/density voxel grid, like the DFTL compute shader: segments are splatted
+// trilinearly, then each one blends its velocity towards the grid velocity (friction) and away from the density gradient
+// (repulsion). Both cost one pass over the segments, however many strands share a cell. Collision spheres are culled
+// against the bounds of each group of strands before testing the segments. Virtual particles take part in neither
+class HairStrandSolver {
+public:
+	HairStrandSolver(HairSimulationInit const& simulationParams, std::vector<Vec3> const& rootPositions, std::vector<Vec3> const& rootNormals);
+
+	void Update(float deltaSeconds);
+	void ExecutePass(HairStrandPass pass, int jobIndex, int firstStrand, int strandCount, float deltaSeconds);
+	void UpdateStrandBatch(int firstStrand, int strandCount, float deltaSeconds);
+	void SplatStrandBatch(int splatIndex, int firstStrand, int strandCount);
+	void ResolveStrandBatch(int firstStrand, int strandCount, float deltaSeconds);
+	void AddForce(Vec3 const& force);
+	void AddVerts(std::vector<Vertex_PNCU>& hairVertexes) const;
+
+	void SetSimulationAlgorithm(SimulAlgorithm usedAlgorithm, bool isCurlyHair);
+	void SetSpringStiffness(float const& edgeStiffness, float const& bendStiffness, float const& torsionStiffness);
+	void SetSpringLengths(float const& edgeLength, float const& bendLength, float const& torsionLength);
+	void GetSpringLengths(float& edgeLength, float& bendLength, float& torsionLength) const;
+
+	// Zero dimensions turn the grid off. Cells are cellWidth wide on x and y, cellHeight tall on z
+	void SetGrid(IntVec3 const& gridDimensions, float cellWidth, float cellHeight, Vec3 const& gridCenter);
+	void AddCollisionSphere(Vec3 const& position, float radius);
+	void ClearCollisionObjects();
+
+	int GetStrandCount() const { return m_strandCount; }
+	int GetSegmentCount() const { return m_segmentCount; }
+	int GetBatchCount() const { return (m_paddedStrandCount + HAIR_STRANDS_PER_BATCH - 1) / HAIR_STRANDS_PER_BATCH; }
+	Vec3 const GetPosition(int strandIndex, int segmentIndex) const;
+	Vec3 const GetVirtualParticlePosition(int strandIndex, int particleIndex) const;
+	bool IsGridEnabled() const { return !m_grid.m_cells.empty(); }
+	HairGridCell const GetGridCell(IntVec3 const& cellCoords) const; // As of the last Update
+
+	float m_gravity = -9.8f;
+	float m_frictionCoefficient = 0.1f;
+	float m_repulsionCoefficient = 0.01f;
+	float m_collisionTolerance = 0.05f;
+
+private:
+	void UpdateDFTL(int firstStrand, float deltaSeconds);
+	void UpdateMassSprings(int firstStrand, float deltaSeconds);
+	void CalculateRestitutionForcesCurly(int firstStrand, float deltaSeconds, bool useHalfPosition);
+	void CalculateRestitutionForcesStraight(int firstStrand, float deltaSeconds, bool useHalfPosition);
+	void ClearForces(int firstStrand);
+	void RunPass(HairStrandPass pass, int strandsPerJob, float deltaSeconds);
+	void ReduceSplats(int splatCount);
+	void ClearGridSplat(HairGridSplat& splat) const;
+	void ApplyGridVelocity(int firstStrand, int segmentIndex, float deltaSeconds);
+	void CollideGroup(int firstStrand, float deltaSeconds);
+	void GetTrilinearLanes(StrandLanes const& position, TrilinearLanes& out_trilinear) const;
+	int GetCellIndex(int x, int y, int z) const { return x + (m_gridDimensions.x * (y + (m_gridDimensions.y * z))); }
+
+	float* GetLanes(HairStrandChannel channel, int axis, int segmentIndex, int firstStrand);
+	float const* GetLanes(HairStrandChannel channel, int axis, int segmentIndex, int firstStrand) const;
+	Vec3 const GetStrandValue(HairStrandChannel channel, int strandIndex, int segmentIndex) const;
+	StrandLanes LoadLanes(HairStrandChannel channel, int segmentIndex, int firstStrand) const;
+	StrandLanes LoadSpringPosition(int segmentIndex, int firstStrand, bool useHalfPosition) const;
+	void StoreLanes(HairStrandChannel channel, int segmentIndex, int firstStrand, StrandLanes const& lanes);
+	void AddToLanes(HairStrandChannel channel, int segmentIndex, int firstStrand, StrandLanes const& lanes, float scale);
+	void SetStrandValue(HairStrandChannel channel, int strandIndex, int segmentIndex, Vec3 const& value);
+
+private:
+	HairSimulationInit m_simulationParams;
+	int m_strandCount = 0;
+	int m_segmentCount = 0;
+	int m_paddedStrandCount = 0; // Rounded up to a whole group; padding strands copy the last one
+	int m_groupStride = 0; // Floats per group of HAIR_STRAND_LANES strands
+	std::vector<float> m_buffer;
+
+	float m_segmentLength = 0.0f;
+	float m_bendInitialLength = 0.0f;
+	float m_torsionInitialLength = 0.0f;
+
+	Vec3 m_genForce = Vec3::ZERO;
+	Vec3 m_stepForce = Vec3::ZERO; // m_genForce plus gravity, for the step being run by the batches
+
+	IntVec3 m_gridDimensions = IntVec3::ZERO;
+	Vec3 m_gridOrigin = Vec3::ZERO;
+	Vec3 m_cellSize = Vec3::ZERO;
+	HairGridSplat m_grid; // Sum of every splat, read by the resolve pass
+	std::vector<HairGridSplat> m_gridSplats;
+
+	std::vector<HairCollisionObject> m_collisionObjects;
+};
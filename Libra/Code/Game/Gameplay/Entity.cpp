@@ -4,6 +4,14 @@
 #include "Game/Gameplay/Map.hpp"
 
 
+// Only path finding entities use the map sized heat maps. Projectiles, effects and rubble get empty ones, so spawning
+// them does not allocate and fill two of them
+static IntVec2 const GetHeatMapDimensions(Map const* map, bool isActor, EntityType type)
+{
+	bool isRubble = (type == EntityType::WALLRUBBLE) || (type == EntityType::ENEMYRUBBLE);
+	return (isActor && !isRubble) ? map->GetDimensions() : IntVec2::ZERO;
+}
+
 Entity::Entity(Map* pointerToGame, Vec2 const& startingPosition, float orientation, EntityFaction faction, EntityType type, bool isActor) :
 	m_map(pointerToGame),
 	m_position(startingPosition),
@@ -12,12 +20,14 @@ Entity::Entity(Map* pointerToGame, Vec2 const& startingPosition, float orientati
 	m_type(type),
 	m_isActor(isActor),
 	m_isProjectile(!isActor),
-	m_heatMap(m_map->GetDimensions()),
-	m_solidMap(m_map->GetDimensions()),
+	m_heatMap(GetHeatMapDimensions(pointerToGame, isActor, type)),
+	m_solidMap(GetHeatMapDimensions(pointerToGame, isActor, type)),
 	m_rayCastLength(g_gameConfigBlackboard.GetValue("MAX_RAYCAST_LENGTH", 10.0f)),
 	m_reachedGoal(true)
 {
-	m_map->GetSolidMapForEntity(m_solidMap, m_canSwim);
+	if (m_solidMap.GetDimensions() != IntVec2::ZERO) {
+		m_map->GetSolidMapForEntity(m_solidMap, m_canSwim);
+	}
 }
 
 void Entity::RenderDebug() const
@@ -255,6 +255,8 @@ void Map::SpawnEntities()
 Entity* Map::SpawnNewEntity(EntityType type, EntityFaction faction, Vec2 const& startingPosition, float orientation)
 {
 	Entity* newEntity = CreateEntity(type, faction, startingPosition, orientation);
+	if (!newEntity) return nullptr; // Its pool is full; dropping a projectile or effect beats stalling the frame
+
 	AddEntityToMap(newEntity);
 	return newEntity;
 }
@@ -448,10 +450,10 @@ Entity* Map::CreateEntity(EntityType type, EntityFaction faction, Vec2 const& st
 	Entity* newEntity = nullptr;
 	switch (type) {
 	case EntityType::WALLRUBBLE:
-		newEntity = new Rubble(this, startingPosition, orientation, faction, EntityType::WALLRUBBLE);
+		newEntity = m_rubblePool.Create(this, startingPosition, orientation, faction, EntityType::WALLRUBBLE);
 		break;
 	case EntityType::ENEMYRUBBLE:
-		newEntity = new Rubble(this, startingPosition, orientation, faction, EntityType::ENEMYRUBBLE);
+		newEntity = m_rubblePool.Create(this, startingPosition, orientation, faction, EntityType::ENEMYRUBBLE);
 		break;
 	case EntityType::ARIES:
 		newEntity = new Aries(this, startingPosition, orientation, faction, EntityType::ARIES);
@@ -466,23 +468,23 @@ Entity* Map::CreateEntity(EntityType type, EntityFaction faction, Vec2 const& st
 		newEntity = new Scorpio(this, startingPosition, orientation, faction, EntityType::SCORPIO);
 		break;
 	case EntityType::BULLET:
-		newEntity = new Bullet(this, startingPosition, orientation, faction, EntityType::BULLET, BulletType::REGULAR);
-		if (faction == EntityFaction::EVIL) {
+		newEntity = m_bulletPool.Create(this, startingPosition, orientation, faction, EntityType::BULLET, BulletType::REGULAR);
+		if (newEntity && (faction == EntityFaction::EVIL)) {
 			newEntity->m_health = 1;
 		}
 		break;
 	case EntityType::FLAMETHROWER_BULLET:
-		newEntity = new Bullet(this, startingPosition, orientation, faction, EntityType::FLAMETHROWER_BULLET, BulletType::FLAMETHROWER);
+		newEntity = m_bulletPool.Create(this, startingPosition, orientation, faction, EntityType::FLAMETHROWER_BULLET, BulletType::FLAMETHROWER);
 		break;
 	case EntityType::BOLT:
-		newEntity = new GuidedMissile(this, startingPosition, orientation, faction, EntityType::BOLT);
+		newEntity = m_guidedMissilePool.Create(this, startingPosition, orientation, faction, EntityType::BOLT);
 		break;
 	case EntityType::PLAYER:
 		newEntity = new PlayerTank(this, startingPosition, orientation, faction, EntityType::PLAYER);
 		m_hasPlayerBeenCreated = true;
 		break;
 	case EntityType::EXPLOSION:
-		newEntity = new Explosion(this, startingPosition, orientation, faction, EntityType::EXPLOSION);
+		newEntity = m_explosionPool.Create(this, startingPosition, orientation, faction, EntityType::EXPLOSION);
 		break;
 	default:
 		ERROR_AND_DIE("NOT A VALID NEW ENTITY!");
@@ -491,19 +493,33 @@ Entity* Map::CreateEntity(EntityType type, EntityFaction faction, Vec2 const& st
 	return newEntity;
 }
 
+void Map::DestroyEntity(Entity* entity)
+{
+	switch (entity->m_type) {
+	case EntityType::WALLRUBBLE:
+	case EntityType::ENEMYRUBBLE:
+		m_rubblePool.Destroy(static_cast<Rubble*>(entity));
+		break;
+	case EntityType::BULLET:
+	case EntityType::FLAMETHROWER_BULLET:
+		m_bulletPool.Destroy(static_cast<Bullet*>(entity));
+		break;
+	case EntityType::BOLT:
+		m_guidedMissilePool.Destroy(static_cast<GuidedMissile*>(entity));
+		break;
+	case EntityType::EXPLOSION:
+		m_explosionPool.Destroy(static_cast<Explosion*>(entity));
+		break;
+	default:
+		delete entity;
+		break;
+	}
+}
 
 
-
+// Lists are kept packed, with no empty entries: removing moves the last entity into the removed one's place
 void Map::AddEntityToList(Entity* newEntity, EntityList& list)
 {
-	for (int listIndex = 0; listIndex < (int)list.size(); listIndex++) {
-		Entity*& entity = list[listIndex];
-		if (!entity) {
-			entity = newEntity;
-			return;
-		}
-	}
-
 	list.push_back(newEntity);
 }
 
@@ -516,7 +532,8 @@ void Map::RemoveEntityFromList(Entity& entityToRemove, EntityList& list) {
 		}
 
 		if (entity == &entityToRemove) {
-			entity = nullptr;
+			entity = list.back();
+			list.pop_back();
 			return;
 		}
 	}
@@ -648,7 +665,7 @@ void Map::UpdateEntities(float deltaSeconds)
 {
 	for (int entityTypeIndex = 0; entityTypeIndex < (int)EntityType::NUM_ENTITIES; entityTypeIndex++) {
 		for (int entityIndex = 0; entityIndex < m_entitiesByType[entityTypeIndex].size(); entityIndex++) {
-			Entity*& entity = m_entitiesByType[entityTypeIndex][entityIndex];
+			Entity* entity = m_entitiesByType[entityTypeIndex][entityIndex];
 			if (entity) {
 				entity->Update(deltaSeconds);
 			}
@@ -726,8 +743,9 @@ void Map::RenderEntitiesHealthBars() const
 
 void Map::DeleteGarbageEntities()
 {
-	for (int entityIndex = 0; entityIndex < m_allEntities.size(); entityIndex++) {
-		Entity*& entity = m_allEntities[entityIndex];
+	// Backwards, since removing moves the last entity of the list into the removed one's place
+	for (int entityIndex = (int)m_allEntities.size() - 1; entityIndex >= 0; entityIndex--) {
+		Entity* entity = m_allEntities[entityIndex];
 		if (!entity) continue;
 
 		if (!IsAlive(entity)) {
@@ -735,7 +753,7 @@ void Map::DeleteGarbageEntities()
 				continue;
 			}
 			RemoveEntityFromMap(*entity);
-			delete entity;
+			DestroyEntity(entity);
 		}
 
 	}
@@ -927,7 +945,7 @@ void Map::CheckEntitiesAgainstBullets()
 void Map::CheckEntityAgainstBulletGroup(Entity& entityToCheck, EntityList& bulletList)
 {
 	for (int bulletIndex = 0; bulletIndex < bulletList.size(); bulletIndex++) {
-		Entity*& bullet = bulletList[bulletIndex];
+		Entity* bullet = bulletList[bulletIndex]; // Not a reference: reacting can spawn entities and grow the list
 		if (!bullet) continue;
 		if (DoDiscsOverlap(bullet->m_position, bullet->m_physicsRadius, entityToCheck.m_position, entityToCheck.m_physicsRadius)) {
 			Bullet* certainlyABullet = reinterpret_cast<Bullet*>(bullet);
@@ -1011,13 +1029,14 @@ void Map::AddVertsForTiles()
 
 
 	Entity const* debuggedEntity = nullptr;
-	if (m_entitiesByType[heatMapDebugListIndex].size() > 0) {
+	if (heatMapDebugEntityIndex < m_entitiesByType[heatMapDebugListIndex].size()) {
 		debuggedEntity = m_entitiesByType[heatMapDebugListIndex][heatMapDebugEntityIndex];
 	}
 
 	float maxHeatMapValue = 0.0f;
+	bool drawEntityHeatMap = g_drawDebugHeatMapEntity && IsAlive(debuggedEntity) && (debuggedEntity->m_heatMap.GetDimensions() == m_definition.m_dimensions);
 
-	if (g_drawDebugHeatMapEntity && IsAlive(debuggedEntity)) {
+	if (drawEntityHeatMap) {
 		maxHeatMapValue = debuggedEntity->m_heatMap.GetMaxValue();
 	}
 
@@ -1043,7 +1062,7 @@ void Map::AddVertsForTiles()
 			IntVec2 tileCoords = GetTileCoordsForIndex(tileIndex);
 		}
 
-		if (g_drawDebugHeatMapEntity && IsAlive(debuggedEntity)) {
+		if (drawEntityHeatMap) {
 			float heatMapValue = debuggedEntity->m_heatMap.GetValue(tileIndex);
 			float gradient = RangeMapClamped(heatMapValue, 0, maxHeatMapValue, 0, 255);
 			unsigned char gradientAsUChar = static_cast<unsigned char>(gradient);
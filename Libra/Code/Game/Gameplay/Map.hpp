@@ -3,9 +3,14 @@
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Core/HeatMaps.hpp"
+#include "Engine/Core/EntityPool.hpp"
 #include "Engine/Math/RaycastUtils.hpp"
 #include "Game/Gameplay/Tile.hpp"
 #include "Game/Gameplay/Entity.hpp"
+#include "Game/Gameplay/Bullet.hpp"
+#include "Game/Gameplay/GuidedMissile.hpp"
+#include "Game/Gameplay/Explosion.hpp"
+#include "Game/Gameplay/Rubble.hpp"
 #include "Game/Gameplay/MapDefinition.hpp"
 
 #include <vector>
@@ -88,6 +93,7 @@ private:
 
 	void SpawnEntities();
 	Entity* CreateEntity(EntityType type, EntityFaction faction, Vec2 const& startingPosition, float orientation);
+	void DestroyEntity(Entity* entity);
 
 	Vec2 const GetRandomSpawnPoint(bool canSwim = false) const;
 
@@ -149,6 +155,13 @@ private:
 	EntityList m_bulletsByFaction[(int)EntityFaction::NUM_FACTIONS];
 	EntityList m_rubble;
 
+	// Projectiles and effects are spawned and destroyed constantly, so they come out of pools. Actors are few and the
+	// player moves between maps, so they stay individually allocated
+	EntityPool<Bullet> m_bulletPool = EntityPool<Bullet>(g_gameConfigBlackboard.GetValue("MAX_BULLETS_PER_MAP", 1024));
+	EntityPool<GuidedMissile> m_guidedMissilePool = EntityPool<GuidedMissile>(g_gameConfigBlackboard.GetValue("MAX_GUIDED_MISSILES_PER_MAP", 128));
+	EntityPool<Explosion> m_explosionPool = EntityPool<Explosion>(g_gameConfigBlackboard.GetValue("MAX_EXPLOSIONS_PER_MAP", 512));
+	EntityPool<Rubble> m_rubblePool = EntityPool<Rubble>(g_gameConfigBlackboard.GetValue("MAX_RUBBLE_PER_MAP", 512));
+
 	int heatMapDebugEntityIndex = 0;
 	int heatMapDebugListIndex = 0;
 
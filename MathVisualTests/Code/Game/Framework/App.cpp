@@ -56,6 +56,12 @@ void App::Startup()
 	g_gameConfigBlackboard.SetValue("TEXT_CELL_HEIGHT", std::to_string(TEXT_CELL_HEIGHT));
 	g_gameConfigBlackboard.SetValue("TEXT_CELL_HEIGHT_ATTRACT_SCREEN", std::to_string(TEXT_CELL_HEIGHT_ATTRACT_SCREEN));
 	
+	JobSystemConfig jobSystemConfig{
+	(int)std::thread::hardware_concurrency() // This conversion is safe
+	};
+
+	g_theJobSystem = new JobSystem(jobSystemConfig);
+
 	EventSystemConfig eventSystemConfig;
 	g_theEventSystem = new EventSystem(eventSystemConfig);
 
@@ -81,6 +87,7 @@ void App::Startup()
 
 	g_theGame = new Game(this);
 
+	g_theJobSystem->Startup();
 	g_theEventSystem->Startup();
 	g_theConsole->Startup();
 	g_theInput->Startup();
@@ -178,6 +185,10 @@ void App::Shutdown()
 	g_theEventSystem->Shutdown();
 	delete g_theEventSystem;
 	g_theEventSystem = nullptr;
+
+	g_theJobSystem->Shutdown();
+	delete g_theJobSystem;
+	g_theJobSystem = nullptr;
 }
 
 
@@ -368,6 +368,7 @@ void Shapes3DMode::RenderShapes() const
 
 	g_theRenderer->SetModelMatrix(Mat44());
 	std::vector<Vertex_PCU> basisVerts;
+	basisVerts.reserve(3 * GetVertCountForArrow3D(8));
 	Mat44 playerModel = m_player->GetModelMatrix();
 	Vec3 playerFwd = playerModel.GetIBasis3D() * 0.25f;
 	Vec3 basisDisp = m_worldCamera.GetViewPosition() + playerFwd;
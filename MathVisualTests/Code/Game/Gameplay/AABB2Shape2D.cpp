@@ -9,18 +9,18 @@ AABB2Shape2D::AABB2Shape2D(Vec2 const& dimensions, Vec2 const& center, Rgba8 con
 
 void AABB2Shape2D::Render() const
 {
-	std::vector<Vertex_PCU> worldVerts;
-	AddVertsForAABB2D(worldVerts, m_AABB2, m_color);
+	Vertex_PCU worldVerts[6];
+	Vertex_PCU* vertsEnd = AddVertsForAABB2D(worldVerts, m_AABB2, m_color);
 
-	g_theRenderer->DrawVertexArray(worldVerts);
+	g_theRenderer->DrawVertexArray((unsigned int)(vertsEnd - worldVerts), worldVerts);
 }
 
 void AABB2Shape2D::RenderHighlighted() const
 {
-	std::vector<Vertex_PCU> worldVerts;
-	AddVertsForAABB2D(worldVerts, m_AABB2, m_highlightedColor);
+	Vertex_PCU worldVerts[6];
+	Vertex_PCU* vertsEnd = AddVertsForAABB2D(worldVerts, m_AABB2, m_highlightedColor);
 
-	g_theRenderer->DrawVertexArray(worldVerts);
+	g_theRenderer->DrawVertexArray((unsigned int)(vertsEnd - worldVerts), worldVerts);
 }
 
 Vec2 AABB2Shape2D::GetNearestPoint(Vec2 const& refPoint) const
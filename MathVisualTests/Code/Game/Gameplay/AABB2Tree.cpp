@@ -1 +0,0 @@
-#include "Game/Gameplay/AABB2Tree.hpp"
@@ -11,18 +11,18 @@ CapsuleShape2D::CapsuleShape2D(Vec2 const& lineStart, Vec2 const& lineEnd, float
 
 void CapsuleShape2D::Render() const
 {
-	std::vector<Vertex_PCU> worldVerts;
-	AddVertsForCapsule2D(worldVerts, m_capsule, m_color);
+	m_renderVerts.clear();
+	AddVertsForCapsule2D(m_renderVerts, m_capsule, m_color);
 
-	g_theRenderer->DrawVertexArray(worldVerts);
+	g_theRenderer->DrawVertexArray(m_renderVerts);
 }
 
 void CapsuleShape2D::RenderHighlighted() const
 {
-	std::vector<Vertex_PCU> worldVerts;
-	AddVertsForCapsule2D(worldVerts, m_capsule, m_highlightedColor);
+	m_renderVerts.clear();
+	AddVertsForCapsule2D(m_renderVerts, m_capsule, m_highlightedColor);
 
-	g_theRenderer->DrawVertexArray(worldVerts);
+	g_theRenderer->DrawVertexArray(m_renderVerts);
 }
 
 Vec2 CapsuleShape2D::GetNearestPoint(Vec2 const& refPoint) const
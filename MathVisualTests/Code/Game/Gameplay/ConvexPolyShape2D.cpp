@@ -21,21 +21,21 @@ void ConvexPolyShape2D::AddVertsForFillings(std::vector<Vertex_PCU>& vertexes) c
 
 void ConvexPolyShape2D::Render() const
 {
-	std::vector<Vertex_PCU> worldVerts;
-	AddVertsForWireConvexPoly2D(worldVerts, m_convexPoly2D,  Rgba8::WHITE);
-	AddVertsForConvexPoly2D(worldVerts, m_convexPoly2D,  m_color);
+	m_renderVerts.clear();
+	AddVertsForWireConvexPoly2D(m_renderVerts, m_convexPoly2D,  Rgba8::WHITE);
+	AddVertsForConvexPoly2D(m_renderVerts, m_convexPoly2D,  m_color);
 	//AddVertsForConvexHull2D(worldVerts, m_convexPoly2D.GetConvexHull(), Rgba8::WHITE, 1000.0f);
 
-	g_theRenderer->DrawVertexArray(worldVerts);
+	g_theRenderer->DrawVertexArray(m_renderVerts);
 }
 
 void ConvexPolyShape2D::RenderHighlighted() const
 {
-	std::vector<Vertex_PCU> worldVerts;
-	AddVertsForWireConvexPoly2D(worldVerts, m_convexPoly2D, Rgba8::WHITE);
-	AddVertsForConvexPoly2D(worldVerts, m_convexPoly2D, m_highlightedColor);
+	m_renderVerts.clear();
+	AddVertsForWireConvexPoly2D(m_renderVerts, m_convexPoly2D, Rgba8::WHITE);
+	AddVertsForConvexPoly2D(m_renderVerts, m_convexPoly2D, m_highlightedColor);
 	//AddVertsForConvexHull2D(worldVerts, m_convexPoly2D.GetConvexHull(), Rgba8::WHITE, 1000.0f);
-	g_theRenderer->DrawVertexArray(worldVerts);
+	g_theRenderer->DrawVertexArray(m_renderVerts);
 }
 
 Vec2 ConvexPolyShape2D::GetNearestPoint(Vec2 const& refPoint) const
@@ -2,6 +2,12 @@
 #include "Game/Gameplay/ConvexSceneUtils.hpp"
 
 
+unsigned int GetTocSize(unsigned int numTocEntries)
+{
+	// Header, entry count, one type byte plus start and size per entry, end sequence
+	return 4 + 1 + numTocEntries * 9 + 4;
+}
+
 bool ParseHeader(BufferParser& bufferParser, unsigned char& endianness, unsigned int& tocLocation)
 {
 	bool isEverythingRight = true;
@@ -20,6 +20,7 @@ enum ChunkType : unsigned char {
 	BSPChunk = 0x8B,
 	CompositeTreeChunk = 0x8C,
 	ConvexPolyTreeChunk = 0x8D,
+	AABB2TreeNodesChunk = 0x8E, // Engine AABB2Tree node array, loads without rebuilding the tree
 	ObjectColorsChunk = 0xE0,
 	SceneGeneralDebugChunk = 0xF0,
 	SceneRaycastDebugChunk = 0xF1,
@@ -28,6 +29,12 @@ enum ChunkType : unsigned char {
 
 
 
+constexpr unsigned int SCENE_HEADER_SIZE = 16;
+constexpr unsigned int SCENE_TOC_LOCATION_OFFSET = 8;
+constexpr unsigned int CHUNK_HEADER_AND_END_SIZE = 14;
+
+unsigned int GetTocSize(unsigned int numTocEntries);
+
 bool ParseHeader(BufferParser& bufferParser, unsigned char& endianness, unsigned int& tocLocation);
 bool ParseChunkHeader(BufferParser& bufferParser, ChunkType& chunkType, unsigned char& chunkEndianness, unsigned int& chunkSize);
 bool ParseChunkHeaderEndSequence(BufferParser& bufferParser);
@@ -9,18 +9,18 @@ DiscShape2D::DiscShape2D(Vec2 const& center, float radius, Rgba8 const& color, R
 
 void DiscShape2D::Render() const
 {
-	std::vector<Vertex_PCU> worldVerts;
-	AddVertsForDisc2D(worldVerts, m_position, m_radius, m_color);
+	m_renderVerts.clear();
+	AddVertsForDisc2D(m_renderVerts, m_position, m_radius, m_color);
 
-	g_theRenderer->DrawVertexArray(worldVerts);
+	g_theRenderer->DrawVertexArray(m_renderVerts);
 }
 
 void DiscShape2D::RenderHighlighted() const
 {
-	std::vector<Vertex_PCU> worldVerts;
-	AddVertsForDisc2D(worldVerts, m_position, m_radius, m_highlightedColor);
+	m_renderVerts.clear();
+	AddVertsForDisc2D(m_renderVerts, m_position, m_radius, m_highlightedColor);
 
-	g_theRenderer->DrawVertexArray(worldVerts);
+	g_theRenderer->DrawVertexArray(m_renderVerts);
 }
 
 Vec2 DiscShape2D::GetNearestPoint(Vec2 const& refPoint) const
@@ -11,18 +11,18 @@ OBB2Shape2D::OBB2Shape2D(Vec2 const& halfDimensions, Vec2 const& position, float
 
 void OBB2Shape2D::Render() const
 {
-	std::vector<Vertex_PCU> worldVerts;
-	AddVertsForOBB2D(worldVerts, m_OBB2, m_color);
+	Vertex_PCU worldVerts[6];
+	Vertex_PCU* vertsEnd = AddVertsForOBB2D(worldVerts, m_OBB2, m_color);
 
-	g_theRenderer->DrawVertexArray(worldVerts);
+	g_theRenderer->DrawVertexArray((unsigned int)(vertsEnd - worldVerts), worldVerts);
 }
 
 void OBB2Shape2D::RenderHighlighted() const
 {
-	std::vector<Vertex_PCU> worldVerts;
-	AddVertsForOBB2D(worldVerts, m_OBB2, m_highlightedColor);
+	Vertex_PCU worldVerts[6];
+	Vertex_PCU* vertsEnd = AddVertsForOBB2D(worldVerts, m_OBB2, m_highlightedColor);
 
-	g_theRenderer->DrawVertexArray(worldVerts);
+	g_theRenderer->DrawVertexArray((unsigned int)(vertsEnd - worldVerts), worldVerts);
 }
 
 Vec2 OBB2Shape2D::GetNearestPoint(Vec2 const& refPoint) const
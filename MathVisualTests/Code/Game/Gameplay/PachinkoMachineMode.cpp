@@ -144,22 +144,23 @@ void PachinkoMachineMode::Render() const
 
 	//g_theRenderer->DrawVertexArray(m_raycastVsDiscCollisionVerts);
 
-	std::vector<Vertex_PCU> arrowVerts;
+	Vertex_PCU arrowVerts[18]; // At most two arrows
+	Vertex_PCU* arrowVertsEnd = arrowVerts;
 
 	if (m_impactedDisc) {
 		if (m_raycastResult.m_impactDist >= 1.0f) {
-			AddVertsForArrow2D(arrowVerts, m_rayStart, m_raycastResult.m_impactPos, Rgba8::RED, 0.5f);
+			arrowVertsEnd = AddVertsForArrow2D(arrowVertsEnd, m_rayStart, m_raycastResult.m_impactPos, Rgba8::RED, 0.5f);
 		}
-		AddVertsForArrow2D(arrowVerts, m_raycastResult.m_impactPos, m_rayEnd, Rgba8::GRAY, 0.5f);
+		arrowVertsEnd = AddVertsForArrow2D(arrowVertsEnd, m_raycastResult.m_impactPos, m_rayEnd, Rgba8::GRAY, 0.5f);
 	}
 	else {
-		AddVertsForArrow2D(arrowVerts, m_rayStart, m_rayEnd, Rgba8::GREEN, 0.5f);
+		arrowVertsEnd = AddVertsForArrow2D(arrowVertsEnd, m_rayStart, m_rayEnd, Rgba8::GREEN, 0.5f);
 	}
 
 	DebugDrawRing(m_rayStart, m_ballSizeRange.m_min, 0.25f, Rgba8::WHITE);
 	DebugDrawRing(m_rayStart, m_ballSizeRange.m_max, 0.25f, Rgba8::WHITE);
 
-	g_theRenderer->DrawVertexArray(arrowVerts);
+	g_theRenderer->DrawVertexArray((unsigned int)(arrowVertsEnd - arrowVerts), arrowVerts);
 	g_theRenderer->EndCamera(m_worldCamera);
 
 	RenderUI();
@@ -19,11 +19,13 @@ void RaycastVsBoxes2DMode::Startup()
 {
 	Rgba8 transparentBlue(0, 0, 255, 120);
 	Rgba8 solidBlue(0, 0, 255, 220);
+	m_boxPacket.Reserve(m_amountOfBoxes);
 	for (int boxIndex = 0; boxIndex < m_amountOfBoxes; boxIndex++) {
 		float randDimX = rng.GetRandomFloatInRange(10.0f, 20.0f);
 		float randDimY = rng.GetRandomFloatInRange(10.0f, 20.0f);
 		AABB2Shape2D* newBox = new AABB2Shape2D(Vec2(randDimX, randDimY), GetClampedRandomPositionInWorld(randDimX), transparentBlue, solidBlue);
 		m_allShapes.push_back(newBox);
+		m_boxPacket.AddBox(newBox->m_AABB2);
 	}
 
 }
@@ -41,6 +43,7 @@ void RaycastVsBoxes2DMode::Shutdown()
 	m_allShapes.clear();
 	m_normalColorShapes.clear();
 	m_highlightedShapes.clear();
+	m_boxPacket.Clear();
 }
 
 void RaycastVsBoxes2DMode::Update(float deltaSeconds)
@@ -65,19 +68,20 @@ void RaycastVsBoxes2DMode::Render() const
 
 	g_theRenderer->DrawVertexArray(m_raycastVsBoxesCollisionVerts);
 
-	std::vector<Vertex_PCU> arrowVerts;
+	Vertex_PCU arrowVerts[18]; // At most two arrows
+	Vertex_PCU* arrowVertsEnd = arrowVerts;
 
 	if (m_impactedBox) {
 		if (m_raycastResult.m_impactDist >= 1.0f) {
-			AddVertsForArrow2D(arrowVerts, m_rayStart, m_raycastResult.m_impactPos, Rgba8::RED, 0.5f);
+			arrowVertsEnd = AddVertsForArrow2D(arrowVertsEnd, m_rayStart, m_raycastResult.m_impactPos, Rgba8::RED, 0.5f);
 		}
-		AddVertsForArrow2D(arrowVerts, m_raycastResult.m_impactPos, m_rayEnd, Rgba8::GRAY, 0.5f);
+		arrowVertsEnd = AddVertsForArrow2D(arrowVertsEnd, m_raycastResult.m_impactPos, m_rayEnd, Rgba8::GRAY, 0.5f);
 	}
 	else {
-		AddVertsForArrow2D(arrowVerts, m_rayStart, m_rayEnd, Rgba8::GREEN, 0.5f);
+		arrowVertsEnd = AddVertsForArrow2D(arrowVertsEnd, m_rayStart, m_rayEnd, Rgba8::GREEN, 0.5f);
 	}
 
-	g_theRenderer->DrawVertexArray(arrowVerts);
+	g_theRenderer->DrawVertexArray((unsigned int)(arrowVertsEnd - arrowVerts), arrowVerts);
 	g_theRenderer->EndCamera(m_worldCamera);
 
 	RenderUI();
@@ -163,31 +167,12 @@ void RaycastVsBoxes2DMode::AddVertsForRaycastVsBoxes2D()
 	m_highlightedShapes.clear();
 	m_raycastVsBoxesCollisionVerts.clear();
 
-	float rayDistance = GetDistance2D(m_rayStart, m_rayEnd);
+	Vec2 rayForward = m_rayEnd - m_rayStart;
+	float rayDistance = rayForward.NormalizeAndGetPreviousLength();
 
-	m_impactedBox = false;
-	RaycastResult2D closestRaycast;
-	closestRaycast.m_impactDist = ARBITRARILY_LARGE_VALUE;
-	int closestImpactedShapeIndex = -1;
-
-	for (int shapeIndex = 0; shapeIndex < m_allShapes.size(); shapeIndex++) {
-		Shape2D* shape = m_allShapes[shapeIndex];
-		AABB2Shape2D const* shapeAsBox = dynamic_cast<AABB2Shape2D*>(shape);
-		if (!shape)continue;
-
-		RaycastResult2D raycastResult;
-		raycastResult = RaycastVsBox(m_rayStart, (m_rayEnd - m_rayStart).GetNormalized(), rayDistance, shapeAsBox->m_AABB2);
-
-
-		if (raycastResult.m_didImpact) {
-			if (raycastResult.m_impactDist < closestRaycast.m_impactDist) {
-				closestRaycast = raycastResult;
-				closestImpactedShapeIndex = shapeIndex;
-			}
-			m_impactedBox = true;
-		}
-
-	}
+	RaycastHit nearestHit = RaycastVsBoxes2D(m_rayStart, rayForward, rayDistance, m_boxPacket);
+	m_impactedBox = nearestHit.DidImpact();
+	int closestImpactedShapeIndex = nearestHit.m_index;
 
 	for (int shapeIndex = 0; shapeIndex < m_allShapes.size(); shapeIndex++) {
 		Shape2D* shape = m_allShapes[shapeIndex];
@@ -197,9 +182,11 @@ void RaycastVsBoxes2DMode::AddVertsForRaycastVsBoxes2D()
 
 	}
 
-	m_raycastResult = closestRaycast;
 	if (m_impactedBox) {
-		AddVertsForRaycastImpactOnBox(*m_allShapes[closestImpactedShapeIndex], m_raycastResult);
+		// Only the nearest box needs the full result, for the impact point and normal
+		AABB2Shape2D* closestBox = dynamic_cast<AABB2Shape2D*>(m_allShapes[closestImpactedShapeIndex]);
+		m_raycastResult = RaycastVsBox(m_rayStart, rayForward, rayDistance, closestBox->m_AABB2);
+		AddVertsForRaycastImpactOnBox(*closestBox, m_raycastResult);
 	}
 }
 
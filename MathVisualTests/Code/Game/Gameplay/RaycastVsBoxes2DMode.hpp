@@ -27,6 +27,7 @@ private:
 	std::vector<Shape2D*> m_highlightedShapes;
 	std::vector<Shape2D*> m_normalColorShapes;
 	std::vector<Vertex_PCU> m_raycastVsBoxesCollisionVerts;
+	AABB2Packet2D m_boxPacket;
 
 	Vec2 m_rayStart = Vec2::ZERO;
 	Vec2 m_rayEnd = Vec2::ZERO;
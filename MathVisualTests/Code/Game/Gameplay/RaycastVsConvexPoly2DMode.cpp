@@ -4,11 +4,8 @@
 #include "Engine/Core/FileUtils.hpp"
 #include "Game/Gameplay/RaycastVsConvexPoly2DMode.hpp"
 #include "Game/Gameplay/ConvexPolyShape2D.hpp"
-#include "Game/Gameplay/AABB2Tree.hpp"
-#include "Game/Gameplay/AABB2Shape2D.hpp"
 #include "Game/Gameplay/ConvexSceneUtils.hpp"
 #include "Engine/Core/NamedProperties.hpp"
-#include <queue>
 
 RaycastVsConvexPoly2DMode* pointerToSelf = nullptr;
 
@@ -20,6 +17,15 @@ struct TOCEntry {
 
 std::vector<TOCEntry> toc;
 
+Rgba8 const BVH_DEPTH_COLORS[] = {
+	Rgba8(255, 80, 80, 60),
+	Rgba8(80, 255, 80, 60),
+	Rgba8(80, 80, 255, 60),
+	Rgba8(255, 255, 80, 60),
+	Rgba8(255, 80, 255, 60),
+	Rgba8(80, 255, 255, 60),
+};
+
 TOCEntry* FindTocEntry(unsigned char chunkType) {
 	for (TOCEntry& entry : toc) {
 		if (entry.m_chunkType == chunkType) {
@@ -36,7 +42,7 @@ RaycastVsConvexPoly2DMode::RaycastVsConvexPoly2DMode(Game* pointerToGame, Vec2 c
 {
 	m_worldSize = cameraSize;
 	m_gameModeName = "Raycasts vs ConvexPoly2D";
-	m_helperText = "F8 to randomize. S/E set ray start/end; Hold T = slow, W/R = Rotate, U/I = +/- max depth, N/M = double/halve rays, ,/. = double/halve shapes";
+	m_helperText = "F8 to randomize. S/E set ray start/end; Hold T = slow, W/R = Rotate, F2/F3 = BVH/jobs, U/I = +/- BVH draw depth, N/M = double/halve rays, ,/. = double/halve shapes";
 	m_baseHelperText = m_helperText;
 	m_rayStart = Vec2(20.0f, 20.0f);
 	m_rayEnd = Vec2(100.0f, 40.0f);
@@ -77,20 +83,16 @@ void RaycastVsConvexPoly2DMode::Shutdown()
 		}
 	}
 
-	for (Shape2D* aabb2Shape : m_hitAABB2s) {
-		delete aabb2Shape;
-	}
-
 	delete m_shapesBuffer;
 	m_shapesBuffer = nullptr;
-	m_hitAABB2s.clear();
 	m_allShapes.clear();
 	m_allConvexPolys.clear();
 	m_normalColorShapes.clear();
 	m_highlightedShapes.clear();
 	m_existingPolys = 0;
 	DeleteAABB2Tree();
-	m_bvhDebugVerts.clear();
+	m_currentScene.Close();
+	m_currentScenePath.clear();
 	UnsubscribeEventCallbackFunction("SaveScene", RaycastVsConvexPoly2DMode::SaveGHCSScene);
 	UnsubscribeEventCallbackFunction("LoadScene", RaycastVsConvexPoly2DMode::LoadGHCSScene);
 	toc.clear();
@@ -103,9 +105,7 @@ void RaycastVsConvexPoly2DMode::Update(float deltaSeconds)
 	m_raycastCounter = 0;
 
 	if (m_isTreeDirty && m_useBVH) {
-		DeleteAABB2Tree();
-		CreateAABB2Tree();
-		m_isTreeDirty = false;
+		RebuildAABB2Tree();
 	}
 
 	if (m_halfPolygons) {
@@ -124,8 +124,6 @@ void RaycastVsConvexPoly2DMode::Update(float deltaSeconds)
 
 	if (m_didAnyShapeChange && !(m_isMovingShape || m_isChangingShape)) {
 		CreateVertexBuffer();
-		DeleteAABB2Tree();
-		CreateAABB2Tree();
 		m_didAnyShapeChange = false;
 	}
 
@@ -135,14 +133,23 @@ void RaycastVsConvexPoly2DMode::Update(float deltaSeconds)
 
 	m_helperText = m_baseHelperText;
 	m_helperText += (m_useBVH) ? ", BVH: ON" : ", BVH: OFF";
+	m_helperText += (m_useJobSystem) ? ", Jobs: ON" : ", Jobs: OFF";
+
+	float invisibleRaysPerSecond = 0.0f;
+	if (m_invisibleRaysTime > 0) {
+		invisibleRaysPerSecond = static_cast<float>(m_numInvisibleRays) * 1'000'000'000.0f / static_cast<float>(m_invisibleRaysTime);
+	}
+	float treeBuildTimeMs = static_cast<float>(m_treeBuildTime) / 1'000'000.0f;
 
 	DebugAddScreenText(Stringf("Invisible Rays: %d", m_numInvisibleRays), Vec2(0.0f, m_UICameraSize.y * 0.90f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
 	DebugAddScreenText(Stringf("Convex Poly Count %d", m_amountOfPolys), Vec2(0.0f, m_UICameraSize.y * 0.87f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
 	DebugAddScreenText(Stringf("Raycast Avg Time (ms): %f", raycastAvgTime), Vec2(0.0f, m_UICameraSize.y * 0.84f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
 	DebugAddScreenText(Stringf("Raycast Per MS: %.2f", raycastsPerMs), Vec2(0.0f, m_UICameraSize.y * 0.81f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
 	DebugAddScreenText(Stringf("Raycast Total: %.2f", raycastTimeFlt), Vec2(0.0f, m_UICameraSize.y * 0.78f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
-	DebugAddScreenText(Stringf("Max depth: %d", m_maxDepth), Vec2(0.0f, m_UICameraSize.y * 0.75f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
-	DebugAddScreenText(Stringf("FPS: %.2f", 1.0f / deltaSeconds), Vec2(0.0f, m_UICameraSize.y * 0.71f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
+	DebugAddScreenText(Stringf("BVH draw depth: %d, height: %d", m_maxDepth, m_convexPolyTree.GetHeight()), Vec2(0.0f, m_UICameraSize.y * 0.75f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
+	DebugAddScreenText(Stringf("Invisible Rays/s: %.0f, hits: %d, jobs: %d", invisibleRaysPerSecond, m_invisibleRayHitCount, m_invisibleRayJobCount), Vec2(0.0f, m_UICameraSize.y * 0.72f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
+	DebugAddScreenText(Stringf("BVH build (ms): %.2f", treeBuildTimeMs), Vec2(0.0f, m_UICameraSize.y * 0.69f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
+	DebugAddScreenText(Stringf("FPS: %.2f", 1.0f / deltaSeconds), Vec2(0.0f, m_UICameraSize.y * 0.66f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
 	GameMode::Update(deltaSeconds);
 }
 
@@ -167,19 +174,20 @@ void RaycastVsConvexPoly2DMode::Render() const
 	RenderHighlightedColorShapes();
 	g_theRenderer->DrawVertexArray(m_raycastVsConvexPolyCollisionVerts);
 
-	std::vector<Vertex_PCU> arrowVerts;
+	Vertex_PCU arrowVerts[18]; // At most two arrows
+	Vertex_PCU* arrowVertsEnd = arrowVerts;
 
 	if (m_impactedShape) {
 		if (m_raycastResult.m_impactDist >= 1.0f) {
-			AddVertsForArrow2D(arrowVerts, m_rayStart, m_raycastResult.m_impactPos, Rgba8::RED, 0.5f);
+			arrowVertsEnd = AddVertsForArrow2D(arrowVertsEnd, m_rayStart, m_raycastResult.m_impactPos, Rgba8::RED, 0.5f);
 		}
-		AddVertsForArrow2D(arrowVerts, m_raycastResult.m_impactPos, m_rayEnd, Rgba8::GRAY, 0.5f);
+		arrowVertsEnd = AddVertsForArrow2D(arrowVertsEnd, m_raycastResult.m_impactPos, m_rayEnd, Rgba8::GRAY, 0.5f);
 	}
 	else {
-		AddVertsForArrow2D(arrowVerts, m_rayStart, m_rayEnd, Rgba8::GREEN, 0.5f);
+		arrowVertsEnd = AddVertsForArrow2D(arrowVertsEnd, m_rayStart, m_rayEnd, Rgba8::GREEN, 0.5f);
 	}
 
-	g_theRenderer->DrawVertexArray(arrowVerts);
+	g_theRenderer->DrawVertexArray((unsigned int)(arrowVertsEnd - arrowVerts), arrowVerts);
 	g_theRenderer->EndCamera(m_worldCamera);
 
 	RenderUI();
@@ -268,38 +276,108 @@ void RaycastVsConvexPoly2DMode::RenderHighlightedColorShapes() const
 
 void RaycastVsConvexPoly2DMode::DoInvisibleRaycasts()
 {
-	//ProfileLogScope raycastsProfile("Raycast Profile", false, &m_raycastTotalTime);
-
+	m_invisibleRays.Clear();
+	m_invisibleRays.Reserve(m_numInvisibleRays);
 	for (int raycastInd = 0; raycastInd < m_numInvisibleRays; raycastInd++) {
 		Vec2 startRay = GetRandomPositionInWorld();
-		Vec2 endRay = GetRandomPositionInWorld();
+		Vec2 forward = GetRandomPositionInWorld() - startRay;
+		float rayLength = forward.NormalizeAndGetPreviousLength();
+		m_invisibleRays.AddRay(startRay, forward, rayLength);
+	}
 
-		if (m_useBVH) {
+	m_invisibleRaysTime = 0;
+	m_invisibleRayHitCount = 0;
+	m_invisibleRayJobCount = 0;
+	{
+		ProfileLogScope raycastsProfile("Raycast Profile", false, &m_invisibleRaysTime);
 
-			RaycastVsAABB2Tree(startRay, endRay, false);
+		if (m_useBVH) {
+			DoInvisibleRaycastsOnJobs();
 		}
 		else {
-			ProfileLogScope raycastsProfile("Raycast Profile", false, &m_raycastTotalTime);
+			for (int raycastInd = 0; raycastInd < m_numInvisibleRays; raycastInd++) {
+				Vec2 startRay(m_invisibleRays.m_startsX[raycastInd], m_invisibleRays.m_startsY[raycastInd]);
+				Vec2 forward(m_invisibleRays.m_forwardsX[raycastInd], m_invisibleRays.m_forwardsY[raycastInd]);
+				float rayLength = m_invisibleRays.m_maxDistances[raycastInd];
+				bool didHit = false;
+
+				for (Shape2D* shape : m_allShapes) {
+					ConvexPolyShape2D* asConvexPoly2D = dynamic_cast<ConvexPolyShape2D*>(shape);
+
+					if (asConvexPoly2D) {
+						RaycastResult2D raycastVsDisc = RaycastVsDisc(startRay, forward, rayLength, asConvexPoly2D->m_position, asConvexPoly2D->m_radius);
+						if (raycastVsDisc.m_didImpact) {
+							didHit = RaycastVsConvexHull2D(startRay, forward, rayLength, asConvexPoly2D->m_convexHull2D).m_didImpact || didHit;
+						}
+					}
+				}
 
-			Vec2 forward = endRay - startRay;
-			float rayLength = forward.NormalizeAndGetPreviousLength();
-			m_raycastCounter++;
+				m_invisibleRayHitCount += (didHit) ? 1 : 0;
+			}
+		}
+	}
 
-			for (Shape2D* shape : m_allShapes) {
-				ConvexPolyShape2D* asConvexPoly2D = dynamic_cast<ConvexPolyShape2D*>(shape);
+	m_raycastTotalTime += m_invisibleRaysTime;
+	m_raycastCounter += m_numInvisibleRays;
+}
 
-				if (asConvexPoly2D) {
-					RaycastResult2D raycastVsDisc = RaycastVsDisc(startRay, forward, rayLength, asConvexPoly2D->m_position, asConvexPoly2D->m_radius);
-					if (raycastVsDisc.m_didImpact) {
-						RaycastVsConvexHull2D(startRay, forward, rayLength, asConvexPoly2D->m_convexHull2D);
-					}
-				}
+void RaycastVsConvexPoly2DMode::DoInvisibleRaycastsOnJobs()
+{
+	int numRays = m_invisibleRays.GetCount();
+	int numJobs = (m_useJobSystem && g_theJobSystem) ? g_theJobSystem->GetNumThreads() : 0;
+	if (numJobs > numRays) {
+		numJobs = numRays;
+	}
+
+	if (numJobs <= 1) {
+		m_invisibleRayHits.resize(1);
+		TraceInvisibleRays(0, numRays, m_invisibleRayHits[0]);
+	}
+	else {
+		m_invisibleRayHits.resize(numJobs);
+		int raysPerJob = (numRays + numJobs - 1) / numJobs;
+		JobBatch raycastJobs(g_theJobSystem);
+		for (int jobIndex = 0; jobIndex < numJobs; jobIndex++) {
+			int firstRay = jobIndex * raysPerJob;
+			int jobRays = (firstRay + raysPerJob <= numRays) ? raysPerJob : numRays - firstRay;
+			if (jobRays <= 0) {
+				m_invisibleRayHits[jobIndex].clear();
+				continue;
 			}
+			raycastJobs.QueueJob(new ConvexPolyRaycastJob(this, firstRay, jobRays, &m_invisibleRayHits[jobIndex]));
+		}
+
+		m_invisibleRayJobCount = raycastJobs.GetNumJobs();
+		raycastJobs.WaitAndDeleteJobs();
+	}
+
+	for (std::vector<RaycastHit> const& jobHits : m_invisibleRayHits) {
+		for (RaycastHit const& hit : jobHits) {
+			m_invisibleRayHitCount += (hit.DidImpact()) ? 1 : 0;
 		}
+	}
+}
 
+void RaycastVsConvexPoly2DMode::TraceInvisibleRays(int firstRay, int numRays, std::vector<RaycastHit>& out_hits) const
+{
+	out_hits.resize(numRays);
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex++) {
+		int packetIndex = firstRay + rayIndex;
+		Vec2 rayStart(m_invisibleRays.m_startsX[packetIndex], m_invisibleRays.m_startsY[packetIndex]);
+		Vec2 rayForward(m_invisibleRays.m_forwardsX[packetIndex], m_invisibleRays.m_forwardsY[packetIndex]);
+		out_hits[rayIndex] = m_convexPolyTree.Raycast(rayStart, rayForward, m_invisibleRays.m_maxDistances[packetIndex], RaycastVsConvexPolyItem, const_cast<RaycastVsConvexPoly2DMode*>(this));
 	}
 }
 
+void ConvexPolyRaycastJob::Execute()
+{
+	m_gameMode->TraceInvisibleRays(m_firstRay, m_numRays, *m_hits);
+}
+
+void ConvexPolyRaycastJob::OnFinished()
+{
+}
+
 ConvexPolyShape2D* RaycastVsConvexPoly2DMode::GetShapeUnderMouse() const
 {
 	AABB2 worldBoundingBox(Vec2::ZERO, m_worldSize);
@@ -322,10 +400,15 @@ ConvexPolyShape2D* RaycastVsConvexPoly2DMode::GetShapeUnderMouse() const
 	return nullptr;
 }
 
-void RaycastVsConvexPoly2DMode::ParseToc(unsigned int tocStart)
+bool RaycastVsConvexPoly2DMode::ParseToc(unsigned int tocStart)
 {
 	toc.clear();
-	BufferParser buffParser(m_currentScene);
+	if (tocStart >= m_currentScene.GetSize()) {
+		ERROR_RECOVERABLE("TOC LOCATION IS OUTSIDE OF THE SCENE FILE");
+		return false;
+	}
+
+	BufferParser buffParser(m_currentScene.GetData(), m_currentScene.GetSize());
 	buffParser.GoToOffset(tocStart);
 
 	buffParser.SetEndianness((BufferEndianness)m_currentFileEndianness);
@@ -333,7 +416,7 @@ void RaycastVsConvexPoly2DMode::ParseToc(unsigned int tocStart)
 	bool isHeaderCorrect = ParseTocHeader(buffParser);
 	if (!isHeaderCorrect) {
 		ERROR_RECOVERABLE("TOC HEADER IS INCORRECT");
-		return;
+		return false;
 	}
 
 	unsigned char tocEntries = buffParser.ParseChar();
@@ -343,22 +426,31 @@ void RaycastVsConvexPoly2DMode::ParseToc(unsigned int tocStart)
 		newEntry.m_chunkType = buffParser.ParseChar();
 		newEntry.m_headerStart = buffParser.ParseUint32();
 		newEntry.m_chunkTotalSize = buffParser.ParseUint32();
+
+		// Chunks are decoded lazily, so a bad entry has to be caught here rather than when it gets used
+		if (((size_t)newEntry.m_headerStart + (size_t)newEntry.m_chunkTotalSize) > m_currentScene.GetSize()) {
+			ERROR_RECOVERABLE("TOC ENTRY POINTS OUTSIDE OF THE SCENE FILE");
+			toc.clear();
+			return false;
+		}
 		toc.push_back(newEntry);
 	}
 
 	bool isEndSeqCorrect = ParseTocEndSequence(buffParser);
 	if (!isEndSeqCorrect) {
 		ERROR_RECOVERABLE("TOC END SEQUENCE IS INCORRECT");
-		return;
+		toc.clear();
+		return false;
 	}
 
+	return true;
 }
 
-void RaycastVsConvexPoly2DMode::AppendToc(std::vector<unsigned char>& sceneBuffer) const
+void RaycastVsConvexPoly2DMode::AppendToc(std::vector<unsigned char>& sceneBuffer, unsigned char endianness) const
 {
 	WriteTocHeaderToBuffer(sceneBuffer);
 
-	BufferWriter bufWriter(sceneBuffer);
+	BufferWriter bufWriter(sceneBuffer, (BufferEndianness)endianness);
 	bufWriter.AppendeByte((unsigned char)toc.size());
 	for (TOCEntry entry : toc) {
 		bufWriter.AppendChar(entry.m_chunkType);
@@ -407,7 +499,7 @@ void RaycastVsConvexPoly2DMode::WriteSceneChunkToBuffer(std::vector<unsigned cha
 
 	WriteChunkHeaderEndSequence(fileBuffer);
 
-	CreateOrUpdateTocEntry(ChunkType::SceneInfoChunk, 34, chunkHeaderStart);
+	CreateOrUpdateTocEntry(ChunkType::SceneInfoChunk, 34, m_chunkWriteOffset + chunkHeaderStart);
 
 }
 
@@ -439,7 +531,7 @@ void RaycastVsConvexPoly2DMode::WriteConvexPolyChunkToBuffer(std::vector<unsigne
 
 	bufWriter.OverwriteUint32(chunkSizePos, chunkSize);
 
-	CreateOrUpdateTocEntry(ChunkType::ConvexPolysChunk, totalChunkSize, chunkHeaderStart);
+	CreateOrUpdateTocEntry(ChunkType::ConvexPolysChunk, totalChunkSize, m_chunkWriteOffset + chunkHeaderStart);
 
 
 }
@@ -475,7 +567,7 @@ void RaycastVsConvexPoly2DMode::WriteBoundingDiscsChunkToBuffer(std::vector<unsi
 
 	bufWriter.OverwriteUint32(chunkSizePos, chunkSize);
 
-	CreateOrUpdateTocEntry(ChunkType::BoundingDiscsChunk, totalChunkSize, chunkHeaderStart);
+	CreateOrUpdateTocEntry(ChunkType::BoundingDiscsChunk, totalChunkSize, m_chunkWriteOffset + chunkHeaderStart);
 
 }
 
@@ -493,20 +585,48 @@ void RaycastVsConvexPoly2DMode::WriteAABB2TreeChunkToBuffer(std::vector<unsigned
 
 	unsigned int startingChunkPos = (unsigned int)fileBuffer.size();
 
-	std::vector<AABB2TreeNode*> allTreeNodes;
-	int amountOfNodes = 0;
-	GetAABB2TreeInVector(allTreeNodes, -1, amountOfNodes);
-
-	bufWriter.AppendUint32((unsigned int)amountOfNodes);
-	for (int nodeNumber = 0; nodeNumber < allTreeNodes.size(); nodeNumber++) {
-		AABB2TreeNode const* currentNode = allTreeNodes[nodeNumber];
-		if (!currentNode) continue;
-		bufWriter.AppendInt32(nodeNumber);
-
-		bufWriter.AppendAABB2(currentNode->m_bounds);
+	// Nodes are numbered as in a binary heap, children of node i are 2i+1 and 2i+2
+	std::vector<int> nodesToWrite;
+	std::vector<int> nodeNumbers;
+	std::vector<int> containedIndexes;
+	std::vector<int> nodesToGather;
+	if (m_convexPolyTree.GetRootIndex() != -1) {
+		nodesToWrite.push_back(m_convexPolyTree.GetRootIndex());
+		nodeNumbers.push_back(0);
+	}
+
+	for (int writeIndex = 0; writeIndex < (int)nodesToWrite.size(); writeIndex++) {
+		AABB2TreeNode const& node = m_convexPolyTree.GetNode(nodesToWrite[writeIndex]);
+		if (node.IsLeaf()) continue;
+		nodesToWrite.push_back(node.m_firstChild);
+		nodeNumbers.push_back(nodeNumbers[writeIndex] * 2 + 1);
+		nodesToWrite.push_back(node.m_secondChild);
+		nodeNumbers.push_back(nodeNumbers[writeIndex] * 2 + 2);
+	}
+
+	bufWriter.AppendUint32((unsigned int)nodesToWrite.size());
+	for (int writeIndex = 0; writeIndex < (int)nodesToWrite.size(); writeIndex++) {
+		AABB2TreeNode const& currentNode = m_convexPolyTree.GetNode(nodesToWrite[writeIndex]);
+		bufWriter.AppendInt32(nodeNumbers[writeIndex]);
+
+		bufWriter.AppendAABB2(currentNode.m_bounds);
+
+		containedIndexes.clear();
+		nodesToGather.clear();
+		nodesToGather.push_back(nodesToWrite[writeIndex]);
+		while (!nodesToGather.empty()) {
+			AABB2TreeNode const& gatheredNode = m_convexPolyTree.GetNode(nodesToGather.back());
+			nodesToGather.pop_back();
+			if (gatheredNode.IsLeaf()) {
+				containedIndexes.push_back(gatheredNode.m_itemIndex);
+				continue;
+			}
+			nodesToGather.push_back(gatheredNode.m_secondChild);
+			nodesToGather.push_back(gatheredNode.m_firstChild);
+		}
 
-		bufWriter.AppendUint32((unsigned int)currentNode->m_containedShapesIndexes.size());
-		for (int containedIndex : currentNode->m_containedShapesIndexes) {
+		bufWriter.AppendUint32((unsigned int)containedIndexes.size());
+		for (int containedIndex : containedIndexes) {
 			bufWriter.AppendInt32(containedIndex);
 		}
 
@@ -519,7 +639,44 @@ void RaycastVsConvexPoly2DMode::WriteAABB2TreeChunkToBuffer(std::vector<unsigned
 
 	bufWriter.OverwriteUint32(chunkSizePos, chunkSize);
 
-	CreateOrUpdateTocEntry(ChunkType::AABB2TreeChunk, totalChunkSize, chunkHeaderStart);
+	CreateOrUpdateTocEntry(ChunkType::AABB2TreeChunk, totalChunkSize, m_chunkWriteOffset + chunkHeaderStart);
+}
+
+void RaycastVsConvexPoly2DMode::WriteAABB2TreeNodesChunkToBuffer(std::vector<unsigned char>& fileBuffer, unsigned char endianness) const
+{
+	unsigned int chunkSize = 0; // Unknown at this time
+	unsigned int chunkHeaderStart = (unsigned int)fileBuffer.size();
+	unsigned int chunkSizePos = (unsigned int)fileBuffer.size() + 6;
+
+	WriteChunkHeaderToBuffer(fileBuffer, ChunkType::AABB2TreeNodesChunk, endianness, chunkSize);
+
+	BufferWriter bufWriter(fileBuffer, (BufferEndianness)endianness);
+
+	unsigned int startingChunkPos = (unsigned int)fileBuffer.size();
+
+	std::vector<AABB2TreeNode> const& nodes = m_convexPolyTree.GetNodes();
+	bufWriter.AppendUint32((unsigned int)nodes.size());
+	bufWriter.AppendInt32(m_convexPolyTree.GetRootIndex());
+
+	// Pads the nodes to a 4 byte boundary in the file, so a mapped scene can hand them to the tree without decoding
+	unsigned int nodesFilePos = m_chunkWriteOffset + (unsigned int)fileBuffer.size() + 1;
+	unsigned char numPaddingBytes = (unsigned char)((4 - (nodesFilePos % 4)) % 4);
+	bufWriter.AppendeByte(numPaddingBytes);
+	for (unsigned char paddingIndex = 0; paddingIndex < numPaddingBytes; paddingIndex++) {
+		bufWriter.AppendeByte(0);
+	}
+
+	bufWriter.AppendArray(nodes);
+
+	unsigned int endingChunkPos = (unsigned int)fileBuffer.size();
+	chunkSize = endingChunkPos - startingChunkPos;
+
+	WriteChunkHeaderEndSequence(fileBuffer);
+	unsigned int totalChunkSize = chunkSize + CHUNK_HEADER_AND_END_SIZE;
+
+	bufWriter.OverwriteUint32(chunkSizePos, chunkSize);
+
+	CreateOrUpdateTocEntry(ChunkType::AABB2TreeNodesChunk, totalChunkSize, m_chunkWriteOffset + chunkHeaderStart);
 }
 
 
@@ -555,18 +712,14 @@ void RaycastVsConvexPoly2DMode::ParseConvexPolyChunk(BufferParser& bufferParser)
 	for (unsigned int polyIndex = 0; polyIndex < numPolys; polyIndex++) {
 		unsigned char numVertexes = bufferParser.ParseByte();
 		std::vector<Vec2> vertexes;
-		vertexes.reserve(numVertexes);
-
-		for (int vertexIndex = 0; vertexIndex < numVertexes; vertexIndex++) {
-			Vec2 vertex = bufferParser.ParseVec2();
-			vertexes.push_back(vertex);
-		}
+		if (!bufferParser.ParseArray(vertexes, numVertexes)) return;
 
 		ConvexPolyShape2D* newPoly = new ConvexPolyShape2D(vertexes, transparentBlue, solidBlue);
 		newPoly->m_convexHull2D = newPoly->m_convexPoly2D.GetConvexHull();
 		m_allShapes.push_back(newPoly);
 		m_allConvexPolys.push_back(newPoly);
 	}
+	m_existingPolys = (int)m_allConvexPolys.size();
 
 	bool isEndRight = ParseChunkHeaderEndSequence(bufferParser);
 	if (!isEndRight) {
@@ -578,52 +731,60 @@ void RaycastVsConvexPoly2DMode::ParseConvexPolyChunk(BufferParser& bufferParser)
 
 void RaycastVsConvexPoly2DMode::ParseAABB2TreeChunk(BufferParser& bufferParser)
 {
-	m_bvhDebugVerts.clear();
-	std::vector<AABB2TreeNode*> allTreeNodes;
+	DeleteAABB2Tree();
 	unsigned int amountOfNodes = bufferParser.ParseUint32();
 
-	allTreeNodes.push_back(nullptr);
+	// Only the leaves are needed, the tree rebalances itself as they get inserted
 	for (unsigned int nodeIndex = 0; nodeIndex < amountOfNodes; nodeIndex++) {
-
-		AABB2TreeNode* newTreeNode = new AABB2TreeNode();
-
-		int nodeNumber = bufferParser.ParseInt32();
-		allTreeNodes[nodeNumber] = newTreeNode;
-
+		bufferParser.ParseInt32(); // Node number
 		AABB2 bounds = bufferParser.ParseAABB2();
 
-		newTreeNode->m_bounds = bounds;
-		AddVertsForAABB2D(m_bvhDebugVerts, newTreeNode->m_bounds, GetRandomColor());
-
-		allTreeNodes.push_back(nullptr);
-		allTreeNodes.push_back(nullptr);
-
 		unsigned int numContainedShapesIndexes = bufferParser.ParseUint32();
+		int firstContainedIndex = -1;
 		for (unsigned int shapeIndex = 0; shapeIndex < numContainedShapesIndexes; shapeIndex++) {
 			int containedIndex = bufferParser.ParseInt32();
-			newTreeNode->m_containedShapesIndexes.push_back(containedIndex);
+			if (shapeIndex == 0) {
+				firstContainedIndex = containedIndex;
+			}
+		}
+
+		// Out of range leaves are dropped here, LoadAABB2TreeFromScene then sees the tree is incomplete and rebuilds it
+		if (numContainedShapesIndexes != 1 || firstContainedIndex < 0 || firstContainedIndex >= (int)m_allShapes.size()) continue;
+
+		if (firstContainedIndex >= (int)m_convexPolyProxyIds.size()) {
+			m_convexPolyProxyIds.resize((size_t)firstContainedIndex + 1, -1);
 		}
+		m_convexPolyProxyIds[firstContainedIndex] = m_convexPolyTree.InsertProxy(bounds, firstContainedIndex);
 	}
+}
 
-	for (unsigned int nodeIndex = 0; nodeIndex < allTreeNodes.size(); nodeIndex++) {
-		AABB2TreeNode* treeNode = allTreeNodes[nodeIndex];
+void RaycastVsConvexPoly2DMode::ParseAABB2TreeNodesChunk(BufferParser& bufferParser)
+{
+	DeleteAABB2Tree();
+	unsigned int numNodes = bufferParser.ParseUint32();
+	int rootIndex = bufferParser.ParseInt32();
 
-		if (!treeNode) continue;
+	unsigned char numPaddingBytes = bufferParser.ParseByte();
+	for (unsigned char paddingIndex = 0; paddingIndex < numPaddingBytes; paddingIndex++) {
+		bufferParser.ParseByte();
+	}
 
-		int firstChild = (nodeIndex * 2) + 1;
-		int secondChild = (nodeIndex * 2) + 2;
+	// With this machine's byte order the nodes are used right where they sit in the mapped file
+	AABB2TreeNode const* nodes = bufferParser.ViewArray<AABB2TreeNode>(numNodes);
+	std::vector<AABB2TreeNode> swappedNodes;
+	if (!nodes) {
+		if (!bufferParser.ParseArray(swappedNodes, numNodes)) return;
+		nodes = swappedNodes.data();
+	}
 
-		if (firstChild < allTreeNodes.size()) {
-			treeNode->m_firstChild = allTreeNodes[firstChild];
-		}
-		if (firstChild < allTreeNodes.size()) {
-			treeNode->m_secondChild = allTreeNodes[secondChild];
-		}
+	if (!m_convexPolyTree.SetNodes(nodes, (int)numNodes, rootIndex, &m_convexPolyProxyIds)) {
+		ERROR_RECOVERABLE("AABB2 TREE NODES CHUNK IS CORRUPTED");
+		return;
 	}
 
-	if (allTreeNodes.size() > 0) {
-		m_convexPolyTreeRoot = allTreeNodes[0];
-		m_isTreeDirty = false;
+	bool isEndRight = ParseChunkHeaderEndSequence(bufferParser);
+	if (!isEndRight) {
+		ERROR_RECOVERABLE("CURRENT CHUNK END SEQUENCE IS INCORRECT");
 	}
 }
 
@@ -702,6 +863,9 @@ void RaycastVsConvexPoly2DMode::ParseChunk(BufferParser& bufferParser)
 		break;
 	case ConvexPolyTreeChunk:
 		break;
+	case AABB2TreeNodesChunk:
+		ParseAABB2TreeNodesChunk(bufferParser);
+		break;
 	case ObjectColorsChunk:
 		break;
 	case SceneGeneralDebugChunk:
@@ -719,7 +883,7 @@ void RaycastVsConvexPoly2DMode::ParseChunk(BufferParser& bufferParser)
 
 void RaycastVsConvexPoly2DMode::RewriteScene(std::vector<unsigned char>& saveBuffer, unsigned char chunkType, unsigned int headerStart, unsigned int totalChunkSize) const
 {
-	BufferParser bufParser(m_currentScene);
+	BufferParser bufParser(m_currentScene.GetData(), m_currentScene.GetSize());
 	bufParser.GoToOffset(headerStart);
 
 	ChunkType throwawayType = ChunkType::INVALID_CHUNK;
@@ -741,6 +905,9 @@ void RaycastVsConvexPoly2DMode::RewriteScene(std::vector<unsigned char>& saveBuf
 	case AABB2TreeChunk:
 		WriteAABB2TreeChunkToBuffer(saveBuffer, chunkEndianness);
 		break;
+	case AABB2TreeNodesChunk:
+		WriteAABB2TreeNodesChunkToBuffer(saveBuffer, chunkEndianness);
+		break;
 	case BoundingDiscsChunk:
 		WriteBoundingDiscsChunkToBuffer(saveBuffer, chunkEndianness);
 		break;
@@ -748,57 +915,153 @@ void RaycastVsConvexPoly2DMode::RewriteScene(std::vector<unsigned char>& saveBuf
 		ERROR_RECOVERABLE("TRYING TO WRITE AN INVALID CHUNK TO BUFFER");
 		break;
 	default:
-		CopyChunkAsIs(saveBuffer, headerStart, totalChunkSize);
+		CopyChunkAsIs(saveBuffer, chunkType, headerStart, totalChunkSize);
 		break;
 	}
 }
 
-void RaycastVsConvexPoly2DMode::CopyChunkAsIs(std::vector<unsigned char>& saveBuffer, unsigned int headerStart, unsigned int totalChunkSize) const
+void RaycastVsConvexPoly2DMode::CopyChunkAsIs(std::vector<unsigned char>& saveBuffer, unsigned char chunkType, unsigned int headerStart, unsigned int totalChunkSize) const
+{
+	unsigned int newHeaderStart = m_chunkWriteOffset + (unsigned int)saveBuffer.size();
+	unsigned char const* chunkStart = m_currentScene.GetData() + headerStart;
+	saveBuffer.insert(saveBuffer.end(), chunkStart, chunkStart + totalChunkSize);
+
+	CreateOrUpdateTocEntry(chunkType, totalChunkSize, newHeaderStart);
+}
+
+void RaycastVsConvexPoly2DMode::WriteMissingChunksToBuffer(std::vector<unsigned char>& saveBuffer) const
 {
-	unsigned int endPosition = headerStart + totalChunkSize;
-	saveBuffer.insert(saveBuffer.end(), m_currentScene[headerStart], m_currentScene[endPosition]);
+	unsigned char nativeEndianness = (unsigned char)GetNativeEndianness();
+	if (!FindTocEntry(ChunkType::SceneInfoChunk)) {
+		WriteSceneChunkToBuffer(saveBuffer, nativeEndianness);
+	}
+	if (!FindTocEntry(ChunkType::ConvexPolysChunk)) {
+		WriteConvexPolyChunkToBuffer(saveBuffer, nativeEndianness);
+	}
+	if (!FindTocEntry(ChunkType::BoundingDiscsChunk)) {
+		WriteBoundingDiscsChunkToBuffer(saveBuffer, nativeEndianness);
+	}
+	if (!FindTocEntry(ChunkType::AABB2TreeChunk)) {
+		WriteAABB2TreeChunkToBuffer(saveBuffer, nativeEndianness);
+	}
+	if (!FindTocEntry(ChunkType::AABB2TreeNodesChunk)) {
+		WriteAABB2TreeNodesChunkToBuffer(saveBuffer, nativeEndianness);
+	}
 }
 
-void RaycastVsConvexPoly2DMode::SaveSceneToFile(std::filesystem::path fileName) const
+void RaycastVsConvexPoly2DMode::SaveSceneToFile(std::filesystem::path fileName)
 {
 	fileName.replace_extension(".ghcs");
+	std::string filePath = fileName.string();
+
+	// The saved tree has to match the shapes. Tree chunks still pending in the mapped scene are valid and get copied
+	// as they are, unless one of the two is missing and has to be written from the actual tree
+	bool hasBothTreeChunks = FindTocEntry(ChunkType::AABB2TreeChunk) && FindTocEntry(ChunkType::AABB2TreeNodesChunk);
+	if (m_isTreeDirty && !(m_isTreeChunkPending && hasBothTreeChunks)) {
+		RebuildAABB2Tree();
+	}
+
+	bool isSavingCurrentScene = m_currentScene.IsOpen() && (filePath == m_currentScenePath);
+	if (isSavingCurrentScene) {
+		size_t supersededBytes = GetTocSize((unsigned int)toc.size());
+		for (TOCEntry const& entry : toc) {
+			if (m_isChunkDirty[entry.m_chunkType]) {
+				supersededBytes += entry.m_chunkTotalSize;
+			}
+		}
+
+		// Once dead space would outgrow the live data, a full rewrite compacts the file instead
+		size_t liveBytes = m_currentScene.GetSize() - m_sceneDeadBytes;
+		if ((m_sceneDeadBytes + supersededBytes) <= liveBytes) {
+			SaveSceneIncrementally();
+			return;
+		}
+	}
 
 	std::vector<unsigned char> newSceneBuffer;
-	newSceneBuffer.reserve(8000);
+	newSceneBuffer.reserve((m_currentScene.GetSize() > 8000) ? m_currentScene.GetSize() : 8000);
 
 	WriteHeaderToBuffer(newSceneBuffer);
 
-	if (m_rewritingExistingScene) {
-		for (TOCEntry const& entry : toc) {
-			RewriteScene(newSceneBuffer, entry.m_chunkType, entry.m_headerStart, entry.m_chunkTotalSize);
+	m_chunkWriteOffset = 0;
+	m_rewritingExistingScene = false;
+
+	// Clean chunks are copied straight from the mapped scene, only the dirty ones get serialized again
+	std::vector<TOCEntry> previousToc;
+	previousToc.swap(toc);
+	if (m_currentScene.IsOpen()) {
+		for (TOCEntry const& entry : previousToc) {
+			if (m_isChunkDirty[entry.m_chunkType]) {
+				RewriteScene(newSceneBuffer, entry.m_chunkType, entry.m_headerStart, entry.m_chunkTotalSize);
+			}
+			else {
+				CopyChunkAsIs(newSceneBuffer, entry.m_chunkType, entry.m_headerStart, entry.m_chunkTotalSize);
+			}
 		}
 	}
-	else {
-		unsigned char nativeEndianness = (unsigned char)GetNativeEndianness();
-		WriteSceneChunkToBuffer(newSceneBuffer, nativeEndianness);
-		WriteConvexPolyChunkToBuffer(newSceneBuffer, nativeEndianness);
-		WriteBoundingDiscsChunkToBuffer(newSceneBuffer, nativeEndianness);
-		WriteAABB2TreeChunkToBuffer(newSceneBuffer, nativeEndianness);
-	}
+	WriteMissingChunksToBuffer(newSceneBuffer);
 
 	unsigned int tocLocationStart = (unsigned int)newSceneBuffer.size();
 	BufferWriter bufWriter(newSceneBuffer);
-	bufWriter.OverwriteUint32(8, tocLocationStart);
-	AppendToc(newSceneBuffer);
+	bufWriter.OverwriteUint32(SCENE_TOC_LOCATION_OFFSET, tocLocationStart);
+	AppendToc(newSceneBuffer, (unsigned char)bufWriter.GetEndianness());
 
+	// The file may be the one currently mapped, which cannot be written over while the mapping is open
+	m_currentScene.Close();
+	FileWriteFromBuffer(newSceneBuffer, filePath);
 
-	FileWriteFromBuffer(newSceneBuffer, fileName.string());
+	m_currentScenePath = (MapSceneFile(filePath)) ? filePath : "";
 }
 
+void RaycastVsConvexPoly2DMode::SaveSceneIncrementally()
+{
+	// Dirty chunks and a new TOC are appended after everything already in the file, then the header is pointed at
+	// the new TOC. Clean chunks are never touched; whatever got superseded stays behind as dead space
+	std::vector<unsigned char> appendBuffer;
+	m_chunkWriteOffset = (unsigned int)m_currentScene.GetSize();
+	m_rewritingExistingScene = true;
+
+	for (int entryIndex = 0; entryIndex < (int)toc.size(); entryIndex++) {
+		TOCEntry entry = toc[entryIndex];
+		if (m_isChunkDirty[entry.m_chunkType]) {
+			RewriteScene(appendBuffer, entry.m_chunkType, entry.m_headerStart, entry.m_chunkTotalSize);
+		}
+	}
+	WriteMissingChunksToBuffer(appendBuffer);
+
+	unsigned int tocLocationStart = m_chunkWriteOffset + (unsigned int)appendBuffer.size();
+	AppendToc(appendBuffer, m_currentFileEndianness);
 
-void RaycastVsConvexPoly2DMode::LoadSceneFromFile(std::filesystem::path fileName)
+	std::vector<unsigned char> tocLocationBytes;
+	BufferWriter tocLocationWriter(tocLocationBytes, (BufferEndianness)m_currentFileEndianness);
+	tocLocationWriter.AppendUint32(tocLocationStart);
+
+	m_chunkWriteOffset = 0;
+	m_rewritingExistingScene = false;
+
+	m_currentScene.Close();
+	FileAppendFromBuffer(appendBuffer, m_currentScenePath);
+	FileOverwriteBytes(tocLocationBytes.data(), tocLocationBytes.size(), SCENE_TOC_LOCATION_OFFSET, m_currentScenePath);
+
+	if (!MapSceneFile(m_currentScenePath)) {
+		m_currentScenePath.clear();
+	}
+}
+
+bool RaycastVsConvexPoly2DMode::MapSceneFile(std::string const& fileName)
 {
-	fileName.replace_extension(".ghcs");
-	m_currentScene.clear();
+	toc.clear();
+	m_sceneDeadBytes = 0;
+	for (bool& isChunkDirty : m_isChunkDirty) {
+		isChunkDirty = false;
+	}
 
-	FileReadToBuffer(m_currentScene, fileName.string());
+	if (!m_currentScene.Open(fileName)) {
+		ERROR_RECOVERABLE(Stringf("COULD NOT OPEN SCENE FILE %s", fileName.c_str()));
+		return false;
+	}
 
-	BufferParser buffParser(m_currentScene);
+	BufferParser buffParser(m_currentScene.GetData(), m_currentScene.GetSize());
 
 	unsigned int tocLocation = 0;
 
@@ -806,11 +1069,33 @@ void RaycastVsConvexPoly2DMode::LoadSceneFromFile(std::filesystem::path fileName
 
 	if (!isHeaderCorrect) {
 		ERROR_RECOVERABLE("HEADER IS INCORRECTLY FORMATTED");
-		return;
+		m_currentScene.Close();
+		return false;
+	}
+
+	if (!ParseToc(tocLocation)) {
+		m_currentScene.Close();
+		return false;
+	}
+
+	size_t liveBytes = SCENE_HEADER_SIZE + GetTocSize((unsigned int)toc.size());
+	for (TOCEntry const& entry : toc) {
+		liveBytes += entry.m_chunkTotalSize;
 	}
+	m_sceneDeadBytes = (m_currentScene.GetSize() > liveBytes) ? (m_currentScene.GetSize() - liveBytes) : 0;
+
+	return true;
+}
 
+void RaycastVsConvexPoly2DMode::LoadSceneFromFile(std::filesystem::path fileName)
+{
+	fileName.replace_extension(".ghcs");
+	m_currentScenePath.clear();
+	m_isTreeChunkPending = false;
+
+	if (!MapSceneFile(fileName.string())) return;
 
-	ParseToc(tocLocation);
+	BufferParser buffParser(m_currentScene.GetData(), m_currentScene.GetSize());
 
 	bool foundSceneInfo = false;
 	bool foundConvexPolyChunk = false;
@@ -836,124 +1121,151 @@ void RaycastVsConvexPoly2DMode::LoadSceneFromFile(std::filesystem::path fileName
 			foundConvexPolyChunk = true;
 		}
 
-
-		buffParser.GoToOffset(tocEntry.m_headerStart);
-		ParseChunk(buffParser);
+		// Only what the scene needs right away is decoded. Trees wait until the BVH is turned on, and chunks this mode
+		// has no use for are never touched, so their pages never even get read in
+		switch (tocEntry.m_chunkType)
+		{
+		case SceneInfoChunk:
+		case ConvexPolysChunk:
+		case BoundingDiscsChunk:
+			buffParser.GoToOffset(tocEntry.m_headerStart);
+			ParseChunk(buffParser);
+			break;
+		case AABB2TreeChunk:
+		case AABB2TreeNodesChunk:
+			m_isTreeChunkPending = true;
+			break;
+		default:
+			break;
+		}
 	}
+
+	m_currentScenePath = fileName.string();
+	DeleteAABB2Tree();
+	m_isTreeDirty = true;
 }
 
 void RaycastVsConvexPoly2DMode::CreateAABB2Tree()
 {
-	std::vector<AABB2TreeNode*> candidates;
+	std::vector<AABB2> shapeBounds;
+	shapeBounds.reserve(m_allShapes.size());
 	for (int shapeIndex = 0; shapeIndex < m_allShapes.size(); shapeIndex++) {
-		Shape2D* shape = m_allShapes[shapeIndex];
-		ConvexPolyShape2D* asConvexPoly = dynamic_cast<ConvexPolyShape2D*>(shape);
+		ConvexPolyShape2D* asConvexPoly = dynamic_cast<ConvexPolyShape2D*>(m_allShapes[shapeIndex]);
 		if (asConvexPoly) {
-			AABB2TreeNode* newNode = new AABB2TreeNode();
-			newNode->m_bounds = asConvexPoly->m_convexPoly2D.GetBoundingBox();
-			newNode->m_containedShapesIndexes.push_back(shapeIndex);
-			candidates.push_back(newNode);
-			AddVertsForAABB2D(m_bvhDebugVerts, newNode->m_bounds, GetRandomColor());
+			shapeBounds.push_back(asConvexPoly->m_convexPoly2D.GetBoundingBox());
+		}
+		else {
+			// Keeps item indexes matching shape indexes; an empty box far away is never hit
+			shapeBounds.emplace_back(Vec2(-ARBITRARILY_LARGE_VALUE, -ARBITRARILY_LARGE_VALUE), Vec2(-ARBITRARILY_LARGE_VALUE, -ARBITRARILY_LARGE_VALUE));
 		}
 	}
 
-	std::vector<AABB2TreeNode*> usedCandidates;
-	while (candidates.size() > 1) {
-		usedCandidates.clear();
-		std::vector<AABB2TreeNode*> newCandidates;
-		for (int currentNodeInd = 0; currentNodeInd < candidates.size(); currentNodeInd++) {
-			AABB2TreeNode* currentNode = candidates[currentNodeInd];
-
-			auto currentNodeIt = std::find(usedCandidates.begin(), usedCandidates.end(), currentNode);
-			bool isCurrentNodeTaken = (currentNodeIt != usedCandidates.end());
-			if (isCurrentNodeTaken) continue;
+	m_treeBuildTime = 0;
+	{
+		ProfileLogScope buildProfile("BVH Build", false, &m_treeBuildTime);
+		if (m_useJobSystem) {
+			m_convexPolyTree.BuildParallel(shapeBounds, g_theJobSystem, &m_convexPolyProxyIds);
+		}
+		else {
+			m_convexPolyTree.Build(shapeBounds, &m_convexPolyProxyIds);
+		}
+	}
+	CreateBVHDebugVerts();
+}
 
-			AABB2TreeNode* bestCandidate = nullptr;
-			float closestDistance = FLT_MAX;
-			Vec2 currentNodeBoundCenter = currentNode->m_bounds.GetCenter();
+void RaycastVsConvexPoly2DMode::DeleteAABB2Tree()
+{
+	m_bvhDebugVerts.clear();
+	m_convexPolyTree.Clear();
+	m_convexPolyProxyIds.clear();
+}
 
-			for (int mergeCandidateInd = currentNodeInd + 1; mergeCandidateInd < candidates.size(); mergeCandidateInd++) {
-				AABB2TreeNode* mergeCandidate = candidates[mergeCandidateInd];
-				auto candidateIt = std::find(usedCandidates.begin(), usedCandidates.end(), mergeCandidate);
-				bool isCandidateTaken = (candidateIt != usedCandidates.end());
-				if (isCandidateTaken) continue;
+void RaycastVsConvexPoly2DMode::RebuildAABB2Tree()
+{
+	// A tree saved with the scene stays valid as long as no shape changed since loading
+	bool didLoadTree = m_isTreeChunkPending && LoadAABB2TreeFromScene();
+	if (didLoadTree) {
+		CreateBVHDebugVerts();
+	}
+	else {
+		DeleteAABB2Tree();
+		CreateAABB2Tree();
+	}
 
+	m_isTreeChunkPending = false;
+	m_isTreeDirty = false;
+}
 
-				Vec2 mergeCandidateCenter = mergeCandidate->m_bounds.GetCenter();
-				float distanceSqr = GetDistanceSquared2D(mergeCandidateCenter, currentNodeBoundCenter);
-				if (closestDistance > distanceSqr) {
-					closestDistance = distanceSqr;
-					bestCandidate = mergeCandidate;
-				}
+bool RaycastVsConvexPoly2DMode::LoadAABB2TreeFromScene()
+{
+	// The engine node array loads with a single copy, the heap numbered tree needs every leaf inserted again
+	TOCEntry* treeEntry = FindTocEntry(ChunkType::AABB2TreeNodesChunk);
+	if (!treeEntry) {
+		treeEntry = FindTocEntry(ChunkType::AABB2TreeChunk);
+	}
+	if (!treeEntry || !m_currentScene.IsOpen()) return false;
 
-			}
+	BufferParser bufferParser(m_currentScene.GetData(), m_currentScene.GetSize());
+	bufferParser.GoToOffset(treeEntry->m_headerStart);
 
-			bool foundBetterMatchNextRound = false;
+	m_treeBuildTime = 0;
+	{
+		ProfileLogScope loadProfile("BVH Load", false, &m_treeBuildTime);
+		ParseChunk(bufferParser);
+	}
 
-			for (int newCandidateInd = 0; (newCandidateInd < newCandidates.size()) && !foundBetterMatchNextRound; newCandidateInd++) {
-				AABB2TreeNode* currentNewCand = newCandidates[newCandidateInd];
-				Vec2 newCandCenter = currentNewCand->m_bounds.GetCenter();
-				float distanceSqr = GetDistanceSquared2D(newCandCenter, currentNodeBoundCenter);
-				if (closestDistance > distanceSqr) {
-					foundBetterMatchNextRound = true;
-				}
+	// Every shape needs exactly one leaf holding its own index. Anything else (missing, duplicated or out of range items)
+	// would hand MoveProxy a -1 or index m_allShapes out of bounds, so the caller rebuilds instead
+	int numShapes = (int)m_allShapes.size();
+	if (m_convexPolyTree.GetProxyCount() != numShapes) return false;
+	if ((int)m_convexPolyProxyIds.size() != numShapes) return false;
 
-			}
+	int numTreeNodes = (int)m_convexPolyTree.GetNodes().size();
+	for (int shapeIndex = 0; shapeIndex < numShapes; shapeIndex++) {
+		int proxyId = m_convexPolyProxyIds[shapeIndex];
+		if ((proxyId < 0) || (proxyId >= numTreeNodes)) return false;
 
-			if (!foundBetterMatchNextRound && bestCandidate) {
-				AABB2 combinedBounds = currentNode->m_bounds;
-				combinedBounds.StretchToIncludePoint(bestCandidate->m_bounds.m_mins);
-				combinedBounds.StretchToIncludePoint(bestCandidate->m_bounds.m_maxs);
-
-				AABB2TreeNode* combinedNode = new AABB2TreeNode();
-				combinedNode->m_bounds = combinedBounds;
-				combinedNode->m_containedShapesIndexes.insert(combinedNode->m_containedShapesIndexes.begin(), currentNode->m_containedShapesIndexes.begin(), currentNode->m_containedShapesIndexes.end());
-				combinedNode->m_containedShapesIndexes.insert(combinedNode->m_containedShapesIndexes.end(), bestCandidate->m_containedShapesIndexes.begin(), bestCandidate->m_containedShapesIndexes.end());
-
-				combinedNode->m_firstChild = currentNode;
-				combinedNode->m_secondChild = bestCandidate;
-				newCandidates.push_back(combinedNode);
-				usedCandidates.push_back(currentNode);
-				usedCandidates.push_back(bestCandidate);
-				AddVertsForAABB2D(m_bvhDebugVerts, combinedNode->m_bounds, GetRandomColor());
-			}
-			else {
-				newCandidates.push_back(currentNode);
-			}
-		}
-
-		candidates.clear();
-		candidates.insert(candidates.begin(), newCandidates.begin(), newCandidates.end());
+		AABB2TreeNode const& leaf = m_convexPolyTree.GetNode(proxyId);
+		if ((leaf.m_height != 0) || (leaf.m_itemIndex != shapeIndex)) return false;
 	}
 
-	m_convexPolyTreeRoot = candidates[0];
+	return true;
+}
 
+void RaycastVsConvexPoly2DMode::MarkShapeChunksDirty()
+{
+	m_isChunkDirty[ChunkType::SceneInfoChunk] = true;
+	m_isChunkDirty[ChunkType::ConvexPolysChunk] = true;
+	m_isChunkDirty[ChunkType::BoundingDiscsChunk] = true;
+	m_isChunkDirty[ChunkType::AABB2TreeChunk] = true;
+	m_isChunkDirty[ChunkType::AABB2TreeNodesChunk] = true;
+	m_isTreeChunkPending = false;
 }
 
-void RaycastVsConvexPoly2DMode::DeleteAABB2Tree()
+void RaycastVsConvexPoly2DMode::CreateBVHDebugVerts()
 {
 	m_bvhDebugVerts.clear();
-	std::queue<AABB2TreeNode*> nodesToDelete;
-	nodesToDelete.push(m_convexPolyTreeRoot);
-
-	while (!nodesToDelete.empty()) {
-		AABB2TreeNode*& currentNode = nodesToDelete.front();
-		nodesToDelete.pop();
-		if (currentNode) {
-			if (currentNode->m_firstChild) {
-				nodesToDelete.push(currentNode->m_firstChild);
-			}
-			if (currentNode->m_secondChild) {
-				nodesToDelete.push(currentNode->m_secondChild);
+	if (m_convexPolyTree.GetRootIndex() == -1) return;
+
+	int const numDepthColors = (int)(sizeof(BVH_DEPTH_COLORS) / sizeof(Rgba8));
+
+	std::vector<int> levelNodes;
+	std::vector<int> nextLevelNodes;
+	levelNodes.push_back(m_convexPolyTree.GetRootIndex());
+
+	for (int depth = 0; !levelNodes.empty() && ((m_maxDepth == -1) || (depth <= m_maxDepth)); depth++) {
+		Rgba8 const& depthColor = BVH_DEPTH_COLORS[depth % numDepthColors];
+		nextLevelNodes.clear();
+		for (int nodeIndex : levelNodes) {
+			AABB2TreeNode const& node = m_convexPolyTree.GetNode(nodeIndex);
+			AddVertsForAABB2D(m_bvhDebugVerts, node.m_bounds, depthColor);
+			if (!node.IsLeaf()) {
+				nextLevelNodes.push_back(node.m_firstChild);
+				nextLevelNodes.push_back(node.m_secondChild);
 			}
 		}
-
-		delete currentNode;
-		currentNode = nullptr;
+		levelNodes.swap(nextLevelNodes);
 	}
-
-	m_convexPolyTreeRoot = nullptr;
-
 }
 
 void RaycastVsConvexPoly2DMode::CreateReaminingConvexPoly2D()
@@ -965,6 +1277,7 @@ void RaycastVsConvexPoly2DMode::CreateReaminingConvexPoly2D()
 	Rgba8 solidBlue(0, 0, 255, 220);
 
 	int polysToCreate = (m_amountOfPolys - m_existingPolys);
+	MarkShapeChunksDirty();
 
 	for (int convexPolyInd = 0; convexPolyInd < polysToCreate; convexPolyInd++) {
 		float randAngleStart = rng.GetRandomFloatInRange(0.0f, 360.0f);
@@ -1061,6 +1374,19 @@ void RaycastVsConvexPoly2DMode::UpdateSelectedPoly(float deltaSeconds)
 	if (m_didAnyShapeChange) {
 		m_selectedShape->m_convexHull2D = m_selectedShape->m_convexPoly2D.GetConvexHull();
 		m_selectedShape->UpdateBoundingDisc();
+		MarkShapeChunksDirty();
+
+		if (m_useBVH && !m_isTreeDirty) {
+			for (int shapeIndex = 0; shapeIndex < (int)m_convexPolyProxyIds.size(); shapeIndex++) {
+				if (m_allShapes[shapeIndex] != m_selectedShape) continue;
+				m_convexPolyTree.MoveProxy(m_convexPolyProxyIds[shapeIndex], m_selectedShape->m_convexPoly2D.GetBoundingBox());
+				CreateBVHDebugVerts();
+				break;
+			}
+		}
+		else {
+			m_isTreeDirty = true;
+		}
 	}
 
 
@@ -1080,6 +1406,7 @@ void RaycastVsConvexPoly2DMode::HalveCurrentConvexPoly2D()
 	m_allShapes.resize(m_amountOfPolys);
 	m_allConvexPolys.resize(m_amountOfPolys);
 	m_existingPolys = m_amountOfPolys;
+	MarkShapeChunksDirty();
 
 	CreateVertexBuffer();
 	DeleteAABB2Tree();
@@ -1088,151 +1415,45 @@ void RaycastVsConvexPoly2DMode::HalveCurrentConvexPoly2D()
 
 void RaycastVsConvexPoly2DMode::RaycastVsAABB2Tree(Vec2 const& rayStart, Vec2 const& rayEnd, bool addVertsForImpact)
 {
-
-	for (Shape2D* aabb2Shape : m_hitAABB2s) {
-		delete aabb2Shape;
+	if (addVertsForImpact) {
+		m_normalColorShapes.clear();
+		m_highlightedShapes.clear();
+		m_raycastVsConvexPolyCollisionVerts.clear();
 	}
 
-	m_hitAABB2s.clear();
-	m_normalColorShapes.clear();
-	m_highlightedShapes.clear();
-	m_raycastVsConvexPolyCollisionVerts.clear();
-
-	std::queue<AABB2TreeNode*> nodesToCheck;
-	std::vector<int> indexesToCheck;
 	Vec2 rayFwd = rayEnd - rayStart;
 	float rayLength = rayFwd.NormalizeAndGetPreviousLength();
 
-	AABB2TreeNode* lastHitNode = nullptr;
-
-	int currentLevel = 0;
-	nodesToCheck.push(m_convexPolyTreeRoot);
-	int nodesInCurrentLevel = 1;
-	int nodesCheckedInLevel = 0;
-	int nextLevelNodes = 0;
-	while ((currentLevel < m_maxDepth) && (nodesToCheck.size() > 0)) {
-		AABB2TreeNode* currentNode = nodesToCheck.front();
-		AABB2 const& nodeBounds = currentNode->m_bounds;
-		nodesToCheck.pop();
-		nodesCheckedInLevel++;
-
-		if (nodesCheckedInLevel == nodesInCurrentLevel) {
-			currentLevel++;
-			nodesCheckedInLevel = 0;
-			nodesInCurrentLevel = nextLevelNodes;
-			nextLevelNodes = 0;
-		}
-
-		RaycastResult2D hitsAABB2 = RaycastVsBox(rayStart, rayFwd, rayLength, nodeBounds);
-		if (hitsAABB2.m_didImpact) {
-			lastHitNode = currentNode;
-			bool aboveMaxDepth = (m_maxDepth == -1) || (currentLevel < m_maxDepth);
-			if (aboveMaxDepth && currentNode->HasChildren()) {
-				if (currentNode->m_firstChild) {
-					nodesToCheck.push(currentNode->m_firstChild);
-					nextLevelNodes++;
-				}
-				if (currentNode->m_secondChild) {
-					nodesToCheck.push(currentNode->m_secondChild);
-					nextLevelNodes++;
-				}
-			}
-			else {
-				indexesToCheck.insert(indexesToCheck.end(), currentNode->m_containedShapesIndexes.begin(), currentNode->m_containedShapesIndexes.end());
-			}
-
-		}
-
-
-	}
-
-	if (addVertsForImpact && lastHitNode) {
-		if (g_drawDebug) {
-			AABB2 const& lastHitBounds = lastHitNode->m_bounds;
-			AABB2Shape2D* hitAABB2 = new AABB2Shape2D(lastHitBounds.GetDimensions(), lastHitBounds.GetCenter(), Rgba8(255, 255, 255, 100), Rgba8(255, 255, 255, 100));
-			m_highlightedShapes.push_back(hitAABB2);
-		}
+	RaycastHit closestHit;
+	{
+		ProfileLogScope raycastProfile("RaycastProfile", false, &m_raycastTotalTime);
+		m_raycastCounter++;
+		closestHit = m_convexPolyTree.Raycast(rayStart, rayFwd, rayLength, RaycastVsConvexPolyItem, this);
 	}
 
-	ProfileLogScope raycastProfile("RaycastProfile", false, &m_raycastTotalTime);
-	m_raycastCounter++;
-	if (indexesToCheck.size() > 0) {
-
-		m_impactedShape = false;
-		RaycastResult2D closestRaycast;
-		closestRaycast.m_impactDist = ARBITRARILY_LARGE_VALUE;
-		ConvexPolyShape2D* closestHitShape = nullptr;
-
-		for (int checkIndex = 0; checkIndex < indexesToCheck.size(); checkIndex++) {
-			int shapeIndex = indexesToCheck[checkIndex];
-			ConvexPolyShape2D* convexPoly = dynamic_cast<ConvexPolyShape2D*>(m_allShapes[shapeIndex]);
-			if (!convexPoly) continue;
-
-			RaycastResult2D raycastVsDisc = RaycastVsDisc(rayStart, rayFwd, rayLength, convexPoly->m_position, convexPoly->m_radius);
-
-			if (!raycastVsDisc.m_didImpact) continue;
-
-			RaycastResult2D raycastResult = RaycastVsConvexHull2D(rayStart, rayFwd, rayLength, convexPoly->m_convexHull2D);
-
-			if (raycastResult.m_didImpact) {
-				if (raycastResult.m_impactDist < closestRaycast.m_impactDist) {
-					closestRaycast = raycastResult;
-					closestHitShape = convexPoly;
-				}
-
-				m_impactedShape = addVertsForImpact && true; // Invisible raycasts use this too
-			}
-		}
-
-
-		if (addVertsForImpact) {
-			m_raycastResult = closestRaycast;
-			if (m_impactedShape) {
-				AddVertsForRaycastImpactOnConvexPoly2D(*closestHitShape, m_raycastResult);
-			}
-		}
-	}
+	if (!addVertsForImpact) return;
 
+	m_impactedShape = closestHit.DidImpact();
+	m_raycastResult = RaycastResult2D();
+	if (!m_impactedShape) return;
 
+	// The tree only reports the distance, the full result is only worth computing for the winner
+	ConvexPolyShape2D* closestHitShape = dynamic_cast<ConvexPolyShape2D*>(m_allShapes[closestHit.m_index]);
+	m_raycastResult = RaycastVsConvexHull2D(rayStart, rayFwd, rayLength, closestHitShape->m_convexHull2D);
+	AddVertsForRaycastImpactOnConvexPoly2D(*closestHitShape, m_raycastResult);
 }
 
-void RaycastVsConvexPoly2DMode::GetAABB2TreeInVector(std::vector<AABB2TreeNode*>& container, int maxDepthStored, int& amountOfNodes) const
+float RaycastVsConvexPoly2DMode::RaycastVsConvexPolyItem(void* userData, int itemIndex, Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance)
 {
-	int actualAmountOfNodes = 0;
-
-	int currentNodeChecked = 0;
+	RaycastVsConvexPoly2DMode const* gameMode = static_cast<RaycastVsConvexPoly2DMode const*>(userData);
+	ConvexPolyShape2D const* convexPoly = dynamic_cast<ConvexPolyShape2D const*>(gameMode->m_allShapes[itemIndex]);
+	if (!convexPoly) return -1.0f;
 
-	int currentLevel = 0;
-	container.push_back(m_convexPolyTreeRoot);
-	int nodesInCurrentLevel = 1;
-	int nodesCheckedInLevel = 0;
-	int nextLevelNodes = 0;
-
-
-	while (((currentLevel < maxDepthStored) || (maxDepthStored == -1)) && (currentNodeChecked < container.size())) {
-		AABB2TreeNode* currentNode = container[currentNodeChecked];
-		nodesCheckedInLevel++;
-
-		if (nodesCheckedInLevel == nodesInCurrentLevel) {
-			currentLevel++;
-			nodesCheckedInLevel = 0;
-			nodesInCurrentLevel = nextLevelNodes;
-			nextLevelNodes = 0;
-		}
+	RaycastResult2D raycastVsDisc = RaycastVsDisc(rayStart, rayForward, maxDistance, convexPoly->m_position, convexPoly->m_radius);
+	if (!raycastVsDisc.m_didImpact) return -1.0f;
 
-
-		bool aboveMaxDepth = (maxDepthStored == -1) || (currentLevel < maxDepthStored);
-		if (aboveMaxDepth && currentNode) {
-			actualAmountOfNodes++;
-			container.push_back(currentNode->m_firstChild);
-			container.push_back(currentNode->m_secondChild);
-			nextLevelNodes += 2;
-		}
-
-		currentNodeChecked++;
-	}
-
-	amountOfNodes = actualAmountOfNodes;
+	RaycastResult2D raycastResult = RaycastVsConvexHull2D(rayStart, rayForward, maxDistance, convexPoly->m_convexHull2D);
+	return (raycastResult.m_didImpact) ? raycastResult.m_impactDist : -1.0f;
 }
 
 void RaycastVsConvexPoly2DMode::UpdateInput(float deltaSeconds)
@@ -1366,13 +1587,20 @@ void RaycastVsConvexPoly2DMode::UpdateInput(float deltaSeconds)
 		m_useBVH = !m_useBVH;
 	}
 
+	if (g_theInput->WasKeyJustPressed(KEYCODE_F3)) {
+		m_useJobSystem = !m_useJobSystem;
+		m_isTreeDirty = true;
+	}
+
 	if (g_theInput->WasKeyJustPressed('U')) {
 		m_maxDepth++;
+		CreateBVHDebugVerts();
 	}
 
 	if (g_theInput->WasKeyJustPressed('I')) {
 		m_maxDepth--;
 		if (m_maxDepth < -1) m_maxDepth = -1;
+		CreateBVHDebugVerts();
 	}
 
 }
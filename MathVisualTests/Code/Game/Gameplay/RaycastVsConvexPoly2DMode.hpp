@@ -1,10 +1,33 @@
 #pragma once
 #include "Engine/Math/RaycastUtils.hpp"
+#include "Engine/Math/AABB2Tree.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/FileUtils.hpp"
 #include "Game/Gameplay/GameMode.hpp"
 
 class ConvexPolyShape2D;
-struct AABB2TreeNode;
 class BufferParser;
+class RaycastVsConvexPoly2DMode;
+
+// Traces a slice of the invisible ray batch into its own hit buffer
+class ConvexPolyRaycastJob : public Job {
+public:
+	ConvexPolyRaycastJob(RaycastVsConvexPoly2DMode const* gameMode, int firstRay, int numRays, std::vector<RaycastHit>* hits) :
+		Job::Job(DEFAULT_JOB_ID),
+		m_gameMode(gameMode),
+		m_firstRay(firstRay),
+		m_numRays(numRays),
+		m_hits(hits)
+	{}
+
+	virtual void Execute() override;
+	virtual void OnFinished() override;
+
+	RaycastVsConvexPoly2DMode const* m_gameMode = nullptr;
+	int m_firstRay = 0;
+	int m_numRays = 0;
+	std::vector<RaycastHit>* m_hits = nullptr;
+};
 
 class RaycastVsConvexPoly2DMode : public GameMode {
 public:
@@ -19,15 +42,21 @@ public:
 	static bool SaveGHCSScene(EventArgs& args);
 	static bool LoadGHCSScene(EventArgs& args);
 
+	void TraceInvisibleRays(int firstRay, int numRays, std::vector<RaycastHit>& out_hits) const;
+
 private:
 	void CreateAABB2Tree();
+	void RebuildAABB2Tree();
+	bool LoadAABB2TreeFromScene();
+	void MarkShapeChunksDirty();
 	void DeleteAABB2Tree();
 	void CreateReaminingConvexPoly2D();
 	void CreateVertexBuffer();
 	void UpdateSelectedPoly(float deltaSeconds);
 	void HalveCurrentConvexPoly2D();
 	void RaycastVsAABB2Tree(Vec2 const& rayStart, Vec2 const& rayEnd,bool addVertsForImpact = true);
-	void GetAABB2TreeInVector(std::vector<AABB2TreeNode*>& container, int maxDepthStored, int& amountOfNodes) const;
+	void CreateBVHDebugVerts();
+	static float RaycastVsConvexPolyItem(void* userData, int itemIndex, Vec2 const& rayStart, Vec2 const& rayForward, float maxDistance);
 
 	virtual void UpdateInput(float deltaSeconds) override;
 	void AddVertsForRaycastVsConvexPolys2D();
@@ -40,13 +69,16 @@ private:
 	void RenderNormalColorShapes() const;
 	void RenderHighlightedColorShapes() const;
 	void DoInvisibleRaycasts();
+	void DoInvisibleRaycastsOnJobs();
 
 	ConvexPolyShape2D* GetShapeUnderMouse() const;
 
-	void ParseToc(unsigned int tocStart);
+	bool ParseToc(unsigned int tocStart);
+	bool MapSceneFile(std::string const& fileName);
 	void ParseSceneChunk(BufferParser& bufferParser);
 	void ParseConvexPolyChunk(BufferParser& bufferParser);
 	void ParseAABB2TreeChunk(BufferParser& bufferParser);
+	void ParseAABB2TreeNodesChunk(BufferParser& bufferParser);
 	void ParseBoundingDiscsChunk(BufferParser& bufferParser);
 	void ParseChunk(BufferParser& bufferParser);
 	void LoadSceneFromFile(std::filesystem::path fileName);
@@ -54,13 +86,16 @@ private:
 
 	void WriteBoundingDiscsChunkToBuffer(std::vector<unsigned char>& fileBuffer, unsigned char endianness) const;
 	void WriteAABB2TreeChunkToBuffer(std::vector<unsigned char>& fileBuffer, unsigned char endianness) const;
+	void WriteAABB2TreeNodesChunkToBuffer(std::vector<unsigned char>& fileBuffer, unsigned char endianness) const;
 	void WriteSceneChunkToBuffer(std::vector<unsigned char>& fileBuffer, unsigned char endianness) const;
-	void AppendToc(std::vector<unsigned char>& fileBuffer) const;
+	void AppendToc(std::vector<unsigned char>& fileBuffer, unsigned char endianness) const;
 	void CreateOrUpdateTocEntry(unsigned char chunkType, unsigned int totalSize, unsigned int headerStart) const;
 	void WriteConvexPolyChunkToBuffer(std::vector<unsigned char>& fileBuffer, unsigned char chunkEndianness) const;
-	void CopyChunkAsIs(std::vector<unsigned char>& saveBuffer, unsigned int headerStart, unsigned int totalChunkSize) const;
+	void CopyChunkAsIs(std::vector<unsigned char>& saveBuffer, unsigned char chunkType, unsigned int headerStart, unsigned int totalChunkSize) const;
 	void RewriteScene(std::vector<unsigned char>& saveBuffer, unsigned char chunkType, unsigned int headerStart, unsigned int totalChunkSize) const;
-	void SaveSceneToFile(std::filesystem::path fileName) const;
+	void WriteMissingChunksToBuffer(std::vector<unsigned char>& saveBuffer) const;
+	void SaveSceneToFile(std::filesystem::path fileName);
+	void SaveSceneIncrementally();
 
 
 private:
@@ -68,11 +103,16 @@ private:
 	std::vector<Shape2D*> m_allConvexPolys;
 	std::vector<Shape2D*> m_highlightedShapes;
 	std::vector<Shape2D*> m_normalColorShapes;
-	std::vector<Shape2D*> m_hitAABB2s;
 	std::vector<Vertex_PCU> m_raycastVsConvexPolyCollisionVerts;
 	std::vector<Vertex_PCU> m_shapeDebugDiscs;
 
-	std::vector<unsigned char> m_currentScene;
+	// Stays mapped while the scene is loaded: chunks are decoded when first needed and clean ones are copied on save
+	MappedFile m_currentScene;
+	std::string m_currentScenePath;
+	size_t m_sceneDeadBytes = 0; // Superseded chunks and TOCs left behind by incremental saves
+	bool m_isChunkDirty[256] = {};
+	bool m_isTreeChunkPending = false;
+	unsigned int m_chunkWriteOffset = 0; // File position of the buffer chunks are written into
 
 	std::string m_baseHelperText = "";
 
@@ -87,6 +127,11 @@ private:
 	int m_existingPolys = 0;
 	bool m_halfPolygons = false;
 	int m_numInvisibleRays = g_gameConfigBlackboard.GetValue("CONVEX_INVISIBLE_RAYS_AMOUNT", 1024);
+	RayPacket2D m_invisibleRays;
+	std::vector<std::vector<RaycastHit>> m_invisibleRayHits; // One buffer per job, never shared between threads
+	int m_invisibleRayHitCount = 0;
+	int m_invisibleRayJobCount = 0;
+	uint64_t m_invisibleRaysTime = 0;
 	float m_rotationSpeed = g_gameConfigBlackboard.GetValue("CONVEX_ROTATION_SPEED", 15.0f);
 	float m_angularVelocity = 0.0f;
 
@@ -100,12 +145,15 @@ private:
 	bool m_didAnyShapeChange = false;
 	Vec2 m_prevMousePosition = Vec2::ZERO;
 	ConvexPolyShape2D* m_selectedShape = nullptr;
-	AABB2TreeNode* m_convexPolyTreeRoot = nullptr;
+	AABB2Tree m_convexPolyTree;
+	std::vector<int> m_convexPolyProxyIds;
 	std::vector<Vertex_PCU> m_bvhDebugVerts;
 	bool m_useBVH = false;
+	bool m_useJobSystem = true;
+	uint64_t m_treeBuildTime = 0;
 	uint64_t m_raycastTotalTime =  0;
 	int m_raycastCounter = 0;
-	int m_maxDepth = 1;
+	int m_maxDepth = -1; // BVH debug draw depth, -1 draws every level
 	bool m_isTreeDirty = true;
 	bool m_rewritingExistingScene = false;
 	unsigned char m_currentFileEndianness = 0;
@@ -1,4 +1,4 @@
-#include "Engine/Math/RaycastUtils.hpp"
+#include "Engine/Core/ProfileLogScope.hpp"
 #include "Game/Gameplay/RaycastVsDiscsGameMode.hpp"
 #include "Game/Gameplay/DiscShape2D.hpp"
 
@@ -7,7 +7,7 @@ RaycastVsDiscMode::RaycastVsDiscMode(Game* pointerToGame, Vec2 const& cameraSize
 {
 	m_worldSize = worldSize;
 	m_gameModeName = "Raycasts vs Discs 2D";
-	m_helperText = "F8 to randomize. LMB/RMB set ray start/end; WASD moves start, IJKL moves end, arrows move ray. Hold T = slow";
+	m_helperText = "F8 to randomize. LMB/RMB set ray start/end; WASD moves start, IJKL moves end, arrows move ray. Hold T = slow. N/M more/less invisible rays";
 	m_rayStart = Vec2(20.0f, 20.0f);
 	m_rayEnd = Vec2(100.0f, 40.0f);
 }
@@ -20,13 +20,14 @@ void RaycastVsDiscMode::Startup()
 {
 	Rgba8 transparentBlue(0, 0, 255, 120);
 	Rgba8 solidBlue(0, 0, 255, 180);
-	for (int discIndex = 0; discIndex < 10; discIndex++) {
+	m_discPacket.Reserve(m_amountOfDiscs);
+	for (int discIndex = 0; discIndex < m_amountOfDiscs; discIndex++) {
 		float randRadius = rng.GetRandomFloatInRange(5.0f, 10.0f);
 		DiscShape2D* newDisc = new DiscShape2D(GetClampedRandomPositionInWorld(randRadius), randRadius, transparentBlue, solidBlue);
 		m_allShapes.push_back(newDisc);
+		m_discPacket.AddDisc(newDisc->m_position, newDisc->m_radius);
 	}
 
-
 }
 
 void RaycastVsDiscMode::Shutdown()
@@ -42,11 +43,21 @@ void RaycastVsDiscMode::Shutdown()
 	m_allShapes.clear();
 	m_normalColorShapes.clear();
 	m_highlightedShapes.clear();
+	m_discPacket.Clear();
 }
 
 void RaycastVsDiscMode::Update(float deltaSeconds)
 {
 	AddVertsForRaycastVsDiscs2D();
+	DoInvisibleRaycasts();
+
+	float scalarTimeMs = static_cast<float>(m_scalarRaycastTime) / 1'000'000.0f;
+	float packetTimeMs = static_cast<float>(m_packetRaycastTime) / 1'000'000.0f;
+	float speedUp = (packetTimeMs > 0.0f) ? scalarTimeMs / packetTimeMs : 0.0f;
+
+	DebugAddScreenText(Stringf("Invisible Rays: %d vs %d discs", m_numInvisibleRays, m_amountOfDiscs), Vec2(0.0f, m_UICameraSize.y * 0.90f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
+	DebugAddScreenText(Stringf("Scalar Raycast Total (ms): %.3f", scalarTimeMs), Vec2(0.0f, m_UICameraSize.y * 0.87f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
+	DebugAddScreenText(Stringf("Packet Raycast Total (ms): %.3f (%.1fx)", packetTimeMs, speedUp), Vec2(0.0f, m_UICameraSize.y * 0.84f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::WHITE, Rgba8::WHITE);
 
 	UpdateInput(deltaSeconds);
 	GameMode::Update(deltaSeconds);
@@ -66,19 +77,20 @@ void RaycastVsDiscMode::Render() const
 
 	g_theRenderer->DrawVertexArray(m_raycastVsDiscCollisionVerts);
 
-	std::vector<Vertex_PCU> arrowVerts;
+	Vertex_PCU arrowVerts[18]; // At most two arrows
+	Vertex_PCU* arrowVertsEnd = arrowVerts;
 
 	if (m_impactedDisc) {
 		if (m_raycastResult.m_impactDist >= 1.0f) {
-			AddVertsForArrow2D(arrowVerts, m_rayStart, m_raycastResult.m_impactPos, Rgba8::RED, 0.5f);
+			arrowVertsEnd = AddVertsForArrow2D(arrowVertsEnd, m_rayStart, m_raycastResult.m_impactPos, Rgba8::RED, 0.5f);
 		}
-		AddVertsForArrow2D(arrowVerts, m_raycastResult.m_impactPos, m_rayEnd, Rgba8::GRAY, 0.5f);
+		arrowVertsEnd = AddVertsForArrow2D(arrowVertsEnd, m_raycastResult.m_impactPos, m_rayEnd, Rgba8::GRAY, 0.5f);
 	}
 	else {
-		AddVertsForArrow2D(arrowVerts, m_rayStart, m_rayEnd, Rgba8::GREEN, 0.5f);
+		arrowVertsEnd = AddVertsForArrow2D(arrowVertsEnd, m_rayStart, m_rayEnd, Rgba8::GREEN, 0.5f);
 	}
 
-	g_theRenderer->DrawVertexArray(arrowVerts);
+	g_theRenderer->DrawVertexArray((unsigned int)(arrowVertsEnd - arrowVerts), arrowVerts);
 	g_theRenderer->EndCamera(m_worldCamera);
 
 	RenderUI();
@@ -156,6 +168,15 @@ void RaycastVsDiscMode::UpdateInput(float deltaSeconds)
 	if (g_theInput->IsKeyDown(KEYCODE_RIGHT_MOUSE)) {
 		m_rayEnd = worldBoundingBox.GetPointAtUV(g_theWindow->GetNormalizedCursorPos());
 	}
+
+	if (g_theInput->WasKeyJustPressed('N')) {
+		m_numInvisibleRays *= 2;
+		if (m_numInvisibleRays == 0) m_numInvisibleRays = 1;
+	}
+
+	if (g_theInput->WasKeyJustPressed('M')) {
+		m_numInvisibleRays /= 2;
+	}
 }
 
 void RaycastVsDiscMode::AddVertsForRaycastVsDiscs2D()
@@ -164,42 +185,78 @@ void RaycastVsDiscMode::AddVertsForRaycastVsDiscs2D()
 	m_highlightedShapes.clear();
 	m_raycastVsDiscCollisionVerts.clear();
 
-	float rayDistance = GetDistance2D(m_rayStart, m_rayEnd);
+	Vec2 rayForward = m_rayEnd - m_rayStart;
+	float rayDistance = rayForward.NormalizeAndGetPreviousLength();
 
-	m_impactedDisc = false;
-	RaycastResult2D closestRaycast;
-	closestRaycast.m_impactDist = ARBITRARILY_LARGE_VALUE;
-	int closestImpactedShapeIndex = -1;
+	RaycastHit nearestHit = RaycastVsDiscs2D(m_rayStart, rayForward, rayDistance, m_discPacket);
+	m_impactedDisc = nearestHit.DidImpact();
+	int closestImpactedShapeIndex = nearestHit.m_index;
 
 	for (int shapeIndex = 0; shapeIndex < m_allShapes.size(); shapeIndex++) {
 		Shape2D* shape = m_allShapes[shapeIndex];
-		DiscShape2D const* shapeAsDisc = dynamic_cast<DiscShape2D*>(shape);
-		if (!shape)continue;
+		if (shapeIndex != closestImpactedShapeIndex) {
+			m_normalColorShapes.push_back(shape);
+		}
 
-		RaycastResult2D raycastResult;
-		raycastResult = RaycastVsDisc(m_rayStart, (m_rayEnd - m_rayStart).GetNormalized(), rayDistance, shapeAsDisc->m_position, shapeAsDisc->m_radius);
+	}
 
-		if (raycastResult.m_didImpact) {
-			if (raycastResult.m_impactDist < closestRaycast.m_impactDist) {
-				closestRaycast = raycastResult;
-				closestImpactedShapeIndex = shapeIndex;
-			}
-			m_impactedDisc = true;
-		}
+	if (m_impactedDisc) {
+		// Only the nearest disc needs the full result, for the impact point and normal
+		DiscShape2D* closestDisc = dynamic_cast<DiscShape2D*>(m_allShapes[closestImpactedShapeIndex]);
+		m_raycastResult = RaycastVsDisc(m_rayStart, rayForward, rayDistance, closestDisc->m_position, closestDisc->m_radius);
+		AddVertsForRaycastImpactOnDisc(*closestDisc, m_raycastResult);
+	}
+}
 
+void RaycastVsDiscMode::DoInvisibleRaycasts()
+{
+	m_invisibleRays.Clear();
+	m_invisibleRays.Reserve(m_numInvisibleRays);
+	for (int raycastInd = 0; raycastInd < m_numInvisibleRays; raycastInd++) {
+		Vec2 startRay = GetRandomPositionInWorld();
+		Vec2 forward = GetRandomPositionInWorld() - startRay;
+		float rayLength = forward.NormalizeAndGetPreviousLength();
+		m_invisibleRays.AddRay(startRay, forward, rayLength);
 	}
 
-	for (int shapeIndex = 0; shapeIndex < m_allShapes.size(); shapeIndex++) {
-		Shape2D* shape = m_allShapes[shapeIndex];
-		if (shapeIndex != closestImpactedShapeIndex) {
-			m_normalColorShapes.push_back(shape);
+	m_scalarRaycastTime = 0;
+	m_packetRaycastTime = 0;
+	int scalarImpacts = 0;
+	int packetImpacts = 0;
+
+	{
+		ProfileLogScope scalarProfile("Scalar Raycast Profile", false, &m_scalarRaycastTime);
+		for (int raycastInd = 0; raycastInd < m_numInvisibleRays; raycastInd++) {
+			Vec2 startRay(m_invisibleRays.m_startsX[raycastInd], m_invisibleRays.m_startsY[raycastInd]);
+			Vec2 forward(m_invisibleRays.m_forwardsX[raycastInd], m_invisibleRays.m_forwardsY[raycastInd]);
+			float rayLength = m_invisibleRays.m_maxDistances[raycastInd];
+
+			float closestImpactDist = ARBITRARILY_LARGE_VALUE;
+			bool didImpact = false;
+			for (int shapeIndex = 0; shapeIndex < m_allShapes.size(); shapeIndex++) {
+				DiscShape2D const* shapeAsDisc = dynamic_cast<DiscShape2D*>(m_allShapes[shapeIndex]);
+				RaycastResult2D raycastResult = RaycastVsDisc(startRay, forward, rayLength, shapeAsDisc->m_position, shapeAsDisc->m_radius);
+				if (raycastResult.m_didImpact && raycastResult.m_impactDist < closestImpactDist) {
+					closestImpactDist = raycastResult.m_impactDist;
+					didImpact = true;
+				}
+			}
+			if (didImpact) scalarImpacts++;
 		}
+	}
 
+	{
+		ProfileLogScope packetProfile("Packet Raycast Profile", false, &m_packetRaycastTime);
+		for (int raycastInd = 0; raycastInd < m_numInvisibleRays; raycastInd++) {
+			Vec2 startRay(m_invisibleRays.m_startsX[raycastInd], m_invisibleRays.m_startsY[raycastInd]);
+			Vec2 forward(m_invisibleRays.m_forwardsX[raycastInd], m_invisibleRays.m_forwardsY[raycastInd]);
+			RaycastHit nearestHit = RaycastVsDiscs2D(startRay, forward, m_invisibleRays.m_maxDistances[raycastInd], m_discPacket);
+			if (nearestHit.DidImpact()) packetImpacts++;
+		}
 	}
 
-	m_raycastResult = closestRaycast;
-	if (m_impactedDisc) {
-		AddVertsForRaycastImpactOnDisc(*m_allShapes[closestImpactedShapeIndex], m_raycastResult);
+	if (scalarImpacts != packetImpacts) {
+		DebugAddScreenText(Stringf("Scalar/packet impact mismatch: %d vs %d", scalarImpacts, packetImpacts), Vec2(0.0f, m_UICameraSize.y * 0.81f), 0.0f, Vec2::ZERO, m_textCellHeight, Rgba8::RED, Rgba8::RED);
 	}
 }
 
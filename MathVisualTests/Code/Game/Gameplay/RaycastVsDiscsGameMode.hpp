@@ -1,4 +1,5 @@
 #pragma once
+#include "Engine/Math/RaycastUtils.hpp"
 #include "Game/Gameplay/GameMode.hpp"
 
 class RaycastVsDiscMode : public GameMode {
@@ -15,6 +16,7 @@ private:
 	virtual void UpdateInput(float deltaSeconds) override;
 	void AddVertsForRaycastVsDiscs2D();
 	void AddVertsForRaycastImpactOnDisc(Shape2D& shape, RaycastResult2D& raycastResult);
+	void DoInvisibleRaycasts();
 
 	virtual void UpdateInputFromKeyboard();
 	virtual void UpdateInputFromController();
@@ -26,6 +28,8 @@ private:
 	std::vector<Shape2D*> m_highlightedShapes;
 	std::vector<Shape2D*> m_normalColorShapes;
 	std::vector<Vertex_PCU> m_raycastVsDiscCollisionVerts;
+	DiscPacket2D m_discPacket;
+	RayPacket2D m_invisibleRays;
 
 	Vec2 m_rayStart = Vec2::ZERO;
 	Vec2 m_rayEnd = Vec2::ZERO;
@@ -34,4 +38,9 @@ private:
 	bool m_impactedDisc = false;
 	float m_dotSpeed = g_gameConfigBlackboard.GetValue("DOT_SPEED", 40.0f);
 
+	int m_amountOfDiscs = g_gameConfigBlackboard.GetValue("AMOUNT_OF_2D_DISCS", 10);
+	int m_numInvisibleRays = g_gameConfigBlackboard.GetValue("DISC_INVISIBLE_RAYS_AMOUNT", 1024);
+	uint64_t m_scalarRaycastTime = 0;
+	uint64_t m_packetRaycastTime = 0;
+
 };
\ No newline at end of file
@@ -23,4 +23,7 @@ public:
 	Rgba8 m_highlightedColor = Rgba8::WHITE;
 	float m_elasticity = 1.0f;
 
+protected:
+	mutable std::vector<Vertex_PCU> m_renderVerts; // Reused every frame so rendering doesn't allocate
+
 };
\ No newline at end of file
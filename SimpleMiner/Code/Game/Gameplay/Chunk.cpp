@@ -1336,9 +1336,13 @@ bool Chunk::LoadFromFile()
 {
 	std::string fileName = GetChunkFileName();
 	if (!FileExists(fileName)) return false;
-	std::vector<uint8_t> fileBytes;
 
-	int loadStatus = FileReadToBuffer(fileBytes, fileName);
+	// Parsed straight out of the mapped file, the bytes are never copied
+	MappedFile chunkFile(fileName);
+	if (!chunkFile.IsOpen() || chunkFile.GetSize() < 8) return false;
+	unsigned char const* fileBytes = chunkFile.GetData();
+	size_t fileSize = chunkFile.GetSize();
+
 	bool foundG = fileBytes[0] == 'G';
 	bool foundC = fileBytes[1] == 'C';
 	bool foundH = fileBytes[2] == 'H';
@@ -1360,25 +1364,28 @@ bool Chunk::LoadFromFile()
 	if (!(versionsMatch && chunkBitsXMatch && chunkBitsYMatch && chunkBitsZMatch)) return false;
 
 	int blockIndex = 0;
-	if (loadStatus == 0) {
-		m_blocks = new Block[CHUNK_TOTAL_SIZE];
-
-		for (int byteIndex = 8; byteIndex < fileBytes.size(); byteIndex += 2) {
-			uint8_t blockType = fileBytes[byteIndex];
-			int nextIndex = byteIndex + 1;
-			uint8_t blockAmount = fileBytes[nextIndex];
-			for (int blockCount = 0; blockCount < blockAmount; blockCount++, blockIndex++) {
-				m_blocks[blockIndex].m_typeIndex = blockType;
-			}
+	m_blocks = new Block[CHUNK_TOTAL_SIZE];
+
+	for (size_t byteIndex = 8; byteIndex + 1 < fileSize; byteIndex += 2) {
+		uint8_t blockType = fileBytes[byteIndex];
+		uint8_t blockAmount = fileBytes[byteIndex + 1];
+		if (blockIndex + blockAmount > CHUNK_TOTAL_SIZE) {
+			// Corrupt or oversized run; the chunk is generated instead
+			delete[] m_blocks;
+			m_blocks = nullptr;
+			ERROR_RECOVERABLE("CHUNK FILE HOLDS MORE BLOCKS THAN THE CHUNK");
+			return false;
 		}
 
-		if (blockIndex != CHUNK_TOTAL_SIZE) {
-			ERROR_AND_DIE("CHUNK LOADED SIZE IS NOT THE EXPECTED ONE");
+		for (int blockCount = 0; blockCount < blockAmount; blockCount++, blockIndex++) {
+			m_blocks[blockIndex].m_typeIndex = blockType;
 		}
-		return true;
 	}
 
-	return false;
+	if (blockIndex != CHUNK_TOTAL_SIZE) {
+		ERROR_AND_DIE("CHUNK LOADED SIZE IS NOT THE EXPECTED ONE");
+	}
+	return true;
 }
 
 void ChunkGenerationJob::Execute()
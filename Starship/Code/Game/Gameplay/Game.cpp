@@ -57,21 +57,10 @@ void Game::ShutDown()
 	delete m_playerShip;
 	m_playerShip = nullptr;
 
-	for (int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; asteroidIndex++) {
-		Asteroid*& asteroid = m_asteroids[asteroidIndex];
-		if (asteroid) {
-			delete asteroid;
-			asteroid = nullptr;
-		}
-	}
-
-	for (int bulletIndex = 0; bulletIndex < MAX_BULLETS; bulletIndex++) {
-		Bullet*& bullet = m_bullets[bulletIndex];
-		if (bullet) {
-			delete bullet;
-			bullet = nullptr;
-		}
-	}
+	m_asteroids.Clear();
+	m_bullets.Clear();
+	m_debris.Clear();
+	m_pickUps.Clear();
 
 	for (int enemyIndex = 0; enemyIndex < MAX_ENEMIES; enemyIndex++)
 	{
@@ -82,15 +71,6 @@ void Game::ShutDown()
 		}
 	}
 
-	for (int pickUpIndex = 0; pickUpIndex < MAX_PICKUPS; pickUpIndex++)
-	{
-		PickUp*& pickUp = m_pickUps[pickUpIndex];
-		if (pickUp) {
-			delete pickUp;
-			pickUp = nullptr;
-		}
-	}
-
 	if (m_loseGameSoundID != -1) {
 		g_theAudio->StopSound(m_loseGameSoundID);
 	}
@@ -219,20 +199,15 @@ void Game::UpdateAttractScreen(float deltaSeconds)
 void Game::UpdateEntities(float deltaTime)
 {
 	m_playerShip->Update(deltaTime);
-	for (int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; asteroidIndex++) {
-		Asteroid*& asteroid = m_asteroids[asteroidIndex];
-		if (asteroid) {
-			asteroid->Update(deltaTime);
-		}
+	for (int asteroidIndex = 0; asteroidIndex < m_asteroids.GetCount(); asteroidIndex++) {
+		m_asteroids.GetItem(asteroidIndex)->Update(deltaTime);
 	}
 
-	for (int bulletIndex = 0; bulletIndex < MAX_BULLETS; bulletIndex++) {
-		Bullet*& bullet = m_bullets[bulletIndex];
-		if (bullet) {
-			bullet->Update(deltaTime);
-			if (bullet->IsOffScreen()) {
-				bullet->Die();
-			}
+	for (int bulletIndex = 0; bulletIndex < m_bullets.GetCount(); bulletIndex++) {
+		Bullet* bullet = m_bullets.GetItem(bulletIndex);
+		bullet->Update(deltaTime);
+		if (bullet->IsOffScreen()) {
+			bullet->Die();
 		}
 	}
 
@@ -243,11 +218,8 @@ void Game::UpdateEntities(float deltaTime)
 		}
 	}
 
-	for (int debrisIndex = 0; debrisIndex < DEBRIS_MAX_AMOUNT; debrisIndex++) {
-		Debris* debris = m_debris[debrisIndex];
-		if (debris) {
-			debris->Update(deltaTime);
-		}
+	for (int debrisIndex = 0; debrisIndex < m_debris.GetCount(); debrisIndex++) {
+		m_debris.GetItem(debrisIndex)->Update(deltaTime);
 	}
 }
 
@@ -554,19 +526,18 @@ void Game::Render() const
 
 void Game::DeleteGarbageEntities()
 {
-	for (int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; asteroidIndex++) {
-		Asteroid*& asteroid = m_asteroids[asteroidIndex];
-		if (asteroid && asteroid->m_isGarbage) {
-			delete asteroid;
-			asteroid = nullptr;
+	// Backwards, since destroying moves the last live entity into the freed spot
+	for (int asteroidIndex = m_asteroids.GetCount() - 1; asteroidIndex >= 0; asteroidIndex--) {
+		Asteroid* asteroid = m_asteroids.GetItem(asteroidIndex);
+		if (asteroid->m_isGarbage) {
+			m_asteroids.Destroy(asteroid);
 		}
 	}
 
-	for (int bulletIndex = 0; bulletIndex < MAX_BULLETS; bulletIndex++) {
-		Bullet*& bullet = m_bullets[bulletIndex];
-		if (bullet && bullet->m_isGarbage) {
-			delete bullet;
-			bullet = nullptr;
+	for (int bulletIndex = m_bullets.GetCount() - 1; bulletIndex >= 0; bulletIndex--) {
+		Bullet* bullet = m_bullets.GetItem(bulletIndex);
+		if (bullet->m_isGarbage) {
+			m_bullets.Destroy(bullet);
 		}
 	}
 
@@ -578,19 +549,17 @@ void Game::DeleteGarbageEntities()
 		}
 	}
 
-	for (int debrisIndex = 0; debrisIndex < DEBRIS_MAX_AMOUNT; debrisIndex++) {
-		Debris*& debris = m_debris[debrisIndex];
-		if (debris && debris->m_isGarbage) {
-			delete debris;
-			debris = nullptr;
+	for (int debrisIndex = m_debris.GetCount() - 1; debrisIndex >= 0; debrisIndex--) {
+		Debris* debris = m_debris.GetItem(debrisIndex);
+		if (debris->m_isGarbage) {
+			m_debris.Destroy(debris);
 		}
 	}
 
-	for (int pickupIndex = 0; pickupIndex < MAX_PICKUPS; pickupIndex++) {
-		PickUp*& pickup = m_pickUps[pickupIndex];
-		if (pickup && pickup->m_isGarbage) {
-			delete pickup;
-			pickup = nullptr;
+	for (int pickupIndex = m_pickUps.GetCount() - 1; pickupIndex >= 0; pickupIndex--) {
+		PickUp* pickup = m_pickUps.GetItem(pickupIndex);
+		if (pickup->m_isGarbage) {
+			m_pickUps.Destroy(pickup);
 		}
 	}
 
@@ -650,20 +619,14 @@ void Game::RenderEntities() const
 
 	//g_theRenderer->ClearScreen(Rgba8::BLACK);
 
-	for (int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; asteroidIndex++) {
-		Asteroid const* asteroid = m_asteroids[asteroidIndex];
-		if (asteroid) {
-			asteroid->Render();
-		}
+	for (int asteroidIndex = 0; asteroidIndex < m_asteroids.GetCount(); asteroidIndex++) {
+		m_asteroids.GetItem(asteroidIndex)->Render();
 	}
 
 	m_playerShip->Render();
 
-	for (int bulletIndex = 0; bulletIndex < MAX_BULLETS; bulletIndex++) {
-		Bullet const* bullet = m_bullets[bulletIndex];
-		if (bullet) {
-			bullet->Render();
-		}
+	for (int bulletIndex = 0; bulletIndex < m_bullets.GetCount(); bulletIndex++) {
+		m_bullets.GetItem(bulletIndex)->Render();
 	}
 
 	for (int enemyIndex = 0; enemyIndex < MAX_ENEMIES; enemyIndex++) {
@@ -673,11 +636,8 @@ void Game::RenderEntities() const
 		}
 	}
 
-	for (int debrisIndex = 0; debrisIndex < DEBRIS_MAX_AMOUNT; debrisIndex++) {
-		Debris const* debris = m_debris[debrisIndex];
-		if (debris) {
-			debris->Render();
-		}
+	for (int debrisIndex = 0; debrisIndex < m_debris.GetCount(); debrisIndex++) {
+		m_debris.GetItem(debrisIndex)->Render();
 	}
 
 	if (g_drawDebug) {
@@ -685,11 +645,8 @@ void Game::RenderEntities() const
 	}
 
 
-	for (int pickupIndex = 0; pickupIndex < MAX_PICKUPS; pickupIndex++) {
-		PickUp const* pickup = m_pickUps[pickupIndex];
-		if (pickup) {
-			pickup->Render();
-		}
+	for (int pickupIndex = 0; pickupIndex < m_pickUps.GetCount(); pickupIndex++) {
+		m_pickUps.GetItem(pickupIndex)->Render();
 	}
 	g_theRenderer->EndCamera(m_worldCamera);
 
@@ -699,20 +656,16 @@ void Game::RenderDegubEntities() const {
 	float lineThickness = 0.15f;
 	Rgba8 darkGrey(50, 50, 50, 255);
 
-	for (int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; asteroidIndex++) {
-		Asteroid const* asteroid = m_asteroids[asteroidIndex];
-		if (asteroid) {
-			DebugDrawLine(asteroid->m_position, m_playerShip->m_position, lineThickness, darkGrey);
-			asteroid->DrawDebug();
-		}
+	for (int asteroidIndex = 0; asteroidIndex < m_asteroids.GetCount(); asteroidIndex++) {
+		Asteroid const* asteroid = m_asteroids.GetItem(asteroidIndex);
+		DebugDrawLine(asteroid->m_position, m_playerShip->m_position, lineThickness, darkGrey);
+		asteroid->DrawDebug();
 	}
 
-	for (int bulletIndex = 0; bulletIndex < MAX_BULLETS; bulletIndex++) {
-		Bullet const* bullet = m_bullets[bulletIndex];
-		if (bullet) {
-			DebugDrawLine(bullet->m_position, m_playerShip->m_position, lineThickness, darkGrey);
-			bullet->DrawDebug();
-		}
+	for (int bulletIndex = 0; bulletIndex < m_bullets.GetCount(); bulletIndex++) {
+		Bullet const* bullet = m_bullets.GetItem(bulletIndex);
+		DebugDrawLine(bullet->m_position, m_playerShip->m_position, lineThickness, darkGrey);
+		bullet->DrawDebug();
 	}
 
 	for (int enemyIndex = 0; enemyIndex < MAX_ENEMIES; enemyIndex++)
@@ -724,12 +677,10 @@ void Game::RenderDegubEntities() const {
 		}
 	}
 
-	for (int debrisIndex = 0; debrisIndex < DEBRIS_MAX_AMOUNT; debrisIndex++) {
-		Debris const* debris = m_debris[debrisIndex];
-		if (debris) {
-			DebugDrawLine(debris->m_position, m_playerShip->m_position, lineThickness, darkGrey);
-			debris->DrawDebug();
-		}
+	for (int debrisIndex = 0; debrisIndex < m_debris.GetCount(); debrisIndex++) {
+		Debris const* debris = m_debris.GetItem(debrisIndex);
+		DebugDrawLine(debris->m_position, m_playerShip->m_position, lineThickness, darkGrey);
+		debris->DrawDebug();
 	}
 	m_playerShip->DrawDebug();
 
@@ -895,11 +846,8 @@ void Game::CheckCollisionEntities()
 			continue;
 		}
 
-		for (int bulletIndex = 0; bulletIndex < MAX_BULLETS; bulletIndex++) {
-			Bullet* bullet = m_bullets[bulletIndex];
-			if (!bullet) {
-				continue;
-			}
+		for (int bulletIndex = 0; bulletIndex < m_bullets.GetCount(); bulletIndex++) {
+			Bullet* bullet = m_bullets.GetItem(bulletIndex);
 			if (DoDiscsOverlap(enemy->m_position, enemy->GetCollisionRadius(), bullet->m_position, bullet->m_physicsRadius)) {
 				enemy->TakeAHit(bullet->m_position);
 				if (!enemy->IsAlive()) {
@@ -929,17 +877,14 @@ void Game::CheckCollisionEntities()
 
 void Game::CheckCollisionAsteroids()
 {
-	for (int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; asteroidIndex++) {
-		Asteroid* asteroid = m_asteroids[asteroidIndex];
-		if (!asteroid || !asteroid->IsAlive()) {
+	for (int asteroidIndex = 0; asteroidIndex < m_asteroids.GetCount(); asteroidIndex++) {
+		Asteroid* asteroid = m_asteroids.GetItem(asteroidIndex);
+		if (!asteroid->IsAlive()) {
 			continue;
 		}
 
-		for (int bulletIndex = 0; bulletIndex < MAX_BULLETS; bulletIndex++) {
-			Bullet* bullet = m_bullets[bulletIndex];
-			if (!bullet) {
-				continue;
-			}
+		for (int bulletIndex = 0; bulletIndex < m_bullets.GetCount(); bulletIndex++) {
+			Bullet* bullet = m_bullets.GetItem(bulletIndex);
 
 			if (DoDiscsOverlap(asteroid->m_position, asteroid->m_physicsRadius, bullet->m_position, bullet->m_physicsRadius)) {
 				asteroid->TakeAHit();
@@ -998,11 +943,8 @@ void Game::CheckCollisionLaserBeams()
 
 void Game::CheckCollisionPickUps()
 {
-	for (int pickUpIndex = 0; pickUpIndex < MAX_PICKUPS; pickUpIndex++) {
-		PickUp* const pickUp = m_pickUps[pickUpIndex];
-		if (!pickUp) {
-			continue;
-		}
+	for (int pickUpIndex = 0; pickUpIndex < m_pickUps.GetCount(); pickUpIndex++) {
+		PickUp* const pickUp = m_pickUps.GetItem(pickUpIndex);
 
 		if (DoDiscsOverlap(pickUp->m_position, pickUp->m_physicsRadius, m_playerShip->m_position, m_playerShip->m_physicsRadius)) {
 			if (m_playerShip->IsAlive()) {
@@ -1034,12 +976,7 @@ void Game::SpawnRandomAsteroid()
 	float randX = rng.GetRandomFloatInRange(-WRAP_AROUND_SPACE, -ASTEROID_COSMETIC_RADIUS);
 	float randY = rng.GetRandomFloatInRange(-WRAP_AROUND_SPACE, -ASTEROID_COSMETIC_RADIUS);
 
-	for (int asteroidIndex = 0; asteroidIndex < MAX_ASTEROIDS; asteroidIndex++) {
-		if (!m_asteroids[asteroidIndex]) {
-			m_asteroids[asteroidIndex] = new Asteroid(this, Vec2(randX, randY));
-			return;
-		}
-	}
+	if (m_asteroids.Create(this, Vec2(randX, randY))) return;
 
 	ERROR_RECOVERABLE("CANNOT SPAWN A NEW ASTEROID; ALL SLOTS ARE FULL!");
 
@@ -1048,14 +985,11 @@ void Game::SpawnRandomAsteroid()
 void Game::SpawnBullet(const Vec2& pos, float forwardDegrees)
 {
 	if (!m_playerShip->IsAlive()) return;
-	for (int bulletIndex = 0; bulletIndex < MAX_BULLETS; bulletIndex++) {
-		Bullet*& bullet = m_bullets[bulletIndex];
-		if (!bullet) {
-			bullet = new Bullet(this, pos);
-			bullet->m_orientationDegrees = forwardDegrees;
-			bullet->m_velocity.SetOrientationDegrees(forwardDegrees);
-			return;
-		}
+	Bullet* bullet = m_bullets.Create(this, pos);
+	if (bullet) {
+		bullet->m_orientationDegrees = forwardDegrees;
+		bullet->m_velocity.SetOrientationDegrees(forwardDegrees);
+		return;
 	}
 
 	ERROR_RECOVERABLE("CANNOT SPAWN MORE BULLETS; ALL SLOTS ARE FULL!");
@@ -1076,13 +1010,7 @@ void Game::SpawnRandomDebris(const Vec2& pos, Rgba8 color, const Vec2& velocity,
 {
 	float randomDegrees = rng.GetRandomFloatInRange(-1.0f, 1.0f) * 90.0f;
 	Vec2 newVel = velocity.GetRotatedDegrees(randomDegrees);
-	for (int debrisIndex = 0; debrisIndex < DEBRIS_MAX_AMOUNT; debrisIndex++) {
-		Debris*& debris = m_debris[debrisIndex];
-		if (!debris) {
-			debris = new Debris(this, pos, color, newVel, scale, speed);
-			return;
-		}
-	}
+	m_debris.Create(this, pos, color, newVel, scale, speed);
 }
 
 Vec2 const Game::GetRandomSpawnPosition()
@@ -1236,13 +1164,7 @@ void Game::SpawnPickUp()
 	float randX = rng.GetRandomFloatInRange(SHIELD_PICKUP_RADIUS, WORLD_SIZE_X - SHIELD_PICKUP_RADIUS);
 	float randY = rng.GetRandomFloatInRange(SHIELD_PICKUP_RADIUS, WORLD_SIZE_Y - SHIELD_PICKUP_RADIUS);
 
-	for (int pickupIndex = 0; pickupIndex < MAX_PICKUPS; pickupIndex++) {
-		PickUp*& pickup = m_pickUps[pickupIndex];
-		if (!pickup) {
-			pickup = new PickUp(this, Vec2(randX, randY));
-			return;
-		}
-	}
+	if (m_pickUps.Create(this, Vec2(randX, randY))) return;
 
 	ERROR_RECOVERABLE("CANNOT SPAWN MORE PICKUPS");
 
@@ -1,14 +1,15 @@
 #pragma once
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/Camera.hpp"
+#include "Engine/Core/EntityPool.hpp"
 #include "Game/Framework/GameCommon.hpp"
 #include "Game/Gameplay/Entity.hpp"
+#include "Game/Gameplay/Asteroid.hpp"
+#include "Game/Gameplay/Bullet.hpp"
+#include "Game/Gameplay/Debris.hpp"
+#include "Game/Gameplay/PickUp.hpp"
 
 class PlayerShip;
-class Asteroid;
-class Bullet;
-class Debris;
-class PickUp;
 
 extern SoundID playerShootingSound;
 extern SoundID playerExplosionSound;
@@ -121,12 +122,14 @@ private:
 
 	Vec2 const GetRandomSpawnPosition();
 
-	Asteroid* m_asteroids[MAX_ASTEROIDS] = {};
-	Bullet* m_bullets[MAX_BULLETS] = {};
+	// Spawned and destroyed in bulk every wave, so they live in pools. Enemies are few, of several types, and the twins
+	// point at each other, so they stay individually allocated
+	EntityPool<Asteroid> m_asteroids = EntityPool<Asteroid>(MAX_ASTEROIDS);
+	EntityPool<Bullet> m_bullets = EntityPool<Bullet>(MAX_BULLETS);
 	PlayerShip* m_playerShip = nullptr;
 	Entity* m_enemies[MAX_ENEMIES] = {};
-	Debris* m_debris[DEBRIS_MAX_AMOUNT] = {};
-	PickUp* m_pickUps[MAX_PICKUPS] = {};
+	EntityPool<Debris> m_debris = EntityPool<Debris>(DEBRIS_MAX_AMOUNT);
+	EntityPool<PickUp> m_pickUps = EntityPool<PickUp>(MAX_PICKUPS);
 
 	Camera m_worldCamera;
 	Camera m_UICamera;